@@ -0,0 +1,29 @@
+#!/bin/bash
+# Build the headless load bot (standalone, no OpenGL required, Linux only)
+
+echo "Building load bot (standalone)..."
+
+mkdir -p build_loadbot
+cd build_loadbot
+
+echo "Compiling protocol_handler.cpp..."
+g++ -std=c++17 -O2 -c ../src/network/protocol_handler.cpp -I../include -I../external -I../external/json/include -o protocol_handler.o
+
+echo "Compiling load_bot.cpp..."
+g++ -std=c++17 -O2 -c ../src/network/load_bot.cpp -I../include -I../external -I../external/json/include -o load_bot.o
+
+echo "Compiling loadbot_main.cpp..."
+g++ -std=c++17 -O2 -c ../src/loadbot_main.cpp -I../include -I../external -I../external/json/include -o loadbot_main.o
+
+echo "Linking..."
+g++ -std=c++17 protocol_handler.o load_bot.o loadbot_main.o -o atlas_loadbot
+
+if [ -f atlas_loadbot ]; then
+    echo "Build complete! Binary: build_loadbot/atlas_loadbot"
+    echo ""
+    echo "Example (2000 pilots for two minutes against a local server):"
+    echo "  ./build_loadbot/atlas_loadbot --bots 2000 --duration 120"
+else
+    echo "Build failed!"
+    exit 1
+fi
@@ -11,6 +11,9 @@ cd build_test_network
 echo "Compiling tcp_client.cpp..."
 g++ -std=c++17 -c ../src/network/tcp_client.cpp -I../include -I../external/json/include -o tcp_client.o
 
+echo "Compiling message_stream.cpp..."
+g++ -std=c++17 -c ../src/network/message_stream.cpp -I../include -I../external/json/include -o message_stream.o
+
 echo "Compiling protocol_handler.cpp..."
 g++ -std=c++17 -c ../src/network/protocol_handler.cpp -I../include -I../external/json/include -o protocol_handler.o
 
@@ -21,7 +24,7 @@ echo "Compiling test_network.cpp..."
 g++ -std=c++17 -c ../test_network.cpp -I../include -I../external/json/include -o test_network.o
 
 echo "Linking..."
-g++ -std=c++17 tcp_client.o protocol_handler.o network_manager.o test_network.o -lpthread -o test_network
+g++ -std=c++17 tcp_client.o message_stream.o protocol_handler.o network_manager.o test_network.o -lpthread -o test_network
 
 if [ -f test_network ]; then
     echo "Build complete! Binary: build_test_network/test_network"
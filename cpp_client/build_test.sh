@@ -10,20 +10,27 @@ mkdir -p build_test
 cd build_test
 
 # Compile frustum culler implementation
-g++ -c -std=c++17 -I../include -I../external/glm \
+g++ -c -std=c++17 -O2 -I../include -I../external/glm \
     ../src/rendering/frustum_culler.cpp \
     -o frustum_culler.o
 
+# Compile batched culler implementation
+g++ -c -std=c++17 -O2 -I../include -I../external/glm \
+    ../src/rendering/batch_culler.cpp \
+    -o batch_culler.o
+
 # Compile LOD manager implementation
-g++ -c -std=c++17 -I../include -I../external/glm \
+g++ -c -std=c++17 -O2 -I../include -I../external/glm \
     ../src/rendering/lod_manager.cpp \
     -o lod_manager.o
 
 # Compile and link test
-g++ -std=c++17 -I../include -I../external/glm \
+g++ -std=c++17 -O2 -I../include -I../external/glm \
     ../test_frustum_culling.cpp \
     frustum_culler.o \
+    batch_culler.o \
     lod_manager.o \
+    -pthread \
     -o test_frustum_culling
 
 if [ $? -eq 0 ]; then
@@ -0,0 +1,27 @@
+#!/bin/bash
+
+# Build script for binary model test
+
+echo "Building Binary Model Test..."
+
+# Create build directory
+mkdir -p build_test_binary_model
+cd build_test_binary_model
+
+# Compile and link test (converts and maps CPU-side meshes only, no OpenGL)
+g++ -std=c++17 -I../include -I../external/glm -I../external/tinyobjloader \
+    ../test_binary_model.cpp \
+    ../src/rendering/binary_model.cpp \
+    ../src/rendering/mapped_file.cpp \
+    ../src/rendering/procedural_mesh_ops.cpp \
+    -pthread \
+    -o test_binary_model
+
+if [ $? -eq 0 ]; then
+    echo "Build successful!"
+    echo "Running tests..."
+    ./test_binary_model
+else
+    echo "Build failed!"
+    exit 1
+fi
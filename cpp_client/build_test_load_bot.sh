@@ -0,0 +1,26 @@
+#!/bin/bash
+
+# Build script for load bot test
+
+echo "Building Load Bot Test..."
+
+# Create build directory
+mkdir -p build_test_load_bot
+cd build_test_load_bot
+
+# Compile and link test (local stand-in server only, no game server or OpenGL; Linux only)
+g++ -std=c++17 -O2 -I../include -I../external -I../external/json/include \
+    ../test_load_bot.cpp \
+    ../src/network/load_bot.cpp \
+    ../src/network/protocol_handler.cpp \
+    -pthread \
+    -o test_load_bot
+
+if [ $? -eq 0 ]; then
+    echo "Build successful!"
+    echo "Running tests..."
+    ./test_load_bot
+else
+    echo "Build failed!"
+    exit 1
+fi
@@ -0,0 +1,25 @@
+#!/bin/bash
+
+# Build script for mesh cache test
+
+echo "Building Mesh Cache Test..."
+
+# Create build directory
+mkdir -p build_test_mesh_cache
+cd build_test_mesh_cache
+
+# Compile and link test (this test doesn't need OpenGL, just logic testing)
+g++ -std=c++17 -I../include \
+    ../test_mesh_cache.cpp \
+    ../src/rendering/mesh_cache.cpp \
+    -pthread \
+    -o test_mesh_cache
+
+if [ $? -eq 0 ]; then
+    echo "Build successful!"
+    echo "Running tests..."
+    ./test_mesh_cache
+else
+    echo "Build failed!"
+    exit 1
+fi
@@ -0,0 +1,28 @@
+#!/bin/bash
+
+# Build script for mesh disk cache test
+
+echo "Building Mesh Disk Cache Test..."
+
+# Create build directory
+mkdir -p build_test_mesh_disk_cache
+cd build_test_mesh_disk_cache
+
+# Compile and link test (bakes and maps CPU-side meshes only, no OpenGL)
+g++ -std=c++17 -I../include -I../external/glm \
+    ../test_mesh_disk_cache.cpp \
+    ../src/rendering/mesh_disk_cache.cpp \
+    ../src/rendering/mapped_file.cpp \
+    ../src/rendering/mesh_cache.cpp \
+    ../src/rendering/procedural_mesh_ops.cpp \
+    -pthread \
+    -o test_mesh_disk_cache
+
+if [ $? -eq 0 ]; then
+    echo "Build successful!"
+    echo "Running tests..."
+    ./test_mesh_disk_cache
+else
+    echo "Build failed!"
+    exit 1
+fi
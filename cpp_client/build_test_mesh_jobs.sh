@@ -0,0 +1,26 @@
+#!/bin/bash
+
+# Build script for mesh job system test
+
+echo "Building Mesh Job System Test..."
+
+# Create build directory
+mkdir -p build_test_mesh_jobs
+cd build_test_mesh_jobs
+
+# Compile and link test (CPU-side mesh generation only, no OpenGL)
+g++ -std=c++17 -I../include -I../external/glm \
+    ../test_mesh_jobs.cpp \
+    ../src/rendering/mesh_job_system.cpp \
+    ../src/rendering/procedural_mesh_ops.cpp \
+    -pthread \
+    -o test_mesh_jobs
+
+if [ $? -eq 0 ]; then
+    echo "Build successful!"
+    echo "Running tests..."
+    ./test_mesh_jobs
+else
+    echo "Build failed!"
+    exit 1
+fi
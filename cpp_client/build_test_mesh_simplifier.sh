@@ -0,0 +1,26 @@
+#!/bin/bash
+
+# Build script for mesh simplifier test
+
+echo "Building Mesh Simplifier Test..."
+
+# Create build directory
+mkdir -p build_test_mesh_simplifier
+cd build_test_mesh_simplifier
+
+# Compile and link test (simplifies CPU-side meshes only, no OpenGL)
+g++ -std=c++17 -I../include -I../external/glm \
+    ../test_mesh_simplifier.cpp \
+    ../src/rendering/mesh_simplifier.cpp \
+    ../src/rendering/procedural_mesh_ops.cpp \
+    -pthread \
+    -o test_mesh_simplifier
+
+if [ $? -eq 0 ]; then
+    echo "Build successful!"
+    echo "Running tests..."
+    ./test_mesh_simplifier
+else
+    echo "Build failed!"
+    exit 1
+fi
@@ -0,0 +1,26 @@
+#!/bin/bash
+
+# Build script for message stream test
+
+echo "Building Message Stream Test..."
+
+# Create build directory
+mkdir -p build_test_message_stream
+cd build_test_message_stream
+
+# Compile and link test (local loopback server only, no game server or OpenGL)
+g++ -std=c++17 -O2 -I../include \
+    ../test_message_stream.cpp \
+    ../src/network/message_stream.cpp \
+    ../src/network/tcp_client.cpp \
+    -pthread \
+    -o test_message_stream
+
+if [ $? -eq 0 ]; then
+    echo "Build successful!"
+    echo "Running tests..."
+    ./test_message_stream
+else
+    echo "Build failed!"
+    exit 1
+fi
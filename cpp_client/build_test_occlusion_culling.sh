@@ -0,0 +1,25 @@
+#!/bin/bash
+
+# Build script for occlusion culling test
+
+echo "Building Occlusion Culling Test..."
+
+# Create build directory
+mkdir -p build_test_occlusion_culling
+cd build_test_occlusion_culling
+
+# Compile and link test (software depth buffer on the CPU only, no OpenGL)
+g++ -std=c++17 -O2 -I../include -I../external/glm \
+    ../test_occlusion_culling.cpp \
+    ../src/rendering/occlusion_culler.cpp \
+    -pthread \
+    -o test_occlusion_culling
+
+if [ $? -eq 0 ]; then
+    echo "Build successful!"
+    echo "Running tests..."
+    ./test_occlusion_culling
+else
+    echo "Build failed!"
+    exit 1
+fi
@@ -0,0 +1,25 @@
+#!/bin/bash
+
+# Build script for particle simulation test
+
+echo "Building Particle Simulation Test..."
+
+# Create build directory
+mkdir -p build_test_particle_simulation
+cd build_test_particle_simulation
+
+# Compile and link test (simulates particles on the CPU only, no OpenGL)
+g++ -std=c++17 -O2 -I../include -I../external/glm \
+    ../test_particle_simulation.cpp \
+    ../src/rendering/particle_simulation.cpp \
+    -pthread \
+    -o test_particle_simulation
+
+if [ $? -eq 0 ]; then
+    echo "Build successful!"
+    echo "Running tests..."
+    ./test_particle_simulation
+else
+    echo "Build failed!"
+    exit 1
+fi
@@ -0,0 +1,25 @@
+#!/bin/bash
+
+# Build script for render queue test
+
+echo "Building Render Queue Test..."
+
+# Create build directory
+mkdir -p build_test_render_queue
+cd build_test_render_queue
+
+# Compile and link test (builds draw batches on the CPU only, no OpenGL)
+g++ -std=c++17 -I../include -I../external/glm \
+    ../test_render_queue.cpp \
+    ../src/rendering/render_queue.cpp \
+    -pthread \
+    -o test_render_queue
+
+if [ $? -eq 0 ]; then
+    echo "Build successful!"
+    echo "Running tests..."
+    ./test_render_queue
+else
+    echo "Build failed!"
+    exit 1
+fi
@@ -53,3 +53,5 @@ echo "Reference models ready in: $OUT_DIR"
 echo ""
 echo "Inventory:"
 find "$OUT_DIR" -name "*.obj" -exec ls -lh {} \; 2>/dev/null
+echo ""
+echo "Convert them to .amdl for fast loading: cmake --build <build dir> --target convert_models"
@@ -67,6 +67,12 @@ public:
      */
     const std::string& getPlayerEntityId() const { return m_playerEntityId; }
 
+    /**
+     * Get the server time dilation factor for the current solar system
+     * (1.0 = real time)
+     */
+    float getTimeDilation() const { return m_timeDilation; }
+
     /**
      * Set callbacks for entity events
      */
@@ -84,12 +90,14 @@ private:
     void handleDestroyEntity(const std::string& dataJson);
     void handleStateUpdate(const std::string& dataJson);
     void handleConnectAck(const std::string& dataJson);
+    void handleTimeDilation(const std::string& dataJson);
 
     NetworkManager m_networkManager;
     EntityManager m_entityManager;
 
     std::string m_playerEntityId;
     std::string m_characterName;
+    float m_timeDilation = 1.0f;
 };
 
 } // namespace atlas
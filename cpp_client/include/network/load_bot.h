@@ -0,0 +1,232 @@
+#pragma once
+
+#include "network/protocol_handler.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * Collected samples with percentile queries (latency, bandwidth, tick
+ * intervals).  Samples are sorted lazily on the first query after an add.
+ */
+class SampleStats {
+public:
+    void add(double value);
+
+    size_t count() const { return m_samples.size(); }
+    double mean() const;
+    double max() const;
+
+    /**
+     * Nearest-rank percentile
+     * @param p Percentile in [0, 100]
+     */
+    double percentile(double p) const;
+
+    /**
+     * One-line summary: "n=.. mean=.. p50=.. p90=.. p99=.. max=.."
+     */
+    std::string summary() const;
+
+private:
+    mutable std::vector<double> m_samples;
+    mutable bool m_sorted = true;
+    double m_sum = 0.0;
+};
+
+/**
+ * Cuts a TCP byte stream into JSON messages.
+ *
+ * The server writes its messages back to back with no delimiter (the
+ * Python server newline-terminates them), so a message ends at the brace
+ * that closes its top-level object, ignoring braces inside strings.
+ */
+class JsonStreamSplitter {
+public:
+    /**
+     * Append received bytes; every message they complete is appended to @p out
+     */
+    void feed(const char* data, size_t size, std::vector<std::string>& out);
+
+    /**
+     * Bytes held for a message that has not finished arriving
+     */
+    size_t buffered() const { return m_buffer.size(); }
+
+private:
+    std::string m_buffer;
+    size_t m_scan = 0;      // next byte of m_buffer to examine
+    int m_depth = 0;
+    bool m_inString = false;
+    bool m_escape = false;
+};
+
+/**
+ * Parse a Prometheus text exposition (the server's metrics_export_path
+ * file) into name -> value.  Comment lines and labelled series are
+ * skipped; only bare "name value" samples are kept.
+ * @return false if no sample was found
+ */
+bool parseMetricsText(const std::string& text, std::map<std::string, double>& out);
+
+/**
+ * Load bot settings.  Action rates are per bot, per minute, and drawn as
+ * independent Poisson processes so a large swarm produces smooth load.
+ */
+struct LoadBotConfig {
+    std::string host = "127.0.0.1";
+    int port = 8765;
+    int botCount = 100;
+    float connectRate = 200.0f;     // new connections per second
+    float duration = 60.0f;         // seconds of load after the first connect
+    unsigned int seed = 1;
+
+    float undockPerMinute = 0.5f;
+    float warpPerMinute = 2.0f;
+    float orbitPerMinute = 4.0f;
+    float lockAndShootPerMinute = 6.0f;
+    float marketPerMinute = 1.0f;
+    float chatPerMinute = 1.0f;
+    std::string marketStation = "jita_4_4";
+    std::string marketItem = "tritanium";
+
+    float responseTimeout = 10.0f;  // seconds before a request counts as lost
+    int tickSampleBots = 8;         // bots that estimate the tick interval
+    std::string serverMetricsPath;  // server's metrics_export_path, "" = not sampled
+    bool verbose = false;
+};
+
+/**
+ * Headless swarm of simulated pilots driven from one thread.
+ *
+ * Every bot is a non-blocking socket on a single epoll loop, so thousands
+ * of pilots cost one process and no render or UI code.  Messages are
+ * built with the client's ProtocolHandler; responses are matched to the
+ * oldest outstanding request expecting them to measure latency.
+ *
+ * Server tick cost comes from the server itself: given the path of its
+ * metrics_export_path file (same host, or a shared mount) the swarm reads
+ * each export as it lands.  Without it the report only has a client-side
+ * estimate of the tick interval, taken from the sequence and clock stamps
+ * on the state_update broadcasts a few bots receive.
+ *
+ * Linux only (epoll).
+ */
+class LoadBotSwarm {
+public:
+    explicit LoadBotSwarm(const LoadBotConfig& config);
+    ~LoadBotSwarm();
+
+    LoadBotSwarm(const LoadBotSwarm&) = delete;
+    LoadBotSwarm& operator=(const LoadBotSwarm&) = delete;
+
+    /**
+     * Connect the swarm and drive it for the configured duration
+     * @return false if the event loop could not be created
+     */
+    bool run();
+
+    /**
+     * Human-readable results of the last run
+     */
+    std::string report() const;
+
+    int getConnectedCount() const { return m_connected; }
+    int getFailedCount() const { return m_failed; }
+    const SampleStats& getLatency() const { return m_latency; }
+    const SampleStats& getTickIntervalEstimate() const { return m_tickIntervalEstimate; }
+    const SampleStats& getServerTickAvg() const { return m_serverTickAvg; }
+
+private:
+    enum class BotState { Idle, Connecting, Handshake, Active, Closed };
+
+    enum class Action { Undock, Warp, Orbit, LockAndShoot, Market, Chat, Count };
+
+    struct Pending {
+        std::string kind;           // latency bucket, e.g. "warp"
+        std::string token;          // text the response must contain (chat)
+        double sentAt = 0.0;
+    };
+
+    struct Bot {
+        int fd = -1;
+        BotState state = BotState::Idle;
+        std::string name;
+        std::string entityId;
+        JsonStreamSplitter splitter;
+        std::string outbox;
+        bool wantWrite = false;
+        double lastSendAt = -1.0;
+        std::deque<Pending> pending;
+        double nextAction[static_cast<int>(Action::Count)] = {};
+        double shootAt = 0.0;       // follow-up module_activate, 0 if none
+        std::string lockedTarget;
+        uint64_t lastSequence = 0;
+        double lastServerTime = 0.0;
+        uint64_t bytesIn = 0;
+        uint64_t bytesOut = 0;
+        double activeSince = 0.0;
+        double activeUntil = 0.0;
+        std::mt19937 rng;
+    };
+
+    static double now();
+
+    void startConnect(size_t index, double t);
+    void finishConnect(size_t index, double t);
+    void closeBot(size_t index, double t, bool failed);
+    void readBot(size_t index, double t);
+    void flushBot(size_t index);
+    void send(size_t index, const std::string& message, const std::string& kind,
+              double t, const std::string& token = "");
+    void handleMessage(size_t index, const std::string& message, double t);
+    void runActions(size_t index, double t);
+    void scheduleAction(Bot& bot, Action action, double t);
+    void expirePending(Bot& bot, double t);
+    std::string pickTarget(Bot& bot);
+    void sampleServerMetrics();
+
+    LoadBotConfig m_config;
+    ProtocolHandler m_protocol;
+    std::vector<Bot> m_bots;
+    int m_epoll = -1;
+    uint32_t m_address = 0;         // IPv4, network byte order
+    double m_start = 0.0;
+
+    std::vector<std::string> m_targets;       // entity ids seen in spawn_entity
+    std::unordered_set<std::string> m_targetSet;
+
+    int m_connected = 0;
+    int m_failed = 0;
+    int m_disconnected = 0;
+    uint64_t m_timeouts = 0;
+    uint64_t m_errors = 0;
+    uint64_t m_sequenceGaps = 0;
+    uint64_t m_messagesIn = 0;
+    std::map<std::string, uint64_t> m_sent;
+    std::map<std::string, SampleStats> m_latencyByKind;
+    SampleStats m_latency;
+    SampleStats m_connectLatency;
+    SampleStats m_tickIntervalEstimate;
+    SampleStats m_serverTickAvg;    // atlas_tick_duration_avg_ms, one sample per export
+    SampleStats m_serverTickMax;    // atlas_tick_duration_max_ms
+    SampleStats m_serverTickRate;   // ticks per second between exports
+    double m_lastServerTicks = -1.0;
+    double m_lastServerUptime = 0.0;
+    int m_serverExports = 0;
+    SampleStats m_bytesInPerBot;    // KB/s over each bot's active time
+    SampleStats m_bytesOutPerBot;
+    SampleStats m_aggregateIn;      // KB/s across the swarm, one sample per second
+    uint64_t m_secondBytes = 0;
+    uint64_t m_chatNonce = 0;
+    double m_runTime = 0.0;
+};
+
+} // namespace atlas
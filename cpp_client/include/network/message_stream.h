@@ -0,0 +1,198 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * Bounded lock-free queue for exactly one producer thread and one consumer
+ * thread
+ *
+ * A power-of-two ring of slots; each side owns one index and only reads the
+ * other's, so push and pop are a load, a store and no locks.
+ */
+template <typename T>
+class SpscQueue {
+public:
+    /**
+     * @param capacity Slots, rounded up to a power of two
+     */
+    explicit SpscQueue(size_t capacity) {
+        size_t slots = 2;
+        while (slots < capacity) slots <<= 1;
+        m_slots.resize(slots);
+        m_mask = slots - 1;
+    }
+
+    /**
+     * Producer side; false when full
+     */
+    bool push(const T& value) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead > m_mask) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead > m_mask) return false;
+        }
+        m_slots[tail & m_mask] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer side; false when empty
+     */
+    bool pop(T& value) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail) return false;
+        }
+        value = m_slots[head & m_mask];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return m_slots.size(); }
+
+private:
+    std::vector<T> m_slots;
+    size_t m_mask = 0;
+
+    // Producer and consumer indices on separate cache lines, each with the
+    // last value seen of the other side's index
+    alignas(64) std::atomic<size_t> m_tail{0};
+    size_t m_cachedHead = 0;
+    alignas(64) std::atomic<size_t> m_head{0};
+    size_t m_cachedTail = 0;
+};
+
+/**
+ * Receive buffer messages point into
+ *
+ * Holds one reference for the receiving thread while it writes into the
+ * block and one per message not yet consumed; the last release recycles it.
+ */
+struct ReceiveBlock {
+    std::unique_ptr<char[]> data;
+    size_t capacity = 0;
+    std::atomic<uint32_t> references{0};
+    ReceiveBlock* next = nullptr;       // in the returned list
+};
+
+/**
+ * Newline-framed messages received on one thread, handled on another
+ *
+ * The receiving thread reads straight into a pooled block (prepareWrite(),
+ * then commit()), messages are found in place with memchr and handed over
+ * as string_views through an SpscQueue, so no message is copied or
+ * allocated.  Only the unfinished tail of a full block is moved into the
+ * next one; a message larger than a block gets a larger block.  Blocks
+ * come back to the receiving thread once every message in them has been
+ * handled.
+ *
+ * When the consumer falls QUEUE_CAPACITY messages behind, commit() sleeps
+ * on a condition variable until consume() frees space or close() is
+ * called, which in turn stops reading from the socket.  The consumer only
+ * takes the lock when the receiving thread is actually waiting.
+ */
+class MessageStream {
+public:
+    explicit MessageStream(size_t blockSize = DEFAULT_BLOCK_SIZE, size_t queueCapacity = QUEUE_CAPACITY);
+    ~MessageStream();
+
+    MessageStream(const MessageStream&) = delete;
+    MessageStream& operator=(const MessageStream&) = delete;
+
+    /**
+     * Receiving thread: space to receive into (never empty)
+     */
+    char* prepareWrite(size_t& available);
+
+    /**
+     * Receiving thread: @p bytes were written at prepareWrite(); queue every
+     * message they complete
+     * @return False once close() was called
+     */
+    bool commit(size_t bytes);
+
+    /**
+     * Consuming thread: pass each queued message to @p handler, in order.
+     * The view is valid only during the call.
+     * @return Messages handled
+     */
+    template <typename Handler>
+    size_t consume(Handler&& handler) {
+        size_t handled = 0;
+        Message message;
+        while (m_queue.pop(message)) {
+            handler(message.text);
+            release(message.block);
+            ++handled;
+        }
+        if (handled > 0) wakeReceiver();
+        return handled;
+    }
+
+    /**
+     * Stop a commit() waiting for queue space (any thread)
+     */
+    void close();
+
+    /**
+     * Drop partial and queued messages and reopen; neither thread may be
+     * using the stream
+     */
+    void reset();
+
+    uint64_t getMessagesReceived() const { return m_messages.load(std::memory_order_relaxed); }
+    uint64_t getBytesReceived() const { return m_bytes.load(std::memory_order_relaxed); }
+    size_t getBlocksAllocated() const { return m_blocksAllocated.load(std::memory_order_relaxed); }
+
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+    static constexpr size_t QUEUE_CAPACITY = 4096;
+
+private:
+    struct Message {
+        std::string_view text;
+        ReceiveBlock* block = nullptr;
+    };
+
+    ReceiveBlock* acquireBlock(size_t minCapacity);
+    void startBlock();
+    void release(ReceiveBlock* block);
+    void retire(ReceiveBlock* block);
+    bool waitToPush(const Message& message);
+    void wakeReceiver();
+
+    size_t m_blockSize;
+    SpscQueue<Message> m_queue;
+    std::atomic<bool> m_closed{false};
+
+    // A full queue parks the receiving thread here until consume() or close()
+    std::mutex m_spaceMutex;
+    std::condition_variable m_spaceFreed;
+    std::atomic<bool> m_receiverWaiting{false};
+
+    // Receiving thread only
+    std::vector<std::unique_ptr<ReceiveBlock>> m_blocks;
+    std::vector<ReceiveBlock*> m_free;
+    ReceiveBlock* m_current = nullptr;
+    size_t m_size = 0;          // bytes written to m_current
+    size_t m_frameStart = 0;    // first byte of the unfinished message
+
+    // Blocks released by the consuming thread, taken back in one exchange
+    std::atomic<ReceiveBlock*> m_returned{nullptr};
+
+    std::atomic<uint64_t> m_messages{0};
+    std::atomic<uint64_t> m_bytes{0};
+    std::atomic<size_t> m_blocksAllocated{0};
+};
+
+} // namespace atlas
@@ -6,6 +6,7 @@
 #include <memory>
 #include <map>
 #include <string>
+#include <string_view>
 
 namespace atlas {
 
@@ -191,7 +192,7 @@ public:
     std::string getConnectionState() const;
 
 private:
-    void onRawMessage(const std::string& message);
+    void onRawMessage(std::string_view message);
     void onProtocolMessage(const std::string& type, const std::string& dataJson);
     
     // Response handlers
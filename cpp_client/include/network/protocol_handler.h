@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <functional>
 
 namespace atlas {
@@ -16,9 +17,9 @@ public:
     ProtocolHandler();
 
     /**
-     * Parse incoming message
+     * Parse incoming message (parsed in place, nothing is kept)
      */
-    void handleMessage(const std::string& message);
+    void handleMessage(std::string_view message);
 
     /**
      * Create outgoing message
@@ -1,21 +1,28 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <functional>
 #include <memory>
 #include <thread>
 #include <atomic>
-#include <queue>
-#include <mutex>
+#include "network/message_stream.h"
 
 namespace atlas {
 
 /**
  * TCP Client for connecting to game server
+ *
+ * A receive thread blocks in recv() directly into a MessageStream, which
+ * splits the newline-delimited messages in place; processMessages() hands
+ * them to the callback on the calling thread without copying them.
  */
 class TCPClient {
 public:
-    using MessageCallback = std::function<void(const std::string&)>;
+    /**
+     * The view points into the receive buffer and is valid during the call only
+     */
+    using MessageCallback = std::function<void(std::string_view)>;
 
     TCPClient();
     ~TCPClient();
@@ -47,8 +54,14 @@ public:
 
     /**
      * Process received messages (call from main thread)
+     * @return Messages processed
+     */
+    size_t processMessages();
+
+    /**
+     * Received message and byte counts, buffers in use
      */
-    void processMessages();
+    const MessageStream& getReceiveStream() const { return m_stream; }
 
 private:
     void receiveThread();
@@ -63,9 +76,8 @@ private:
     std::unique_ptr<std::thread> m_receiveThread;
     MessageCallback m_messageCallback;
 
-    // Thread-safe message queue
-    std::queue<std::string> m_messageQueue;
-    std::mutex m_queueMutex;
+    // Filled by the receive thread, drained by processMessages()
+    MessageStream m_stream;
 };
 
 } // namespace atlas
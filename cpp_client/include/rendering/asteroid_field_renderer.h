@@ -11,6 +11,8 @@
 
 namespace atlas {
 
+class MeshDiskCache;
+
 /**
  * Asteroid Field Renderer
  * Renders procedural asteroid fields using instanced rendering
@@ -54,8 +56,16 @@ public:
     /**
      * Initialize asteroid field renderer
      * Creates procedural asteroid meshes
+     * @param diskCache Baked meshes to map instead of generating, or nullptr
+     */
+    bool initialize(MeshDiskCache* diskCache = nullptr);
+
+    /**
+     * Generate the asteroid meshes into @p diskCache without a GL context
+     * (prewarming the cache ahead of the first launch)
+     * @return Number of mesh types baked or already current
      */
-    bool initialize();
+    size_t bakeMeshes(MeshDiskCache& diskCache);
     
     /**
      * Generate an asteroid field
@@ -103,9 +113,10 @@ private:
     
     /**
      * Create procedural asteroid meshes
-     * Creates 3 different asteroid mesh types with varying detail
+     * Creates 3 different asteroid mesh types with varying detail,
+     * through @p diskCache when given
      */
-    void createAsteroidMeshes();
+    void createAsteroidMeshes(MeshDiskCache* diskCache);
     
     /**
      * Create a single asteroid mesh
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "rendering/fork_join_pool.h"
+#include "rendering/lod_manager.h"
+
+namespace atlas {
+
+class Frustum;
+
+/**
+ * Bounding spheres in structure-of-arrays layout: one array per coordinate,
+ * so a vector register loads the same component of consecutive spheres
+ */
+struct SphereArrays {
+    const float* x = nullptr;
+    const float* y = nullptr;
+    const float* z = nullptr;
+    const float* radius = nullptr;
+    size_t count = 0;
+};
+
+/**
+ * Output of one culling pass
+ */
+struct BatchCullResult {
+    std::vector<uint32_t> visible;   // indices of visible spheres, ascending
+    std::vector<uint8_t> lod;        // LODLevel of every sphere, CULLED when not visible
+    size_t frustumCulled = 0;        // outside the frustum
+    size_t distanceCulled = 0;       // inside the frustum, beyond the cull distance
+};
+
+/**
+ * Batched frustum culling and distance LOD classification
+ *
+ * Tests spheres against the six frustum planes several at a time (8 with
+ * AVX, 4 with SSE2, one otherwise; chosen when the client is compiled) and
+ * classifies each by camera distance in the same pass, with the same
+ * results as Frustum::containsSphere() and LODManager's distance bands.
+ * Visible spheres come out as a compact index list, so callers walk only
+ * what they draw.
+ *
+ * Sets larger than the split size are divided into contiguous ranges, one
+ * per thread of a ForkJoinPool, the calling thread included.
+ */
+class BatchCuller {
+public:
+    /**
+     * @param threadCount Threads sharing a large pass, including the caller;
+     *        0 picks the hardware thread count (at most MAX_THREADS)
+     */
+    explicit BatchCuller(unsigned int threadCount = 0);
+
+    BatchCuller(const BatchCuller&) = delete;
+    BatchCuller& operator=(const BatchCuller&) = delete;
+
+    /**
+     * Cull and classify @p spheres
+     * @param frustum Planes to test against, or nullptr for distance only
+     * @param config LOD distances; bands must not decrease
+     * @param result Reused between passes to keep its capacity
+     */
+    void cull(const SphereArrays& spheres, const Frustum* frustum, const glm::vec3& cameraPosition,
+              const LODConfig& config, BatchCullResult& result);
+
+    /**
+     * Spheres per thread below which a pass stays on the calling thread
+     */
+    void setSplitSize(size_t spheres) { m_splitSize = spheres > 0 ? spheres : 1; }
+    size_t getSplitSize() const { return m_splitSize; }
+
+    unsigned int getThreadCount() const { return m_tasks.getThreadCount(); }
+
+    /**
+     * Spheres tested per instruction in this build (8, 4 or 1)
+     */
+    static unsigned int getSimdWidth();
+
+    /**
+     * Instruction set of the plane tests in this build ("AVX", "SSE2" or "scalar")
+     */
+    static const char* getSimdName();
+
+    static constexpr unsigned int MAX_THREADS = 16;
+    static constexpr size_t DEFAULT_SPLIT_SIZE = 16384;
+
+private:
+    size_t m_splitSize = DEFAULT_SPLIT_SIZE;
+
+    // Visible indices of each task's range, joined in order after the pass
+    std::vector<std::vector<uint32_t>> m_taskVisible;
+
+    ForkJoinPool m_tasks;
+};
+
+} // namespace atlas
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "rendering/mesh.h"
+#include "rendering/mesh_bounds.h"
+
+namespace atlas {
+
+/**
+ * Compact binary model format (.amdl)
+ *
+ * Written offline by atlas_model_convert from OBJ and glTF sources, and
+ * mapped at runtime instead of parsing text.  One file holds every mesh of
+ * a model, already in the layout Mesh uploads:
+ *
+ *   header | mesh table | per mesh: PackedVertex block, index block
+ *
+ * The table lists full-detail meshes first, then each simplified level of
+ * detail (see mesh_simplifier.h) with its model-space error.
+ *
+ * Vertices are quantised to PackedVertex (half-float positions and UVs,
+ * 10:10:10 normals, 8-bit colours), welded, and ordered for the post-transform
+ * vertex cache, then for overdraw, then for vertex fetch.  Meshes with fewer
+ * than 65536 vertices get 16-bit indices.  Per-mesh and whole-model
+ * bounding boxes and spheres are stored so loading never touches vertices.
+ *
+ * Blocks are 16-byte aligned.  Files are little-endian; a file with another
+ * format version, byte order or vertex layout is rejected and the source is
+ * parsed instead.
+ */
+constexpr uint32_t BINARY_MODEL_VERSION = 2;
+constexpr const char* BINARY_MODEL_EXTENSION = ".amdl";
+
+/**
+ * One mesh ready to be written: quantised, welded and reordered
+ */
+struct ConvertedMesh {
+    std::vector<PackedVertex> vertices;
+    std::vector<uint32_t> indices;
+    MeshBounds bounds;
+    uint32_t lod = 0;           // 0 is full detail
+    float lodError = 0.0f;
+};
+
+/**
+ * What convertMesh() did to one mesh
+ */
+struct MeshConvertStats {
+    size_t sourceVertices = 0;
+    size_t vertices = 0;            // after welding
+    size_t triangles = 0;
+    size_t degenerateTriangles = 0; // collapsed by quantisation and dropped
+    float acmrBefore = 0.0f;        // average cache miss ratio, welded source order
+    float acmrAfter = 0.0f;
+};
+
+/**
+ * One simplified level of a mapped model
+ */
+struct BinaryModelLod {
+    std::vector<PackedMeshView> meshes;
+    float error = 0.0f;
+};
+
+/**
+ * A mapped .amdl file
+ *
+ * Each mesh views vertex and index data inside the mapping; build Mesh
+ * objects from them with the mapping as storage to keep it alive.
+ */
+struct BinaryModel {
+    std::vector<PackedMeshView> meshes;
+    std::vector<MeshBounds> meshBounds;
+    std::vector<BinaryModelLod> lods;   // coarsest last
+    MeshBounds bounds;
+    size_t mappedBytes = 0;
+    std::shared_ptr<const void> mapping;
+};
+
+// ── Quantisation ────────────────────────────────────────────────────
+
+/** IEEE 754 binary16, round to nearest even; overflow saturates to infinity */
+uint16_t floatToHalf(float value);
+float halfToFloat(uint16_t half);
+
+PackedVertex packVertex(const Vertex& vertex);
+Vertex unpackVertex(const PackedVertex& packed);
+
+/**
+ * Expand a quantised mesh into float vertices and 32-bit indices for CPU
+ * consumers such as the occlusion culler; the buffers are reused, and the
+ * returned view points into them
+ */
+MeshGeometryView unpackGeometry(const PackedMeshView& packed, std::vector<Vertex>& vertices,
+                                std::vector<unsigned int>& indices);
+
+// ── Optimisation ────────────────────────────────────────────────────
+
+/**
+ * Reorder triangles for the post-transform vertex cache
+ * (Forsyth's linear-speed algorithm)
+ */
+void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+/**
+ * Reorder cache-optimised triangles to reduce overdraw, keeping the cache
+ * miss ratio within @p threshold of its current value.  Triangles are
+ * grouped into clusters at cache restarts and drawn outward-facing
+ * clusters first (Sander et al., as in meshoptimizer).
+ */
+void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<PackedVertex>& vertices,
+                      float threshold = 1.05f);
+
+/**
+ * Renumber vertices in order of first use and drop unreferenced ones
+ */
+void optimizeVertexFetch(std::vector<PackedVertex>& vertices, std::vector<uint32_t>& indices);
+
+/**
+ * Average cache misses per triangle for a FIFO cache of @p cacheSize
+ * (3.0 is worst, about 0.5 is the limit for regular grids)
+ */
+float computeACMR(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize = 16);
+
+/**
+ * Quantise, weld and reorder one source mesh
+ */
+ConvertedMesh convertMesh(const MeshGeometryView& source, MeshConvertStats* stats = nullptr);
+
+// ── Files ───────────────────────────────────────────────────────────
+
+/**
+ * Write @p meshes to @p path through a temporary file; levels of detail
+ * must follow full detail in ascending order
+ * @return false if the file could not be written
+ */
+bool writeBinaryModel(const std::string& path, const std::vector<ConvertedMesh>& meshes);
+
+/**
+ * Map a .amdl file without copying its geometry
+ * @return Mapped model, or nullptr if missing, from another format version,
+ *         truncated or corrupt
+ */
+std::shared_ptr<const BinaryModel> loadBinaryModel(const std::string& path);
+
+/**
+ * Where the converter puts the binary version of @p sourcePath
+ * (same directory and name, .amdl extension)
+ */
+std::string binaryModelPathFor(const std::string& sourcePath);
+
+/**
+ * Binary version of @p sourcePath if one exists and is not older than the
+ * source, otherwise empty
+ */
+std::string findCurrentBinaryModel(const std::string& sourcePath);
+
+} // namespace atlas
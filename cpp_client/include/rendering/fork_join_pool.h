@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * Fork-join pool for splitting one pass over several threads
+ *
+ * run() hands task indices 0..n-1 to the calling thread (index 0) and up to
+ * n-1 workers, and returns when all of them have finished, so the caller
+ * never waits idle.  Workers start on the first pass that needs them and
+ * sleep on a condition variable between passes.  Passes come from one
+ * thread at a time (the owner's update or cull call); they are not queued.
+ *
+ * Used by ParticleSimulation and BatchCuller.  Long-running jobs that
+ * finish on a later frame belong in MeshJobSystem instead.
+ */
+class ForkJoinPool {
+public:
+    using Task = std::function<void(unsigned int)>;
+
+    /**
+     * @param threadCount Threads sharing a pass, including the caller;
+     *        0 picks the hardware thread count
+     * @param maxThreads Upper bound on the thread count
+     */
+    explicit ForkJoinPool(unsigned int threadCount = 0, unsigned int maxThreads = 16)
+        : m_threadCount(threadCount)
+    {
+        if (m_threadCount == 0) m_threadCount = std::max(1u, std::thread::hardware_concurrency());
+        m_threadCount = std::max(1u, std::min(m_threadCount, maxThreads));
+    }
+
+    ~ForkJoinPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_taskReady.notify_all();
+        for (auto& worker : m_workers) {
+            if (worker.joinable()) worker.join();
+        }
+    }
+
+    ForkJoinPool(const ForkJoinPool&) = delete;
+    ForkJoinPool& operator=(const ForkJoinPool&) = delete;
+
+    unsigned int getThreadCount() const { return m_threadCount; }
+
+    /**
+     * Run task(0) .. task(taskCount - 1) and wait for all of them
+     *
+     * taskCount is clamped to the thread count; one task runs inline.
+     */
+    void run(unsigned int taskCount, const Task& task) {
+        taskCount = std::min(taskCount, m_threadCount);
+        if (taskCount <= 1) {
+            if (taskCount == 1) task(0);
+            return;
+        }
+
+        startWorkers();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_task = &task;
+            m_taskCount = taskCount;
+            m_tasksPending = taskCount - 1;
+            ++m_generation;
+        }
+        m_taskReady.notify_all();
+
+        // The calling thread works too
+        task(0);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_taskDone.wait(lock, [this]() { return m_tasksPending == 0; });
+        m_task = nullptr;
+    }
+
+    /**
+     * Call body(item, task) for every item in [0, itemCount); threads
+     * claim the next item until none are left, so uneven items balance
+     * @return Tasks that shared the pass
+     */
+    template <typename Body>
+    unsigned int forEach(size_t itemCount, Body&& body) {
+        unsigned int taskCount = static_cast<unsigned int>(std::min<size_t>(m_threadCount, itemCount));
+        if (taskCount <= 1) {
+            for (size_t i = 0; i < itemCount; ++i) body(i, 0u);
+            return 1;
+        }
+        std::atomic<size_t> next(0);
+        Task task = [&](unsigned int index) {
+            for (size_t i = next++; i < itemCount; i = next++) body(i, index);
+        };
+        run(taskCount, task);
+        return taskCount;
+    }
+
+private:
+    void startWorkers() {
+        if (!m_workers.empty()) return;
+        m_workers.reserve(m_threadCount - 1);
+        for (unsigned int index = 1; index < m_threadCount; ++index) {
+            m_workers.emplace_back(&ForkJoinPool::workerLoop, this, index);
+        }
+    }
+
+    void workerLoop(unsigned int index) {
+        uint64_t seen = 0;
+        for (;;) {
+            const Task* task = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_taskReady.wait(lock, [&]() { return m_stopping || (m_task && m_generation != seen); });
+                if (m_stopping) return;
+                seen = m_generation;
+                if (index >= m_taskCount) continue;
+                task = m_task;
+            }
+
+            (*task)(index);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_tasksPending == 0) m_taskDone.notify_one();
+        }
+    }
+
+    unsigned int m_threadCount;
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_taskReady;
+    std::condition_variable m_taskDone;
+    const Task* m_task = nullptr;
+    unsigned int m_taskCount = 0;
+    unsigned int m_tasksPending = 0;
+    uint64_t m_generation = 0;
+    bool m_stopping = false;
+};
+
+} // namespace atlas
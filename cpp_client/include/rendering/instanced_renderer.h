@@ -73,6 +73,12 @@ public:
      * Clear all instances
      */
     void clear();
+
+    /**
+     * Replace every instance with @p count from @p instances, growing the
+     * GPU buffer if they do not fit
+     */
+    void assign(const InstanceData* instances, unsigned int count);
     
     /**
      * Upload instance data to GPU
@@ -192,6 +198,22 @@ public:
      * Clear all instances (keeps mesh registrations)
      */
     void clearInstances();
+
+    /**
+     * Draw @p count instances of @p mesh from a per-frame list
+     *
+     * Each mesh gets a streaming batch on first use, refilled on every call,
+     * so draw lists rebuilt each frame (see RenderQueue) need no mesh
+     * registration or instance IDs.
+     */
+    void drawInstances(const std::shared_ptr<Mesh>& mesh, const InstanceData* instances,
+                       unsigned int count, Shader* shader);
+
+    /**
+     * Free the streaming batches of meshes not drawn since the last call;
+     * call once per frame after the draws
+     */
+    void trimStreams();
     
     /**
      * Clear everything (instances and mesh registrations)
@@ -228,6 +250,13 @@ private:
         unsigned int batchIndex;
     };
     std::unordered_map<int, InstanceLocation> m_instanceLocations;
+
+    // Streaming batches for drawInstances(), by mesh
+    struct Stream {
+        std::unique_ptr<InstanceBatch> batch;
+        bool used = false;
+    };
+    std::unordered_map<const Mesh*, Stream> m_streams;
     
     int m_nextInstanceId;
     Stats m_stats;
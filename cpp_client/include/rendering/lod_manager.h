@@ -1,14 +1,17 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <vector>
-#include <map>
+#include <unordered_map>
 #include <memory>
 
 namespace atlas {
 
-// Forward declaration
+// Forward declarations
 class FrustumCuller;
+class BatchCuller;
+struct BatchCullResult;
 
 /**
  * Level of Detail enum
@@ -33,32 +36,39 @@ struct LODConfig {
     float highUpdateRate = 30.0f;
     float mediumUpdateRate = 15.0f;
     float lowUpdateRate = 5.0f;
+
+    // Pixels a simplified mesh level may deviate from full detail on screen
+    float maxScreenSpaceError = 1.0f;
 };
 
 /**
- * LOD entity information
+ * Pixels one world unit covers at @p distance in front of a perspective
+ * camera (projection[1][1] is the cotangent of half the vertical FOV)
  */
-struct LODEntity {
-    unsigned int id;
-    glm::vec3 position;
-    float boundingRadius;
-    LODLevel currentLOD;
-    float lastUpdateTime;
-    bool isVisible;
-    
-    LODEntity()
-        : id(0)
-        , position(0.0f)
-        , boundingRadius(1.0f)
-        , currentLOD(LODLevel::HIGH)
-        , lastUpdateTime(0.0f)
-        , isVisible(true)
-    {}
-};
+inline float pixelsPerUnitAt(float distance, const glm::mat4& projection, float viewportHeight) {
+    return projection[1][1] * 0.5f * viewportHeight / (distance > 1e-3f ? distance : 1e-3f);
+}
+
+/**
+ * Mesh level to draw by screen-space error: the coarsest simplified level
+ * whose model-space error, projected, stays within @p maxPixelError
+ * @param errors Model-space error of each simplified level, finest first
+ * @param pixelsPerUnit Screen pixels per model-space unit at the model
+ * @return 0 for full detail, otherwise 1 + index into @p errors
+ */
+inline size_t selectMeshLOD(const std::vector<float>& errors, float pixelsPerUnit, float maxPixelError) {
+    size_t level = 0;
+    while (level < errors.size() && errors[level] * pixelsPerUnit <= maxPixelError) ++level;
+    return level;
+}
 
 /**
  * LOD Manager
  * Manages level-of-detail for entities based on distance from camera
+ *
+ * Entities are stored densely, one array per field, and update() culls and
+ * classifies all of them in one BatchCuller pass.  Unregistering moves the
+ * last entity into the freed slot, so entity order is not stable.
  */
 class LODManager {
 public:
@@ -114,7 +124,7 @@ public:
     bool isEntityVisible(unsigned int id) const;
 
     /**
-     * Get all visible entities
+     * Get all visible entities (as of the last update)
      */
     std::vector<unsigned int> getVisibleEntities() const;
 
@@ -158,13 +168,29 @@ public:
      */
     const FrustumCuller* getFrustumCuller() const;
 
+    /**
+     * Threads sharing update() once there are enough entities to split
+     */
+    unsigned int getCullThreadCount() const;
+
 private:
     LODConfig m_config;
-    std::map<unsigned int, LODEntity> m_entities;
     std::unique_ptr<FrustumCuller> m_frustumCuller;
+    std::unique_ptr<BatchCuller> m_batchCuller;
+    std::unique_ptr<BatchCullResult> m_cullResult;
+
+    // Entities by slot; m_slots maps an entity ID to its slot
+    std::unordered_map<unsigned int, size_t> m_slots;
+    std::vector<unsigned int> m_ids;
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_z;
+    std::vector<float> m_radius;
+    std::vector<uint8_t> m_lod;        // LODLevel
+    std::vector<float> m_lastUpdateTime;
+    bool m_cullCurrent = false;        // m_cullResult matches the slots
     
     // Helper methods
-    LODLevel calculateLOD(float distance) const;
     float getUpdateInterval(LODLevel lod) const;
 };
 
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace atlas {
+
+/**
+ * Map a whole file read-only
+ *
+ * The mapping stays valid while the returned pointer (or a copy) lives, even
+ * if the file is replaced or deleted meanwhile.
+ *
+ * @param path File to map
+ * @param bytes Receives the mapped size
+ * @return Start of the mapping, or nullptr on failure or an empty file
+ */
+std::shared_ptr<const void> mapFileReadOnly(const std::string& path, size_t& bytes);
+
+} // namespace atlas
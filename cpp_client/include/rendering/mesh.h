@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <glm/glm.hpp>
 
@@ -7,6 +10,11 @@ namespace atlas {
 
 /**
  * Mesh class - holds vertex data
+ *
+ * Construction only copies the vertex and index data, so meshes can be
+ * built on any thread.  The GPU buffers are created by upload(), which must
+ * run on the thread owning the GL context; draw() uploads on first use if
+ * nobody did so earlier.
  */
 struct Vertex {
     glm::vec3 position;
@@ -15,12 +23,79 @@ struct Vertex {
     glm::vec3 color;
 };
 
+/**
+ * Quantised vertex of converted binary models (20 bytes instead of 44)
+ *
+ * Uploaded as-is: GL expands the half floats and normalised integers to the
+ * same vec3/vec2 shader inputs as Vertex, so shaders need no changes.
+ * See packVertex() / unpackVertex() in binary_model.h.
+ */
+struct PackedVertex {
+    uint16_t position[4];       // half floats x, y, z, padding
+    uint32_t normal;            // signed normalised 10:10:10:2
+    uint16_t texCoords[2];      // half floats
+    uint8_t color[4];           // unsigned normalised r, g, b, 255
+};
+
+/**
+ * Read-only view of one mesh's vertex and index data
+ */
+struct MeshGeometryView {
+    const Vertex* vertices = nullptr;
+    size_t vertexCount = 0;
+    const unsigned int* indices = nullptr;
+    size_t indexCount = 0;
+};
+
+/**
+ * Every mesh of a model at one simplified level of detail, and how far
+ * (model-space distance) the level deviates from full detail
+ */
+struct MeshLodGeometry {
+    std::vector<MeshGeometryView> parts;
+    float error = 0.0f;
+};
+
+/**
+ * Read-only view of one quantised mesh; indices are 16 or 32 bits
+ */
+struct PackedMeshView {
+    const PackedVertex* vertices = nullptr;
+    size_t vertexCount = 0;
+    const void* indices = nullptr;
+    size_t indexCount = 0;
+    bool shortIndices = false;
+};
+
 class Mesh {
 public:
     Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+
+    /**
+     * Mesh over data owned elsewhere, such as a baked file mapped by
+     * MeshDiskCache.  Nothing is copied; @p storage keeps the data alive
+     * for the lifetime of the mesh.
+     */
+    Mesh(std::shared_ptr<const void> storage, const MeshGeometryView& geometry);
+
+    /**
+     * Quantised mesh over data owned elsewhere (a mapped binary model);
+     * getGeometry() is empty for these, use getPackedGeometry()
+     */
+    Mesh(std::shared_ptr<const void> storage, const PackedMeshView& packed);
     ~Mesh();
 
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+
     void draw() const;
+
+    /**
+     * Create the GPU buffers (GL thread only; no-op once uploaded)
+     */
+    void upload() const;
+
+    bool isUploaded() const { return m_VAO != 0; }
     
     /**
      * Draw with instancing
@@ -32,20 +107,46 @@ public:
      * Get VAO for instanced rendering setup
      * Allows external setup of instance attribute pointers
      */
-    unsigned int getVAO() const { return m_VAO; }
+    unsigned int getVAO() const { upload(); return m_VAO; }
     
     /**
      * Get index count
      */
-    size_t getIndexCount() const { return m_indices.size(); }
+    size_t getIndexCount() const { return m_packed ? m_packedGeometry.indexCount : m_geometry.indexCount; }
 
-private:
-    void setup();
+    /**
+     * Get vertex count
+     */
+    size_t getVertexCount() const { return m_packed ? m_packedGeometry.vertexCount : m_geometry.vertexCount; }
+
+    /**
+     * Vertex and index data, as uploaded (empty for quantised meshes)
+     */
+    const MeshGeometryView& getGeometry() const { return m_geometry; }
+
+    /**
+     * Quantised vertex and index data (empty unless isPacked())
+     */
+    const PackedMeshView& getPackedGeometry() const { return m_packedGeometry; }
 
+    bool isPacked() const { return m_packed; }
+
+    /**
+     * Bytes of vertex and index data (the GPU buffers hold the same again)
+     */
+    size_t getMemoryBytes() const;
+
+private:
+    // Owned data; empty when the mesh views external storage
     std::vector<Vertex> m_vertices;
     std::vector<unsigned int> m_indices;
+    std::shared_ptr<const void> m_storage;
+    MeshGeometryView m_geometry;
+    PackedMeshView m_packedGeometry;
+    bool m_packed = false;
 
-    unsigned int m_VAO, m_VBO, m_EBO;
+    // Created lazily by upload()
+    mutable unsigned int m_VAO, m_VBO, m_EBO;
 };
 
 } // namespace atlas
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include "rendering/mesh.h"
+
+namespace atlas {
+
+/**
+ * Axis-aligned box and bounding sphere of a mesh, in model space
+ *
+ * The sphere is centred on the box so merging and transforming stay cheap;
+ * it is never smaller than the geometry.
+ */
+struct MeshBounds {
+    glm::vec3 min{0.0f};
+    glm::vec3 max{0.0f};
+    glm::vec3 center{0.0f};
+    float radius = 0.0f;
+    bool valid = false;
+
+    glm::vec3 extents() const { return max - min; }
+};
+
+/**
+ * Bounds of @p count positions read with @p stride bytes between them
+ */
+inline MeshBounds computeMeshBounds(const glm::vec3* positions, size_t count, size_t stride = sizeof(glm::vec3)) {
+    MeshBounds bounds;
+    if (count == 0) return bounds;
+
+    auto at = [positions, stride](size_t i) -> const glm::vec3& {
+        return *reinterpret_cast<const glm::vec3*>(reinterpret_cast<const unsigned char*>(positions) + i * stride);
+    };
+    bounds.min = bounds.max = at(0);
+    for (size_t i = 1; i < count; ++i) {
+        bounds.min = glm::min(bounds.min, at(i));
+        bounds.max = glm::max(bounds.max, at(i));
+    }
+    bounds.center = (bounds.min + bounds.max) * 0.5f;
+    float radiusSq = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        glm::vec3 d = at(i) - bounds.center;
+        radiusSq = std::max(radiusSq, glm::dot(d, d));
+    }
+    bounds.radius = std::sqrt(radiusSq);
+    bounds.valid = true;
+    return bounds;
+}
+
+inline MeshBounds computeMeshBounds(const MeshGeometryView& geometry) {
+    if (geometry.vertexCount == 0) return MeshBounds();
+    return computeMeshBounds(&geometry.vertices[0].position, geometry.vertexCount, sizeof(Vertex));
+}
+
+/**
+ * Smallest bounds holding both @p a and @p b (the sphere is conservative)
+ */
+inline MeshBounds mergeMeshBounds(const MeshBounds& a, const MeshBounds& b) {
+    if (!a.valid) return b;
+    if (!b.valid) return a;
+    MeshBounds merged;
+    merged.min = glm::min(a.min, b.min);
+    merged.max = glm::max(a.max, b.max);
+    merged.center = (merged.min + merged.max) * 0.5f;
+    merged.radius = std::max(glm::length(a.center - merged.center) + a.radius,
+                             glm::length(b.center - merged.center) + b.radius);
+    merged.valid = true;
+    return merged;
+}
+
+} // namespace atlas
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace atlas {
+
+/**
+ * Identity of one generated mesh variant.
+ *
+ * Everything that changes the generated geometry is part of the key, so two
+ * entities with equal keys can always share one mesh.  Simplified levels of
+ * detail are not keyed separately: they live inside the cached model with
+ * the full mesh they were derived from.
+ */
+struct MeshCacheKey {
+    enum class Variant : uint8_t {
+        Full,       // the generated mesh
+        Proxy       // low-poly stand-in shown while the full mesh generates
+    };
+
+    std::string shipType;
+    std::string faction;
+    uint32_t seed = 0;
+    Variant variant = Variant::Full;
+
+    bool operator==(const MeshCacheKey& other) const {
+        return variant == other.variant && seed == other.seed &&
+               shipType == other.shipType && faction == other.faction;
+    }
+
+    /**
+     * "type/faction/seed", plus "/proxy" for a proxy, for logs and on-disk names
+     */
+    std::string toString() const;
+};
+
+struct MeshCacheKeyHash {
+    size_t operator()(const MeshCacheKey& key) const;
+};
+
+/**
+ * Cache counters
+ */
+struct MeshCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;          // each miss is one generation
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t residentBytes = 0;
+    size_t budgetBytes = 0;
+
+    double hitRate() const;
+};
+
+/**
+ * Shared, reference-counted cache of generated meshes
+ *
+ * acquire() runs the factory once per key and hands every later caller the
+ * same immutable object, so 300 identical frigates on grid cost one
+ * generation and one set of GPU buffers.  Entries are tracked in LRU order
+ * against a memory budget; trim() drops the least recently used entries
+ * that nobody outside the cache still holds until the budget is met.  An
+ * entry in use is never evicted: freeing it would save nothing and the next
+ * spawn would generate a duplicate.
+ *
+ * The factory runs without the lock held, so slow generation of one key
+ * does not stall lookups of others, and acquire() may be called from
+ * worker threads.  Only trim(), setBudget(), releaseUnused() and clear()
+ * destroy meshes, so call those on the thread that owns the GPU resources.
+ *
+ * @tparam T Mesh type (Model in the renderer; any type in headless tests)
+ */
+template <typename T>
+class MeshCache {
+public:
+    using Factory = std::function<std::shared_ptr<T>()>;
+    using SizeFunction = std::function<size_t(const T&)>;
+
+    /**
+     * @param budgetBytes Memory budget for resident meshes
+     * @param sizeOf Bytes used by one mesh
+     */
+    MeshCache(size_t budgetBytes, SizeFunction sizeOf)
+        : m_budgetBytes(budgetBytes)
+        , m_sizeOf(std::move(sizeOf))
+    {}
+
+    /**
+     * Get the mesh for @p key, generating it with @p factory on a miss
+     * @return Shared mesh, or nullptr if the factory failed (not cached)
+     */
+    std::shared_ptr<const T> acquire(const MeshCacheKey& key, const Factory& factory) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_entries.find(key);
+            if (it != m_entries.end()) {
+                ++m_stats.hits;
+                m_lru.splice(m_lru.begin(), m_lru, it->second.lruPosition);
+                return it->second.mesh;
+            }
+            ++m_stats.misses;
+        }
+
+        std::shared_ptr<T> generated = factory();
+        if (!generated) return nullptr;
+        size_t bytes = m_sizeOf ? m_sizeOf(*generated) : 0;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            // Another thread generated the same key meanwhile; keep the first
+            m_lru.splice(m_lru.begin(), m_lru, it->second.lruPosition);
+            return it->second.mesh;
+        }
+        m_lru.push_front(key);
+        Entry entry;
+        entry.mesh = std::move(generated);
+        entry.bytes = bytes;
+        entry.lruPosition = m_lru.begin();
+        std::shared_ptr<const T> result = entry.mesh;
+        m_entries.emplace(key, std::move(entry));
+        m_residentBytes += bytes;
+        return result;
+    }
+
+    /**
+     * Cached mesh for @p key, counted as a hit; nullptr on a miss, which is
+     * not counted (the acquire() that generates it will count it)
+     */
+    std::shared_ptr<const T> acquireCached(const MeshCacheKey& key) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it == m_entries.end()) return nullptr;
+        ++m_stats.hits;
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lruPosition);
+        return it->second.mesh;
+    }
+
+    /**
+     * Cached mesh for @p key without generating or touching LRU order
+     */
+    std::shared_ptr<const T> find(const MeshCacheKey& key) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        return it != m_entries.end() ? it->second.mesh : nullptr;
+    }
+
+    /**
+     * Evict unused entries until the budget is met (call after releasing meshes)
+     */
+    void trim() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        evictLocked();
+    }
+
+    /**
+     * Drop every entry nobody else holds, regardless of budget
+     */
+    void releaseUnused() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_lru.begin(); it != m_lru.end();) {
+            auto entry = m_entries.find(*it);
+            if (entry->second.mesh.use_count() == 1) {
+                m_residentBytes -= entry->second.bytes;
+                m_entries.erase(entry);
+                it = m_lru.erase(it);
+                ++m_stats.evictions;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+        m_lru.clear();
+        m_residentBytes = 0;
+    }
+
+    void setBudget(size_t budgetBytes) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_budgetBytes = budgetBytes;
+        evictLocked();
+    }
+
+    MeshCacheStats getStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        MeshCacheStats stats = m_stats;
+        stats.entries = m_entries.size();
+        stats.residentBytes = m_residentBytes;
+        stats.budgetBytes = m_budgetBytes;
+        return stats;
+    }
+
+    void resetStats() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats = MeshCacheStats();
+    }
+
+private:
+    struct Entry {
+        std::shared_ptr<const T> mesh;
+        size_t bytes = 0;
+        typename std::list<MeshCacheKey>::iterator lruPosition;
+    };
+
+    void evictLocked() {
+        // Oldest first; entries still referenced elsewhere are skipped
+        auto it = m_lru.end();
+        while (m_residentBytes > m_budgetBytes && it != m_lru.begin()) {
+            --it;
+            auto entry = m_entries.find(*it);
+            if (entry->second.mesh.use_count() > 1) continue;
+            m_residentBytes -= entry->second.bytes;
+            m_entries.erase(entry);
+            it = m_lru.erase(it);
+            ++m_stats.evictions;
+        }
+    }
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<MeshCacheKey, Entry, MeshCacheKeyHash> m_entries;
+    std::list<MeshCacheKey> m_lru;          // most recently used first
+    size_t m_budgetBytes;
+    size_t m_residentBytes = 0;
+    SizeFunction m_sizeOf;
+    MeshCacheStats m_stats;
+};
+
+} // namespace atlas
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "rendering/mesh.h"
+#include "rendering/mesh_cache.h"
+
+namespace atlas {
+
+/**
+ * A baked mesh mapped from disk
+ *
+ * Each part views vertex and index data inside the mapping, laid out exactly
+ * as Mesh uploads it, so building a Mesh from a part copies nothing.  The
+ * mapping lives as long as this object (hold it through Mesh's storage).
+ */
+struct BakedMesh {
+    std::vector<MeshGeometryView> parts;
+    std::vector<MeshLodGeometry> lods;  // simplified levels, coarsest last
+    size_t mappedBytes = 0;
+    std::shared_ptr<const void> mapping;
+};
+
+/**
+ * Disk cache counters
+ */
+struct MeshDiskCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;          // no baked file
+    uint64_t stale = 0;           // file from other code, assets or layout; rebaked
+    uint64_t writes = 0;
+    uint64_t writeFailures = 0;
+    uint64_t bytesMapped = 0;
+    uint64_t bytesWritten = 0;
+};
+
+/**
+ * Persistent cache of baked procedural meshes
+ *
+ * Procedural ships, stations and asteroids come out identical on every
+ * launch, so the first launch bakes each one into a file and later launches
+ * map that file instead of generating again.  One file holds one
+ * MeshCacheKey variant, with its simplified levels of detail:
+ *
+ *   header | part table | key | vertex and index blocks (16-byte aligned)
+ *
+ * The header records the format version, the byte order, sizeof(Vertex),
+ * the generator code version and a caller-supplied source stamp (hash of
+ * any asset files the generator read).  A file whose header disagrees with
+ * the running client is stale and is regenerated, so nobody has to clear
+ * the cache after changing a generator.  The code version is a hash of the
+ * generator sources computed by CMake (ATLAS_MESH_GENERATOR_HASH).
+ *
+ * Files are written to a temporary name and renamed into place, so workers
+ * may load and store concurrently and a crash never leaves a torn file.
+ * Files are little-endian and only read by the machine that wrote them.
+ */
+class MeshDiskCache {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 2;
+    static constexpr const char* DEFAULT_DIRECTORY = "cache/meshes";
+    static constexpr const char* FILE_EXTENSION = ".amesh";
+
+    /**
+     * @param directory Cache directory (created on first store)
+     * @param codeVersion Generator version baked files must match
+     */
+    explicit MeshDiskCache(const std::string& directory = DEFAULT_DIRECTORY,
+                           const std::string& codeVersion = generatorVersion());
+
+    /**
+     * Version of the mesh generators this client was built from
+     */
+    static std::string generatorVersion();
+
+    /**
+     * Map the baked file for @p key
+     * @param sourceStamp Must equal the stamp it was stored with
+     * @return Mapped mesh, or nullptr if missing, stale or corrupt
+     */
+    std::shared_ptr<const BakedMesh> load(const MeshCacheKey& key, uint64_t sourceStamp = 0);
+
+    /**
+     * Bake @p parts and their simplified levels @p lods for @p key,
+     * replacing any older file
+     * @return false if the file could not be written (the cache is optional)
+     */
+    bool store(const MeshCacheKey& key, const std::vector<MeshGeometryView>& parts,
+               uint64_t sourceStamp = 0, const std::vector<MeshLodGeometry>& lods = {});
+
+    /**
+     * Delete every baked file in the directory
+     * @return Number of files removed
+     */
+    size_t clear();
+
+    /**
+     * File that holds @p key
+     */
+    std::string pathFor(const MeshCacheKey& key) const;
+
+    const std::string& getDirectory() const { return m_directory; }
+    const std::string& getCodeVersion() const { return m_codeVersion; }
+
+    MeshDiskCacheStats getStats() const;
+    void resetStats();
+
+private:
+    std::string m_directory;
+    std::string m_codeVersion;
+
+    mutable std::mutex m_statsMutex;
+    MeshDiskCacheStats m_stats;
+};
+
+/**
+ * Single-part mesh for @p key from @p cache, or generate() baked into it on
+ * a miss.  Without a cache this is just generate().
+ */
+inline std::shared_ptr<Mesh> loadOrBakeMesh(MeshDiskCache* cache, const MeshCacheKey& key,
+                                            const std::function<std::shared_ptr<Mesh>()>& generate) {
+    if (cache) {
+        std::shared_ptr<const BakedMesh> baked = cache->load(key);
+        if (baked && baked->parts.size() == 1) {
+            return std::make_shared<Mesh>(baked, baked->parts[0]);
+        }
+    }
+    std::shared_ptr<Mesh> mesh = generate();
+    if (cache && mesh) {
+        cache->store(key, { mesh->getGeometry() });
+    }
+    return mesh;
+}
+
+} // namespace atlas
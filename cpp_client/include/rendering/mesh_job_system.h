@@ -0,0 +1,148 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * Timing of one finished mesh job (milliseconds)
+ */
+struct MeshJobTiming {
+    uint64_t id = 0;
+    std::string name;
+    double queueMs = 0.0;       // submitted -> picked up by a worker
+    double buildMs = 0.0;       // CPU-side generation on the worker
+    double waitMs = 0.0;        // built -> main thread got to it
+    double completeMs = 0.0;    // main-thread completion (GPU upload)
+    double totalMs = 0.0;       // submitted -> completed
+    bool failed = false;        // build threw
+};
+
+/**
+ * Aggregate job counters
+ */
+struct MeshJobStats {
+    uint64_t submitted = 0;
+    uint64_t built = 0;
+    uint64_t completed = 0;
+    uint64_t failed = 0;
+    size_t queued = 0;          // waiting for a worker
+    size_t building = 0;        // on a worker now
+    size_t ready = 0;           // built, waiting for processCompleted()
+
+    double buildMsTotal = 0.0;
+    double buildMsMax = 0.0;
+    double completeMsTotal = 0.0;
+    double completeMsMax = 0.0;
+    double queueMsMax = 0.0;
+
+    double averageBuildMs() const { return built ? buildMsTotal / static_cast<double>(built) : 0.0; }
+};
+
+/**
+ * Worker pool for procedural mesh generation
+ *
+ * A job is split in two: the build function runs on a worker thread and
+ * produces CPU-side geometry; the completion function runs on the main
+ * thread, from processCompleted(), and does whatever needs the GL context
+ * (buffer upload, swapping the finished model in for a proxy).
+ * processCompleted() stops once its time budget is spent, so a burst of
+ * finished jobs is spread over several frames instead of stalling one.
+ *
+ * Jobs start in submission order.  Destruction waits for builds already
+ * running and drops every other job without completing it.
+ */
+class MeshJobSystem {
+public:
+    using BuildFunction = std::function<void()>;
+    using CompleteFunction = std::function<void()>;
+
+    /**
+     * @param workerCount Worker threads; 0 picks hardware threads - 1 (at least 1)
+     */
+    explicit MeshJobSystem(unsigned int workerCount = 0);
+    ~MeshJobSystem();
+
+    MeshJobSystem(const MeshJobSystem&) = delete;
+    MeshJobSystem& operator=(const MeshJobSystem&) = delete;
+
+    /**
+     * Queue a job
+     * @param name Label for timing stats
+     * @param build Runs on a worker thread
+     * @param complete Runs on the thread calling processCompleted() (may be empty)
+     * @return Job id
+     */
+    uint64_t submit(const std::string& name, BuildFunction build,
+                    CompleteFunction complete = CompleteFunction());
+
+    /**
+     * Run completion functions of built jobs, oldest first, until
+     * @p budgetMs is spent.  At least one job completes per call when any
+     * is ready, so progress never stalls on an overlong upload.
+     * @return Number of jobs completed
+     */
+    size_t processCompleted(double budgetMs);
+
+    /**
+     * Block until every submitted job has been built (not completed)
+     */
+    void waitForBuilds();
+
+    size_t getWorkerCount() const { return m_workers.size(); }
+
+    /**
+     * Jobs queued, building or awaiting completion
+     */
+    size_t getPendingCount() const;
+
+    MeshJobStats getStats() const;
+
+    /**
+     * Timings of the most recently completed jobs, oldest first
+     */
+    std::vector<MeshJobTiming> getRecentTimings() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job {
+        uint64_t id = 0;
+        std::string name;
+        BuildFunction build;
+        CompleteFunction complete;
+        Clock::time_point submittedAt;
+        Clock::time_point builtAt;
+        MeshJobTiming timing;
+    };
+
+    static constexpr size_t MAX_RECENT_TIMINGS = 256;
+
+    void workerLoop();
+    void recordTiming(const MeshJobTiming& timing);
+
+    std::vector<std::thread> m_workers;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_buildFinished;
+    std::deque<Job> m_queue;
+    std::deque<Job> m_ready;
+    size_t m_building = 0;
+    bool m_stopping = false;
+    uint64_t m_nextId = 1;
+
+    MeshJobStats m_stats;
+    std::deque<MeshJobTiming> m_recent;
+};
+
+} // namespace atlas
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "rendering/mesh.h"
+
+namespace atlas {
+
+/**
+ * Mesh simplification for levels of detail
+ *
+ * Edges are collapsed cheapest first by quadric error (Garland and
+ * Heckbert), in passes as meshoptimizer's simplifier does.  A vertex is only
+ * ever moved onto a neighbour, so the result indexes the source vertex array
+ * and every attribute stays exact.
+ *
+ * Vertices sharing a position but not attributes (UV seams, hard normal
+ * edges, colour boundaries) collapse together along the seam or not at all,
+ * so seams never crack.  Open borders only collapse along themselves and
+ * carry extra error to keep their outline.  Collapses that would flip a
+ * triangle are rejected.
+ *
+ * CPU only; runs on any thread.
+ */
+
+/** Simplified levels a model keeps besides full detail */
+constexpr size_t MAX_MESH_LODS = 3;
+
+/**
+ * Simplify @p mesh to at most @p targetIndexCount indices, stopping earlier
+ * once the next collapse would exceed @p targetError
+ * @param targetError Allowed deviation, as a fraction of simplificationScale()
+ * @param resultError If given, receives the deviation reached (same unit)
+ * @return Triangle list indexing mesh.vertices
+ */
+std::vector<unsigned int> simplifyMesh(const MeshGeometryView& mesh, size_t targetIndexCount,
+                                       float targetError, float* resultError = nullptr);
+
+/**
+ * Simplify @p mesh by clustering vertices on a grid, ignoring topology, to
+ * at most @p targetIndexCount indices where @p targetError allows.  Coarser
+ * than simplifyMesh() can reach on meshes made of open shells, but holes may
+ * close or open and attributes snap to one vertex per cell; meant for levels
+ * only seen a few pixels tall.
+ * @param targetError Allowed vertex displacement, as a fraction of simplificationScale()
+ * @param resultError If given, receives the largest displacement (same unit)
+ * @return Triangle list indexing mesh.vertices
+ */
+std::vector<unsigned int> simplifyMeshSloppy(const MeshGeometryView& mesh, size_t targetIndexCount,
+                                             float targetError, float* resultError = nullptr);
+
+/**
+ * Largest side of the bounding box of @p mesh; simplifyMesh() errors times
+ * this are model-space distances
+ */
+float simplificationScale(const MeshGeometryView& mesh);
+
+/**
+ * One simplified level of a mesh, with unused vertices dropped
+ */
+struct MeshLod {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    float error = 0.0f;         // model-space deviation from full detail
+};
+
+/**
+ * How buildMeshLods() steps down
+ */
+struct MeshLodSettings {
+    float ratios[MAX_MESH_LODS] = { 0.4f, 0.15f, 0.05f };  // triangles kept, of full detail
+    float maxError = 0.2f;      // fraction of simplificationScale() any level may deviate
+    float minReduction = 0.2f;  // drop levels saving less than this of the previous one
+};
+
+/**
+ * Simplified levels of @p mesh, coarsest last; full detail is not included.
+ * A level simplifyMesh() cannot bring to its ratio falls back to
+ * simplifyMeshSloppy().  Stops early when the error limit keeps a level from
+ * getting cheaper.
+ */
+std::vector<MeshLod> buildMeshLods(const MeshGeometryView& mesh,
+                                   const MeshLodSettings& settings = MeshLodSettings());
+
+} // namespace atlas
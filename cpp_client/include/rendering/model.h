@@ -4,12 +4,18 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include <functional>
 #include <glm/glm.hpp>
 #include "rendering/mesh.h"
+#include "rendering/mesh_bounds.h"
+#include "rendering/mesh_cache.h"
+#include "rendering/mesh_simplifier.h"
 
 namespace atlas {
 
 class Mesh;
+class MeshDiskCache;
+struct BakedMesh;
 struct ShipPart;
 
 /**
@@ -67,9 +73,11 @@ struct ShipDesignTraits {
  * Features:
  * - Procedural generation for all ship classes (frigates to titans)
  * - Faction-specific color schemes and design patterns for 7 factions
- * - Model caching to prevent duplicate geometry generation
+ * - Deterministic per-variant generation, so identical ships can share one
+ *   Model through MeshCache (see Renderer::createEntityVisual)
  * - Support for stations and asteroids
  * - Tech I and Tech II ship variants with visual differentiation
+ * - Simplified levels of detail, picked per draw by screen-space error
  */
 class Model {
 public:
@@ -78,9 +86,18 @@ public:
 
     /**
      * Load model from file
+     *
+     * .amdl files are mapped directly.  For .obj, .gltf and .glb sources a
+     * converted .amdl next to the source is used instead when it is at least
+     * as new (see atlas_model_convert).
      */
     bool loadFromFile(const std::string& path);
 
+    /**
+     * Parse an OBJ or glTF source, ignoring any converted binary
+     */
+    bool loadSourceFile(const std::string& path);
+
     /**
      * Create procedural ship model with basic geometry
      * 
@@ -113,17 +130,148 @@ public:
     static std::unique_ptr<Model> createShipModelWithRacialDesign(const std::string& shipType, const std::string& faction);
 
     /**
-     * Draw the model
+     * Create a cheap stand-in shown while the real model is generated
+     *
+     * A flat-shaded elongated octahedron with roughly the hull length and
+     * radius of the ship class, in the faction's primary colour.
+     *
+     * @param shipType The type/class of ship
+     * @param faction The faction
+     * @return Unique pointer to the proxy Model
+     */
+    static std::unique_ptr<Model> createProxyModel(const std::string& shipType, const std::string& faction);
+
+    /**
+     * Seed the procedural generators use for a ship type and faction.
+     * Part of the mesh cache key, since it determines the geometry.
+     */
+    static unsigned int shipSeed(const std::string& shipType, const std::string& faction);
+
+    /**
+     * Mesh cache key of the full-detail model for a ship type and faction
+     */
+    static MeshCacheKey shipCacheKey(const std::string& shipType, const std::string& faction);
+
+    /**
+     * Hash of the asset files createShipModel() would read for this ship
+     * (path, size and modification time), 0 for purely procedural hulls.
+     * Baked models are rebuilt when it changes.
+     */
+    static uint64_t shipSourceStamp(const std::string& shipType, const std::string& faction);
+
+    /**
+     * createShipModel() through a disk cache: maps the baked model if it is
+     * current, otherwise generates it and bakes it for the next launch
+     * @param diskCache Disk cache, or nullptr to always generate
+     */
+    static std::unique_ptr<Model> loadOrCreateShipModel(const std::string& shipType, const std::string& faction,
+                                                        MeshDiskCache* diskCache);
+
+    /**
+     * Map the baked model for @p key, or generate() it, build its levels of
+     * detail and bake both for the next launch.  Models generate() maps
+     * from a converted .amdl keep the levels stored there and are not baked.
+     * @param diskCache Disk cache, or nullptr to always generate
+     * @param sourceStamp Hash of the assets generate() reads (see shipSourceStamp())
+     */
+    static std::unique_ptr<Model> loadOrBakeModel(MeshDiskCache* diskCache, const MeshCacheKey& key,
+                                                  uint64_t sourceStamp,
+                                                  const std::function<std::unique_ptr<Model>()>& generate);
+
+    /**
+     * Model whose meshes view a baked file without copying it
+     */
+    static std::unique_ptr<Model> createFromBaked(const std::shared_ptr<const BakedMesh>& baked);
+
+    /**
+     * Vertex and index data of every mesh, for baking
+     * (empty views for meshes mapped from a binary model)
+     */
+    std::vector<MeshGeometryView> getGeometry() const;
+
+    /**
+     * Model-space bounds of all meshes; stored in binary models, otherwise
+     * computed on first call
+     */
+    const MeshBounds& getBounds() const;
+
+    /**
+     * Build simplified levels of detail from the full-detail meshes,
+     * replacing any present (meshes mapped from a binary model are kept as
+     * they are)
+     */
+    void generateLods(const MeshLodSettings& settings = MeshLodSettings());
+
+    /**
+     * Append a simplified level, coarser than the last
+     * @param error Model-space deviation from full detail
+     */
+    void addLod(std::vector<std::shared_ptr<Mesh>> meshes, float error);
+
+    /**
+     * Levels of detail, counting full detail as level 0
      */
-    void draw() const;
+    size_t getLodCount() const { return m_lods.size() + 1; }
+
+    /**
+     * Model-space deviation of @p level from full detail
+     */
+    float getLodError(size_t level) const { return level == 0 ? 0.0f : m_lodErrors[level - 1]; }
+
+    /**
+     * Vertex and index data of the simplified levels, for baking
+     */
+    std::vector<MeshLodGeometry> getLodGeometry() const;
+
+    /**
+     * Coarsest level whose error covers at most @p maxPixelError pixels
+     * @param pixelsPerUnit Screen pixels per model-space unit (pixelsPerUnitAt()
+     *        times the model's scale)
+     */
+    size_t selectLod(float pixelsPerUnit, float maxPixelError) const;
+
+    /**
+     * Triangles drawn at @p level
+     */
+    size_t getTriangleCount(size_t level = 0) const;
+
+    /**
+     * Meshes drawn at @p level, for callers batching draws across models
+     */
+    const std::vector<std::shared_ptr<Mesh>>& getMeshes(size_t level = 0) const;
+
+    /**
+     * Draw the model at a level of detail (full detail by default)
+     */
+    void draw(size_t level = 0) const;
+
+    /**
+     * Bytes of vertex and index data across all meshes and levels
+     */
+    size_t getMemoryBytes() const;
+
+    /**
+     * Create GPU buffers for meshes not yet uploaded (GL thread only)
+     * @return Bytes uploaded by this call
+     */
+    size_t upload() const;
+
+    /**
+     * True once every mesh has its GPU buffers
+     */
+    bool isUploaded() const;
 
     /**
      * Add a mesh to the model
      */
-    void addMesh(std::unique_ptr<Mesh> mesh);
+    void addMesh(std::shared_ptr<Mesh> mesh);
 
 private:
-    std::vector<std::unique_ptr<Mesh>> m_meshes;
+    // Levels share meshes that did not simplify
+    std::vector<std::shared_ptr<Mesh>> m_meshes;
+    std::vector<std::vector<std::shared_ptr<Mesh>>> m_lods;  // levels 1 and up
+    std::vector<float> m_lodErrors;
+    mutable MeshBounds m_bounds;
 
     /**
      * Model loading helper methods
@@ -131,6 +279,7 @@ private:
      */
     bool loadOBJ(const std::string& path);
     bool loadGLTF(const std::string& path);
+    bool loadBinary(const std::string& path);
 
     /**
      * Find OBJ model file for a given ship type and faction
@@ -142,6 +291,17 @@ private:
      */
     static std::string findOBJModelPath(const std::string& shipType, const std::string& faction);
 
+    /**
+     * Hull class used to pick a seed OBJ for procedural generation
+     * ("frigate" ... "titan", or "generic")
+     */
+    static std::string seedClassFor(const std::string& shipType);
+
+    /**
+     * Seed OBJ createShipModel() generates this ship from, or empty
+     */
+    static std::string findSeedOBJPath(const std::string& shipType, const std::string& faction);
+
     /**
      * Ship type classification helpers
      * These methods determine which procedural generation function to use
@@ -207,13 +367,6 @@ private:
      */
     static void addPartToMesh(const ShipPart* part, const glm::mat4& transform,
                               std::vector<Vertex>& allVertices, std::vector<unsigned int>& allIndices);
-
-    /**
-     * Model cache for sharing geometry between instances
-     * Key: "shipType_faction" string
-     * Value: Shared pointer to Model for reuse
-     */
-    static std::map<std::string, std::shared_ptr<Model>> s_modelCache;
 };
 
 } // namespace atlas
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include "rendering/mesh.h"
+
+namespace atlas {
+
+/**
+ * Counters and timings of one occlusion frame (milliseconds)
+ */
+struct OcclusionStats {
+    size_t occluders = 0;
+    size_t occluderTriangles = 0;     // submitted
+    size_t trianglesRasterized = 0;   // after near clipping and size rejection
+    size_t tested = 0;
+    size_t occluded = 0;
+    double rasterMs = 0.0;
+    double pyramidMs = 0.0;
+    double testMs = 0.0;
+
+    double totalMs() const { return rasterMs + pyramidMs + testMs; }
+    float occludedRate() const { return tested ? static_cast<float>(occluded) / static_cast<float>(tested) : 0.0f; }
+};
+
+/**
+ * Software occlusion culling on the CPU
+ *
+ * Each frame a few large occluders (stations, big hulls, at a coarse level
+ * of detail) are rasterised into a small depth buffer, nearest depth per
+ * pixel, four pixels at a time with SSE2.  A max-depth pyramid built from
+ * it then answers box queries with a handful of reads: a box is hidden
+ * when its nearest point lies behind the farthest occluder depth over its
+ * whole screen footprint.
+ *
+ * Nothing here touches GL, so the renderer can cull before submission and
+ * tests can run headless.  Queries are conservative: boxes crossing the
+ * near plane or leaving the screen count as visible.
+ *
+ * Usage per frame: beginFrame(), addOccluder() for each occluder, then any
+ * number of isBoxVisible() calls (the pyramid is built on the first one).
+ */
+class OcclusionCuller {
+public:
+    /**
+     * @param width Depth buffer width in pixels (rounded up to a multiple of 4)
+     * @param height Depth buffer height in pixels
+     */
+    explicit OcclusionCuller(int width = DEFAULT_WIDTH, int height = DEFAULT_HEIGHT);
+
+    /**
+     * Clear the depth buffer and counters for a new view
+     */
+    void beginFrame(const glm::mat4& viewProjection);
+
+    /**
+     * Rasterise a mesh into the depth buffer (either winding)
+     * @param model Model-to-world transform of the occluder
+     */
+    void addOccluder(const MeshGeometryView& mesh, const glm::mat4& model);
+
+    /**
+     * Rasterise one triangle given in world space
+     */
+    void addTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c);
+
+    /**
+     * False when the box is certainly hidden behind the occluders
+     * @param min, max Model-space box corners
+     * @param model Model-to-world transform of the box
+     */
+    bool isBoxVisible(const glm::vec3& min, const glm::vec3& max, const glm::mat4& model = glm::mat4(1.0f));
+
+    const OcclusionStats& getStats() const { return m_stats; }
+
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+
+    /**
+     * Nearest occluder depth per pixel (NDC z, 1 where nothing was drawn),
+     * rows bottom to top
+     */
+    const std::vector<float>& getDepthBuffer() const { return m_depth; }
+
+    /**
+     * Pyramid levels above the depth buffer (builds it if needed)
+     */
+    size_t getPyramidLevels();
+
+    static constexpr int DEFAULT_WIDTH = 256;
+    static constexpr int DEFAULT_HEIGHT = 128;
+
+private:
+    struct Level {
+        int width = 0;
+        int height = 0;
+        std::vector<float> depth;   // farthest depth of the 2x2 texels below
+    };
+
+    void rasterizeClipped(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+    void rasterize(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c);
+    void buildPyramid();
+    float farthestDepth(int x0, int y0, int x1, int y1);
+
+    int m_width;
+    int m_height;
+    glm::mat4 m_viewProjection{1.0f};
+    std::vector<float> m_depth;
+    std::vector<glm::vec4> m_clipVertices;    // scratch for addOccluder()
+    std::vector<Level> m_pyramid;
+    bool m_pyramidValid = false;
+    OcclusionStats m_stats;
+};
+
+} // namespace atlas
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "rendering/fork_join_pool.h"
+
+namespace atlas {
+
+/**
+ * Particle structure
+ *
+ * Describes one particle when spawning or inspecting it; the simulation
+ * itself keeps particles in ParticlePool's per-component arrays.
+ */
+struct Particle {
+    glm::vec3 position;
+    glm::vec3 velocity;
+    glm::vec4 color;
+    float life;       // Remaining life time
+    float maxLife;    // Maximum life time
+    float size;
+
+    Particle() : life(0.0f), maxLife(1.0f), size(1.0f) {}
+
+    bool isAlive() const { return life > 0.0f; }
+
+    void update(float deltaTime) {
+        life -= deltaTime;
+        position += velocity * deltaTime;
+    }
+};
+
+/**
+ * Particle emitter types
+ */
+enum class EmitterType {
+    ENGINE_TRAIL,
+    EXPLOSION,
+    SHIELD_HIT,
+    WEAPON_BEAM,
+    WARP_TUNNEL,
+    DEBRIS
+};
+
+/**
+ * Point sprite vertex streamed to the GPU (20 bytes)
+ */
+struct ParticleVertex {
+    glm::vec3 position;
+    uint8_t color[4];   // unsigned normalised RGBA
+    float size;
+};
+
+/**
+ * Small, fast random numbers for spawning (PCG32)
+ *
+ * Each emitter owns one, so spawning needs no shared state and a seeded
+ * emitter replays the same particles.
+ */
+class ParticleRandom {
+public:
+    explicit ParticleRandom(uint64_t seed = 0x853c49e6748fea9bULL) { this->seed(seed); }
+
+    void seed(uint64_t seed) {
+        m_state = 0;
+        next();
+        m_state += seed;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t old = m_state;
+        m_state = old * 6364136223846793005ULL + INCREMENT;
+        uint32_t xorShifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        uint32_t rotation = static_cast<uint32_t>(old >> 59u);
+        return (xorShifted >> rotation) | (xorShifted << ((32u - rotation) & 31u));
+    }
+
+    /**
+     * Uniform in [min, max)
+     */
+    float uniform(float min, float max) {
+        return min + (max - min) * static_cast<float>(next() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    /**
+     * Random point within @p radius, denser towards the centre
+     */
+    glm::vec3 inSphere(float radius);
+
+private:
+    static constexpr uint64_t INCREMENT = 1442695040888963407ULL;
+    uint64_t m_state = 0;
+};
+
+/**
+ * Live particles of one emitter in structure-of-arrays layout
+ *
+ * Integration walks each component array with SIMD (8 particles per step
+ * with AVX, 4 with SSE2).  Dead particles are replaced by the last live
+ * one, so removal moves only as many particles as died and the live
+ * particles stay in [0, size()).  Order is not preserved.
+ */
+class ParticlePool {
+public:
+    explicit ParticlePool(uint64_t seed = 0);
+
+    /**
+     * Append a particle (the caller enforces any particle budget)
+     */
+    void add(const Particle& particle);
+
+    /**
+     * Append @p count uninitialised particles for set() to fill
+     * @return Index of the first one
+     */
+    size_t grow(size_t count);
+
+    /**
+     * Overwrite one particle; safe on distinct indices from several threads
+     */
+    void set(size_t index, const Particle& particle);
+
+    /**
+     * Age and move particles [begin, end); safe to run on disjoint ranges
+     * from several threads
+     */
+    void integrate(size_t begin, size_t end, float deltaTime);
+
+    /**
+     * Swap-remove every particle whose life ran out
+     * @return Particles removed
+     */
+    size_t removeDead();
+
+    /**
+     * integrate() everything, then removeDead()
+     */
+    size_t update(float deltaTime);
+
+    /**
+     * Interleave particles [begin, end) into GPU vertices
+     */
+    void writeVertices(size_t begin, size_t end, ParticleVertex* out) const;
+
+    /**
+     * Copy of one live particle
+     */
+    Particle get(size_t index) const;
+
+    void clear();
+    void reserve(size_t count);
+
+    size_t size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+
+    /**
+     * Emitter's own random numbers for spawning
+     */
+    ParticleRandom& getRandom() { return m_random; }
+
+private:
+    size_t m_count = 0;
+    std::vector<float> m_x, m_y, m_z;
+    std::vector<float> m_vx, m_vy, m_vz;
+    std::vector<float> m_life;
+    std::vector<float> m_maxLife;
+    std::vector<float> m_size;
+    std::vector<uint32_t> m_color;   // RGBA8, as streamed
+    ParticleRandom m_random;
+};
+
+/**
+ * One effect's particles, queued with ParticleSimulation::spawn()
+ *
+ * The emitter type picks the shape.  @c direction is the engine's velocity
+ * for a trail, the end point for a weapon beam and the heading for a warp
+ * tunnel; @c scale sizes an explosion; @c color tints a weapon beam.
+ */
+struct ParticleBurst {
+    EmitterType type = EmitterType::DEBRIS;
+    glm::vec3 position{0.0f};
+    glm::vec3 direction{0.0f};
+    glm::vec4 color{1.0f};
+    float scale = 1.0f;
+    uint32_t count = 0;
+    uint64_t seed = 0;          // drawn from the emitter by spawn()
+};
+
+/**
+ * Counters and timings of the last update (milliseconds)
+ */
+struct ParticleUpdateStats {
+    size_t particles = 0;       // alive after the update
+    size_t spawned = 0;         // created from queued bursts
+    size_t removed = 0;
+    size_t rejected = 0;        // spawns refused over budget since the previous update
+    unsigned int tasks = 0;     // threads that shared the update
+    double spawnMs = 0.0;
+    double integrateMs = 0.0;
+    double compactMs = 0.0;
+
+    double totalMs() const { return spawnMs + integrateMs + compactMs; }
+};
+
+/**
+ * CPU particle simulation: one pool per emitter type under a shared budget
+ *
+ * Updates first create the particles of queued bursts, then integrate
+ * fixed-size ranges of every pool, then compact the pools, each step split
+ * over a ForkJoinPool (the calling thread included).  Nothing
+ * here touches GL, so the simulation can be tested and benchmarked headless;
+ * ParticleSystem streams writeVertices() to the GPU.
+ */
+class ParticleSimulation {
+public:
+    /**
+     * @param maxParticles Live particles across all emitters
+     * @param threadCount Threads sharing an update, including the caller;
+     *        0 picks the hardware thread count (at most MAX_THREADS)
+     */
+    explicit ParticleSimulation(size_t maxParticles = DEFAULT_MAX_PARTICLES, unsigned int threadCount = 0);
+
+    ParticleSimulation(const ParticleSimulation&) = delete;
+    ParticleSimulation& operator=(const ParticleSimulation&) = delete;
+
+    /**
+     * Spawn a particle from @p type's emitter
+     * @return False when the budget is full (the particle is dropped)
+     */
+    bool add(EmitterType type, const Particle& particle);
+
+    /**
+     * Queue a burst; its particles are created in parallel by the next update()
+     *
+     * The burst's seed is drawn from the emitter's random numbers and each
+     * SPAWN_CHUNK of particles is seeded from it, so a seeded emitter
+     * replays the same particles whatever the thread count.  Particles over
+     * the budget are dropped at update() and counted as rejected.
+     */
+    void spawn(ParticleBurst burst);
+
+    /**
+     * Particles queued by spawn() and not yet created
+     */
+    size_t getPendingCount() const { return m_pending; }
+
+    /**
+     * Pool and random numbers of one emitter
+     */
+    ParticlePool& getEmitter(EmitterType type) { return m_pools[static_cast<size_t>(type)]; }
+    const ParticlePool& getEmitter(EmitterType type) const { return m_pools[static_cast<size_t>(type)]; }
+
+    /**
+     * Create queued bursts, advance every particle and drop the dead ones
+     */
+    void update(float deltaTime);
+
+    /**
+     * Interleave every live particle, emitter by emitter
+     * @param out Room for at least getParticleCount() vertices
+     * @return Vertices written
+     */
+    size_t writeVertices(ParticleVertex* out) const;
+
+    void clear();
+
+    size_t getParticleCount() const { return m_count; }
+
+    void setMaxParticles(size_t maxCount) { m_maxParticles = maxCount; }
+    size_t getMaxParticles() const { return m_maxParticles; }
+
+    /**
+     * Particles per range handed to one thread
+     */
+    void setSplitSize(size_t particles) { m_splitSize = particles > 0 ? particles : 1; }
+    size_t getSplitSize() const { return m_splitSize; }
+
+    unsigned int getThreadCount() const { return m_tasks.getThreadCount(); }
+
+    const ParticleUpdateStats& getStats() const { return m_stats; }
+
+    /**
+     * Particles integrated per instruction in this build (8, 4 or 1)
+     */
+    static unsigned int getSimdWidth();
+
+    static constexpr size_t EMITTER_COUNT = 6;
+    static constexpr size_t DEFAULT_MAX_PARTICLES = 1u << 20;
+    static constexpr size_t DEFAULT_SPLIT_SIZE = 32768;
+    static constexpr size_t SPAWN_CHUNK = 1024;
+    static constexpr unsigned int MAX_THREADS = 16;
+
+private:
+    struct Range {
+        ParticlePool* pool;
+        size_t begin;
+        size_t end;
+    };
+
+    // Up to SPAWN_CHUNK particles of one burst, written from pool index first
+    struct SpawnChunk {
+        const ParticleBurst* burst;
+        ParticlePool* pool;
+        size_t first;
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    void createBursts();
+
+    std::array<ParticlePool, EMITTER_COUNT> m_pools;
+    size_t m_count = 0;
+    size_t m_maxParticles;
+    size_t m_splitSize = DEFAULT_SPLIT_SIZE;
+    std::vector<Range> m_ranges;
+    std::vector<ParticleBurst> m_bursts;
+    std::vector<SpawnChunk> m_chunks;
+    size_t m_pending = 0;
+    size_t m_rejected = 0;
+    ParticleUpdateStats m_stats;
+    ForkJoinPool m_tasks;
+};
+
+} // namespace atlas
@@ -1,49 +1,26 @@
 #pragma once
 
-#include <vector>
+#include <cstddef>
 #include <memory>
 #include <glm/glm.hpp>
+#include "rendering/particle_simulation.h"
 
 namespace atlas {
 
 class Shader;
 
-/**
- * Particle structure
- */
-struct Particle {
-    glm::vec3 position;
-    glm::vec3 velocity;
-    glm::vec4 color;
-    float life;       // Remaining life time
-    float maxLife;    // Maximum life time
-    float size;
-    
-    Particle() : life(0.0f), maxLife(1.0f), size(1.0f) {}
-    
-    bool isAlive() const { return life > 0.0f; }
-    
-    void update(float deltaTime) {
-        life -= deltaTime;
-        position += velocity * deltaTime;
-    }
-};
-
-/**
- * Particle emitter types
- */
-enum class EmitterType {
-    ENGINE_TRAIL,
-    EXPLOSION,
-    SHIELD_HIT,
-    WEAPON_BEAM,
-    WARP_TUNNEL,
-    DEBRIS
-};
-
 /**
  * Particle System
  * Manages particle emission, update, and rendering
+ *
+ * Simulation runs in ParticleSimulation (one pool per emitter type).  The
+ * create*() effects queue a ParticleBurst, whose particles the next
+ * update() creates across the simulation's threads.  Each
+ * frame only the live particles are written into a persistently mapped
+ * vertex buffer, cycling through three regions guarded by fences so the
+ * CPU never writes what the GPU is still reading.  Without buffer storage
+ * (GL 4.4 / ARB_buffer_storage) the live range is mapped and invalidated
+ * each frame instead.
  */
 class ParticleSystem {
 public:
@@ -108,26 +85,45 @@ public:
     /**
      * Get active particle count
      */
-    size_t getParticleCount() const { return m_particles.size(); }
+    size_t getParticleCount() const { return m_simulation.getParticleCount(); }
 
     /**
      * Set maximum particle count
      */
-    void setMaxParticles(size_t maxCount) { m_maxParticles = maxCount; }
+    void setMaxParticles(size_t maxCount) { m_simulation.setMaxParticles(maxCount); }
+
+    /**
+     * Simulation pools, thread count and last update timings
+     */
+    const ParticleSimulation& getSimulation() const { return m_simulation; }
+
+    /**
+     * True when particles stream through a persistently mapped buffer
+     */
+    bool isPersistentlyMapped() const { return m_mapped != nullptr; }
+
+    static constexpr unsigned int STREAM_REGIONS = 3;
+    static constexpr size_t MIN_STREAM_CAPACITY = 65536;
 
 private:
-    std::vector<Particle> m_particles;
-    size_t m_maxParticles;
+    ParticleSimulation m_simulation;
     
     // OpenGL resources
     unsigned int m_vao;
     unsigned int m_vbo;
     std::unique_ptr<Shader> m_shader;
+
+    // Vertex stream: STREAM_REGIONS regions of m_streamCapacity particles
+    bool m_bufferStorage;
+    size_t m_streamCapacity;
+    unsigned int m_streamRegion;
+    ParticleVertex* m_mapped;              // persistent mapping, or nullptr
+    void* m_fences[STREAM_REGIONS];        // GLsync per region
     
     // Helper methods
-    void addParticle(const Particle& particle);
-    void removeDeadParticles();
-    void updateBuffers();
+    void createStreamBuffer(size_t capacity);
+    void releaseStreamBuffer();
+    bool streamVertices(size_t& first);
 };
 
 } // namespace atlas
@@ -142,7 +142,8 @@ public:
 
     /**
      * Parse a Wavefront OBJ file into an OBJSeedMesh.
-     * Uses tinyobjloader internally.
+     * Uses tinyobjloader internally, or maps the converted .amdl next to
+     * the file when it is current (indexed and welded, see binary_model.h).
      *
      * @param path  Absolute or relative path to the .obj file.
      * @return      Populated seed mesh, or empty mesh on failure.
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include "rendering/instanced_renderer.h"
+
+namespace atlas {
+
+/**
+ * Model matrix of an entity: translation, then yaw (Y), pitch (X) and roll
+ * (Z), then uniform scale.  The same matrix as chaining glm::translate,
+ * three glm::rotate calls and glm::scale, built from one sine and cosine
+ * per angle instead of three 4x4 products.
+ * @param rotation Euler angles in radians (pitch, yaw, roll)
+ */
+glm::mat4 composeEntityTransform(const glm::vec3& position, const glm::vec3& rotation, float scale);
+
+/**
+ * Draw calls of one frame's queue
+ */
+struct RenderQueueStats {
+    size_t items = 0;             // meshes submitted: draw calls without batching
+    size_t drawCalls = 0;         // instanced draws after batching
+    size_t materialChanges = 0;   // shader binds
+    size_t meshChanges = 0;       // vertex array binds
+
+    /** Submitted meshes per draw call */
+    float batchingFactor() const;
+};
+
+/**
+ * One instanced draw: consecutive instances of a mesh in one material
+ */
+template <typename T>
+struct DrawBatch {
+    std::shared_ptr<T> mesh;
+    uint32_t material = 0;
+    size_t firstInstance = 0;
+    size_t instanceCount = 0;
+};
+
+/**
+ * Per-frame draw list for entity visuals
+ *
+ * The renderer submits every visible mesh with its instance data; build()
+ * groups submissions sharing a mesh and material into one instance range
+ * each and orders the ranges by material, then mesh, so every shader and
+ * vertex array is bound once.  Instances within a range run front to back
+ * for early depth rejection.  A fleet of 500 hulls built from a dozen
+ * meshes becomes a dozen instanced draws instead of 500 draws.
+ *
+ * Building is CPU only and touches no GL state; InstancedRenderer submits
+ * the result.  clear() keeps capacity, so a queue reused every frame stops
+ * allocating once it has seen the largest frame.
+ *
+ * @tparam T Mesh type (Mesh in the renderer; any type in headless tests)
+ */
+template <typename T>
+class RenderQueue {
+public:
+    /**
+     * Drop last frame's submissions, batches and counters
+     */
+    void clear() {
+        m_keys.clear();
+        m_meshes.clear();
+        m_submitted.clear();
+        m_instances.clear();
+        m_batches.clear();
+        m_stats = RenderQueueStats();
+    }
+
+    /**
+     * Queue one draw of @p mesh
+     * @param material Shader or material the mesh is drawn with
+     * @param depth View distance, for front-to-back order within a batch
+     */
+    void submit(std::shared_ptr<T> mesh, uint32_t material, const InstanceData& instance, float depth = 0.0f) {
+        if (!mesh) return;
+        m_keys.push_back({ material, mesh.get(), depth, static_cast<uint32_t>(m_submitted.size()) });
+        m_meshes.push_back(std::move(mesh));
+        m_submitted.push_back(instance);
+    }
+
+    /**
+     * Sort and group the submissions into batches and one contiguous
+     * instance array
+     */
+    void build() {
+        std::sort(m_keys.begin(), m_keys.end(), [](const Key& a, const Key& b) {
+            if (a.material != b.material) return a.material < b.material;
+            if (a.mesh != b.mesh) return std::less<const T*>()(a.mesh, b.mesh);
+            if (a.depth != b.depth) return a.depth < b.depth;
+            return a.submission < b.submission;
+        });
+
+        m_instances.clear();
+        m_batches.clear();
+        m_stats = RenderQueueStats();
+        m_instances.reserve(m_keys.size());
+        for (size_t i = 0; i < m_keys.size(); ++i) {
+            const Key& key = m_keys[i];
+            bool newMaterial = i == 0 || key.material != m_keys[i - 1].material;
+            if (newMaterial || key.mesh != m_keys[i - 1].mesh) {
+                DrawBatch<T> batch;
+                batch.mesh = m_meshes[key.submission];
+                batch.material = key.material;
+                batch.firstInstance = m_instances.size();
+                m_batches.push_back(std::move(batch));
+                if (newMaterial) ++m_stats.materialChanges;
+            }
+            m_instances.push_back(m_submitted[key.submission]);
+            ++m_batches.back().instanceCount;
+        }
+
+        m_stats.items = m_keys.size();
+        m_stats.drawCalls = m_batches.size();
+        m_stats.meshChanges = m_batches.size();
+    }
+
+    /**
+     * Batches in draw order (after build())
+     */
+    const std::vector<DrawBatch<T>>& getBatches() const { return m_batches; }
+
+    /**
+     * Instance data of every batch, each batch's instances contiguous
+     * (after build())
+     */
+    const std::vector<InstanceData>& getInstances() const { return m_instances; }
+
+    /**
+     * Counters of the last build()
+     */
+    const RenderQueueStats& getStats() const { return m_stats; }
+
+    /**
+     * Meshes submitted since clear()
+     */
+    size_t size() const { return m_keys.size(); }
+
+private:
+    struct Key {
+        uint32_t material;
+        const T* mesh;
+        float depth;
+        uint32_t submission;    // index into m_meshes and m_submitted
+    };
+
+    std::vector<Key> m_keys;
+    std::vector<std::shared_ptr<T>> m_meshes;
+    std::vector<InstanceData> m_submitted;
+    std::vector<InstanceData> m_instances;
+    std::vector<DrawBatch<T>> m_batches;
+    RenderQueueStats m_stats;
+};
+
+} // namespace atlas
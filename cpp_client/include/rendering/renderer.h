@@ -5,6 +5,12 @@
 #include <unordered_map>
 #include <string>
 #include <glm/glm.hpp>
+#include "rendering/lod_manager.h"
+#include "rendering/mesh_cache.h"
+#include "rendering/mesh_disk_cache.h"
+#include "rendering/mesh_job_system.h"
+#include "rendering/occlusion_culler.h"
+#include "rendering/render_queue.h"
 
 namespace atlas {
 
@@ -13,6 +19,7 @@ class Shader;
 class Camera;
 class Mesh;
 class Model;
+class InstancedRenderer;
 class HealthBarRenderer;
 class WarpEffectRenderer;
 class Entity;
@@ -21,7 +28,7 @@ class Entity;
  * Visual representation of a game entity
  */
 struct EntityVisual {
-    std::shared_ptr<Model> model;
+    std::shared_ptr<const Model> model;   // shared with every visual of the same variant
     glm::vec3 position;
     glm::vec3 rotation;  // Euler angles (pitch, yaw, roll)
     float scale;
@@ -153,6 +160,48 @@ public:
      */
     void updateEntityVisuals(const std::unordered_map<std::string, std::shared_ptr<Entity>>& entities);
 
+    /**
+     * Ship model cache shared by all entity visuals
+     */
+    const MeshCache<Model>& getModelCache() const { return m_modelCache; }
+
+    /**
+     * Background generation of ship models (timing stats)
+     */
+    const MeshJobSystem& getMeshJobs() const { return *m_meshJobs; }
+
+    /**
+     * Baked models on disk, mapped instead of regenerated on later launches
+     */
+    const MeshDiskCache& getMeshDiskCache() const { return *m_diskCache; }
+
+    /**
+     * Pixels a ship model's simplified level may deviate from full detail
+     * before a finer level is drawn
+     */
+    void setMaxScreenSpaceError(float pixels) { m_maxScreenSpaceError = pixels; }
+
+    /**
+     * Entity triangles drawn last frame, after level-of-detail selection
+     */
+    size_t getEntityTrianglesDrawn() const { return m_entityTrianglesDrawn; }
+
+    /**
+     * Entity meshes submitted and instanced draws issued last frame
+     */
+    const RenderQueueStats& getEntityQueueStats() const { return m_entityQueue.getStats(); }
+
+    /**
+     * Skip entities hidden behind the largest hulls on screen (on by default)
+     */
+    void setOcclusionCulling(bool enabled) { m_occlusionCullingEnabled = enabled; }
+    bool isOcclusionCullingEnabled() const { return m_occlusionCullingEnabled; }
+
+    /**
+     * Occluders, entities hidden and CPU time of last frame's occlusion pass
+     */
+    const OcclusionStats& getOcclusionStats() const { return m_occlusionCuller.getStats(); }
+
 private:
     /**
      * Initialize starfield geometry
@@ -204,6 +253,11 @@ private:
      * @param camera Current camera for view/projection matrices
      */
     void renderEntities(Camera& camera);
+
+    /**
+     * Rasterise the largest visuals on screen into the occlusion depth buffer
+     */
+    void renderOccluders(const glm::mat4& projection, const glm::vec3& cameraPosition);
     
     /**
      * Render health bars above entities
@@ -221,6 +275,16 @@ private:
      */
     void renderHealthBars(Camera& camera);
 
+    /**
+     * Queue generation of a ship model; the visual shows a proxy until then
+     */
+    void requestModel(const MeshCacheKey& key, const std::string& entityId);
+
+    /**
+     * Main-thread half of a model job: upload and swap out the proxies
+     */
+    void onModelReady(const MeshCacheKey& key, const std::shared_ptr<const Model>& model);
+
     /**
      * Setup sun sphere geometry for solar system rendering
      */
@@ -242,6 +306,7 @@ private:
     std::unique_ptr<Shader> m_starfieldShader;
     std::unique_ptr<Shader> m_nebulaShader;
     std::unique_ptr<Shader> m_entityShader;
+    std::unique_ptr<Shader> m_entityInstancedShader;
     std::unique_ptr<HealthBarRenderer> m_healthBarRenderer;
     std::unique_ptr<WarpEffectRenderer> m_warpEffectRenderer;
     
@@ -268,6 +333,19 @@ private:
 
     // Entity visuals
     std::unordered_map<std::string, EntityVisual> m_entityVisuals;
+    MeshCache<Model> m_modelCache;
+    std::unique_ptr<MeshDiskCache> m_diskCache;
+    std::unique_ptr<MeshJobSystem> m_meshJobs;     // after the caches: stops first
+    std::unordered_map<MeshCacheKey, std::vector<std::string>, MeshCacheKeyHash> m_pendingModels;
+    float m_maxScreenSpaceError = LODConfig().maxScreenSpaceError;
+    size_t m_entityTrianglesDrawn = 0;
+    RenderQueue<Mesh> m_entityQueue;
+    std::unique_ptr<InstancedRenderer> m_entityInstances;
+    OcclusionCuller m_occlusionCuller;
+    std::vector<const EntityVisual*> m_occluders;   // rasterised this frame, never tested
+    std::vector<Vertex> m_unpackedVertices;         // scratch for packed occluders
+    std::vector<unsigned int> m_unpackedIndices;
+    bool m_occlusionCullingEnabled = true;
 
     bool m_initialized;
 };
@@ -11,6 +11,9 @@
 
 namespace atlas {
 
+class MeshDiskCache;
+class Model;
+
 /**
  * Station Renderer
  * Renders procedural space stations using faction-specific designs
@@ -70,9 +73,11 @@ public:
     
     /**
      * Initialize station renderer
-     * Creates procedural station meshes for all factions
+     * Creates procedural station meshes for all factions.  Needs no GL
+     * context: meshes upload on first draw.
+     * @param diskCache Baked meshes to map instead of generating, or nullptr
      */
-    bool initialize();
+    bool initialize(MeshDiskCache* diskCache = nullptr);
     
     /**
      * Add a station to be rendered
@@ -100,11 +105,11 @@ public:
     size_t getStationCount() const { return m_stations.size(); }
 
 private:
-    // Station meshes by faction
-    std::map<FactionStyle, std::shared_ptr<Mesh>> m_factionStationMeshes;
+    // Station models by faction, with levels of detail
+    std::map<FactionStyle, std::shared_ptr<Model>> m_factionStationModels;
     
-    // Upwell structure meshes
-    std::map<UpwellType, std::shared_ptr<Mesh>> m_upwellMeshes;
+    // Upwell structure models
+    std::map<UpwellType, std::shared_ptr<Model>> m_upwellModels;
     
     // Active station instances
     std::vector<StationInstance> m_stations;
@@ -113,9 +118,10 @@ private:
     std::map<FactionStyle, FactionVisuals> m_factionVisuals;
     
     /**
-     * Create all station meshes
+     * Create all station models and their levels of detail, through
+     * @p diskCache when given
      */
-    void createStationMeshes();
+    void createStationMeshes(MeshDiskCache* diskCache);
     
     /**
      * Create Solari cathedral-style station
@@ -54,6 +54,9 @@ struct ShipHUDData {
     float warpProgress = 0.0f;  // 0.0 – 1.0
     float warpSpeedAU  = 0.0f;  // Current warp speed in AU/s
 
+    // Server time dilation for the current system (1.0 = real time)
+    float timeDilation = 1.0f;
+
     // Module rack (up to 8 high, 8 mid, 8 low slots)
     struct ModuleInfo {
         bool   fitted    = false;
@@ -0,0 +1,30 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoord;
+layout (location = 3) in vec3 aColor;
+
+// Per-instance attributes (see InstanceBatch)
+layout (location = 4) in mat4 aInstanceModel;
+layout (location = 8) in vec4 aInstanceColor;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoord;
+out vec3 Color;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main()
+{
+    FragPos = vec3(aInstanceModel * vec4(aPos, 1.0));
+    // Entity transforms are rotation and uniform scale, so the model matrix
+    // serves as its own normal matrix up to length
+    Normal = mat3(aInstanceModel) * aNormal;
+    TexCoord = aTexCoord;
+    Color = aColor * aInstanceColor.rgb;
+
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
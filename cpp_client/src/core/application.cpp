@@ -536,12 +536,15 @@ void Application::update(float deltaTime) {
     // Update game client
     m_gameClient->update(deltaTime);
     
+    // Simulation runs at the server's time dilation rate for this system
+    float simDeltaTime = deltaTime * m_gameClient->getTimeDilation();
+
     // Update local movement (PVE mode — EVE-style movement commands)
-    updateLocalMovement(deltaTime);
+    updateLocalMovement(simDeltaTime);
     
     // Update solar system scene (engine trail, warp visual state)
     if (m_solarSystem && m_shipPhysics) {
-        m_solarSystem->update(deltaTime, m_shipPhysics.get());
+        m_solarSystem->update(simDeltaTime, m_shipPhysics.get());
     }
     
     // Update ship status in the HUD
@@ -639,6 +642,7 @@ void Application::render() {
             shipData.warpProgress = ws.progress;
             shipData.warpSpeedAU  = ws.speedAU;
         }
+        shipData.timeDilation = m_gameClient->getTimeDilation();
         
         // Build Atlas target cards from target list
         std::vector<atlas::TargetCardInfo> atlasTargets;
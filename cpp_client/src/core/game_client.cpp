@@ -1,6 +1,7 @@
 #include "core/game_client.h"
 #include "core/entity_message_parser.h"
 #include <iostream>
+#include <algorithm>
 
 namespace atlas {
 
@@ -30,6 +31,10 @@ void GameClient::setupMessageHandlers() {
     m_networkManager.registerHandler("connect_ack", [this](const std::string& data) {
         handleConnectAck(data);
     });
+
+    m_networkManager.registerHandler("time_dilation", [this](const std::string& data) {
+        handleTimeDilation(data);
+    });
 }
 
 bool GameClient::connect(const std::string& host, int port, const std::string& characterName) {
@@ -112,4 +117,18 @@ void GameClient::handleConnectAck(const std::string& dataJson) {
     }
 }
 
+void GameClient::handleTimeDilation(const std::string& dataJson) {
+    // The server slows an overloaded solar system down rather than lagging;
+    // local prediction must run at the same rate to stay in sync.
+    try {
+        auto data = nlohmann::json::parse(dataJson);
+        if (data.contains("factor")) {
+            float factor = data["factor"].get<float>();
+            m_timeDilation = std::min(1.0f, std::max(0.0f, factor));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "GameClient: Failed to parse time_dilation: " << e.what() << std::endl;
+    }
+}
+
 } // namespace atlas
@@ -0,0 +1,106 @@
+/**
+ * Headless load bot: a swarm of scripted pilots against a dedicated server
+ *
+ * Usage: atlas_loadbot [--host H] [--port P] [--bots N] [--duration S] ...
+ *        atlas_loadbot --help
+ */
+
+#include "network/load_bot.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <sys/resource.h>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --host <host>          Server address (default 127.0.0.1)\n"
+              << "  --port <port>          Server port (default 8765)\n"
+              << "  --bots <n>             Simulated pilots (default 100)\n"
+              << "  --connect-rate <n/s>   Connection ramp-up rate (default 200)\n"
+              << "  --duration <s>         Seconds to run (default 60)\n"
+              << "  --seed <n>             Behaviour seed (default 1)\n"
+              << "  --undock <n/min>       Undock requests per bot per minute\n"
+              << "  --warp <n/min>         Warps per bot per minute\n"
+              << "  --orbit <n/min>        Orbit commands per bot per minute\n"
+              << "  --shoot <n/min>        Lock-and-fire cycles per bot per minute\n"
+              << "  --market <n/min>       Market history queries per bot per minute\n"
+              << "  --chat <n/min>         Chat messages per bot per minute\n"
+              << "  --station <id>         Station for market queries\n"
+              << "  --item <id>            Item for market queries\n"
+              << "  --timeout <s>          Seconds before a request counts as lost\n"
+              << "  --server-metrics <f>   Server's metrics_export_path file, for real tick stats\n"
+              << "  --verbose              Log connection failures\n";
+}
+
+/// Every bot is a socket; lift the descriptor limit to fit the swarm
+void raiseDescriptorLimit(int bots) {
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) return;
+    rlim_t wanted = static_cast<rlim_t>(bots) + 64;
+    if (limit.rlim_cur >= wanted) return;
+    limit.rlim_cur = std::min(wanted, limit.rlim_max);
+    if (setrlimit(RLIMIT_NOFILE, &limit) != 0 || limit.rlim_cur < wanted) {
+        std::cerr << "Warning: descriptor limit " << limit.rlim_cur
+                  << " is below the " << bots << " bots requested" << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    atlas::LoadBotConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if (arg == "--verbose") {
+            config.verbose = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+        const char* value = argv[++i];
+        if (arg == "--host") config.host = value;
+        else if (arg == "--port") config.port = std::atoi(value);
+        else if (arg == "--bots") config.botCount = std::atoi(value);
+        else if (arg == "--connect-rate") config.connectRate = std::strtof(value, nullptr);
+        else if (arg == "--duration") config.duration = std::strtof(value, nullptr);
+        else if (arg == "--seed") config.seed = static_cast<unsigned int>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--undock") config.undockPerMinute = std::strtof(value, nullptr);
+        else if (arg == "--warp") config.warpPerMinute = std::strtof(value, nullptr);
+        else if (arg == "--orbit") config.orbitPerMinute = std::strtof(value, nullptr);
+        else if (arg == "--shoot") config.lockAndShootPerMinute = std::strtof(value, nullptr);
+        else if (arg == "--market") config.marketPerMinute = std::strtof(value, nullptr);
+        else if (arg == "--chat") config.chatPerMinute = std::strtof(value, nullptr);
+        else if (arg == "--station") config.marketStation = value;
+        else if (arg == "--item") config.marketItem = value;
+        else if (arg == "--timeout") config.responseTimeout = std::strtof(value, nullptr);
+        else if (arg == "--server-metrics") config.serverMetricsPath = value;
+        else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    raiseDescriptorLimit(config.botCount);
+
+    std::cout << "=== Atlas Load Bot ===" << std::endl;
+    std::cout << config.botCount << " bots -> " << config.host << ":" << config.port
+              << " for " << config.duration << " s" << std::endl;
+
+    atlas::LoadBotSwarm swarm(config);
+    if (!swarm.run()) return 1;
+
+    std::cout << swarm.report();
+    return swarm.getConnectedCount() > 0 ? 0 : 1;
+}
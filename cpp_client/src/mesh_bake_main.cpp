@@ -0,0 +1,221 @@
+/**
+ * Mesh baker: prewarm the on-disk mesh cache, and measure what it saves
+ *
+ * Generates every ship hull listed in data/ships, every station and the
+ * asteroid meshes, and bakes them into the cache the client maps at startup.
+ * No window or GL context is created.
+ *
+ * Usage: atlas_mesh_bake [--cache-dir DIR] [--ships DIR] [--all-factions] ...
+ *        atlas_mesh_bake --benchmark
+ *        atlas_mesh_bake --help
+ */
+
+#include "rendering/asteroid_field_renderer.h"
+#include "rendering/mesh_disk_cache.h"
+#include "rendering/mesh_job_system.h"
+#include "rendering/model.h"
+#include "rendering/station_renderer.h"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using ShipVariant = std::pair<std::string, std::string>;    // type, faction
+
+const std::vector<std::string> PLAYABLE_FACTIONS = { "Veyren", "Aurelian", "Keldari", "Solari" };
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --cache-dir <dir>      Mesh cache directory (default "
+              << atlas::MeshDiskCache::DEFAULT_DIRECTORY << ")\n"
+              << "  --ships <dir>          Ship definitions (default: find data/ships)\n"
+              << "  --all-factions         Bake every hull for every playable faction\n"
+              << "  --workers <n>          Generation threads (default: cores - 1)\n"
+              << "  --clear                Delete baked meshes first\n"
+              << "  --benchmark            Time a cold start (generate) against a warm one (map)\n"
+              << "                         single-threaded; clears the cache first\n";
+}
+
+std::string findShipsDir() {
+    for (const char* dir : { "data/ships", "../data/ships", "../../data/ships", "../../../data/ships" }) {
+        if (std::filesystem::is_directory(dir)) return dir;
+    }
+    return "";
+}
+
+// Every (name, race) in data/ships/*.json, optionally crossed with each faction
+std::vector<ShipVariant> loadShipVariants(const std::string& shipsDir, bool allFactions) {
+    std::set<ShipVariant> variants;
+    for (const auto& entry : std::filesystem::directory_iterator(shipsDir)) {
+        if (entry.path().extension() != ".json") continue;
+        std::ifstream file(entry.path());
+        nlohmann::json ships = nlohmann::json::parse(file, nullptr, false);
+        if (!ships.is_object()) {
+            std::cerr << "Skipping unreadable " << entry.path().string() << std::endl;
+            continue;
+        }
+        for (const auto& [id, ship] : ships.items()) {
+            if (!ship.is_object()) continue;
+            std::string name = ship.value("name", id);
+            if (allFactions) {
+                for (const auto& faction : PLAYABLE_FACTIONS) variants.insert({ name, faction });
+            } else {
+                variants.insert({ name, ship.value("race", "Veyren") });
+            }
+        }
+    }
+    return std::vector<ShipVariant>(variants.begin(), variants.end());
+}
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+double megabytes(uint64_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+// Touch every byte the upload would read, so mapped pages are really loaded
+uint64_t checksum(const atlas::Model& model) {
+    uint64_t sum = 0;
+    for (const auto& part : model.getGeometry()) {
+        for (size_t i = 0; i < part.vertexCount; ++i) {
+            sum += static_cast<uint64_t>(part.vertices[i].position.x * 1000.0f);
+        }
+        for (size_t i = 0; i < part.indexCount; ++i) sum += part.indices[i];
+    }
+    return sum;
+}
+
+// Ships, stations and asteroids through the cache on this thread
+uint64_t startWorld(const std::vector<ShipVariant>& ships, atlas::MeshDiskCache& cache) {
+    uint64_t sum = 0;
+    for (const auto& [type, faction] : ships) {
+        auto model = atlas::Model::loadOrCreateShipModel(type, faction, &cache);
+        if (model) sum += checksum(*model);
+    }
+    atlas::StationRenderer stations;
+    stations.initialize(&cache);
+    atlas::AsteroidFieldRenderer asteroids;
+    asteroids.bakeMeshes(cache);
+    return sum;
+}
+
+int runBenchmark(const std::vector<ShipVariant>& ships, atlas::MeshDiskCache& cache) {
+    cache.clear();
+    cache.resetStats();
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t coldSum = startWorld(ships, cache);
+    double coldMs = millisecondsSince(start);
+    atlas::MeshDiskCacheStats cold = cache.getStats();
+
+    cache.resetStats();
+    start = std::chrono::steady_clock::now();
+    uint64_t warmSum = startWorld(ships, cache);
+    double warmMs = millisecondsSince(start);
+    atlas::MeshDiskCacheStats warm = cache.getStats();
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "\nCold start (generate and bake): " << coldMs << " ms\n"
+              << "  " << cold.writes << " meshes baked, " << megabytes(cold.bytesWritten) << " MB written\n"
+              << "Warm start (map): " << warmMs << " ms\n"
+              << "  " << warm.hits << " meshes mapped, " << warm.misses + warm.stale << " regenerated, "
+              << megabytes(warm.bytesMapped) << " MB mapped\n"
+              << "Speedup: " << std::setprecision(2) << (warmMs > 0.0 ? coldMs / warmMs : 0.0) << "x\n";
+
+    if (coldSum != warmSum) {
+        std::cerr << "Warm start geometry differs from the generated meshes" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string cacheDir = atlas::MeshDiskCache::DEFAULT_DIRECTORY;
+    std::string shipsDir;
+    bool allFactions = false;
+    bool clear = false;
+    bool benchmark = false;
+    unsigned int workers = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if (arg == "--all-factions") { allFactions = true; continue; }
+        if (arg == "--clear") { clear = true; continue; }
+        if (arg == "--benchmark") { benchmark = true; continue; }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+        const char* value = argv[++i];
+        if (arg == "--cache-dir") cacheDir = value;
+        else if (arg == "--ships") shipsDir = value;
+        else if (arg == "--workers") workers = static_cast<unsigned int>(std::strtoul(value, nullptr, 10));
+        else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (shipsDir.empty()) shipsDir = findShipsDir();
+    if (shipsDir.empty() || !std::filesystem::is_directory(shipsDir)) {
+        std::cerr << "Ship definitions not found; pass --ships <dir>" << std::endl;
+        return 1;
+    }
+    std::vector<ShipVariant> ships = loadShipVariants(shipsDir, allFactions);
+
+    atlas::MeshDiskCache cache(cacheDir);
+    std::cout << "Mesh cache " << cacheDir << " (generator " << cache.getCodeVersion() << "), "
+              << ships.size() << " ship variants" << std::endl;
+
+    if (benchmark) return runBenchmark(ships, cache);
+
+    if (clear) {
+        std::cout << "Removed " << cache.clear() << " baked meshes" << std::endl;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    atlas::MeshJobSystem jobs(workers);
+    for (const auto& [type, faction] : ships) {
+        jobs.submit(type + "/" + faction, [&cache, type = type, faction = faction]() {
+            atlas::Model::loadOrCreateShipModel(type, faction, &cache);
+        });
+    }
+    jobs.submit("stations", [&cache]() {
+        atlas::StationRenderer stations;
+        stations.initialize(&cache);
+    });
+    jobs.submit("asteroids", [&cache]() {
+        atlas::AsteroidFieldRenderer asteroids;
+        asteroids.bakeMeshes(cache);
+    });
+    jobs.waitForBuilds();
+
+    atlas::MeshDiskCacheStats stats = cache.getStats();
+    atlas::MeshJobStats jobStats = jobs.getStats();
+    std::cout << std::fixed << std::setprecision(1)
+              << "Baked " << stats.writes << " meshes (" << megabytes(stats.bytesWritten) << " MB), "
+              << stats.hits << " already current, " << stats.stale << " stale replaced, "
+              << stats.writeFailures << " failed\n"
+              << jobs.getWorkerCount() << " workers, " << millisecondsSince(start) << " ms, slowest "
+              << jobStats.buildMsMax << " ms" << std::endl;
+    return stats.writeFailures == 0 && jobStats.failed == 0 ? 0 : 1;
+}
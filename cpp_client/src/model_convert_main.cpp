@@ -0,0 +1,291 @@
+/**
+ * Model converter: OBJ and glTF sources to the binary .amdl format
+ *
+ * Quantises, welds and reorders every mesh (see binary_model.h), builds its
+ * simplified levels of detail (see mesh_simplifier.h) and writes the result
+ * next to its source, where Model::loadFromFile() and
+ * ProceduralShipGenerator::parseOBJ() pick it up.  No window or GL context
+ * is created.
+ *
+ * Usage: atlas_model_convert [options] [file or directory ...]
+ *        atlas_model_convert --benchmark [file or directory ...]
+ *        atlas_model_convert --help
+ */
+
+#include "rendering/binary_model.h"
+#include "rendering/model.h"
+#include "rendering/procedural_ship_generator.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+constexpr int BENCHMARK_RUNS = 3;
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options] [file or directory ...]\n"
+              << "  Converts .obj, .gltf and .glb files (directories recursively) to .amdl.\n"
+              << "  Without inputs, converts the reference models (assets/reference_models).\n"
+              << "  -o, --output <dir>     Write .amdl files here instead of next to each source\n"
+              << "                         (the client only finds them next to the source)\n"
+              << "  --force                Convert even if the .amdl is current\n"
+              << "  --benchmark            Time parsing each source against mapping its .amdl\n";
+}
+
+std::string findReferenceModelsDir() {
+    for (const char* dir : { "assets/reference_models", "cpp_client/assets/reference_models",
+                             "../assets/reference_models", "../../assets/reference_models",
+                             "../cpp_client/assets/reference_models" }) {
+        if (std::filesystem::is_directory(dir)) return dir;
+    }
+    return "";
+}
+
+bool isSourceModel(const std::filesystem::path& path) {
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    return extension == ".obj" || extension == ".gltf" || extension == ".glb";
+}
+
+bool isOBJ(const std::string& path) {
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    return extension == ".obj";
+}
+
+std::vector<std::string> collectSources(const std::vector<std::string>& inputs) {
+    std::vector<std::string> sources;
+    for (const auto& input : inputs) {
+        std::error_code ec;
+        if (std::filesystem::is_directory(input, ec)) {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(input, ec)) {
+                if (entry.is_regular_file() && isSourceModel(entry.path())) sources.push_back(entry.path().string());
+            }
+        } else if (std::filesystem::is_regular_file(input, ec)) {
+            sources.push_back(input);
+        } else {
+            std::cerr << "No such file or directory: " << input << std::endl;
+        }
+    }
+    std::sort(sources.begin(), sources.end());
+    return sources;
+}
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+double megabytes(uint64_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+uint64_t fileBytes(const std::string& path) {
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(path, ec);
+    return ec ? 0 : static_cast<uint64_t>(size);
+}
+
+// Fastest of a few runs of @p work
+template <typename Work>
+double bestOf(Work&& work) {
+    double best = std::numeric_limits<double>::max();
+    for (int run = 0; run < BENCHMARK_RUNS; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        work();
+        best = std::min(best, millisecondsSince(start));
+    }
+    return best;
+}
+
+bool convert(const std::string& source, const std::string& target) {
+    atlas::Model model;
+    if (!model.loadSourceFile(source)) {
+        std::cerr << "Cannot read " << source << std::endl;
+        return false;
+    }
+
+    std::vector<atlas::ConvertedMesh> meshes;
+    atlas::MeshConvertStats total;
+    float acmrBefore = 0.0f;
+    float acmrAfter = 0.0f;
+    for (const auto& part : model.getGeometry()) {
+        atlas::MeshConvertStats stats;
+        meshes.push_back(atlas::convertMesh(part, &stats));
+        total.sourceVertices += stats.sourceVertices;
+        total.vertices += stats.vertices;
+        total.triangles += stats.triangles;
+        total.degenerateTriangles += stats.degenerateTriangles;
+        acmrBefore += stats.acmrBefore * static_cast<float>(stats.triangles);
+        acmrAfter += stats.acmrAfter * static_cast<float>(stats.triangles);
+    }
+    if (total.triangles > 0) {
+        acmrBefore /= static_cast<float>(total.triangles);
+        acmrAfter /= static_cast<float>(total.triangles);
+    }
+
+    // Levels of detail follow full detail, converted the same way
+    model.generateLods();
+    std::vector<atlas::MeshLodGeometry> lods = model.getLodGeometry();
+    std::vector<size_t> lodTriangles;
+    for (size_t level = 0; level < lods.size(); ++level) {
+        size_t triangles = 0;
+        for (const auto& part : lods[level].parts) {
+            atlas::ConvertedMesh mesh = atlas::convertMesh(part);
+            mesh.lod = static_cast<uint32_t>(level + 1);
+            mesh.lodError = lods[level].error;
+            triangles += mesh.indices.size() / 3;
+            meshes.push_back(std::move(mesh));
+        }
+        lodTriangles.push_back(triangles);
+    }
+
+    if (!atlas::writeBinaryModel(target, meshes)) return false;
+
+    std::cout << std::fixed << std::setprecision(2)
+              << source << " -> " << target << "\n"
+              << "  " << model.getGeometry().size() << " meshes, " << total.sourceVertices << " -> " << total.vertices
+              << " vertices, " << total.triangles << " triangles (" << total.degenerateTriangles
+              << " degenerate dropped)\n"
+              << "  ACMR " << acmrBefore << " -> " << acmrAfter << ", "
+              << megabytes(fileBytes(source)) << " MB -> " << megabytes(fileBytes(target)) << " MB\n"
+              << "  LODs:";
+    for (size_t level = 0; level < lodTriangles.size(); ++level) {
+        std::cout << " " << lodTriangles[level] << " triangles (error " << lods[level].error << ")";
+    }
+    std::cout << (lodTriangles.empty() ? " none" : "") << std::endl;
+    return true;
+}
+
+// Source parse against binary map, for the loaders the client actually uses
+void benchmark(const std::string& source, const std::string& binary) {
+    size_t sink = 0;
+    double parseMs = bestOf([&]() {
+        atlas::Model model;
+        model.loadSourceFile(source);
+        sink += model.getMemoryBytes();
+    });
+    // Mapping alone defers the reads to the upload, so read every byte here
+    double mapMs = bestOf([&]() {
+        auto model = atlas::loadBinaryModel(binary);
+        if (!model) return;
+        for (const auto& mesh : model->meshes) {
+            const auto* words = reinterpret_cast<const uint32_t*>(mesh.vertices);
+            for (size_t i = 0; i < mesh.vertexCount * sizeof(atlas::PackedVertex) / 4; ++i) sink += words[i];
+            const auto* bytes = static_cast<const unsigned char*>(mesh.indices);
+            size_t indexBytes = mesh.indexCount * (mesh.shortIndices ? 2 : 4);
+            for (size_t i = 0; i < indexBytes; ++i) sink += bytes[i];
+        }
+    });
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "  Model:   parse " << parseMs << " ms, map and read " << mapMs << " ms ("
+              << std::setprecision(1) << (mapMs > 0.0 ? parseMs / mapMs : 0.0) << "x)" << std::endl;
+
+    if (isOBJ(source)) {
+        // parseOBJ() prefers the binary when it sits next to the source
+        bool sideBySide = atlas::findCurrentBinaryModel(source) == binary;
+        double seedParseMs = 0.0;
+        if (!sideBySide) {
+            seedParseMs = bestOf([&]() { sink += atlas::ProceduralShipGenerator::parseOBJ(source).positions.size(); });
+        } else {
+            // Time the text path by parsing a copy without a binary beside it
+            auto copy = std::filesystem::temp_directory_path() / ("atlas_model_convert_bench" +
+                                                                   std::filesystem::path(source).extension().string());
+            std::error_code ec;
+            std::filesystem::copy_file(source, copy, std::filesystem::copy_options::overwrite_existing, ec);
+            seedParseMs = bestOf([&]() { sink += atlas::ProceduralShipGenerator::parseOBJ(copy.string()).positions.size(); });
+            std::filesystem::remove(copy, ec);
+        }
+        double seedMapMs = sideBySide
+            ? bestOf([&]() { sink += atlas::ProceduralShipGenerator::parseOBJ(source).positions.size(); })
+            : 0.0;
+        std::cout << std::fixed << std::setprecision(2) << "  Seed:    parse " << seedParseMs << " ms";
+        if (sideBySide) {
+            std::cout << ", map " << seedMapMs << " ms (" << std::setprecision(1)
+                      << (seedMapMs > 0.0 ? seedParseMs / seedMapMs : 0.0) << "x)";
+        }
+        std::cout << std::endl;
+    }
+    if (sink == 0) std::cout << "  (no geometry)" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> inputs;
+    std::string outputDir;
+    bool force = false;
+    bool runBenchmark = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if (arg == "--force") { force = true; continue; }
+        if (arg == "--benchmark") { runBenchmark = true; continue; }
+        if (arg == "-o" || arg == "--output") {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+            outputDir = argv[++i];
+            continue;
+        }
+        if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "Unknown option " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+        inputs.push_back(arg);
+    }
+
+    if (inputs.empty()) {
+        std::string referenceDir = findReferenceModelsDir();
+        if (referenceDir.empty()) {
+            std::cerr << "Reference models not found; pass files or directories to convert" << std::endl;
+            return 1;
+        }
+        inputs.push_back(referenceDir);
+    }
+
+    std::vector<std::string> sources = collectSources(inputs);
+    if (!outputDir.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(outputDir, ec);
+    }
+
+    size_t converted = 0;
+    size_t current = 0;
+    size_t failed = 0;
+    for (const auto& source : sources) {
+        std::string target = outputDir.empty()
+            ? atlas::binaryModelPathFor(source)
+            : (std::filesystem::path(outputDir) /
+               std::filesystem::path(atlas::binaryModelPathFor(source)).filename()).string();
+
+        if (!force && outputDir.empty() && atlas::findCurrentBinaryModel(source) == target) {
+            ++current;
+        } else if (convert(source, target)) {
+            ++converted;
+        } else {
+            ++failed;
+            continue;
+        }
+        if (runBenchmark) benchmark(source, target);
+    }
+
+    std::cout << "Converted " << converted << " models, " << current << " already current, "
+              << failed << " failed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
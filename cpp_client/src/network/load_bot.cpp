@@ -0,0 +1,705 @@
+#include "network/load_bot.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sstream>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace atlas {
+
+namespace {
+
+// The server reads one message per recv(), so a bot never sends two
+// messages closer together than this
+constexpr double MIN_SEND_SPACING = 0.05;
+
+// Delay between a target lock and the module activation that follows it
+constexpr double SHOOT_DELAY = 0.25;
+
+const char* ACTION_NAMES[] = {"undock", "warp", "orbit", "lock", "market", "chat"};
+
+/**
+ * Type of a server message without parsing it.  Most messages are keyed
+ * "type", some "message_type"; whichever comes first is the envelope's.
+ */
+std::string messageType(const std::string& message) {
+    static const std::string TYPE_KEY = "\"type\":\"";
+    static const std::string MESSAGE_TYPE_KEY = "\"message_type\":\"";
+    size_t typePos = message.find(TYPE_KEY);
+    size_t messageTypePos = message.find(MESSAGE_TYPE_KEY);
+    size_t start;
+    if (typePos != std::string::npos &&
+        (messageTypePos == std::string::npos || typePos < messageTypePos)) {
+        start = typePos + TYPE_KEY.size();
+    } else if (messageTypePos != std::string::npos) {
+        start = messageTypePos + MESSAGE_TYPE_KEY.size();
+    } else {
+        return "";
+    }
+    size_t end = message.find('"', start);
+    return end == std::string::npos ? "" : message.substr(start, end - start);
+}
+
+std::string stringField(const std::string& message, const std::string& key) {
+    std::string pattern = "\"" + key + "\":\"";
+    size_t pos = message.find(pattern);
+    if (pos == std::string::npos) return "";
+    size_t start = pos + pattern.size();
+    size_t end = message.find('"', start);
+    return end == std::string::npos ? "" : message.substr(start, end - start);
+}
+
+bool numberField(const std::string& message, const std::string& key, double& value) {
+    std::string pattern = "\"" + key + "\":";
+    size_t pos = message.find(pattern);
+    if (pos == std::string::npos) return false;
+    const char* start = message.c_str() + pos + pattern.size();
+    char* end = nullptr;
+    value = std::strtod(start, &end);
+    return end != start;
+}
+
+/// Latency bucket a response settles
+const char* responseKind(const std::string& type) {
+    if (type == "connect_ack") return "connect";
+    if (type == "undock_success") return "undock";
+    if (type == "warp_result") return "warp";
+    if (type == "movement_ack") return "orbit";
+    if (type == "target_lock_ack") return "lock";
+    if (type == "module_activate_ack") return "shoot";
+    if (type == "market_history") return "market";
+    if (type == "chat") return "chat";
+    return nullptr;
+}
+
+} // namespace
+
+bool parseMetricsText(const std::string& text, std::map<std::string, double>& out) {
+    bool found = false;
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        size_t space = line.find(' ');
+        if (space == std::string::npos || space == 0) continue;
+        std::string name = line.substr(0, space);
+        if (name.find('{') != std::string::npos) continue;
+        const char* start = line.c_str() + space + 1;
+        char* end = nullptr;
+        double value = std::strtod(start, &end);
+        if (end == start) continue;
+        out[name] = value;
+        found = true;
+    }
+    return found;
+}
+
+// ---------------------------------------------------------------------------
+// SampleStats
+// ---------------------------------------------------------------------------
+
+void SampleStats::add(double value) {
+    m_samples.push_back(value);
+    m_sum += value;
+    m_sorted = false;
+}
+
+double SampleStats::mean() const {
+    return m_samples.empty() ? 0.0 : m_sum / static_cast<double>(m_samples.size());
+}
+
+double SampleStats::max() const {
+    return m_samples.empty() ? 0.0 : *std::max_element(m_samples.begin(), m_samples.end());
+}
+
+double SampleStats::percentile(double p) const {
+    if (m_samples.empty()) return 0.0;
+    if (!m_sorted) {
+        std::sort(m_samples.begin(), m_samples.end());
+        m_sorted = true;
+    }
+    p = std::min(100.0, std::max(0.0, p));
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * m_samples.size()));
+    return m_samples[rank > 0 ? rank - 1 : 0];
+}
+
+std::string SampleStats::summary() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2)
+        << "n=" << count()
+        << " mean=" << mean()
+        << " p50=" << percentile(50.0)
+        << " p90=" << percentile(90.0)
+        << " p99=" << percentile(99.0)
+        << " max=" << max();
+    return out.str();
+}
+
+// ---------------------------------------------------------------------------
+// JsonStreamSplitter
+// ---------------------------------------------------------------------------
+
+void JsonStreamSplitter::feed(const char* data, size_t size, std::vector<std::string>& out) {
+    m_buffer.append(data, size);
+
+    size_t start = 0;
+    for (size_t i = m_scan; i < m_buffer.size(); ++i) {
+        char c = m_buffer[i];
+        if (m_inString) {
+            if (m_escape) m_escape = false;
+            else if (c == '\\') m_escape = true;
+            else if (c == '"') m_inString = false;
+            continue;
+        }
+        if (c == '"') {
+            m_inString = true;
+        } else if (c == '{') {
+            if (m_depth == 0) start = i;
+            ++m_depth;
+        } else if (c == '}' && m_depth > 0) {
+            if (--m_depth == 0) {
+                out.emplace_back(m_buffer, start, i + 1 - start);
+                start = i + 1;
+            }
+        } else if (m_depth == 0) {
+            start = i + 1;      // whitespace or newlines between messages
+        }
+    }
+
+    m_buffer.erase(0, start);
+    m_scan = m_buffer.size();
+}
+
+// ---------------------------------------------------------------------------
+// LoadBotSwarm
+// ---------------------------------------------------------------------------
+
+LoadBotSwarm::LoadBotSwarm(const LoadBotConfig& config)
+    : m_config(config) {
+}
+
+LoadBotSwarm::~LoadBotSwarm() {
+    for (auto& bot : m_bots) {
+        if (bot.fd >= 0) ::close(bot.fd);
+    }
+    if (m_epoll >= 0) ::close(m_epoll);
+}
+
+double LoadBotSwarm::now() {
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool LoadBotSwarm::run() {
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* resolved = nullptr;
+    if (getaddrinfo(m_config.host.c_str(), nullptr, &hints, &resolved) != 0 || !resolved) {
+        std::cerr << "[LoadBot] Cannot resolve " << m_config.host << std::endl;
+        return false;
+    }
+    m_address = reinterpret_cast<sockaddr_in*>(resolved->ai_addr)->sin_addr.s_addr;
+    freeaddrinfo(resolved);
+
+    m_epoll = epoll_create1(0);
+    if (m_epoll < 0) {
+        std::cerr << "[LoadBot] epoll_create1 failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    m_bots.resize(static_cast<size_t>(std::max(0, m_config.botCount)));
+    for (size_t i = 0; i < m_bots.size(); ++i) {
+        m_bots[i].name = "loadbot_" + std::to_string(i);
+        m_bots[i].rng.seed(m_config.seed * 7919u + static_cast<unsigned int>(i));
+    }
+
+    m_start = now();
+    const double deadline = m_start + m_config.duration;
+    const double connectRate = std::max(1.0f, m_config.connectRate);
+    size_t launched = 0;
+    double nextActionScan = m_start;
+    double nextSecond = m_start + 1.0;
+
+    std::vector<epoll_event> events(512);
+    while (true) {
+        double t = now();
+        if (t >= deadline) break;
+
+        // Ramp up at the configured connection rate
+        size_t due = std::min(m_bots.size(),
+                              static_cast<size_t>((t - m_start) * connectRate) + 1);
+        while (launched < due) startConnect(launched++, t);
+
+        int ready = epoll_wait(m_epoll, events.data(), static_cast<int>(events.size()), 5);
+        if (ready < 0 && errno != EINTR) {
+            std::cerr << "[LoadBot] epoll_wait failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        t = now();
+        for (int e = 0; e < ready; ++e) {
+            size_t index = static_cast<size_t>(events[e].data.u64);
+            uint32_t flags = events[e].events;
+            Bot& bot = m_bots[index];
+            if (bot.state == BotState::Connecting) {
+                finishConnect(index, t);
+                continue;
+            }
+            if (flags & EPOLLIN) readBot(index, t);
+            if (bot.state == BotState::Closed) continue;
+            if ((flags & EPOLLOUT) && bot.wantWrite) flushBot(index);
+            if (bot.state != BotState::Closed && (flags & (EPOLLERR | EPOLLHUP))) {
+                closeBot(index, t, false);
+            }
+        }
+
+        if (t >= nextActionScan) {
+            nextActionScan = t + 0.01;
+            for (size_t i = 0; i < launched; ++i) {
+                Bot& bot = m_bots[i];
+                if (bot.state == BotState::Closed || bot.state == BotState::Idle) continue;
+                expirePending(bot, t);
+                if (bot.state == BotState::Active) runActions(i, t);
+            }
+        }
+
+        if (t >= nextSecond) {
+            m_aggregateIn.add(static_cast<double>(m_secondBytes) / 1024.0);
+            m_secondBytes = 0;
+            nextSecond += 1.0;
+            sampleServerMetrics();
+        }
+    }
+
+    double end = now();
+    m_runTime = end - m_start;
+    for (size_t i = 0; i < m_bots.size(); ++i) {
+        Bot& bot = m_bots[i];
+        if (bot.state == BotState::Active) {
+            bot.activeUntil = end;
+            double active = bot.activeUntil - bot.activeSince;
+            if (active > 0.5) {
+                m_bytesInPerBot.add(static_cast<double>(bot.bytesIn) / 1024.0 / active);
+                m_bytesOutPerBot.add(static_cast<double>(bot.bytesOut) / 1024.0 / active);
+            }
+        }
+        if (bot.fd >= 0) {
+            ::close(bot.fd);
+            bot.fd = -1;
+        }
+        bot.state = BotState::Closed;
+    }
+    return true;
+}
+
+void LoadBotSwarm::startConnect(size_t index, double t) {
+    Bot& bot = m_bots[index];
+    bot.fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (bot.fd < 0) {
+        if (m_config.verbose) {
+            std::cerr << "[LoadBot] socket() failed for " << bot.name << ": "
+                      << std::strerror(errno) << std::endl;
+        }
+        bot.state = BotState::Closed;
+        ++m_failed;
+        return;
+    }
+    int one = 1;
+    setsockopt(bot.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(m_config.port));
+    addr.sin_addr.s_addr = m_address;
+
+    bot.state = BotState::Connecting;
+    bot.activeSince = t;
+    if (::connect(bot.fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 &&
+        errno != EINPROGRESS) {
+        closeBot(index, t, true);
+        return;
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLOUT;
+    ev.data.u64 = index;
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, bot.fd, &ev);
+}
+
+void LoadBotSwarm::finishConnect(size_t index, double t) {
+    Bot& bot = m_bots[index];
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if (getsockopt(bot.fd, SOL_SOCKET, SO_ERROR, &error, &length) < 0 || error != 0) {
+        if (m_config.verbose) {
+            std::cerr << "[LoadBot] " << bot.name << " failed to connect: "
+                      << std::strerror(error) << std::endl;
+        }
+        closeBot(index, t, true);
+        return;
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = index;
+    epoll_ctl(m_epoll, EPOLL_CTL_MOD, bot.fd, &ev);
+
+    bot.state = BotState::Handshake;
+    send(index, m_protocol.createConnectMessage(bot.name, bot.name), "connect", t);
+}
+
+void LoadBotSwarm::closeBot(size_t index, double t, bool failed) {
+    Bot& bot = m_bots[index];
+    if (bot.state == BotState::Active) {
+        bot.activeUntil = t;
+        double active = bot.activeUntil - bot.activeSince;
+        if (active > 0.5) {
+            m_bytesInPerBot.add(static_cast<double>(bot.bytesIn) / 1024.0 / active);
+            m_bytesOutPerBot.add(static_cast<double>(bot.bytesOut) / 1024.0 / active);
+        }
+    }
+    if (failed || bot.state != BotState::Active) ++m_failed;
+    else ++m_disconnected;
+
+    if (bot.fd >= 0) {
+        epoll_ctl(m_epoll, EPOLL_CTL_DEL, bot.fd, nullptr);
+        ::close(bot.fd);
+        bot.fd = -1;
+    }
+    m_timeouts += bot.pending.size();
+    bot.pending.clear();
+    bot.state = BotState::Closed;
+}
+
+void LoadBotSwarm::readBot(size_t index, double t) {
+    Bot& bot = m_bots[index];
+    char buffer[65536];
+    std::vector<std::string> messages;
+    while (true) {
+        ssize_t received = ::recv(bot.fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            bot.bytesIn += static_cast<uint64_t>(received);
+            m_secondBytes += static_cast<uint64_t>(received);
+            bot.splitter.feed(buffer, static_cast<size_t>(received), messages);
+            continue;
+        }
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (received < 0 && errno == EINTR) continue;
+
+        for (const auto& message : messages) handleMessage(index, message, t);
+        if (m_config.verbose) {
+            std::cerr << "[LoadBot] " << bot.name << " disconnected by server" << std::endl;
+        }
+        closeBot(index, t, false);
+        return;
+    }
+    for (const auto& message : messages) handleMessage(index, message, t);
+}
+
+void LoadBotSwarm::flushBot(size_t index) {
+    Bot& bot = m_bots[index];
+    while (!bot.outbox.empty()) {
+        ssize_t sent = ::send(bot.fd, bot.outbox.data(), bot.outbox.size(), MSG_NOSIGNAL);
+        if (sent > 0) {
+            bot.outbox.erase(0, static_cast<size_t>(sent));
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (!bot.wantWrite) {
+                bot.wantWrite = true;
+                epoll_event ev{};
+                ev.events = EPOLLIN | EPOLLOUT;
+                ev.data.u64 = index;
+                epoll_ctl(m_epoll, EPOLL_CTL_MOD, bot.fd, &ev);
+            }
+            return;
+        }
+        closeBot(index, now(), false);
+        return;
+    }
+    if (bot.wantWrite) {
+        bot.wantWrite = false;
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = index;
+        epoll_ctl(m_epoll, EPOLL_CTL_MOD, bot.fd, &ev);
+    }
+}
+
+void LoadBotSwarm::send(size_t index, const std::string& message, const std::string& kind,
+                        double t, const std::string& token) {
+    Bot& bot = m_bots[index];
+    bot.outbox += message;
+    bot.bytesOut += message.size();
+    bot.lastSendAt = t;
+    ++m_sent[kind];
+    bot.pending.push_back(Pending{kind, token, t});
+    flushBot(index);
+}
+
+void LoadBotSwarm::handleMessage(size_t index, const std::string& message, double t) {
+    Bot& bot = m_bots[index];
+    ++m_messagesIn;
+    std::string type = messageType(message);
+
+    if (type == "state_update") {
+        // Every client receives the same broadcast; a few samplers suffice
+        if (static_cast<int>(index) >= m_config.tickSampleBots) return;
+        double sequence = 0.0;
+        double serverTime = 0.0;
+        if (!numberField(message, "sequence", sequence) ||
+            !numberField(message, "timestamp", serverTime)) return;
+        uint64_t seq = static_cast<uint64_t>(sequence);
+        if (bot.lastSequence > 0 && seq > bot.lastSequence) {
+            uint64_t steps = seq - bot.lastSequence;
+            m_tickIntervalEstimate.add((serverTime - bot.lastServerTime) /
+                                       static_cast<double>(steps));
+            m_sequenceGaps += steps - 1;
+        }
+        bot.lastSequence = seq;
+        bot.lastServerTime = serverTime;
+        return;
+    }
+
+    if (type == "ping") {
+        // Answer straight away so the server's RTT sample is not skewed by
+        // the send pacing; a pong is not a request awaiting a response
+        double nonce = 0.0;
+        if (!numberField(message, "nonce", nonce)) return;
+        std::string pong = m_protocol.createMessage(
+            "pong", "{\"nonce\":" + std::to_string(static_cast<uint64_t>(nonce)) + "}");
+        bot.outbox += pong;
+        bot.bytesOut += pong.size();
+        flushBot(index);
+        return;
+    }
+
+    if (type == "spawn_entity") {
+        std::string id = stringField(message, "entity_id");
+        if (!id.empty() && m_targetSet.insert(id).second) m_targets.push_back(id);
+        return;
+    }
+
+    if (type == "connect_ack") {
+        bot.entityId = stringField(message, "player_entity_id");
+        if (bot.state == BotState::Handshake) {
+            bot.state = BotState::Active;
+            m_connectLatency.add((t - bot.activeSince) * 1000.0);
+            bot.activeSince = t;
+            bot.bytesIn = 0;
+            bot.bytesOut = 0;
+            ++m_connected;
+            for (int a = 0; a < static_cast<int>(Action::Count); ++a) {
+                scheduleAction(bot, static_cast<Action>(a), t);
+            }
+        }
+    }
+
+    // Match the oldest outstanding request this response answers; an
+    // error answers whatever was asked first
+    bool isError = (type == "error");
+    const char* kind = responseKind(type);
+    if (!kind && !isError) return;
+    if (isError) ++m_errors;
+    for (auto it = bot.pending.begin(); it != bot.pending.end(); ++it) {
+        if (isError ? it->kind == "connect" : it->kind != kind) continue;
+        if (!it->token.empty() && message.find(it->token) == std::string::npos) continue;
+        double ms = (t - it->sentAt) * 1000.0;
+        if (it->kind != "connect") {
+            m_latency.add(ms);
+            m_latencyByKind[it->kind].add(ms);
+        }
+        bot.pending.erase(it);
+        break;
+    }
+}
+
+void LoadBotSwarm::scheduleAction(Bot& bot, Action action, double t) {
+    float perMinute = 0.0f;
+    switch (action) {
+        case Action::Undock:       perMinute = m_config.undockPerMinute; break;
+        case Action::Warp:         perMinute = m_config.warpPerMinute; break;
+        case Action::Orbit:        perMinute = m_config.orbitPerMinute; break;
+        case Action::LockAndShoot: perMinute = m_config.lockAndShootPerMinute; break;
+        case Action::Market:       perMinute = m_config.marketPerMinute; break;
+        case Action::Chat:         perMinute = m_config.chatPerMinute; break;
+        case Action::Count:        break;
+    }
+    int slot = static_cast<int>(action);
+    if (perMinute <= 0.0f) {
+        bot.nextAction[slot] = std::numeric_limits<double>::infinity();
+        return;
+    }
+    std::exponential_distribution<double> gap(perMinute / 60.0);
+    bot.nextAction[slot] = t + gap(bot.rng);
+}
+
+std::string LoadBotSwarm::pickTarget(Bot& bot) {
+    if (m_targets.empty()) return "";
+    std::uniform_int_distribution<size_t> pick(0, m_targets.size() - 1);
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        const std::string& id = m_targets[pick(bot.rng)];
+        if (id != bot.entityId) return id;
+    }
+    return "";
+}
+
+void LoadBotSwarm::runActions(size_t index, double t) {
+    Bot& bot = m_bots[index];
+    if (t - bot.lastSendAt < MIN_SEND_SPACING) return;
+
+    if (bot.shootAt > 0.0 && t >= bot.shootAt) {
+        bot.shootAt = 0.0;
+        send(index, m_protocol.createModuleActivateMessage(0, bot.lockedTarget), "shoot", t);
+        return;
+    }
+
+    // At most one message per pass; anything else due waits its turn
+    for (int a = 0; a < static_cast<int>(Action::Count); ++a) {
+        if (t < bot.nextAction[a]) continue;
+        Action action = static_cast<Action>(a);
+        scheduleAction(bot, action, t);
+
+        std::ostringstream data;
+        switch (action) {
+            case Action::Undock:
+                send(index, m_protocol.createUndockRequestMessage(), ACTION_NAMES[a], t);
+                return;
+            case Action::Warp: {
+                std::uniform_real_distribution<double> offset(-5.0e6, 5.0e6);
+                data << "{\"dest_x\":" << offset(bot.rng)
+                     << ",\"dest_y\":" << offset(bot.rng) * 0.1
+                     << ",\"dest_z\":" << offset(bot.rng) << "}";
+                send(index, m_protocol.createMessage("warp_request", data.str()),
+                     ACTION_NAMES[a], t);
+                return;
+            }
+            case Action::Orbit: {
+                std::string target = pickTarget(bot);
+                if (target.empty()) continue;
+                data << "{\"target_id\":\"" << target << "\",\"distance\":5000}";
+                send(index, m_protocol.createMessage("orbit", data.str()), ACTION_NAMES[a], t);
+                return;
+            }
+            case Action::LockAndShoot: {
+                std::string target = pickTarget(bot);
+                if (target.empty()) continue;
+                bot.lockedTarget = target;
+                bot.shootAt = t + SHOOT_DELAY;
+                send(index, m_protocol.createTargetLockMessage(target), ACTION_NAMES[a], t);
+                return;
+            }
+            case Action::Market:
+                data << "{\"station_id\":\"" << m_config.marketStation
+                     << "\",\"item_id\":\"" << m_config.marketItem
+                     << "\",\"resolution\":\"1h\",\"count\":24}";
+                send(index, m_protocol.createMessage("market_history", data.str()),
+                     ACTION_NAMES[a], t);
+                return;
+            case Action::Chat: {
+                // The echo from the channel carries the nonce back
+                std::string token = bot.name + "#" + std::to_string(++m_chatNonce);
+                send(index, m_protocol.createChatMessage("o7 " + token), ACTION_NAMES[a],
+                     t, token);
+                return;
+            }
+            case Action::Count:
+                break;
+        }
+    }
+}
+
+void LoadBotSwarm::expirePending(Bot& bot, double t) {
+    while (!bot.pending.empty() &&
+           t - bot.pending.front().sentAt > m_config.responseTimeout) {
+        bot.pending.pop_front();
+        ++m_timeouts;
+    }
+}
+
+void LoadBotSwarm::sampleServerMetrics() {
+    if (m_config.serverMetricsPath.empty()) return;
+    std::ifstream file(m_config.serverMetricsPath);
+    if (!file) return;
+    std::ostringstream text;
+    text << file.rdbuf();
+
+    std::map<std::string, double> metrics;
+    if (!parseMetricsText(text.str(), metrics)) return;
+    auto ticks = metrics.find("atlas_ticks_total");
+    auto uptime = metrics.find("atlas_uptime_seconds");
+    if (ticks == metrics.end() || uptime == metrics.end()) return;
+
+    // The file is rewritten every metrics_export_interval_seconds; only a
+    // new export is a new sample
+    if (ticks->second == m_lastServerTicks) return;
+    if (m_lastServerTicks >= 0.0 && uptime->second > m_lastServerUptime) {
+        m_serverTickRate.add((ticks->second - m_lastServerTicks) /
+                             (uptime->second - m_lastServerUptime));
+    }
+    m_lastServerTicks = ticks->second;
+    m_lastServerUptime = uptime->second;
+    ++m_serverExports;
+
+    auto avg = metrics.find("atlas_tick_duration_avg_ms");
+    if (avg != metrics.end()) m_serverTickAvg.add(avg->second);
+    auto max = metrics.find("atlas_tick_duration_max_ms");
+    if (max != metrics.end()) m_serverTickMax.add(max->second);
+}
+
+std::string LoadBotSwarm::report() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    out << "=== Load Bot Report ===\n";
+    out << "Bots:        " << m_bots.size() << " requested, " << m_connected << " connected, "
+        << m_failed << " failed, " << m_disconnected << " dropped by server\n";
+    out << "Run time:    " << m_runTime << " s, " << m_messagesIn << " messages received\n";
+
+    out << "Sent:       ";
+    for (const auto& kv : m_sent) out << " " << kv.first << "=" << kv.second;
+    out << "\n";
+    out << "Timeouts:    " << m_timeouts << " (no reply within " << m_config.responseTimeout
+        << " s), " << m_errors << " error replies\n";
+
+    out << "\nClient-observed latency (ms)\n";
+    out << "  connect    " << m_connectLatency.summary() << "\n";
+    out << "  all        " << m_latency.summary() << "\n";
+    for (const auto& kv : m_latencyByKind) {
+        out << "  " << std::left << std::setw(10) << kv.first << " " << kv.second.summary() << "\n";
+    }
+
+    out << "\nServer tick (ms, from the server's metrics export)\n";
+    if (m_serverExports == 0) {
+        out << "  not sampled; pass the server's metrics_export_path with --server-metrics\n";
+    } else {
+        out << "  duration avg   " << m_serverTickAvg.summary() << "\n";
+        out << "  duration max   " << m_serverTickMax.summary() << "\n";
+        out << "  ticks/s        " << m_serverTickRate.summary() << "\n";
+    }
+
+    out << "\nTick interval, client-side estimate (ms, state_update stamps)\n";
+    out << "  " << m_tickIntervalEstimate.summary() << "\n";
+    out << "  sequence gaps: " << m_sequenceGaps << "\n";
+
+    out << "\nBandwidth (KB/s)\n";
+    out << "  in per bot     " << m_bytesInPerBot.summary() << "\n";
+    out << "  out per bot    " << m_bytesOutPerBot.summary() << "\n";
+    out << "  in swarm-wide  " << m_aggregateIn.summary() << "\n";
+    return out.str();
+}
+
+} // namespace atlas
@@ -0,0 +1,157 @@
+#include "network/message_stream.h"
+#include <algorithm>
+#include <cstring>
+
+namespace atlas {
+
+MessageStream::MessageStream(size_t blockSize, size_t queueCapacity)
+    : m_blockSize(std::max<size_t>(blockSize, 256))
+    , m_queue(queueCapacity)
+{
+    m_current = acquireBlock(m_blockSize);
+}
+
+MessageStream::~MessageStream() = default;
+
+char* MessageStream::prepareWrite(size_t& available) {
+    if (m_size == m_current->capacity) startBlock();
+    available = m_current->capacity - m_size;
+    return m_current->data.get() + m_size;
+}
+
+bool MessageStream::commit(size_t bytes) {
+    char* data = m_current->data.get();
+    size_t scan = m_size;
+    m_size += bytes;
+    m_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    // Only the new bytes are searched; earlier ones held no newline
+    while (scan < m_size) {
+        const char* newline = static_cast<const char*>(std::memchr(data + scan, '\n', m_size - scan));
+        if (!newline) break;
+        size_t end = static_cast<size_t>(newline - data);
+        if (end > m_frameStart) {
+            Message message;
+            message.text = std::string_view(data + m_frameStart, end - m_frameStart);
+            message.block = m_current;
+            m_current->references.fetch_add(1, std::memory_order_relaxed);
+            if (!m_queue.push(message) && !waitToPush(message)) {
+                m_current->references.fetch_sub(1, std::memory_order_relaxed);
+                return false;
+            }
+            m_messages.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_frameStart = end + 1;
+        scan = end + 1;
+    }
+    return !m_closed.load(std::memory_order_acquire);
+}
+
+bool MessageStream::waitToPush(const Message& message) {
+    std::unique_lock<std::mutex> lock(m_spaceMutex);
+    m_receiverWaiting.store(true, std::memory_order_relaxed);
+    // Pairs with the fence in wakeReceiver(): either the consumer sees the
+    // flag, or the push below sees the space it freed
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    bool pushed = false;
+    m_spaceFreed.wait(lock, [&]() {
+        pushed = m_queue.push(message);
+        return pushed || m_closed.load(std::memory_order_acquire);
+    });
+    m_receiverWaiting.store(false, std::memory_order_relaxed);
+    return pushed;
+}
+
+void MessageStream::wakeReceiver() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!m_receiverWaiting.load(std::memory_order_relaxed)) return;
+    std::lock_guard<std::mutex> lock(m_spaceMutex);
+    m_spaceFreed.notify_one();
+}
+
+void MessageStream::close() {
+    {
+        std::lock_guard<std::mutex> lock(m_spaceMutex);
+        m_closed.store(true, std::memory_order_release);
+    }
+    m_spaceFreed.notify_all();
+}
+
+void MessageStream::startBlock() {
+    size_t tail = m_size - m_frameStart;
+
+    // Nothing queued from this block: slide the unfinished message to the front
+    if (tail < m_current->capacity && m_current->references.load(std::memory_order_acquire) == 1) {
+        std::memmove(m_current->data.get(), m_current->data.get() + m_frameStart, tail);
+        m_size = tail;
+        m_frameStart = 0;
+        return;
+    }
+
+    // Room for the unfinished message to at least double
+    ReceiveBlock* next = acquireBlock(std::max(m_blockSize, tail * 2));
+    std::memcpy(next->data.get(), m_current->data.get() + m_frameStart, tail);
+    retire(m_current);
+    m_current = next;
+    m_size = tail;
+    m_frameStart = 0;
+}
+
+ReceiveBlock* MessageStream::acquireBlock(size_t minCapacity) {
+    for (ReceiveBlock* block = m_returned.exchange(nullptr, std::memory_order_acquire); block;) {
+        ReceiveBlock* next = block->next;
+        m_free.push_back(block);
+        block = next;
+    }
+
+    auto fits = std::find_if(m_free.begin(), m_free.end(),
+                             [minCapacity](const ReceiveBlock* block) { return block->capacity >= minCapacity; });
+    if (fits != m_free.end()) {
+        ReceiveBlock* block = *fits;
+        *fits = m_free.back();
+        m_free.pop_back();
+        block->references.store(1, std::memory_order_relaxed);
+        return block;
+    }
+
+    auto block = std::make_unique<ReceiveBlock>();
+    block->data.reset(new char[minCapacity]);
+    block->capacity = minCapacity;
+    block->references.store(1, std::memory_order_relaxed);
+    m_blocks.push_back(std::move(block));
+    m_blocksAllocated.fetch_add(1, std::memory_order_relaxed);
+    return m_blocks.back().get();
+}
+
+void MessageStream::retire(ReceiveBlock* block) {
+    if (block->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        m_free.push_back(block);
+    }
+}
+
+void MessageStream::release(ReceiveBlock* block) {
+    if (block->references.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    // Last message handled after the receiving thread moved on
+    ReceiveBlock* head = m_returned.load(std::memory_order_relaxed);
+    do {
+        block->next = head;
+    } while (!m_returned.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void MessageStream::reset() {
+    consume([](std::string_view) {});
+    m_returned.store(nullptr, std::memory_order_relaxed);
+    m_free.clear();
+    for (auto& block : m_blocks) {
+        block->references.store(0, std::memory_order_relaxed);
+        m_free.push_back(block.get());
+    }
+    m_current = acquireBlock(m_blockSize);
+    m_size = 0;
+    m_frameStart = 0;
+    m_closed.store(false, std::memory_order_release);
+}
+
+} // namespace atlas
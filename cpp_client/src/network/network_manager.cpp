@@ -11,7 +11,7 @@ NetworkManager::NetworkManager()
     , m_state(State::DISCONNECTED)
 {
     // Set up callbacks
-    m_tcpClient->setMessageCallback([this](const std::string& msg) {
+    m_tcpClient->setMessageCallback([this](std::string_view msg) {
         onRawMessage(msg);
     });
 
@@ -274,7 +274,7 @@ std::string NetworkManager::getConnectionState() const {
     }
 }
 
-void NetworkManager::onRawMessage(const std::string& message) {
+void NetworkManager::onRawMessage(std::string_view message) {
     // Parse and dispatch through protocol handler
     m_protocolHandler->handleMessage(message);
 }
@@ -285,6 +285,9 @@ void NetworkManager::onProtocolMessage(const std::string& type, const std::strin
         m_state = State::AUTHENTICATED;
         m_authenticated = true;
         std::cout << "Connection acknowledged by server" << std::endl;
+    } else if (type == "ping") {
+        // Echo the nonce so the server can measure round-trip time
+        m_tcpClient->send(m_protocolHandler->createMessage("pong", dataJson));
     } else if (type == "error") {
         handleErrorResponse(dataJson);
     }
@@ -10,9 +10,9 @@ namespace atlas {
 ProtocolHandler::ProtocolHandler() {
 }
 
-void ProtocolHandler::handleMessage(const std::string& message) {
+void ProtocolHandler::handleMessage(std::string_view message) {
     try {
-        auto j = json::parse(message);
+        auto j = json::parse(message.begin(), message.end());
         
         // Extract message type and data
         std::string type = j.value("type", "");
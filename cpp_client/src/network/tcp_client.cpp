@@ -1,5 +1,7 @@
 #include "network/tcp_client.h"
 #include <iostream>
+#include <algorithm>
+#include <climits>
 #include <cstring>
 
 #ifdef _WIN32
@@ -13,7 +15,6 @@
     #include <arpa/inet.h>
     #include <netdb.h>
     #include <unistd.h>
-    #include <fcntl.h>
     #include <errno.h>
     #define INVALID_SOCKET -1
     #define SOCKET_ERROR -1
@@ -45,15 +46,12 @@ TCPClient::TCPClient()
 }
 
 TCPClient::~TCPClient() {
-    if (m_connected.load()) {
-        disconnect();
-    }
+    disconnect();
 }
 
 bool TCPClient::connect(const std::string& host, int port) {
-    if (m_connected) {
-        disconnect();
-    }
+    // Also joins a receive thread left over from a connection the server closed
+    disconnect();
 
     // Resolve hostname
     struct addrinfo hints, *result = nullptr;
@@ -104,15 +102,9 @@ bool TCPClient::connect(const std::string& host, int port) {
         return false;
     }
 
-    // Set non-blocking mode for receive
-#ifdef _WIN32
-    u_long mode = 1;
-    ioctlsocket(static_cast<SOCKET>(reinterpret_cast<uintptr_t>(m_socket)), FIONBIO, &mode);
-#else
-    int flags = fcntl(m_socket, F_GETFL, 0);
-    fcntl(m_socket, F_SETFL, flags | O_NONBLOCK);
-#endif
-
+    // The socket stays blocking: the receive thread sleeps in recv() until
+    // data arrives, and disconnect() wakes it with shutdown()
+    m_stream.reset();
     m_connected = true;
     m_receiveThread = std::make_unique<std::thread>(&TCPClient::receiveThread, this);
 
@@ -121,28 +113,42 @@ bool TCPClient::connect(const std::string& host, int port) {
 }
 
 void TCPClient::disconnect() {
-    if (m_connected) {
-        m_connected = false;
+    // The receive thread outlives the connection when the server closes it
+    if (!m_receiveThread) return;
 
-        // Close socket first to break receive loop
+    bool wasConnected = m_connected.exchange(false);
+    m_stream.close();
+
+    // Shut down first to wake the blocked recv(), close once it has returned
 #ifdef _WIN32
-        if (m_socket != nullptr) {
-            closesocket(static_cast<SOCKET>(reinterpret_cast<uintptr_t>(m_socket)));
-        }
-        m_socket = nullptr;
+    if (m_socket != nullptr) {
+        shutdown(static_cast<SOCKET>(reinterpret_cast<uintptr_t>(m_socket)), SD_BOTH);
+    }
 #else
-        if (m_socket != INVALID_SOCKET) {
-            ::close(m_socket);
-        }
-        m_socket = INVALID_SOCKET;
+    if (m_socket != INVALID_SOCKET) {
+        shutdown(m_socket, SHUT_RDWR);
+    }
 #endif
 
-        // Wait for receive thread to finish
-        if (m_receiveThread && m_receiveThread->joinable()) {
-            m_receiveThread->join();
-        }
-        m_receiveThread.reset();
+    // Wait for receive thread to finish
+    if (m_receiveThread->joinable()) {
+        m_receiveThread->join();
+    }
+    m_receiveThread.reset();
 
+#ifdef _WIN32
+    if (m_socket != nullptr) {
+        closesocket(static_cast<SOCKET>(reinterpret_cast<uintptr_t>(m_socket)));
+    }
+    m_socket = nullptr;
+#else
+    if (m_socket != INVALID_SOCKET) {
+        ::close(m_socket);
+    }
+    m_socket = INVALID_SOCKET;
+#endif
+
+    if (wasConnected) {
         std::cout << "Disconnected from server" << std::endl;
     }
 }
@@ -169,64 +175,47 @@ bool TCPClient::send(const std::string& message) {
     return true;
 }
 
-void TCPClient::processMessages() {
-    std::lock_guard<std::mutex> lock(m_queueMutex);
-    while (!m_messageQueue.empty()) {
+size_t TCPClient::processMessages() {
+    return m_stream.consume([this](std::string_view message) {
         if (m_messageCallback) {
-            m_messageCallback(m_messageQueue.front());
+            m_messageCallback(message);
         }
-        m_messageQueue.pop();
-    }
+    });
 }
 
 void TCPClient::receiveThread() {
-    char buffer[8192];
-    std::string incompleteMessage;
-
     while (m_connected) {
+        size_t available = 0;
+        char* buffer = m_stream.prepareWrite(available);
 #ifdef _WIN32
-        int bytesReceived = recv(static_cast<SOCKET>(reinterpret_cast<uintptr_t>(m_socket)), buffer, sizeof(buffer) - 1, 0);
+        int bytesReceived = recv(static_cast<SOCKET>(reinterpret_cast<uintptr_t>(m_socket)), buffer,
+                                 static_cast<int>(std::min<size_t>(available, INT_MAX)), 0);
 #else
-        ssize_t bytesReceived = recv(m_socket, buffer, sizeof(buffer) - 1, 0);
+        ssize_t bytesReceived = recv(m_socket, buffer, available, 0);
 #endif
 
         if (bytesReceived > 0) {
-            buffer[bytesReceived] = '\0';
-            incompleteMessage += buffer;
-
-            // Process complete messages (delimited by newline)
-            size_t pos;
-            while ((pos = incompleteMessage.find('\n')) != std::string::npos) {
-                std::string message = incompleteMessage.substr(0, pos);
-                incompleteMessage = incompleteMessage.substr(pos + 1);
-
-                if (!message.empty()) {
-                    std::cout << "[DEBUG] Received: " << message << std::endl;
-                    std::lock_guard<std::mutex> lock(m_queueMutex);
-                    m_messageQueue.push(message);
-                }
+            // Complete messages are queued in place
+            if (!m_stream.commit(static_cast<size_t>(bytesReceived))) {
+                break;
             }
         } else if (bytesReceived == 0) {
-            // Connection closed
-            std::cout << "Server closed connection" << std::endl;
-            m_connected = false;
+            // Connection closed (or shut down by disconnect())
+            if (m_connected.exchange(false)) {
+                std::cout << "Server closed connection" << std::endl;
+            }
             break;
         } else {
 #ifdef _WIN32
             int err = WSAGetLastError();
-            if (err != WSAEWOULDBLOCK && err != WSAECONNRESET) {
+            if (err == WSAEINTR) continue;
 #else
-            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != ECONNRESET) {
+            if (errno == EINTR) continue;
 #endif
+            if (m_connected.exchange(false)) {
                 std::cerr << "Receive error" << std::endl;
-                m_connected = false;
-                break;
             }
-        }
-
-        // Small sleep to avoid busy waiting
-        if (m_connected) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            break;
         }
     }
 }
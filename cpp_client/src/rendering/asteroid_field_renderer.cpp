@@ -1,4 +1,5 @@
 #include "rendering/asteroid_field_renderer.h"
+#include "rendering/mesh_disk_cache.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/constants.hpp>
 #include <cmath>
@@ -16,14 +17,14 @@ AsteroidFieldRenderer::~AsteroidFieldRenderer() {
     clearField();
 }
 
-bool AsteroidFieldRenderer::initialize() {
+bool AsteroidFieldRenderer::initialize(MeshDiskCache* diskCache) {
     std::cout << "[AsteroidFieldRenderer] Initializing..." << std::endl;
     
     // Create instanced renderer
     m_renderer = std::make_unique<InstancedRenderer>();
     
     // Create procedural asteroid meshes
-    createAsteroidMeshes();
+    createAsteroidMeshes(diskCache);
     
     // Register meshes with instanced renderer
     if (m_asteroidMeshes.empty()) {
@@ -43,18 +44,38 @@ bool AsteroidFieldRenderer::initialize() {
     return true;
 }
 
-void AsteroidFieldRenderer::createAsteroidMeshes() {
+size_t AsteroidFieldRenderer::bakeMeshes(MeshDiskCache& diskCache) {
+    createAsteroidMeshes(&diskCache);
+    size_t count = m_asteroidMeshes.size();
+    m_asteroidMeshes.clear();
+    return count;
+}
+
+void AsteroidFieldRenderer::createAsteroidMeshes(MeshDiskCache* diskCache) {
     std::cout << "[AsteroidFieldRenderer] Creating procedural asteroid meshes..." << std::endl;
     
+    m_asteroidMeshes.clear();
+    auto build = [this, diskCache](int subdivisions, float displacement, int seed) {
+        // Every generator parameter is part of the key
+        MeshCacheKey key;
+        key.shipType = "asteroid_d" + std::to_string(static_cast<int>(displacement * 1000.0f)) +
+                       "_s" + std::to_string(subdivisions);
+        key.faction = "asteroid";
+        key.seed = static_cast<uint32_t>(seed);
+        return loadOrBakeMesh(diskCache, key, [this, subdivisions, displacement, seed]() {
+            return createAsteroidMesh(subdivisions, displacement, seed);
+        });
+    };
+    
     // Create 3 different asteroid mesh types with varying detail
     // Type 0: Low detail (for distant/small asteroids)
-    m_asteroidMeshes.push_back(createAsteroidMesh(1, 0.2f, 100));
+    m_asteroidMeshes.push_back(build(1, 0.2f, 100));
     
     // Type 1: Medium detail (for medium asteroids)
-    m_asteroidMeshes.push_back(createAsteroidMesh(2, 0.3f, 200));
+    m_asteroidMeshes.push_back(build(2, 0.3f, 200));
     
     // Type 2: High detail (for large/huge asteroids)
-    m_asteroidMeshes.push_back(createAsteroidMesh(2, 0.35f, 300));
+    m_asteroidMeshes.push_back(build(2, 0.35f, 300));
     
     std::cout << "[AsteroidFieldRenderer] Created " << m_asteroidMeshes.size() 
               << " asteroid mesh types" << std::endl;
@@ -0,0 +1,298 @@
+#include "rendering/batch_culler.h"
+#include "rendering/frustum_culler.h"
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define ATLAS_CULL_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ATLAS_CULL_SSE2 1
+#endif
+
+namespace atlas {
+
+namespace {
+
+#if defined(ATLAS_CULL_AVX)
+constexpr unsigned int SIMD_WIDTH = 8;
+#elif defined(ATLAS_CULL_SSE2)
+constexpr unsigned int SIMD_WIDTH = 4;
+#else
+constexpr unsigned int SIMD_WIDTH = 1;
+#endif
+
+// Pass inputs shared by every range
+struct CullParams {
+    float planes[6][4];          // normal xyz, distance
+    bool testFrustum = false;
+    glm::vec3 camera;
+    float mediumSq = 0.0f;       // squared LOD band starts
+    float lowSq = 0.0f;
+    float cullSq = 0.0f;
+};
+
+struct RangeCounts {
+    size_t frustumCulled = 0;
+    size_t distanceCulled = 0;
+};
+
+// One sphere, with the same arithmetic order as the vector paths so both
+// agree exactly
+inline void cullOne(const CullParams& params, const SphereArrays& spheres, size_t i, uint8_t* lod,
+                    std::vector<uint32_t>& visible, RangeCounts& counts) {
+    float x = spheres.x[i];
+    float y = spheres.y[i];
+    float z = spheres.z[i];
+    float negRadius = -spheres.radius[i];
+
+    bool inside = true;
+    if (params.testFrustum) {
+        for (const auto& plane : params.planes) {
+            float distance = plane[0] * x + plane[1] * y + plane[2] * z + plane[3];
+            if (distance < negRadius) inside = false;
+        }
+    }
+
+    float dx = x - params.camera.x;
+    float dy = y - params.camera.y;
+    float dz = z - params.camera.z;
+    float distanceSq = dx * dx + dy * dy + dz * dz;
+    int level = (distanceSq >= params.mediumSq) + (distanceSq >= params.lowSq) + (distanceSq >= params.cullSq);
+
+    if (!inside) {
+        lod[i] = static_cast<uint8_t>(LODLevel::CULLED);
+        ++counts.frustumCulled;
+        return;
+    }
+    lod[i] = static_cast<uint8_t>(level);
+    if (level == static_cast<int>(LODLevel::CULLED)) {
+        ++counts.distanceCulled;
+    } else {
+        visible.push_back(static_cast<uint32_t>(i));
+    }
+}
+
+// Append the lanes set in @p mask, lowest first
+inline void appendLanes(unsigned int mask, size_t first, std::vector<uint32_t>& visible) {
+    for (unsigned int lane = 0; mask != 0; ++lane, mask >>= 1) {
+        if (mask & 1u) visible.push_back(static_cast<uint32_t>(first + lane));
+    }
+}
+
+#if defined(ATLAS_CULL_AVX)
+
+// Spheres [begin, end) with end - begin a multiple of 8
+void cullVector(const CullParams& params, const SphereArrays& spheres, size_t begin, size_t end,
+                uint8_t* lod, std::vector<uint32_t>& visible, RangeCounts& counts) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 culled = _mm256_set1_ps(static_cast<float>(LODLevel::CULLED));
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    const __m256 camX = _mm256_set1_ps(params.camera.x);
+    const __m256 camY = _mm256_set1_ps(params.camera.y);
+    const __m256 camZ = _mm256_set1_ps(params.camera.z);
+    const __m256 mediumSq = _mm256_set1_ps(params.mediumSq);
+    const __m256 lowSq = _mm256_set1_ps(params.lowSq);
+    const __m256 cullSq = _mm256_set1_ps(params.cullSq);
+    __m256 planes[6][4];
+    for (int p = 0; p < 6; ++p) {
+        for (int c = 0; c < 4; ++c) planes[p][c] = _mm256_set1_ps(params.planes[p][c]);
+    }
+
+    for (size_t i = begin; i < end; i += 8) {
+        __m256 x = _mm256_loadu_ps(spheres.x + i);
+        __m256 y = _mm256_loadu_ps(spheres.y + i);
+        __m256 z = _mm256_loadu_ps(spheres.z + i);
+        __m256 negRadius = _mm256_xor_ps(_mm256_loadu_ps(spheres.radius + i), signBit);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        if (params.testFrustum) {
+            for (const auto& plane : planes) {
+                __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+                    _mm256_mul_ps(plane[0], x), _mm256_mul_ps(plane[1], y)), _mm256_mul_ps(plane[2], z)), plane[3]);
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negRadius, _CMP_NLT_UQ));
+            }
+        }
+
+        __m256 dx = _mm256_sub_ps(x, camX);
+        __m256 dy = _mm256_sub_ps(y, camY);
+        __m256 dz = _mm256_sub_ps(z, camZ);
+        __m256 distanceSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                          _mm256_mul_ps(dz, dz));
+        __m256 beyondCull = _mm256_cmp_ps(distanceSq, cullSq, _CMP_GE_OQ);
+        __m256 level = _mm256_add_ps(_mm256_add_ps(
+            _mm256_and_ps(_mm256_cmp_ps(distanceSq, mediumSq, _CMP_GE_OQ), one),
+            _mm256_and_ps(_mm256_cmp_ps(distanceSq, lowSq, _CMP_GE_OQ), one)),
+            _mm256_and_ps(beyondCull, one));
+        level = _mm256_or_ps(_mm256_and_ps(inside, level), _mm256_andnot_ps(inside, culled));
+
+        // Eight levels to eight bytes
+        __m256i levels = _mm256_cvttps_epi32(level);
+        __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(levels), _mm256_extractf128_si256(levels, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(lod + i), _mm_packus_epi16(words, words));
+
+        unsigned int insideMask = static_cast<unsigned int>(_mm256_movemask_ps(inside));
+        unsigned int visibleMask = static_cast<unsigned int>(_mm256_movemask_ps(_mm256_andnot_ps(beyondCull, inside)));
+        counts.frustumCulled += 8 - std::bitset<8>(insideMask).count();
+        counts.distanceCulled += std::bitset<8>(insideMask & ~visibleMask).count();
+        appendLanes(visibleMask, i, visible);
+    }
+}
+
+#elif defined(ATLAS_CULL_SSE2)
+
+// Spheres [begin, end) with end - begin a multiple of 4
+void cullVector(const CullParams& params, const SphereArrays& spheres, size_t begin, size_t end,
+                uint8_t* lod, std::vector<uint32_t>& visible, RangeCounts& counts) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 culled = _mm_set1_ps(static_cast<float>(LODLevel::CULLED));
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128 camX = _mm_set1_ps(params.camera.x);
+    const __m128 camY = _mm_set1_ps(params.camera.y);
+    const __m128 camZ = _mm_set1_ps(params.camera.z);
+    const __m128 mediumSq = _mm_set1_ps(params.mediumSq);
+    const __m128 lowSq = _mm_set1_ps(params.lowSq);
+    const __m128 cullSq = _mm_set1_ps(params.cullSq);
+    __m128 planes[6][4];
+    for (int p = 0; p < 6; ++p) {
+        for (int c = 0; c < 4; ++c) planes[p][c] = _mm_set1_ps(params.planes[p][c]);
+    }
+
+    for (size_t i = begin; i < end; i += 4) {
+        __m128 x = _mm_loadu_ps(spheres.x + i);
+        __m128 y = _mm_loadu_ps(spheres.y + i);
+        __m128 z = _mm_loadu_ps(spheres.z + i);
+        __m128 negRadius = _mm_xor_ps(_mm_loadu_ps(spheres.radius + i), signBit);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        if (params.testFrustum) {
+            for (const auto& plane : planes) {
+                __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(plane[0], x), _mm_mul_ps(plane[1], y)), _mm_mul_ps(plane[2], z)), plane[3]);
+                inside = _mm_and_ps(inside, _mm_cmpnlt_ps(distance, negRadius));
+            }
+        }
+
+        __m128 dx = _mm_sub_ps(x, camX);
+        __m128 dy = _mm_sub_ps(y, camY);
+        __m128 dz = _mm_sub_ps(z, camZ);
+        __m128 distanceSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        __m128 beyondCull = _mm_cmpge_ps(distanceSq, cullSq);
+        __m128 level = _mm_add_ps(_mm_add_ps(
+            _mm_and_ps(_mm_cmpge_ps(distanceSq, mediumSq), one),
+            _mm_and_ps(_mm_cmpge_ps(distanceSq, lowSq), one)),
+            _mm_and_ps(beyondCull, one));
+        level = _mm_or_ps(_mm_and_ps(inside, level), _mm_andnot_ps(inside, culled));
+
+        // Four levels to four bytes
+        __m128i levels = _mm_cvttps_epi32(level);
+        __m128i words = _mm_packs_epi32(levels, levels);
+        int bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+        std::memcpy(lod + i, &bytes, 4);
+
+        unsigned int insideMask = static_cast<unsigned int>(_mm_movemask_ps(inside));
+        unsigned int visibleMask = static_cast<unsigned int>(_mm_movemask_ps(_mm_andnot_ps(beyondCull, inside)));
+        counts.frustumCulled += 4 - std::bitset<4>(insideMask).count();
+        counts.distanceCulled += std::bitset<4>(insideMask & ~visibleMask).count();
+        appendLanes(visibleMask, i, visible);
+    }
+}
+
+#endif
+
+void cullRange(const CullParams& params, const SphereArrays& spheres, size_t begin, size_t end,
+               uint8_t* lod, std::vector<uint32_t>& visible, RangeCounts& counts) {
+    size_t i = begin;
+#if defined(ATLAS_CULL_AVX) || defined(ATLAS_CULL_SSE2)
+    size_t vectorEnd = begin + (end - begin) / SIMD_WIDTH * SIMD_WIDTH;
+    cullVector(params, spheres, begin, vectorEnd, lod, visible, counts);
+    i = vectorEnd;
+#endif
+    for (; i < end; ++i) {
+        cullOne(params, spheres, i, lod, visible, counts);
+    }
+}
+
+} // namespace
+
+BatchCuller::BatchCuller(unsigned int threadCount)
+    : m_tasks(threadCount, MAX_THREADS)
+{
+    m_taskVisible.resize(m_tasks.getThreadCount());
+}
+
+unsigned int BatchCuller::getSimdWidth() {
+    return SIMD_WIDTH;
+}
+
+const char* BatchCuller::getSimdName() {
+#if defined(ATLAS_CULL_AVX)
+    return "AVX";
+#elif defined(ATLAS_CULL_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+void BatchCuller::cull(const SphereArrays& spheres, const Frustum* frustum, const glm::vec3& cameraPosition,
+                       const LODConfig& config, BatchCullResult& result) {
+    CullParams params;
+    params.testFrustum = frustum != nullptr;
+    if (frustum) {
+        const auto& planes = frustum->getPlanes();
+        for (size_t p = 0; p < planes.size(); ++p) {
+            params.planes[p][0] = planes[p].normal.x;
+            params.planes[p][1] = planes[p].normal.y;
+            params.planes[p][2] = planes[p].normal.z;
+            params.planes[p][3] = planes[p].distance;
+        }
+    }
+    params.camera = cameraPosition;
+    params.mediumSq = config.mediumDistance * config.mediumDistance;
+    params.lowSq = config.lowDistance * config.lowDistance;
+    params.cullSq = config.cullDistance * config.cullDistance;
+
+    result.visible.clear();
+    result.lod.resize(spheres.count);
+    result.frustumCulled = 0;
+    result.distanceCulled = 0;
+    if (spheres.count == 0) return;
+
+    // Contiguous ranges on SIMD boundaries keep the tails on the last range
+    size_t wanted = (spheres.count + m_splitSize - 1) / m_splitSize;
+    unsigned int taskCount = static_cast<unsigned int>(std::min<size_t>(m_tasks.getThreadCount(), wanted));
+    size_t rangeSize = (spheres.count + taskCount - 1) / taskCount;
+    rangeSize = (rangeSize + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+
+    if (taskCount <= 1) {
+        RangeCounts counts;
+        cullRange(params, spheres, 0, spheres.count, result.lod.data(), result.visible, counts);
+        result.frustumCulled = counts.frustumCulled;
+        result.distanceCulled = counts.distanceCulled;
+        return;
+    }
+
+    std::vector<RangeCounts> counts(taskCount);
+    uint8_t* lod = result.lod.data();
+    // The calling thread takes the first range
+    m_tasks.run(taskCount, [&](unsigned int index) {
+        size_t begin = std::min(spheres.count, index * rangeSize);
+        size_t end = std::min(spheres.count, begin + rangeSize);
+        m_taskVisible[index].clear();
+        cullRange(params, spheres, begin, end, lod, m_taskVisible[index], counts[index]);
+    });
+
+    size_t visibleCount = 0;
+    for (unsigned int t = 0; t < taskCount; ++t) visibleCount += m_taskVisible[t].size();
+    result.visible.reserve(visibleCount);
+    for (unsigned int t = 0; t < taskCount; ++t) {
+        result.visible.insert(result.visible.end(), m_taskVisible[t].begin(), m_taskVisible[t].end());
+        result.frustumCulled += counts[t].frustumCulled;
+        result.distanceCulled += counts[t].distanceCulled;
+    }
+}
+
+} // namespace atlas
@@ -0,0 +1,688 @@
+#include "rendering/binary_model.h"
+#include "rendering/mapped_file.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <system_error>
+#include <unordered_map>
+
+namespace atlas {
+
+namespace {
+
+constexpr char FILE_MAGIC[4] = { 'A', 'M', 'D', 'L' };
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304u;
+constexpr size_t DATA_ALIGNMENT = 16;
+constexpr size_t FORSYTH_CACHE_SIZE = 32;
+constexpr size_t FIFO_CACHE_SIZE = 16;
+
+struct StoredBounds {
+    float min[3];
+    float max[3];
+    float center[3];
+    float radius;
+};
+
+struct FileHeader {
+    char magic[4];
+    uint32_t formatVersion;
+    uint32_t byteOrder;
+    uint32_t vertexStride;
+    uint64_t fileBytes;
+    uint32_t meshCount;
+    uint32_t reserved;
+    StoredBounds bounds;
+};
+
+struct MeshRecord {
+    uint64_t vertexOffset;
+    uint64_t vertexCount;
+    uint64_t indexOffset;
+    uint64_t indexCount;
+    uint32_t indexBytes;
+    uint32_t lod;           // 0 is full detail
+    float lodError;
+    uint32_t reserved;
+    StoredBounds bounds;
+};
+
+size_t alignUp(size_t value) {
+    return (value + DATA_ALIGNMENT - 1) & ~(DATA_ALIGNMENT - 1);
+}
+
+StoredBounds storeBounds(const MeshBounds& bounds) {
+    StoredBounds stored = {};
+    for (int i = 0; i < 3; ++i) {
+        stored.min[i] = bounds.min[i];
+        stored.max[i] = bounds.max[i];
+        stored.center[i] = bounds.center[i];
+    }
+    stored.radius = bounds.radius;
+    return stored;
+}
+
+MeshBounds restoreBounds(const StoredBounds& stored, bool valid) {
+    MeshBounds bounds;
+    bounds.min = glm::vec3(stored.min[0], stored.min[1], stored.min[2]);
+    bounds.max = glm::vec3(stored.max[0], stored.max[1], stored.max[2]);
+    bounds.center = glm::vec3(stored.center[0], stored.center[1], stored.center[2]);
+    bounds.radius = stored.radius;
+    bounds.valid = valid;
+    return bounds;
+}
+
+glm::vec3 unpackPosition(const PackedVertex& vertex) {
+    return glm::vec3(halfToFloat(vertex.position[0]), halfToFloat(vertex.position[1]),
+                     halfToFloat(vertex.position[2]));
+}
+
+// Signed normalised 10-bit component
+uint32_t packSnorm10(float value) {
+    int quantised = static_cast<int>(std::lround(std::clamp(value, -1.0f, 1.0f) * 511.0f));
+    return static_cast<uint32_t>(quantised) & 0x3ffu;
+}
+
+float unpackSnorm10(uint32_t bits) {
+    int value = static_cast<int>(bits & 0x3ffu);
+    if (value >= 512) value -= 1024;
+    return std::max(static_cast<float>(value) / 511.0f, -1.0f);
+}
+
+uint8_t packUnorm8(float value) {
+    return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
+
+/**
+ * FIFO post-transform cache model: a vertex is cached while fewer than
+ * `size` misses happened since it was loaded
+ */
+class FifoCache {
+public:
+    FifoCache(size_t vertexCount, size_t size)
+        : m_stamps(vertexCount, 0), m_time(static_cast<uint32_t>(size) + 1), m_size(static_cast<uint32_t>(size)) {}
+
+    // 1 on a miss, 0 on a hit
+    unsigned int access(uint32_t vertex) {
+        if (m_time - m_stamps[vertex] <= m_size) return 0;
+        m_stamps[vertex] = m_time++;
+        return 1;
+    }
+
+    void reset() { m_time += m_size + 1; }
+
+private:
+    std::vector<uint32_t> m_stamps;
+    uint32_t m_time;
+    uint32_t m_size;
+};
+
+float forsythVertexScore(int cachePosition, uint32_t liveTriangles) {
+    if (liveTriangles == 0) return -1.0f;
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // Just used: prefer the triangle's neighbours, but not over the rest of the cache
+            score = 0.75f;
+        } else {
+            float fresh = 1.0f - static_cast<float>(cachePosition - 3) / static_cast<float>(FORSYTH_CACHE_SIZE - 3);
+            score = std::pow(fresh, 1.5f);
+        }
+    }
+    // Finish off vertices with few triangles left so they leave the cache for good
+    return score + 2.0f / std::sqrt(static_cast<float>(liveTriangles));
+}
+
+struct PackedVertexHash {
+    size_t operator()(const PackedVertex& vertex) const {
+        uint32_t words[sizeof(PackedVertex) / 4];
+        std::memcpy(words, &vertex, sizeof(words));
+        uint64_t hash = 1469598103934665603ull;
+        for (uint32_t word : words) {
+            hash ^= word;
+            hash *= 1099511628211ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+struct PackedVertexEqual {
+    bool operator()(const PackedVertex& a, const PackedVertex& b) const {
+        return std::memcmp(&a, &b, sizeof(PackedVertex)) == 0;
+    }
+};
+
+} // namespace
+
+// ── Quantisation ────────────────────────────────────────────────────
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t magnitude = bits & 0x7fffffffu;
+
+    if (magnitude >= 0x7f800000u) {
+        // Infinity stays infinity, NaN stays NaN
+        return static_cast<uint16_t>(sign | 0x7c00u | (magnitude > 0x7f800000u ? 0x200u : 0u));
+    }
+    if (magnitude >= 0x477ff000u) {
+        // Rounds above 65504
+        return static_cast<uint16_t>(sign | 0x7c00u);
+    }
+    if (magnitude < 0x38800000u) {
+        // Below the smallest normal half: subnormal or zero
+        if (magnitude < 0x33000000u) return static_cast<uint16_t>(sign);
+        uint32_t exponent = magnitude >> 23;
+        uint32_t mantissa = (magnitude & 0x7fffffu) | 0x800000u;
+        uint32_t shift = 126 - exponent;
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1u))) ++half;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    // Rebias the exponent; a rounding carry correctly bumps it
+    uint32_t half = (magnitude - 0x38000000u) >> 13;
+    uint32_t remainder = magnitude & 0x1fffu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) ++half;
+    return static_cast<uint16_t>(sign | half);
+}
+
+float halfToFloat(uint16_t half) {
+    uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+    uint32_t exponent = (half >> 10) & 0x1fu;
+    uint32_t mantissa = half & 0x3ffu;
+
+    uint32_t bits;
+    if (exponent == 0) {
+        float value = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -value : value;
+    } else if (exponent == 31) {
+        bits = sign | 0x7f800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+PackedVertex packVertex(const Vertex& vertex) {
+    PackedVertex packed = {};
+    for (int i = 0; i < 3; ++i) packed.position[i] = floatToHalf(vertex.position[i]);
+
+    float length = glm::length(vertex.normal);
+    glm::vec3 normal = length > 0.0f ? vertex.normal / length : vertex.normal;
+    packed.normal = packSnorm10(normal.x) | (packSnorm10(normal.y) << 10) | (packSnorm10(normal.z) << 20);
+
+    packed.texCoords[0] = floatToHalf(vertex.texCoords.x);
+    packed.texCoords[1] = floatToHalf(vertex.texCoords.y);
+
+    packed.color[0] = packUnorm8(vertex.color.r);
+    packed.color[1] = packUnorm8(vertex.color.g);
+    packed.color[2] = packUnorm8(vertex.color.b);
+    packed.color[3] = 255;
+    return packed;
+}
+
+Vertex unpackVertex(const PackedVertex& packed) {
+    Vertex vertex;
+    vertex.position = unpackPosition(packed);
+    vertex.normal = glm::vec3(unpackSnorm10(packed.normal), unpackSnorm10(packed.normal >> 10),
+                              unpackSnorm10(packed.normal >> 20));
+    vertex.texCoords = glm::vec2(halfToFloat(packed.texCoords[0]), halfToFloat(packed.texCoords[1]));
+    vertex.color = glm::vec3(packed.color[0], packed.color[1], packed.color[2]) / 255.0f;
+    return vertex;
+}
+
+MeshGeometryView unpackGeometry(const PackedMeshView& packed, std::vector<Vertex>& vertices,
+                                std::vector<unsigned int>& indices) {
+    vertices.resize(packed.vertexCount);
+    for (size_t i = 0; i < packed.vertexCount; ++i) vertices[i] = unpackVertex(packed.vertices[i]);
+
+    indices.resize(packed.indexCount);
+    if (packed.shortIndices) {
+        const uint16_t* source = static_cast<const uint16_t*>(packed.indices);
+        std::copy(source, source + packed.indexCount, indices.begin());
+    } else {
+        const uint32_t* source = static_cast<const uint32_t*>(packed.indices);
+        std::copy(source, source + packed.indexCount, indices.begin());
+    }
+
+    MeshGeometryView view;
+    view.vertices = vertices.data();
+    view.vertexCount = vertices.size();
+    view.indices = indices.data();
+    view.indexCount = indices.size();
+    return view;
+}
+
+// ── Optimisation ────────────────────────────────────────────────────
+
+void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0) return;
+
+    // Live triangles of each vertex, packed per vertex; emitted ones are
+    // swapped past the live count
+    std::vector<uint32_t> liveTriangles(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i) ++liveTriangles[indices[i]];
+    std::vector<uint32_t> adjacencyStart(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) adjacencyStart[v + 1] = adjacencyStart[v] + liveTriangles[v];
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    {
+        std::vector<uint32_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+        for (size_t i = 0; i < triangleCount * 3; ++i) {
+            adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) vertexScores[v] = forsythVertexScore(-1, liveTriangles[v]);
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> touched;
+    std::vector<uint32_t> output;
+    output.reserve(triangleCount * 3);
+    size_t scanCursor = 0;
+    int64_t best = -1;
+
+    while (output.size() < triangleCount * 3) {
+        if (best < 0) {
+            // Nothing next to the cache: continue with the next unused triangle
+            while (emitted[scanCursor]) ++scanCursor;
+            best = static_cast<int64_t>(scanCursor);
+        }
+        uint32_t triangle = static_cast<uint32_t>(best);
+        const uint32_t* corners = &indices[triangle * 3];
+        emitted[triangle] = true;
+        output.insert(output.end(), corners, corners + 3);
+
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = corners[k];
+            auto begin = adjacency.begin() + adjacencyStart[v];
+            auto end = begin + liveTriangles[v];
+            auto it = std::find(begin, end, triangle);
+            if (it != end) {
+                std::iter_swap(it, end - 1);
+                --liveTriangles[v];
+            }
+        }
+
+        // Triangle's vertices move to the front; the rest shift back, and
+        // whatever falls off the end leaves the cache
+        touched.clear();
+        for (int k = 0; k < 3; ++k) {
+            if (std::find(touched.begin(), touched.end(), corners[k]) == touched.end()) touched.push_back(corners[k]);
+        }
+        for (uint32_t v : cache) {
+            if (v != corners[0] && v != corners[1] && v != corners[2]) touched.push_back(v);
+        }
+        cache.assign(touched.begin(), touched.begin() + std::min(touched.size(), FORSYTH_CACHE_SIZE));
+        for (size_t i = 0; i < touched.size(); ++i) {
+            uint32_t v = touched[i];
+            cachePosition[v] = i < FORSYTH_CACHE_SIZE ? static_cast<int>(i) : -1;
+            vertexScores[v] = forsythVertexScore(cachePosition[v], liveTriangles[v]);
+        }
+
+        // Rescore triangles around the touched vertices; the best of those
+        // in the cache goes next
+        best = -1;
+        float bestScore = -std::numeric_limits<float>::max();
+        for (uint32_t v : touched) {
+            for (uint32_t i = adjacencyStart[v]; i < adjacencyStart[v] + liveTriangles[v]; ++i) {
+                uint32_t t = adjacency[i];
+                float score = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] +
+                              vertexScores[indices[t * 3 + 2]];
+                if (cachePosition[v] >= 0 && score > bestScore) {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+    }
+
+    indices.swap(output);
+}
+
+void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<PackedVertex>& vertices, float threshold) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2 || vertices.empty()) return;
+
+    // Hard boundaries: triangles where the cache restarts (all three miss)
+    std::vector<size_t> hardBoundaries;
+    std::vector<unsigned int> misses(triangleCount);
+    {
+        FifoCache cache(vertices.size(), FIFO_CACHE_SIZE);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            misses[t] = cache.access(indices[t * 3]) + cache.access(indices[t * 3 + 1]) +
+                        cache.access(indices[t * 3 + 2]);
+            if (t == 0 || misses[t] == 3) hardBoundaries.push_back(t);
+        }
+    }
+    hardBoundaries.push_back(triangleCount);
+
+    // Soft boundaries: split each hard cluster wherever the miss ratio so
+    // far is already within threshold of the cluster's
+    std::vector<size_t> boundaries;
+    FifoCache cache(vertices.size(), FIFO_CACHE_SIZE);
+    for (size_t c = 0; c + 1 < hardBoundaries.size(); ++c) {
+        size_t start = hardBoundaries[c];
+        size_t end = hardBoundaries[c + 1];
+        unsigned int clusterMisses = 0;
+        for (size_t t = start; t < end; ++t) clusterMisses += misses[t];
+        float target = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+        boundaries.push_back(start);
+        size_t firstOfCluster = boundaries.size() - 1;
+        cache.reset();
+        unsigned int runningMisses = 0;
+        size_t runningTriangles = 0;
+        for (size_t t = start; t < end; ++t) {
+            runningMisses += cache.access(indices[t * 3]) + cache.access(indices[t * 3 + 1]) +
+                             cache.access(indices[t * 3 + 2]);
+            ++runningTriangles;
+            if (static_cast<float>(runningMisses) <= target * static_cast<float>(runningTriangles)) {
+                boundaries.push_back(t + 1);
+                cache.reset();
+                runningMisses = 0;
+                runningTriangles = 0;
+            }
+        }
+        if (boundaries.back() == end) boundaries.pop_back();
+        // A tail that never reached the target joins the cluster before it
+        if (runningTriangles > 0 && boundaries.size() - 1 > firstOfCluster) boundaries.pop_back();
+    }
+    boundaries.push_back(triangleCount);
+
+    // Sort key: how far a cluster sits out along its own facing direction
+    struct Cluster {
+        size_t start;
+        size_t end;
+        float key;
+    };
+    std::vector<Cluster> clusters;
+    std::vector<glm::vec3> centroids;
+    std::vector<glm::vec3> normals;
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    for (size_t c = 0; c + 1 < boundaries.size(); ++c) {
+        glm::vec3 centroid(0.0f);
+        glm::vec3 normal(0.0f);
+        float area = 0.0f;
+        for (size_t t = boundaries[c]; t < boundaries[c + 1]; ++t) {
+            glm::vec3 a = unpackPosition(vertices[indices[t * 3]]);
+            glm::vec3 b = unpackPosition(vertices[indices[t * 3 + 1]]);
+            glm::vec3 d = unpackPosition(vertices[indices[t * 3 + 2]]);
+            glm::vec3 cross = glm::cross(b - a, d - a);
+            float triangleArea = glm::length(cross);
+            centroid += (a + b + d) * (triangleArea / 3.0f);
+            normal += cross;
+            area += triangleArea;
+        }
+        meshCentroid += centroid;
+        meshArea += area;
+        centroids.push_back(area > 0.0f ? centroid / area : centroid);
+        normals.push_back(glm::length(normal) > 0.0f ? glm::normalize(normal) : normal);
+        clusters.push_back({ boundaries[c], boundaries[c + 1], 0.0f });
+    }
+    if (meshArea > 0.0f) meshCentroid /= meshArea;
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        clusters[c].key = glm::dot(centroids[c] - meshCentroid, normals[c]);
+    }
+
+    // Outward-facing clusters first: they tend to hide the rest
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const Cluster& a, const Cluster& b) { return a.key > b.key; });
+
+    std::vector<uint32_t> output;
+    output.reserve(triangleCount * 3);
+    for (const auto& cluster : clusters) {
+        output.insert(output.end(), indices.begin() + cluster.start * 3, indices.begin() + cluster.end * 3);
+    }
+    indices.swap(output);
+}
+
+void optimizeVertexFetch(std::vector<PackedVertex>& vertices, std::vector<uint32_t>& indices) {
+    const uint32_t unused = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> remap(vertices.size(), unused);
+    std::vector<PackedVertex> ordered;
+    ordered.reserve(vertices.size());
+    for (uint32_t& index : indices) {
+        if (remap[index] == unused) {
+            remap[index] = static_cast<uint32_t>(ordered.size());
+            ordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices.swap(ordered);
+}
+
+float computeACMR(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return 0.0f;
+    FifoCache cache(vertexCount, cacheSize);
+    size_t misses = 0;
+    for (size_t i = 0; i < triangleCount * 3; ++i) misses += cache.access(indices[i]);
+    return static_cast<float>(misses) / static_cast<float>(triangleCount);
+}
+
+ConvertedMesh convertMesh(const MeshGeometryView& source, MeshConvertStats* stats) {
+    ConvertedMesh mesh;
+
+    // Weld vertices that quantise to the same bytes
+    std::unordered_map<PackedVertex, uint32_t, PackedVertexHash, PackedVertexEqual> welded;
+    welded.reserve(source.vertexCount);
+    std::vector<uint32_t> remap(source.vertexCount);
+    for (size_t i = 0; i < source.vertexCount; ++i) {
+        PackedVertex packed = packVertex(source.vertices[i]);
+        auto inserted = welded.emplace(packed, static_cast<uint32_t>(mesh.vertices.size()));
+        if (inserted.second) mesh.vertices.push_back(packed);
+        remap[i] = inserted.first->second;
+    }
+
+    // Drop triangles that collapsed (or never were valid)
+    size_t degenerate = 0;
+    mesh.indices.reserve(source.indexCount);
+    for (size_t i = 0; i + 2 < source.indexCount; i += 3) {
+        unsigned int a = source.indices[i];
+        unsigned int b = source.indices[i + 1];
+        unsigned int c = source.indices[i + 2];
+        if (a >= source.vertexCount || b >= source.vertexCount || c >= source.vertexCount ||
+            remap[a] == remap[b] || remap[b] == remap[c] || remap[a] == remap[c]) {
+            ++degenerate;
+            continue;
+        }
+        mesh.indices.push_back(remap[a]);
+        mesh.indices.push_back(remap[b]);
+        mesh.indices.push_back(remap[c]);
+    }
+
+    float acmrBefore = computeACMR(mesh.indices, mesh.vertices.size());
+    optimizeVertexCache(mesh.indices, mesh.vertices.size());
+    optimizeOverdraw(mesh.indices, mesh.vertices);
+    optimizeVertexFetch(mesh.vertices, mesh.indices);
+
+    // Bounds of what will be drawn, i.e. the quantised positions
+    std::vector<glm::vec3> positions;
+    positions.reserve(mesh.vertices.size());
+    for (const auto& vertex : mesh.vertices) positions.push_back(unpackPosition(vertex));
+    mesh.bounds = computeMeshBounds(positions.data(), positions.size());
+
+    if (stats) {
+        stats->sourceVertices = source.vertexCount;
+        stats->vertices = mesh.vertices.size();
+        stats->triangles = mesh.indices.size() / 3;
+        stats->degenerateTriangles = degenerate;
+        stats->acmrBefore = acmrBefore;
+        stats->acmrAfter = computeACMR(mesh.indices, mesh.vertices.size());
+    }
+    return mesh;
+}
+
+// ── Files ───────────────────────────────────────────────────────────
+
+bool writeBinaryModel(const std::string& path, const std::vector<ConvertedMesh>& meshes) {
+    std::vector<MeshRecord> table(meshes.size());
+    MeshBounds modelBounds;
+    size_t offset = alignUp(sizeof(FileHeader) + meshes.size() * sizeof(MeshRecord));
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        const ConvertedMesh& mesh = meshes[i];
+        MeshRecord& record = table[i];
+        record = {};
+        record.indexBytes = mesh.vertices.size() <= 0x10000u ? 2 : 4;
+        record.vertexOffset = offset;
+        record.vertexCount = mesh.vertices.size();
+        offset = alignUp(offset + mesh.vertices.size() * sizeof(PackedVertex));
+        record.indexOffset = offset;
+        record.indexCount = mesh.indices.size();
+        offset = alignUp(offset + mesh.indices.size() * record.indexBytes);
+        record.lod = mesh.lod;
+        record.lodError = mesh.lodError;
+        record.bounds = storeBounds(mesh.bounds);
+        if (mesh.lod == 0) modelBounds = mergeMeshBounds(modelBounds, mesh.bounds);
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.formatVersion = BINARY_MODEL_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.vertexStride = sizeof(PackedVertex);
+    header.fileBytes = offset;
+    header.meshCount = static_cast<uint32_t>(meshes.size());
+    header.bounds = storeBounds(modelBounds);
+
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "[BinaryModel] Cannot open " << tempPath << std::endl;
+            return false;
+        }
+
+        static const char padding[DATA_ALIGNMENT] = {};
+        auto padTo = [&out](size_t target) {
+            size_t position = static_cast<size_t>(out.tellp());
+            if (target > position) out.write(padding, static_cast<std::streamsize>(target - position));
+        };
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(table.data()),
+                  static_cast<std::streamsize>(table.size() * sizeof(MeshRecord)));
+        std::vector<uint16_t> shortIndices;
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            const ConvertedMesh& mesh = meshes[i];
+            padTo(static_cast<size_t>(table[i].vertexOffset));
+            out.write(reinterpret_cast<const char*>(mesh.vertices.data()),
+                      static_cast<std::streamsize>(mesh.vertices.size() * sizeof(PackedVertex)));
+            padTo(static_cast<size_t>(table[i].indexOffset));
+            if (table[i].indexBytes == 2) {
+                shortIndices.assign(mesh.indices.begin(), mesh.indices.end());
+                out.write(reinterpret_cast<const char*>(shortIndices.data()),
+                          static_cast<std::streamsize>(shortIndices.size() * sizeof(uint16_t)));
+            } else {
+                out.write(reinterpret_cast<const char*>(mesh.indices.data()),
+                          static_cast<std::streamsize>(mesh.indices.size() * sizeof(uint32_t)));
+            }
+        }
+        padTo(offset);
+        if (!out) {
+            std::cerr << "[BinaryModel] Write error on " << tempPath << std::endl;
+            std::error_code ignored;
+            std::filesystem::remove(tempPath, ignored);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::cerr << "[BinaryModel] Cannot replace " << path << ": " << ec.message() << std::endl;
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<const BinaryModel> loadBinaryModel(const std::string& path) {
+    size_t fileBytes = 0;
+    std::shared_ptr<const void> mapping = mapFileReadOnly(path, fileBytes);
+    if (!mapping || fileBytes < sizeof(FileHeader)) return nullptr;
+
+    const auto* base = static_cast<const unsigned char*>(mapping.get());
+    FileHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+        header.formatVersion != BINARY_MODEL_VERSION ||
+        header.byteOrder != BYTE_ORDER_MARK ||
+        header.vertexStride != sizeof(PackedVertex) ||
+        header.fileBytes != fileBytes ||
+        header.meshCount > (fileBytes - sizeof(FileHeader)) / sizeof(MeshRecord)) {
+        return nullptr;
+    }
+
+    auto model = std::make_shared<BinaryModel>();
+    model->meshes.reserve(header.meshCount);
+    model->meshBounds.reserve(header.meshCount);
+    for (uint32_t i = 0; i < header.meshCount; ++i) {
+        MeshRecord record;
+        std::memcpy(&record, base + sizeof(FileHeader) + i * sizeof(MeshRecord), sizeof(record));
+        bool valid =
+            (record.indexBytes == 2 || record.indexBytes == 4) &&
+            record.vertexOffset % DATA_ALIGNMENT == 0 && record.indexOffset % DATA_ALIGNMENT == 0 &&
+            record.vertexOffset <= fileBytes &&
+            record.vertexCount <= (fileBytes - record.vertexOffset) / sizeof(PackedVertex) &&
+            record.indexOffset <= fileBytes &&
+            record.indexCount <= (fileBytes - record.indexOffset) / record.indexBytes &&
+            (record.indexBytes == 4 || record.vertexCount <= 0x10000u) &&
+            record.lod <= model->lods.size() + 1 && (record.lod > 0 || model->lods.empty());
+        if (!valid) return nullptr;
+
+        PackedMeshView view;
+        view.vertices = reinterpret_cast<const PackedVertex*>(base + record.vertexOffset);
+        view.vertexCount = static_cast<size_t>(record.vertexCount);
+        view.indices = base + record.indexOffset;
+        view.indexCount = static_cast<size_t>(record.indexCount);
+        view.shortIndices = record.indexBytes == 2;
+        if (record.lod == 0) {
+            model->meshes.push_back(view);
+            model->meshBounds.push_back(restoreBounds(record.bounds, record.vertexCount > 0));
+        } else {
+            if (record.lod > model->lods.size()) model->lods.emplace_back();
+            model->lods.back().meshes.push_back(view);
+            model->lods.back().error = record.lodError;
+        }
+    }
+    bool anyGeometry = std::any_of(model->meshBounds.begin(), model->meshBounds.end(),
+                                   [](const MeshBounds& bounds) { return bounds.valid; });
+    model->bounds = restoreBounds(header.bounds, anyGeometry);
+    model->mappedBytes = fileBytes;
+    model->mapping = std::move(mapping);
+    return model;
+}
+
+std::string binaryModelPathFor(const std::string& sourcePath) {
+    return std::filesystem::path(sourcePath).replace_extension(BINARY_MODEL_EXTENSION).string();
+}
+
+std::string findCurrentBinaryModel(const std::string& sourcePath) {
+    std::string binaryPath = binaryModelPathFor(sourcePath);
+    if (binaryPath == sourcePath) return sourcePath;
+
+    std::error_code ec;
+    auto binaryTime = std::filesystem::last_write_time(binaryPath, ec);
+    if (ec) return "";
+    auto sourceTime = std::filesystem::last_write_time(sourcePath, ec);
+    // Shipping only the binary is fine; an edited source wins over its binary
+    if (ec || binaryTime >= sourceTime) return binaryPath;
+    return "";
+}
+
+} // namespace atlas
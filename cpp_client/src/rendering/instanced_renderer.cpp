@@ -2,10 +2,18 @@
 #include "rendering/mesh.h"
 #include "rendering/shader.h"
 #include <GL/glew.h>
+#include <algorithm>
 #include <iostream>
 
 namespace atlas {
 
+namespace {
+
+// Smallest streaming batch; most draw lists repeat a mesh a few dozen times
+constexpr unsigned int MIN_STREAM_INSTANCES = 64;
+
+} // namespace
+
 // ============================================================================
 // InstanceBatch Implementation
 // ============================================================================
@@ -110,6 +118,19 @@ void InstanceBatch::clear() {
     m_bufferDirty = true;
 }
 
+void InstanceBatch::assign(const InstanceData* instances, unsigned int count) {
+    if (count > m_maxInstances) {
+        // Respecifying the store keeps the VAO's attribute bindings
+        while (m_maxInstances < count) m_maxInstances = std::max(m_maxInstances * 2, 1u);
+        glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+        glBufferData(GL_ARRAY_BUFFER, m_maxInstances * sizeof(InstanceData), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        m_instances.reserve(m_maxInstances);
+    }
+    m_instances.assign(instances, instances + count);
+    m_bufferDirty = true;
+}
+
 void InstanceBatch::updateGPUBuffer() {
     if (!m_bufferDirty || m_instances.empty()) {
         return;
@@ -264,6 +285,29 @@ void InstancedRenderer::renderMesh(const std::string& meshId, Shader* shader) {
     }
 }
 
+void InstancedRenderer::drawInstances(const std::shared_ptr<Mesh>& mesh, const InstanceData* instances,
+                                      unsigned int count, Shader* shader) {
+    if (!shader || !mesh || count == 0) return;
+
+    Stream& stream = m_streams[mesh.get()];
+    if (!stream.batch) stream.batch = std::make_unique<InstanceBatch>(mesh, std::max(count, MIN_STREAM_INSTANCES));
+    stream.used = true;
+    stream.batch->assign(instances, count);
+    stream.batch->render(shader);
+    m_stats.drawCalls++;
+}
+
+void InstancedRenderer::trimStreams() {
+    for (auto it = m_streams.begin(); it != m_streams.end();) {
+        if (!it->second.used) {
+            it = m_streams.erase(it);
+        } else {
+            it->second.used = false;
+            ++it;
+        }
+    }
+}
+
 void InstancedRenderer::clearInstances() {
     for (auto& pair : m_batches) {
         pair.second->clear();
@@ -274,6 +318,7 @@ void InstancedRenderer::clearInstances() {
 
 void InstancedRenderer::clearAll() {
     m_batches.clear();
+    m_streams.clear();
     m_instanceLocations.clear();
     m_stats.reset();
 }
@@ -1,4 +1,5 @@
 #include "rendering/lod_manager.h"
+#include "rendering/batch_culler.h"
 #include "rendering/frustum_culler.h"
 #include <iostream>
 #include <algorithm>
@@ -7,6 +8,8 @@ namespace atlas {
 
 LODManager::LODManager() 
     : m_frustumCuller(std::make_unique<FrustumCuller>())
+    , m_batchCuller(std::make_unique<BatchCuller>())
+    , m_cullResult(std::make_unique<BatchCullResult>())
 {
 }
 
@@ -14,99 +17,143 @@ LODManager::~LODManager() {
 }
 
 void LODManager::registerEntity(unsigned int id, const glm::vec3& position, float boundingRadius) {
-    LODEntity entity;
-    entity.id = id;
-    entity.position = position;
-    entity.boundingRadius = boundingRadius;
-    entity.currentLOD = LODLevel::HIGH;
-    entity.lastUpdateTime = 0.0f;
-    entity.isVisible = true;
+    auto it = m_slots.find(id);
+    size_t slot;
+    if (it != m_slots.end()) {
+        slot = it->second;
+    } else {
+        slot = m_ids.size();
+        m_slots[id] = slot;
+        m_ids.push_back(id);
+        m_x.push_back(0.0f);
+        m_y.push_back(0.0f);
+        m_z.push_back(0.0f);
+        m_radius.push_back(0.0f);
+        m_lod.push_back(0);
+        m_lastUpdateTime.push_back(0.0f);
+    }
     
-    m_entities[id] = entity;
+    m_x[slot] = position.x;
+    m_y[slot] = position.y;
+    m_z[slot] = position.z;
+    m_radius[slot] = boundingRadius;
+    m_lod[slot] = static_cast<uint8_t>(LODLevel::HIGH);
+    m_lastUpdateTime[slot] = 0.0f;
+    m_cullCurrent = false;
 }
 
 void LODManager::unregisterEntity(unsigned int id) {
-    m_entities.erase(id);
+    auto it = m_slots.find(id);
+    if (it == m_slots.end()) return;
+    
+    // Move the last entity into the freed slot
+    size_t slot = it->second;
+    size_t last = m_ids.size() - 1;
+    m_slots.erase(it);
+    if (slot != last) {
+        m_ids[slot] = m_ids[last];
+        m_x[slot] = m_x[last];
+        m_y[slot] = m_y[last];
+        m_z[slot] = m_z[last];
+        m_radius[slot] = m_radius[last];
+        m_lod[slot] = m_lod[last];
+        m_lastUpdateTime[slot] = m_lastUpdateTime[last];
+        m_slots[m_ids[slot]] = slot;
+    }
+    m_ids.pop_back();
+    m_x.pop_back();
+    m_y.pop_back();
+    m_z.pop_back();
+    m_radius.pop_back();
+    m_lod.pop_back();
+    m_lastUpdateTime.pop_back();
+    m_cullCurrent = false;
 }
 
 void LODManager::updateEntityPosition(unsigned int id, const glm::vec3& position) {
-    auto it = m_entities.find(id);
-    if (it != m_entities.end()) {
-        it->second.position = position;
+    auto it = m_slots.find(id);
+    if (it != m_slots.end()) {
+        m_x[it->second] = position.x;
+        m_y[it->second] = position.y;
+        m_z[it->second] = position.z;
     }
 }
 
-void LODManager::update(const glm::vec3& cameraPosition, float deltaTime, const glm::mat4* viewProjection) {
+void LODManager::update(const glm::vec3& cameraPosition, float /*deltaTime*/, const glm::mat4* viewProjection) {
     // Update frustum culler if view-projection matrix provided
     if (viewProjection && m_frustumCuller) {
         m_frustumCuller->update(*viewProjection);
     }
+    bool testFrustum = viewProjection && m_frustumCuller && m_frustumCuller->isEnabled();
     
-    for (auto& pair : m_entities) {
-        LODEntity& entity = pair.second;
-        
-        // Calculate distance from camera
-        float distance = glm::length(entity.position - cameraPosition);
-        
-        // Determine LOD level based on distance
-        LODLevel newLOD = calculateLOD(distance);
-        
-        // Apply frustum culling if enabled
-        bool visibleInFrustum = true;
-        if (viewProjection && m_frustumCuller && m_frustumCuller->isEnabled()) {
-            visibleInFrustum = m_frustumCuller->isVisible(entity.position, entity.boundingRadius);
-            
-            // If not in frustum, force to CULLED
-            if (!visibleInFrustum) {
-                newLOD = LODLevel::CULLED;
-            }
-        }
-        
-        // Update LOD if changed
-        if (newLOD != entity.currentLOD) {
-            entity.currentLOD = newLOD;
-        }
-        
-        // Update visibility
-        entity.isVisible = (newLOD != LODLevel::CULLED);
+    // Distance bands and frustum test for every entity in one pass
+    SphereArrays spheres;
+    spheres.x = m_x.data();
+    spheres.y = m_y.data();
+    spheres.z = m_z.data();
+    spheres.radius = m_radius.data();
+    spheres.count = m_ids.size();
+    m_batchCuller->cull(spheres, testFrustum ? &m_frustumCuller->getFrustum() : nullptr,
+                        cameraPosition, m_config, *m_cullResult);
+    m_lod.swap(m_cullResult->lod);
+    m_cullCurrent = true;
+    
+    if (testFrustum) {
+        auto& stats = m_frustumCuller->getStats();
+        size_t culled = m_cullResult->frustumCulled;
+        stats.totalTests += static_cast<unsigned int>(spheres.count);
+        stats.visibleEntities += static_cast<unsigned int>(spheres.count - culled);
+        stats.culledEntities += static_cast<unsigned int>(culled);
     }
 }
 
 LODLevel LODManager::getEntityLOD(unsigned int id) const {
-    auto it = m_entities.find(id);
-    if (it != m_entities.end()) {
-        return it->second.currentLOD;
+    auto it = m_slots.find(id);
+    if (it != m_slots.end()) {
+        return static_cast<LODLevel>(m_lod[it->second]);
     }
     return LODLevel::CULLED;
 }
 
 bool LODManager::shouldUpdateEntity(unsigned int id, float currentTime) const {
-    auto it = m_entities.find(id);
-    if (it == m_entities.end() || !it->second.isVisible) {
+    auto it = m_slots.find(id);
+    if (it == m_slots.end()) {
         return false;
     }
     
-    const LODEntity& entity = it->second;
-    float updateInterval = getUpdateInterval(entity.currentLOD);
+    LODLevel lod = static_cast<LODLevel>(m_lod[it->second]);
+    if (lod == LODLevel::CULLED) {
+        return false;
+    }
+    float updateInterval = getUpdateInterval(lod);
     
-    return (currentTime - entity.lastUpdateTime) >= (1.0f / updateInterval);
+    return (currentTime - m_lastUpdateTime[it->second]) >= (1.0f / updateInterval);
 }
 
 bool LODManager::isEntityVisible(unsigned int id) const {
-    auto it = m_entities.find(id);
-    if (it != m_entities.end()) {
-        return it->second.isVisible;
+    auto it = m_slots.find(id);
+    if (it != m_slots.end()) {
+        return m_lod[it->second] != static_cast<uint8_t>(LODLevel::CULLED);
     }
     return false;
 }
 
 std::vector<unsigned int> LODManager::getVisibleEntities() const {
     std::vector<unsigned int> visible;
-    visible.reserve(m_entities.size());
     
-    for (const auto& pair : m_entities) {
-        if (pair.second.isVisible) {
-            visible.push_back(pair.first);
+    // The last pass listed them, unless entities came or went since
+    if (m_cullCurrent) {
+        visible.reserve(m_cullResult->visible.size());
+        for (uint32_t slot : m_cullResult->visible) {
+            visible.push_back(m_ids[slot]);
+        }
+        return visible;
+    }
+    
+    visible.reserve(m_ids.size());
+    for (size_t slot = 0; slot < m_ids.size(); ++slot) {
+        if (m_lod[slot] != static_cast<uint8_t>(LODLevel::CULLED)) {
+            visible.push_back(m_ids[slot]);
         }
     }
     
@@ -116,9 +163,9 @@ std::vector<unsigned int> LODManager::getVisibleEntities() const {
 std::vector<unsigned int> LODManager::getEntitiesByLOD(LODLevel lod) const {
     std::vector<unsigned int> entities;
     
-    for (const auto& pair : m_entities) {
-        if (pair.second.currentLOD == lod) {
-            entities.push_back(pair.first);
+    for (size_t slot = 0; slot < m_ids.size(); ++slot) {
+        if (m_lod[slot] == static_cast<uint8_t>(lod)) {
+            entities.push_back(m_ids[slot]);
         }
     }
     
@@ -127,13 +174,11 @@ std::vector<unsigned int> LODManager::getEntitiesByLOD(LODLevel lod) const {
 
 LODManager::Stats LODManager::getStats() const {
     Stats stats = {};
-    stats.totalEntities = static_cast<unsigned int>(m_entities.size());
+    stats.totalEntities = static_cast<unsigned int>(m_ids.size());
     stats.frustumCulled = 0;
     
-    for (const auto& pair : m_entities) {
-        const LODEntity& entity = pair.second;
-        
-        switch (entity.currentLOD) {
+    for (uint8_t lod : m_lod) {
+        switch (static_cast<LODLevel>(lod)) {
             case LODLevel::HIGH:
                 stats.highLOD++;
                 break;
@@ -147,11 +192,8 @@ LODManager::Stats LODManager::getStats() const {
                 stats.culled++;
                 break;
         }
-        
-        if (entity.isVisible) {
-            stats.visible++;
-        }
     }
+    stats.visible = stats.totalEntities - stats.culled;
     
     // Get frustum culler stats if available
     if (m_frustumCuller && m_frustumCuller->isEnabled()) {
@@ -162,21 +204,15 @@ LODManager::Stats LODManager::getStats() const {
 }
 
 void LODManager::clear() {
-    m_entities.clear();
-}
-
-LODLevel LODManager::calculateLOD(float distance) const {
-    if (distance >= m_config.cullDistance) {
-        return LODLevel::CULLED;
-    } else if (distance >= m_config.lowDistance) {
-        return LODLevel::LOW;
-    } else if (distance >= m_config.mediumDistance) {
-        return LODLevel::MEDIUM;
-    } else if (distance >= m_config.highDistance) {
-        return LODLevel::HIGH;
-    } else {
-        return LODLevel::HIGH;
-    }
+    m_slots.clear();
+    m_ids.clear();
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_radius.clear();
+    m_lod.clear();
+    m_lastUpdateTime.clear();
+    m_cullCurrent = false;
 }
 
 float LODManager::getUpdateInterval(LODLevel lod) const {
@@ -207,4 +243,8 @@ const FrustumCuller* LODManager::getFrustumCuller() const {
     return m_frustumCuller.get();
 }
 
+unsigned int LODManager::getCullThreadCount() const {
+    return m_batchCuller->getThreadCount();
+}
+
 } // namespace atlas
@@ -10,7 +10,29 @@ Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>&
     , m_VBO(0)
     , m_EBO(0)
 {
-    setup();
+    m_geometry.vertices = m_vertices.data();
+    m_geometry.vertexCount = m_vertices.size();
+    m_geometry.indices = m_indices.data();
+    m_geometry.indexCount = m_indices.size();
+}
+
+Mesh::Mesh(std::shared_ptr<const void> storage, const MeshGeometryView& geometry)
+    : m_storage(std::move(storage))
+    , m_geometry(geometry)
+    , m_VAO(0)
+    , m_VBO(0)
+    , m_EBO(0)
+{
+}
+
+Mesh::Mesh(std::shared_ptr<const void> storage, const PackedMeshView& packed)
+    : m_storage(std::move(storage))
+    , m_packedGeometry(packed)
+    , m_packed(true)
+    , m_VAO(0)
+    , m_VBO(0)
+    , m_EBO(0)
+{
 }
 
 Mesh::~Mesh() {
@@ -19,30 +41,67 @@ Mesh::~Mesh() {
     if (m_EBO != 0) glDeleteBuffers(1, &m_EBO);
 }
 
+size_t Mesh::getMemoryBytes() const {
+    if (m_packed) {
+        size_t indexBytes = m_packedGeometry.shortIndices ? sizeof(uint16_t) : sizeof(uint32_t);
+        return m_packedGeometry.vertexCount * sizeof(PackedVertex) + m_packedGeometry.indexCount * indexBytes;
+    }
+    return m_geometry.vertexCount * sizeof(Vertex) + m_geometry.indexCount * sizeof(unsigned int);
+}
+
 void Mesh::draw() const {
+    upload();
+    GLenum indexType = m_packed && m_packedGeometry.shortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
     glBindVertexArray(m_VAO);
-    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(m_indices.size()), GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(getIndexCount()), indexType, 0);
     glBindVertexArray(0);
 }
 
 void Mesh::drawInstanced(unsigned int instanceCount) const {
+    upload();
+    GLenum indexType = m_packed && m_packedGeometry.shortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
     glBindVertexArray(m_VAO);
-    glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(m_indices.size()), GL_UNSIGNED_INT, 0, instanceCount);
+    glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(getIndexCount()), indexType, 0, instanceCount);
     glBindVertexArray(0);
 }
 
-void Mesh::setup() {
+void Mesh::upload() const {
+    if (m_VAO != 0) return;
+
     glGenVertexArrays(1, &m_VAO);
     glGenBuffers(1, &m_VBO);
     glGenBuffers(1, &m_EBO);
     
     glBindVertexArray(m_VAO);
+
+    if (m_packed) {
+        const PackedMeshView& packed = m_packedGeometry;
+        size_t indexBytes = packed.shortIndices ? sizeof(uint16_t) : sizeof(uint32_t);
+        glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+        glBufferData(GL_ARRAY_BUFFER, packed.vertexCount * sizeof(PackedVertex), packed.vertices, GL_STATIC_DRAW);
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, packed.indexCount * indexBytes, packed.indices, GL_STATIC_DRAW);
+
+        // Same attribute locations as Vertex; GL expands to float
+        glVertexAttribPointer(0, 3, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, position));
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, normal));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, texCoords));
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, color));
+        glEnableVertexAttribArray(3);
+
+        glBindVertexArray(0);
+        return;
+    }
     
     glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(Vertex), m_vertices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, m_geometry.vertexCount * sizeof(Vertex), m_geometry.vertices, GL_STATIC_DRAW);
     
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(unsigned int), m_indices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_geometry.indexCount * sizeof(unsigned int), m_geometry.indices, GL_STATIC_DRAW);
     
     // Position
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
@@ -0,0 +1,26 @@
+#include "rendering/mesh_cache.h"
+
+namespace atlas {
+
+std::string MeshCacheKey::toString() const {
+    std::string text = shipType + "/" + faction + "/" + std::to_string(seed);
+    if (variant == Variant::Proxy) text += "/proxy";
+    return text;
+}
+
+size_t MeshCacheKeyHash::operator()(const MeshCacheKey& key) const {
+    // boost::hash_combine
+    size_t h = std::hash<std::string>{}(key.shipType);
+    auto combine = [&h](size_t v) { h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2); };
+    combine(std::hash<std::string>{}(key.faction));
+    combine(std::hash<uint32_t>{}(key.seed));
+    combine(static_cast<size_t>(key.variant));
+    return h;
+}
+
+double MeshCacheStats::hitRate() const {
+    uint64_t lookups = hits + misses;
+    return lookups ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+}
+
+} // namespace atlas
@@ -0,0 +1,283 @@
+#include "rendering/mesh_disk_cache.h"
+#include "rendering/mapped_file.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <system_error>
+#include <thread>
+
+// Set by CMake from a hash of the generator sources; builds without it
+// share one version and must clear the cache after changing a generator
+#ifndef ATLAS_MESH_GENERATOR_HASH
+#define ATLAS_MESH_GENERATOR_HASH "dev"
+#endif
+
+namespace atlas {
+
+namespace {
+
+constexpr char FILE_MAGIC[4] = { 'A', 'M', 'S', 'H' };
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304u;
+constexpr size_t DATA_ALIGNMENT = 16;
+constexpr size_t CODE_VERSION_BYTES = 32;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t formatVersion;
+    uint32_t byteOrder;
+    uint32_t vertexStride;
+    uint64_t sourceStamp;
+    uint64_t fileBytes;
+    uint32_t partCount;
+    uint32_t keyBytes;
+    char codeVersion[CODE_VERSION_BYTES];
+};
+
+struct PartRecord {
+    uint64_t vertexOffset;
+    uint64_t vertexCount;
+    uint64_t indexOffset;
+    uint64_t indexCount;
+    uint32_t lod;           // 0 is full detail
+    float lodError;
+};
+
+size_t alignUp(size_t value) {
+    return (value + DATA_ALIGNMENT - 1) & ~(DATA_ALIGNMENT - 1);
+}
+
+uint64_t fnv1a(const std::string& text) {
+    uint64_t hash = 1469598103934665603ull;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+MeshDiskCache::MeshDiskCache(const std::string& directory, const std::string& codeVersion)
+    : m_directory(directory)
+    , m_codeVersion(codeVersion.substr(0, CODE_VERSION_BYTES))
+{
+}
+
+std::string MeshDiskCache::generatorVersion() {
+    return ATLAS_MESH_GENERATOR_HASH;
+}
+
+std::string MeshDiskCache::pathFor(const MeshCacheKey& key) const {
+    // Readable prefix for humans, hash for uniqueness
+    std::string keyText = key.toString();
+    std::string name;
+    for (char c : keyText) {
+        if (name.size() >= 48) break;
+        name += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+    }
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(fnv1a(keyText)));
+    return (std::filesystem::path(m_directory) / (name + "_" + hash + FILE_EXTENSION)).string();
+}
+
+std::shared_ptr<const BakedMesh> MeshDiskCache::load(const MeshCacheKey& key, uint64_t sourceStamp) {
+    size_t fileBytes = 0;
+    std::shared_ptr<const void> mapping = mapFileReadOnly(pathFor(key), fileBytes);
+    if (!mapping) {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        ++m_stats.misses;
+        return nullptr;
+    }
+
+    const auto* base = static_cast<const unsigned char*>(mapping.get());
+    auto rejectStale = [this]() -> std::shared_ptr<const BakedMesh> {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        ++m_stats.stale;
+        return nullptr;
+    };
+
+    if (fileBytes < sizeof(FileHeader)) return rejectStale();
+    FileHeader header;
+    std::memcpy(&header, base, sizeof(header));
+
+    char expectedVersion[CODE_VERSION_BYTES] = {};
+    std::memcpy(expectedVersion, m_codeVersion.data(), m_codeVersion.size());
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+        header.formatVersion != FORMAT_VERSION ||
+        header.byteOrder != BYTE_ORDER_MARK ||
+        header.vertexStride != sizeof(Vertex) ||
+        header.fileBytes != fileBytes ||
+        header.sourceStamp != sourceStamp ||
+        std::memcmp(header.codeVersion, expectedVersion, CODE_VERSION_BYTES) != 0) {
+        return rejectStale();
+    }
+
+    size_t tableEnd = sizeof(FileHeader) + static_cast<size_t>(header.partCount) * sizeof(PartRecord);
+    std::string keyText = key.toString();
+    if (tableEnd + header.keyBytes > fileBytes || header.keyBytes != keyText.size() ||
+        std::memcmp(base + tableEnd, keyText.data(), keyText.size()) != 0) {
+        // Truncated, or a different key hashed to the same name
+        return rejectStale();
+    }
+
+    auto baked = std::make_shared<BakedMesh>();
+    baked->parts.reserve(header.partCount);
+    for (uint32_t i = 0; i < header.partCount; ++i) {
+        PartRecord part;
+        std::memcpy(&part, base + sizeof(FileHeader) + i * sizeof(PartRecord), sizeof(part));
+        bool inBounds =
+            part.vertexOffset % DATA_ALIGNMENT == 0 && part.indexOffset % DATA_ALIGNMENT == 0 &&
+            part.vertexOffset <= fileBytes &&
+            part.vertexCount <= (fileBytes - part.vertexOffset) / sizeof(Vertex) &&
+            part.indexOffset <= fileBytes &&
+            part.indexCount <= (fileBytes - part.indexOffset) / sizeof(unsigned int);
+        if (!inBounds) return rejectStale();
+
+        // Levels are stored in order, full detail first
+        if (part.lod > baked->lods.size() + 1 || (part.lod == 0 && !baked->lods.empty())) return rejectStale();
+
+        MeshGeometryView view;
+        view.vertices = reinterpret_cast<const Vertex*>(base + part.vertexOffset);
+        view.vertexCount = static_cast<size_t>(part.vertexCount);
+        view.indices = reinterpret_cast<const unsigned int*>(base + part.indexOffset);
+        view.indexCount = static_cast<size_t>(part.indexCount);
+        if (part.lod == 0) {
+            baked->parts.push_back(view);
+        } else {
+            if (part.lod > baked->lods.size()) baked->lods.emplace_back();
+            baked->lods.back().parts.push_back(view);
+            baked->lods.back().error = part.lodError;
+        }
+    }
+    baked->mappedBytes = fileBytes;
+    baked->mapping = std::move(mapping);
+
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    ++m_stats.hits;
+    m_stats.bytesMapped += fileBytes;
+    return baked;
+}
+
+bool MeshDiskCache::store(const MeshCacheKey& key, const std::vector<MeshGeometryView>& parts,
+                          uint64_t sourceStamp, const std::vector<MeshLodGeometry>& lods) {
+    std::string keyText = key.toString();
+
+    // Every level's parts in one list, full detail first
+    std::vector<MeshGeometryView> blocks = parts;
+    std::vector<PartRecord> table(blocks.size(), PartRecord{});
+    for (size_t level = 0; level < lods.size(); ++level) {
+        for (const auto& part : lods[level].parts) {
+            blocks.push_back(part);
+            PartRecord record = {};
+            record.lod = static_cast<uint32_t>(level + 1);
+            record.lodError = lods[level].error;
+            table.push_back(record);
+        }
+    }
+
+    // Lay out the blocks after the header, part table and key
+    size_t offset = alignUp(sizeof(FileHeader) + blocks.size() * sizeof(PartRecord) + keyText.size());
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        table[i].vertexOffset = offset;
+        table[i].vertexCount = blocks[i].vertexCount;
+        offset = alignUp(offset + blocks[i].vertexCount * sizeof(Vertex));
+        table[i].indexOffset = offset;
+        table[i].indexCount = blocks[i].indexCount;
+        offset = alignUp(offset + blocks[i].indexCount * sizeof(unsigned int));
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.vertexStride = sizeof(Vertex);
+    header.sourceStamp = sourceStamp;
+    header.fileBytes = offset;
+    header.partCount = static_cast<uint32_t>(blocks.size());
+    header.keyBytes = static_cast<uint32_t>(keyText.size());
+    std::memcpy(header.codeVersion, m_codeVersion.data(), m_codeVersion.size());
+
+    std::string path = pathFor(key);
+    static std::atomic<uint64_t> s_tempCounter{0};
+    std::string tempPath = path + ".tmp" +
+        std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + "_" +
+        std::to_string(s_tempCounter++);
+
+    auto fail = [this, &tempPath](const std::string& reason) {
+        std::error_code ignored;
+        std::filesystem::remove(tempPath, ignored);
+        std::cerr << "[MeshDiskCache] Could not write " << tempPath << ": " << reason << std::endl;
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        ++m_stats.writeFailures;
+        return false;
+    };
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_directory, ec);
+    if (ec) return fail(ec.message());
+
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) return fail("cannot open");
+
+        static const char padding[DATA_ALIGNMENT] = {};
+        auto padTo = [&out](size_t target) {
+            size_t position = static_cast<size_t>(out.tellp());
+            if (target > position) out.write(padding, static_cast<std::streamsize>(target - position));
+        };
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(table.data()),
+                  static_cast<std::streamsize>(table.size() * sizeof(PartRecord)));
+        out.write(keyText.data(), static_cast<std::streamsize>(keyText.size()));
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            padTo(static_cast<size_t>(table[i].vertexOffset));
+            out.write(reinterpret_cast<const char*>(blocks[i].vertices),
+                      static_cast<std::streamsize>(blocks[i].vertexCount * sizeof(Vertex)));
+            padTo(static_cast<size_t>(table[i].indexOffset));
+            out.write(reinterpret_cast<const char*>(blocks[i].indices),
+                      static_cast<std::streamsize>(blocks[i].indexCount * sizeof(unsigned int)));
+        }
+        padTo(offset);
+        if (!out) return fail("write error");
+    }
+
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) return fail(ec.message());
+
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    ++m_stats.writes;
+    m_stats.bytesWritten += offset;
+    return true;
+}
+
+size_t MeshDiskCache::clear() {
+    size_t removed = 0;
+    std::error_code ec;
+    if (!std::filesystem::is_directory(m_directory, ec)) return 0;
+    for (const auto& entry : std::filesystem::directory_iterator(m_directory, ec)) {
+        std::string name = entry.path().filename().string();
+        // Baked files and temporaries left by an interrupted store
+        if (name.find(FILE_EXTENSION) == std::string::npos) continue;
+        if (std::filesystem::remove(entry.path(), ec)) ++removed;
+    }
+    return removed;
+}
+
+MeshDiskCacheStats MeshDiskCache::getStats() const {
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    return m_stats;
+}
+
+void MeshDiskCache::resetStats() {
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    m_stats = MeshDiskCacheStats();
+}
+
+} // namespace atlas
@@ -0,0 +1,167 @@
+#include "rendering/mesh_job_system.h"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+namespace atlas {
+
+namespace {
+
+double millisecondsBetween(std::chrono::steady_clock::time_point from,
+                           std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+} // namespace
+
+MeshJobSystem::MeshJobSystem(unsigned int workerCount) {
+    if (workerCount == 0) {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        // Leave a core for the render thread
+        workerCount = hardware > 1 ? hardware - 1 : 1;
+    }
+    m_workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&MeshJobSystem::workerLoop, this);
+    }
+}
+
+MeshJobSystem::~MeshJobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_queue.clear();
+    }
+    m_workAvailable.notify_all();
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+uint64_t MeshJobSystem::submit(const std::string& name, BuildFunction build,
+                               CompleteFunction complete) {
+    Job job;
+    job.name = name;
+    job.build = std::move(build);
+    job.complete = std::move(complete);
+    job.submittedAt = Clock::now();
+
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        id = m_nextId++;
+        job.id = id;
+        m_queue.push_back(std::move(job));
+        ++m_stats.submitted;
+    }
+    m_workAvailable.notify_one();
+    return id;
+}
+
+void MeshJobSystem::workerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workAvailable.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+            if (m_stopping) return;
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+            ++m_building;
+        }
+
+        Clock::time_point startedAt = Clock::now();
+        bool failed = false;
+        try {
+            if (job.build) job.build();
+        } catch (const std::exception& e) {
+            std::cerr << "Mesh job '" << job.name << "' failed: " << e.what() << std::endl;
+            failed = true;
+        } catch (...) {
+            std::cerr << "Mesh job '" << job.name << "' failed" << std::endl;
+            failed = true;
+        }
+        job.builtAt = Clock::now();
+
+        job.timing.id = job.id;
+        job.timing.name = job.name;
+        job.timing.queueMs = millisecondsBetween(job.submittedAt, startedAt);
+        job.timing.buildMs = millisecondsBetween(startedAt, job.builtAt);
+        job.timing.failed = failed;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_building;
+            ++m_stats.built;
+            if (failed) ++m_stats.failed;
+            m_stats.buildMsTotal += job.timing.buildMs;
+            m_stats.buildMsMax = std::max(m_stats.buildMsMax, job.timing.buildMs);
+            m_stats.queueMsMax = std::max(m_stats.queueMsMax, job.timing.queueMs);
+            m_ready.push_back(std::move(job));
+        }
+        m_buildFinished.notify_all();
+    }
+}
+
+size_t MeshJobSystem::processCompleted(double budgetMs) {
+    Clock::time_point start = Clock::now();
+    size_t completed = 0;
+
+    for (;;) {
+        if (completed > 0 && millisecondsBetween(start, Clock::now()) >= budgetMs) break;
+
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_ready.empty()) break;
+            job = std::move(m_ready.front());
+            m_ready.pop_front();
+        }
+
+        Clock::time_point completeStart = Clock::now();
+        if (job.complete) job.complete();
+        Clock::time_point completedAt = Clock::now();
+
+        job.timing.waitMs = millisecondsBetween(job.builtAt, completeStart);
+        job.timing.completeMs = millisecondsBetween(completeStart, completedAt);
+        job.timing.totalMs = millisecondsBetween(job.submittedAt, completedAt);
+        recordTiming(job.timing);
+        ++completed;
+    }
+    return completed;
+}
+
+void MeshJobSystem::waitForBuilds() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_buildFinished.wait(lock, [this]() { return m_queue.empty() && m_building == 0; });
+}
+
+size_t MeshJobSystem::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size() + m_building + m_ready.size();
+}
+
+MeshJobStats MeshJobSystem::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    MeshJobStats stats = m_stats;
+    stats.queued = m_queue.size();
+    stats.building = m_building;
+    stats.ready = m_ready.size();
+    return stats;
+}
+
+std::vector<MeshJobTiming> MeshJobSystem::getRecentTimings() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::vector<MeshJobTiming>(m_recent.begin(), m_recent.end());
+}
+
+void MeshJobSystem::recordTiming(const MeshJobTiming& timing) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_stats.completed;
+    m_stats.completeMsTotal += timing.completeMs;
+    m_stats.completeMsMax = std::max(m_stats.completeMsMax, timing.completeMs);
+    m_recent.push_back(timing);
+    if (m_recent.size() > MAX_RECENT_TIMINGS) m_recent.pop_front();
+}
+
+} // namespace atlas
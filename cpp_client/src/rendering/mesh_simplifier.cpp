@@ -0,0 +1,844 @@
+#include "rendering/mesh_simplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace atlas {
+
+namespace {
+
+constexpr unsigned int NO_VERTEX = ~0u;
+
+// Border outlines should hold; seams only need to stay closed
+constexpr float BORDER_EDGE_WEIGHT = 10.0f;
+constexpr float SEAM_EDGE_WEIGHT = 1.0f;
+
+// Cosine of the furthest a collapse may turn a triangle
+constexpr float MAX_TURN_COSINE = 0.25f;
+
+// Collapses in one pass may exceed the cheapest half's error by this much
+constexpr float PASS_ERROR_SLACK = 1.5f;
+
+enum VertexKind : unsigned char {
+    KIND_MANIFOLD,  // interior, one set of attributes
+    KIND_BORDER,    // on one open edge loop
+    KIND_SEAM,      // two attribute sets along one seam
+    KIND_LOCKED,    // corners, seam junctions, non-manifold: never moves
+    KIND_COUNT
+};
+
+// Whether a vertex of the first kind may collapse onto one of the second
+const bool CAN_COLLAPSE[KIND_COUNT][KIND_COUNT] = {
+    { true,  true,  true,  true  },
+    { false, true,  false, false },
+    { false, false, true,  false },
+    { false, false, false, false },
+};
+
+// Whether an edge between these kinds is shared by two triangles (once each way)
+const bool HAS_OPPOSITE[KIND_COUNT][KIND_COUNT] = {
+    { true,  true,  true,  true  },
+    { true,  false, true,  false },
+    { true,  true,  true,  true  },
+    { true,  false, true,  false },
+};
+
+/**
+ * Sum of squared distances to weighted planes, as a symmetric 4x4 matrix
+ */
+struct Quadric {
+    float a00 = 0, a11 = 0, a22 = 0;
+    float a10 = 0, a20 = 0, a21 = 0;
+    float b0 = 0, b1 = 0, b2 = 0;
+    float c = 0;
+    float w = 0;
+};
+
+Quadric quadricFromPlane(const glm::vec3& n, float d, float weight) {
+    Quadric q;
+    glm::vec3 nw = n * weight;
+    q.a00 = n.x * nw.x;
+    q.a11 = n.y * nw.y;
+    q.a22 = n.z * nw.z;
+    q.a10 = n.y * nw.x;
+    q.a20 = n.z * nw.x;
+    q.a21 = n.z * nw.y;
+    q.b0 = d * nw.x;
+    q.b1 = d * nw.y;
+    q.b2 = d * nw.z;
+    q.c = d * d * weight;
+    q.w = weight;
+    return q;
+}
+
+// Plane of the triangle, weighted by its area
+Quadric quadricFromTriangle(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2) {
+    glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+    float area = glm::length(normal);
+    if (area > 0.0f) normal /= area;
+    return quadricFromPlane(normal, -glm::dot(normal, p0), area);
+}
+
+// Plane through edge p0-p1 perpendicular to the triangle, weighted by length squared
+Quadric quadricFromTriangleEdge(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, float weight) {
+    glm::vec3 edge = p1 - p0;
+    float length = glm::length(edge);
+    if (length > 0.0f) edge /= length;
+    glm::vec3 toOpposite = p2 - p0;
+    glm::vec3 normal = toOpposite - edge * glm::dot(toOpposite, edge);
+    float normalLength = glm::length(normal);
+    if (normalLength > 0.0f) normal /= normalLength;
+    return quadricFromPlane(normal, -glm::dot(normal, p0), length * length * weight);
+}
+
+void quadricAdd(Quadric& q, const Quadric& r) {
+    q.a00 += r.a00; q.a11 += r.a11; q.a22 += r.a22;
+    q.a10 += r.a10; q.a20 += r.a20; q.a21 += r.a21;
+    q.b0 += r.b0; q.b1 += r.b1; q.b2 += r.b2;
+    q.c += r.c;
+    q.w += r.w;
+}
+
+// Weighted mean squared distance of @p v to the planes
+float quadricError(const Quadric& q, const glm::vec3& v) {
+    float rx = q.b0 + q.a10 * v.y;
+    float ry = q.b1 + q.a21 * v.z;
+    float rz = q.b2 + q.a20 * v.x;
+    rx = rx * 2.0f + q.a00 * v.x;
+    ry = ry * 2.0f + q.a11 * v.y;
+    rz = rz * 2.0f + q.a22 * v.z;
+    float r = q.c + rx * v.x + ry * v.y + rz * v.z;
+    return q.w > 0.0f ? std::fabs(r) / q.w : 0.0f;
+}
+
+struct PositionHash {
+    size_t operator()(const glm::vec3& p) const {
+        // Adding zero turns -0 into +0, which compare equal
+        glm::vec3 canonical = p + glm::vec3(0.0f);
+        uint32_t bits[3];
+        std::memcpy(bits, &canonical, sizeof(bits));
+        return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+    }
+};
+
+/**
+ * Half-edges leaving each vertex, in compressed rows
+ */
+struct EdgeAdjacency {
+    std::vector<unsigned int> offsets;
+    std::vector<unsigned int> targets;
+
+    void build(const std::vector<unsigned int>& indices, size_t vertexCount) {
+        offsets.assign(vertexCount + 1, 0);
+        for (unsigned int v : indices) ++offsets[v + 1];
+        for (size_t i = 0; i < vertexCount; ++i) offsets[i + 1] += offsets[i];
+        targets.resize(indices.size());
+        std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            for (size_t e = 0; e < 3; ++e) {
+                unsigned int from = indices[i + e];
+                targets[fill[from]++] = indices[i + (e + 1) % 3];
+            }
+        }
+    }
+
+    bool hasEdge(unsigned int from, unsigned int to) const {
+        for (unsigned int i = offsets[from]; i < offsets[from + 1]; ++i) {
+            if (targets[i] == to) return true;
+        }
+        return false;
+    }
+};
+
+/**
+ * Triangles touching each position (not each vertex), in compressed rows
+ */
+struct TriangleAdjacency {
+    std::vector<unsigned int> offsets;
+    std::vector<unsigned int> triangles;
+
+    void build(const std::vector<unsigned int>& indices, const std::vector<unsigned int>& remap) {
+        size_t vertexCount = remap.size();
+        offsets.assign(vertexCount + 1, 0);
+        for (unsigned int v : indices) ++offsets[remap[v] + 1];
+        for (size_t i = 0; i < vertexCount; ++i) offsets[i + 1] += offsets[i];
+        triangles.resize(indices.size());
+        std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            triangles[fill[remap[indices[i]]]++] = static_cast<unsigned int>(i / 3);
+        }
+    }
+};
+
+struct Collapse {
+    unsigned int from;
+    unsigned int to;
+    bool bidirectional;
+    float error;
+};
+
+/**
+ * Simplification state for one mesh; positions are normalised to the unit
+ * cube so errors do not depend on model scale
+ */
+class Simplifier {
+public:
+    Simplifier(const MeshGeometryView& mesh, float scale)
+        : m_vertexCount(mesh.vertexCount)
+    {
+        glm::vec3 minimum(std::numeric_limits<float>::max());
+        for (size_t i = 0; i < mesh.vertexCount; ++i) minimum = glm::min(minimum, mesh.vertices[i].position);
+        float inverseScale = scale > 0.0f ? 1.0f / scale : 1.0f;
+        m_positions.resize(mesh.vertexCount);
+        for (size_t i = 0; i < mesh.vertexCount; ++i) {
+            m_positions[i] = (mesh.vertices[i].position - minimum) * inverseScale;
+        }
+        buildPositionRemap(mesh);
+    }
+
+    std::vector<unsigned int> run(std::vector<unsigned int> indices, size_t targetIndexCount,
+                                  float targetError, float* resultError) {
+        m_edges.build(indices, m_vertexCount);
+        classifyVertices();
+        fillQuadrics(indices);
+
+        float errorLimit = targetError * targetError;
+        float reachedError = 0.0f;
+        std::vector<Collapse> collapses;
+        std::vector<unsigned int> collapseRemap(m_vertexCount);
+        std::vector<unsigned char> collapseLocked(m_vertexCount);
+
+        while (indices.size() > targetIndexCount) {
+            m_triangles.build(indices, m_remap);
+            pickEdgeCollapses(indices, collapses);
+            if (collapses.empty()) break;
+            rankEdgeCollapses(collapses);
+            std::sort(collapses.begin(), collapses.end(),
+                      [](const Collapse& a, const Collapse& b) { return a.error < b.error; });
+
+            for (size_t i = 0; i < m_vertexCount; ++i) collapseRemap[i] = static_cast<unsigned int>(i);
+            std::fill(collapseLocked.begin(), collapseLocked.end(), 0);
+
+            size_t triangleGoal = (indices.size() - targetIndexCount) / 3;
+            size_t edgeGoal = triangleGoal / 2;
+            float passLimit = edgeGoal < collapses.size()
+                ? std::max(collapses[edgeGoal].error * PASS_ERROR_SLACK, std::numeric_limits<float>::min())
+                : std::numeric_limits<float>::max();
+
+            size_t trianglesCollapsed = 0;
+            size_t performed = 0;
+            for (const Collapse& c : collapses) {
+                if (c.error > errorLimit || trianglesCollapsed >= triangleGoal) break;
+                // Past the pass limit only while everything under it was blocked
+                if (c.error > passLimit && performed > 0) break;
+
+                unsigned int r0 = m_remap[c.from];
+                unsigned int r1 = m_remap[c.to];
+                if (collapseLocked[r0] || collapseLocked[r1]) continue;
+                if (hasTriangleFlips(indices, c.from, c.to)) continue;
+
+                if (m_kinds[c.from] == KIND_SEAM) {
+                    // Both sides of the seam move along it together
+                    unsigned int s0 = m_wedge[c.from];
+                    unsigned int s1 = m_loop[c.from] == c.to ? m_loopBack[s0] : m_loop[s0];
+                    if (s1 == NO_VERTEX || m_remap[s1] != r1) continue;
+                    collapseRemap[c.from] = c.to;
+                    collapseRemap[s0] = s1;
+                } else {
+                    collapseRemap[c.from] = c.to;
+                }
+
+                // Each triangle changes at most once per pass, so flip checks see current positions
+                for (unsigned int t = m_triangles.offsets[r0]; t < m_triangles.offsets[r0 + 1]; ++t) {
+                    const unsigned int* tri = &indices[m_triangles.triangles[t] * 3];
+                    for (size_t corner = 0; corner < 3; ++corner) collapseLocked[m_remap[tri[corner]]] = 1;
+                }
+                quadricAdd(m_quadrics[r1], m_quadrics[r0]);
+                trianglesCollapsed += m_kinds[c.from] == KIND_BORDER ? 1 : 2;
+                reachedError = std::max(reachedError, c.error);
+                ++performed;
+            }
+            if (performed == 0) break;
+
+            remapEdgeLoops(m_loop, collapseRemap);
+            remapEdgeLoops(m_loopBack, collapseRemap);
+            remapIndices(indices, collapseRemap);
+        }
+
+        if (resultError) *resultError = std::sqrt(reachedError);
+        return indices;
+    }
+
+private:
+    size_t m_vertexCount;
+    std::vector<glm::vec3> m_positions;
+    std::vector<unsigned int> m_remap;      // first vertex at the same position
+    std::vector<unsigned int> m_wedge;      // next vertex at the same position, cyclic
+    std::vector<unsigned char> m_kinds;
+    std::vector<unsigned int> m_loop;       // open edge leaving the vertex
+    std::vector<unsigned int> m_loopBack;   // open edge entering the vertex
+    std::vector<Quadric> m_quadrics;        // per position
+    EdgeAdjacency m_edges;
+    TriangleAdjacency m_triangles;
+
+    void buildPositionRemap(const MeshGeometryView& mesh) {
+        std::unordered_map<glm::vec3, unsigned int, PositionHash> first;
+        first.reserve(mesh.vertexCount);
+        m_remap.resize(mesh.vertexCount);
+        m_wedge.resize(mesh.vertexCount);
+        for (size_t i = 0; i < mesh.vertexCount; ++i) {
+            unsigned int index = static_cast<unsigned int>(i);
+            unsigned int r = first.emplace(mesh.vertices[i].position, index).first->second;
+            m_remap[i] = r;
+            m_wedge[i] = index;
+            if (r != index) {
+                m_wedge[i] = m_wedge[r];
+                m_wedge[r] = index;
+            }
+        }
+    }
+
+    void classifyVertices() {
+        // A unique open edge in or out, or the vertex itself when there are several
+        m_loop.assign(m_vertexCount, NO_VERTEX);
+        m_loopBack.assign(m_vertexCount, NO_VERTEX);
+        for (unsigned int v = 0; v < m_vertexCount; ++v) {
+            for (unsigned int i = m_edges.offsets[v]; i < m_edges.offsets[v + 1]; ++i) {
+                unsigned int target = m_edges.targets[i];
+                if (m_edges.hasEdge(target, v)) continue;
+                m_loopBack[target] = m_loopBack[target] == NO_VERTEX ? v : target;
+                m_loop[v] = m_loop[v] == NO_VERTEX ? target : v;
+            }
+        }
+
+        m_kinds.assign(m_vertexCount, KIND_LOCKED);
+        for (unsigned int v = 0; v < m_vertexCount; ++v) {
+            if (m_remap[v] != v) continue;
+            unsigned char kind = KIND_LOCKED;
+            if (m_wedge[v] == v) {
+                unsigned int in = m_loopBack[v];
+                unsigned int out = m_loop[v];
+                if (in == NO_VERTEX && out == NO_VERTEX) {
+                    kind = KIND_MANIFOLD;
+                } else if (in != NO_VERTEX && out != NO_VERTEX && in != v && out != v) {
+                    kind = KIND_BORDER;
+                }
+            } else if (m_wedge[m_wedge[v]] == v) {
+                // The two sides' open edges must run opposite ways between the same positions
+                unsigned int w = m_wedge[v];
+                unsigned int inV = m_loopBack[v], outV = m_loop[v];
+                unsigned int inW = m_loopBack[w], outW = m_loop[w];
+                bool unique = inV != NO_VERTEX && inV != v && outV != NO_VERTEX && outV != v &&
+                              inW != NO_VERTEX && inW != w && outW != NO_VERTEX && outW != w;
+                if (unique && m_remap[inV] == m_remap[outW] && m_remap[outV] == m_remap[inW]) {
+                    kind = KIND_SEAM;
+                }
+            }
+            m_kinds[v] = kind;
+        }
+        for (unsigned int v = 0; v < m_vertexCount; ++v) m_kinds[v] = m_kinds[m_remap[v]];
+    }
+
+    void fillQuadrics(const std::vector<unsigned int>& indices) {
+        m_quadrics.assign(m_vertexCount, Quadric());
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            unsigned int i0 = indices[i], i1 = indices[i + 1], i2 = indices[i + 2];
+            Quadric q = quadricFromTriangle(m_positions[i0], m_positions[i1], m_positions[i2]);
+            quadricAdd(m_quadrics[m_remap[i0]], q);
+            quadricAdd(m_quadrics[m_remap[i1]], q);
+            quadricAdd(m_quadrics[m_remap[i2]], q);
+        }
+
+        // Planes along border and seam edges resist moving them sideways
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            for (size_t e = 0; e < 3; ++e) {
+                unsigned int i0 = indices[i + e];
+                unsigned int i1 = indices[i + (e + 1) % 3];
+                unsigned int i2 = indices[i + (e + 2) % 3];
+                unsigned char k0 = m_kinds[i0], k1 = m_kinds[i1];
+                bool open0 = k0 == KIND_BORDER || k0 == KIND_SEAM;
+                bool open1 = k1 == KIND_BORDER || k1 == KIND_SEAM;
+                if (!open0 && !open1) continue;
+                if (open0 && m_loop[i0] != i1) continue;
+                if (open1 && m_loopBack[i1] != i0) continue;
+                if (HAS_OPPOSITE[k0][k1] && m_remap[i1] > m_remap[i0]) continue;
+
+                float weight = (k0 == KIND_BORDER || k1 == KIND_BORDER) ? BORDER_EDGE_WEIGHT : SEAM_EDGE_WEIGHT;
+                Quadric q = quadricFromTriangleEdge(m_positions[i0], m_positions[i1], m_positions[i2], weight);
+                quadricAdd(m_quadrics[m_remap[i0]], q);
+                quadricAdd(m_quadrics[m_remap[i1]], q);
+            }
+        }
+    }
+
+    void pickEdgeCollapses(const std::vector<unsigned int>& indices, std::vector<Collapse>& collapses) const {
+        collapses.clear();
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            for (size_t e = 0; e < 3; ++e) {
+                unsigned int i0 = indices[i + e];
+                unsigned int i1 = indices[i + (e + 1) % 3];
+                unsigned char k0 = m_kinds[i0], k1 = m_kinds[i1];
+                if (!CAN_COLLAPSE[k0][k1] && !CAN_COLLAPSE[k1][k0]) continue;
+                // Shared edges are seen twice; keep one
+                if (HAS_OPPOSITE[k0][k1] && m_remap[i1] > m_remap[i0]) continue;
+                // Two border or seam vertices not joined by their own loop
+                if (k0 == k1 && (k0 == KIND_BORDER || k0 == KIND_SEAM) && m_loop[i0] != i1) continue;
+
+                if (CAN_COLLAPSE[k0][k1] && CAN_COLLAPSE[k1][k0]) {
+                    collapses.push_back({ i0, i1, true, 0.0f });
+                } else if (CAN_COLLAPSE[k0][k1]) {
+                    collapses.push_back({ i0, i1, false, 0.0f });
+                } else {
+                    collapses.push_back({ i1, i0, false, 0.0f });
+                }
+            }
+        }
+    }
+
+    void rankEdgeCollapses(std::vector<Collapse>& collapses) const {
+        for (Collapse& c : collapses) {
+            c.error = quadricError(m_quadrics[m_remap[c.from]], m_positions[c.to]);
+            if (!c.bidirectional) continue;
+            float reverse = quadricError(m_quadrics[m_remap[c.to]], m_positions[c.from]);
+            if (reverse < c.error) {
+                std::swap(c.from, c.to);
+                c.error = reverse;
+            }
+        }
+    }
+
+    // Would moving @p from onto @p to turn any surviving triangle around it (nearly) over?
+    bool hasTriangleFlips(const std::vector<unsigned int>& indices, unsigned int from, unsigned int to) const {
+        unsigned int r0 = m_remap[from];
+        unsigned int r1 = m_remap[to];
+        const glm::vec3& target = m_positions[to];
+        for (unsigned int i = m_triangles.offsets[r0]; i < m_triangles.offsets[r0 + 1]; ++i) {
+            const unsigned int* tri = &indices[m_triangles.triangles[i] * 3];
+            unsigned int a = m_remap[tri[0]], b = m_remap[tri[1]], c = m_remap[tri[2]];
+            // Triangles on the collapsing edge disappear
+            if (a == r1 || b == r1 || c == r1) continue;
+
+            // Rotate so the moving corner comes first
+            unsigned int corner = a == r0 ? 0 : (b == r0 ? 1 : 2);
+            const glm::vec3& p0 = m_positions[tri[corner]];
+            const glm::vec3& p1 = m_positions[tri[(corner + 1) % 3]];
+            const glm::vec3& p2 = m_positions[tri[(corner + 2) % 3]];
+            glm::vec3 before = glm::cross(p1 - p0, p2 - p0);
+            glm::vec3 after = glm::cross(p1 - target, p2 - target);
+            // Turning more than about 75 degrees; steps near 90 add up to flips over passes
+            if (glm::dot(before, after) <= MAX_TURN_COSINE * glm::length(before) * glm::length(after)) return true;
+        }
+        return false;
+    }
+
+    static void remapEdgeLoops(std::vector<unsigned int>& loop, const std::vector<unsigned int>& collapseRemap) {
+        for (size_t i = 0; i < loop.size(); ++i) {
+            unsigned int next = loop[i];
+            if (next == NO_VERTEX) continue;
+            unsigned int moved = collapseRemap[next];
+            // The loop skips over a vertex that collapsed back onto this one
+            loop[i] = moved == i ? loop[next] : moved;
+        }
+    }
+
+    void remapIndices(std::vector<unsigned int>& indices, const std::vector<unsigned int>& collapseRemap) const {
+        size_t write = 0;
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            unsigned int a = collapseRemap[indices[i]];
+            unsigned int b = collapseRemap[indices[i + 1]];
+            unsigned int c = collapseRemap[indices[i + 2]];
+            // Zero area once two corners share a position
+            unsigned int ra = m_remap[a], rb = m_remap[b], rc = m_remap[c];
+            if (ra == rb || rb == rc || ra == rc) continue;
+            indices[write++] = a;
+            indices[write++] = b;
+            indices[write++] = c;
+        }
+        indices.resize(write);
+    }
+};
+
+// Finest grid clustering will try; coarser grids give fewer triangles
+constexpr unsigned int MAX_CLUSTER_GRID = 1024;
+
+// Grids up to this are all tried for the error limit, not only bisected
+constexpr unsigned int MAX_CLUSTER_SCAN = 64;
+
+/**
+ * Vertex clustering on a uniform grid over the unit cube.  Topology is
+ * ignored, so open borders and seams that stop edge collapses do not stop it.
+ */
+class Clusterer {
+public:
+    Clusterer(const MeshGeometryView& mesh, std::vector<unsigned int> indices, float scale)
+        : m_indices(std::move(indices))
+    {
+        glm::vec3 minimum(std::numeric_limits<float>::max());
+        for (size_t i = 0; i < mesh.vertexCount; ++i) minimum = glm::min(minimum, mesh.vertices[i].position);
+        float inverseScale = scale > 0.0f ? 1.0f / scale : 1.0f;
+        m_positions.resize(mesh.vertexCount);
+        for (size_t i = 0; i < mesh.vertexCount; ++i) {
+            m_positions[i] = (mesh.vertices[i].position - minimum) * inverseScale;
+        }
+        m_cells.resize(mesh.vertexCount);
+    }
+
+    // Triangles that keep three distinct cells at @p grid cells per side
+    size_t countTriangles(unsigned int grid) {
+        assignCells(grid);
+        size_t count = 0;
+        for (size_t i = 0; i < m_indices.size(); i += 3) {
+            unsigned int a = m_cells[m_indices[i]], b = m_cells[m_indices[i + 1]], c = m_cells[m_indices[i + 2]];
+            if (a != b && b != c && a != c) ++count;
+        }
+        return count;
+    }
+
+    /**
+     * Snap every vertex to its cell's representative, the one nearest the
+     * cell's centroid, dropping collapsed and repeated triangles
+     */
+    std::vector<unsigned int> cluster(unsigned int grid, float* resultError) {
+        assignCells(grid);
+
+        // xyz sums positions, w counts them
+        std::unordered_map<unsigned int, glm::vec4> centroids;
+        for (unsigned int v : m_indices) centroids[m_cells[v]] += glm::vec4(m_positions[v], 1.0f);
+
+        std::unordered_map<unsigned int, std::pair<unsigned int, float>> best;
+        for (unsigned int v : m_indices) {
+            glm::vec4 sum = centroids[m_cells[v]];
+            glm::vec3 offset = glm::vec3(sum.x, sum.y, sum.z) / sum.w - m_positions[v];
+            float distance = glm::dot(offset, offset);
+            auto inserted = best.emplace(m_cells[v], std::make_pair(v, distance));
+            if (!inserted.second && distance < inserted.first->second.second) inserted.first->second = { v, distance };
+        }
+
+        float maxDistance = 0.0f;
+        for (unsigned int v : m_indices) {
+            maxDistance = std::max(maxDistance, glm::length(m_positions[v] - m_positions[best[m_cells[v]].first]));
+        }
+        if (resultError) *resultError = maxDistance;
+
+        std::vector<unsigned int> result;
+        std::unordered_map<glm::vec3, char, PositionHash> seen;
+        for (size_t i = 0; i < m_indices.size(); i += 3) {
+            unsigned int a = m_cells[m_indices[i]], b = m_cells[m_indices[i + 1]], c = m_cells[m_indices[i + 2]];
+            if (a == b || b == c || a == c) continue;
+            // Same cells in the same winding, whichever corner comes first
+            unsigned int first = std::min(a, std::min(b, c));
+            glm::vec3 key = first == a ? glm::vec3(a, b, c) : first == b ? glm::vec3(b, c, a) : glm::vec3(c, a, b);
+            if (!seen.emplace(key, 0).second) continue;
+            result.push_back(best[a].first);
+            result.push_back(best[b].first);
+            result.push_back(best[c].first);
+        }
+        return result;
+    }
+
+private:
+    std::vector<unsigned int> m_indices;
+    std::vector<glm::vec3> m_positions;     // in the unit cube
+    std::vector<unsigned int> m_cells;
+
+    void assignCells(unsigned int grid) {
+        float cells = static_cast<float>(grid);
+        for (size_t i = 0; i < m_positions.size(); ++i) {
+            glm::vec3 p = glm::min(m_positions[i] * cells, glm::vec3(cells - 1.0f));
+            unsigned int x = static_cast<unsigned int>(std::max(p.x, 0.0f));
+            unsigned int y = static_cast<unsigned int>(std::max(p.y, 0.0f));
+            unsigned int z = static_cast<unsigned int>(std::max(p.z, 0.0f));
+            m_cells[i] = x + grid * (y + grid * z);
+        }
+    }
+};
+
+// Well-formed triangles of @p mesh
+std::vector<unsigned int> validTriangles(const MeshGeometryView& mesh) {
+    std::vector<unsigned int> indices;
+    indices.reserve(mesh.indexCount);
+    for (size_t i = 0; i + 2 < mesh.indexCount; i += 3) {
+        unsigned int a = mesh.indices[i], b = mesh.indices[i + 1], c = mesh.indices[i + 2];
+        if (a >= mesh.vertexCount || b >= mesh.vertexCount || c >= mesh.vertexCount ||
+            a == b || b == c || a == c) {
+            continue;
+        }
+        indices.push_back(a);
+        indices.push_back(b);
+        indices.push_back(c);
+    }
+    return indices;
+}
+
+/**
+ * A mesh with vertices that differ only in normal merged, for LOD building
+ */
+struct WeldedMesh {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    std::vector<unsigned char> faceted;  // welded from several normals; rebuild per level
+};
+
+struct WeldKey {
+    glm::vec3 position;
+    glm::vec2 texCoords;
+    glm::vec3 color;
+
+    bool operator==(const WeldKey& other) const {
+        return std::memcmp(this, &other, sizeof(WeldKey)) == 0;
+    }
+};
+
+struct WeldKeyHash {
+    size_t operator()(const WeldKey& key) const {
+        uint32_t words[sizeof(WeldKey) / 4];
+        std::memcpy(words, &key, sizeof(words));
+        uint32_t hash = 2166136261u;
+        for (uint32_t word : words) hash = (hash ^ word) * 16777619u;
+        return hash;
+    }
+};
+
+WeldedMesh weldNormals(const MeshGeometryView& mesh) {
+    WeldedMesh welded;
+    std::unordered_map<WeldKey, unsigned int, WeldKeyHash> first;
+    first.reserve(mesh.vertexCount);
+    std::vector<unsigned int> remap(mesh.vertexCount);
+    for (size_t i = 0; i < mesh.vertexCount; ++i) {
+        const Vertex& vertex = mesh.vertices[i];
+        WeldKey key;
+        key.position = vertex.position;
+        key.texCoords = vertex.texCoords;
+        key.color = vertex.color;
+        auto inserted = first.emplace(key, static_cast<unsigned int>(welded.vertices.size()));
+        if (inserted.second) {
+            welded.vertices.push_back(vertex);
+            welded.faceted.push_back(0);
+        } else if (welded.vertices[inserted.first->second].normal != vertex.normal) {
+            welded.faceted[inserted.first->second] = 1;
+        }
+        remap[i] = inserted.first->second;
+    }
+
+    welded.indices.reserve(mesh.indexCount);
+    for (size_t i = 0; i + 2 < mesh.indexCount; i += 3) {
+        unsigned int a = mesh.indices[i], b = mesh.indices[i + 1], c = mesh.indices[i + 2];
+        if (a >= mesh.vertexCount || b >= mesh.vertexCount || c >= mesh.vertexCount) continue;
+        welded.indices.push_back(remap[a]);
+        welded.indices.push_back(remap[b]);
+        welded.indices.push_back(remap[c]);
+    }
+    return welded;
+}
+
+// A faceted vertex of a level with its rebuilt normal
+struct CornerKey {
+    unsigned int vertex;
+    glm::vec3 normal;
+
+    bool operator==(const CornerKey& other) const {
+        return vertex == other.vertex && normal == other.normal;
+    }
+};
+
+struct CornerKeyHash {
+    size_t operator()(const CornerKey& key) const {
+        return PositionHash()(key.normal) ^ (key.vertex * 2654435761u);
+    }
+};
+
+// Faces closer than this to a corner's face share its rebuilt normal
+const float CREASE_COSINE = std::cos(glm::radians(20.0f));
+
+/**
+ * Compact @p indices of a simplified welded mesh into a level.  Faceted
+ * vertices get a normal per corner averaged over nearby faces within the
+ * crease angle, so hard edges stay hard on the coarser surface; with
+ * @p rebuildAll every vertex does, for clustered levels whose vertices may
+ * stand in for surfaces facing elsewhere.
+ */
+MeshLod rebuildLod(const WeldedMesh& welded, const std::vector<unsigned int>& indices, bool rebuildAll) {
+    size_t triangleCount = indices.size() / 3;
+    std::vector<glm::vec3> faceNormals(triangleCount);
+    std::vector<glm::vec3> areaNormals(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const glm::vec3& p0 = welded.vertices[indices[t * 3]].position;
+        const glm::vec3& p1 = welded.vertices[indices[t * 3 + 1]].position;
+        const glm::vec3& p2 = welded.vertices[indices[t * 3 + 2]].position;
+        areaNormals[t] = glm::cross(p1 - p0, p2 - p0);
+        float length = glm::length(areaNormals[t]);
+        faceNormals[t] = length > 0.0f ? areaNormals[t] / length : glm::vec3(0.0f);
+    }
+
+    // Triangles around each faceted vertex, across UV and colour seams
+    std::unordered_map<glm::vec3, std::vector<unsigned int>, PositionHash> around;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        unsigned int v = indices[i];
+        if (rebuildAll || welded.faceted[v]) around[welded.vertices[v].position].push_back(static_cast<unsigned int>(i / 3));
+    }
+
+    MeshLod lod;
+    lod.indices.reserve(indices.size());
+    std::vector<unsigned int> compact(welded.vertices.size(), NO_VERTEX);
+    std::unordered_map<CornerKey, unsigned int, CornerKeyHash> split;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        unsigned int v = indices[i];
+        if (!rebuildAll && !welded.faceted[v]) {
+            if (compact[v] == NO_VERTEX) {
+                compact[v] = static_cast<unsigned int>(lod.vertices.size());
+                lod.vertices.push_back(welded.vertices[v]);
+            }
+            lod.indices.push_back(compact[v]);
+            continue;
+        }
+
+        const glm::vec3& face = faceNormals[i / 3];
+        glm::vec3 normal(0.0f);
+        for (unsigned int t : around[welded.vertices[v].position]) {
+            if (glm::dot(faceNormals[t], face) >= CREASE_COSINE) normal += areaNormals[t];
+        }
+        float length = glm::length(normal);
+        normal = length > 0.0f ? normal / length : welded.vertices[v].normal;
+
+        auto inserted = split.emplace(CornerKey{ v, normal }, static_cast<unsigned int>(lod.vertices.size()));
+        if (inserted.second) {
+            Vertex vertex = welded.vertices[v];
+            vertex.normal = normal;
+            lod.vertices.push_back(vertex);
+        }
+        lod.indices.push_back(inserted.first->second);
+    }
+    return lod;
+}
+
+} // namespace
+
+float simplificationScale(const MeshGeometryView& mesh) {
+    if (mesh.vertexCount == 0) return 0.0f;
+    glm::vec3 minimum = mesh.vertices[0].position;
+    glm::vec3 maximum = minimum;
+    for (size_t i = 1; i < mesh.vertexCount; ++i) {
+        minimum = glm::min(minimum, mesh.vertices[i].position);
+        maximum = glm::max(maximum, mesh.vertices[i].position);
+    }
+    glm::vec3 extent = maximum - minimum;
+    return std::max(extent.x, std::max(extent.y, extent.z));
+}
+
+std::vector<unsigned int> simplifyMesh(const MeshGeometryView& mesh, size_t targetIndexCount,
+                                       float targetError, float* resultError) {
+    std::vector<unsigned int> indices = validTriangles(mesh);
+    if (resultError) *resultError = 0.0f;
+    targetIndexCount -= targetIndexCount % 3;
+    if (indices.size() <= targetIndexCount) return indices;
+
+    Simplifier simplifier(mesh, simplificationScale(mesh));
+    return simplifier.run(std::move(indices), targetIndexCount, targetError, resultError);
+}
+
+std::vector<unsigned int> simplifyMeshSloppy(const MeshGeometryView& mesh, size_t targetIndexCount,
+                                             float targetError, float* resultError) {
+    std::vector<unsigned int> indices = validTriangles(mesh);
+    if (resultError) *resultError = 0.0f;
+    size_t targetTriangles = targetIndexCount / 3;
+    if (indices.size() / 3 <= targetTriangles) return indices;
+
+    Clusterer clusterer(mesh, std::move(indices), simplificationScale(mesh));
+
+    // Coarsest grid keeping every vertex within the error; displacement
+    // shrinks with the cell size, near enough for a bisection
+    unsigned int low = 1;
+    unsigned int high = MAX_CLUSTER_GRID;
+    while (low < high) {
+        unsigned int middle = low + (high - low) / 2;
+        float error = 0.0f;
+        clusterer.cluster(middle, &error);
+        if (error <= targetError) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+
+    // Displacement is not strictly monotonic; coarser grids may still fit
+    for (unsigned int coarser = 1; coarser < std::min(low, MAX_CLUSTER_SCAN); ++coarser) {
+        float error = 0.0f;
+        clusterer.cluster(coarser, &error);
+        if (error <= targetError) {
+            low = coarser;
+            break;
+        }
+    }
+
+    // Then the finest grid still within the target count
+    unsigned int grid = low;
+    if (clusterer.countTriangles(grid) <= targetTriangles) {
+        high = MAX_CLUSTER_GRID;
+        while (low < high) {
+            unsigned int middle = low + (high - low + 1) / 2;
+            if (clusterer.countTriangles(middle) <= targetTriangles) {
+                low = middle;
+            } else {
+                high = middle - 1;
+            }
+        }
+        grid = low;
+    }
+
+    float error = 0.0f;
+    std::vector<unsigned int> result = clusterer.cluster(grid, &error);
+    if (error > targetError) return validTriangles(mesh);
+    if (resultError) *resultError = error;
+    return result;
+}
+
+std::vector<MeshLod> buildMeshLods(const MeshGeometryView& mesh, const MeshLodSettings& settings) {
+    // Faceted hulls carry a normal per face, which would make every vertex a
+    // seam; weld those and rebuild their normals per level instead
+    WeldedMesh welded = weldNormals(mesh);
+    MeshGeometryView source;
+    source.vertices = welded.vertices.data();
+    source.vertexCount = welded.vertices.size();
+    source.indices = welded.indices.data();
+    source.indexCount = welded.indices.size();
+
+    std::vector<MeshLod> lods;
+    float scale = simplificationScale(source);
+    size_t previousCount = source.indexCount;
+    float previousError = 0.0f;
+
+    for (size_t level = 0; level < MAX_MESH_LODS; ++level) {
+        size_t target = static_cast<size_t>(static_cast<float>(source.indexCount) * settings.ratios[level]);
+        float error = 0.0f;
+        // Always from full detail, so errors do not compound across levels
+        std::vector<unsigned int> indices = simplifyMesh(source, target, settings.maxError, &error);
+        bool clustered = false;
+        if (indices.size() > target) {
+            // Open borders and seams stalled the collapses; cluster instead
+            float sloppyError = 0.0f;
+            std::vector<unsigned int> sloppy = simplifyMeshSloppy(source, target, settings.maxError, &sloppyError);
+            if (!sloppy.empty() && sloppy.size() < indices.size()) {
+                indices = std::move(sloppy);
+                error = sloppyError;
+                clustered = true;
+            }
+        }
+        if (indices.empty() ||
+            static_cast<float>(indices.size()) > static_cast<float>(previousCount) * (1.0f - settings.minReduction)) {
+            break;
+        }
+
+        MeshLod lod = rebuildLod(welded, indices, clustered);
+        lod.error = std::max(error * scale, previousError);
+
+        previousCount = lod.indices.size();
+        previousError = lod.error;
+        lods.push_back(std::move(lod));
+    }
+    return lods;
+}
+
+} // namespace atlas
@@ -1,5 +1,8 @@
 #include "rendering/model.h"
+#include "rendering/binary_model.h"
+#include "rendering/lod_manager.h"
 #include "rendering/mesh.h"
+#include "rendering/mesh_disk_cache.h"
 #include "rendering/procedural_mesh_ops.h"
 #include "rendering/procedural_ship_generator.h"
 #include "rendering/ship_part_library.h"
@@ -82,24 +85,42 @@ static std::string getExecutableDir() {
 // Mathematical constants
 constexpr float PI = 3.14159265358979323846f;
 
-// Initialize static cache
-std::map<std::string, std::shared_ptr<Model>> Model::s_modelCache;
-
 Model::Model() {
 }
 
 Model::~Model() {
 }
 
-bool Model::loadFromFile(const std::string& path) {
-    // Determine file format based on extension
+// Lower-case extension without the dot
+static std::string fileExtension(const std::string& path) {
     std::string extension;
     size_t dotPos = path.find_last_of('.');
     if (dotPos != std::string::npos) {
         extension = path.substr(dotPos + 1);
-        // Convert to lowercase
         std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
     }
+    return extension;
+}
+
+bool Model::loadFromFile(const std::string& path) {
+    std::string extension = fileExtension(path);
+    if (extension == "amdl") {
+        return loadBinary(path);
+    }
+
+    // Prefer the converted binary: mapping it is far cheaper than parsing
+    if (extension == "obj" || extension == "gltf" || extension == "glb") {
+        std::string binaryPath = findCurrentBinaryModel(path);
+        if (!binaryPath.empty() && loadBinary(binaryPath)) {
+            return true;
+        }
+    }
+    return loadSourceFile(path);
+}
+
+bool Model::loadSourceFile(const std::string& path) {
+    // Determine file format based on extension
+    std::string extension = fileExtension(path);
 
     if (extension == "obj") {
         return loadOBJ(path);
@@ -107,11 +128,34 @@ bool Model::loadFromFile(const std::string& path) {
         return loadGLTF(path);
     } else {
         std::cerr << "Unsupported model format: " << extension << std::endl;
-        std::cerr << "Supported formats: .obj, .gltf, .glb" << std::endl;
+        std::cerr << "Supported formats: .obj, .gltf, .glb, .amdl" << std::endl;
         return false;
     }
 }
 
+bool Model::loadBinary(const std::string& path) {
+    std::shared_ptr<const BinaryModel> binary = loadBinaryModel(path);
+    if (!binary) {
+        std::cerr << "Invalid or outdated binary model: " << path << std::endl;
+        return false;
+    }
+
+    for (const auto& mesh : binary->meshes) {
+        if (mesh.vertexCount > 0 && mesh.indexCount > 0) {
+            addMesh(std::make_unique<Mesh>(binary, mesh));
+        }
+    }
+    for (const auto& lod : binary->lods) {
+        std::vector<std::shared_ptr<Mesh>> meshes;
+        for (const auto& mesh : lod.meshes) {
+            if (mesh.vertexCount > 0 && mesh.indexCount > 0) meshes.push_back(std::make_unique<Mesh>(binary, mesh));
+        }
+        addLod(std::move(meshes), lod.error);
+    }
+    m_bounds = binary->bounds;
+    return !m_meshes.empty();
+}
+
 bool Model::loadOBJ(const std::string& path) {
     tinyobj::attrib_t attrib;
     std::vector<tinyobj::shape_t> shapes;
@@ -359,8 +403,23 @@ bool Model::loadGLTF(const std::string& path) {
     return !m_meshes.empty();
 }
 
-void Model::addMesh(std::unique_ptr<Mesh> mesh) {
+void Model::addMesh(std::shared_ptr<Mesh> mesh) {
     m_meshes.push_back(std::move(mesh));
+    if (!m_meshes.back()->isPacked()) {
+        // Recomputed by getBounds()
+        m_bounds.valid = false;
+    }
+}
+
+const MeshBounds& Model::getBounds() const {
+    if (!m_bounds.valid) {
+        MeshBounds bounds;
+        for (const auto& mesh : m_meshes) {
+            bounds = mergeMeshBounds(bounds, computeMeshBounds(mesh->getGeometry()));
+        }
+        m_bounds = bounds;
+    }
+    return m_bounds;
 }
 
 std::string Model::findOBJModelPath(const std::string& shipType, const std::string& faction) {
@@ -497,6 +556,117 @@ static ProceduralShipParams getProceduralParamsForClass(const std::string& shipC
     return params;
 }
 
+unsigned int Model::shipSeed(const std::string& shipType, const std::string& faction) {
+    return static_cast<unsigned int>(std::hash<std::string>{}(shipType + "_" + faction));
+}
+
+MeshCacheKey Model::shipCacheKey(const std::string& shipType, const std::string& faction) {
+    MeshCacheKey key;
+    key.shipType = shipType;
+    key.faction = faction;
+    key.seed = shipSeed(shipType, faction);
+    return key;
+}
+
+std::string Model::seedClassFor(const std::string& shipType) {
+    if (isFrigate(shipType))                                    return "frigate";
+    if (isDestroyer(shipType))                                  return "destroyer";
+    if (isCruiser(shipType) || isTech2Cruiser(shipType))        return "cruiser";
+    if (isCommandShip(shipType) || isBattlecruiser(shipType))   return "battlecruiser";
+    if (isBattleship(shipType))                                 return "battleship";
+    if (isCarrier(shipType))                                    return "carrier";
+    if (isDreadnought(shipType))                                return "dreadnought";
+    if (isTitan(shipType))                                      return "titan";
+    return "generic";
+}
+
+std::string Model::findSeedOBJPath(const std::string& shipType, const std::string& faction) {
+    ProceduralShipGenerator generator;
+    // Configure reference assets — extracted OBJ models from testing/ archives.
+    // The extraction script (extract_reference_models.sh) places the large OBJ
+    // files into cpp_client/assets/reference_models/.
+    ReferenceAssetConfig assetCfg;
+    assetCfg.objArchivePath      = "testing/99-intergalactic_spaceship-obj.rar";
+    assetCfg.textureArchivePath  = "testing/24-textures.zip";
+    assetCfg.extractedObjDir     = "cpp_client/assets/reference_models";
+    assetCfg.extractedTextureDir = "textures";
+    generator.setReferenceAssets(assetCfg);
+    return generator.findSeedOBJ(faction, seedClassFor(shipType));
+}
+
+uint64_t Model::shipSourceStamp(const std::string& shipType, const std::string& faction) {
+    uint64_t stamp = 0;
+    auto mix = [&stamp](const std::string& path) {
+        if (path.empty()) return;
+        std::error_code ec;
+        uintmax_t size = std::filesystem::file_size(path, ec);
+        auto modified = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+        std::string identity = path + "|" + std::to_string(size) + "|" + std::to_string(modified);
+        stamp = stamp * 31 + std::hash<std::string>{}(identity);
+    };
+    for (const std::string& path : { findOBJModelPath(shipType, faction), findSeedOBJPath(shipType, faction) }) {
+        mix(path);
+        // Converting a source changes which file is read
+        if (!path.empty()) mix(findCurrentBinaryModel(path));
+    }
+    return stamp;
+}
+
+std::unique_ptr<Model> Model::loadOrCreateShipModel(const std::string& shipType, const std::string& faction,
+                                                    MeshDiskCache* diskCache) {
+    // The source stamp stats asset files; without a cache nothing uses it
+    uint64_t stamp = diskCache ? shipSourceStamp(shipType, faction) : 0;
+    return loadOrBakeModel(diskCache, shipCacheKey(shipType, faction), stamp,
+                           [&shipType, &faction]() { return createShipModel(shipType, faction); });
+}
+
+std::unique_ptr<Model> Model::loadOrBakeModel(MeshDiskCache* diskCache, const MeshCacheKey& key,
+                                              uint64_t sourceStamp,
+                                              const std::function<std::unique_ptr<Model>()>& generate) {
+    if (diskCache) {
+        if (auto baked = diskCache->load(key, sourceStamp)) {
+            return createFromBaked(baked);
+        }
+    }
+
+    auto model = generate();
+    if (!model) return model;
+
+    // Models mapped from a converted .amdl are as cheap as a baked file
+    std::vector<MeshGeometryView> geometry = model->getGeometry();
+    bool mapped = std::any_of(geometry.begin(), geometry.end(),
+                              [](const MeshGeometryView& part) { return part.vertexCount == 0; });
+    if (mapped) return model;
+
+    model->generateLods();
+    if (diskCache) diskCache->store(key, geometry, sourceStamp, model->getLodGeometry());
+    return model;
+}
+
+std::unique_ptr<Model> Model::createFromBaked(const std::shared_ptr<const BakedMesh>& baked) {
+    auto model = std::make_unique<Model>();
+    for (const auto& part : baked->parts) {
+        model->addMesh(std::make_unique<Mesh>(baked, part));
+    }
+    for (const auto& lod : baked->lods) {
+        std::vector<std::shared_ptr<Mesh>> meshes;
+        for (const auto& part : lod.parts) {
+            meshes.push_back(std::make_unique<Mesh>(baked, part));
+        }
+        model->addLod(std::move(meshes), lod.error);
+    }
+    return model;
+}
+
+std::vector<MeshGeometryView> Model::getGeometry() const {
+    std::vector<MeshGeometryView> geometry;
+    geometry.reserve(m_meshes.size());
+    for (const auto& mesh : m_meshes) {
+        geometry.push_back(mesh->getGeometry());
+    }
+    return geometry;
+}
+
 std::unique_ptr<Model> Model::createShipModel(const std::string& shipType, const std::string& faction) {
     // Try to load from OBJ file first
     std::string objPath = findOBJModelPath(shipType, faction);
@@ -511,34 +681,13 @@ std::unique_ptr<Model> Model::createShipModel(const std::string& shipType, const
 
     // Try procedural generation from a seed OBJ (reference assets)
     {
-        ProceduralShipGenerator generator;
-        // Configure reference assets — extracted OBJ models from testing/ archives.
-        // The extraction script (extract_reference_models.sh) places the large OBJ
-        // files into cpp_client/assets/reference_models/.
-        ReferenceAssetConfig assetCfg;
-        assetCfg.objArchivePath      = "testing/99-intergalactic_spaceship-obj.rar";
-        assetCfg.textureArchivePath  = "testing/24-textures.zip";
-        assetCfg.extractedObjDir     = "cpp_client/assets/reference_models";
-        assetCfg.extractedTextureDir = "textures";
-        generator.setReferenceAssets(assetCfg);
-
-        // Determine ship class for seed lookup
-        std::string shipClass = "generic";
-        if (isFrigate(shipType))         shipClass = "frigate";
-        else if (isDestroyer(shipType))  shipClass = "destroyer";
-        else if (isCruiser(shipType) || isTech2Cruiser(shipType)) shipClass = "cruiser";
-        else if (isCommandShip(shipType) || isBattlecruiser(shipType)) shipClass = "battlecruiser";
-        else if (isBattleship(shipType)) shipClass = "battleship";
-        else if (isCarrier(shipType))    shipClass = "carrier";
-        else if (isDreadnought(shipType)) shipClass = "dreadnought";
-        else if (isTitan(shipType))      shipClass = "titan";
-
-        std::string seedPath = generator.findSeedOBJ(faction, shipClass);
+        std::string shipClass = seedClassFor(shipType);
+        std::string seedPath = findSeedOBJPath(shipType, faction);
         if (!seedPath.empty()) {
+            ProceduralShipGenerator generator;
             ProceduralShipParams params = getProceduralParamsForClass(shipClass);
             // Generate a deterministic seed from ship type + faction
-            params.seed = static_cast<unsigned int>(
-                std::hash<std::string>{}(shipType + "_" + faction));
+            params.seed = shipSeed(shipType, faction);
 
             // Faction-specific colour
             FactionColors fc = getFactionColors(faction);
@@ -592,6 +741,63 @@ std::unique_ptr<Model> Model::createShipModel(const std::string& shipType, const
     return model;
 }
 
+std::unique_ptr<Model> Model::createProxyModel(const std::string& shipType, const std::string& faction) {
+    // Hull length and radius per class, matching the procedural builders below
+    float length = 3.5f;
+    float radius = 0.3f;
+    if (isDestroyer(shipType))                                  { length = 4.8f;  radius = 0.25f; }
+    else if (isMiningBarge(shipType))                           { length = 6.3f;  radius = 0.9f; }
+    else if (isCruiser(shipType) || isTech2Cruiser(shipType))   { length = 6.3f;  radius = 0.65f; }
+    else if (isCommandShip(shipType) || isBattlecruiser(shipType)) { length = 8.5f; radius = 0.8f; }
+    else if (isBattleship(shipType))                            { length = 12.0f; radius = 1.0f; }
+    else if (isCarrier(shipType))                               { length = 15.4f; radius = 1.2f; }
+    else if (isDreadnought(shipType))                           { length = 12.0f; radius = 1.3f; }
+    else if (isTitan(shipType))                                 { length = 24.0f; radius = 1.8f; }
+    else if (isStation(shipType))                               { length = 20.0f; radius = 3.0f; }
+    else if (isAsteroid(shipType))                              { length = 4.5f;  radius = 2.0f; }
+
+    FactionColors colors = getFactionColors(faction);
+    glm::vec3 color(colors.primary.r, colors.primary.g, colors.primary.b);
+
+    // Tips on the +Z hull axis, four corners around the widest point
+    const glm::vec3 corners[6] = {
+        glm::vec3(0.0f, 0.0f, 0.0f),
+        glm::vec3(0.0f, 0.0f, length),
+        glm::vec3(radius, 0.0f, length * 0.4f),
+        glm::vec3(0.0f, radius, length * 0.4f),
+        glm::vec3(-radius, 0.0f, length * 0.4f),
+        glm::vec3(0.0f, -radius, length * 0.4f)
+    };
+
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    vertices.reserve(24);
+    indices.reserve(24);
+    for (int i = 0; i < 4; ++i) {
+        int a = 2 + i;
+        int b = 2 + (i + 1) % 4;
+        // One face to each tip; flat normals so the silhouette reads clearly
+        const int faces[2][3] = { { 1, a, b }, { 0, b, a } };
+        for (const auto& face : faces) {
+            glm::vec3 p0 = corners[face[0]], p1 = corners[face[1]], p2 = corners[face[2]];
+            glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
+            for (glm::vec3 p : { p0, p1, p2 }) {
+                Vertex v;
+                v.position = p;
+                v.normal = normal;
+                v.texCoords = glm::vec2(0.0f);
+                v.color = color;
+                indices.push_back(static_cast<unsigned int>(vertices.size()));
+                vertices.push_back(v);
+            }
+        }
+    }
+
+    auto model = std::make_unique<Model>();
+    model->addMesh(std::make_unique<Mesh>(vertices, indices));
+    return model;
+}
+
 // ==================== Procedural Hull Generation via buildSegmentedHull ====================
 
 /**
@@ -742,15 +948,19 @@ std::unique_ptr<Model> Model::createShipModelWithRacialDesign(const std::string&
     variation.proportionJitter = 0.3f;
     variation.scaleJitter = 0.1f;
 
-    // Initialize libraries (using static variables to avoid repeated initialization)
-    static ShipPartLibrary library;
-    static ShipGenerationRules rules;
-    static bool initialized = false;
-    if (!initialized) {
-        library.initialize();
-        rules.initialize();
-        initialized = true;
-    }
+    // Initialize libraries once; a function-local static initializes
+    // thread-safely, which matters now that models build on worker threads
+    struct PartLibraries {
+        ShipPartLibrary library;
+        ShipGenerationRules rules;
+        PartLibraries() {
+            library.initialize();
+            rules.initialize();
+        }
+    };
+    static PartLibraries libraries;
+    ShipPartLibrary& library = libraries.library;
+    ShipGenerationRules& rules = libraries.rules;
     
     ShipAssemblyConfig config = library.createVariedAssemblyConfig(shipClass, faction, variation);
     auto classRules = rules.getClassRules(shipClass);
@@ -939,12 +1149,110 @@ std::unique_ptr<Model> Model::createShipModelWithRacialDesign(const std::string&
     return model;
 }
 
-void Model::draw() const {
+void Model::generateLods(const MeshLodSettings& settings) {
+    m_lods.clear();
+    m_lodErrors.clear();
+
+    std::vector<std::vector<MeshLod>> chains;
+    size_t levels = 0;
     for (const auto& mesh : m_meshes) {
+        // Empty for meshes mapped from a binary model
+        chains.push_back(buildMeshLods(mesh->getGeometry(), settings));
+        levels = std::max(levels, chains.back().size());
+    }
+
+    // A mesh that stops simplifying early repeats its coarsest level
+    for (size_t level = 0; level < levels; ++level) {
+        std::vector<std::shared_ptr<Mesh>> meshes;
+        float error = 0.0f;
+        for (size_t i = 0; i < m_meshes.size(); ++i) {
+            const std::vector<MeshLod>& chain = chains[i];
+            if (level >= chain.size()) {
+                meshes.push_back(level == 0 ? m_meshes[i] : m_lods.back()[i]);
+                if (!chain.empty()) error = std::max(error, chain.back().error);
+                continue;
+            }
+            meshes.push_back(std::make_shared<Mesh>(chain[level].vertices, chain[level].indices));
+            error = std::max(error, chain[level].error);
+        }
+        addLod(std::move(meshes), error);
+    }
+}
+
+void Model::addLod(std::vector<std::shared_ptr<Mesh>> meshes, float error) {
+    m_lodErrors.push_back(std::max(error, m_lodErrors.empty() ? 0.0f : m_lodErrors.back()));
+    m_lods.push_back(std::move(meshes));
+}
+
+std::vector<MeshLodGeometry> Model::getLodGeometry() const {
+    std::vector<MeshLodGeometry> lods(m_lods.size());
+    for (size_t level = 0; level < m_lods.size(); ++level) {
+        lods[level].error = m_lodErrors[level];
+        for (const auto& mesh : m_lods[level]) {
+            lods[level].parts.push_back(mesh->getGeometry());
+        }
+    }
+    return lods;
+}
+
+size_t Model::selectLod(float pixelsPerUnit, float maxPixelError) const {
+    return selectMeshLOD(m_lodErrors, pixelsPerUnit, maxPixelError);
+}
+
+const std::vector<std::shared_ptr<Mesh>>& Model::getMeshes(size_t level) const {
+    if (level == 0 || m_lods.empty()) return m_meshes;
+    return m_lods[std::min(level, m_lods.size()) - 1];
+}
+
+size_t Model::getTriangleCount(size_t level) const {
+    size_t triangles = 0;
+    for (const auto& mesh : getMeshes(level)) {
+        triangles += mesh->getIndexCount() / 3;
+    }
+    return triangles;
+}
+
+void Model::draw(size_t level) const {
+    for (const auto& mesh : getMeshes(level)) {
         mesh->draw();
     }
 }
 
+size_t Model::getMemoryBytes() const {
+    size_t bytes = 0;
+    for (size_t level = 0; level < getLodCount(); ++level) {
+        const auto& meshes = getMeshes(level);
+        const auto& finer = getMeshes(level > 0 ? level - 1 : 0);
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            // Count meshes shared with the finer level once
+            if (level > 0 && i < finer.size() && finer[i] == meshes[i]) continue;
+            bytes += meshes[i]->getMemoryBytes();
+        }
+    }
+    return bytes;
+}
+
+size_t Model::upload() const {
+    size_t bytes = 0;
+    for (size_t level = 0; level < getLodCount(); ++level) {
+        for (const auto& mesh : getMeshes(level)) {
+            if (mesh->isUploaded()) continue;
+            mesh->upload();
+            bytes += mesh->getMemoryBytes();
+        }
+    }
+    return bytes;
+}
+
+bool Model::isUploaded() const {
+    for (size_t level = 0; level < getLodCount(); ++level) {
+        for (const auto& mesh : getMeshes(level)) {
+            if (!mesh->isUploaded()) return false;
+        }
+    }
+    return true;
+}
+
 // Ship type checking functions
 bool Model::isFrigate(const std::string& shipType) {
     static const std::vector<std::string> frigateNames = {
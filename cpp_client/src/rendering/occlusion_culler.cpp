@@ -0,0 +1,303 @@
+#include "rendering/occlusion_culler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ATLAS_OCCLUSION_SSE2 1
+#endif
+
+namespace atlas {
+
+namespace {
+
+// Triangles covering less screen area (pixels squared, doubled) are skipped
+constexpr float MIN_TRIANGLE_AREA = 1e-6f;
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Signed distance to the near plane (z = -w) in clip space
+inline float nearDistance(const glm::vec4& v) {
+    return v.z + v.w;
+}
+
+} // namespace
+
+OcclusionCuller::OcclusionCuller(int width, int height)
+    : m_width(std::max(4, (width + 3) / 4 * 4))
+    , m_height(std::max(1, height))
+    , m_depth(static_cast<size_t>(m_width) * static_cast<size_t>(m_height), 1.0f)
+{
+}
+
+void OcclusionCuller::beginFrame(const glm::mat4& viewProjection) {
+    m_viewProjection = viewProjection;
+    std::fill(m_depth.begin(), m_depth.end(), 1.0f);
+    m_pyramidValid = false;
+    m_stats = OcclusionStats();
+}
+
+void OcclusionCuller::addOccluder(const MeshGeometryView& mesh, const glm::mat4& model) {
+    if (!mesh.vertices || !mesh.indices || mesh.indexCount < 3) return;
+    auto start = std::chrono::steady_clock::now();
+
+    // Each vertex is shared by several triangles: transform them once
+    glm::mat4 modelViewProjection = m_viewProjection * model;
+    m_clipVertices.resize(mesh.vertexCount);
+    for (size_t i = 0; i < mesh.vertexCount; ++i) {
+        m_clipVertices[i] = modelViewProjection * glm::vec4(mesh.vertices[i].position, 1.0f);
+    }
+
+    size_t triangles = mesh.indexCount / 3;
+    for (size_t t = 0; t < triangles; ++t) {
+        const unsigned int* index = mesh.indices + t * 3;
+        if (index[0] >= mesh.vertexCount || index[1] >= mesh.vertexCount || index[2] >= mesh.vertexCount) continue;
+        rasterizeClipped(m_clipVertices[index[0]], m_clipVertices[index[1]], m_clipVertices[index[2]]);
+    }
+
+    ++m_stats.occluders;
+    m_stats.occluderTriangles += triangles;
+    m_pyramidValid = false;
+    m_stats.rasterMs += millisecondsSince(start);
+}
+
+void OcclusionCuller::addTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+    auto start = std::chrono::steady_clock::now();
+    rasterizeClipped(m_viewProjection * glm::vec4(a, 1.0f), m_viewProjection * glm::vec4(b, 1.0f),
+                     m_viewProjection * glm::vec4(c, 1.0f));
+    ++m_stats.occluderTriangles;
+    m_pyramidValid = false;
+    m_stats.rasterMs += millisecondsSince(start);
+}
+
+void OcclusionCuller::rasterizeClipped(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c) {
+    // Entirely outside one side of the view volume
+    if ((a.x > a.w && b.x > b.w && c.x > c.w) || (a.x < -a.w && b.x < -b.w && c.x < -c.w) ||
+        (a.y > a.w && b.y > b.w && c.y > c.w) || (a.y < -a.w && b.y < -b.w && c.y < -c.w)) {
+        return;
+    }
+
+    // Clip against the near plane; a triangle becomes at most a quad
+    glm::vec4 input[3] = { a, b, c };
+    glm::vec4 polygon[4];
+    int count = 0;
+    for (int i = 0; i < 3; ++i) {
+        const glm::vec4& current = input[i];
+        const glm::vec4& next = input[(i + 1) % 3];
+        float currentDistance = nearDistance(current);
+        float nextDistance = nearDistance(next);
+        if (currentDistance >= 0.0f) polygon[count++] = current;
+        if ((currentDistance >= 0.0f) != (nextDistance >= 0.0f)) {
+            float t = currentDistance / (currentDistance - nextDistance);
+            polygon[count++] = current + (next - current) * t;
+        }
+    }
+    if (count < 3) return;
+
+    glm::vec3 screen[4];
+    for (int i = 0; i < count; ++i) {
+        // w is positive in front of the near plane
+        float inverseW = 1.0f / std::max(polygon[i].w, 1e-6f);
+        screen[i] = glm::vec3((polygon[i].x * inverseW * 0.5f + 0.5f) * static_cast<float>(m_width),
+                              (polygon[i].y * inverseW * 0.5f + 0.5f) * static_cast<float>(m_height),
+                              polygon[i].z * inverseW);
+    }
+    rasterize(screen[0], screen[1], screen[2]);
+    if (count == 4) rasterize(screen[0], screen[2], screen[3]);
+}
+
+void OcclusionCuller::rasterize(const glm::vec3& a, const glm::vec3& bIn, const glm::vec3& cIn) {
+    glm::vec3 b = bIn;
+    glm::vec3 c = cIn;
+    float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    if (std::abs(area) < MIN_TRIANGLE_AREA) return;
+    if (area < 0.0f) {
+        // Occluders draw both windings
+        std::swap(b, c);
+        area = -area;
+    }
+
+    // Pixels whose centres may lie inside; rows start on a 4-pixel boundary
+    int x0 = std::max(0, static_cast<int>(std::floor(std::min({ a.x, b.x, c.x }) - 0.5f)));
+    int x1 = std::min(m_width - 1, static_cast<int>(std::ceil(std::max({ a.x, b.x, c.x }) - 0.5f)));
+    int y0 = std::max(0, static_cast<int>(std::floor(std::min({ a.y, b.y, c.y }) - 0.5f)));
+    int y1 = std::min(m_height - 1, static_cast<int>(std::ceil(std::max({ a.y, b.y, c.y }) - 0.5f)));
+    if (x0 > x1 || y0 > y1) return;
+    x0 &= ~3;
+    ++m_stats.trianglesRasterized;
+
+    // Edge functions, positive inside: each is area times one barycentric
+    float e0dx = -(c.y - b.y), e0dy = c.x - b.x;
+    float e1dx = -(a.y - c.y), e1dy = a.x - c.x;
+    float e2dx = -(b.y - a.y), e2dy = b.x - a.x;
+    float inverseArea = 1.0f / area;
+    float dzdx = ((b.z - a.z) * e1dx + (c.z - a.z) * e2dx) * inverseArea;
+    float dzdy = ((b.z - a.z) * e1dy + (c.z - a.z) * e2dy) * inverseArea;
+
+    float px = static_cast<float>(x0) + 0.5f;
+    float py = static_cast<float>(y0) + 0.5f;
+    float e0Row = e0dy * (py - b.y) + e0dx * (px - b.x);
+    float e1Row = e1dy * (py - c.y) + e1dx * (px - c.x);
+    float e2Row = e2dy * (py - a.y) + e2dx * (px - a.x);
+    float zRow = a.z + (b.z - a.z) * e1Row * inverseArea + (c.z - a.z) * e2Row * inverseArea;
+
+#if defined(ATLAS_OCCLUSION_SSE2)
+    const __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 e0Step = _mm_set1_ps(e0dx * 4.0f);
+    const __m128 e1Step = _mm_set1_ps(e1dx * 4.0f);
+    const __m128 e2Step = _mm_set1_ps(e2dx * 4.0f);
+    const __m128 zStep = _mm_set1_ps(dzdx * 4.0f);
+    const __m128 e0Lanes = _mm_mul_ps(lanes, _mm_set1_ps(e0dx));
+    const __m128 e1Lanes = _mm_mul_ps(lanes, _mm_set1_ps(e1dx));
+    const __m128 e2Lanes = _mm_mul_ps(lanes, _mm_set1_ps(e2dx));
+    const __m128 zLanes = _mm_mul_ps(lanes, _mm_set1_ps(dzdx));
+#endif
+
+    for (int y = y0; y <= y1; ++y) {
+        float* row = m_depth.data() + static_cast<size_t>(y) * static_cast<size_t>(m_width);
+#if defined(ATLAS_OCCLUSION_SSE2)
+        __m128 e0 = _mm_add_ps(_mm_set1_ps(e0Row), e0Lanes);
+        __m128 e1 = _mm_add_ps(_mm_set1_ps(e1Row), e1Lanes);
+        __m128 e2 = _mm_add_ps(_mm_set1_ps(e2Row), e2Lanes);
+        __m128 z = _mm_add_ps(_mm_set1_ps(zRow), zLanes);
+        for (int x = x0; x <= x1; x += 4) {
+            __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)),
+                                       _mm_cmpge_ps(e2, zero));
+            if (_mm_movemask_ps(inside) != 0) {
+                __m128 depth = _mm_loadu_ps(row + x);
+                __m128 nearer = _mm_min_ps(depth, z);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, depth)));
+            }
+            e0 = _mm_add_ps(e0, e0Step);
+            e1 = _mm_add_ps(e1, e1Step);
+            e2 = _mm_add_ps(e2, e2Step);
+            z = _mm_add_ps(z, zStep);
+        }
+#else
+        float e0 = e0Row, e1 = e1Row, e2 = e2Row, z = zRow;
+        for (int x = x0; x <= x1; ++x) {
+            if (e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f) row[x] = std::min(row[x], z);
+            e0 += e0dx;
+            e1 += e1dx;
+            e2 += e2dx;
+            z += dzdx;
+        }
+#endif
+        e0Row += e0dy;
+        e1Row += e1dy;
+        e2Row += e2dy;
+        zRow += dzdy;
+    }
+}
+
+void OcclusionCuller::buildPyramid() {
+    auto start = std::chrono::steady_clock::now();
+
+    // Each level halves the one below (rounding up), keeping the farthest
+    // depth; sized first so levels do not move while the next reads them
+    size_t levels = 0;
+    for (int width = m_width, height = m_height; width > 1 || height > 1; ++levels) {
+        width = (width + 1) / 2;
+        height = (height + 1) / 2;
+    }
+    m_pyramid.resize(levels);
+
+    const std::vector<float>* below = &m_depth;
+    int belowWidth = m_width;
+    int belowHeight = m_height;
+    for (Level& level : m_pyramid) {
+        level.width = (belowWidth + 1) / 2;
+        level.height = (belowHeight + 1) / 2;
+        level.depth.resize(static_cast<size_t>(level.width) * static_cast<size_t>(level.height));
+
+        for (int y = 0; y < level.height; ++y) {
+            int y0 = y * 2;
+            int y1 = std::min(y0 + 1, belowHeight - 1);
+            const float* row0 = below->data() + static_cast<size_t>(y0) * static_cast<size_t>(belowWidth);
+            const float* row1 = below->data() + static_cast<size_t>(y1) * static_cast<size_t>(belowWidth);
+            float* out = level.depth.data() + static_cast<size_t>(y) * static_cast<size_t>(level.width);
+            for (int x = 0; x < level.width; ++x) {
+                int x0 = x * 2;
+                int x1 = std::min(x0 + 1, belowWidth - 1);
+                out[x] = std::max(std::max(row0[x0], row0[x1]), std::max(row1[x0], row1[x1]));
+            }
+        }
+
+        below = &level.depth;
+        belowWidth = level.width;
+        belowHeight = level.height;
+    }
+    m_pyramidValid = true;
+    m_stats.pyramidMs += millisecondsSince(start);
+}
+
+size_t OcclusionCuller::getPyramidLevels() {
+    if (!m_pyramidValid) buildPyramid();
+    return m_pyramid.size();
+}
+
+float OcclusionCuller::farthestDepth(int x0, int y0, int x1, int y1) {
+    // Coarsest level where the rectangle spans at most 2x2 texels
+    size_t level = 0;
+    while (level < m_pyramid.size() && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1)) {
+        ++level;
+    }
+    const float* depth = level == 0 ? m_depth.data() : m_pyramid[level - 1].depth.data();
+    int width = level == 0 ? m_width : m_pyramid[level - 1].width;
+
+    float farthest = 0.0f;
+    for (int y = y0 >> level; y <= (y1 >> level); ++y) {
+        for (int x = x0 >> level; x <= (x1 >> level); ++x) {
+            farthest = std::max(farthest, depth[static_cast<size_t>(y) * static_cast<size_t>(width) + x]);
+        }
+    }
+    return farthest;
+}
+
+bool OcclusionCuller::isBoxVisible(const glm::vec3& min, const glm::vec3& max, const glm::mat4& model) {
+    if (!m_pyramidValid) buildPyramid();
+    auto start = std::chrono::steady_clock::now();
+    ++m_stats.tested;
+
+    glm::mat4 modelViewProjection = m_viewProjection * model;
+    glm::vec2 screenMin(1e30f);
+    glm::vec2 screenMax(-1e30f);
+    float nearestDepth = 1e30f;
+    for (int corner = 0; corner < 8; ++corner) {
+        glm::vec3 point((corner & 1) ? max.x : min.x, (corner & 2) ? max.y : min.y, (corner & 4) ? max.z : min.z);
+        glm::vec4 clip = modelViewProjection * glm::vec4(point, 1.0f);
+        if (nearDistance(clip) <= 0.0f || clip.w <= 1e-6f) {
+            // Reaches the camera: cannot be behind anything
+            m_stats.testMs += millisecondsSince(start);
+            return true;
+        }
+        glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        screenMin = glm::min(screenMin, glm::vec2(ndc.x, ndc.y));
+        screenMax = glm::max(screenMax, glm::vec2(ndc.x, ndc.y));
+        nearestDepth = std::min(nearestDepth, ndc.z);
+    }
+
+    bool visible = true;
+    if (screenMax.x >= -1.0f && screenMin.x <= 1.0f && screenMax.y >= -1.0f && screenMin.y <= 1.0f) {
+        // Every pixel the box touches, centre covered or not
+        auto toPixel = [](float ndc, int size) {
+            int pixel = static_cast<int>(std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(size)));
+            return std::min(std::max(pixel, 0), size - 1);
+        };
+        int x0 = toPixel(screenMin.x, m_width);
+        int x1 = toPixel(screenMax.x, m_width);
+        int y0 = toPixel(screenMin.y, m_height);
+        int y1 = toPixel(screenMax.y, m_height);
+        visible = nearestDepth <= farthestDepth(x0, y0, x1, y1);
+    }
+
+    if (!visible) ++m_stats.occluded;
+    m_stats.testMs += millisecondsSince(start);
+    return visible;
+}
+
+} // namespace atlas
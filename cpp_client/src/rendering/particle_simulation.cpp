@@ -0,0 +1,400 @@
+#include "rendering/particle_simulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define ATLAS_PARTICLE_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ATLAS_PARTICLE_SSE2 1
+#endif
+
+namespace atlas {
+
+namespace {
+
+#if defined(ATLAS_PARTICLE_AVX)
+constexpr unsigned int SIMD_WIDTH = 8;
+#elif defined(ATLAS_PARTICLE_SSE2)
+constexpr unsigned int SIMD_WIDTH = 4;
+#else
+constexpr unsigned int SIMD_WIDTH = 1;
+#endif
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint32_t packColor(const glm::vec4& color) {
+    auto channel = [](float value) {
+        return static_cast<uint32_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+    };
+    return channel(color.r) | (channel(color.g) << 8) | (channel(color.b) << 16) | (channel(color.a) << 24);
+}
+
+glm::vec4 unpackColor(uint32_t color) {
+    return glm::vec4(static_cast<float>(color & 0xffu), static_cast<float>((color >> 8) & 0xffu),
+                     static_cast<float>((color >> 16) & 0xffu), static_cast<float>(color >> 24)) / 255.0f;
+}
+
+// position += velocity * dt, life -= dt, one SIMD group at a time
+void integrateRange(float* x, float* y, float* z, const float* vx, const float* vy, const float* vz,
+                    float* life, size_t begin, size_t end, float deltaTime) {
+    size_t i = begin;
+#if defined(ATLAS_PARTICLE_AVX)
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    for (; i + 8 <= end; i += 8) {
+        _mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(_mm256_loadu_ps(vx + i), dt)));
+        _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(_mm256_loadu_ps(vy + i), dt)));
+        _mm256_storeu_ps(z + i, _mm256_add_ps(_mm256_loadu_ps(z + i), _mm256_mul_ps(_mm256_loadu_ps(vz + i), dt)));
+        _mm256_storeu_ps(life + i, _mm256_sub_ps(_mm256_loadu_ps(life + i), dt));
+    }
+#elif defined(ATLAS_PARTICLE_SSE2)
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    for (; i + 4 <= end; i += 4) {
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(vx + i), dt)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(_mm_loadu_ps(vy + i), dt)));
+        _mm_storeu_ps(z + i, _mm_add_ps(_mm_loadu_ps(z + i), _mm_mul_ps(_mm_loadu_ps(vz + i), dt)));
+        _mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), dt));
+    }
+#endif
+    for (; i < end; ++i) {
+        x[i] += vx[i] * deltaTime;
+        y[i] += vy[i] * deltaTime;
+        z[i] += vz[i] * deltaTime;
+        life[i] -= deltaTime;
+    }
+}
+
+// Particles [begin, end) of a burst into pool slots from first on; the
+// shapes are ParticleSystem's effects
+void createParticles(const ParticleBurst& burst, uint32_t begin, uint32_t end,
+                     ParticlePool& pool, size_t first) {
+    // Seeded per chunk, so the particles do not depend on which thread runs it
+    ParticleRandom random(burst.seed + 0x9e3779b97f4a7c15ULL * (begin / ParticleSimulation::SPAWN_CHUNK));
+
+    // Beam line and warp frame, shared by the whole chunk
+    glm::vec3 axis(0.0f, 0.0f, 1.0f);
+    glm::vec3 perpendicular1(1.0f, 0.0f, 0.0f);
+    glm::vec3 perpendicular2(0.0f, 1.0f, 0.0f);
+    float distance = 0.0f;
+    if (burst.type == EmitterType::WEAPON_BEAM || burst.type == EmitterType::WARP_TUNNEL) {
+        glm::vec3 line = burst.type == EmitterType::WEAPON_BEAM ? burst.direction - burst.position : burst.direction;
+        distance = glm::length(line);
+        if (distance > 0.0f) axis = line / distance;
+        perpendicular1 = glm::cross(axis, glm::vec3(0.0f, 1.0f, 0.0f));
+        if (glm::length(perpendicular1) < 0.001f) {
+            perpendicular1 = glm::cross(axis, glm::vec3(1.0f, 0.0f, 0.0f));
+        }
+        perpendicular1 = glm::normalize(perpendicular1);
+        perpendicular2 = glm::normalize(glm::cross(axis, perpendicular1));
+    }
+
+    for (uint32_t i = begin; i < end; ++i) {
+        Particle p;
+        switch (burst.type) {
+            case EmitterType::ENGINE_TRAIL:
+                p.position = burst.position + random.inSphere(0.2f);
+                p.velocity = -burst.direction * 0.3f + random.inSphere(2.0f);
+                p.color = glm::vec4(1.0f, 0.7f, 0.3f, 1.0f); // Orange glow
+                p.life = random.uniform(0.3f, 0.8f);
+                p.size = random.uniform(0.5f, 1.5f);
+                break;
+            case EmitterType::EXPLOSION: {
+                p.position = burst.position;
+                p.velocity = random.inSphere(10.0f * burst.scale);
+                // Color variation (orange to yellow)
+                float colorVariation = random.uniform(0.0f, 1.0f);
+                p.color = glm::vec4(1.0f, 0.5f + colorVariation * 0.5f, colorVariation * 0.3f, 1.0f);
+                p.life = random.uniform(0.5f, 1.5f);
+                p.size = random.uniform(1.0f, 3.0f) * burst.scale;
+                break;
+            }
+            case EmitterType::SHIELD_HIT:
+                p.position = burst.position + random.inSphere(1.0f);
+                p.velocity = random.inSphere(5.0f);
+                p.color = glm::vec4(0.3f, 0.7f, 1.0f, 1.0f); // Cyan shield color
+                p.life = random.uniform(0.2f, 0.5f);
+                p.size = random.uniform(0.5f, 2.0f);
+                break;
+            case EmitterType::WEAPON_BEAM: {
+                float t = static_cast<float>(i) / burst.count;
+                p.position = burst.position + axis * (distance * t) + random.inSphere(0.3f);
+                p.velocity = random.inSphere(1.0f);
+                p.color = burst.color;
+                p.life = 0.1f;
+                p.size = random.uniform(0.3f, 0.8f);
+                break;
+            }
+            case EmitterType::WARP_TUNNEL: {
+                // Tunnel ring: particles spawn in a cylinder around the warp line
+                float angle = random.uniform(0.0f, 2.0f * 3.14159f);
+                float radius = random.uniform(2.0f, 6.0f);
+                float along = random.uniform(-5.0f, 30.0f);
+                p.position = burst.position + axis * along +
+                             perpendicular1 * (radius * std::cos(angle)) +
+                             perpendicular2 * (radius * std::sin(angle));
+                // Streaking velocity — particles rush past the ship
+                p.velocity = -axis * random.uniform(20.0f, 60.0f);
+                // Blue-white warp colour with slight variation
+                float colVar = random.uniform(0.0f, 0.3f);
+                p.color = glm::vec4(0.4f + colVar, 0.5f + colVar, 1.0f, 0.7f);
+                p.life = random.uniform(0.3f, 0.8f);
+                p.size = random.uniform(0.8f, 2.5f);
+                break;
+            }
+            case EmitterType::DEBRIS:
+                p.position = burst.position + random.inSphere(0.5f);
+                p.velocity = random.inSphere(8.0f);
+                p.color = glm::vec4(0.3f, 0.3f, 0.3f, 1.0f); // Gray debris
+                p.life = random.uniform(1.0f, 3.0f);
+                p.size = random.uniform(0.3f, 1.0f);
+                break;
+        }
+        p.maxLife = p.life;
+        pool.set(first + (i - begin), p);
+    }
+}
+
+} // namespace
+
+glm::vec3 ParticleRandom::inSphere(float radius) {
+    float theta = uniform(0.0f, 2.0f * 3.14159f);
+    float phi = uniform(0.0f, 3.14159f);
+    float r = uniform(0.0f, radius);
+
+    return glm::vec3(
+        r * std::sin(phi) * std::cos(theta),
+        r * std::sin(phi) * std::sin(theta),
+        r * std::cos(phi)
+    );
+}
+
+ParticlePool::ParticlePool(uint64_t seed)
+    : m_random(seed)
+{
+}
+
+void ParticlePool::add(const Particle& particle) {
+    set(grow(1), particle);
+}
+
+size_t ParticlePool::grow(size_t count) {
+    size_t first = m_count;
+    if (m_count + count > m_life.size()) {
+        reserve(std::max(m_count + count, std::max<size_t>(1024, m_count * 2)));
+    }
+    m_count += count;
+    return first;
+}
+
+void ParticlePool::set(size_t index, const Particle& particle) {
+    m_x[index] = particle.position.x;
+    m_y[index] = particle.position.y;
+    m_z[index] = particle.position.z;
+    m_vx[index] = particle.velocity.x;
+    m_vy[index] = particle.velocity.y;
+    m_vz[index] = particle.velocity.z;
+    m_life[index] = particle.life;
+    m_maxLife[index] = particle.maxLife;
+    m_size[index] = particle.size;
+    m_color[index] = packColor(particle.color);
+}
+
+void ParticlePool::reserve(size_t count) {
+    if (count <= m_life.size()) return;
+    for (auto* component : { &m_x, &m_y, &m_z, &m_vx, &m_vy, &m_vz, &m_life, &m_maxLife, &m_size }) {
+        component->resize(count);
+    }
+    m_color.resize(count);
+}
+
+void ParticlePool::integrate(size_t begin, size_t end, float deltaTime) {
+    end = std::min(end, m_count);
+    if (begin >= end) return;
+    integrateRange(m_x.data(), m_y.data(), m_z.data(), m_vx.data(), m_vy.data(), m_vz.data(),
+                   m_life.data(), begin, end, deltaTime);
+}
+
+size_t ParticlePool::removeDead() {
+    size_t removed = 0;
+    size_t i = 0;
+    while (i < m_count) {
+        if (m_life[i] > 0.0f) {
+            ++i;
+            continue;
+        }
+        // The last particle takes the slot and is checked in turn
+        size_t last = --m_count;
+        m_x[i] = m_x[last];
+        m_y[i] = m_y[last];
+        m_z[i] = m_z[last];
+        m_vx[i] = m_vx[last];
+        m_vy[i] = m_vy[last];
+        m_vz[i] = m_vz[last];
+        m_life[i] = m_life[last];
+        m_maxLife[i] = m_maxLife[last];
+        m_size[i] = m_size[last];
+        m_color[i] = m_color[last];
+        ++removed;
+    }
+    return removed;
+}
+
+size_t ParticlePool::update(float deltaTime) {
+    integrate(0, m_count, deltaTime);
+    return removeDead();
+}
+
+void ParticlePool::writeVertices(size_t begin, size_t end, ParticleVertex* out) const {
+    end = std::min(end, m_count);
+    for (size_t i = begin; i < end; ++i, ++out) {
+        out->position = glm::vec3(m_x[i], m_y[i], m_z[i]);
+        uint32_t color = m_color[i];
+        out->color[0] = static_cast<uint8_t>(color);
+        out->color[1] = static_cast<uint8_t>(color >> 8);
+        out->color[2] = static_cast<uint8_t>(color >> 16);
+        out->color[3] = static_cast<uint8_t>(color >> 24);
+        out->size = m_size[i];
+    }
+}
+
+Particle ParticlePool::get(size_t index) const {
+    Particle particle;
+    particle.position = glm::vec3(m_x[index], m_y[index], m_z[index]);
+    particle.velocity = glm::vec3(m_vx[index], m_vy[index], m_vz[index]);
+    particle.color = unpackColor(m_color[index]);
+    particle.life = m_life[index];
+    particle.maxLife = m_maxLife[index];
+    particle.size = m_size[index];
+    return particle;
+}
+
+void ParticlePool::clear() {
+    m_count = 0;
+}
+
+ParticleSimulation::ParticleSimulation(size_t maxParticles, unsigned int threadCount)
+    : m_maxParticles(maxParticles)
+    , m_tasks(threadCount, MAX_THREADS)
+{
+    // Distinct streams per emitter
+    for (size_t i = 0; i < EMITTER_COUNT; ++i) {
+        m_pools[i].getRandom().seed(0x9e3779b97f4a7c15ULL * (i + 1));
+    }
+}
+
+unsigned int ParticleSimulation::getSimdWidth() {
+    return SIMD_WIDTH;
+}
+
+bool ParticleSimulation::add(EmitterType type, const Particle& particle) {
+    if (m_count >= m_maxParticles) {
+        ++m_rejected;
+        return false;
+    }
+    getEmitter(type).add(particle);
+    ++m_count;
+    return true;
+}
+
+void ParticleSimulation::spawn(ParticleBurst burst) {
+    if (burst.count == 0) return;
+    ParticleRandom& random = getEmitter(burst.type).getRandom();
+    burst.seed = (static_cast<uint64_t>(random.next()) << 32) | random.next();
+    m_pending += burst.count;
+    m_bursts.push_back(burst);
+}
+
+void ParticleSimulation::createBursts() {
+    // Slots are claimed in queue order, so the budget cuts the latest bursts
+    size_t room = m_maxParticles > m_count ? m_maxParticles - m_count : 0;
+    m_chunks.clear();
+    for (const auto& burst : m_bursts) {
+        uint32_t count = static_cast<uint32_t>(std::min<size_t>(burst.count, room));
+        m_rejected += burst.count - count;
+        room -= count;
+        if (count == 0) continue;
+
+        ParticlePool& pool = getEmitter(burst.type);
+        size_t first = pool.grow(count);
+        for (uint32_t begin = 0; begin < count; begin += SPAWN_CHUNK) {
+            uint32_t end = static_cast<uint32_t>(std::min<size_t>(count, begin + SPAWN_CHUNK));
+            m_chunks.push_back({ &burst, &pool, first + begin, begin, end });
+        }
+        m_count += count;
+        m_stats.spawned += count;
+    }
+
+    m_tasks.forEach(m_chunks.size(), [this](size_t c, unsigned int) {
+        const SpawnChunk& chunk = m_chunks[c];
+        createParticles(*chunk.burst, chunk.begin, chunk.end, *chunk.pool, chunk.first);
+    });
+
+    m_bursts.clear();
+    m_pending = 0;
+}
+
+void ParticleSimulation::update(float deltaTime) {
+    m_stats = ParticleUpdateStats();
+
+    auto start = std::chrono::steady_clock::now();
+    if (!m_bursts.empty()) createBursts();
+    m_stats.spawnMs = millisecondsSince(start);
+    m_stats.rejected = m_rejected;
+    m_rejected = 0;
+
+    // Ranges on SIMD boundaries, so only the last range of a pool has a tail
+    size_t rangeSize = (m_splitSize + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+    m_ranges.clear();
+    for (auto& pool : m_pools) {
+        for (size_t begin = 0; begin < pool.size(); begin += rangeSize) {
+            m_ranges.push_back({ &pool, begin, std::min(pool.size(), begin + rangeSize) });
+        }
+    }
+
+    // Threads take the next range until none are left
+    start = std::chrono::steady_clock::now();
+    m_stats.tasks = m_tasks.forEach(m_ranges.size(), [&](size_t r, unsigned int) {
+        m_ranges[r].pool->integrate(m_ranges[r].begin, m_ranges[r].end, deltaTime);
+    });
+    m_stats.integrateMs = millisecondsSince(start);
+
+    // Pools compact independently
+    start = std::chrono::steady_clock::now();
+    std::array<ParticlePool*, EMITTER_COUNT> busy{};
+    std::array<size_t, EMITTER_COUNT> removed{};
+    size_t busyCount = 0;
+    for (auto& pool : m_pools) {
+        if (!pool.empty()) busy[busyCount++] = &pool;
+    }
+    m_tasks.forEach(busyCount, [&](size_t i, unsigned int) { removed[i] = busy[i]->removeDead(); });
+    m_stats.compactMs = millisecondsSince(start);
+
+    m_count = 0;
+    for (size_t i = 0; i < EMITTER_COUNT; ++i) {
+        m_stats.removed += removed[i];
+        m_count += m_pools[i].size();
+    }
+    m_stats.particles = m_count;
+}
+
+size_t ParticleSimulation::writeVertices(ParticleVertex* out) const {
+    size_t written = 0;
+    for (const auto& pool : m_pools) {
+        pool.writeVertices(0, pool.size(), out + written);
+        written += pool.size();
+    }
+    return written;
+}
+
+void ParticleSimulation::clear() {
+    for (auto& pool : m_pools) pool.clear();
+    m_bursts.clear();
+    m_count = 0;
+    m_pending = 0;
+}
+
+} // namespace atlas
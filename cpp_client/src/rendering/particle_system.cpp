@@ -3,76 +3,35 @@
 #include <GL/glew.h>
 #include <iostream>
 #include <algorithm>
-#include <random>
+#include <cmath>
 
 namespace atlas {
 
-// Random number generator
-static std::random_device s_rd;
-static std::mt19937 s_gen(s_rd());
-
-// Helper function to get random float in range
-static float randomFloat(float min, float max) {
-    std::uniform_real_distribution<float> dist(min, max);
-    return dist(s_gen);
-}
-
-// Helper function to get random vector in sphere
-static glm::vec3 randomInSphere(float radius) {
-    float theta = randomFloat(0.0f, 2.0f * 3.14159f);
-    float phi = randomFloat(0.0f, 3.14159f);
-    float r = randomFloat(0.0f, radius);
-    
-    return glm::vec3(
-        r * sin(phi) * cos(theta),
-        r * sin(phi) * sin(theta),
-        r * cos(phi)
-    );
-}
-
 ParticleSystem::ParticleSystem()
-    : m_maxParticles(10000)
-    , m_vao(0)
+    : m_vao(0)
     , m_vbo(0)
+    , m_bufferStorage(false)
+    , m_streamCapacity(0)
+    , m_streamRegion(0)
+    , m_mapped(nullptr)
+    , m_fences{}
 {
-    m_particles.reserve(m_maxParticles);
 }
 
 ParticleSystem::~ParticleSystem() {
+    releaseStreamBuffer();
     if (m_vao != 0) {
         glDeleteVertexArrays(1, &m_vao);
     }
-    if (m_vbo != 0) {
-        glDeleteBuffers(1, &m_vbo);
-    }
 }
 
 bool ParticleSystem::initialize() {
     std::cout << "Initializing particle system..." << std::endl;
     
-    // Create VAO and VBO for particles
+    // Persistent mapping needs immutable buffer storage
+    m_bufferStorage = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
     glGenVertexArrays(1, &m_vao);
-    glGenBuffers(1, &m_vbo);
-    
-    glBindVertexArray(m_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    
-    // Allocate buffer for max particles
-    glBufferData(GL_ARRAY_BUFFER, m_maxParticles * sizeof(Particle), nullptr, GL_DYNAMIC_DRAW);
-    
-    // Position
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Particle), (void*)offsetof(Particle, position));
-    
-    // Color
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Particle), (void*)offsetof(Particle, color));
-    
-    // Size
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(Particle), (void*)offsetof(Particle, size));
-    
-    glBindVertexArray(0);
+    createStreamBuffer(MIN_STREAM_CAPACITY);
     
     // Load particle shaders
     m_shader = std::make_unique<Shader>();
@@ -81,30 +40,26 @@ bool ParticleSystem::initialize() {
         return false;
     }
     
-    std::cout << "Particle system initialized (max: " << m_maxParticles << ")" << std::endl;
+    std::cout << "Particle system initialized (max: " << m_simulation.getMaxParticles()
+              << ", threads: " << m_simulation.getThreadCount()
+              << ", " << (m_mapped ? "persistent" : "mapped") << " stream)" << std::endl;
     return true;
 }
 
 void ParticleSystem::update(float deltaTime) {
-    // Update all particles
-    for (auto& particle : m_particles) {
-        particle.update(deltaTime);
-        
-        // Apply gravity/forces if needed
-        // particle.velocity.z -= 9.8f * deltaTime;
-    }
-    
-    // Remove dead particles
-    removeDeadParticles();
+    m_simulation.update(deltaTime);
 }
 
 void ParticleSystem::render(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) {
-    if (m_particles.empty() || !m_shader) {
+    if (m_simulation.getParticleCount() == 0 || !m_shader) {
         return;
     }
     
-    // Update buffer with current particles
-    updateBuffers();
+    // Write the live particles into this frame's part of the stream
+    size_t first = 0;
+    if (!streamVertices(first)) {
+        return;
+    }
     
     // Enable point sprites and blending
     glEnable(GL_PROGRAM_POINT_SIZE);
@@ -119,8 +74,14 @@ void ParticleSystem::render(const glm::mat4& viewMatrix, const glm::mat4& projec
     
     // Draw particles as points
     glBindVertexArray(m_vao);
-    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(m_particles.size()));
+    glDrawArrays(GL_POINTS, static_cast<GLint>(first), static_cast<GLsizei>(m_simulation.getParticleCount()));
     glBindVertexArray(0);
+
+    // The region is reused once the GPU has drawn from it
+    if (m_mapped) {
+        m_fences[m_streamRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        m_streamRegion = (m_streamRegion + 1) % STREAM_REGIONS;
+    }
     
     // Restore state
     glDepthMask(GL_TRUE);
@@ -129,11 +90,15 @@ void ParticleSystem::render(const glm::mat4& viewMatrix, const glm::mat4& projec
 
 void ParticleSystem::emit(EmitterType type, const glm::vec3& position, const glm::vec3& direction, int count) {
     switch (type) {
-        case EmitterType::ENGINE_TRAIL:
-            for (int i = 0; i < count; ++i) {
-                createEngineTrail(position, direction);
-            }
+        case EmitterType::ENGINE_TRAIL: {
+            ParticleBurst burst;
+            burst.type = EmitterType::ENGINE_TRAIL;
+            burst.position = position;
+            burst.direction = direction;
+            burst.count = static_cast<uint32_t>(std::max(0, count));
+            m_simulation.spawn(burst);
             break;
+        }
         case EmitterType::EXPLOSION:
             createExplosion(position, 1.0f);
             break;
@@ -154,150 +119,153 @@ void ParticleSystem::emit(EmitterType type, const glm::vec3& position, const glm
 }
 
 void ParticleSystem::createEngineTrail(const glm::vec3& position, const glm::vec3& velocity) {
-    Particle p;
-    p.position = position + randomInSphere(0.2f);
-    p.velocity = -velocity * 0.3f + randomInSphere(2.0f);
-    p.color = glm::vec4(1.0f, 0.7f, 0.3f, 1.0f); // Orange glow
-    p.life = randomFloat(0.3f, 0.8f);
-    p.maxLife = p.life;
-    p.size = randomFloat(0.5f, 1.5f);
-    
-    addParticle(p);
+    ParticleBurst burst;
+    burst.type = EmitterType::ENGINE_TRAIL;
+    burst.position = position;
+    burst.direction = velocity;
+    burst.count = 1;
+    m_simulation.spawn(burst);
 }
 
 void ParticleSystem::createExplosion(const glm::vec3& position, float size) {
-    int particleCount = static_cast<int>(50 * size);
-    
-    for (int i = 0; i < particleCount; ++i) {
-        Particle p;
-        p.position = position;
-        p.velocity = randomInSphere(10.0f * size);
-        
-        // Color variation (orange to yellow)
-        float colorVariation = randomFloat(0.0f, 1.0f);
-        p.color = glm::vec4(1.0f, 0.5f + colorVariation * 0.5f, colorVariation * 0.3f, 1.0f);
-        
-        p.life = randomFloat(0.5f, 1.5f);
-        p.maxLife = p.life;
-        p.size = randomFloat(1.0f, 3.0f) * size;
-        
-        addParticle(p);
-    }
+    ParticleBurst burst;
+    burst.type = EmitterType::EXPLOSION;
+    burst.position = position;
+    burst.scale = size;
+    burst.count = static_cast<uint32_t>(std::max(0, static_cast<int>(50 * size)));
+    m_simulation.spawn(burst);
 }
 
 void ParticleSystem::createShieldHit(const glm::vec3& position) {
-    int particleCount = 20;
-    
-    for (int i = 0; i < particleCount; ++i) {
-        Particle p;
-        p.position = position + randomInSphere(1.0f);
-        p.velocity = randomInSphere(5.0f);
-        p.color = glm::vec4(0.3f, 0.7f, 1.0f, 1.0f); // Cyan shield color
-        p.life = randomFloat(0.2f, 0.5f);
-        p.maxLife = p.life;
-        p.size = randomFloat(0.5f, 2.0f);
-        
-        addParticle(p);
-    }
+    ParticleBurst burst;
+    burst.type = EmitterType::SHIELD_HIT;
+    burst.position = position;
+    burst.count = 20;
+    m_simulation.spawn(burst);
 }
 
 void ParticleSystem::createWeaponBeam(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color) {
-    int particleCount = 10;
-    glm::vec3 direction = end - start;
-    float distance = glm::length(direction);
-    direction = glm::normalize(direction);
-    
-    for (int i = 0; i < particleCount; ++i) {
-        Particle p;
-        float t = static_cast<float>(i) / particleCount;
-        p.position = start + direction * (distance * t) + randomInSphere(0.3f);
-        p.velocity = randomInSphere(1.0f);
-        p.color = color;
-        p.life = 0.1f;
-        p.maxLife = p.life;
-        p.size = randomFloat(0.3f, 0.8f);
-        
-        addParticle(p);
-    }
+    ParticleBurst burst;
+    burst.type = EmitterType::WEAPON_BEAM;
+    burst.position = start;
+    burst.direction = end;
+    burst.color = color;
+    burst.count = 10;
+    m_simulation.spawn(burst);
 }
 
 void ParticleSystem::createWarpTunnel(const glm::vec3& position, const glm::vec3& direction) {
-    glm::vec3 normalized = glm::normalize(direction);
-    
     // Spawn fewer particles per call (designed to be called every frame during warp)
-    int particleCount = 8;
-    
-    // Build a perpendicular frame from the warp direction
-    glm::vec3 perpendicular1 = glm::cross(normalized, glm::vec3(0.0f, 1.0f, 0.0f));
-    if (glm::length(perpendicular1) < 0.001f) {
-        perpendicular1 = glm::cross(normalized, glm::vec3(1.0f, 0.0f, 0.0f));
-    }
-    perpendicular1 = glm::normalize(perpendicular1);
-    glm::vec3 perpendicular2 = glm::normalize(glm::cross(normalized, perpendicular1));
-    
-    for (int i = 0; i < particleCount; ++i) {
-        Particle p;
-        // Tunnel ring: particles spawn in a cylinder around the warp line
-        float angle = randomFloat(0.0f, 2.0f * 3.14159f);
-        float radius = randomFloat(2.0f, 6.0f);
-        float distance = randomFloat(-5.0f, 30.0f);
-        
-        p.position = position + normalized * distance + 
-                     perpendicular1 * (radius * std::cos(angle)) +
-                     perpendicular2 * (radius * std::sin(angle));
-        // Streaking velocity — particles rush past the ship
-        p.velocity = -normalized * randomFloat(20.0f, 60.0f);
-        // Blue-white warp colour with slight variation
-        float colVar = randomFloat(0.0f, 0.3f);
-        p.color = glm::vec4(0.4f + colVar, 0.5f + colVar, 1.0f, 0.7f);
-        p.life = randomFloat(0.3f, 0.8f);
-        p.maxLife = p.life;
-        p.size = randomFloat(0.8f, 2.5f);
-        
-        addParticle(p);
-    }
+    ParticleBurst burst;
+    burst.type = EmitterType::WARP_TUNNEL;
+    burst.position = position;
+    burst.direction = direction;
+    burst.count = 8;
+    m_simulation.spawn(burst);
 }
 
 void ParticleSystem::createDebris(const glm::vec3& position, int count) {
-    for (int i = 0; i < count; ++i) {
-        Particle p;
-        p.position = position + randomInSphere(0.5f);
-        p.velocity = randomInSphere(8.0f);
-        p.color = glm::vec4(0.3f, 0.3f, 0.3f, 1.0f); // Gray debris
-        p.life = randomFloat(1.0f, 3.0f);
-        p.maxLife = p.life;
-        p.size = randomFloat(0.3f, 1.0f);
-        
-        addParticle(p);
-    }
+    ParticleBurst burst;
+    burst.type = EmitterType::DEBRIS;
+    burst.position = position;
+    burst.count = static_cast<uint32_t>(std::max(0, count));
+    m_simulation.spawn(burst);
 }
 
 void ParticleSystem::clear() {
-    m_particles.clear();
+    m_simulation.clear();
 }
 
-void ParticleSystem::addParticle(const Particle& particle) {
-    if (m_particles.size() < m_maxParticles) {
-        m_particles.push_back(particle);
+void ParticleSystem::createStreamBuffer(size_t capacity) {
+    releaseStreamBuffer();
+    m_streamCapacity = capacity;
+    
+    glBindVertexArray(m_vao);
+    glGenBuffers(1, &m_vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    
+    if (m_bufferStorage) {
+        // Mapped once for the buffer's lifetime; coherent, so no flushes
+        GLsizeiptr bytes = static_cast<GLsizeiptr>(STREAM_REGIONS * capacity * sizeof(ParticleVertex));
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, bytes, nullptr, flags);
+        m_mapped = static_cast<ParticleVertex*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, bytes, flags));
+        if (!m_mapped) {
+            std::cerr << "Particle stream: persistent mapping failed, mapping per frame" << std::endl;
+            m_bufferStorage = false;
+            createStreamBuffer(capacity);
+            return;
+        }
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(ParticleVertex), nullptr, GL_STREAM_DRAW);
     }
+    
+    // Position
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ParticleVertex), (void*)offsetof(ParticleVertex, position));
+    
+    // Color
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ParticleVertex), (void*)offsetof(ParticleVertex, color));
+    
+    // Size
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(ParticleVertex), (void*)offsetof(ParticleVertex, size));
+    
+    glBindVertexArray(0);
 }
 
-void ParticleSystem::removeDeadParticles() {
-    m_particles.erase(
-        std::remove_if(m_particles.begin(), m_particles.end(),
-            [](const Particle& p) { return !p.isAlive(); }),
-        m_particles.end()
-    );
+void ParticleSystem::releaseStreamBuffer() {
+    for (auto& fence : m_fences) {
+        if (fence) {
+            glDeleteSync(static_cast<GLsync>(fence));
+            fence = nullptr;
+        }
+    }
+    if (m_vbo != 0) {
+        if (m_mapped) {
+            glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &m_vbo);
+        m_vbo = 0;
+    }
+    m_mapped = nullptr;
+    m_streamRegion = 0;
 }
 
-void ParticleSystem::updateBuffers() {
-    if (m_particles.empty()) {
-        return;
+bool ParticleSystem::streamVertices(size_t& first) {
+    size_t count = m_simulation.getParticleCount();
+    if (count > m_streamCapacity) {
+        createStreamBuffer(std::max(count, m_streamCapacity * 2));
     }
     
+    if (m_mapped) {
+        // Wait until the GPU is done with this region's previous frame
+        if (m_fences[m_streamRegion]) {
+            GLsync fence = static_cast<GLsync>(m_fences[m_streamRegion]);
+            while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {
+            }
+            glDeleteSync(fence);
+            m_fences[m_streamRegion] = nullptr;
+        }
+        first = m_streamRegion * m_streamCapacity;
+        m_simulation.writeVertices(m_mapped + first);
+        return true;
+    }
+    
+    // Only the live range; invalidating lets the driver hand out fresh memory
     glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, m_particles.size() * sizeof(Particle), m_particles.data());
+    void* data = glMapBufferRange(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(count * sizeof(ParticleVertex)),
+                                  GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (data) {
+        m_simulation.writeVertices(static_cast<ParticleVertex*>(data));
+    }
+    bool written = data && glUnmapBuffer(GL_ARRAY_BUFFER) == GL_TRUE;
     glBindBuffer(GL_ARRAY_BUFFER, 0);
+    first = 0;
+    return written;
 }
 
 } // namespace atlas
@@ -1,4 +1,5 @@
 #include "rendering/procedural_ship_generator.h"
+#include "rendering/binary_model.h"
 #include "rendering/model.h"
 #include "rendering/mesh.h"
 
@@ -78,7 +79,43 @@ void ProceduralShipGenerator::setReferenceAssets(const ReferenceAssetConfig& con
 // OBJ parsing
 // ─────────────────────────────────────────────────────────────────────
 
+// Seed mesh from the converter's .amdl version of an OBJ (already welded)
+static OBJSeedMesh parseBinarySeed(const std::string& path) {
+    OBJSeedMesh seed;
+    std::shared_ptr<const BinaryModel> binary = loadBinaryModel(path);
+    if (!binary) return seed;
+
+    for (const auto& mesh : binary->meshes) {
+        unsigned int base = static_cast<unsigned int>(seed.positions.size());
+        for (size_t v = 0; v < mesh.vertexCount; ++v) {
+            Vertex vertex = unpackVertex(mesh.vertices[v]);
+            seed.positions.push_back(vertex.position);
+            seed.normals.push_back(vertex.normal);
+            seed.uvs.push_back(vertex.texCoords);
+        }
+        for (size_t i = 0; i < mesh.indexCount; ++i) {
+            unsigned int index = mesh.shortIndices ? static_cast<const uint16_t*>(mesh.indices)[i]
+                                                   : static_cast<const uint32_t*>(mesh.indices)[i];
+            if (index >= mesh.vertexCount) return OBJSeedMesh();
+            seed.indices.push_back(base + index);
+        }
+    }
+    seed.computeBounds();
+
+    std::cout << "[ProceduralShipGenerator] Mapped binary seed: " << path
+              << " (" << seed.positions.size() << " verts, "
+              << seed.indices.size() / 3 << " tris)" << std::endl;
+    return seed;
+}
+
 OBJSeedMesh ProceduralShipGenerator::parseOBJ(const std::string& path) {
+    // A converted binary next to the OBJ skips the text parse entirely
+    std::string binaryPath = findCurrentBinaryModel(path);
+    if (!binaryPath.empty()) {
+        OBJSeedMesh seed = parseBinarySeed(binaryPath);
+        if (!seed.empty()) return seed;
+    }
+
     OBJSeedMesh seed;
 
     tinyobj::attrib_t attrib;
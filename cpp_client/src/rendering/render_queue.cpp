@@ -0,0 +1,24 @@
+#include "rendering/render_queue.h"
+#include <cmath>
+
+namespace atlas {
+
+glm::mat4 composeEntityTransform(const glm::vec3& position, const glm::vec3& rotation, float scale) {
+    float sx = std::sin(rotation.x), cx = std::cos(rotation.x);
+    float sy = std::sin(rotation.y), cy = std::cos(rotation.y);
+    float sz = std::sin(rotation.z), cz = std::cos(rotation.z);
+
+    // Columns of Ry * Rx * Rz, scaled
+    glm::mat4 m;
+    m[0] = glm::vec4(cy * cz + sy * sx * sz, cx * sz, cy * sx * sz - sy * cz, 0.0f) * scale;
+    m[1] = glm::vec4(sy * sx * cz - cy * sz, cx * cz, sy * sz + cy * sx * cz, 0.0f) * scale;
+    m[2] = glm::vec4(sy * cx, -sx, cy * cx, 0.0f) * scale;
+    m[3] = glm::vec4(position, 1.0f);
+    return m;
+}
+
+float RenderQueueStats::batchingFactor() const {
+    return drawCalls ? static_cast<float>(items) / static_cast<float>(drawCalls) : 0.0f;
+}
+
+} // namespace atlas
@@ -2,6 +2,9 @@
 #include "rendering/shader.h"
 #include "rendering/camera.h"
 #include "rendering/model.h"
+#include "rendering/mesh.h"
+#include "rendering/binary_model.h"
+#include "rendering/instanced_renderer.h"
 #include "rendering/healthbar_renderer.h"
 #include "rendering/warp_effect_renderer.h"
 #include "core/entity.h"
@@ -20,6 +23,22 @@
 
 namespace atlas {
 
+namespace {
+
+// Generated ship, station and asteroid models kept resident
+constexpr size_t MODEL_CACHE_BUDGET_BYTES = 256u * 1024u * 1024u;
+
+// Main-thread time per frame for uploading finished models
+constexpr double MODEL_UPLOAD_BUDGET_MS = 2.0;
+
+// Largest visuals on screen rasterised as occluders each frame
+constexpr size_t MAX_OCCLUDERS = 8;
+
+// Smallest bounding-sphere radius over distance worth rasterising as an occluder
+constexpr float MIN_OCCLUDER_ANGULAR_SIZE = 0.05f;
+
+} // namespace
+
 Renderer::Renderer()
     : m_nebulaVAO(0)
     , m_nebulaVBO(0)
@@ -34,6 +53,10 @@ Renderer::Renderer()
     , m_sunPosition(0.0f)
     , m_sunColor(1.0f, 0.95f, 0.85f)
     , m_sunRadius(500000.0f)
+    , m_modelCache(MODEL_CACHE_BUDGET_BYTES,
+                   [](const Model& model) { return model.getMemoryBytes(); })
+    , m_diskCache(std::make_unique<MeshDiskCache>())
+    , m_meshJobs(std::make_unique<MeshJobSystem>())
     , m_initialized(false)
 {
 }
@@ -106,6 +129,14 @@ bool Renderer::initialize() {
         std::cerr << "Failed to load entity shader" << std::endl;
         return false;
     }
+
+    // Without the instanced variant entities are still batched, one draw each
+    m_entityInstancedShader = std::make_unique<Shader>();
+    if (!m_entityInstancedShader->loadFromFiles("shaders/entity_instanced.vert", "shaders/entity.frag")) {
+        std::cerr << "Warning: Failed to load instanced entity shader - entity instancing disabled" << std::endl;
+        m_entityInstancedShader.reset();
+    }
+    m_entityInstances = std::make_unique<InstancedRenderer>();
     
     // Initialize health bar renderer
     m_healthBarRenderer = std::make_unique<HealthBarRenderer>();
@@ -136,7 +167,8 @@ bool Renderer::initialize() {
 }
 
 void Renderer::beginFrame() {
-    // Nothing needed here for now
+    // Upload models finished by the mesh workers, within the frame budget
+    m_meshJobs->processCompleted(MODEL_UPLOAD_BUDGET_MS);
 }
 
 void Renderer::endFrame() {
@@ -308,8 +340,21 @@ bool Renderer::createEntityVisual(const std::shared_ptr<Entity>& entity) {
     // Create entity visual
     EntityVisual visual;
     
-    // Create ship model
-    visual.model = Model::createShipModel(entity->getShipType(), entity->getFaction());
+    // Ship model, generated once per variant and shared.  A variant not
+    // yet resident is built (or mapped from the disk cache) in the
+    // background behind a proxy.
+    const std::string& shipType = entity->getShipType();
+    const std::string& faction = entity->getFaction();
+    MeshCacheKey key = Model::shipCacheKey(shipType, faction);
+    visual.model = m_modelCache.acquireCached(key);
+    if (!visual.model) {
+        MeshCacheKey proxyKey = key;
+        proxyKey.variant = MeshCacheKey::Variant::Proxy;
+        visual.model = m_modelCache.acquire(proxyKey, [&shipType, &faction]() {
+            return std::shared_ptr<Model>(Model::createProxyModel(shipType, faction));
+        });
+        requestModel(key, entityId);
+    }
     if (!visual.model) {
         std::cerr << "Failed to create ship model for " << entity->getShipType() << std::endl;
         return false;
@@ -336,11 +381,58 @@ bool Renderer::createEntityVisual(const std::shared_ptr<Entity>& entity) {
     return true;
 }
 
+void Renderer::requestModel(const MeshCacheKey& key, const std::string& entityId) {
+    auto pending = m_pendingModels.find(key);
+    if (pending != m_pendingModels.end()) {
+        // Already generating; just wait for it too
+        pending->second.push_back(entityId);
+        return;
+    }
+    m_pendingModels[key].push_back(entityId);
+
+    auto result = std::make_shared<std::shared_ptr<const Model>>();
+    m_meshJobs->submit(key.toString(),
+        [this, key, result]() {
+            *result = m_modelCache.acquire(key, [this, &key]() {
+                return std::shared_ptr<Model>(
+                    Model::loadOrCreateShipModel(key.shipType, key.faction, m_diskCache.get()));
+            });
+        },
+        [this, key, result]() {
+            onModelReady(key, *result);
+        });
+}
+
+void Renderer::onModelReady(const MeshCacheKey& key, const std::shared_ptr<const Model>& model) {
+    auto pending = m_pendingModels.find(key);
+    if (pending == m_pendingModels.end()) return;
+    std::vector<std::string> entityIds = std::move(pending->second);
+    m_pendingModels.erase(pending);
+
+    if (!model) {
+        std::cerr << "Failed to create ship model for " << key.shipType
+                  << "; keeping proxy" << std::endl;
+        return;
+    }
+
+    model->upload();
+    for (const auto& entityId : entityIds) {
+        auto it = m_entityVisuals.find(entityId);
+        if (it != m_entityVisuals.end()) {
+            it->second.model = model;
+        }
+    }
+    // The proxy may now be unreferenced
+    m_modelCache.trim();
+}
+
 void Renderer::removeEntityVisual(const std::string& entityId) {
     auto it = m_entityVisuals.find(entityId);
     if (it != m_entityVisuals.end()) {
         std::cout << "Removing visual for entity: " << entityId << std::endl;
         m_entityVisuals.erase(it);
+        // Its model may now be unreferenced; drop it if over budget
+        m_modelCache.trim();
     }
 }
 
@@ -370,31 +462,110 @@ void Renderer::updateEntityVisuals(const std::unordered_map<std::string, std::sh
 void Renderer::renderEntities(Camera& camera) {
     if (!m_entityShader) return;
     
-    m_entityShader->use();
-    m_entityShader->setMat4("view", camera.getViewMatrix());
-    m_entityShader->setMat4("projection", camera.getProjectionMatrix());
-    
-    // Simple directional light
-    m_entityShader->setVec3("lightDir", glm::normalize(glm::vec3(-0.5f, -1.0f, -0.3f)));
-    m_entityShader->setVec3("lightColor", glm::vec3(1.0f, 0.95f, 0.9f));
-    m_entityShader->setVec3("viewPos", camera.getPosition());
-    
-    // Render each entity
+    glm::mat4 projection = camera.getProjectionMatrix();
+    glm::vec3 cameraPosition = camera.getPosition();
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    // Hulls hidden behind the stations and large rocks in front of them are
+    // dropped before they reach the queue
+    m_occluders.clear();
+    if (m_occlusionCullingEnabled) {
+        m_occlusionCuller.beginFrame(projection * camera.getViewMatrix());
+        renderOccluders(projection, cameraPosition);
+    }
+
+    // Queue every entity mesh, then draw each mesh's instances together
+    m_entityTrianglesDrawn = 0;
+    m_entityQueue.clear();
     for (const auto& [entityId, visual] : m_entityVisuals) {
         if (!visual.model) continue;
         
-        // Create model matrix
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, visual.position);
-        model = glm::rotate(model, visual.rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
-        model = glm::rotate(model, visual.rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
-        model = glm::rotate(model, visual.rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
-        model = glm::scale(model, glm::vec3(visual.scale));
+        InstanceData instance;
+        instance.transform = composeEntityTransform(visual.position, visual.rotation, visual.scale);
+
+        const MeshBounds& bounds = visual.model->getBounds();
+        if (m_occlusionCullingEnabled && bounds.valid &&
+            std::find(m_occluders.begin(), m_occluders.end(), &visual) == m_occluders.end() &&
+            !m_occlusionCuller.isBoxVisible(bounds.min, bounds.max, instance.transform)) {
+            continue;
+        }
         
-        m_entityShader->setMat4("model", model);
+        // Coarsest level whose simplification error stays under the pixel budget,
+        // measured from the nearest point of the bounding sphere
+        float radius = bounds.radius * visual.scale;
+        float distance = std::max(glm::length(visual.position - cameraPosition) - radius, 1.0f);
+        float pixelsPerUnit = pixelsPerUnitAt(distance, projection, static_cast<float>(viewport[3])) * visual.scale;
+        size_t lod = visual.model->selectLod(pixelsPerUnit, m_maxScreenSpaceError);
         
-        // Draw model
-        visual.model->draw();
+        for (const auto& mesh : visual.model->getMeshes(lod)) {
+            m_entityQueue.submit(mesh, 0, instance, distance);
+        }
+        m_entityTrianglesDrawn += visual.model->getTriangleCount(lod);
+    }
+    m_entityQueue.build();
+
+    Shader* shader = m_entityInstancedShader ? m_entityInstancedShader.get() : m_entityShader.get();
+    shader->use();
+    shader->setMat4("view", camera.getViewMatrix());
+    shader->setMat4("projection", projection);
+    
+    // Simple directional light
+    shader->setVec3("lightDir", glm::normalize(glm::vec3(-0.5f, -1.0f, -0.3f)));
+    shader->setVec3("lightColor", glm::vec3(1.0f, 0.95f, 0.9f));
+    shader->setVec3("viewPos", cameraPosition);
+    
+    const auto& instances = m_entityQueue.getInstances();
+    for (const auto& batch : m_entityQueue.getBatches()) {
+        const InstanceData* first = instances.data() + batch.firstInstance;
+        if (m_entityInstancedShader) {
+            m_entityInstances->drawInstances(batch.mesh, first, static_cast<unsigned int>(batch.instanceCount), shader);
+            continue;
+        }
+        for (size_t i = 0; i < batch.instanceCount; ++i) {
+            shader->setMat4("model", first[i].transform);
+            batch.mesh->draw();
+        }
+    }
+    m_entityInstances->trimStreams();
+}
+
+void Renderer::renderOccluders(const glm::mat4& projection, const glm::vec3& cameraPosition) {
+    // The visuals covering most of the view, largest first
+    std::vector<std::pair<float, const EntityVisual*>> candidates;
+    for (const auto& [entityId, visual] : m_entityVisuals) {
+        if (!visual.model) continue;
+        float radius = visual.model->getBounds().radius * visual.scale;
+        float distance = std::max(glm::length(visual.position - cameraPosition), 1.0f);
+        if (radius / distance >= MIN_OCCLUDER_ANGULAR_SIZE) {
+            candidates.emplace_back(radius / distance, &visual);
+        }
+    }
+    size_t count = std::min(candidates.size(), MAX_OCCLUDERS);
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    // Coarse levels are plenty at the culler's resolution: allow one of its pixels of error
+    float occlusionHeight = static_cast<float>(m_occlusionCuller.getHeight());
+    for (size_t i = 0; i < count; ++i) {
+        const EntityVisual& visual = *candidates[i].second;
+        float radius = visual.model->getBounds().radius * visual.scale;
+        float distance = std::max(glm::length(visual.position - cameraPosition) - radius, 1.0f);
+        size_t lod = visual.model->selectLod(pixelsPerUnitAt(distance, projection, occlusionHeight) * visual.scale, 1.0f);
+
+        // Packed meshes keep no float geometry on the CPU; the level picked
+        // is coarse at the culler's resolution, so expanding it is cheap
+        glm::mat4 transform = composeEntityTransform(visual.position, visual.rotation, visual.scale);
+        for (const auto& mesh : visual.model->getMeshes(lod)) {
+            if (!mesh->isPacked()) {
+                m_occlusionCuller.addOccluder(mesh->getGeometry(), transform);
+                continue;
+            }
+            MeshGeometryView geometry = unpackGeometry(mesh->getPackedGeometry(),
+                                                       m_unpackedVertices, m_unpackedIndices);
+            m_occlusionCuller.addOccluder(geometry, transform);
+        }
+        m_occluders.push_back(&visual);
     }
 }
 
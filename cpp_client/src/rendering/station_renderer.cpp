@@ -1,4 +1,8 @@
 #include "rendering/station_renderer.h"
+#include "rendering/lod_manager.h"
+#include "rendering/mesh_disk_cache.h"
+#include "rendering/model.h"
+#include <GL/glew.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/constants.hpp>
 #include <cmath>
@@ -14,23 +18,23 @@ StationRenderer::~StationRenderer() {
     clearStations();
 }
 
-bool StationRenderer::initialize() {
+bool StationRenderer::initialize(MeshDiskCache* diskCache) {
     std::cout << "[StationRenderer] Initializing..." << std::endl;
     
     // Initialize faction visual properties
     initializeFactionVisuals();
     
     // Create procedural station meshes
-    createStationMeshes();
+    createStationMeshes(diskCache);
     
-    if (m_factionStationMeshes.empty() && m_upwellMeshes.empty()) {
+    if (m_factionStationModels.empty() && m_upwellModels.empty()) {
         std::cerr << "[StationRenderer] Failed to create station meshes" << std::endl;
         return false;
     }
     
     std::cout << "[StationRenderer] Initialized with " 
-              << m_factionStationMeshes.size() << " faction stations and "
-              << m_upwellMeshes.size() << " Upwell structures" << std::endl;
+              << m_factionStationModels.size() << " faction stations and "
+              << m_upwellModels.size() << " Upwell structures" << std::endl;
     
     return true;
 }
@@ -109,20 +113,33 @@ const StationRenderer::FactionVisuals& StationRenderer::getFactionVisuals(Factio
     return defaultVisuals;
 }
 
-void StationRenderer::createStationMeshes() {
+void StationRenderer::createStationMeshes(MeshDiskCache* diskCache) {
     std::cout << "[StationRenderer] Creating procedural station meshes..." << std::endl;
     
+    // Each design is fixed, so the style name alone identifies the mesh
+    auto build = [this, diskCache](const std::string& design, const std::string& group,
+                                   std::shared_ptr<Mesh> (StationRenderer::*create)()) {
+        MeshCacheKey key;
+        key.shipType = design;
+        key.faction = group;
+        return std::shared_ptr<Model>(Model::loadOrBakeModel(diskCache, key, 0, [this, create]() {
+            auto model = std::make_unique<Model>();
+            model->addMesh((this->*create)());
+            return model;
+        }));
+    };
+    
     // Create faction stations
-    m_factionStationMeshes[FactionStyle::SOLARI] = createSolariStation();
-    m_factionStationMeshes[FactionStyle::VEYREN] = createVeyrenStation();
-    m_factionStationMeshes[FactionStyle::AURELIAN] = createAurelianStation();
-    m_factionStationMeshes[FactionStyle::KELDARI] = createKeldariStation();
+    m_factionStationModels[FactionStyle::SOLARI] = build("Solari", "station", &StationRenderer::createSolariStation);
+    m_factionStationModels[FactionStyle::VEYREN] = build("Veyren", "station", &StationRenderer::createVeyrenStation);
+    m_factionStationModels[FactionStyle::AURELIAN] = build("Aurelian", "station", &StationRenderer::createAurelianStation);
+    m_factionStationModels[FactionStyle::KELDARI] = build("Keldari", "station", &StationRenderer::createKeldariStation);
     
     // Create Upwell structures
-    m_upwellMeshes[UpwellType::ASTRAHUS] = createAstrahus();
-    m_upwellMeshes[UpwellType::FORTIZAR] = createFortizar();
-    m_upwellMeshes[UpwellType::KEEPSTAR] = createKeepstar();
-    m_upwellMeshes[UpwellType::RAITARU] = createRaitaru();
+    m_upwellModels[UpwellType::ASTRAHUS] = build("Astrahus", "upwell", &StationRenderer::createAstrahus);
+    m_upwellModels[UpwellType::FORTIZAR] = build("Fortizar", "upwell", &StationRenderer::createFortizar);
+    m_upwellModels[UpwellType::KEEPSTAR] = build("Keepstar", "upwell", &StationRenderer::createKeepstar);
+    m_upwellModels[UpwellType::RAITARU] = build("Raitaru", "upwell", &StationRenderer::createRaitaru);
     
     std::cout << "[StationRenderer] Created station meshes" << std::endl;
 }
@@ -765,26 +782,31 @@ void StationRenderer::clearStations() {
 void StationRenderer::render(Shader* shader, const Camera& camera) {
     if (!shader) return;
     
+    glm::mat4 projection = camera.getProjectionMatrix();
+    glm::vec3 cameraPosition = camera.getPosition();
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    
     shader->use();
     shader->setMat4("view", camera.getViewMatrix());
-    shader->setMat4("projection", camera.getProjectionMatrix());
+    shader->setMat4("projection", projection);
     
     for (const auto& station : m_stations) {
-        // Get the appropriate mesh
-        std::shared_ptr<Mesh> mesh;
+        // Get the appropriate model
+        std::shared_ptr<Model> stationModel;
         if (station.isUpwell) {
-            auto it = m_upwellMeshes.find(station.upwellType);
-            if (it != m_upwellMeshes.end()) {
-                mesh = it->second;
+            auto it = m_upwellModels.find(station.upwellType);
+            if (it != m_upwellModels.end()) {
+                stationModel = it->second;
             }
         } else {
-            auto it = m_factionStationMeshes.find(station.faction);
-            if (it != m_factionStationMeshes.end()) {
-                mesh = it->second;
+            auto it = m_factionStationModels.find(station.faction);
+            if (it != m_factionStationModels.end()) {
+                stationModel = it->second;
             }
         }
         
-        if (!mesh) continue;
+        if (!stationModel) continue;
         
         // Build model matrix
         glm::mat4 model = glm::mat4(1.0f);
@@ -806,8 +828,11 @@ void StationRenderer::render(Shader* shader, const Camera& camera) {
             shader->setFloat("material.emissiveIntensity", visuals.emissiveIntensity);
         }
         
-        // Render the mesh
-        mesh->draw();
+        // Coarsest level that stays within a pixel of full detail
+        float radius = stationModel->getBounds().radius * station.scale;
+        float distance = std::max(glm::length(station.position - cameraPosition) - radius, 1.0f);
+        float pixelsPerUnit = pixelsPerUnitAt(distance, projection, static_cast<float>(viewport[3])) * station.scale;
+        stationModel->draw(stationModel->selectLod(pixelsPerUnit, LODConfig().maxScreenSpaceError));
     }
 }
 
@@ -254,6 +254,17 @@ void AtlasHUD::drawShipHUD(AtlasContext& ctx, const ShipHUDData& ship) {
                               ship.warpSpeedAU);
     }
 
+    // Time dilation readout (left of the speed indicator while dilated)
+    if (ship.timeDilation < 0.995f) {
+        const Theme& t = ctx.theme();
+        char tidiBuf[32];
+        std::snprintf(tidiBuf, sizeof(tidiBuf), "TiDi %.0f%%", ship.timeDilation * 100.0f);
+        float textW = ctx.renderer().measureText(tidiBuf);
+        ctx.renderer().drawText(tidiBuf,
+            {hudCentre.x - hudRadius - 16.0f - textW, winH - 48.0f},
+            ship.timeDilation < 0.5f ? t.danger : t.warning);
+    }
+
     // Keyboard shortcuts: F1–F8 activate high-slot modules
     if (m_moduleCallback) {
         const auto& input = ctx.input();
@@ -0,0 +1,521 @@
+/**
+ * Test program for the binary model format
+ * Checks quantisation accuracy, the vertex cache / overdraw / fetch
+ * reordering, stored bounds, and that converted files map back intact and
+ * corrupt ones are rejected.  Also times parsing an OBJ with tinyobjloader
+ * (as Model::loadOBJ does) against mapping its converted .amdl.
+ * Headless: no GL context is created, only vertex and index data.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "rendering/binary_model.h"
+#include "rendering/procedural_mesh_ops.h"
+
+#define TINYOBJLOADER_IMPLEMENTATION
+#include <tiny_obj_loader.h>
+
+using namespace atlas;
+
+// Simple test framework
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string message;
+};
+
+std::vector<TestResult> g_testResults;
+
+void runTest(const std::string& name, bool result, const std::string& message = "") {
+    g_testResults.push_back({name, result, message});
+    std::cout << (result ? "[PASS] " : "[FAIL] ") << name;
+    if (!message.empty() && !result) {
+        std::cout << ": " << message;
+    }
+    std::cout << std::endl;
+}
+
+void printTestSummary() {
+    int passed = 0;
+    int failed = 0;
+
+    for (const auto& result : g_testResults) {
+        if (result.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Test Summary: " << passed << " passed, " << failed << " failed" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+}
+
+std::string testPath(const std::string& name) {
+    auto dir = std::filesystem::temp_directory_path() / "atlas_binary_model";
+    std::filesystem::create_directories(dir);
+    return (dir / name).string();
+}
+
+TriangulatedMesh makeHull(unsigned int seed) {
+    auto mults = generateRadiusMultipliers(12, 1.0f, seed);
+    TriangulatedMesh hull = buildSegmentedHull(14, 12, 1.0f, 1.0f, mults, 1.1f, 0.8f, glm::vec3(0.5f));
+    computeSmoothNormals(hull);
+    return hull;
+}
+
+// Wavy n x n vertex grid, triangles in shuffled order
+TriangulatedMesh makeGrid(int n, unsigned int seed) {
+    TriangulatedMesh grid;
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            Vertex v;
+            v.position = glm::vec3(x * 0.1f, std::sin(x * 0.3f) * std::cos(y * 0.2f), y * 0.1f);
+            v.normal = glm::normalize(glm::vec3(0.1f * std::sin(x * 0.5f), 1.0f, 0.1f * std::cos(y * 0.5f)));
+            v.texCoords = glm::vec2(x, y) / static_cast<float>(n - 1);
+            v.color = glm::vec3(0.2f, 0.6f, 0.9f);
+            grid.vertices.push_back(v);
+        }
+    }
+    std::vector<std::array<unsigned int, 3>> triangles;
+    for (int y = 0; y + 1 < n; ++y) {
+        for (int x = 0; x + 1 < n; ++x) {
+            unsigned int i = static_cast<unsigned int>(y * n + x);
+            unsigned int row = static_cast<unsigned int>(n);
+            triangles.push_back({ i, i + row, i + 1 });
+            triangles.push_back({ i + 1, i + row, i + row + 1 });
+        }
+    }
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937(seed));
+    for (const auto& t : triangles) grid.indices.insert(grid.indices.end(), t.begin(), t.end());
+    return grid;
+}
+
+MeshGeometryView viewOf(const TriangulatedMesh& mesh) {
+    MeshGeometryView view;
+    view.vertices = mesh.vertices.data();
+    view.vertexCount = mesh.vertices.size();
+    view.indices = mesh.indices.data();
+    view.indexCount = mesh.indices.size();
+    return view;
+}
+
+// Triangles by position, rotated to a canonical corner, sorted
+std::vector<std::array<float, 9>> triangleSet(const std::vector<glm::vec3>& positions,
+                                              const std::vector<uint32_t>& indices) {
+    std::vector<std::array<float, 9>> set;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        std::array<glm::vec3, 3> corners = { positions[indices[i]], positions[indices[i + 1]],
+                                             positions[indices[i + 2]] };
+        auto lexLess = [](const glm::vec3& a, const glm::vec3& b) {
+            return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+        };
+        auto first = std::min_element(corners.begin(), corners.end(), lexLess);
+        std::rotate(corners.begin(), first, corners.end());
+        std::array<float, 9> key;
+        for (int c = 0; c < 3; ++c) {
+            key[c * 3] = corners[c].x;
+            key[c * 3 + 1] = corners[c].y;
+            key[c * 3 + 2] = corners[c].z;
+        }
+        set.push_back(key);
+    }
+    std::sort(set.begin(), set.end());
+    return set;
+}
+
+std::vector<glm::vec3> unpackedPositions(const std::vector<PackedVertex>& vertices) {
+    std::vector<glm::vec3> positions;
+    for (const auto& v : vertices) positions.push_back(unpackVertex(v).position);
+    return positions;
+}
+
+// a <= b in every component
+bool allLessEqual(const glm::vec3& a, const glm::vec3& b) {
+    return a.x <= b.x && a.y <= b.y && a.z <= b.z;
+}
+
+uint32_t indexAt(const PackedMeshView& view, size_t i) {
+    return view.shortIndices ? static_cast<const uint16_t*>(view.indices)[i]
+                             : static_cast<const uint32_t*>(view.indices)[i];
+}
+
+// Test 1: half floats and packed vertices stay close to the source
+void testQuantisation() {
+    std::cout << "\n=== Test 1: Quantisation ===" << std::endl;
+
+    bool exact = true;
+    for (float value : { 0.0f, 1.0f, -2.5f, 0.5f, 1024.0f, 65504.0f, -0.000061035156f }) {
+        if (halfToFloat(floatToHalf(value)) != value) exact = false;
+    }
+    runTest("Representable values round-trip exactly", exact);
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> range(-1000.0f, 1000.0f);
+    float worstRelative = 0.0f;
+    for (int i = 0; i < 10000; ++i) {
+        float value = range(rng);
+        float error = std::abs(halfToFloat(floatToHalf(value)) - value) / std::abs(value);
+        worstRelative = std::max(worstRelative, error);
+    }
+    runTest("Relative error within half an ulp", worstRelative <= 1.0f / 2048.0f + 1e-7f,
+            std::to_string(worstRelative));
+    runTest("Overflow saturates to infinity", std::isinf(halfToFloat(floatToHalf(70000.0f))));
+    runTest("Subnormals survive", std::abs(halfToFloat(floatToHalf(1e-6f)) - 1e-6f) < 6e-8f);
+    runTest("Ties round to even", floatToHalf(1.0f + 1.0f / 2048.0f) == floatToHalf(1.0f));
+
+    TriangulatedMesh hull = makeHull(3);
+    float worstNormal = 0.0f;
+    float worstPosition = 0.0f;
+    float worstColor = 0.0f;
+    for (const auto& vertex : hull.vertices) {
+        Vertex back = unpackVertex(packVertex(vertex));
+        worstNormal = std::max(worstNormal, glm::length(back.normal - glm::normalize(vertex.normal)));
+        for (int c = 0; c < 3; ++c) {
+            float error = std::abs(back.position[c] - vertex.position[c]);
+            worstPosition = std::max(worstPosition, error / std::max(std::abs(vertex.position[c]), 1.0f / 16384.0f));
+        }
+        worstColor = std::max(worstColor, glm::length(back.color - vertex.color));
+    }
+    runTest("Packed vertex is 20 bytes", sizeof(PackedVertex) == 20);
+    runTest("Normals within 10-bit precision", worstNormal < 0.004f, std::to_string(worstNormal));
+    runTest("Positions within half precision", worstPosition <= 1.0f / 2048.0f + 1e-7f, std::to_string(worstPosition));
+    runTest("Colours within 8-bit precision", worstColor < 0.004f, std::to_string(worstColor));
+}
+
+// Test 2: reordering cuts cache misses without changing the surface
+void testOptimisation() {
+    std::cout << "\n=== Test 2: Vertex Cache, Overdraw and Fetch Order ===" << std::endl;
+
+    TriangulatedMesh grid = makeGrid(64, 9);
+    MeshConvertStats stats;
+    ConvertedMesh converted = convertMesh(viewOf(grid), &stats);
+
+    runTest("Every triangle kept", stats.triangles == grid.indices.size() / 3 && stats.degenerateTriangles == 0);
+    runTest("Shuffled order misses often", stats.acmrBefore > 1.5f, std::to_string(stats.acmrBefore));
+    runTest("Optimised order mostly hits", stats.acmrAfter < 0.8f, std::to_string(stats.acmrAfter));
+
+    std::vector<glm::vec3> sourcePositions;
+    for (const auto& v : grid.vertices) sourcePositions.push_back(unpackVertex(packVertex(v)).position);
+    std::vector<uint32_t> sourceIndices(grid.indices.begin(), grid.indices.end());
+    runTest("Same triangles, same winding",
+            triangleSet(sourcePositions, sourceIndices) == triangleSet(unpackedPositions(converted.vertices),
+                                                                       converted.indices));
+
+    uint32_t nextNew = 0;
+    bool fetchOrdered = true;
+    for (uint32_t index : converted.indices) {
+        if (index > nextNew) fetchOrdered = false;
+        if (index == nextNew) ++nextNew;
+    }
+    runTest("Vertices stored in order of first use", fetchOrdered && nextNew == converted.vertices.size());
+
+    // Overdraw ordering trades only a little cache efficiency
+    std::vector<PackedVertex> vertices;
+    for (const auto& v : grid.vertices) vertices.push_back(packVertex(v));
+    std::vector<uint32_t> indices = sourceIndices;
+    optimizeVertexCache(indices, vertices.size());
+    float cacheOnly = computeACMR(indices, vertices.size());
+    optimizeOverdraw(indices, vertices, 1.05f);
+    float withOverdraw = computeACMR(indices, vertices.size());
+    runTest("Overdraw pass keeps ACMR near the cache-optimal one", withOverdraw <= cacheOnly * 1.15f,
+            std::to_string(cacheOnly) + " -> " + std::to_string(withOverdraw));
+
+    // Unindexed input welds back down to shared vertices
+    TriangulatedMesh hull = makeHull(4);
+    TriangulatedMesh unindexed;
+    for (unsigned int index : hull.indices) {
+        unindexed.vertices.push_back(hull.vertices[index]);
+        unindexed.indices.push_back(static_cast<unsigned int>(unindexed.vertices.size() - 1));
+    }
+    MeshConvertStats weldStats;
+    convertMesh(viewOf(unindexed), &weldStats);
+    runTest("Duplicate vertices welded", weldStats.vertices <= hull.vertices.size() &&
+                                         weldStats.vertices < unindexed.vertices.size() / 2,
+            std::to_string(weldStats.vertices) + " of " + std::to_string(unindexed.vertices.size()));
+
+    std::cout << std::fixed << std::setprecision(3) << "  grid ACMR " << stats.acmrBefore << " -> "
+              << stats.acmrAfter << "; cache only " << cacheOnly << ", with overdraw " << withOverdraw << std::endl;
+}
+
+// Test 3: stored bounds enclose the drawn geometry
+void testBounds() {
+    std::cout << "\n=== Test 3: Bounds ===" << std::endl;
+
+    TriangulatedMesh hull = makeHull(5);
+    ConvertedMesh converted = convertMesh(viewOf(hull));
+    const MeshBounds& bounds = converted.bounds;
+
+    bool inBox = true;
+    bool inSphere = true;
+    for (const auto& position : unpackedPositions(converted.vertices)) {
+        if (!allLessEqual(bounds.min, position) || !allLessEqual(position, bounds.max)) inBox = false;
+        if (glm::length(position - bounds.center) > bounds.radius * 1.0001f) inSphere = false;
+    }
+    runTest("Bounds valid", bounds.valid && bounds.radius > 0.0f);
+    runTest("Every vertex inside the box", inBox);
+    runTest("Every vertex inside the sphere", inSphere);
+    runTest("Sphere no larger than the box diagonal",
+            bounds.radius <= glm::length(bounds.extents()) * 0.5f + 1e-4f);
+
+    MeshBounds far;
+    far.min = glm::vec3(10.0f);
+    far.max = glm::vec3(12.0f);
+    far.center = glm::vec3(11.0f);
+    far.radius = std::sqrt(3.0f);
+    far.valid = true;
+    MeshBounds merged = mergeMeshBounds(bounds, far);
+    runTest("Merged bounds hold both", allLessEqual(merged.min, bounds.min) &&
+                                       allLessEqual(far.max, merged.max) &&
+                                       merged.radius + 1e-4f >= glm::length(far.center - merged.center) + far.radius);
+}
+
+// Test 4: written files map back intact, with the right index width
+void testRoundTrip() {
+    std::cout << "\n=== Test 4: Round Trip ===" << std::endl;
+
+    std::vector<ConvertedMesh> meshes;
+    meshes.push_back(convertMesh(viewOf(makeHull(6))));
+    meshes.push_back(convertMesh(viewOf(makeGrid(300, 1))));   // 90000 vertices
+    std::string path = testPath("roundtrip.amdl");
+    runTest("Write succeeds", writeBinaryModel(path, meshes));
+
+    auto model = loadBinaryModel(path);
+    runTest("Load succeeds", model != nullptr);
+    if (!model) return;
+    runTest("Both meshes present", model->meshes.size() == 2 && model->meshBounds.size() == 2);
+    runTest("Mapped size is the file size", model->mappedBytes == std::filesystem::file_size(path));
+    runTest("Small mesh uses 16-bit indices", model->meshes[0].shortIndices);
+    runTest("Large mesh uses 32-bit indices", !model->meshes[1].shortIndices);
+
+    bool identical = true;
+    bool aligned = true;
+    for (size_t m = 0; m < meshes.size(); ++m) {
+        const PackedMeshView& view = model->meshes[m];
+        identical = identical && view.vertexCount == meshes[m].vertices.size() &&
+                    view.indexCount == meshes[m].indices.size() &&
+                    std::memcmp(view.vertices, meshes[m].vertices.data(),
+                                meshes[m].vertices.size() * sizeof(PackedVertex)) == 0;
+        for (size_t i = 0; identical && i < view.indexCount; ++i) {
+            if (indexAt(view, i) != meshes[m].indices[i]) identical = false;
+        }
+        aligned = aligned && reinterpret_cast<uintptr_t>(view.vertices) % 16 == 0 &&
+                  reinterpret_cast<uintptr_t>(view.indices) % 16 == 0;
+    }
+    runTest("Geometry identical", identical);
+    runTest("Blocks aligned for upload", aligned);
+
+    // Float expansion for the occlusion culler, 16- and 32-bit indices alike
+    std::vector<Vertex> unpackedVertices;
+    std::vector<unsigned int> unpackedIndices;
+    bool unpacked = true;
+    for (size_t m = 0; m < meshes.size(); ++m) {
+        const PackedMeshView& view = model->meshes[m];
+        MeshGeometryView geometry = unpackGeometry(view, unpackedVertices, unpackedIndices);
+        unpacked = unpacked && geometry.vertexCount == view.vertexCount &&
+                   geometry.indexCount == view.indexCount;
+        for (size_t i = 0; unpacked && i < geometry.indexCount; ++i) {
+            if (geometry.indices[i] != indexAt(view, i)) unpacked = false;
+        }
+        for (size_t v = 0; unpacked && v < geometry.vertexCount; v += 97) {
+            if (geometry.vertices[v].position != unpackVertex(view.vertices[v]).position) unpacked = false;
+        }
+    }
+    runTest("Unpacked geometry matches the packed mesh", unpacked);
+    runTest("Mesh bounds stored", model->meshBounds[0].valid &&
+                                  model->meshBounds[0].radius == meshes[0].bounds.radius);
+    runTest("Model bounds cover every mesh",
+            allLessEqual(model->bounds.min, glm::min(meshes[0].bounds.min, meshes[1].bounds.min)) &&
+            allLessEqual(glm::max(meshes[0].bounds.max, meshes[1].bounds.max), model->bounds.max));
+
+    // Simplified levels follow full detail and stay out of its mesh list
+    std::vector<ConvertedMesh> withLods = { convertMesh(viewOf(makeHull(6))) };
+    TriangulatedMesh coarse = makeHull(6);
+    coarse.indices.resize(coarse.indices.size() / 2);
+    for (uint32_t level = 1; level <= 2; ++level) {
+        ConvertedMesh mesh = convertMesh(viewOf(coarse));
+        mesh.lod = level;
+        mesh.lodError = 0.25f * static_cast<float>(level);
+        withLods.push_back(mesh);
+    }
+    std::string lodPath = testPath("lods.amdl");
+    writeBinaryModel(lodPath, withLods);
+    auto lodModel = loadBinaryModel(lodPath);
+    runTest("Levels load apart from full detail",
+            lodModel && lodModel->meshes.size() == 1 && lodModel->lods.size() == 2 &&
+            lodModel->lods[0].meshes.size() == 1 && lodModel->lods[1].meshes.size() == 1 &&
+            lodModel->lods[1].meshes[0].indexCount == withLods[2].indices.size());
+    runTest("Level errors kept",
+            lodModel && lodModel->lods.size() == 2 && lodModel->lods[0].error == 0.25f &&
+            lodModel->lods[1].error == 0.5f);
+
+    std::swap(withLods[1], withLods[2]);
+    writeBinaryModel(lodPath, withLods);
+    runTest("Levels out of order rejected", loadBinaryModel(lodPath) == nullptr);
+}
+
+// Test 5: damaged, foreign or outdated files are not used
+void testRejection() {
+    std::cout << "\n=== Test 5: Rejected Files ===" << std::endl;
+
+    std::vector<ConvertedMesh> meshes = { convertMesh(viewOf(makeHull(7))) };
+    std::string path = testPath("reject.amdl");
+
+    writeBinaryModel(path, meshes);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 16);
+    runTest("Truncated file rejected", loadBinaryModel(path) == nullptr);
+
+    writeBinaryModel(path, meshes);
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.write("XXXX", 4);
+    }
+    runTest("Bad magic rejected", loadBinaryModel(path) == nullptr);
+
+    writeBinaryModel(path, meshes);
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(4);
+        uint32_t futureVersion = BINARY_MODEL_VERSION + 1;
+        file.write(reinterpret_cast<const char*>(&futureVersion), sizeof(futureVersion));
+    }
+    runTest("Other format version rejected", loadBinaryModel(path) == nullptr);
+    runTest("Missing file rejected", loadBinaryModel(testPath("missing.amdl")) == nullptr);
+
+    // Only a binary at least as new as its source is used
+    std::string source = testPath("ship.obj");
+    std::ofstream(source) << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+    std::string binary = binaryModelPathFor(source);
+    runTest("Binary sits next to its source", binary == testPath("ship.amdl"));
+    writeBinaryModel(binary, meshes);
+    auto now = std::filesystem::file_time_type::clock::now();
+    std::filesystem::last_write_time(source, now - std::chrono::hours(1));
+    std::filesystem::last_write_time(binary, now);
+    runTest("Current binary found", findCurrentBinaryModel(source) == binary);
+    std::filesystem::last_write_time(source, now + std::chrono::hours(1));
+    runTest("Binary older than its source ignored", findCurrentBinaryModel(source).empty());
+    std::filesystem::remove(binary);
+    runTest("No binary, nothing found", findCurrentBinaryModel(source).empty());
+}
+
+// Test 6: mapping the binary beats parsing the OBJ
+void testParseBenchmark() {
+    std::cout << "\n=== Test 6: OBJ Parse Versus Binary Map ===" << std::endl;
+
+    // A reference-model-sized OBJ: one big grid, written unindexed per
+    // attribute the way exporters do
+    TriangulatedMesh grid = makeGrid(200, 3);
+    std::string objPath = testPath("benchmark.obj");
+    {
+        std::ofstream obj(objPath);
+        obj << std::fixed << std::setprecision(6);
+        for (const auto& v : grid.vertices) obj << "v " << v.position.x << ' ' << v.position.y << ' ' << v.position.z << '\n';
+        for (const auto& v : grid.vertices) obj << "vn " << v.normal.x << ' ' << v.normal.y << ' ' << v.normal.z << '\n';
+        for (const auto& v : grid.vertices) obj << "vt " << v.texCoords.x << ' ' << v.texCoords.y << '\n';
+        for (size_t i = 0; i < grid.indices.size(); i += 3) {
+            obj << 'f';
+            for (int k = 0; k < 3; ++k) {
+                unsigned int index = grid.indices[i + k] + 1;
+                obj << ' ' << index << '/' << index << '/' << index;
+            }
+            obj << '\n';
+        }
+    }
+
+    // The OBJ path: tinyobjloader, flattened to one vertex per corner
+    std::vector<Vertex> parsedVertices;
+    std::vector<unsigned int> parsedIndices;
+    auto start = std::chrono::steady_clock::now();
+    {
+        tinyobj::attrib_t attrib;
+        std::vector<tinyobj::shape_t> shapes;
+        std::vector<tinyobj::material_t> materials;
+        std::string warn, err;
+        tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, objPath.c_str());
+        for (const auto& shape : shapes) {
+            for (const auto& idx : shape.mesh.indices) {
+                Vertex vertex;
+                vertex.position = glm::vec3(attrib.vertices[3 * idx.vertex_index], attrib.vertices[3 * idx.vertex_index + 1],
+                                            attrib.vertices[3 * idx.vertex_index + 2]);
+                vertex.normal = glm::vec3(attrib.normals[3 * idx.normal_index], attrib.normals[3 * idx.normal_index + 1],
+                                          attrib.normals[3 * idx.normal_index + 2]);
+                vertex.texCoords = glm::vec2(attrib.texcoords[2 * idx.texcoord_index],
+                                             attrib.texcoords[2 * idx.texcoord_index + 1]);
+                vertex.color = glm::vec3(1.0f);
+                parsedVertices.push_back(vertex);
+                parsedIndices.push_back(static_cast<unsigned int>(parsedVertices.size() - 1));
+            }
+        }
+    }
+    double parseMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    runTest("OBJ parsed", parsedIndices.size() == grid.indices.size());
+
+    MeshGeometryView parsed;
+    parsed.vertices = parsedVertices.data();
+    parsed.vertexCount = parsedVertices.size();
+    parsed.indices = parsedIndices.data();
+    parsed.indexCount = parsedIndices.size();
+    MeshConvertStats stats;
+    std::string binaryPath = binaryModelPathFor(objPath);
+    writeBinaryModel(binaryPath, { convertMesh(parsed, &stats) });
+
+    // The binary path: map, and read every byte as the upload would
+    uint64_t checksum = 0;
+    start = std::chrono::steady_clock::now();
+    auto model = loadBinaryModel(binaryPath);
+    if (model) {
+        for (const auto& view : model->meshes) {
+            const auto* bytes = reinterpret_cast<const uint32_t*>(view.vertices);
+            for (size_t i = 0; i < view.vertexCount * sizeof(PackedVertex) / 4; ++i) checksum += bytes[i];
+            for (size_t i = 0; i < view.indexCount; ++i) checksum += indexAt(view, i);
+        }
+    }
+    double mapMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t objBytes = std::filesystem::file_size(objPath);
+    uint64_t binaryBytes = std::filesystem::file_size(binaryPath);
+    runTest("Binary maps back", model != nullptr && checksum > 0);
+    runTest("Binary welds the per-corner vertices", stats.vertices == grid.vertices.size(),
+            std::to_string(stats.vertices));
+    runTest("Binary smaller than the OBJ", binaryBytes * 4 < objBytes);
+    runTest("Mapping is faster than parsing", mapMs * 10.0 < parseMs,
+            std::to_string(mapMs) + " ms vs " + std::to_string(parseMs) + " ms");
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "  " << grid.indices.size() / 3 << " triangles: OBJ " << objBytes / 1024 << " KB parsed in "
+              << parseMs << " ms; .amdl " << binaryBytes / 1024 << " KB mapped in " << mapMs << " ms ("
+              << std::setprecision(1) << (mapMs > 0.0 ? parseMs / mapMs : 0.0) << "x)" << std::endl;
+}
+
+int main() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Binary Model Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testQuantisation();
+    testOptimisation();
+    testBounds();
+    testRoundTrip();
+    testRejection();
+    testParseBenchmark();
+
+    printTestSummary();
+
+    // Return 0 if all tests passed, 1 otherwise
+    for (const auto& result : g_testResults) {
+        if (!result.passed) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
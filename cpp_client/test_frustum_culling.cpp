@@ -1,12 +1,19 @@
 /**
  * Test program for Frustum Culling
- * Validates frustum extraction and entity culling
+ * Validates frustum extraction and entity culling, checks the batched
+ * culler against per-sphere tests and benchmarks it on 100k objects
  */
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 #include <iomanip>
+#include <map>
+#include <random>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include "rendering/batch_culler.h"
 #include "rendering/frustum_culler.h"
 #include "rendering/lod_manager.h"
 
@@ -272,6 +279,254 @@ void testPerformance() {
     runTest("Cull rate reasonable", cullRate > 10.0f && cullRate < 99.0f);
 }
 
+// Random spheres around a camera at the origin looking down -Z
+struct SphereSet {
+    std::vector<float> x, y, z, radius;
+
+    SphereArrays arrays() const {
+        SphereArrays spheres;
+        spheres.x = x.data();
+        spheres.y = y.data();
+        spheres.z = z.data();
+        spheres.radius = radius.data();
+        spheres.count = x.size();
+        return spheres;
+    }
+};
+
+SphereSet makeSpheres(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coordinate(-1200.0f, 1200.0f);
+    std::uniform_real_distribution<float> size(0.5f, 40.0f);
+    SphereSet set;
+    for (size_t i = 0; i < count; ++i) {
+        set.x.push_back(coordinate(rng));
+        set.y.push_back(coordinate(rng) * 0.25f);
+        set.z.push_back(coordinate(rng));
+        set.radius.push_back(size(rng));
+    }
+    return set;
+}
+
+glm::mat4 benchmarkViewProjection() {
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 2000.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return projection * view;
+}
+
+// What LODManager::update() computed per entity before batching
+LODLevel referenceLOD(const Frustum& frustum, const LODConfig& config, const glm::vec3& camera,
+                      const glm::vec3& center, float radius) {
+    if (!frustum.containsSphere(center, radius)) return LODLevel::CULLED;
+    float distance = glm::length(center - camera);
+    if (distance >= config.cullDistance) return LODLevel::CULLED;
+    if (distance >= config.lowDistance) return LODLevel::LOW;
+    if (distance >= config.mediumDistance) return LODLevel::MEDIUM;
+    return LODLevel::HIGH;
+}
+
+// Distance within rounding of a band edge, where squared and plain
+// comparisons may disagree
+bool nearBandEdge(const LODConfig& config, float distance) {
+    for (float edge : { config.mediumDistance, config.lowDistance, config.cullDistance }) {
+        if (std::abs(distance - edge) < edge * 1e-5f) return true;
+    }
+    return false;
+}
+
+bool sameResult(const BatchCullResult& a, const BatchCullResult& b) {
+    return a.visible == b.visible && a.lod == b.lod &&
+           a.frustumCulled == b.frustumCulled && a.distanceCulled == b.distanceCulled;
+}
+
+// Test 8: Batched culling against per-sphere tests
+void testBatchCulling() {
+    std::cout << "\n=== Test 8: Batched Culling (" << BatchCuller::getSimdName() << ", "
+              << BatchCuller::getSimdWidth() << " spheres per test) ===" << std::endl;
+
+    // Odd count leaves a scalar tail after the vector loop
+    SphereSet set = makeSpheres(20011, 3);
+    Frustum frustum;
+    frustum.extractFromMatrix(benchmarkViewProjection());
+    LODConfig config;
+    glm::vec3 camera(0.0f);
+
+    BatchCuller single(1);
+    BatchCullResult result;
+    single.cull(set.arrays(), &frustum, camera, config, result);
+
+    size_t mismatches = 0;
+    size_t frustumCulled = 0;
+    for (size_t i = 0; i < set.x.size(); ++i) {
+        glm::vec3 center(set.x[i], set.y[i], set.z[i]);
+        LODLevel expected = referenceLOD(frustum, config, camera, center, set.radius[i]);
+        if (!frustum.containsSphere(center, set.radius[i])) ++frustumCulled;
+        if (static_cast<LODLevel>(result.lod[i]) != expected &&
+            !nearBandEdge(config, glm::length(center - camera))) {
+            ++mismatches;
+        }
+    }
+    runTest("Batched LOD levels match per-sphere tests", mismatches == 0,
+            std::to_string(mismatches) + " mismatches");
+    runTest("Frustum-culled count matches", result.frustumCulled == frustumCulled);
+
+    bool listMatches = std::is_sorted(result.visible.begin(), result.visible.end());
+    size_t listed = 0;
+    for (size_t i = 0; i < result.lod.size(); ++i) {
+        bool visible = result.lod[i] != static_cast<uint8_t>(LODLevel::CULLED);
+        if (visible) {
+            if (listed >= result.visible.size() || result.visible[listed] != i) listMatches = false;
+            ++listed;
+        }
+    }
+    runTest("Visible list is ascending and complete", listMatches && listed == result.visible.size());
+    runTest("Counts add up", result.visible.size() + result.frustumCulled + result.distanceCulled == set.x.size());
+    std::cout << "  " << set.x.size() << " spheres: " << result.visible.size() << " visible, "
+              << result.frustumCulled << " outside frustum, " << result.distanceCulled << " beyond cull distance"
+              << std::endl;
+
+    // Splitting across threads must not change anything
+    BatchCuller threaded(4);
+    threaded.setSplitSize(1000);
+    BatchCullResult split;
+    threaded.cull(set.arrays(), &frustum, camera, config, split);
+    runTest("Threaded pass matches single-threaded pass", sameResult(result, split));
+    threaded.cull(set.arrays(), &frustum, camera, config, split);
+    runTest("Repeated threaded pass is stable", sameResult(result, split));
+
+    // Distance only
+    BatchCullResult distanceOnly;
+    single.cull(set.arrays(), nullptr, camera, config, distanceOnly);
+    runTest("Without a frustum nothing is frustum-culled", distanceOnly.frustumCulled == 0 &&
+            distanceOnly.visible.size() + distanceOnly.distanceCulled == set.x.size());
+
+    // Empty and tiny sets
+    SphereSet tiny = makeSpheres(3, 5);
+    BatchCullResult tinyResult;
+    threaded.cull(tiny.arrays(), &frustum, camera, config, tinyResult);
+    BatchCullResult none;
+    threaded.cull(SphereArrays(), &frustum, camera, config, none);
+    runTest("Tiny and empty sets", tinyResult.lod.size() == 3 && none.lod.empty() && none.visible.empty());
+}
+
+// Test 9: LODManager bookkeeping on dense storage
+void testLODManagerSlots() {
+    std::cout << "\n=== Test 9: LODManager Entity Slots ===" << std::endl;
+
+    LODManager lodManager;
+    for (unsigned int id = 1; id <= 6; ++id) {
+        lodManager.registerEntity(id, glm::vec3(0.0f, 0.0f, -10.0f * static_cast<float>(id)), 1.0f);
+    }
+    lodManager.registerEntity(100, glm::vec3(0.0f, 0.0f, -5000.0f), 1.0f);
+
+    glm::mat4 viewProj = benchmarkViewProjection();
+    lodManager.update(glm::vec3(0.0f), 0.016f, &viewProj);
+    runTest("Entity beyond cull distance culled", !lodManager.isEntityVisible(100));
+
+    // Removing from the middle moves the last entity into the gap
+    lodManager.unregisterEntity(3);
+    lodManager.unregisterEntity(42);
+    runTest("Unregistered entity gone", !lodManager.isEntityVisible(3) &&
+            lodManager.getEntityLOD(3) == LODLevel::CULLED);
+    runTest("Moved entity keeps its state", !lodManager.isEntityVisible(100) && lodManager.isEntityVisible(6));
+
+    lodManager.updateEntityPosition(100, glm::vec3(0.0f, 0.0f, -20.0f));
+    lodManager.update(glm::vec3(0.0f), 0.016f, &viewProj);
+    std::vector<unsigned int> visible = lodManager.getVisibleEntities();
+    std::sort(visible.begin(), visible.end());
+    runTest("Visible list after move", visible == std::vector<unsigned int>({ 1, 2, 4, 5, 6, 100 }));
+    runTest("Stats follow slots", lodManager.getStats().totalEntities == 6 && lodManager.getStats().visible == 6);
+
+    lodManager.clear();
+    runTest("Clear empties manager", lodManager.getStats().totalEntities == 0 &&
+            lodManager.getVisibleEntities().empty());
+}
+
+// Test 10: 100k object benchmark
+void testBatchBenchmark() {
+    std::cout << "\n=== Test 10: 100k Object Benchmark ===" << std::endl;
+
+    const size_t NUM_OBJECTS = 100000;
+    const int FRAMES = 20;
+    SphereSet set = makeSpheres(NUM_OBJECTS, 11);
+    glm::mat4 viewProj = benchmarkViewProjection();
+    glm::vec3 camera(0.0f);
+    LODConfig config;
+
+    // Per-object path: map walk with one sphere test per entity
+    struct MapEntity {
+        glm::vec3 position;
+        float boundingRadius;
+        LODLevel lod;
+        bool visible;
+    };
+    std::map<unsigned int, MapEntity> entities;
+    for (size_t i = 0; i < NUM_OBJECTS; ++i) {
+        entities[static_cast<unsigned int>(i)] = { glm::vec3(set.x[i], set.y[i], set.z[i]), set.radius[i],
+                                                   LODLevel::HIGH, true };
+    }
+    FrustumCuller culler;
+    culler.update(viewProj);
+    size_t mapVisible = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        mapVisible = 0;
+        for (auto& pair : entities) {
+            MapEntity& entity = pair.second;
+            float distance = glm::length(entity.position - camera);
+            LODLevel lod = distance >= config.cullDistance ? LODLevel::CULLED
+                         : distance >= config.lowDistance ? LODLevel::LOW
+                         : distance >= config.mediumDistance ? LODLevel::MEDIUM : LODLevel::HIGH;
+            if (!culler.isVisible(entity.position, entity.boundingRadius)) lod = LODLevel::CULLED;
+            entity.lod = lod;
+            entity.visible = lod != LODLevel::CULLED;
+            if (entity.visible) ++mapVisible;
+        }
+    }
+    double mapMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / FRAMES;
+
+    Frustum frustum;
+    frustum.extractFromMatrix(viewProj);
+    auto timePass = [&](BatchCuller& batch, BatchCullResult& result) {
+        batch.cull(set.arrays(), &frustum, camera, config, result);    // warm up
+        auto passStart = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            batch.cull(set.arrays(), &frustum, camera, config, result);
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - passStart).count() / FRAMES;
+    };
+
+    BatchCuller single(1);
+    BatchCullResult singleResult;
+    double singleMs = timePass(single, singleResult);
+
+    BatchCuller threaded;
+    BatchCullResult threadedResult;
+    double threadedMs = timePass(threaded, threadedResult);
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "  Objects: " << NUM_OBJECTS << ", visible: " << singleResult.visible.size() << std::endl
+              << "  Map walk, per-sphere tests:  " << mapMs << " ms" << std::endl
+              << "  Batched, 1 thread (" << BatchCuller::getSimdName() << "): " << singleMs << " ms ("
+              << std::setprecision(1) << (singleMs > 0.0 ? mapMs / singleMs : 0.0) << "x)" << std::endl
+              << std::setprecision(3)
+              << "  Batched, " << threaded.getThreadCount() << " threads:        " << threadedMs << " ms ("
+              << std::setprecision(1) << (threadedMs > 0.0 ? mapMs / threadedMs : 0.0) << "x)" << std::endl;
+
+    // Squared distances may flip a sphere sitting exactly on a band edge
+    long visibleDifference = static_cast<long>(singleResult.visible.size()) - static_cast<long>(mapVisible);
+    runTest("Batched visible count matches map walk", std::abs(visibleDifference) <= 2);
+    runTest("Threaded benchmark pass matches", sameResult(singleResult, threadedResult));
+
+    // LODManager drives the same pass
+    LODManager lodManager;
+    for (size_t i = 0; i < NUM_OBJECTS; ++i) {
+        lodManager.registerEntity(static_cast<unsigned int>(i), glm::vec3(set.x[i], set.y[i], set.z[i]), set.radius[i]);
+    }
+    lodManager.update(camera, 0.016f, &viewProj);
+    runTest("LODManager visible list matches", lodManager.getVisibleEntities().size() == singleResult.visible.size());
+}
+
 int main() {
     std::cout << "\n========================================" << std::endl;
     std::cout << "Frustum Culling Test Suite" << std::endl;
@@ -284,6 +539,9 @@ int main() {
     testFrustumCuller();
     testLODManagerIntegration();
     testPerformance();
+    testBatchCulling();
+    testLODManagerSlots();
+    testBatchBenchmark();
     
     printTestSummary();
     
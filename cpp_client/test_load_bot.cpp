@@ -0,0 +1,255 @@
+/**
+ * Test program for the load bot's building blocks
+ * Validates percentile statistics, JSON stream splitting and metrics
+ * export parsing, then drives a small swarm against a local stand-in
+ * server to check that server tick stats are read from its export file.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "network/load_bot.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace atlas;
+
+// Simple test framework
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string message;
+};
+
+std::vector<TestResult> g_testResults;
+
+void runTest(const std::string& name, bool result, const std::string& message = "") {
+    g_testResults.push_back({name, result, message});
+    std::cout << (result ? "[PASS] " : "[FAIL] ") << name;
+    if (!message.empty() && !result) {
+        std::cout << ": " << message;
+    }
+    std::cout << std::endl;
+}
+
+void printTestSummary() {
+    int passed = 0;
+    int failed = 0;
+
+    for (const auto& result : g_testResults) {
+        if (result.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Test Summary: " << passed << " passed, " << failed << " failed" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+}
+
+bool near(double a, double b) {
+    return std::fabs(a - b) < 1e-9;
+}
+
+// Test 1: SampleStats
+void testSampleStats() {
+    std::cout << "\n=== Test 1: SampleStats ===" << std::endl;
+
+    SampleStats empty;
+    runTest("Empty stats report zero", empty.count() == 0 && empty.mean() == 0.0 &&
+            empty.max() == 0.0 && empty.percentile(50.0) == 0.0);
+
+    SampleStats stats;
+    for (int v = 10; v >= 1; --v) stats.add(static_cast<double>(v));
+    runTest("Mean and max", near(stats.mean(), 5.5) && near(stats.max(), 10.0));
+    runTest("Nearest-rank percentiles",
+            near(stats.percentile(50.0), 5.0) && near(stats.percentile(90.0), 9.0) &&
+            near(stats.percentile(91.0), 10.0) && near(stats.percentile(100.0), 10.0));
+    runTest("Percentile clamps its argument",
+            near(stats.percentile(-5.0), 1.0) && near(stats.percentile(250.0), 10.0));
+
+    // A query sorts; a later add must invalidate that order
+    stats.add(0.5);
+    runTest("Add after a query re-sorts", near(stats.percentile(0.0), 0.5) && stats.count() == 11);
+
+    SampleStats one;
+    one.add(2.0);
+    runTest("Summary format", one.summary() ==
+            "n=1 mean=2.00 p50=2.00 p90=2.00 p99=2.00 max=2.00", one.summary());
+}
+
+// Test 2: JsonStreamSplitter
+void testSplitter() {
+    std::cout << "\n=== Test 2: JSON Stream Splitter ===" << std::endl;
+
+    const std::string first = "{\"type\":\"state_update\",\"data\":{\"x\":1}}";
+    const std::string second = "{\"type\":\"chat\",\"message\":\"a } and { in \\\"quotes\\\" \\\\\"}";
+    const std::string third = "{\"type\":\"ping\",\"nonce\":7}";
+    const std::string stream = first + second + "\n" + third;
+
+    JsonStreamSplitter whole;
+    std::vector<std::string> messages;
+    whole.feed(stream.data(), stream.size(), messages);
+    runTest("Back-to-back messages split", messages.size() == 3 && messages[0] == first &&
+            messages[1] == second && messages[2] == third);
+    runTest("Nothing buffered after complete messages", whole.buffered() == 0);
+
+    // Every possible cut point, one byte at a time
+    bool intact = true;
+    for (size_t cut = 1; cut < stream.size(); ++cut) {
+        JsonStreamSplitter splitter;
+        std::vector<std::string> out;
+        splitter.feed(stream.data(), cut, out);
+        splitter.feed(stream.data() + cut, stream.size() - cut, out);
+        intact = intact && out.size() == 3 && out[1] == second;
+    }
+    runTest("Messages intact at every split point", intact);
+
+    JsonStreamSplitter bytewise;
+    std::vector<std::string> out;
+    for (char c : stream) bytewise.feed(&c, 1, out);
+    runTest("Messages intact fed a byte at a time", out.size() == 3 && out[2] == third);
+
+    JsonStreamSplitter partial;
+    out.clear();
+    partial.feed(first.data(), first.size() - 1, out);
+    runTest("Unfinished message is held", out.empty() && partial.buffered() == first.size() - 1);
+    partial.feed("}", 1, out);
+    runTest("Held message completes", out.size() == 1 && out[0] == first && partial.buffered() == 0);
+}
+
+// Test 3: metrics export parsing
+void testMetricsText() {
+    std::cout << "\n=== Test 3: Metrics Export Parsing ===" << std::endl;
+
+    const std::string text =
+        "# HELP atlas_uptime_seconds Seconds since the server started\n"
+        "# TYPE atlas_uptime_seconds gauge\n"
+        "atlas_uptime_seconds 42.5\n"
+        "atlas_ticks_total 1275\n"
+        "atlas_tick_duration_avg_ms 3.25\n"
+        "atlas_client_rtt_ms{player=\"a\"} 12\n"
+        "garbage\n";
+    std::map<std::string, double> metrics;
+    runTest("Samples found", parseMetricsText(text, metrics));
+    runTest("Bare samples parsed", near(metrics["atlas_uptime_seconds"], 42.5) &&
+            near(metrics["atlas_ticks_total"], 1275.0) &&
+            near(metrics["atlas_tick_duration_avg_ms"], 3.25));
+    runTest("Labelled and malformed lines skipped", metrics.size() == 3);
+
+    std::map<std::string, double> none;
+    runTest("Comment-only text has no samples", !parseMetricsText("# HELP x\n", none) && none.empty());
+}
+
+// Test 4: swarm against a stand-in server that exports tick metrics
+void writeMetrics(const std::string& path, double uptime, double ticks, double avgMs) {
+    std::ofstream out(path + ".tmp");
+    out << "atlas_uptime_seconds " << uptime << "\n"
+        << "atlas_ticks_total " << ticks << "\n"
+        << "atlas_tick_duration_avg_ms " << avgMs << "\n"
+        << "atlas_tick_duration_max_ms " << avgMs * 2.0 << "\n";
+    out.close();
+    std::rename((path + ".tmp").c_str(), path.c_str());
+}
+
+void testSwarmReadsServerMetrics() {
+    std::cout << "\n=== Test 4: Swarm Reads Server Tick Metrics ===" << std::endl;
+
+    int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    bool listening = ::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 &&
+                     ::listen(listener, 16) == 0;
+    socklen_t length = sizeof(addr);
+    getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &length);
+    runTest("Stand-in server listening", listening);
+    if (!listening) {
+        ::close(listener);
+        return;
+    }
+
+    const std::string path = "/tmp/atlas_loadbot_test_metrics.prom";
+    writeMetrics(path, 10.0, 300.0, 4.0);
+
+    const int bots = 4;
+    std::atomic<bool> stop{false};
+    std::vector<int> clients;
+    std::thread server([&]() {
+        // Answer each connect; the server sends without newlines
+        for (int i = 0; i < bots; ++i) {
+            int fd = ::accept(listener, nullptr, nullptr);
+            if (fd < 0) return;
+            clients.push_back(fd);
+            char buffer[1024];
+            ::recv(fd, buffer, sizeof(buffer), 0);
+            std::string ack = "{\"type\":\"connect_ack\",\"data\":{\"player_entity_id\":\"player_" +
+                              std::to_string(i) + "\"}}";
+            ::send(fd, ack.data(), ack.size(), MSG_NOSIGNAL);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1200));
+        writeMetrics(path, 11.5, 345.0, 6.0);
+        while (!stop.load()) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    });
+
+    LoadBotConfig config;
+    config.port = ntohs(addr.sin_port);
+    config.botCount = bots;
+    config.duration = 2.6f;
+    config.undockPerMinute = config.warpPerMinute = config.orbitPerMinute = 0.0f;
+    config.lockAndShootPerMinute = config.marketPerMinute = config.chatPerMinute = 0.0f;
+    config.serverMetricsPath = path;
+
+    LoadBotSwarm swarm(config);
+    bool ran = swarm.run();
+    stop.store(true);
+    server.join();
+    for (int fd : clients) ::close(fd);
+    ::close(listener);
+    std::remove(path.c_str());
+
+    std::string report = swarm.report();
+    runTest("Swarm ran", ran);
+    runTest("Every bot connected", swarm.getConnectedCount() == bots,
+            std::to_string(swarm.getConnectedCount()) + " connected");
+    runTest("One sample per export", swarm.getServerTickAvg().count() == 2,
+            std::to_string(swarm.getServerTickAvg().count()) + " samples");
+    runTest("Server tick cost taken from the export", near(swarm.getServerTickAvg().max(), 6.0));
+    runTest("Tick rate derived between exports",
+            report.find("ticks/s        n=1 mean=30.00") != std::string::npos, report);
+    runTest("Client-side figure labelled an estimate",
+            report.find("client-side estimate") != std::string::npos);
+}
+
+int main() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Load Bot Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testSampleStats();
+    testSplitter();
+    testMetricsText();
+    testSwarmReadsServerMetrics();
+
+    printTestSummary();
+
+    // Return 0 if all tests passed, 1 otherwise
+    for (const auto& result : g_testResults) {
+        if (!result.passed) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,234 @@
+/**
+ * Test program for the shared mesh cache
+ * Validates generate-once sharing, hit/miss counters and budget eviction
+ * without a GPU: the cached type is plain geometry, not a Model.
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "rendering/mesh_cache.h"
+
+using namespace atlas;
+
+// Simple test framework
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string message;
+};
+
+std::vector<TestResult> g_testResults;
+
+void runTest(const std::string& name, bool result, const std::string& message = "") {
+    g_testResults.push_back({name, result, message});
+    std::cout << (result ? "[PASS] " : "[FAIL] ") << name;
+    if (!message.empty() && !result) {
+        std::cout << ": " << message;
+    }
+    std::cout << std::endl;
+}
+
+void printTestSummary() {
+    int passed = 0;
+    int failed = 0;
+
+    for (const auto& result : g_testResults) {
+        if (result.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Test Summary: " << passed << " passed, " << failed << " failed" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+}
+
+// Stand-in for generated geometry
+struct FakeMesh {
+    std::vector<float> vertices;
+};
+
+using FakeMeshCache = MeshCache<FakeMesh>;
+
+size_t fakeMeshBytes(const FakeMesh& mesh) {
+    return mesh.vertices.size() * sizeof(float);
+}
+
+MeshCacheKey makeKey(const std::string& type, const std::string& faction) {
+    MeshCacheKey key;
+    key.shipType = type;
+    key.faction = faction;
+    key.seed = static_cast<uint32_t>(std::hash<std::string>{}(type + "_" + faction));
+    return key;
+}
+
+// Test 1: 1000 spawns generate each variant exactly once
+void testSpawnSharing() {
+    std::cout << "\n=== Test 1: 1000 Spawns Share Variants ===" << std::endl;
+
+    const std::vector<std::string> types = {
+        "Fang", "Ironscale", "Strix", "Rifter", "Thorax", "Hurricane", "Raven", "Venture"
+    };
+    const std::vector<std::string> factions = { "Veyren", "Aurelian", "Keldari", "Solari" };
+
+    FakeMeshCache cache(64u * 1024u * 1024u, fakeMeshBytes);
+    int generations = 0;
+    std::set<std::string> uniqueVariants;
+    std::vector<std::shared_ptr<const FakeMesh>> visuals;
+    std::vector<MeshCacheKey> keys;
+
+    std::mt19937 rng(42);
+    for (int i = 0; i < 1000; ++i) {
+        // Skewed toward a few hulls, like a busy grid
+        const std::string& type = types[std::min<size_t>(rng() % 12, types.size() - 1)];
+        const std::string& faction = factions[rng() % factions.size()];
+        MeshCacheKey key = makeKey(type, faction);
+        uniqueVariants.insert(key.toString());
+        keys.push_back(key);
+
+        visuals.push_back(cache.acquire(key, [&]() {
+            ++generations;
+            auto mesh = std::make_shared<FakeMesh>();
+            mesh->vertices.assign(3000, 1.0f);
+            return mesh;
+        }));
+    }
+
+    MeshCacheStats stats = cache.getStats();
+    runTest("Every spawn got a mesh", visuals.size() == 1000 && visuals.back() != nullptr);
+    runTest("One generation per unique variant",
+            generations == static_cast<int>(uniqueVariants.size()),
+            std::to_string(generations) + " generations for " +
+            std::to_string(uniqueVariants.size()) + " variants");
+    runTest("Misses equal generations", stats.misses == static_cast<uint64_t>(generations));
+    runTest("Hits cover the remaining spawns", stats.hits + stats.misses == 1000);
+    runTest("Entries match variants", stats.entries == uniqueVariants.size());
+    runTest("Resident bytes counted",
+            stats.residentBytes == uniqueVariants.size() * 3000 * sizeof(float));
+
+    bool shared = true;
+    for (size_t i = 0; i < visuals.size(); ++i) {
+        if (cache.find(keys[i]) != visuals[i]) shared = false;
+    }
+    runTest("Equal keys share one object", shared);
+
+    std::cout << "  " << generations << " generations for 1000 spawns, hit rate "
+              << stats.hitRate() * 100.0 << "%" << std::endl;
+}
+
+// Test 2: key fields all distinguish variants
+void testKeyIdentity() {
+    std::cout << "\n=== Test 2: Key Identity ===" << std::endl;
+
+    FakeMeshCache cache(1024u * 1024u, fakeMeshBytes);
+    int generations = 0;
+    auto factory = [&generations]() {
+        ++generations;
+        return std::make_shared<FakeMesh>();
+    };
+
+    MeshCacheKey base = makeKey("Rifter", "Keldari");
+    MeshCacheKey proxy = base;
+    proxy.variant = MeshCacheKey::Variant::Proxy;
+    MeshCacheKey otherSeed = base;
+    otherSeed.seed += 1;
+    MeshCacheKey otherFaction = makeKey("Rifter", "Veyren");
+
+    auto a = cache.acquire(base, factory);
+    auto b = cache.acquire(proxy, factory);
+    auto c = cache.acquire(otherSeed, factory);
+    auto d = cache.acquire(otherFaction, factory);
+    auto e = cache.acquire(base, factory);
+
+    runTest("Proxy, seed and faction make distinct variants", generations == 4);
+    runTest("Repeated key returns the same mesh", a == e && a != b && a != c && a != d);
+    runTest("Hash agrees for equal keys",
+            MeshCacheKeyHash{}(base) == MeshCacheKeyHash{}(makeKey("Rifter", "Keldari")));
+    runTest("Proxy has its own name", proxy.toString() == base.toString() + "/proxy");
+}
+
+// Test 3: eviction respects the budget and never drops meshes in use
+void testBudgetEviction() {
+    std::cout << "\n=== Test 3: Budget Eviction ===" << std::endl;
+
+    const size_t meshBytes = 1000 * sizeof(float);
+    FakeMeshCache cache(meshBytes * 3, fakeMeshBytes);
+    auto factory = []() {
+        auto mesh = std::make_shared<FakeMesh>();
+        mesh->vertices.assign(1000, 0.0f);
+        return mesh;
+    };
+
+    std::vector<std::shared_ptr<const FakeMesh>> held;
+    for (int i = 0; i < 5; ++i) {
+        held.push_back(cache.acquire(makeKey("Hull" + std::to_string(i), "Solari"), factory));
+    }
+    MeshCacheStats stats = cache.getStats();
+    runTest("Meshes in use are not evicted", stats.entries == 5 && stats.evictions == 0);
+    runTest("Over budget while everything is in use", stats.residentBytes > stats.budgetBytes);
+
+    // Release the two oldest; trimming drops exactly those
+    held[0].reset();
+    held[1].reset();
+    cache.trim();
+    stats = cache.getStats();
+    runTest("Released meshes evicted to meet budget", stats.evictions == 2 && stats.entries == 3);
+    runTest("Resident bytes within budget", stats.residentBytes <= stats.budgetBytes);
+    runTest("Oldest released variant is gone", cache.find(makeKey("Hull0", "Solari")) == nullptr);
+    runTest("Held variant survives", cache.find(makeKey("Hull4", "Solari")) == held[4]);
+
+    // Touching a variant protects it from LRU eviction
+    held.clear();
+    cache.acquire(makeKey("Hull2", "Solari"), factory);
+    cache.setBudget(meshBytes);
+    runTest("Most recently used variant kept", cache.find(makeKey("Hull2", "Solari")) != nullptr);
+    runTest("Budget shrink evicts least recently used",
+            cache.find(makeKey("Hull3", "Solari")) == nullptr &&
+            cache.find(makeKey("Hull4", "Solari")) == nullptr);
+
+    cache.releaseUnused();
+    runTest("releaseUnused empties an idle cache", cache.getStats().entries == 0);
+}
+
+// Test 4: a failed generation is not cached
+void testFailedGeneration() {
+    std::cout << "\n=== Test 4: Failed Generation ===" << std::endl;
+
+    FakeMeshCache cache(1024u, fakeMeshBytes);
+    int attempts = 0;
+    auto failing = [&attempts]() -> std::shared_ptr<FakeMesh> {
+        ++attempts;
+        return nullptr;
+    };
+
+    auto first = cache.acquire(makeKey("Unknown", "None"), failing);
+    auto second = cache.acquire(makeKey("Unknown", "None"), failing);
+    runTest("Failed factory returns null", first == nullptr && second == nullptr);
+    runTest("Failure retried on next acquire", attempts == 2);
+    runTest("Nothing cached", cache.getStats().entries == 0);
+}
+
+int main() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Mesh Cache Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testSpawnSharing();
+    testKeyIdentity();
+    testBudgetEviction();
+    testFailedGeneration();
+
+    printTestSummary();
+
+    // Return 0 if all tests passed, 1 otherwise
+    for (const auto& result : g_testResults) {
+        if (!result.passed) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
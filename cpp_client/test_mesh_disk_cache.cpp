@@ -0,0 +1,297 @@
+/**
+ * Test program for the on-disk mesh cache
+ * Bakes CPU-side procedural hulls, maps them back and checks that stale,
+ * truncated or foreign files are rejected.  Also times a cold start
+ * (generate every hull) against a warm one (map the baked files).
+ * Headless: no GL context is created, only vertex and index data.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "rendering/mesh_disk_cache.h"
+#include "rendering/procedural_mesh_ops.h"
+
+using namespace atlas;
+
+// Simple test framework
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string message;
+};
+
+std::vector<TestResult> g_testResults;
+
+void runTest(const std::string& name, bool result, const std::string& message = "") {
+    g_testResults.push_back({name, result, message});
+    std::cout << (result ? "[PASS] " : "[FAIL] ") << name;
+    if (!message.empty() && !result) {
+        std::cout << ": " << message;
+    }
+    std::cout << std::endl;
+}
+
+void printTestSummary() {
+    int passed = 0;
+    int failed = 0;
+
+    for (const auto& result : g_testResults) {
+        if (result.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Test Summary: " << passed << " passed, " << failed << " failed" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+}
+
+std::string testDirectory(const std::string& name) {
+    auto dir = std::filesystem::temp_directory_path() / ("atlas_mesh_disk_cache_" + name);
+    std::filesystem::remove_all(dir);
+    return dir.string();
+}
+
+MeshCacheKey makeKey(const std::string& type, uint32_t seed) {
+    MeshCacheKey key;
+    key.shipType = type;
+    key.faction = "Solari";
+    key.seed = seed;
+    return key;
+}
+
+TriangulatedMesh makeHull(unsigned int seed) {
+    auto mults = generateRadiusMultipliers(12, 1.0f, seed);
+    TriangulatedMesh hull = buildSegmentedHull(14, 12, 1.0f, 1.0f, mults, 1.1f, 0.8f, glm::vec3(0.5f));
+    computeSmoothNormals(hull);
+    return hull;
+}
+
+MeshGeometryView viewOf(const TriangulatedMesh& mesh) {
+    MeshGeometryView view;
+    view.vertices = mesh.vertices.data();
+    view.vertexCount = mesh.vertices.size();
+    view.indices = mesh.indices.data();
+    view.indexCount = mesh.indices.size();
+    return view;
+}
+
+bool sameGeometry(const MeshGeometryView& view, const TriangulatedMesh& mesh) {
+    return view.vertexCount == mesh.vertices.size() && view.indexCount == mesh.indices.size() &&
+           std::memcmp(view.vertices, mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex)) == 0 &&
+           std::memcmp(view.indices, mesh.indices.data(), mesh.indices.size() * sizeof(unsigned int)) == 0;
+}
+
+// Test 1: baked geometry maps back bit for bit
+void testRoundTrip() {
+    std::cout << "\n=== Test 1: Round Trip ===" << std::endl;
+
+    MeshDiskCache cache(testDirectory("roundtrip"), "test-v1");
+    TriangulatedMesh hull = makeHull(7);
+    TriangulatedMesh detail = makeHull(8);
+    MeshCacheKey key = makeKey("Rifter", 7);
+
+    runTest("Missing file is a miss", cache.load(key) == nullptr && cache.getStats().misses == 1);
+    runTest("Store succeeds", cache.store(key, { viewOf(hull), viewOf(detail) }));
+    runTest("File named after the key", std::filesystem::exists(cache.pathFor(key)));
+
+    auto baked = cache.load(key);
+    runTest("Load hits", baked != nullptr && cache.getStats().hits == 1);
+    if (!baked) return;
+    runTest("Both parts present", baked->parts.size() == 2);
+    runTest("Geometry identical",
+            sameGeometry(baked->parts[0], hull) && sameGeometry(baked->parts[1], detail));
+    runTest("Blocks aligned for upload",
+            reinterpret_cast<uintptr_t>(baked->parts[1].vertices) % 16 == 0 &&
+            reinterpret_cast<uintptr_t>(baked->parts[1].indices) % 16 == 0);
+    runTest("Mapped size is the file size",
+            baked->mappedBytes == std::filesystem::file_size(cache.pathFor(key)));
+
+    // The mapping outlives the cache and a replaced file
+    MeshGeometryView first = baked->parts[0];
+    cache.store(key, { viewOf(detail) });
+    runTest("Old mapping survives a rebake", sameGeometry(first, hull));
+
+    // Simplified levels ride along with full detail
+    TriangulatedMesh coarse = makeHull(9);
+    TriangulatedMesh coarsest = makeHull(10);
+    coarsest.indices.resize(coarsest.indices.size() / 2);
+    MeshLodGeometry medium;
+    medium.parts = { viewOf(coarse) };
+    medium.error = 0.25f;
+    MeshLodGeometry low;
+    low.parts = { viewOf(coarsest) };
+    low.error = 0.5f;
+    cache.store(key, { viewOf(hull) }, 0, { medium, low });
+    auto withLods = cache.load(key);
+    runTest("Levels map back in order",
+            withLods && withLods->parts.size() == 1 && sameGeometry(withLods->parts[0], hull) &&
+            withLods->lods.size() == 2 && withLods->lods[0].parts.size() == 1 &&
+            sameGeometry(withLods->lods[0].parts[0], coarse) && withLods->lods[1].parts.size() == 1 &&
+            sameGeometry(withLods->lods[1].parts[0], coarsest));
+    runTest("Level errors kept",
+            withLods && withLods->lods.size() == 2 && withLods->lods[0].error == 0.25f &&
+            withLods->lods[1].error == 0.5f);
+}
+
+// Test 2: anything the running client did not write is regenerated
+void testStaleFiles() {
+    std::cout << "\n=== Test 2: Stale Files ===" << std::endl;
+
+    std::string dir = testDirectory("stale");
+    TriangulatedMesh hull = makeHull(11);
+    MeshCacheKey key = makeKey("Thorax", 11);
+
+    MeshDiskCache oldBuild(dir, "generator-a");
+    oldBuild.store(key, { viewOf(hull) }, 42);
+
+    MeshDiskCache newBuild(dir, "generator-b");
+    runTest("Other generator version is stale", newBuild.load(key, 42) == nullptr &&
+                                                newBuild.getStats().stale == 1);
+    runTest("Changed source stamp is stale", oldBuild.load(key, 43) == nullptr);
+    runTest("Matching version and stamp hit", oldBuild.load(key, 42) != nullptr);
+
+    // A file copied to another key's name must not be served for that key
+    MeshCacheKey other = makeKey("Thorax", 12);
+    std::filesystem::copy_file(oldBuild.pathFor(key), oldBuild.pathFor(other));
+    runTest("Foreign key rejected", oldBuild.load(other, 42) == nullptr);
+
+    // Torn or damaged files
+    std::string path = oldBuild.pathFor(key);
+    auto fullSize = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, fullSize - 64);
+    runTest("Truncated file rejected", oldBuild.load(key, 42) == nullptr);
+
+    oldBuild.store(key, { viewOf(hull) }, 42);
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.write("XXXX", 4);
+    }
+    runTest("Bad magic rejected", oldBuild.load(key, 42) == nullptr);
+
+    oldBuild.store(key, { viewOf(hull) }, 42);
+    runTest("Rebake replaces a stale file", oldBuild.load(key, 42) != nullptr);
+
+    size_t removed = oldBuild.clear();
+    runTest("Clear removes baked files", removed == 2 && oldBuild.load(key, 42) == nullptr);
+}
+
+// Test 3: concurrent bakes of one key never expose a torn file
+void testConcurrentStores() {
+    std::cout << "\n=== Test 3: Concurrent Stores ===" << std::endl;
+
+    MeshDiskCache cache(testDirectory("concurrent"), "test-v1");
+    TriangulatedMesh hull = makeHull(21);
+    MeshCacheKey key = makeKey("Raven", 21);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> loads{0};
+    std::atomic<int> torn{0};
+    std::thread reader([&]() {
+        while (!done) {
+            if (auto baked = cache.load(key)) {
+                ++loads;
+                if (baked->parts.size() != 1 || !sameGeometry(baked->parts[0], hull)) ++torn;
+            }
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 4; ++w) {
+        writers.emplace_back([&]() {
+            for (int i = 0; i < 25; ++i) cache.store(key, { viewOf(hull) });
+        });
+    }
+    for (auto& writer : writers) writer.join();
+    done = true;
+    reader.join();
+
+    MeshDiskCacheStats stats = cache.getStats();
+    runTest("Every store landed", stats.writes == 100 && stats.writeFailures == 0);
+    runTest("No torn reads", torn == 0, std::to_string(torn.load()) + " of " + std::to_string(loads.load()));
+    runTest("No stray temporaries",
+            std::distance(std::filesystem::directory_iterator(cache.getDirectory()),
+                          std::filesystem::directory_iterator()) == 1);
+}
+
+// Test 4: a warm start maps what a cold start generated
+void testColdVersusWarm() {
+    std::cout << "\n=== Test 4: Cold Versus Warm Start ===" << std::endl;
+
+    MeshDiskCache cache(testDirectory("startup"), "test-v1");
+    const int hullCount = 64;
+
+    std::vector<TriangulatedMesh> generated;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < hullCount; ++i) {
+        generated.push_back(makeHull(1000u + static_cast<unsigned int>(i)));
+    }
+    double generateMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < hullCount; ++i) {
+        cache.store(makeKey("Hull", static_cast<uint32_t>(i)), { viewOf(generated[i]) });
+    }
+    double bakeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    // Warm: map each file and read every byte, as the upload would
+    std::vector<std::shared_ptr<const BakedMesh>> mapped;
+    uint64_t checksum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < hullCount; ++i) {
+        auto baked = cache.load(makeKey("Hull", static_cast<uint32_t>(i)));
+        if (!baked) break;
+        for (size_t v = 0; v < baked->parts[0].vertexCount; ++v) {
+            checksum += static_cast<uint64_t>(baked->parts[0].vertices[v].position.z * 100.0f);
+        }
+        mapped.push_back(std::move(baked));
+    }
+    double mapMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    bool identical = mapped.size() == static_cast<size_t>(hullCount);
+    for (size_t i = 0; identical && i < mapped.size(); ++i) {
+        identical = sameGeometry(mapped[i]->parts[0], generated[i]);
+    }
+    runTest("Warm start maps every hull", mapped.size() == static_cast<size_t>(hullCount));
+    runTest("Mapped hulls match generated ones", identical && checksum > 0);
+    runTest("Mapping is faster than generating", mapMs < generateMs,
+            std::to_string(mapMs) + " ms vs " + std::to_string(generateMs) + " ms");
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "  cold: generate " << generateMs << " ms + bake " << bakeMs << " ms; "
+              << "warm: map " << mapMs << " ms (" << std::setprecision(1)
+              << (mapMs > 0.0 ? generateMs / mapMs : 0.0) << "x) for " << hullCount << " hulls, "
+              << cache.getStats().bytesMapped / 1024 << " KB" << std::endl;
+}
+
+int main() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Mesh Disk Cache Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testRoundTrip();
+    testStaleFiles();
+    testConcurrentStores();
+    testColdVersusWarm();
+
+    printTestSummary();
+
+    // Return 0 if all tests passed, 1 otherwise
+    for (const auto& result : g_testResults) {
+        if (!result.passed) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,216 @@
+/**
+ * Test program for the background mesh job system
+ * Builds CPU-side procedural hulls on worker threads and checks completion
+ * ordering, the per-frame completion budget and per-job timing stats.
+ * Headless: no GL context is created, only vertex and index data.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "rendering/mesh_job_system.h"
+#include "rendering/procedural_mesh_ops.h"
+
+using namespace atlas;
+
+// Simple test framework
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string message;
+};
+
+std::vector<TestResult> g_testResults;
+
+void runTest(const std::string& name, bool result, const std::string& message = "") {
+    g_testResults.push_back({name, result, message});
+    std::cout << (result ? "[PASS] " : "[FAIL] ") << name;
+    if (!message.empty() && !result) {
+        std::cout << ": " << message;
+    }
+    std::cout << std::endl;
+}
+
+void printTestSummary() {
+    int passed = 0;
+    int failed = 0;
+
+    for (const auto& result : g_testResults) {
+        if (result.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Test Summary: " << passed << " passed, " << failed << " failed" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+}
+
+// Drain every job, as the render loop would over several frames
+size_t completeAll(MeshJobSystem& jobs) {
+    jobs.waitForBuilds();
+    size_t completed = 0;
+    while (jobs.getPendingCount() > 0) {
+        completed += jobs.processCompleted(1000.0);
+    }
+    return completed;
+}
+
+// Test 1: hulls build on workers, completions run on the calling thread
+void testProceduralHullJobs() {
+    std::cout << "\n=== Test 1: Procedural Hull Jobs ===" << std::endl;
+
+    MeshJobSystem jobs(4);
+    const std::thread::id mainThread = std::this_thread::get_id();
+    const int jobCount = 32;
+
+    std::vector<std::shared_ptr<TriangulatedMesh>> results;
+    std::atomic<int> builtOffMain{0};
+    int completedOnMain = 0;
+    int completedWithGeometry = 0;
+
+    for (int i = 0; i < jobCount; ++i) {
+        auto result = std::make_shared<TriangulatedMesh>();
+        results.push_back(result);
+        unsigned int seed = 1000u + static_cast<unsigned int>(i);
+        jobs.submit("hull_" + std::to_string(i),
+            [result, seed, mainThread, &builtOffMain]() {
+                if (std::this_thread::get_id() != mainThread) ++builtOffMain;
+                auto mults = generateRadiusMultipliers(12, 1.0f, seed);
+                *result = buildSegmentedHull(14, 12, 1.0f, 1.0f, mults, 1.1f, 0.8f,
+                                             glm::vec3(0.5f));
+                computeSmoothNormals(*result);
+            },
+            [result, mainThread, &completedOnMain, &completedWithGeometry]() {
+                if (std::this_thread::get_id() == mainThread) ++completedOnMain;
+                if (!result->vertices.empty() && !result->indices.empty()) ++completedWithGeometry;
+            });
+    }
+
+    size_t completed = completeAll(jobs);
+    MeshJobStats stats = jobs.getStats();
+
+    runTest("All jobs completed", completed == static_cast<size_t>(jobCount));
+    runTest("Builds ran on worker threads", builtOffMain == jobCount);
+    runTest("Completions ran on the calling thread", completedOnMain == jobCount);
+    runTest("Every hull has geometry by completion", completedWithGeometry == jobCount);
+    runTest("Counters agree", stats.submitted == static_cast<uint64_t>(jobCount) &&
+                              stats.built == stats.submitted &&
+                              stats.completed == stats.submitted && stats.failed == 0);
+
+    auto timings = jobs.getRecentTimings();
+    bool timingsValid = timings.size() == static_cast<size_t>(jobCount);
+    for (const auto& t : timings) {
+        if (t.buildMs < 0.0 || t.queueMs < 0.0 || t.totalMs + 1e-6 < t.buildMs) timingsValid = false;
+    }
+    runTest("Per-job timings recorded", timingsValid);
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "  " << jobCount << " hulls on " << jobs.getWorkerCount() << " workers: build avg "
+              << stats.averageBuildMs() << " ms, max " << stats.buildMsMax
+              << " ms, max queue " << stats.queueMsMax << " ms" << std::endl;
+}
+
+// Test 2: workers run jobs concurrently
+void testParallelBuilds() {
+    std::cout << "\n=== Test 2: Parallel Builds ===" << std::endl;
+
+    MeshJobSystem jobs(4);
+    const auto sleepFor = std::chrono::milliseconds(40);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 8; ++i) {
+        jobs.submit("sleep", [sleepFor]() { std::this_thread::sleep_for(sleepFor); });
+    }
+    jobs.waitForBuilds();
+    double elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    completeAll(jobs);
+
+    runTest("Four workers overlap eight 40 ms builds", elapsedMs < 8 * 40.0 * 0.75,
+            std::to_string(elapsedMs) + " ms");
+    runTest("Build time measured per job", jobs.getStats().buildMsMax >= 39.0);
+}
+
+// Test 3: the completion budget spreads a burst across frames
+void testCompletionBudget() {
+    std::cout << "\n=== Test 3: Completion Budget ===" << std::endl;
+
+    MeshJobSystem jobs(2);
+    for (int i = 0; i < 6; ++i) {
+        jobs.submit("upload", []() {},
+            []() { std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+    }
+    jobs.waitForBuilds();
+
+    // A 1 ms budget is spent by the first 5 ms "upload": one per frame
+    size_t frames = 0;
+    bool onePerFrame = true;
+    while (jobs.getPendingCount() > 0 && frames < 100) {
+        if (jobs.processCompleted(1.0) != 1) onePerFrame = false;
+        ++frames;
+    }
+    runTest("Overlong uploads complete one per frame", onePerFrame && frames == 6);
+    runTest("Completion time recorded", jobs.getStats().completeMsMax >= 4.0);
+
+    runTest("Nothing ready completes nothing", jobs.processCompleted(1.0) == 0);
+}
+
+// Test 4: a throwing build is counted and still completes
+void testFailedBuild() {
+    std::cout << "\n=== Test 4: Failed Build ===" << std::endl;
+
+    MeshJobSystem jobs(1);
+    bool completed = false;
+    jobs.submit("broken", []() { throw std::runtime_error("bad seed mesh"); },
+                [&completed]() { completed = true; });
+    completeAll(jobs);
+
+    auto timings = jobs.getRecentTimings();
+    runTest("Failure counted", jobs.getStats().failed == 1);
+    runTest("Completion still runs", completed);
+    runTest("Timing marks the failure", timings.size() == 1 && timings[0].failed);
+}
+
+// Test 5: destruction with queued work neither hangs nor completes jobs
+void testShutdownWithPendingJobs() {
+    std::cout << "\n=== Test 5: Shutdown With Pending Jobs ===" << std::endl;
+
+    std::atomic<int> completions{0};
+    {
+        MeshJobSystem jobs(1);
+        for (int i = 0; i < 50; ++i) {
+            jobs.submit("pending", []() { std::this_thread::sleep_for(std::chrono::milliseconds(2)); },
+                        [&completions]() { ++completions; });
+        }
+    }
+    runTest("Dropped jobs never complete", completions == 0);
+}
+
+int main() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Mesh Job System Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testProceduralHullJobs();
+    testParallelBuilds();
+    testCompletionBudget();
+    testFailedBuild();
+    testShutdownWithPendingJobs();
+
+    printTestSummary();
+
+    // Return 0 if all tests passed, 1 otherwise
+    for (const auto& result : g_testResults) {
+        if (!result.passed) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
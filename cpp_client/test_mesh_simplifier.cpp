@@ -0,0 +1,518 @@
+/**
+ * Test program for mesh simplification and screen-space LOD selection
+ * Checks that simplified meshes stay within their error, keep seams closed
+ * and open borders in place, that LOD chains get cheaper level by level,
+ * and that a 500-hull fleet seen from battle distance draws an order of
+ * magnitude fewer triangles once levels are picked by screen-space error.
+ * Headless: no GL context is created, only vertex and index data.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include <glm/gtc/matrix_transform.hpp>
+#include "rendering/lod_manager.h"
+#include "rendering/mesh_simplifier.h"
+#include "rendering/procedural_mesh_ops.h"
+
+using namespace atlas;
+
+// Simple test framework
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string message;
+};
+
+std::vector<TestResult> g_testResults;
+
+void runTest(const std::string& name, bool result, const std::string& message = "") {
+    g_testResults.push_back({name, result, message});
+    std::cout << (result ? "[PASS] " : "[FAIL] ") << name;
+    if (!message.empty() && !result) {
+        std::cout << ": " << message;
+    }
+    std::cout << std::endl;
+}
+
+void printTestSummary() {
+    int passed = 0;
+    int failed = 0;
+
+    for (const auto& result : g_testResults) {
+        if (result.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Test Summary: " << passed << " passed, " << failed << " failed" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+}
+
+MeshGeometryView viewOf(const TriangulatedMesh& mesh) {
+    MeshGeometryView view;
+    view.vertices = mesh.vertices.data();
+    view.vertexCount = mesh.vertices.size();
+    view.indices = mesh.indices.data();
+    view.indexCount = mesh.indices.size();
+    return view;
+}
+
+Vertex makeVertex(const glm::vec3& position, const glm::vec3& normal, const glm::vec2& texCoords) {
+    Vertex v;
+    v.position = position;
+    v.normal = normal;
+    v.texCoords = texCoords;
+    v.color = glm::vec3(0.5f, 0.5f, 0.6f);
+    return v;
+}
+
+// Flat n x n vertex grid in the XY plane
+TriangulatedMesh makePlane(int n) {
+    TriangulatedMesh plane;
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            glm::vec2 uv = glm::vec2(x, y) / static_cast<float>(n - 1);
+            plane.vertices.push_back(makeVertex(glm::vec3(uv * 4.0f, 0.0f), glm::vec3(0, 0, 1), uv));
+        }
+    }
+    for (int y = 0; y + 1 < n; ++y) {
+        for (int x = 0; x + 1 < n; ++x) {
+            unsigned int i = static_cast<unsigned int>(y * n + x);
+            unsigned int row = static_cast<unsigned int>(n);
+            plane.indices.insert(plane.indices.end(), { i, i + 1, i + row, i + 1, i + row + 1, i + row });
+        }
+    }
+    return plane;
+}
+
+/**
+ * UV sphere of unit radius with a texture seam down u = 0 / 1, or the upper
+ * half only (open along the equator) when @p hemisphere is set
+ */
+TriangulatedMesh makeSphere(int rings, int sectors, bool hemisphere) {
+    TriangulatedMesh sphere;
+    int lastRing = hemisphere ? rings / 2 : rings;
+    for (int r = 0; r <= lastRing; ++r) {
+        float theta = glm::radians(180.0f) * static_cast<float>(r) / static_cast<float>(rings);
+        for (int s = 0; s <= sectors; ++s) {
+            float phi = glm::radians(360.0f) * static_cast<float>(s % sectors) / static_cast<float>(sectors);
+            glm::vec3 p(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta));
+            if (r == 0 || r == rings) p = glm::vec3(0.0f, 0.0f, r == 0 ? 1.0f : -1.0f);
+            if (hemisphere && r == lastRing) p.z = 0.0f;
+            sphere.vertices.push_back(makeVertex(p, glm::normalize(p),
+                glm::vec2(static_cast<float>(s) / sectors, static_cast<float>(r) / rings)));
+        }
+    }
+    unsigned int row = static_cast<unsigned int>(sectors + 1);
+    for (int r = 0; r < lastRing; ++r) {
+        for (int s = 0; s < sectors; ++s) {
+            unsigned int i = static_cast<unsigned int>(r) * row + static_cast<unsigned int>(s);
+            if (r > 0) sphere.indices.insert(sphere.indices.end(), { i, i + row, i + 1 });
+            if (r + 1 < rings) sphere.indices.insert(sphere.indices.end(), { i + 1, i + row, i + row + 1 });
+        }
+    }
+    return sphere;
+}
+
+// Split every corner into its own vertex with the face normal, as the ship generator does
+TriangulatedMesh facet(const TriangulatedMesh& mesh) {
+    TriangulatedMesh faceted;
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        const Vertex& a = mesh.vertices[mesh.indices[i]];
+        const Vertex& b = mesh.vertices[mesh.indices[i + 1]];
+        const Vertex& c = mesh.vertices[mesh.indices[i + 2]];
+        glm::vec3 normal = glm::cross(b.position - a.position, c.position - a.position);
+        float length = glm::length(normal);
+        normal = length > 0.0f ? normal / length : glm::vec3(0, 1, 0);
+        for (Vertex v : { a, b, c }) {
+            v.normal = normal;
+            faceted.indices.push_back(static_cast<unsigned int>(faceted.vertices.size()));
+            faceted.vertices.push_back(v);
+        }
+    }
+    return faceted;
+}
+
+/**
+ * Ship-like hull: a segmented body with open fins stuck through it, each a
+ * separate shell as the procedural parts are
+ */
+TriangulatedMesh makeShip(unsigned int seed, bool faceted) {
+    auto mults = generateRadiusMultipliers(12, 1.0f, seed);
+    TriangulatedMesh ship = buildSegmentedHull(12, 12, 0.6f, 1.0f, mults, 1.1f, 0.8f, glm::vec3(0.5f));
+    for (int fin = 0; fin < 3; ++fin) {
+        float angle = glm::radians(360.0f) * static_cast<float>(fin) / 3.0f;
+        glm::vec3 out(std::cos(angle), 0.0f, std::sin(angle));
+        unsigned int base = static_cast<unsigned int>(ship.vertices.size());
+        for (int y = 0; y <= 4; ++y) {
+            for (int x = 0; x <= 2; ++x) {
+                glm::vec3 p = out * (0.5f + 0.6f * x) + glm::vec3(0.0f, 1.0f + 0.8f * y, 0.0f);
+                ship.vertices.push_back(makeVertex(p, glm::vec3(out.z, 0.0f, -out.x), glm::vec2(x, y) * 0.25f));
+            }
+        }
+        for (unsigned int y = 0; y < 4; ++y) {
+            for (unsigned int x = 0; x < 2; ++x) {
+                unsigned int i = base + y * 3 + x;
+                ship.indices.insert(ship.indices.end(), { i, i + 3, i + 1, i + 1, i + 3, i + 4 });
+            }
+        }
+    }
+    if (faceted) return facet(ship);
+    computeSmoothNormals(ship);
+    return ship;
+}
+
+bool validIndices(const std::vector<unsigned int>& indices, size_t vertexCount) {
+    if (indices.size() % 3 != 0) return false;
+    for (unsigned int i : indices) {
+        if (i >= vertexCount) return false;
+    }
+    return true;
+}
+
+// Undirected edges by position, with how many triangles use each
+std::map<std::array<float, 6>, int> edgeUses(const MeshGeometryView& mesh, const std::vector<unsigned int>& indices) {
+    std::map<std::array<float, 6>, int> uses;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        for (size_t e = 0; e < 3; ++e) {
+            glm::vec3 a = mesh.vertices[indices[i + e]].position;
+            glm::vec3 b = mesh.vertices[indices[i + (e + 1) % 3]].position;
+            if (std::tie(b.x, b.y, b.z) < std::tie(a.x, a.y, a.z)) std::swap(a, b);
+            ++uses[{ a.x, a.y, a.z, b.x, b.y, b.z }];
+        }
+    }
+    return uses;
+}
+
+size_t triangleCount(const std::vector<MeshLod>& lods, size_t level, size_t fullDetail) {
+    return level == 0 ? fullDetail : lods[level - 1].indices.size() / 3;
+}
+
+// Test 1: a flat plane collapses to almost nothing without leaving it
+void testPlane() {
+    std::cout << "\n=== Test 1: Flat Plane ===" << std::endl;
+
+    TriangulatedMesh plane = makePlane(33);
+    MeshGeometryView view = viewOf(plane);
+    float error = 1.0f;
+    std::vector<unsigned int> indices = simplifyMesh(view, plane.indices.size() / 10, 0.01f, &error);
+
+    glm::vec3 minimum(1e9f), maximum(-1e9f);
+    bool flat = true;
+    bool facingUp = true;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        glm::vec3 p0 = plane.vertices[indices[i]].position;
+        glm::vec3 p1 = plane.vertices[indices[i + 1]].position;
+        glm::vec3 p2 = plane.vertices[indices[i + 2]].position;
+        if (glm::cross(p1 - p0, p2 - p0).z <= 0.0f) facingUp = false;
+        for (const glm::vec3& p : { p0, p1, p2 }) {
+            minimum = glm::min(minimum, p);
+            maximum = glm::max(maximum, p);
+            if (p.z != 0.0f) flat = false;
+        }
+    }
+
+    runTest("Indices stay valid", validIndices(indices, plane.vertices.size()));
+    runTest("Reaches the target count", !indices.empty() && indices.size() <= plane.indices.size() / 10,
+            std::to_string(indices.size() / 3) + " triangles");
+    runTest("Plane costs no error", error < 1e-4f, std::to_string(error));
+    runTest("Outline keeps its corners", minimum == glm::vec3(0.0f) && maximum == glm::vec3(4.0f, 4.0f, 0.0f));
+    runTest("Stays flat and facing up", flat && facingUp);
+}
+
+// Test 2: seams stay closed and curved surfaces respect the error limit
+void testSphere() {
+    std::cout << "\n=== Test 2: UV Sphere Seam ===" << std::endl;
+
+    TriangulatedMesh sphere = makeSphere(24, 32, false);
+    MeshGeometryView view = viewOf(sphere);
+    size_t target = sphere.indices.size() / 4;
+    float error = 1.0f;
+    std::vector<unsigned int> indices = simplifyMesh(view, target, 0.05f, &error);
+
+    bool closed = true;
+    for (const auto& edge : edgeUses(view, indices)) {
+        if (edge.second != 2) closed = false;
+    }
+    bool noFlips = true;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        glm::vec3 p0 = sphere.vertices[indices[i]].position;
+        glm::vec3 p1 = sphere.vertices[indices[i + 1]].position;
+        glm::vec3 p2 = sphere.vertices[indices[i + 2]].position;
+        if (glm::dot(glm::cross(p1 - p0, p2 - p0), p0 + p1 + p2) <= 0.0f) noFlips = false;
+    }
+    // Vertices only move onto neighbours, so every used one is a source vertex on the sphere
+    bool onSurface = true;
+    for (unsigned int i : indices) {
+        if (std::abs(glm::length(sphere.vertices[i].position) - 1.0f) > 1e-5f) onSurface = false;
+    }
+
+    runTest("Indices stay valid", validIndices(indices, sphere.vertices.size()));
+    runTest("Reaches the target count", !indices.empty() && indices.size() <= target,
+            std::to_string(indices.size() / 3) + " of " + std::to_string(sphere.indices.size() / 3));
+    runTest("Error within the limit", error > 0.0f && error <= 0.05f, std::to_string(error));
+    runTest("Seam stays closed (every edge has two triangles)", closed);
+    runTest("No triangle turns inside out", noFlips);
+    runTest("Vertices stay on the surface", onSurface);
+
+    float tightError = 1.0f;
+    std::vector<unsigned int> tight = simplifyMesh(view, 0, 0.005f, &tightError);
+    runTest("Error limit stops before the target", tight.size() > indices.size() && tightError <= 0.005f,
+            std::to_string(tight.size() / 3) + " triangles at " + std::to_string(tightError));
+}
+
+// Test 3: open borders only move along themselves
+void testHemisphere() {
+    std::cout << "\n=== Test 3: Open Border ===" << std::endl;
+
+    TriangulatedMesh dome = makeSphere(24, 32, true);
+    MeshGeometryView view = viewOf(dome);
+    std::vector<unsigned int> indices = simplifyMesh(view, dome.indices.size() / 4, 0.05f);
+
+    size_t openEdges = 0;
+    bool rimOnly = true;
+    for (const auto& edge : edgeUses(view, indices)) {
+        if (edge.second == 2) continue;
+        ++openEdges;
+        if (edge.second != 1 || edge.first[2] != 0.0f || edge.first[5] != 0.0f) rimOnly = false;
+    }
+
+    runTest("Simplifies", !indices.empty() && indices.size() < dome.indices.size() / 2);
+    runTest("Open edges only on the rim", rimOnly && openEdges >= 3, std::to_string(openEdges) + " open edges");
+}
+
+// Test 4: LOD chains get cheaper per level and keep their shading
+void testLodChain() {
+    std::cout << "\n=== Test 4: LOD Chains ===" << std::endl;
+
+    TriangulatedMesh faceted = makeShip(7, true);
+    std::vector<MeshLod> lods = buildMeshLods(viewOf(faceted));
+    size_t full = faceted.indices.size() / 3;
+
+    bool decreasing = true;
+    bool errorsGrow = true;
+    bool compact = true;
+    bool valid = true;
+    float worstNormal = 1.0f;
+    for (size_t level = 0; level < lods.size(); ++level) {
+        const MeshLod& lod = lods[level];
+        if (lod.indices.size() / 3 >= triangleCount(lods, level, full)) decreasing = false;
+        if (lod.error < (level == 0 ? 0.0f : lods[level - 1].error)) errorsGrow = false;
+        if (!validIndices(lod.indices, lod.vertices.size())) {
+            valid = false;
+            continue;
+        }
+        std::vector<bool> used(lod.vertices.size(), false);
+        for (unsigned int i : lod.indices) used[i] = true;
+        if (std::find(used.begin(), used.end(), false) != used.end()) compact = false;
+
+        // Hard edges stay hard: corner normals lean no further than the crease from their face
+        for (size_t i = 0; i < lod.indices.size(); i += 3) {
+            glm::vec3 p0 = lod.vertices[lod.indices[i]].position;
+            glm::vec3 p1 = lod.vertices[lod.indices[i + 1]].position;
+            glm::vec3 p2 = lod.vertices[lod.indices[i + 2]].position;
+            glm::vec3 face = glm::cross(p1 - p0, p2 - p0);
+            if (glm::length(face) < 1e-6f) continue;
+            face = glm::normalize(face);
+            for (size_t c = 0; c < 3; ++c) {
+                worstNormal = std::min(worstNormal, glm::dot(lod.vertices[lod.indices[i + c]].normal, face));
+            }
+        }
+    }
+
+    std::cout << "  Faceted ship: " << full << " triangles";
+    for (const auto& lod : lods) std::cout << " -> " << lod.indices.size() / 3 << " (error " << lod.error << ")";
+    std::cout << std::endl;
+
+    runTest("Builds every level", lods.size() == MAX_MESH_LODS, std::to_string(lods.size()));
+    runTest("Levels stay valid", valid);
+    runTest("Each level is cheaper", decreasing);
+    runTest("Errors never shrink", errorsGrow);
+    runTest("Levels keep only vertices they use", compact);
+    runTest("Faceted normals follow their faces", worstNormal >= std::cos(glm::radians(20.0f)) - 1e-3f,
+            std::to_string(worstNormal));
+    runTest("Coarsest level at least 10x cheaper", !lods.empty() && lods.back().indices.size() / 3 * 10 <= full,
+            std::to_string(lods.empty() ? 0 : lods.back().indices.size() / 3));
+    float scale = simplificationScale(viewOf(faceted));
+    runTest("Errors within the limit", !lods.empty() && lods.back().error <= MeshLodSettings().maxError * scale,
+            std::to_string(lods.empty() ? 0.0f : lods.back().error));
+
+    // Vertices are never invented: only normals may be rebuilt
+    TriangulatedMesh smooth = makeShip(7, false);
+    std::vector<MeshLod> smoothLods = buildMeshLods(viewOf(smooth));
+    bool exact = !smoothLods.empty();
+    for (const auto& lod : smoothLods) {
+        for (const Vertex& v : lod.vertices) {
+            bool found = false;
+            for (const Vertex& source : smooth.vertices) {
+                if (v.position == source.position && v.texCoords == source.texCoords && v.color == source.color) {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) exact = false;
+        }
+    }
+    runTest("Levels keep source positions and attributes", exact);
+
+    MeshLodSettings strict;
+    strict.maxError = 0.0f;
+    runTest("No levels when nothing may move", buildMeshLods(viewOf(makeSphere(12, 16, false)), strict).empty());
+}
+
+// Test 5: errors are relative, so scaling a model changes nothing but the scale
+void testScaleInvariance() {
+    std::cout << "\n=== Test 5: Scale Invariance ===" << std::endl;
+
+    TriangulatedMesh ship = makeShip(11, false);
+    TriangulatedMesh big = ship;
+    for (auto& v : big.vertices) v.position *= 64.0f;
+
+    float error = 0.0f;
+    float bigError = 0.0f;
+    std::vector<unsigned int> small = simplifyMesh(viewOf(ship), ship.indices.size() / 5, 0.1f, &error);
+    std::vector<unsigned int> large = simplifyMesh(viewOf(big), big.indices.size() / 5, 0.1f, &bigError);
+    runTest("Same triangles at any scale", small == large);
+    runTest("Same relative error", error == bigError, std::to_string(error) + " vs " + std::to_string(bigError));
+    runTest("Scale is the longest side", std::abs(simplificationScale(viewOf(big)) -
+                                                  64.0f * simplificationScale(viewOf(ship))) < 1e-3f);
+
+    std::vector<MeshLod> lods = buildMeshLods(viewOf(ship));
+    std::vector<MeshLod> bigLods = buildMeshLods(viewOf(big));
+    bool scaled = lods.size() == bigLods.size();
+    for (size_t i = 0; scaled && i < lods.size(); ++i) {
+        scaled = std::abs(bigLods[i].error - 64.0f * lods[i].error) <= 1e-3f * bigLods[i].error;
+    }
+    runTest("LOD errors scale with the model", scaled);
+}
+
+// Test 6: clustering reaches counts edge collapses cannot
+void testSloppy() {
+    std::cout << "\n=== Test 6: Clustering ===" << std::endl;
+
+    TriangulatedMesh ship = makeShip(3, false);
+    MeshGeometryView view = viewOf(ship);
+    size_t target = ship.indices.size() / 40;
+    float collapseError = 0.0f;
+    std::vector<unsigned int> collapsed = simplifyMesh(view, target, 0.2f, &collapseError);
+    float error = 1.0f;
+    std::vector<unsigned int> clustered = simplifyMeshSloppy(view, target, 0.2f, &error);
+
+    std::cout << "  " << ship.indices.size() / 3 << " triangles: collapses reach " << collapsed.size() / 3
+              << ", clustering " << clustered.size() / 3 << " (error " << error << ")" << std::endl;
+
+    runTest("Indices stay valid", validIndices(clustered, ship.vertices.size()));
+    runTest("Gets below what collapses reach", !clustered.empty() && clustered.size() < collapsed.size());
+    runTest("Error within the limit", error <= 0.2f, std::to_string(error));
+
+    float tightError = 1.0f;
+    std::vector<unsigned int> tight = simplifyMeshSloppy(view, target, 0.01f, &tightError);
+    runTest("Tight limit keeps more triangles", tight.size() > clustered.size() && tightError <= 0.01f,
+            std::to_string(tight.size() / 3) + " triangles at " + std::to_string(tightError));
+}
+
+// Test 7: levels are picked by how many pixels their error covers
+void testSelection() {
+    std::cout << "\n=== Test 7: Screen-Space Selection ===" << std::endl;
+
+    // 90 degree vertical FOV: projection[1][1] is 1
+    glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 1000.0f);
+    runTest("Pixels per unit", std::abs(pixelsPerUnitAt(10.0f, projection, 1000.0f) - 50.0f) < 1e-3f,
+            std::to_string(pixelsPerUnitAt(10.0f, projection, 1000.0f)));
+    runTest("Distance zero does not divide by zero", std::isfinite(pixelsPerUnitAt(0.0f, projection, 1000.0f)));
+
+    std::vector<float> errors = { 0.01f, 0.05f, 0.2f };
+    runTest("Full detail up close", selectMeshLOD(errors, pixelsPerUnitAt(0.5f, projection, 1000.0f), 1.0f) == 0);
+    runTest("Middle level in between", selectMeshLOD(errors, 50.0f, 1.0f) == 1);
+    runTest("Coarsest far away", selectMeshLOD(errors, pixelsPerUnitAt(500.0f, projection, 1000.0f), 1.0f) == 3);
+    runTest("Looser error picks coarser", selectMeshLOD(errors, 50.0f, 3.0f) == 2);
+    runTest("No levels means full detail", selectMeshLOD({}, 0.001f, 1.0f) == 0);
+}
+
+// Test 8: a fleet battle seen from afar draws far fewer triangles
+void testFleet() {
+    std::cout << "\n=== Test 8: 500-Hull Fleet ===" << std::endl;
+
+    struct Hull {
+        size_t triangles;
+        std::vector<MeshLod> lods;
+        std::vector<float> errors;
+        float scale;
+    };
+    std::vector<Hull> designs;
+    for (unsigned int seed = 1; seed <= 4; ++seed) {
+        TriangulatedMesh ship = makeShip(seed, seed % 2 == 0);
+        Hull hull;
+        hull.triangles = ship.indices.size() / 3;
+        hull.lods = buildMeshLods(viewOf(ship));
+        for (const auto& lod : hull.lods) hull.errors.push_back(lod.error);
+        hull.scale = simplificationScale(viewOf(ship));
+        designs.push_back(std::move(hull));
+    }
+
+    // 1080p, 60 degree FOV; hulls of about 10 model units spread over a
+    // 2 km sphere 3 km out, with a few close to the camera
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 1.0f, 100000.0f);
+    const float viewportHeight = 1080.0f;
+    const float hullSize = 10.0f;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    size_t fullTriangles = 0;
+    size_t lodTriangles = 0;
+    std::array<size_t, MAX_MESH_LODS + 1> perLevel = {};
+    for (int i = 0; i < 500; ++i) {
+        const Hull& hull = designs[static_cast<size_t>(i) % designs.size()];
+        float distance = i < 10 ? 50.0f + 30.0f * static_cast<float>(i)
+                                : glm::length(glm::vec3(unit(rng), unit(rng), unit(rng) + 3.0f) * 1000.0f);
+        // LOD errors are model-space; the hull is scaled to hullSize in the world
+        float pixelsPerUnit = pixelsPerUnitAt(distance, projection, viewportHeight) * hullSize / hull.scale;
+        size_t level = selectMeshLOD(hull.errors, pixelsPerUnit, LODConfig().maxScreenSpaceError);
+        ++perLevel[level];
+        fullTriangles += hull.triangles;
+        lodTriangles += triangleCount(hull.lods, level, hull.triangles);
+    }
+
+    float reduction = lodTriangles > 0 ? static_cast<float>(fullTriangles) / static_cast<float>(lodTriangles) : 0.0f;
+    std::cout << std::fixed << std::setprecision(1)
+              << "  " << fullTriangles << " triangles at full detail, " << lodTriangles << " with LODs ("
+              << reduction << "x); hulls per level:";
+    for (size_t count : perLevel) std::cout << " " << count;
+    std::cout << std::endl;
+
+    runTest("Close hulls keep full detail", perLevel[0] >= 1);
+    runTest("Triangle count drops by an order of magnitude", reduction >= 10.0f, std::to_string(reduction));
+}
+
+int main() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Mesh Simplifier Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testPlane();
+    testSphere();
+    testHemisphere();
+    testLodChain();
+    testScaleInvariance();
+    testSloppy();
+    testSelection();
+    testFleet();
+
+    printTestSummary();
+
+    // Return 0 if all tests passed, 1 otherwise
+    for (const auto& result : g_testResults) {
+        if (!result.passed) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
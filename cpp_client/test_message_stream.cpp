@@ -0,0 +1,375 @@
+/**
+ * Test program for the client receive path
+ * Validates the SPSC queue, in-place message framing and buffer recycling,
+ * then streams messages from a local server through TCPClient to measure
+ * throughput, all without a game server.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "network/message_stream.h"
+#include "network/tcp_client.h"
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace atlas;
+
+// Simple test framework
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string message;
+};
+
+std::vector<TestResult> g_testResults;
+
+void runTest(const std::string& name, bool result, const std::string& message = "") {
+    g_testResults.push_back({name, result, message});
+    std::cout << (result ? "[PASS] " : "[FAIL] ") << name;
+    if (!message.empty() && !result) {
+        std::cout << ": " << message;
+    }
+    std::cout << std::endl;
+}
+
+void printTestSummary() {
+    int passed = 0;
+    int failed = 0;
+
+    for (const auto& result : g_testResults) {
+        if (result.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Test Summary: " << passed << " passed, " << failed << " failed" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+}
+
+// Stand-in for a JSON message of roughly @p size bytes
+std::string makeMessage(size_t index, size_t size) {
+    std::string message = "{\"type\":\"state_update\",\"seq\":" + std::to_string(index) + ",\"data\":\"";
+    while (message.size() + 2 < size) message += static_cast<char>('a' + (index + message.size()) % 26);
+    return message + "\"}";
+}
+
+// Feed @p stream in chunks of random size, as recv() would
+void feed(MessageStream& stream, const std::string& bytes, std::mt19937& rng, size_t maxChunk) {
+    size_t offset = 0;
+    while (offset < bytes.size()) {
+        size_t available = 0;
+        char* space = stream.prepareWrite(available);
+        size_t chunk = std::min({ available, bytes.size() - offset,
+                                  std::uniform_int_distribution<size_t>(1, maxChunk)(rng) });
+        std::memcpy(space, bytes.data() + offset, chunk);
+        stream.commit(chunk);
+        offset += chunk;
+    }
+}
+
+// Test 1: SPSC queue
+void testQueue() {
+    std::cout << "\n=== Test 1: SPSC Queue ===" << std::endl;
+
+    SpscQueue<int> queue(5);
+    runTest("Capacity rounds up to a power of two", queue.capacity() == 8);
+
+    int pushed = 0;
+    while (queue.push(pushed)) ++pushed;
+    runTest("Push fails when full", pushed == 8);
+
+    bool ordered = true;
+    int value = -1;
+    for (int round = 0; round < 100; ++round) {
+        // Keep the ring half full while the indices wrap many times
+        ordered = ordered && queue.pop(value) && value == round;
+        ordered = ordered && queue.push(pushed++);
+    }
+    runTest("FIFO order across wrap-around", ordered);
+
+    int drained = 0;
+    while (queue.pop(value)) ++drained;
+    runTest("Pop fails when empty", drained == 8 && !queue.pop(value));
+}
+
+// Test 2: Framing
+void testFraming() {
+    std::cout << "\n=== Test 2: In-Place Framing ===" << std::endl;
+
+    std::mt19937 rng(9);
+    std::vector<std::string> expected;
+    std::string bytes;
+    for (size_t i = 0; i < 2000; ++i) {
+        expected.push_back(makeMessage(i, 20 + (i * 37) % 3000));
+        bytes += expected.back() + "\n";
+        if (i % 100 == 0) bytes += "\n";   // empty lines are skipped
+    }
+
+    for (size_t maxChunk : { size_t(1), size_t(7), size_t(8192), size_t(100000) }) {
+        MessageStream stream(4096, 8192);
+        std::vector<std::string> received;
+        feed(stream, bytes, rng, maxChunk);
+        stream.consume([&](std::string_view message) { received.emplace_back(message); });
+        runTest("Messages intact with chunks up to " + std::to_string(maxChunk), received == expected,
+                std::to_string(received.size()) + " received");
+    }
+
+    MessageStream stream(4096);
+    std::string partial = "{\"type\":\"partial\"";
+    feed(stream, partial, rng, 5);
+    size_t handled = stream.consume([](std::string_view) {});
+    feed(stream, "}\n", rng, 5);
+    std::string completed;
+    stream.consume([&](std::string_view message) { completed = std::string(message); });
+    runTest("Unfinished message waits for its newline", handled == 0 && completed == partial + "}");
+}
+
+// Test 3: Large messages and block reuse
+void testBlocks() {
+    std::cout << "\n=== Test 3: Receive Blocks ===" << std::endl;
+
+    std::mt19937 rng(4);
+    MessageStream stream(4096);
+    std::string large = makeMessage(1, 300000);
+    feed(stream, large + "\n", rng, 8192);
+    std::string received;
+    stream.consume([&](std::string_view message) { received = std::string(message); });
+    runTest("Message larger than a block", received == large);
+
+    // Steady traffic consumed as it arrives reuses the same few blocks
+    size_t before = stream.getBlocksAllocated();
+    size_t count = 0;
+    bool intact = true;
+    for (size_t i = 0; i < 20000; ++i) {
+        std::string message = makeMessage(i, 200 + i % 1500);
+        feed(stream, message + "\n", rng, 4096);
+        stream.consume([&](std::string_view text) {
+            intact = intact && text == message;
+            ++count;
+        });
+    }
+    runTest("Every message delivered once", intact && count == 20000);
+    runTest("Blocks recycled", stream.getBlocksAllocated() - before <= 2,
+            std::to_string(stream.getBlocksAllocated()) + " allocated");
+    runTest("Counters", stream.getMessagesReceived() == 20001);
+}
+
+// Test 4: Producer and consumer threads
+void testThreads() {
+    std::cout << "\n=== Test 4: Concurrent Handoff ===" << std::endl;
+
+    const size_t COUNT = 200000;
+    MessageStream stream(16384, 256);   // small queue: the producer has to wait
+    std::atomic<bool> done(false);
+
+    std::thread producer([&]() {
+        std::mt19937 rng(1);
+        std::string bytes;
+        for (size_t i = 0; i < COUNT; ++i) {
+            bytes += makeMessage(i, 40 + i % 400) + "\n";
+            if (bytes.size() > 65536) {
+                feed(stream, bytes, rng, 16384);
+                bytes.clear();
+            }
+        }
+        feed(stream, bytes, rng, 16384);
+        done = true;
+    });
+
+    size_t received = 0;
+    bool ordered = true;
+    for (;;) {
+        bool finished = done.load();
+        stream.consume([&](std::string_view message) {
+            ordered = ordered && message == makeMessage(received, 40 + received % 400);
+            ++received;
+        });
+        if (finished && received == stream.getMessagesReceived()) break;
+        std::this_thread::yield();
+    }
+    producer.join();
+
+    runTest("All messages arrive in order", ordered && received == COUNT, std::to_string(received));
+
+    // A full queue parks commit() until consume() or close()
+    auto commitInThread = [](MessageStream& target, std::atomic<int>& result) {
+        return std::thread([&target, &result]() {
+            const std::string bytes = "{\"a\":1}\n{\"b\":2}\n{\"c\":3}\n";
+            size_t available = 0;
+            char* out = target.prepareWrite(available);
+            std::memcpy(out, bytes.data(), bytes.size());
+            result = target.commit(bytes.size()) ? 1 : 0;
+        });
+    };
+
+    MessageStream full(256, 2);
+    std::atomic<int> committed(-1);
+    std::thread blocked = commitInThread(full, committed);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    bool waited = committed == -1;
+    size_t handled = 0;
+    while (committed == -1) {
+        handled += full.consume([](std::string_view) {});
+        std::this_thread::yield();
+    }
+    blocked.join();
+    handled += full.consume([](std::string_view) {});
+    runTest("Full queue waits for the consumer", waited && committed == 1 && handled == 3);
+
+    MessageStream closing(256, 2);
+    std::atomic<int> closedResult(-1);
+    std::thread stuck = commitInThread(closing, closedResult);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    bool stillWaiting = closedResult == -1;
+    closing.close();
+    stuck.join();
+    runTest("Close wakes a waiting commit", stillWaiting && closedResult == 0);
+}
+
+#ifndef _WIN32
+// Test 5: Local server through TCPClient
+void testLoopback() {
+    std::cout << "\n=== Test 5: Loopback Throughput ===" << std::endl;
+
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t length = sizeof(address);
+    bool listening = listener >= 0 && bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+                     listen(listener, 1) == 0 &&
+                     getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) == 0;
+    runTest("Local server listening", listening);
+    if (!listening) return;
+
+    // A burst of small messages with a few large state updates
+    const size_t COUNT = 100000;
+    std::string payload;
+    size_t payloadMessages = 0;
+    for (size_t i = 0; i < COUNT; ++i) {
+        payload += makeMessage(i, (i % 1000 == 0) ? 200000 : 150 + i % 300) + "\n";
+        ++payloadMessages;
+    }
+
+    // Framing alone, against the previous string-based receive loop
+    auto framingStart = std::chrono::steady_clock::now();
+    size_t legacyMessages = 0;
+    std::string incompleteMessage;
+    for (size_t offset = 0; offset < payload.size(); offset += 8191) {
+        incompleteMessage += payload.substr(offset, 8191);
+        size_t pos;
+        while ((pos = incompleteMessage.find('\n')) != std::string::npos) {
+            std::string message = incompleteMessage.substr(0, pos);
+            incompleteMessage = incompleteMessage.substr(pos + 1);
+            if (!message.empty()) ++legacyMessages;
+        }
+    }
+    double legacyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - framingStart).count();
+
+    framingStart = std::chrono::steady_clock::now();
+    MessageStream framing;
+    size_t framedMessages = 0;
+    for (size_t offset = 0; offset < payload.size();) {
+        size_t available = 0;
+        char* space = framing.prepareWrite(available);
+        size_t chunk = std::min({ available, payload.size() - offset, size_t(8191) });
+        std::memcpy(space, payload.data() + offset, chunk);
+        framing.commit(chunk);
+        offset += chunk;
+        framedMessages += framing.consume([](std::string_view) {});
+    }
+    double framingMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - framingStart).count();
+    std::cout << std::fixed << std::setprecision(1) << "  Framing " << payload.size() / (1024.0 * 1024.0)
+              << " MiB: string receive loop " << legacyMs << " ms, message stream " << framingMs << " ms" << std::endl;
+    runTest("Framing faster than the string loop", framedMessages == legacyMessages && framingMs < legacyMs);
+
+    std::thread server([&]() {
+        int client = accept(listener, nullptr, nullptr);
+        if (client < 0) return;
+        size_t sent = 0;
+        while (sent < payload.size()) {
+            ssize_t result = ::send(client, payload.data() + sent, payload.size() - sent, 0);
+            if (result <= 0) break;
+            sent += static_cast<size_t>(result);
+        }
+        // Hold the connection until the client leaves
+        char byte;
+        while (recv(client, &byte, 1, 0) > 0) {
+        }
+        ::close(client);
+    });
+
+    TCPClient client;
+    size_t received = 0;
+    size_t bytes = 0;
+    bool ordered = true;
+    client.setMessageCallback([&](std::string_view message) {
+        // Cheap spot check of the sequence number every message carries
+        std::string expectedPrefix = "{\"type\":\"state_update\",\"seq\":" + std::to_string(received) + ",";
+        ordered = ordered && message.substr(0, expectedPrefix.size()) == expectedPrefix;
+        bytes += message.size() + 1;
+        ++received;
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    bool connected = client.connect("127.0.0.1", ntohs(address.sin_port));
+    while (connected && received < payloadMessages &&
+           std::chrono::steady_clock::now() - start < std::chrono::seconds(60)) {
+        if (client.processMessages() == 0) std::this_thread::yield();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t blocks = client.getReceiveStream().getBlocksAllocated();
+    client.disconnect();
+    server.join();
+    ::close(listener);
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "  " << received << " messages, " << bytes / (1024.0 * 1024.0) << " MiB in " << seconds * 1000.0
+              << " ms: " << bytes / (1024.0 * 1024.0) / seconds << " MiB/s, " << received / seconds / 1000.0
+              << "k messages/s, " << blocks << " receive blocks" << std::endl;
+
+    runTest("Connected to local server", connected);
+    runTest("Every message received in order", received == payloadMessages && ordered,
+            std::to_string(received) + " received");
+    runTest("Disconnect leaves the client reusable", !client.isConnected());
+}
+#endif
+
+int main() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Message Stream Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testQueue();
+    testFraming();
+    testBlocks();
+    testThreads();
+#ifndef _WIN32
+    testLoopback();
+#endif
+
+    printTestSummary();
+
+    // Return 0 if all tests passed, 1 otherwise
+    for (const auto& result : g_testResults) {
+        if (!result.passed) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
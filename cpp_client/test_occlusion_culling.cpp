@@ -0,0 +1,313 @@
+/**
+ * Test program for software occlusion culling
+ * Validates the depth rasteriser, the max-depth pyramid and box queries,
+ * checks every "hidden" answer against the occluder's true shape and
+ * measures the cost per frame, all on the CPU without a GPU.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include "rendering/occlusion_culler.h"
+
+using namespace atlas;
+
+// Simple test framework
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string message;
+};
+
+std::vector<TestResult> g_testResults;
+
+void runTest(const std::string& name, bool result, const std::string& message = "") {
+    g_testResults.push_back({name, result, message});
+    std::cout << (result ? "[PASS] " : "[FAIL] ") << name;
+    if (!message.empty() && !result) {
+        std::cout << ": " << message;
+    }
+    std::cout << std::endl;
+}
+
+void printTestSummary() {
+    int passed = 0;
+    int failed = 0;
+
+    for (const auto& result : g_testResults) {
+        if (result.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Test Summary: " << passed << " passed, " << failed << " failed" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+}
+
+struct TestMesh {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+
+    MeshGeometryView view() const {
+        MeshGeometryView geometry;
+        geometry.vertices = vertices.data();
+        geometry.vertexCount = vertices.size();
+        geometry.indices = indices.data();
+        geometry.indexCount = indices.size();
+        return geometry;
+    }
+};
+
+Vertex makeVertex(const glm::vec3& position) {
+    Vertex vertex;
+    vertex.position = position;
+    vertex.normal = glm::vec3(0.0f, 0.0f, 1.0f);
+    vertex.texCoords = glm::vec2(0.0f);
+    vertex.color = glm::vec3(1.0f);
+    return vertex;
+}
+
+// Square in the XY plane, facing +Z
+TestMesh makeWall(float halfSize) {
+    TestMesh wall;
+    wall.vertices = { makeVertex({ -halfSize, -halfSize, 0.0f }), makeVertex({ halfSize, -halfSize, 0.0f }),
+                      makeVertex({ halfSize, halfSize, 0.0f }), makeVertex({ -halfSize, halfSize, 0.0f }) };
+    wall.indices = { 0, 1, 2, 0, 2, 3 };
+    return wall;
+}
+
+// UV sphere with its vertices on the unit sphere: the faces lie inside it
+TestMesh makeSphere(int rings, int segments) {
+    TestMesh sphere;
+    const float pi = glm::radians(180.0f);
+    for (int ring = 0; ring <= rings; ++ring) {
+        float theta = pi * static_cast<float>(ring) / static_cast<float>(rings);
+        for (int segment = 0; segment <= segments; ++segment) {
+            float phi = 2.0f * pi * static_cast<float>(segment) / static_cast<float>(segments);
+            sphere.vertices.push_back(makeVertex({ std::sin(theta) * std::cos(phi), std::cos(theta),
+                                                   std::sin(theta) * std::sin(phi) }));
+        }
+    }
+    for (int ring = 0; ring < rings; ++ring) {
+        for (int segment = 0; segment < segments; ++segment) {
+            unsigned int a = static_cast<unsigned int>(ring * (segments + 1) + segment);
+            unsigned int b = a + static_cast<unsigned int>(segments + 1);
+            sphere.indices.insert(sphere.indices.end(), { a, b, a + 1, a + 1, b, b + 1 });
+        }
+    }
+    return sphere;
+}
+
+glm::mat4 makeViewProjection(const glm::vec3& eye, const glm::vec3& target) {
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 2.0f, 1.0f, 5000.0f);
+    glm::mat4 view = glm::lookAt(eye, target, glm::vec3(0.0f, 1.0f, 0.0f));
+    return projection * view;
+}
+
+glm::mat4 placeAt(const glm::vec3& position, float scale) {
+    return glm::scale(glm::translate(glm::mat4(1.0f), position), glm::vec3(scale));
+}
+
+bool boxVisible(OcclusionCuller& culler, const glm::vec3& center, float halfSize) {
+    return culler.isBoxVisible(center - glm::vec3(halfSize), center + glm::vec3(halfSize));
+}
+
+// Test 1: Empty depth buffer
+void testEmpty() {
+    std::cout << "\n=== Test 1: Empty Depth Buffer ===" << std::endl;
+
+    OcclusionCuller culler(256, 128);
+    culler.beginFrame(makeViewProjection(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f)));
+    runTest("Pyramid reduces to one texel", culler.getPyramidLevels() == 8);
+    runTest("Nothing hidden without occluders", boxVisible(culler, glm::vec3(0.0f, 0.0f, -100.0f), 5.0f) &&
+            boxVisible(culler, glm::vec3(20.0f, -10.0f, -4000.0f), 1.0f));
+
+    OcclusionCuller odd(250, 67);
+    runTest("Width rounds up to whole SIMD groups", odd.getWidth() == 252 && odd.getHeight() == 67);
+}
+
+// Test 2: A wall in front of the camera
+void testWall() {
+    std::cout << "\n=== Test 2: Wall Occluder ===" << std::endl;
+
+    OcclusionCuller culler;
+    culler.beginFrame(makeViewProjection(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f)));
+    TestMesh wall = makeWall(1.0f);
+    culler.addOccluder(wall.view(), placeAt(glm::vec3(0.0f, 0.0f, -50.0f), 20.0f));
+
+    size_t covered = 0;
+    for (float depth : culler.getDepthBuffer()) {
+        if (depth < 1.0f) ++covered;
+    }
+    runTest("Wall rasterised", covered > 0 && culler.getStats().trianglesRasterized == 2);
+
+    runTest("Box behind the wall hidden", !boxVisible(culler, glm::vec3(0.0f, 0.0f, -100.0f), 5.0f));
+    runTest("Box in front of the wall visible", boxVisible(culler, glm::vec3(0.0f, 0.0f, -30.0f), 5.0f));
+    runTest("Box beside the wall visible", boxVisible(culler, glm::vec3(80.0f, 0.0f, -100.0f), 5.0f));
+    runTest("Box peeking past the edge visible", boxVisible(culler, glm::vec3(38.0f, 0.0f, -100.0f), 5.0f));
+    runTest("Box through the wall visible", boxVisible(culler, glm::vec3(0.0f, 0.0f, -50.0f), 5.0f));
+    runTest("Box around the camera visible", boxVisible(culler, glm::vec3(0.0f), 5.0f));
+
+    const OcclusionStats& stats = culler.getStats();
+    runTest("Query counters", stats.tested == 6 && stats.occluded == 1 && stats.occluders == 1 &&
+            stats.occluderTriangles == 2);
+
+    // A new frame forgets the wall
+    culler.beginFrame(makeViewProjection(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f)));
+    runTest("Begin frame clears occluders", boxVisible(culler, glm::vec3(0.0f, 0.0f, -100.0f), 5.0f) &&
+            culler.getStats().tested == 1);
+}
+
+// Test 3: Occluders crossing the near plane
+void testNearClipping() {
+    std::cout << "\n=== Test 3: Near Plane Clipping ===" << std::endl;
+
+    OcclusionCuller culler;
+    culler.beginFrame(makeViewProjection(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(0.0f, 10.0f, -1.0f)));
+    // Floor reaching from behind the camera far ahead, and a wall whose
+    // corner is behind the camera
+    culler.addTriangle({ -500.0f, 0.0f, 100.0f }, { 500.0f, 0.0f, 100.0f }, { 0.0f, 0.0f, -2000.0f });
+    culler.addTriangle({ -200.0f, -100.0f, -60.0f }, { 200.0f, -100.0f, -60.0f }, { 0.0f, 300.0f, 40.0f });
+
+    bool finite = true;
+    for (float depth : culler.getDepthBuffer()) {
+        if (!std::isfinite(depth) || depth < -1.0001f) finite = false;
+    }
+    runTest("Clipped depth stays in range", finite);
+    runTest("Both triangles drawn", culler.getStats().trianglesRasterized >= 2);
+    runTest("Box below the floor hidden", !boxVisible(culler, glm::vec3(0.0f, -50.0f, -800.0f), 10.0f));
+    runTest("Box above the floor, before the wall, visible", boxVisible(culler, glm::vec3(0.0f, 10.0f, -20.0f), 2.0f));
+}
+
+// Test 4: Hidden answers checked against the true sphere
+void testSphereConservative() {
+    std::cout << "\n=== Test 4: Conservative Against True Shape ===" << std::endl;
+
+    // The tessellated sphere lies inside the unit sphere, so anything the
+    // culler hides must be hidden by the true sphere as well
+    const glm::vec3 eye(0.0f, 0.0f, 800.0f);
+    const glm::vec3 center(0.0f);
+    const float radius = 300.0f;
+    OcclusionCuller culler;
+    culler.beginFrame(makeViewProjection(eye, center));
+    TestMesh sphere = makeSphere(16, 32);
+    culler.addOccluder(sphere.view(), placeAt(center, radius));
+
+    auto rayBlocked = [&](const glm::vec3& point) {
+        glm::vec3 direction = point - eye;
+        float length = glm::length(direction);
+        direction /= length;
+        glm::vec3 toCenter = center - eye;
+        float along = glm::dot(toCenter, direction);
+        float missSq = glm::dot(toCenter, toCenter) - along * along;
+        if (missSq > radius * radius) return false;
+        float entry = along - std::sqrt(radius * radius - missSq);
+        return entry > 0.0f && entry < length;
+    };
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> coordinate(-1500.0f, 1500.0f);
+    std::uniform_real_distribution<float> size(1.0f, 30.0f);
+    size_t hidden = 0;
+    size_t wrong = 0;
+    for (int i = 0; i < 4000; ++i) {
+        glm::vec3 boxCenter(coordinate(rng), coordinate(rng) * 0.5f, coordinate(rng) - 600.0f);
+        float halfSize = size(rng);
+        if (boxVisible(culler, boxCenter, halfSize)) continue;
+        ++hidden;
+        for (int corner = 0; corner < 8; ++corner) {
+            glm::vec3 offset((corner & 1) ? halfSize : -halfSize, (corner & 2) ? halfSize : -halfSize,
+                             (corner & 4) ? halfSize : -halfSize);
+            if (!rayBlocked(boxCenter + offset)) {
+                ++wrong;
+                break;
+            }
+        }
+    }
+    std::cout << "  " << hidden << " of 4000 boxes hidden" << std::endl;
+    runTest("Some boxes hidden behind the sphere", hidden > 100);
+    runTest("Every hidden box is behind the true sphere", wrong == 0, std::to_string(wrong) + " wrongly hidden");
+}
+
+// Test 5: Station scene cost per frame
+void testStationScene() {
+    std::cout << "\n=== Test 5: Station Scene ===" << std::endl;
+
+    const int SHIPS = 5000;
+    const int FRAMES = 20;
+    TestMesh station = makeSphere(24, 48);    // 2304 triangles
+    TestMesh rock = makeSphere(8, 16);
+
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> coordinate(-2500.0f, 2500.0f);
+    std::vector<glm::vec3> ships;
+    for (int i = 0; i < SHIPS; ++i) {
+        ships.emplace_back(coordinate(rng), coordinate(rng) * 0.3f, coordinate(rng) - 1500.0f);
+    }
+    std::vector<glm::vec3> rocks = { { -700.0f, 0.0f, -300.0f }, { 600.0f, 100.0f, -200.0f }, { 200.0f, -150.0f, 100.0f } };
+
+    OcclusionCuller culler;
+    glm::mat4 viewProjection = makeViewProjection(glm::vec3(0.0f, 50.0f, 900.0f), glm::vec3(0.0f, 0.0f, -500.0f));
+    OcclusionStats total;
+    size_t visible = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        culler.beginFrame(viewProjection);
+        culler.addOccluder(station.view(), placeAt(glm::vec3(0.0f, 0.0f, -500.0f), 600.0f));
+        for (const auto& position : rocks) culler.addOccluder(rock.view(), placeAt(position, 120.0f));
+
+        visible = 0;
+        for (const auto& ship : ships) {
+            if (boxVisible(culler, ship, 8.0f)) ++visible;
+        }
+        const OcclusionStats& stats = culler.getStats();
+        total.rasterMs += stats.rasterMs;
+        total.pyramidMs += stats.pyramidMs;
+        total.testMs += stats.testMs;
+    }
+    double frameMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / FRAMES;
+    const OcclusionStats& stats = culler.getStats();
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "  Occluders: " << stats.occluders << " (" << stats.occluderTriangles << " triangles, "
+              << stats.trianglesRasterized << " rasterised) into " << culler.getWidth() << "x" << culler.getHeight()
+              << std::endl
+              << "  Ships: " << SHIPS << ", hidden: " << stats.occluded << " (" << std::setprecision(1)
+              << stats.occludedRate() * 100.0f << "%)" << std::endl
+              << std::setprecision(3)
+              << "  Per frame: raster " << total.rasterMs / FRAMES << " ms, pyramid " << total.pyramidMs / FRAMES
+              << " ms, tests " << total.testMs / FRAMES << " ms, total " << frameMs << " ms" << std::endl;
+
+    runTest("Station hides part of the fleet", stats.occluded > static_cast<size_t>(SHIPS / 20) &&
+            visible + stats.occluded == static_cast<size_t>(SHIPS));
+    runTest("Every ship tested", stats.tested == static_cast<size_t>(SHIPS));
+}
+
+int main() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Occlusion Culling Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testEmpty();
+    testWall();
+    testNearClipping();
+    testSphereConservative();
+    testStationScene();
+
+    printTestSummary();
+
+    // Return 0 if all tests passed, 1 otherwise
+    for (const auto& result : g_testResults) {
+        if (!result.passed) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,438 @@
+/**
+ * Test program for the CPU particle simulation
+ * Validates integration, swap-remove, the particle budget, threaded updates,
+ * parallel burst spawning and vertex streaming output, and benchmarks a million particles against
+ * the old array-of-structs update, all without a GPU.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "rendering/particle_simulation.h"
+
+using namespace atlas;
+
+// Simple test framework
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string message;
+};
+
+std::vector<TestResult> g_testResults;
+
+void runTest(const std::string& name, bool result, const std::string& message = "") {
+    g_testResults.push_back({name, result, message});
+    std::cout << (result ? "[PASS] " : "[FAIL] ") << name;
+    if (!message.empty() && !result) {
+        std::cout << ": " << message;
+    }
+    std::cout << std::endl;
+}
+
+void printTestSummary() {
+    int passed = 0;
+    int failed = 0;
+
+    for (const auto& result : g_testResults) {
+        if (result.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Test Summary: " << passed << " passed, " << failed << " failed" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+}
+
+// Particle whose size doubles as an identifier
+Particle makeParticle(ParticleRandom& random, float id) {
+    Particle p;
+    p.position = random.inSphere(50.0f);
+    p.velocity = random.inSphere(10.0f);
+    p.color = glm::vec4(1.0f, 0.5f, 0.25f, 1.0f);
+    p.life = random.uniform(0.05f, 2.0f);
+    p.maxLife = p.life;
+    p.size = id;
+    return p;
+}
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Test 1: Random numbers
+void testRandom() {
+    std::cout << "\n=== Test 1: Emitter Random Numbers ===" << std::endl;
+
+    ParticleRandom a(42);
+    ParticleRandom b(42);
+    ParticleRandom c(43);
+    bool same = true;
+    bool differs = false;
+    for (int i = 0; i < 100; ++i) {
+        uint32_t value = a.next();
+        same = same && value == b.next();
+        differs = differs || value != c.next();
+    }
+    runTest("Same seed replays the same stream", same);
+    runTest("Different seeds differ", differs);
+
+    bool inRange = true;
+    double sum = 0.0;
+    bool inSphere = true;
+    const int SAMPLES = 100000;
+    for (int i = 0; i < SAMPLES; ++i) {
+        float value = a.uniform(2.0f, 4.0f);
+        inRange = inRange && value >= 2.0f && value < 4.0f;
+        sum += value;
+        inSphere = inSphere && glm::length(a.inSphere(3.0f)) <= 3.0f + 1e-4f;
+    }
+    double mean = sum / SAMPLES;
+    runTest("Uniform stays in range", inRange);
+    runTest("Uniform mean near the middle", std::abs(mean - 3.0) < 0.02, "mean " + std::to_string(mean));
+    runTest("Sphere points within the radius", inSphere);
+}
+
+// Test 2: Integration matches the per-particle update
+void testIntegration() {
+    std::cout << "\n=== Test 2: Vectorised Integration ===" << std::endl;
+
+    ParticleRandom random(7);
+    ParticlePool pool;
+    std::vector<Particle> reference;
+    const int COUNT = 1003;   // leaves a scalar tail for every SIMD width
+    for (int i = 0; i < COUNT; ++i) {
+        Particle p = makeParticle(random, static_cast<float>(i));
+        p.life = 100.0f;
+        pool.add(p);
+        reference.push_back(p);
+    }
+
+    for (int step = 0; step < 10; ++step) {
+        pool.integrate(0, pool.size(), 0.016f);
+        for (auto& p : reference) p.update(0.016f);
+    }
+
+    bool match = pool.size() == reference.size();
+    for (size_t i = 0; match && i < reference.size(); ++i) {
+        Particle p = pool.get(i);
+        match = glm::length(p.position - reference[i].position) < 1e-4f &&
+                std::abs(p.life - reference[i].life) < 1e-5f && p.size == reference[i].size;
+    }
+    runTest("SoA pool matches Particle::update", match);
+
+    // Ranges update independently
+    ParticlePool split;
+    ParticleRandom again(7);
+    for (int i = 0; i < COUNT; ++i) {
+        Particle p = makeParticle(again, static_cast<float>(i));
+        p.life = 100.0f;
+        split.add(p);
+    }
+    split.integrate(0, 500, 0.5f);
+    split.integrate(500, 2000, 0.5f);   // end clamps to the live count
+    ParticlePool whole;
+    ParticleRandom third(7);
+    for (int i = 0; i < COUNT; ++i) {
+        Particle p = makeParticle(third, static_cast<float>(i));
+        p.life = 100.0f;
+        whole.add(p);
+    }
+    whole.integrate(0, whole.size(), 0.5f);
+    bool rangesMatch = true;
+    for (size_t i = 0; i < whole.size(); ++i) {
+        rangesMatch = rangesMatch && whole.get(i).position == split.get(i).position;
+    }
+    runTest("Split ranges match one pass", rangesMatch);
+
+    pool.clear();
+    runTest("Clear empties the pool", pool.empty());
+}
+
+// Test 3: Swap-remove
+void testSwapRemove() {
+    std::cout << "\n=== Test 3: Swap-Remove ===" << std::endl;
+
+    ParticleRandom random(11);
+    ParticlePool pool;
+    std::vector<float> expected;
+    for (int i = 0; i < 5000; ++i) {
+        Particle p = makeParticle(random, static_cast<float>(i));
+        // Every third dies this frame, including the last one
+        p.life = (i % 3 == 0 || i == 4999) ? 0.01f : 1.0f;
+        if (!(i % 3 == 0 || i == 4999)) expected.push_back(p.size);
+        pool.add(p);
+    }
+
+    size_t removed = pool.update(0.02f);
+    std::vector<float> survivors;
+    bool allAlive = true;
+    for (size_t i = 0; i < pool.size(); ++i) {
+        Particle p = pool.get(i);
+        survivors.push_back(p.size);
+        allAlive = allAlive && p.isAlive();
+    }
+    std::sort(survivors.begin(), survivors.end());
+
+    runTest("Removed count", removed == 5000 - expected.size(), std::to_string(removed));
+    runTest("Only live particles remain", allAlive);
+    runTest("Every survivor kept exactly once", survivors == expected);
+    runTest("Colour round trip", glm::length(pool.get(0).color - glm::vec4(1.0f, 0.5f, 0.25f, 1.0f)) < 0.01f);
+
+    pool.update(5.0f);
+    runTest("Everything expires", pool.empty());
+}
+
+// Test 4: Shared particle budget
+void testBudget() {
+    std::cout << "\n=== Test 4: Particle Budget ===" << std::endl;
+
+    ParticleSimulation simulation(100, 1);
+    ParticleRandom random(3);
+    int accepted = 0;
+    for (int i = 0; i < 150; ++i) {
+        EmitterType type = (i % 2) ? EmitterType::EXPLOSION : EmitterType::DEBRIS;
+        Particle p = makeParticle(random, static_cast<float>(i));
+        p.life = 1.0f;
+        if (simulation.add(type, p)) ++accepted;
+    }
+    runTest("Budget caps live particles", accepted == 100 && simulation.getParticleCount() == 100);
+    runTest("Emitters keep their own particles",
+            simulation.getEmitter(EmitterType::EXPLOSION).size() + simulation.getEmitter(EmitterType::DEBRIS).size() == 100);
+
+    simulation.update(0.1f);
+    runTest("Rejected spawns reported", simulation.getStats().rejected == 50);
+    simulation.update(2.0f);
+    runTest("Budget frees as particles die", simulation.getParticleCount() == 0 &&
+            simulation.add(EmitterType::DEBRIS, makeParticle(random, 0.0f)));
+    runTest("Default budget of a million", ParticleSimulation::DEFAULT_MAX_PARTICLES >= 1000000);
+}
+
+// Test 5: Threaded updates and streaming output
+void testThreaded() {
+    std::cout << "\n=== Test 5: Threaded Update ===" << std::endl;
+
+    ParticleSimulation single(1u << 20, 1);
+    ParticleSimulation threaded(1u << 20, 4);
+    threaded.setSplitSize(1000);
+    ParticleRandom random(19);
+    for (int i = 0; i < 60000; ++i) {
+        EmitterType type = static_cast<EmitterType>(i % ParticleSimulation::EMITTER_COUNT);
+        Particle p = makeParticle(random, static_cast<float>(i));
+        single.add(type, p);
+        threaded.add(type, p);
+    }
+
+    for (int step = 0; step < 20; ++step) {
+        single.update(0.05f);
+        threaded.update(0.05f);
+    }
+
+    std::vector<ParticleVertex> a(single.getParticleCount());
+    std::vector<ParticleVertex> b(threaded.getParticleCount());
+    size_t written = single.writeVertices(a.data());
+    threaded.writeVertices(b.data());
+    bool same = a.size() == b.size() && written == a.size();
+    for (size_t i = 0; same && i < a.size(); ++i) {
+        same = a[i].position == b[i].position && a[i].size == b[i].size &&
+               std::equal(a[i].color, a[i].color + 4, b[i].color);
+    }
+    runTest("Threaded update matches single thread", same);
+    runTest("Update shared between threads", threaded.getStats().tasks == 4);
+    runTest("Some particles died, some live", single.getParticleCount() > 0 && single.getParticleCount() < 60000);
+    runTest("Vertex colour packed", !a.empty() && a[0].color[0] == 255 && a[0].color[1] == 128 &&
+            a[0].color[2] == 64 && a[0].color[3] == 255);
+    runTest("Vertex is 20 bytes", sizeof(ParticleVertex) == 20);
+}
+
+// Test 6: Bursts created in parallel by update()
+std::vector<ParticleVertex> spawnScene(unsigned int threads, size_t budget, ParticleUpdateStats& stats) {
+    ParticleSimulation simulation(budget, threads);
+    for (int i = 0; i < 40; ++i) {
+        ParticleBurst burst;
+        burst.type = static_cast<EmitterType>(i % ParticleSimulation::EMITTER_COUNT);
+        burst.position = glm::vec3(static_cast<float>(i), 0.0f, 0.0f);
+        burst.direction = glm::vec3(0.0f, 0.0f, 100.0f);
+        burst.color = glm::vec4(0.2f, 0.4f, 0.8f, 1.0f);
+        burst.count = (i == 5) ? 5000 : 50;   // one burst spans several chunks
+        simulation.spawn(burst);
+    }
+    simulation.update(0.0f);
+    stats = simulation.getStats();
+    std::vector<ParticleVertex> vertices(simulation.getParticleCount());
+    simulation.writeVertices(vertices.data());
+    return vertices;
+}
+
+void testSpawn() {
+    std::cout << "\n=== Test 6: Parallel Spawning ===" << std::endl;
+
+    ForkJoinPool tasks(4);
+    std::vector<int> hits(1000, 0);
+    unsigned int shared = tasks.forEach(hits.size(), [&](size_t i, unsigned int) { ++hits[i]; });
+    std::atomic<unsigned int> ran(0);
+    tasks.run(3, [&](unsigned int index) { ran += 1u << index; });
+    runTest("Pool visits every item once", shared == 4 &&
+            std::all_of(hits.begin(), hits.end(), [](int h) { return h == 1; }));
+    runTest("Pool runs each task index once", ran == 7u);
+
+    ParticleSimulation simulation(1u << 20, 2);
+    ParticleBurst burst;
+    burst.type = EmitterType::EXPLOSION;
+    burst.position = glm::vec3(10.0f, 20.0f, 30.0f);
+    burst.scale = 2.0f;
+    burst.count = 100;
+    simulation.spawn(burst);
+    runTest("Bursts wait for update", simulation.getParticleCount() == 0 && simulation.getPendingCount() == 100);
+    simulation.update(0.0f);
+    const ParticlePool& explosion = simulation.getEmitter(EmitterType::EXPLOSION);
+    bool atOrigin = explosion.size() == 100;
+    for (size_t i = 0; atOrigin && i < explosion.size(); ++i) {
+        Particle p = explosion.get(i);
+        atOrigin = p.position == burst.position && glm::length(p.velocity) <= 20.0f + 1e-3f &&
+                   p.size >= 2.0f && p.size <= 6.0f && p.life == p.maxLife;
+    }
+    runTest("Burst created by update", simulation.getParticleCount() == 100 &&
+            simulation.getPendingCount() == 0 && simulation.getStats().spawned == 100);
+    runTest("Explosion shape", atOrigin);
+
+    ParticleBurst beam;
+    beam.type = EmitterType::WEAPON_BEAM;
+    beam.position = glm::vec3(0.0f);
+    beam.direction = glm::vec3(100.0f, 0.0f, 0.0f);
+    beam.color = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f);
+    beam.count = 10;
+    simulation.spawn(beam);
+    simulation.update(0.0f);
+    const ParticlePool& beamPool = simulation.getEmitter(EmitterType::WEAPON_BEAM);
+    bool alongBeam = beamPool.size() == 10;
+    for (size_t i = 0; alongBeam && i < beamPool.size(); ++i) {
+        Particle p = beamPool.get(i);
+        alongBeam = std::abs(p.position.x - 10.0f * static_cast<float>(i)) <= 0.3f + 1e-3f &&
+                    p.color.g > 0.99f && p.color.r < 0.01f;
+    }
+    runTest("Beam particles spaced along the line", alongBeam);
+
+    ParticleUpdateStats singleStats, threadedStats;
+    std::vector<ParticleVertex> a = spawnScene(1, 1u << 20, singleStats);
+    std::vector<ParticleVertex> b = spawnScene(4, 1u << 20, threadedStats);
+    bool same = a.size() == b.size() && a.size() == 5000 + 39 * 50;
+    for (size_t i = 0; same && i < a.size(); ++i) {
+        same = a[i].position == b[i].position && a[i].size == b[i].size &&
+               std::equal(a[i].color, a[i].color + 4, b[i].color);
+    }
+    runTest("Spawning matches across thread counts", same);
+
+    ParticleUpdateStats cappedStats;
+    std::vector<ParticleVertex> capped = spawnScene(4, 1000, cappedStats);
+    runTest("Budget truncates bursts", capped.size() == 1000 && cappedStats.spawned == 1000 &&
+            cappedStats.rejected == a.size() - 1000, std::to_string(cappedStats.rejected));
+}
+
+// Test 7: A million particles
+void testBenchmark() {
+    std::cout << "\n=== Test 7: Million Particle Benchmark ===" << std::endl;
+
+    const size_t COUNT = 1000000;
+    const int FRAMES = 20;
+    const float DT = 1.0f / 60.0f;
+
+    // Long-lived particles with a steady trickle of deaths and respawns
+    auto makeSteady = [](ParticleRandom& random, size_t i) {
+        Particle p = makeParticle(random, static_cast<float>(i));
+        p.life = random.uniform(0.1f, 10.0f);
+        return p;
+    };
+
+    // The previous array-of-structs update
+    std::vector<Particle> particles;
+    particles.reserve(COUNT);
+    ParticleRandom random(23);
+    for (size_t i = 0; i < COUNT; ++i) particles.push_back(makeSteady(random, i));
+    double aosMs = 0.0;
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        auto start = std::chrono::steady_clock::now();
+        for (auto& particle : particles) particle.update(DT);
+        particles.erase(std::remove_if(particles.begin(), particles.end(),
+                                       [](const Particle& p) { return !p.isAlive(); }),
+                        particles.end());
+        aosMs += millisecondsSince(start);
+        while (particles.size() < COUNT) particles.push_back(makeSteady(random, particles.size()));
+    }
+    aosMs /= FRAMES;
+
+    auto runSimulation = [&](unsigned int threads, double& updateMs, double& writeMs) {
+        ParticleSimulation simulation(COUNT, threads);
+        ParticleRandom spawn(23);
+        for (size_t i = 0; i < COUNT; ++i) {
+            simulation.add(static_cast<EmitterType>(i % ParticleSimulation::EMITTER_COUNT), makeSteady(spawn, i));
+        }
+        std::vector<ParticleVertex> vertices(COUNT);
+        updateMs = 0.0;
+        writeMs = 0.0;
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            auto updateStart = std::chrono::steady_clock::now();
+            simulation.update(DT);
+            updateMs += millisecondsSince(updateStart);
+            size_t index = simulation.getParticleCount();
+            while (simulation.add(static_cast<EmitterType>(index % ParticleSimulation::EMITTER_COUNT),
+                                  makeSteady(spawn, index))) {
+                ++index;
+            }
+            auto writeStart = std::chrono::steady_clock::now();
+            simulation.writeVertices(vertices.data());
+            writeMs += millisecondsSince(writeStart);
+        }
+        updateMs /= FRAMES;
+        writeMs /= FRAMES;
+        return simulation.getParticleCount();
+    };
+
+    double singleMs = 0.0, singleWriteMs = 0.0;
+    size_t live = runSimulation(1, singleMs, singleWriteMs);
+    double threadedMs = 0.0, threadedWriteMs = 0.0;
+    ParticleSimulation probe;
+    runSimulation(0, threadedMs, threadedWriteMs);
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "  Particles: " << live << ", SIMD width " << ParticleSimulation::getSimdWidth() << std::endl
+              << "  AoS update + remove_if: " << aosMs << " ms" << std::endl
+              << "  SoA update, 1 thread: " << singleMs << " ms (" << aosMs / singleMs << "x)" << std::endl
+              << "  SoA update, " << probe.getThreadCount() << " threads: " << threadedMs << " ms ("
+              << aosMs / threadedMs << "x)" << std::endl
+              << "  Vertex write: " << singleWriteMs << " ms" << std::endl;
+
+    runTest("Million particles kept live", live == COUNT);
+    runTest("SoA update faster than AoS", singleMs < aosMs);
+}
+
+int main() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Particle Simulation Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testRandom();
+    testIntegration();
+    testSwapRemove();
+    testBudget();
+    testThreaded();
+    testSpawn();
+    testBenchmark();
+
+    printTestSummary();
+
+    // Return 0 if all tests passed, 1 otherwise
+    for (const auto& result : g_testResults) {
+        if (!result.passed) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,307 @@
+/**
+ * Test program for the entity render queue
+ * Validates grouping by mesh and material, instance ranges, draw order and
+ * the draw-call counters without a GPU: the queued type is a stand-in, not
+ * a Mesh.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include "rendering/render_queue.h"
+
+using namespace atlas;
+
+// Simple test framework
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string message;
+};
+
+std::vector<TestResult> g_testResults;
+
+void runTest(const std::string& name, bool result, const std::string& message = "") {
+    g_testResults.push_back({name, result, message});
+    std::cout << (result ? "[PASS] " : "[FAIL] ") << name;
+    if (!message.empty() && !result) {
+        std::cout << ": " << message;
+    }
+    std::cout << std::endl;
+}
+
+void printTestSummary() {
+    int passed = 0;
+    int failed = 0;
+
+    for (const auto& result : g_testResults) {
+        if (result.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Test Summary: " << passed << " passed, " << failed << " failed" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+}
+
+// Stand-in for a GPU mesh
+struct FakeMesh {
+    int id;
+};
+
+using FakeQueue = RenderQueue<FakeMesh>;
+
+// A fleet: hulls of a few variants, each of several meshes, in a few materials
+struct Fleet {
+    std::vector<std::shared_ptr<FakeMesh>> meshes;
+    size_t materials = 3;
+    size_t ships = 500;
+};
+
+Fleet makeFleet(size_t meshCount) {
+    Fleet fleet;
+    for (size_t i = 0; i < meshCount; ++i) {
+        fleet.meshes.push_back(std::make_shared<FakeMesh>(FakeMesh{ static_cast<int>(i) }));
+    }
+    return fleet;
+}
+
+// Submit every ship's mesh in shuffled order; customFloat1 carries the
+// submission number so instances can be traced through build()
+void submitFleet(FakeQueue& queue, const Fleet& fleet, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> pickMesh(0, fleet.meshes.size() - 1);
+    std::uniform_int_distribution<uint32_t> pickMaterial(0, static_cast<uint32_t>(fleet.materials - 1));
+    std::uniform_real_distribution<float> pickDepth(1.0f, 5000.0f);
+
+    for (size_t i = 0; i < fleet.ships; ++i) {
+        InstanceData instance;
+        instance.customFloat1 = static_cast<float>(i);
+        instance.customFloat2 = pickDepth(rng);
+        queue.submit(fleet.meshes[pickMesh(rng)], pickMaterial(rng), instance, instance.customFloat2);
+    }
+}
+
+float maxDifference(const glm::mat4& a, const glm::mat4& b) {
+    float difference = 0.0f;
+    for (int c = 0; c < 4; ++c) {
+        for (int r = 0; r < 4; ++r) {
+            difference = std::max(difference, std::abs(a[c][r] - b[c][r]));
+        }
+    }
+    return difference;
+}
+
+void testTransform() {
+    std::cout << "\n=== Test 1: Entity Transform ===" << std::endl;
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> angle(-glm::radians(180.0f), glm::radians(180.0f));
+    std::uniform_real_distribution<float> coordinate(-10000.0f, 10000.0f);
+    std::uniform_real_distribution<float> size(0.1f, 40.0f);
+
+    float worst = 0.0f;
+    for (int i = 0; i < 1000; ++i) {
+        glm::vec3 position(coordinate(rng), coordinate(rng), coordinate(rng));
+        glm::vec3 rotation(angle(rng), angle(rng), angle(rng));
+        float scale = size(rng);
+
+        // The chain Renderer::renderEntities used to build per entity
+        glm::mat4 expected = glm::mat4(1.0f);
+        expected = glm::translate(expected, position);
+        expected = glm::rotate(expected, rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
+        expected = glm::rotate(expected, rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
+        expected = glm::rotate(expected, rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
+        expected = glm::scale(expected, glm::vec3(scale));
+
+        glm::mat4 composed = composeEntityTransform(position, rotation, scale);
+        // Relative to the largest entries: translation and scale
+        float magnitude = std::max(1.0f, std::max(glm::length(position), scale));
+        worst = std::max(worst, maxDifference(expected, composed) / magnitude);
+    }
+    std::cout << "  Worst relative difference: " << worst << std::endl;
+    runTest("Composed transform matches translate/rotate/scale chain", worst < 1e-5f);
+
+    glm::mat4 identity = composeEntityTransform(glm::vec3(0.0f), glm::vec3(0.0f), 1.0f);
+    runTest("Zero rotation at the origin is identity", maxDifference(identity, glm::mat4(1.0f)) == 0.0f);
+}
+
+void testGrouping() {
+    std::cout << "\n=== Test 2: Grouping ===" << std::endl;
+
+    Fleet fleet = makeFleet(12);
+    FakeQueue queue;
+    submitFleet(queue, fleet, 42);
+    runTest("Queue counts submissions", queue.size() == fleet.ships);
+    queue.build();
+
+    const auto& batches = queue.getBatches();
+    const auto& instances = queue.getInstances();
+    runTest("Every submission becomes one instance", instances.size() == fleet.ships);
+
+    // Ranges tile the instance array in order
+    bool contiguous = true;
+    size_t next = 0;
+    for (const auto& batch : batches) {
+        if (batch.firstInstance != next || batch.instanceCount == 0) contiguous = false;
+        next += batch.instanceCount;
+    }
+    runTest("Batch ranges tile the instance array", contiguous && next == instances.size());
+
+    std::set<int> seen;
+    for (const auto& instance : instances) seen.insert(static_cast<int>(instance.customFloat1));
+    runTest("Each submission appears exactly once", seen.size() == fleet.ships);
+
+    // One batch per (material, mesh) pair in use
+    std::set<std::pair<uint32_t, const FakeMesh*>> pairs;
+    for (const auto& batch : batches) pairs.insert({ batch.material, batch.mesh.get() });
+    runTest("One batch per mesh and material", pairs.size() == batches.size(),
+            std::to_string(pairs.size()) + " pairs, " + std::to_string(batches.size()) + " batches");
+    runTest("Batches no more than meshes times materials",
+            batches.size() <= fleet.meshes.size() * fleet.materials);
+
+    // Materials never return once left, so each shader binds once
+    bool materialsGrouped = true;
+    std::set<uint32_t> finished;
+    for (size_t i = 1; i < batches.size(); ++i) {
+        if (batches[i].material != batches[i - 1].material) {
+            finished.insert(batches[i - 1].material);
+            if (finished.count(batches[i].material)) materialsGrouped = false;
+        }
+    }
+    runTest("Materials are contiguous", materialsGrouped);
+    runTest("Material changes equal materials in use", queue.getStats().materialChanges == fleet.materials);
+
+    // Front to back within every batch
+    bool frontToBack = true;
+    for (const auto& batch : batches) {
+        for (size_t i = batch.firstInstance + 1; i < batch.firstInstance + batch.instanceCount; ++i) {
+            if (instances[i].customFloat2 < instances[i - 1].customFloat2) frontToBack = false;
+        }
+    }
+    runTest("Instances run front to back within a batch", frontToBack);
+
+    const RenderQueueStats& stats = queue.getStats();
+    std::cout << "  Draw calls: " << stats.items << " before, " << stats.drawCalls << " after ("
+              << stats.batchingFactor() << "x), " << stats.materialChanges << " material changes, "
+              << stats.meshChanges << " mesh changes" << std::endl;
+    runTest("Counters report draws before and after", stats.items == fleet.ships && stats.drawCalls == batches.size());
+    runTest("Fleet batches at least tenfold", stats.batchingFactor() >= 10.0f);
+}
+
+void testSharedMeshes() {
+    std::cout << "\n=== Test 3: Shared Meshes ===" << std::endl;
+
+    // Many entities sharing one model's meshes: one draw per mesh
+    Fleet fleet = makeFleet(3);
+    FakeQueue queue;
+    for (size_t i = 0; i < 200; ++i) {
+        InstanceData instance;
+        instance.customFloat1 = static_cast<float>(i);
+        for (const auto& mesh : fleet.meshes) queue.submit(mesh, 0, instance, static_cast<float>(200 - i));
+    }
+    queue.build();
+
+    runTest("One draw per shared mesh", queue.getStats().drawCalls == fleet.meshes.size());
+    runTest("Single material binds once", queue.getStats().materialChanges == 1);
+    bool complete = true;
+    for (const auto& batch : queue.getBatches()) {
+        if (batch.instanceCount != 200) complete = false;
+    }
+    runTest("Each mesh draws every entity", complete);
+
+    // Nothing drawable queued
+    FakeQueue empty;
+    InstanceData instance;
+    empty.submit(nullptr, 0, instance);
+    empty.build();
+    runTest("Null meshes are ignored", empty.size() == 0 && empty.getBatches().empty() &&
+            empty.getStats().drawCalls == 0 && empty.getStats().batchingFactor() == 0.0f);
+}
+
+void testReuse() {
+    std::cout << "\n=== Test 4: Frame Reuse ===" << std::endl;
+
+    Fleet fleet = makeFleet(12);
+    FakeQueue fresh;
+    submitFleet(fresh, fleet, 9);
+    fresh.build();
+
+    // A queue that already drew a different frame must give the same result
+    FakeQueue reused;
+    submitFleet(reused, fleet, 1);
+    reused.build();
+    reused.clear();
+    runTest("Clear empties the queue", reused.size() == 0 && reused.getBatches().empty() &&
+            reused.getInstances().empty() && reused.getStats().items == 0);
+    submitFleet(reused, fleet, 9);
+    reused.build();
+
+    bool same = fresh.getBatches().size() == reused.getBatches().size() &&
+                fresh.getInstances().size() == reused.getInstances().size();
+    for (size_t i = 0; same && i < fresh.getBatches().size(); ++i) {
+        const auto& a = fresh.getBatches()[i];
+        const auto& b = reused.getBatches()[i];
+        same = a.mesh == b.mesh && a.material == b.material &&
+               a.firstInstance == b.firstInstance && a.instanceCount == b.instanceCount;
+    }
+    for (size_t i = 0; same && i < fresh.getInstances().size(); ++i) {
+        same = fresh.getInstances()[i].customFloat1 == reused.getInstances()[i].customFloat1;
+    }
+    runTest("Reused queue builds the same batches", same);
+
+    // Building twice without new submissions is stable
+    reused.build();
+    runTest("Rebuild keeps counters", reused.getStats().items == fleet.ships &&
+            reused.getStats().drawCalls == fresh.getStats().drawCalls &&
+            reused.getStats().materialChanges == fresh.getStats().materialChanges);
+}
+
+void testBuildTime() {
+    std::cout << "\n=== Test 5: Build Time ===" << std::endl;
+
+    Fleet fleet = makeFleet(24);
+    fleet.ships = 5000;
+    FakeQueue queue;
+    const int frames = 20;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        queue.clear();
+        submitFleet(queue, fleet, static_cast<unsigned>(frame));
+        queue.build();
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+    std::cout << "  " << fleet.ships << " submissions: " << ms << " ms per frame, "
+              << queue.getStats().drawCalls << " draws" << std::endl;
+    runTest("Large frame batches", queue.getStats().drawCalls <= fleet.meshes.size() * fleet.materials);
+}
+
+int main() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Render Queue Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testTransform();
+    testGrouping();
+    testSharedMeshes();
+    testReuse();
+    testBuildTime();
+
+    printTestSummary();
+
+    // Return 0 if all tests passed, 1 otherwise
+    for (const auto& result : g_testResults) {
+        if (!result.passed) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+#ifndef EVE_CLUSTER_CLUSTER_NODE_H
+#define EVE_CLUSTER_CLUSTER_NODE_H
+
+#include "cluster/cluster_topology.h"
+#include "cluster/node_link.h"
+#include "data/world_persistence.h"
+#include "ecs/world.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+namespace cluster {
+
+/**
+ * @brief One simulation process in cluster mode
+ *
+ * Owns the solar systems assigned to it by the ClusterTopology and
+ * exchanges entities with peer nodes over NodeLinks.  Node-to-node
+ * messages are single-line JSON:
+ *
+ *   {"type":"entity_migrate","from_node":"alpha","to_system":"sys_b",
+ *    "entity_id":"player_1","resume_token":"9f...","entity":{...WorldPersistence entity...}}
+ *   {"type":"migrate_ack","entity_id":"player_1","ok":true}
+ *
+ * A migrating entity is released from the local world immediately and
+ * held in flight; the ack either drops it (the peer owns it now) or
+ * restores it locally.  Received messages are queued by the link reader
+ * threads and applied by update() on the simulation thread, so the world
+ * is never touched concurrently by cluster traffic.
+ *
+ * A migration may carry a resume token for the player session that
+ * follows the entity.  The receiving node keeps it with the adopted
+ * entity, and claimResume() accepts it exactly once, so a connect can
+ * only take over a ship that really arrived by handoff.
+ */
+class ClusterNode {
+public:
+    /// Outbound migration finished; ok=false means the entity was restored here
+    using MigrationCallback = std::function<void(const std::string& entity_id,
+                                                 const std::string& to_node, bool ok)>;
+    /// An entity arrived from a peer node and is now in the local world
+    using ArrivalCallback = std::function<void(const std::string& entity_id,
+                                               const std::string& from_node)>;
+
+    ClusterNode(const std::string& node_id, const ClusterTopology& topology,
+                ecs::World* world);
+    ~ClusterNode();
+
+    ClusterNode(const ClusterNode&) = delete;
+    ClusterNode& operator=(const ClusterNode&) = delete;
+
+    /// Start accepting peer links (defaults to this node's topology endpoint)
+    bool start(const std::string& listen_endpoint = "");
+    void stop();
+
+    const std::string& getNodeId() const { return node_id_; }
+    const ClusterTopology& getTopology() const { return topology_; }
+    uint16_t getListenPort() const { return listener_.getPort(); }
+
+    bool ownsSystem(const std::string& system_id) const;
+
+    /// Reach a peer at a different endpoint than the topology lists
+    void setPeerEndpoint(const std::string& node_id, const std::string& endpoint);
+
+    /**
+     * @brief Hand an entity to the node owning @p to_system
+     * @param resume_token One-time secret the session presents on the peer
+     * @return false if the system is local/unknown, the entity is missing,
+     *         or the peer is unreachable (the entity then stays here)
+     */
+    bool migrateEntity(const std::string& entity_id, const std::string& to_system,
+                       const std::string& resume_token = "");
+
+    /**
+     * @brief Consume the resume token of an entity adopted by handoff
+     * @return true if @p entity_id arrived from a peer with @p token; a
+     *         matching token is dropped so it cannot be used again
+     */
+    bool claimResume(const std::string& entity_id, const std::string& token);
+
+    /// Apply queued peer messages; call once per tick on the simulation thread
+    void update();
+
+    void setMigrationCallback(MigrationCallback cb) { on_migrated_ = std::move(cb); }
+    void setArrivalCallback(ArrivalCallback cb) { on_arrival_ = std::move(cb); }
+
+    size_t getInFlightCount() const { return in_flight_.size(); }
+    uint64_t getMigratedOutCount() const { return migrated_out_; }
+    uint64_t getMigratedInCount() const { return migrated_in_; }
+    uint64_t getFailedMigrationCount() const { return failed_migrations_; }
+
+private:
+    struct InFlight {
+        std::unique_ptr<ecs::Entity> entity;
+        std::string to_node;
+    };
+
+    struct Incoming {
+        std::shared_ptr<NodeLink> link;
+        std::string line;
+    };
+
+    std::shared_ptr<NodeLink> linkTo(const std::string& node_id);
+    void attach(const std::shared_ptr<NodeLink>& link);
+    void handleMigrate(const std::shared_ptr<NodeLink>& link, const std::string& line);
+    void handleAck(const std::string& line);
+    void finishMigration(const std::string& entity_id, bool ok);
+
+    std::string node_id_;
+    ClusterTopology topology_;
+    ecs::World* world_;
+    data::WorldPersistence persistence_;
+
+    NodeListener listener_;
+    std::map<std::string, std::string> peer_endpoints_;
+    std::map<std::string, std::shared_ptr<NodeLink>> outbound_;
+    std::vector<std::shared_ptr<NodeLink>> links_;   // every live link (both directions)
+    std::mutex links_mutex_;
+
+    std::vector<Incoming> inbox_;
+    std::mutex inbox_mutex_;
+
+    std::unordered_map<std::string, InFlight> in_flight_;
+    std::unordered_map<std::string, std::string> resume_tokens_;  // adopted entity -> token
+    MigrationCallback on_migrated_;
+    ArrivalCallback on_arrival_;
+
+    uint64_t migrated_out_ = 0;
+    uint64_t migrated_in_ = 0;
+    uint64_t failed_migrations_ = 0;
+};
+
+} // namespace cluster
+} // namespace atlas
+
+#endif // EVE_CLUSTER_CLUSTER_NODE_H
@@ -0,0 +1,113 @@
+#ifndef EVE_CLUSTER_CLUSTER_PROXY_H
+#define EVE_CLUSTER_CLUSTER_PROXY_H
+
+#include "cluster/cluster_topology.h"
+#include "cluster/node_link.h"
+#include "network/tcp_server.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace atlas {
+namespace cluster {
+
+/**
+ * @brief Client-facing front end of a multi-process cluster
+ *
+ * Terminates game client TCP connections and relays each session to the
+ * node currently simulating the player.  New sessions go to the node that
+ * owns the "entry_system" named in the connect message (or the first node
+ * in the topology).  When a node answers with session_redirect after a
+ * cross-node jump, the proxy reconnects the session to the new owner and
+ * resumes it with a connect carrying "resume_entity"; the game client
+ * keeps its single TCP connection throughout.
+ *
+ * Node traffic is relayed whole message by whole message, so a redirect
+ * split across reads is still recognised.  Node connections are opened
+ * and client sends made outside the session lock.
+ */
+class ClusterProxy {
+public:
+    ClusterProxy(const ClusterTopology& topology, const std::string& host,
+                 uint16_t port, int max_connections = 100);
+    ~ClusterProxy();
+
+    ClusterProxy(const ClusterProxy&) = delete;
+    ClusterProxy& operator=(const ClusterProxy&) = delete;
+
+    bool start();
+    void stop();
+
+    /// Reach a node's game port at a different address than the topology lists
+    void setNodeAddress(const std::string& node_id, const std::string& endpoint);
+
+    /// Actual listening port (useful when constructed with port 0)
+    uint16_t getPort() const { return server_.getPort(); }
+
+    size_t getSessionCount() const;
+    /// Node currently serving a client socket ("" if none)
+    std::string getSessionNode(int client_socket) const;
+    uint64_t getRedirectCount() const { return redirect_count_; }
+
+private:
+    /**
+     * Reassembles node → client messages.  The game server writes JSON
+     * objects back to back, newline-terminated or not; a message is
+     * complete when its top-level object closes.
+     */
+    class MessageFramer {
+    public:
+        /// Append @p data; returns the bytes of every message it completes
+        /// (separators included) and adds each message to @p messages
+        std::string feed(const std::string& data, std::vector<std::string>& messages);
+        void reset();
+
+    private:
+        std::string buffer_;
+        size_t scan_ = 0;        // next byte of buffer_ to examine
+        int depth_ = 0;
+        bool in_string_ = false;
+        bool escape_ = false;
+    };
+
+    struct Session {
+        network::ClientConnection client;
+        std::shared_ptr<NodeLink> upstream;
+        std::string node_id;
+        std::string player_id;        // as escaped in the connect message
+        std::string character_name;
+        MessageFramer framer;     // bytes from upstream not yet relayed
+    };
+
+    void onClientMessage(const network::ClientConnection& client, const std::string& raw);
+    void onClientDisconnect(const network::ClientConnection& client);
+    void onUpstreamData(int client_socket, const std::shared_ptr<NodeLink>& from,
+                        const std::string& data);
+    void onUpstreamClosed(int client_socket, const std::shared_ptr<NodeLink>& closed);
+
+    void redirect(int client_socket, const std::shared_ptr<NodeLink>& from,
+                  const std::string& message);
+
+    /// Connect to a node's game port; call without holding sessions_mutex_
+    static std::shared_ptr<NodeLink> connectUpstream(const std::string& node_id,
+                                                     const std::string& endpoint);
+    /// Relay a connected upstream's traffic to the session's client
+    void startRelay(int client_socket, const std::shared_ptr<NodeLink>& link);
+    /// Caller holds sessions_mutex_
+    std::string nodeEndpoint(const std::string& node_id) const;
+
+    ClusterTopology topology_;
+    network::TCPServer server_;
+    std::map<std::string, std::string> node_addresses_;
+
+    std::map<int, Session> sessions_;   // keyed by client socket
+    mutable std::mutex sessions_mutex_;
+    uint64_t redirect_count_ = 0;
+};
+
+} // namespace cluster
+} // namespace atlas
+
+#endif // EVE_CLUSTER_CLUSTER_PROXY_H
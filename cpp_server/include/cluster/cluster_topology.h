@@ -0,0 +1,60 @@
+#ifndef EVE_CLUSTER_CLUSTER_TOPOLOGY_H
+#define EVE_CLUSTER_CLUSTER_TOPOLOGY_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace atlas {
+namespace cluster {
+
+/**
+ * @brief One simulation node in a multi-process cluster
+ */
+struct NodeInfo {
+    std::string node_id;
+    std::string client_host;       // where the proxy reaches the node's game port
+    uint16_t client_port = 0;
+    std::string node_endpoint;     // "host:port" or "unix:/path" for node-to-node links
+    std::vector<std::string> systems;
+};
+
+/**
+ * @brief Static map of which node owns which solar systems
+ *
+ * Parsed from the cluster_topology config string, one node per
+ * ';'-separated entry:
+ *
+ *   node_id|client_host:client_port|node_endpoint|system_a,system_b
+ *
+ * e.g. "alpha|127.0.0.1:8801|127.0.0.1:9801|sys_a;beta|127.0.0.1:8802|unix:/tmp/beta.sock|sys_b"
+ *
+ * Every process in the cluster (proxy and nodes) loads the same string.
+ */
+class ClusterTopology {
+public:
+    ClusterTopology() = default;
+
+    /// Parse a topology string; returns false (and stays empty) on malformed input
+    bool parse(const std::string& spec);
+
+    /// Node owning a solar system ("" if unassigned)
+    std::string ownerOf(const std::string& system_id) const;
+
+    const NodeInfo* getNode(const std::string& node_id) const;
+    const std::vector<NodeInfo>& getNodes() const { return nodes_; }
+    bool empty() const { return nodes_.empty(); }
+
+    /// Serialize back to the config string format
+    std::string toString() const;
+
+private:
+    std::vector<NodeInfo> nodes_;
+    std::map<std::string, std::string> system_owner_;
+};
+
+} // namespace cluster
+} // namespace atlas
+
+#endif // EVE_CLUSTER_CLUSTER_TOPOLOGY_H
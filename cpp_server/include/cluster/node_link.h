@@ -0,0 +1,116 @@
+#ifndef EVE_CLUSTER_NODE_LINK_H
+#define EVE_CLUSTER_NODE_LINK_H
+
+#include "network/tcp_server.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace atlas {
+namespace cluster {
+
+/**
+ * @brief Newline-framed stream connection between cluster processes
+ *
+ * Used for node-to-node traffic and for the proxy's upstream game
+ * connections.  Endpoints are either "host:port" (TCP) or "unix:/path"
+ * (Unix domain socket, POSIX only).  A reader thread delivers every
+ * complete line to the handler passed to start() and holds a reference
+ * to the link until the connection closes; sendLine() may be called
+ * from any thread.
+ */
+class NodeLink : public std::enable_shared_from_this<NodeLink> {
+public:
+    using LineHandler = std::function<void(const std::shared_ptr<NodeLink>& link,
+                                           const std::string& line)>;
+    /// Called once when the peer closes the connection
+    using CloseHandler = std::function<void(const std::shared_ptr<NodeLink>& link)>;
+
+    explicit NodeLink(socket_t socket);
+    ~NodeLink();
+
+    NodeLink(const NodeLink&) = delete;
+    NodeLink& operator=(const NodeLink&) = delete;
+
+    /// Connect to an endpoint; returns null on failure
+    static std::shared_ptr<NodeLink> connect(const std::string& endpoint);
+
+    /// Start the reader thread.  When @p raw is set, chunks are delivered
+    /// as received instead of being split on newlines.
+    void start(LineHandler on_line, CloseHandler on_close = nullptr, bool raw = false);
+
+    /// Send one message followed by a newline
+    bool sendLine(const std::string& line);
+
+    /// Send bytes as-is
+    bool sendRaw(const std::string& data);
+
+    /// Shut the connection down (the reader thread exits)
+    void close();
+
+    bool isOpen() const { return open_; }
+
+    /// True until the reader thread has delivered its last callback
+    bool isReading() const { return reading_; }
+
+    /// Block until the reader thread has delivered its last callback
+    /// (returns at once when called from that thread)
+    void waitUntilDone();
+
+private:
+    void readLoop();
+
+    socket_t socket_;
+    std::atomic<bool> open_;
+    std::atomic<bool> reading_{false};
+    std::mutex reading_mutex_;
+    std::condition_variable reading_done_;
+    std::mutex send_mutex_;
+    LineHandler on_line_;
+    CloseHandler on_close_;
+    bool raw_ = false;
+    std::thread reader_;
+};
+
+/**
+ * @brief Accepts NodeLink connections on an endpoint
+ */
+class NodeListener {
+public:
+    using AcceptHandler = std::function<void(std::shared_ptr<NodeLink> link)>;
+
+    NodeListener();
+    ~NodeListener();
+
+    NodeListener(const NodeListener&) = delete;
+    NodeListener& operator=(const NodeListener&) = delete;
+
+    /// Bind and start accepting.  "host:0" picks a free port (see getPort()).
+    bool listen(const std::string& endpoint, AcceptHandler on_accept);
+    void stop();
+
+    bool isListening() const { return running_; }
+    uint16_t getPort() const { return port_; }
+
+private:
+    void acceptLoop();
+
+    socket_t socket_;
+    std::string unix_path_;
+    uint16_t port_ = 0;
+    std::atomic<bool> running_;
+    AcceptHandler on_accept_;
+    std::thread accept_thread_;
+};
+
+/// Split "host:port" (returns false for unix endpoints or bad ports)
+bool parseHostPort(const std::string& endpoint, std::string& host, uint16_t& port);
+
+} // namespace cluster
+} // namespace atlas
+
+#endif // EVE_CLUSTER_NODE_LINK_H
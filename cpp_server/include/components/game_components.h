@@ -7,8 +7,12 @@
 #include <map>
 #include <algorithm>
 #include <cstdint>
+#include <utility>
 
 namespace atlas {
+namespace data {
+struct ShipStats;
+}
 namespace components {
 
 /**
@@ -119,6 +123,22 @@ public:
     COMPONENT_TYPE(Ship)
 };
 
+/**
+ * @brief Flyweight alternative to Ship for large NPC populations
+ *
+ * Points at an immutable, shared data::ShipStats record owned by
+ * data::ShipTemplateRegistry and stores only the stats this entity has
+ * changed.  Read and write through data::shipStat / data::setShipStat.
+ */
+class ShipTemplateRef : public ecs::Component {
+public:
+    const data::ShipStats* stats = nullptr;
+    std::vector<std::pair<uint8_t, float>> overrides;  // (data::ShipStat, value), sorted by stat
+    std::string ship_class;  // overrides the template's class when non-empty
+
+    COMPONENT_TYPE(ShipTemplateRef)
+};
+
 /**
  * @brief Targeting information
  */
@@ -317,6 +337,19 @@ public:
     COMPONENT_TYPE(SolarSystem)
 };
 
+/**
+ * @brief The solar system a ship is currently in
+ *
+ * Set at spawn and updated by gate and wormhole jumps.  With partitioned
+ * simulation the ship lives in this system's partition world.
+ */
+class SystemLocation : public ecs::Component {
+public:
+    std::string system_id;                // solar system entity id
+
+    COMPONENT_TYPE(SystemLocation)
+};
+
 /**
  * @brief A wormhole connection between two systems
  *
@@ -635,6 +668,7 @@ public:
     };
 
     std::string station_id;
+    std::string system_id;          // owning star system (for economy rollups)
     std::vector<Order> orders;
     double broker_fee_rate = 0.02;  // 2% broker fee
     double sales_tax_rate = 0.04;   // 4% sales tax
@@ -1824,6 +1858,11 @@ public:
     bool lockdown = false;
     float event_timer = 0.0f;           // countdown for active events
 
+    // Observation (fast-forward mode)
+    int observers = 0;                  // players currently in the system
+    bool dormant = false;               // suspended; advanced only in catch-ups
+    double synced_at = 0.0;             // simulation time the state reflects
+
     COMPONENT_TYPE(SimStarSystemState)
 };
 
@@ -1885,6 +1924,8 @@ public:
     float cargo_fill = 0.0f;           // 0.0-1.0 cargo space used
     float profit_target = 0.0f;         // target profit before docking
 
+    float deferred_time = 0.0f;         // time banked while the target system is dormant
+
     COMPONENT_TYPE(SimNPCIntent)
 };
 
@@ -39,11 +39,43 @@ struct ServerConfig {
     // Game settings
     float tick_rate = 30.0f;
     int max_entities = 10000;
+
+    // Simulation partitioning (one World per solar system)
+    bool partition_by_system = false;
+    int partition_workers = -1;      // -1 = hardware_concurrency - 1
+
+    // Time dilation: slows overloaded solar systems (or, unpartitioned,
+    // the whole world) and skips their steps to shed load
+    bool time_dilation = true;
+    float time_dilation_budget_ms = 25.0f;  // world step cost that triggers dilation
+    float time_dilation_floor = 0.1f;       // slowest allowed time rate
+
+    // Background simulation: only systems with players tick every frame,
+    // the rest catch up in coarse steps
+    bool background_fast_forward = true;
+
+    // Multi-process cluster mode
+    std::string cluster_role = "standalone";  // "standalone", "node" or "proxy"
+    std::string cluster_node_id = "";         // this process's id when role is "node"
+    std::string cluster_topology = "";        // see cluster::ClusterTopology::parse
     
     // Paths
     std::string data_path = "../data";
+    std::string data_bake_path = "./cache/static_data.bake";  // precompiled data_path JSON (empty = parse JSON)
     std::string save_path = "./saves";
     std::string log_path = "./logs";
+    std::string replay_record_path = "";  // record the session for --replay (empty = off)
+
+    // Logging
+    bool log_async = true;           // background writer with per-thread ring buffers
+    bool log_json = false;           // also write server.jsonl (one JSON object per line)
+    int log_max_file_mb = 64;        // rotate log files past this size (0 = never)
+    int log_max_files = 5;           // rotated files to keep
+
+    // Per-connection telemetry
+    float ping_interval_seconds = 5.0f;       // RTT probe period (0 = off)
+    std::string metrics_export_path = "";     // Prometheus text file (empty = off)
+    int metrics_export_interval_seconds = 15;
     
     // Load from JSON file
     bool loadFromFile(const std::string& filepath);
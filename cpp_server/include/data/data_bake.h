@@ -0,0 +1,81 @@
+#ifndef EVE_DATA_DATA_BAKE_H
+#define EVE_DATA_DATA_BAKE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace atlas {
+namespace data {
+
+class ShipDatabase;
+class NpcDatabase;
+class WormholeDatabase;
+
+/**
+ * @brief Precompiled static game data
+ *
+ * Compiles the JSON-backed ship, NPC and wormhole databases into one
+ * binary file: a header, fixed-layout record arrays and a table of
+ * interned, NUL-terminated strings that records refer to by offset.
+ * Loading a bake is an mmap, a bounds check of each section and one
+ * offset-to-pointer fixup per string — no text is parsed.
+ *
+ * The header carries a hash of every *.json file under the data
+ * directory; load() rebuilds the bake from JSON whenever that hash no
+ * longer matches, so editing data files needs no manual step.
+ */
+class DataBake {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    struct Report {
+        bool used_bake = false;        // templates came from the bake
+        bool rebuilt = false;          // bake was (re)written from JSON
+        uint64_t source_hash = 0;
+        double hash_ms = 0.0;          // time to hash the JSON sources
+        double load_ms = 0.0;          // time to fill the databases
+        double json_parse_ms = 0.0;    // JSON parse time (measured when baked)
+        size_t bake_bytes = 0;
+        size_t ships = 0;
+        size_t npcs = 0;
+        size_t wormhole_classes = 0;
+        size_t wormhole_effects = 0;
+    };
+
+    /**
+     * @brief Hash every *.json file below @p data_dir (path and contents)
+     */
+    static uint64_t hashSources(const std::string& data_dir);
+
+    /**
+     * @brief Write the given databases to @p bake_path
+     * @param json_parse_us How long the JSON load took, kept for reporting
+     */
+    static bool write(const std::string& bake_path, uint64_t source_hash,
+                      const ShipDatabase& ships, const NpcDatabase& npcs,
+                      const WormholeDatabase& wormholes, uint64_t json_parse_us = 0);
+
+    /**
+     * @brief Fill the non-null databases from a bake
+     * @return false if the file is missing, corrupt, from another version
+     *         or was built from sources with a different hash
+     */
+    static bool read(const std::string& bake_path, uint64_t expected_hash,
+                     ShipDatabase* ships, NpcDatabase* npcs,
+                     WormholeDatabase* wormholes, Report* report = nullptr);
+
+    /**
+     * @brief Load from the bake if it is current, otherwise parse the JSON,
+     *        rewrite the bake and fill the databases from the parse
+     *
+     * Any of the database pointers may be null.
+     */
+    static Report load(const std::string& data_dir, const std::string& bake_path,
+                       ShipDatabase* ships, NpcDatabase* npcs, WormholeDatabase* wormholes);
+};
+
+} // namespace data
+} // namespace atlas
+
+#endif // EVE_DATA_DATA_BAKE_H
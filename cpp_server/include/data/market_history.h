@@ -0,0 +1,175 @@
+#ifndef EVE_DATA_MARKET_HISTORY_H
+#define EVE_DATA_MARKET_HISTORY_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+namespace data {
+
+/**
+ * @brief Compact OHLC/volume time-series store for market trades
+ *
+ * Keeps one series per (hub, item) pair.  Every trade is rolled into
+ * three fixed-width bucket resolutions (5 min, 1 h, 1 day), each backed
+ * by a fixed-capacity ring so a series never grows past a known size.
+ * A per-hub aggregate series (item id "*") tracks total traded volume
+ * so economy code can read hub activity without scanning orders.
+ *
+ * Segments are written as fixed-layout little-endian POD records so a
+ * saved file can be mapped straight into memory and indexed by offset.
+ */
+class MarketHistory {
+public:
+    enum class Resolution : uint8_t {
+        FiveMinutes = 0,
+        OneHour     = 1,
+        OneDay      = 2
+    };
+    static constexpr int RESOLUTION_COUNT = 3;
+
+    /// Item id used for the per-hub aggregate series
+    static constexpr const char* HUB_AGGREGATE = "*";
+
+    /// One OHLC bucket (56 bytes, 8-byte aligned)
+    struct Bucket {
+        int64_t start_time = 0;     // seconds, aligned to resolution width
+        double open = 0.0;
+        double high = 0.0;
+        double low = 0.0;
+        double close = 0.0;
+        int64_t volume = 0;         // units traded
+        uint32_t trade_count = 0;
+        uint32_t reserved = 0;
+    };
+
+    /// Fixed-capacity ring of buckets for one resolution
+    struct Ring {
+        static constexpr int MAX_CAPACITY = 288;
+        uint32_t capacity = 0;
+        uint32_t count = 0;
+        uint32_t head = 0;          // index of the next slot to write
+        uint32_t reserved = 0;
+        double notional[MAX_CAPACITY] = {};  // sum(price * qty) per bucket
+        Bucket buckets[MAX_CAPACITY];
+
+        /// Bucket at logical position i (0 = oldest)
+        const Bucket& at(uint32_t i) const {
+            return buckets[(head + capacity - count + i) % capacity];
+        }
+        Bucket& at(uint32_t i) {
+            return buckets[(head + capacity - count + i) % capacity];
+        }
+        double notionalAt(uint32_t i) const {
+            return notional[(head + capacity - count + i) % capacity];
+        }
+    };
+
+    /// All resolutions for one (hub, item) pair
+    struct Series {
+        std::array<Ring, RESOLUTION_COUNT> rings;
+    };
+
+    MarketHistory();
+
+    /// Bucket width in seconds for a resolution
+    static int64_t bucketWidth(Resolution res);
+    /// Number of buckets retained for a resolution
+    static uint32_t bucketCapacity(Resolution res);
+    /// Parse "5m" / "1h" / "1d"; returns false on unknown strings
+    static bool parseResolution(const std::string& str, Resolution& out);
+    static const char* resolutionToString(Resolution res);
+
+    /**
+     * @brief Roll a trade into every resolution of the (hub, item) series
+     * @param time_seconds simulation time of the trade
+     */
+    void recordTrade(const std::string& hub_id, const std::string& item_id,
+                     double price, int quantity, double time_seconds);
+
+    /**
+     * @brief Buckets whose start time lies in [from_time, to_time]
+     *
+     * Returned oldest-first.  Uses binary search over the ring, so cost
+     * is O(log n + k) for k returned buckets.
+     */
+    std::vector<Bucket> query(const std::string& hub_id, const std::string& item_id,
+                              Resolution res, double from_time, double to_time) const;
+
+    /// Most recent `count` buckets (oldest-first)
+    std::vector<Bucket> latest(const std::string& hub_id, const std::string& item_id,
+                               Resolution res, int count) const;
+
+    /**
+     * @brief Volume-weighted average price over the last `buckets` buckets
+     * @return VWAP, or -1 if the series has no trades
+     */
+    double getAveragePrice(const std::string& hub_id, const std::string& item_id,
+                           Resolution res, int buckets) const;
+
+    /// Total units traded over the last `buckets` buckets (0 if unknown)
+    int64_t getVolume(const std::string& hub_id, const std::string& item_id,
+                      Resolution res, int buckets) const;
+
+    /// Total units traded at a hub across all items over the last `buckets` buckets
+    int64_t getHubVolume(const std::string& hub_id, Resolution res, int buckets) const;
+
+    /**
+     * @brief Units traded in the `buckets` bucket widths ending at `now`
+     *
+     * Only buckets whose start lies in (now - buckets * width, now] count,
+     * so a series with no recent trades reads 0 rather than its last
+     * bucket however old.
+     */
+    int64_t getVolume(const std::string& hub_id, const std::string& item_id,
+                      Resolution res, int buckets, double now) const;
+    int64_t getHubVolume(const std::string& hub_id, Resolution res, int buckets,
+                         double now) const;
+
+    /**
+     * @brief Relative price change between the oldest and newest of the
+     *        last `buckets` buckets: (close_new - open_old) / open_old
+     * @return 0 when the series is empty or has a single flat bucket
+     */
+    double getPriceTrend(const std::string& hub_id, const std::string& item_id,
+                         Resolution res, int buckets) const;
+
+    bool hasSeries(const std::string& hub_id, const std::string& item_id) const;
+
+    /// End of the newest bucket across every series (0 when empty); a
+    /// restarted trade clock resumes from here so loaded history stays ordered
+    double getLatestTime() const;
+    size_t getSeriesCount() const { return series_.size(); }
+    void clear() { series_.clear(); }
+
+    /// Bytes of bucket storage per series (constant for every series)
+    static size_t seriesFootprintBytes() { return sizeof(Series); }
+
+    // --- Segment persistence ---
+
+    /// Maximum hub/item id length stored in a segment record
+    static constexpr size_t SEGMENT_KEY_SIZE = 64;
+
+    /// Write every series to a fixed-layout binary segment.
+    /// Series whose ids do not fit SEGMENT_KEY_SIZE are skipped.
+    bool saveSegment(const std::string& filepath) const;
+
+    /// Map a segment written by saveSegment() and load it, replacing current contents
+    bool loadSegment(const std::string& filepath);
+
+private:
+    static std::string makeKey(const std::string& hub_id, const std::string& item_id);
+    const Series* findSeries(const std::string& hub_id, const std::string& item_id) const;
+    static void rollInto(Ring& ring, int64_t width, double price, int quantity,
+                         int64_t time_seconds);
+
+    std::unordered_map<std::string, Series> series_;
+};
+
+} // namespace data
+} // namespace atlas
+
+#endif // EVE_DATA_MARKET_HISTORY_H
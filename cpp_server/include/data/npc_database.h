@@ -105,6 +105,11 @@ public:
      */
     size_t getNpcCount() const { return npcs_.size(); }
 
+    /**
+     * @brief Insert or replace a template (used by DataBake)
+     */
+    void addNpc(NpcTemplate npc);
+
 private:
     std::unordered_map<std::string, NpcTemplate> npcs_;
 
@@ -115,6 +115,11 @@ public:
      */
     size_t getShipCount() const { return ships_.size(); }
 
+    /**
+     * @brief Insert or replace a template (used by DataBake)
+     */
+    void addShip(ShipTemplate ship);
+
 private:
     std::unordered_map<std::string, ShipTemplate> ships_;
 
@@ -0,0 +1,177 @@
+#ifndef EVE_DATA_SHIP_TEMPLATE_REGISTRY_H
+#define EVE_DATA_SHIP_TEMPLATE_REGISTRY_H
+
+#include "ecs/world.h"
+#include "components/game_components.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace atlas {
+namespace data {
+
+struct ShipTemplate;
+class ShipDatabase;
+
+/**
+ * @brief Numeric ship stats that a flyweight entity can override
+ */
+enum class ShipStat : uint8_t {
+    HullMax,
+    ArmorMax,
+    ShieldMax,
+    ShieldRechargeRate,
+    CapacitorMax,
+    CapacitorRechargeRate,
+    CpuMax,
+    PowergridMax,
+    MaxVelocity,
+    SignatureRadius,
+    ScanResolution,
+    MaxLockedTargets,
+    MaxTargetingRange,
+    WarpSpeedAu,
+    AlignTime,
+    WarpStrength,
+    ShieldEmResist,
+    ShieldThermalResist,
+    ShieldKineticResist,
+    ShieldExplosiveResist,
+    ArmorEmResist,
+    ArmorThermalResist,
+    ArmorKineticResist,
+    ArmorExplosiveResist,
+    HullEmResist,
+    HullThermalResist,
+    HullKineticResist,
+    HullExplosiveResist,
+    Count
+};
+
+constexpr size_t SHIP_STAT_COUNT = static_cast<size_t>(ShipStat::Count);
+
+/// Stable snake_case name used in saves ("scan_resolution", ...)
+const char* shipStatName(ShipStat stat);
+
+/// Inverse of shipStatName; returns false for unknown names
+bool parseShipStat(const std::string& name, ShipStat& out);
+
+/**
+ * @brief Immutable per-hull stats shared by every entity flying that hull
+ */
+struct ShipStats {
+    std::string id;
+    std::string name;
+    std::string ship_class;
+    std::string race;
+    float base[SHIP_STAT_COUNT] = {};
+
+    float value(ShipStat stat) const { return base[static_cast<size_t>(stat)]; }
+
+    static ShipStats fromTemplate(const ShipTemplate& tmpl);
+};
+
+/**
+ * @brief Flyweight store of ship templates
+ *
+ * Each hull is registered once and handed out as a stable
+ * `const ShipStats*`; entities reference it through a
+ * components::ShipTemplateRef and keep only the stats that diverge from
+ * the template.  Records are never modified or freed after registration,
+ * so readers on any partition thread can dereference them without
+ * locking.  Registration and id lookup are mutex-guarded.
+ */
+class ShipTemplateRegistry {
+public:
+    /// Process-wide registry shared by sessions, partitions and persistence
+    static ShipTemplateRegistry& shared();
+
+    /**
+     * @brief Register a template; returns the existing record if the id
+     *        is already known (records are immutable once published)
+     */
+    const ShipStats* registerTemplate(const ShipTemplate& tmpl);
+
+    /// Register every template in @p db, returning the number of new records
+    size_t registerDatabase(const ShipDatabase& db);
+
+    /// Look up by template id ("rifter")
+    const ShipStats* find(const std::string& id) const;
+
+    /// Look up by display name ("Rifter")
+    const ShipStats* findByName(const std::string& name) const;
+
+    size_t size() const;
+
+    /// Bytes held by the shared records, counted once for all entities
+    size_t sharedBytes() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::deque<ShipStats> records_;
+    std::unordered_map<std::string, const ShipStats*> by_id_;
+    std::unordered_map<std::string, const ShipStats*> by_name_;
+};
+
+// ---------------------------------------------------------------------------
+// Flyweight accessors
+// ---------------------------------------------------------------------------
+
+/// Effective value: the entity's override if present, otherwise the template
+float shipStat(const components::ShipTemplateRef& ref, ShipStat stat);
+
+/**
+ * @brief Set an effective value; stored only while it differs from the
+ *        template, so an entity back at its base stats holds no overrides
+ */
+void setShipStat(components::ShipTemplateRef& ref, ShipStat stat, float value);
+
+/// Drop an override, returning the stat to its template value
+void clearShipStat(components::ShipTemplateRef& ref, ShipStat stat);
+
+/**
+ * @brief Read a stat from an entity carrying either a full
+ *        components::Ship or a flyweight components::ShipTemplateRef
+ * @return false if the entity has neither, or the Ship component does not
+ *         carry @p stat
+ */
+bool entityShipStat(const ecs::Entity& entity, ShipStat stat, float& out);
+
+/// Hull class ("Frigate", ...) from Ship or the template; empty if neither
+std::string entityShipClass(const ecs::Entity& entity);
+
+/// Fill a Health component at full HP with the template's pools and resists
+void applyTemplateHealth(components::Health& health, const ShipStats& stats);
+
+/**
+ * @brief Per-entity memory of flyweight ship data versus full copies
+ *
+ * full_copy_bytes is what the same entities would hold as
+ * components::Ship copies (including string heap storage);
+ * flyweight_bytes is the ShipTemplateRef components plus their
+ * overrides.  shared_bytes is paid once per registry.
+ */
+struct ShipMemoryReport {
+    size_t entities = 0;
+    size_t overrides = 0;
+    size_t full_copy_bytes = 0;
+    size_t flyweight_bytes = 0;
+    size_t shared_bytes = 0;
+
+    double bytesSavedPerEntity() const {
+        if (entities == 0) return 0.0;
+        return (static_cast<double>(full_copy_bytes) - static_cast<double>(flyweight_bytes)) /
+               static_cast<double>(entities);
+    }
+};
+
+ShipMemoryReport measureShipMemory(const ecs::World& world,
+                                   const ShipTemplateRegistry& registry);
+
+} // namespace data
+} // namespace atlas
+
+#endif // EVE_DATA_SHIP_TEMPLATE_REGISTRY_H
@@ -0,0 +1,81 @@
+#ifndef EVE_DATA_UNIVERSE_DATABASE_H
+#define EVE_DATA_UNIVERSE_DATABASE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+namespace data {
+
+/**
+ * @brief A solar system as described in data/universe/systems.json
+ */
+struct SolarSystemTemplate {
+    std::string id;                     // e.g. "thyrkstad", also its entity id
+    std::string name;
+    float security = 1.0f;
+    std::string faction;
+    float x = 0.0f;                     // galaxy map coordinates
+    float y = 0.0f;
+    float z = 0.0f;
+    std::vector<std::string> gates;     // destination system ids
+    std::vector<std::string> station_ids;
+};
+
+/**
+ * @brief Loads the solar systems and stargate network
+ *
+ * Gates are listed per system; a gate named by either end connects both,
+ * and gates to systems missing from the file are ignored.
+ */
+class UniverseDatabase {
+public:
+    UniverseDatabase() = default;
+
+    /**
+     * @brief Load data/universe/systems.json
+     * @param data_dir Path to the data/ directory (e.g. "../data")
+     * @return Number of systems loaded
+     */
+    int loadFromDirectory(const std::string& data_dir);
+
+    /**
+     * @brief Get a system by id
+     * @return Pointer to template, or nullptr if not found
+     */
+    const SolarSystemTemplate* getSystem(const std::string& system_id) const;
+
+    /// System ids in file order
+    const std::vector<std::string>& getSystemIds() const { return order_; }
+
+    size_t getSystemCount() const { return systems_.size(); }
+
+    /// True if a stargate links the two systems
+    bool hasGate(const std::string& from_system, const std::string& to_system) const;
+
+    /// Where new pilots appear: the first system in the file ("" if none)
+    std::string getStartingSystem() const { return order_.empty() ? "" : order_.front(); }
+
+    /// Insert or replace a system (tests, generated universes)
+    void addSystem(SolarSystemTemplate system);
+
+private:
+    std::unordered_map<std::string, SolarSystemTemplate> systems_;
+    std::vector<std::string> order_;
+
+    int loadSystems(const std::string& filepath);
+
+    // Lightweight JSON helpers (same pattern as WormholeDatabase)
+    static std::string extractString(const std::string& json, const std::string& key);
+    static float extractFloat(const std::string& json, const std::string& key, float fallback = 0.0f);
+    static std::string extractBlock(const std::string& json, const std::string& key);
+    static std::string extractArray(const std::string& json, const std::string& key);
+    static std::vector<std::string> parseStringArray(const std::string& arr);
+    static std::vector<std::string> splitObjects(const std::string& arr);
+};
+
+} // namespace data
+} // namespace atlas
+
+#endif // EVE_DATA_UNIVERSE_DATABASE_H
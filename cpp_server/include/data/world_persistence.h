@@ -3,6 +3,7 @@
 
 #include "ecs/world.h"
 #include <string>
+#include <vector>
 
 namespace atlas {
 namespace data {
@@ -26,6 +27,10 @@ public:
     /// @return true on success
     bool saveWorld(const ecs::World* world, const std::string& filepath);
 
+    /// Save several worlds (e.g. the coordinator and every solar system
+    /// partition) as one world file; loading yields a single world.
+    bool saveWorlds(const std::vector<const ecs::World*>& worlds, const std::string& filepath);
+
     /// Load world state from a JSON file, creating entities and components.
     /// Existing entities are NOT cleared – call world->destroyEntity() first
     /// if a clean reload is desired.
@@ -44,16 +49,20 @@ public:
     /// Serialize world state to a JSON string (useful for tests and network).
     std::string serializeWorld(const ecs::World* world) const;
 
+    /// Serialize the entities of several worlds into one entity list.
+    std::string serializeWorlds(const std::vector<const ecs::World*>& worlds) const;
+
     /// Deserialize a JSON string into the world.
     bool deserializeWorld(ecs::World* world, const std::string& json) const;
 
-private:
-    /// Serialize a single entity to a JSON object string.
+    /// Serialize a single entity to a JSON object string
+    /// (also the payload for cluster entity migration).
     std::string serializeEntity(const ecs::Entity* entity) const;
 
     /// Deserialize a single entity JSON object and create it in the world.
     bool deserializeEntity(ecs::World* world, const std::string& json) const;
 
+private:
     // Lightweight JSON helpers
     static std::string extractString(const std::string& json, const std::string& key);
     static float extractFloat(const std::string& json, const std::string& key, float fallback = 0.0f);
@@ -98,6 +98,12 @@ public:
      */
     size_t getEffectCount() const { return effects_.size(); }
 
+    /**
+     * @brief Insert or replace entries (used by DataBake)
+     */
+    void addWormholeClass(WormholeClassTemplate tmpl);
+    void addEffect(WormholeEffect effect);
+
 private:
     std::unordered_map<std::string, WormholeClassTemplate> classes_;
     std::unordered_map<std::string, WormholeEffect> effects_;
@@ -0,0 +1,187 @@
+#ifndef EVE_ECS_EVENT_BUS_H
+#define EVE_ECS_EVENT_BUS_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+namespace ecs {
+
+/**
+ * @brief Read-only view of one tick's events of a single type
+ *
+ * Points into the stream's contiguous storage; valid until the next
+ * EventBus::publish().
+ */
+template<typename T>
+class EventBatch {
+public:
+    EventBatch() = default;
+    EventBatch(const T* data, size_t size) : data_(data), size_(size) {}
+
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    const T& operator[](size_t i) const { return data_[i]; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    const T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Type-erased interface the bus uses to flip every stream
+ */
+class EventStreamBase {
+public:
+    virtual ~EventStreamBase() = default;
+
+    /// Make the pending events readable and start an empty pending buffer
+    virtual void publish() = 0;
+
+    /// Hand the published batch to every subscriber
+    virtual void dispatch() = 0;
+
+    virtual size_t pendingCount() const = 0;
+    virtual size_t publishedCount() const = 0;
+};
+
+/**
+ * @brief Double-buffered, contiguous stream of one event type
+ *
+ * Producers emit() into the pending buffer during a tick; publish()
+ * swaps the buffers so consumers read() last tick's events as a single
+ * contiguous batch while the next tick's events accumulate.
+ *
+ * Slots are recycled, never destroyed: a buffer keeps both its capacity
+ * and its constructed elements across ticks, and emit() copy-assigns into
+ * the next slot, so string members reuse their heap storage as well.
+ * Once a stream has seen its peak per-tick volume, emitting allocates
+ * nothing.
+ *
+ * Like World, a stream is owned by one simulation thread.
+ */
+template<typename T>
+class EventStream : public EventStreamBase {
+public:
+    using Handler = std::function<void(const EventBatch<T>& batch)>;
+
+    void emit(const T& event) {
+        Buffer& buf = buffers_[write_];
+        if (buf.count < buf.slots.size()) {
+            buf.slots[buf.count] = event;
+        } else {
+            buf.slots.push_back(event);
+        }
+        ++buf.count;
+    }
+
+    /// Events published by the last publish()
+    EventBatch<T> read() const {
+        const Buffer& buf = buffers_[write_ ^ 1];
+        return EventBatch<T>(buf.slots.data(), buf.count);
+    }
+
+    /// Called with each published batch (only when it is non-empty)
+    void subscribe(Handler handler) { handlers_.push_back(std::move(handler)); }
+
+    void publish() override {
+        write_ ^= 1;
+        buffers_[write_].count = 0;
+    }
+
+    void dispatch() override {
+        EventBatch<T> batch = read();
+        if (batch.empty()) return;
+        for (auto& handler : handlers_) handler(batch);
+    }
+
+    size_t pendingCount() const override { return buffers_[write_].count; }
+    size_t publishedCount() const override { return buffers_[write_ ^ 1].count; }
+
+    /// Slots retained for recycling across both buffers
+    size_t slotCapacity() const {
+        return buffers_[0].slots.size() + buffers_[1].slots.size();
+    }
+
+private:
+    struct Buffer {
+        std::vector<T> slots;   // constructed elements beyond count are reused
+        size_t count = 0;
+    };
+
+    Buffer buffers_[2];
+    unsigned write_ = 0;
+    std::vector<Handler> handlers_;
+};
+
+/**
+ * @brief Typed event streams shared by the systems of one World
+ *
+ * Systems emit plain event structs instead of attaching marker
+ * components, and consume them in batches instead of scanning entities:
+ *
+ *     world_->events().emit(EntityKilledEvent{victim, killer, x, y, z});
+ *     for (const auto& kill : world_->events().read<EntityKilledEvent>()) ...
+ *
+ * World::update() publishes once at the start of each tick, so every
+ * system sees the same batch regardless of update order: events emitted
+ * during tick N (or between ticks) are read during tick N+1.
+ */
+class EventBus {
+public:
+    template<typename T>
+    EventStream<T>& stream();
+
+    template<typename T>
+    void emit(const T& event) { stream<T>().emit(event); }
+
+    /// Last published batch of @p T (empty if the type was never emitted)
+    template<typename T>
+    EventBatch<T> read() const;
+
+    template<typename T>
+    void subscribe(typename EventStream<T>::Handler handler) {
+        stream<T>().subscribe(std::move(handler));
+    }
+
+    /// Flip every stream, then deliver the new batches to subscribers
+    void publish();
+
+    size_t streamCount() const { return streams_.size(); }
+
+    /// Events waiting for the next publish, across all types
+    size_t pendingCount() const;
+
+private:
+    std::unordered_map<std::type_index, std::unique_ptr<EventStreamBase>> streams_;
+    std::vector<EventStreamBase*> order_;   // publish order = registration order
+};
+
+template<typename T>
+EventStream<T>& EventBus::stream() {
+    auto it = streams_.find(std::type_index(typeid(T)));
+    if (it == streams_.end()) {
+        auto created = std::make_unique<EventStream<T>>();
+        order_.push_back(created.get());
+        it = streams_.emplace(std::type_index(typeid(T)), std::move(created)).first;
+    }
+    return static_cast<EventStream<T>&>(*it->second);
+}
+
+template<typename T>
+EventBatch<T> EventBus::read() const {
+    auto it = streams_.find(std::type_index(typeid(T)));
+    if (it == streams_.end()) return EventBatch<T>();
+    return static_cast<const EventStream<T>&>(*it->second).read();
+}
+
+} // namespace ecs
+} // namespace atlas
+
+#endif // EVE_ECS_EVENT_BUS_H
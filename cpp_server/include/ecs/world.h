@@ -3,12 +3,14 @@
 
 #include "entity.h"
 #include "system.h"
+#include "event_bus.h"
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include <memory>
 #include <typeindex>
 #include <algorithm>
+#include <cstdint>
 
 namespace atlas {
 namespace ecs {
@@ -29,6 +31,10 @@ public:
     void destroyEntity(const std::string& id);
     Entity* getEntity(const std::string& id);
     const Entity* getEntity(const std::string& id) const;
+
+    // Ownership transfer (used to hand entities between worlds)
+    std::unique_ptr<Entity> releaseEntity(const std::string& id);
+    Entity* adoptEntity(std::unique_ptr<Entity> entity);
     
     // Get all entities
     std::vector<Entity*> getAllEntities();
@@ -40,15 +46,41 @@ public:
     // System management
     void addSystem(std::unique_ptr<System> system);
     
-    // Update all systems
+    // Publish last tick's events, then update all systems
     void update(float delta_time);
+
+    // Update systems [first, last) only, so one step can be spread over
+    // several calls; events are published when a run starts at system 0
+    void updateSystems(size_t first, size_t last, float delta_time);
+    size_t getSystemCount() const { return systems_.size(); }
+
+    // Typed event streams shared by this world's systems
+    EventBus& events() { return events_; }
+    const EventBus& events() const { return events_; }
     
     // Get entity count
     size_t getEntityCount() const { return entities_.size(); }
+
+    // Per-system update timing, in system order (off by default)
+    struct SystemProfile {
+        std::string name;
+        uint64_t calls = 0;
+        double total_ms = 0.0;
+        double max_ms = 0.0;
+    };
+    void setProfiling(bool enabled) { profiling_ = enabled; }
+    bool isProfiling() const { return profiling_; }
+    const std::vector<SystemProfile>& getSystemProfiles() const { return profiles_; }
+    void resetSystemProfiles() { profiles_.clear(); }
     
 private:
     std::unordered_map<std::string, std::unique_ptr<Entity>> entities_;
     std::vector<std::unique_ptr<System>> systems_;
+    EventBus events_;
+    bool profiling_ = false;
+    std::vector<SystemProfile> profiles_;
+
+    void updateProfiled(size_t first, size_t last, float delta_time);
     
     // Helper to get type indices from component types
     template<typename... ComponentTypes>
@@ -4,11 +4,14 @@
 #include "ecs/world.h"
 #include "network/tcp_server.h"
 #include "network/protocol_handler.h"
+#include "network/chat_hub.h"
 #include "data/ship_database.h"
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <mutex>
 #include <atomic>
+#include <memory>
 
 namespace atlas {
 
@@ -22,6 +25,20 @@ namespace systems {
     class AnomalySystem;
     class MissionSystem;
     class MissionGeneratorSystem;
+    class MarketSystem;
+    class WormholeSystem;
+    class BackgroundSimulationSystem;
+}
+namespace cluster {
+    class ClusterNode;
+}
+namespace sim {
+    class PartitionManager;
+    class ReplayRecorder;
+    class TimeDilation;
+}
+namespace data {
+    class UniverseDatabase;
 }
 
 /**
@@ -37,7 +54,8 @@ namespace systems {
 class GameSession {
 public:
     explicit GameSession(ecs::World* world, network::TCPServer* tcp_server,
-                         const std::string& data_path = "../data");
+                         const std::string& data_path = "../data",
+                         const std::string& data_bake_path = "");
     ~GameSession() = default;
 
     /// Initialize message handlers and spawn initial NPCs
@@ -46,6 +64,15 @@ public:
     /// Called each server tick to broadcast state to all clients
     void update(float delta_time);
 
+    /**
+     * @brief Apply the client messages received since the last call
+     *
+     * Handlers drive systems and event streams that belong to the tick
+     * thread, so client threads only queue messages and the server calls
+     * this from its tick, before the world updates.
+     */
+    void processIncomingMessages();
+
     /// Get the number of connected players
     int getPlayerCount() const;
 
@@ -73,17 +100,96 @@ public:
     /// Set pointer to the MissionGeneratorSystem for mission offers
     void setMissionGeneratorSystem(systems::MissionGeneratorSystem* mg) { mission_generator_ = mg; }
 
+    /// Set pointer to the MarketSystem for price history queries
+    void setMarketSystem(systems::MarketSystem* ms) { market_system_ = ms; }
+
+    /// Set pointer to the WormholeSystem for wormhole jumps
+    void setWormholeSystem(systems::WormholeSystem* ws) { wormhole_system_ = ws; }
+
+    /**
+     * @brief Run this session as one node of a multi-process cluster
+     *
+     * Jumps into systems owned by another node migrate the player's
+     * entity there and send session_redirect so the proxy can move the
+     * connection.  Also registers for the node's migration results.
+     */
+    void setClusterNode(cluster::ClusterNode* node);
+
+    /// Set the partition manager; ships then live in their solar system's world
+    void setPartitionManager(sim::PartitionManager* pm) { partitions_ = pm; }
+
+    /**
+     * @brief Per-world systems a player's commands are applied through
+     *
+     * Each solar system partition runs its own copies of the local
+     * systems.  Handlers use the set of the world holding the player's
+     * ship; the setters above fill in the coordinator's set.
+     */
+    struct SystemSet {
+        ecs::World* world = nullptr;
+        systems::TargetingSystem* targeting = nullptr;
+        systems::StationSystem* station = nullptr;
+        systems::MovementSystem* movement = nullptr;
+        systems::CombatSystem* combat = nullptr;
+        systems::WormholeSystem* wormholes = nullptr;
+    };
+
+    /// Register the systems installed in a solar system's partition
+    void setPartitionSystems(const std::string& system_id, const SystemSet& systems);
+
+    /// Dilation of the unpartitioned world, reported to its players
+    void setWorldDilation(const sim::TimeDilation* dilation) { world_dilation_ = dilation; }
+
+    /// Solar systems and stargates; new ships spawn in the starting system
+    void setUniverse(const data::UniverseDatabase* universe) { universe_ = universe; }
+
+    /// Background simulation told which solar systems players are in
+    void setBackgroundSimulation(systems::BackgroundSimulationSystem* background) {
+        background_ = background;
+    }
+
+    /**
+     * @brief Queue an entity to move to another solar system (any thread)
+     *
+     * Applied in update().  In cluster mode, systems owned by another
+     * node trigger a migration; locally owned systems need no transfer.
+     */
+    void requestMigration(const std::string& entity_id, const std::string& to_system);
+
     /// Get the ship database (read-only)
     const data::ShipDatabase& getShipDatabase() const { return ship_db_; }
 
+    /// Chat channels, history and fan-out (members are socket fds)
+    network::ChatHub& getChatHub() { return *chat_hub_; }
+
+    /// Seconds between RTT pings to each player (0 disables)
+    void setPingInterval(double seconds) { ping_interval_ = seconds; }
+
+    /// Capture every inbound client message into a session recording
+    void setRecorder(sim::ReplayRecorder* recorder) { recorder_ = recorder; }
+
+    /**
+     * @brief Feed a recorded message through the normal dispatch
+     *
+     * Used by headless replay: the message is handled as if it had
+     * arrived on socket @p client, without being recorded again.
+     */
+    void replayMessage(int client, const std::string& raw);
+
+    /// Counter behind player entity ids; part of a recording's seeds
+    uint32_t getNextEntityId() const { return next_entity_id_; }
+    void setNextEntityId(uint32_t next) { next_entity_id_ = next; }
+
 private:
     // --- Message handlers ---
     /**
      * Routes incoming client messages to appropriate handlers
      * @param client Client connection info
      * @param raw Raw message string from network
+     * @param received_at Steady-clock seconds when the client thread received it
      */
-    void onClientMessage(const network::ClientConnection& client, const std::string& raw);
+    void onClientMessage(const network::ClientConnection& client, const std::string& raw,
+                         double received_at);
     
     /**
      * Handle client connection
@@ -126,6 +232,25 @@ private:
      * @param data JSON message data with message content
      */
     void handleChat(const network::ClientConnection& client, const std::string& data);
+
+    /**
+     * Handle chat channel join / leave
+     *
+     * Joining replies with the member count and replays the channel's
+     * recent history.  Local channels follow the ship and cannot be
+     * joined or left by name.
+     * Expected format: {"type":"chat_join","data":{"channel":"corp_alpha"}}
+     *                  {"type":"chat_leave","data":{"channel":"corp_alpha"}}
+     */
+    void handleChatJoin(const network::ClientConnection& client, const std::string& data);
+    void handleChatLeave(const network::ClientConnection& client, const std::string& data);
+
+    /**
+     * Follow each player's ship to its solar system: move them to that
+     * system's local chat channel and keep the background simulation's
+     * observer counts in step (players who left are removed here too)
+     */
+    void refreshPlayerSystems();
     
     /**
      * Handle target lock request
@@ -292,6 +417,73 @@ private:
      */
     void handleMissionProgress(const network::ClientConnection& client, const std::string& data);
 
+    /**
+     * Handle market history request
+     *
+     * Returns OHLC/volume buckets for an item at a station's market hub.
+     * Expected format: {"type":"market_history","station_id":"station_jita4",
+     *                   "item_id":"mineral_tritanium","resolution":"1h","count":24}
+     * resolution is one of "5m", "1h", "1d"; count defaults to 24.
+     */
+    void handleMarketHistory(const network::ClientConnection& client, const std::string& data);
+
+    /**
+     * Handle wormhole jump request
+     *
+     * Jumps the player's ship through a wormhole entity, spending its mass
+     * budget.  In cluster mode a destination owned by another node hands
+     * the ship (and the session) over to that node.
+     * Expected format: {"type":"wormhole_jump","wormhole_id":"wh_001"}
+     */
+    void handleWormholeJump(const network::ClientConnection& client, const std::string& data);
+
+    /**
+     * Handle stargate jump request
+     *
+     * Moves the player's ship to a system linked by a stargate.  With
+     * partitioned simulation the ship is handed off to the destination
+     * partition; in cluster mode a system owned by another node migrates it.
+     * Expected format: {"type":"gate_jump","destination":"rimward"}
+     */
+    void handleGateJump(const network::ClientConnection& client, const std::string& data);
+
+    /// Cluster callback: an outbound migration was acknowledged or rejected
+    void onEntityMigrated(const std::string& entity_id, const std::string& to_node, bool ok);
+
+    /// Start migrations queued by requestMigration(); runs on the tick thread
+    void processPendingMigrations();
+
+    /**
+     * Send time_dilation to players whose solar system's factor changed
+     *
+     * Each player gets the factor of the partition holding their ship, or
+     * of the whole world when unpartitioned; a message goes out only when
+     * it moves by at least 0.01.
+     */
+    void sendTimeDilationUpdates();
+
+    /// Send each player the damage their world's CombatSystem resolved this tick
+    void sendDamageEvents();
+
+    /**
+     * Follow ships that changed world since the last tick
+     *
+     * A player whose ship arrived in another partition is sent the new
+     * system's entities; players in the old and new systems are told the
+     * ship left or appeared.
+     */
+    void syncPlayerWorlds();
+
+    /// Ping every player whose last probe is older than the ping interval
+    void sendPings();
+
+    /// Pong handler: records the round trip in the connection telemetry,
+    /// ending when the pong arrived rather than when the tick applied it
+    void handlePong(const network::ClientConnection& client, const std::string& data,
+                    double received_at);
+    // CombatSystem -> damage pipeline flush count already broadcast
+    std::unordered_map<const systems::CombatSystem*, uint64_t> last_damage_flush_;
+
     // --- State broadcast ---
     /**
      * Build full state update message
@@ -302,9 +494,11 @@ private:
      * - Target locks
      * - Active modules
      * 
+     * @param world World whose entities are included
+     * @param seq Snapshot sequence number, shared by every world in a tick
      * @return JSON string with format: {"type":"state_update","entities":[...]}
      */
-    std::string buildStateUpdate() const;
+    std::string buildStateUpdate(ecs::World* world, uint64_t seq) const;
     
     /**
      * Build entity spawn notification
@@ -315,7 +509,19 @@ private:
      * @param entity_id ID of entity to spawn
      * @return JSON string with format: {"type":"spawn_entity","entity":{...}}
      */
-    std::string buildSpawnEntity(const std::string& entity_id) const;
+    std::string buildSpawnEntity(const std::string& entity_id);
+
+    /// Systems of the world currently holding an entity (coordinator if unpartitioned)
+    SystemSet systemsFor(const std::string& entity_id) const;
+
+    /// Entity in whichever world holds it; nullptr while in flight between partitions
+    ecs::Entity* findEntity(const std::string& entity_id);
+
+    /// Solar system a ship is in ("" if unknown)
+    std::string systemOf(const std::string& entity_id);
+
+    /// Tag a new ship with the starting system and move it into its partition
+    void placeInStartingSystem(ecs::Entity* entity);
 
     // --- NPC management ---
     void spawnInitialNPCs();
@@ -366,12 +572,47 @@ private:
     systems::AnomalySystem* anomaly_system_ = nullptr;
     systems::MissionSystem* mission_system_ = nullptr;
     systems::MissionGeneratorSystem* mission_generator_ = nullptr;
+    systems::MarketSystem* market_system_ = nullptr;
+    systems::WormholeSystem* wormhole_system_ = nullptr;
+    cluster::ClusterNode* cluster_node_ = nullptr;
+    sim::PartitionManager* partitions_ = nullptr;
+    std::unordered_map<std::string, SystemSet> partition_systems_;   // by system id
+    const data::UniverseDatabase* universe_ = nullptr;
+    const sim::TimeDilation* world_dilation_ = nullptr;
+    systems::BackgroundSimulationSystem* background_ = nullptr;
+    std::unordered_map<int, std::string> observed_systems_;  // socket -> system observed (tick thread)
+    sim::ReplayRecorder* recorder_ = nullptr;
+    double ping_interval_ = 5.0;
+    double last_ping_ = -1.0;
+    std::unique_ptr<network::ChatHub> chat_hub_;
+
+    // Messages queued by client threads for processIncomingMessages()
+    struct IncomingMessage {
+        network::ClientConnection client;
+        std::string raw;
+        double received_at = 0.0;   // steady-clock seconds
+    };
+    std::vector<IncomingMessage> incoming_;
+    std::vector<IncomingMessage> applying_;   // swapped with incoming_ each tick
+    std::mutex incoming_mutex_;
+
+    // Queued inter-system moves (entity id, destination system)
+    std::vector<std::pair<std::string, std::string>> pending_migrations_;
+    std::mutex migrations_mutex_;
+    // Cluster migration in flight, by entity id
+    struct Migration {
+        std::string system_id;      // destination system
+        std::string resume_token;   // handed to the proxy with session_redirect
+    };
+    std::unordered_map<std::string, Migration> migrating_;
 
     // Map socket → entity_id for connected players
     struct PlayerInfo {
         std::string entity_id;
         std::string character_name;
         network::ClientConnection connection;
+        float time_dilation = 1.0f;   // last factor sent to this client
+        ecs::World* world = nullptr;  // world whose entities the client was last sent
     };
 
     std::unordered_map<int, PlayerInfo> players_;  // keyed by socket fd
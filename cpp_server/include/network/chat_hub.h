@@ -0,0 +1,192 @@
+#ifndef EVE_NETWORK_CHAT_HUB_H
+#define EVE_NETWORK_CHAT_HUB_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace atlas {
+namespace network {
+
+/// Recipient handle used for fan-out (the socket fd, as in GameSession)
+using ChatMemberId = int;
+
+/**
+ * @brief One posted chat line
+ *
+ * @c wire is the serialized network message, built once per post and
+ * shared by every recipient and by the channel history.
+ */
+struct ChatEntry {
+    uint64_t sequence = 0;
+    std::string channel;
+    ChatMemberId sender = -1;
+    std::string sender_name;
+    std::string text;
+    std::shared_ptr<const std::string> wire;
+};
+
+/**
+ * @brief Fixed-capacity ring of chat entries
+ *
+ * Pushing past capacity overwrites the oldest entry in O(1); nothing is
+ * ever shifted.
+ */
+class ChatHistory {
+public:
+    explicit ChatHistory(size_t capacity = 200);
+
+    void push(std::shared_ptr<const ChatEntry> entry);
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return slots_.size(); }
+
+    /// @p index 0 is the oldest retained entry
+    const ChatEntry& at(size_t index) const;
+
+    /// Up to @p count most recent entries, oldest first
+    std::vector<std::shared_ptr<const ChatEntry>> recent(size_t count) const;
+
+private:
+    std::vector<std::shared_ptr<const ChatEntry>> slots_;
+    size_t head_ = 0;   // next slot to write
+    size_t size_ = 0;
+};
+
+enum class ChatResult {
+    Delivered,
+    UnknownChannel,
+    NotMember,
+    RateLimited,
+    Empty
+};
+
+struct ChatHubConfig {
+    size_t history_capacity = 200;       // messages kept per channel
+    double rate_limit_burst = 5.0;       // messages a sender may post back-to-back
+    double rate_limit_per_second = 1.0;  // sustained messages per second per sender
+    size_t max_message_length = 256;     // longer text is truncated
+};
+
+/**
+ * @brief Channel-based chat fan-out
+ *
+ * Each channel keeps a membership index and a ChatHistory ring.  A post
+ * is validated and rate-limited (token bucket per sender), serialized
+ * exactly once, appended to the history and handed to the send function
+ * for every member of that channel only.  The member list is published
+ * as an immutable snapshot that is rebuilt only after joins and leaves,
+ * so a post into a 5000-member channel copies no membership data.
+ *
+ * Local channels ("local" or "local:<system>") are driven by
+ * setLocalSystem(): the session resolves each player's solar system
+ * from their ship's SystemLocation and the hub moves the member between
+ * the per-system channels.  Players join and leave every other channel
+ * by name; see isJoinableChannel().
+ *
+ * All methods are thread-safe; sends happen outside the hub's lock.
+ */
+class ChatHub {
+public:
+    /// Deliver @p payload to one member (e.g. TCPServer::sendToSocket)
+    using SendFunction = std::function<void(ChatMemberId member, const std::string& payload)>;
+    /// Build the network message for an entry
+    using Serializer = std::function<std::string(const ChatEntry& entry)>;
+
+    struct Stats {
+        uint64_t posted = 0;         // messages accepted
+        uint64_t serialized = 0;     // wire payloads built
+        uint64_t delivered = 0;      // per-recipient sends
+        uint64_t rate_limited = 0;   // posts refused by the rate limiter
+        uint64_t rejected = 0;       // unknown channel, non-member or empty
+    };
+
+    ChatHub(SendFunction send, Serializer serialize, const ChatHubConfig& config);
+    ChatHub(SendFunction send, Serializer serialize);
+
+    /// Channel name for a solar system's local chat ("local" when unpartitioned)
+    static std::string localChannel(const std::string& system_id);
+
+    /**
+     * @brief Whether players may join or leave @p channel by name
+     *
+     * 1-32 characters from [A-Za-z0-9_-], and not a local channel, so
+     * names can be echoed into messages without escaping.
+     */
+    static bool isJoinableChannel(const std::string& channel);
+
+    /// Join a named channel (created on first join)
+    bool join(const std::string& channel, ChatMemberId member);
+    bool leave(const std::string& channel, ChatMemberId member);
+
+    /// Leave every channel and forget the member's rate-limit state
+    void removeMember(ChatMemberId member);
+
+    /// Place @p member in the local channel of @p system_id, leaving the previous one
+    void setLocalSystem(ChatMemberId member, const std::string& system_id);
+
+    /// Local channel @p member currently belongs to ("" if none)
+    std::string localChannelOf(ChatMemberId member) const;
+
+    /**
+     * @brief Post to a channel the sender belongs to
+     * @param now Monotonic time in seconds, used by the rate limiter
+     */
+    ChatResult post(const std::string& channel, ChatMemberId sender,
+                    const std::string& sender_name, const std::string& text, double now);
+
+    /// Post to the sender's current local channel
+    ChatResult postLocal(ChatMemberId sender, const std::string& sender_name,
+                         const std::string& text, double now);
+
+    size_t memberCount(const std::string& channel) const;
+    bool isMember(const std::string& channel, ChatMemberId member) const;
+    size_t channelCount() const;
+
+    /// Up to @p count most recent messages in @p channel, oldest first
+    std::vector<std::shared_ptr<const ChatEntry>> history(const std::string& channel,
+                                                          size_t count) const;
+
+    Stats getStats() const;
+
+private:
+    struct Channel {
+        explicit Channel(size_t history_capacity) : history(history_capacity) {}
+        std::unordered_set<ChatMemberId> members;
+        std::shared_ptr<const std::vector<ChatMemberId>> snapshot;  // null when stale
+        ChatHistory history;
+    };
+
+    struct Bucket {
+        double tokens = 0.0;
+        double last = 0.0;
+    };
+
+    Channel& channelLocked(const std::string& name);
+    bool joinLocked(const std::string& channel, ChatMemberId member);
+    bool leaveLocked(const std::string& channel, ChatMemberId member);
+    bool consumeTokenLocked(ChatMemberId member, double now);
+
+    SendFunction send_;
+    Serializer serialize_;
+    ChatHubConfig config_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Channel> channels_;
+    std::unordered_map<ChatMemberId, std::vector<std::string>> memberships_;
+    std::unordered_map<ChatMemberId, std::string> local_channel_;
+    std::unordered_map<ChatMemberId, Bucket> buckets_;
+    uint64_t next_sequence_ = 1;
+    Stats stats_;
+};
+
+} // namespace network
+} // namespace atlas
+
+#endif // EVE_NETWORK_CHAT_HUB_H
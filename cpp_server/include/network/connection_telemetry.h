@@ -0,0 +1,152 @@
+#ifndef EVE_NETWORK_CONNECTION_TELEMETRY_H
+#define EVE_NETWORK_CONNECTION_TELEMETRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+namespace network {
+
+/**
+ * @brief Fixed-bucket latency histogram (seconds)
+ *
+ * Buckets run from 50 µs to 5 s in a 1-2.5-5 progression, plus an
+ * overflow bucket; the same bounds serve RTT and command-apply latency
+ * so both export as Prometheus histograms without reconfiguration.
+ */
+struct LatencyHistogram {
+    static constexpr size_t BOUNDS = 16;
+    static const double UPPER_BOUNDS[BOUNDS];
+
+    uint64_t buckets[BOUNDS + 1] = {};   // last bucket is +Inf
+    uint64_t count = 0;
+    double sum = 0.0;
+
+    void record(double seconds);
+    void merge(const LatencyHistogram& other);
+
+    /// Upper bound of the bucket holding quantile @p q (0 if empty)
+    double quantile(double q) const;
+    double mean() const { return count ? sum / static_cast<double>(count) : 0.0; }
+};
+
+/// Snapshot of one client connection
+struct ConnectionStats {
+    int socket = -1;
+    std::string address;             // "ip:port"
+    std::string player_name;         // empty until the connect handshake
+    std::string entity_id;
+    double connected_at = 0.0;
+
+    uint64_t bytes_in = 0;
+    uint64_t bytes_out = 0;
+    uint64_t messages_in = 0;
+    uint64_t messages_out = 0;
+    uint64_t send_failures = 0;
+
+    // Over the last sample() window
+    double bytes_in_per_sec = 0.0;
+    double bytes_out_per_sec = 0.0;
+
+    // Kernel socket queues at the last sample (Linux; 0 elsewhere)
+    size_t send_queue_bytes = 0;
+    size_t recv_queue_bytes = 0;
+    size_t peak_send_queue_bytes = 0;
+
+    double rtt_ms = -1.0;            // last ping round trip (-1 = none yet)
+    double rtt_smoothed_ms = -1.0;   // RFC 6298 style SRTT
+    LatencyHistogram rtt;
+    LatencyHistogram apply;          // recv() returned -> handler finished
+};
+
+/**
+ * @brief Per-connection network telemetry
+ *
+ * TCPServer feeds byte and message counts from the client threads;
+ * GameSession reports command-apply times as it applies queued messages,
+ * sends pings from the tick thread and reports pongs; the server samples
+ * rates and socket queue depths about once a second.  Closed connections
+ * drop out of the table but stay in the aggregate counters and
+ * histograms, which only ever grow, as Prometheus expects.
+ *
+ * Thread-safe; every call takes one short lock.
+ */
+class ConnectionTelemetry {
+public:
+    enum class SortKey { BytesOut, BytesIn, Rtt, SendQueue, Apply };
+
+    void onConnect(int socket, const std::string& address, double now);
+    void onDisconnect(int socket);
+    void setPlayer(int socket, const std::string& player_name, const std::string& entity_id);
+
+    void recordMessageIn(int socket, size_t bytes);
+    void recordMessageOut(int socket, size_t bytes);
+    void recordSendFailure(int socket);
+
+    /// Time from a message arriving to its handler finishing on the tick thread
+    void recordApply(int socket, double seconds);
+
+    /// Note a ping sent now; returns the nonce the client must echo
+    uint64_t recordPingSent(int socket, double now);
+
+    /// Match a pong; false if the nonce is unknown or stale
+    bool recordPong(int socket, uint64_t nonce, double now);
+
+    void setQueueDepth(int socket, size_t send_bytes, size_t recv_bytes);
+
+    /// Close the rate window: bytes/s since the previous sample
+    void sample(double now);
+
+    size_t getConnectionCount() const;
+    std::vector<ConnectionStats> snapshot() const;
+
+    /// The @p n heaviest connections by @p key, heaviest first
+    std::vector<ConnectionStats> top(size_t n, SortKey key) const;
+
+    /// "out", "in", "rtt", "queue" or "apply"
+    static bool parseSortKey(const std::string& name, SortKey& key);
+
+    /// Console table of top(n, key)
+    std::string formatTop(size_t n, SortKey key) const;
+
+    /// Prometheus text exposition of the aggregate and per-client series
+    void writePrometheus(std::ostream& out) const;
+
+    uint64_t getTotalBytesIn() const;
+    uint64_t getTotalBytesOut() const;
+    LatencyHistogram getRttHistogram() const;
+    LatencyHistogram getApplyHistogram() const;
+
+private:
+    struct Entry {
+        ConnectionStats stats;
+        uint64_t sampled_bytes_in = 0;
+        uint64_t sampled_bytes_out = 0;
+        uint64_t ping_nonce = 0;     // outstanding ping (0 = none)
+        double ping_sent_at = 0.0;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<int, Entry> connections_;
+    double last_sample_ = -1.0;
+    uint64_t next_nonce_ = 1;
+
+    uint64_t total_bytes_in_ = 0;
+    uint64_t total_bytes_out_ = 0;
+    uint64_t total_messages_in_ = 0;
+    uint64_t total_messages_out_ = 0;
+    uint64_t total_send_failures_ = 0;
+    uint64_t total_connections_ = 0;
+    LatencyHistogram rtt_total_;
+    LatencyHistogram apply_total_;
+};
+
+} // namespace network
+} // namespace atlas
+
+#endif // EVE_NETWORK_CONNECTION_TELEMETRY_H
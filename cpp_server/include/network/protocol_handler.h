@@ -1,6 +1,7 @@
 #ifndef EVE_PROTOCOL_HANDLER_H
 #define EVE_PROTOCOL_HANDLER_H
 
+#include <cstdint>
 #include <string>
 #include <functional>
 #include <map>
@@ -64,6 +65,17 @@ enum class MessageType {
     ABANDON_MISSION,
     MISSION_PROGRESS,
     MISSION_RESULT,
+    MARKET_HISTORY,
+    WORMHOLE_JUMP_RESULT,
+    GATE_JUMP,
+    GATE_JUMP_RESULT,
+    CHAT_JOIN,
+    CHAT_LEAVE,
+    CHAT_CHANNEL_RESULT,
+    SESSION_REDIRECT,
+    TIME_DILATION,
+    PING,
+    PONG,
     ERROR
 };
 
@@ -88,6 +100,12 @@ public:
     std::string createConnectAck(bool success, const std::string& message);
     std::string createStateUpdate(const std::string& game_state);
     std::string createChatMessage(const std::string& sender, const std::string& message);
+    /// Reply to chat_join / chat_leave; @p action is "join" or "leave"
+    std::string createChatChannelResult(bool success, const std::string& channel,
+                                        const std::string& action, int members,
+                                        const std::string& reason = "");
+    std::string createChatMessage(const std::string& sender, const std::string& message,
+                                  const std::string& channel);
     std::string createError(const std::string& error_message);
     
     // Station docking messages
@@ -126,6 +144,29 @@ public:
                                   const std::string& missions_json);
     std::string createMissionResult(bool success, const std::string& mission_id,
                                     const std::string& action, const std::string& message = "");
+
+    // Market messages
+    std::string createMarketHistory(const std::string& station_id, const std::string& item_id,
+                                    const std::string& resolution, int count,
+                                    const std::string& buckets_json);
+
+    // Wormhole / cluster messages
+    std::string createWormholeJumpResult(bool success, const std::string& wormhole_id,
+                                         const std::string& destination_system,
+                                         const std::string& reason = "");
+    std::string createGateJumpResult(bool success, const std::string& destination_system,
+                                     const std::string& reason = "");
+    /// Tell the cluster proxy that this session's entity now lives on another node;
+    /// @p resume_token must accompany the resume_entity connect there
+    std::string createSessionRedirect(const std::string& entity_id, const std::string& node_id,
+                                      const std::string& system_id,
+                                      const std::string& resume_token = "");
+
+    /// Time dilation factor (0.1 - 1.0) for the solar system the client is in
+    std::string createTimeDilation(const std::string& system_id, float factor);
+
+    /// RTT probe; the client answers {"type":"pong","data":{"nonce":N}}
+    std::string createPing(uint64_t nonce);
     
     // Message validation
     bool validateMessage(const std::string& json);
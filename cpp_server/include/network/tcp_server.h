@@ -8,6 +8,7 @@
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include "network/connection_telemetry.h"
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -50,6 +51,7 @@ public:
     void start();
     void stop();
     bool isRunning() const { return running_; }
+    uint16_t getPort() const { return port_; }
     
     // Client management
     int getClientCount() const;
@@ -58,10 +60,25 @@ public:
     // Message handling
     using MessageHandler = std::function<void(const ClientConnection&, const std::string&)>;
     void setMessageHandler(MessageHandler handler);
+
+    // Called from the client's thread after its socket has closed
+    using DisconnectHandler = std::function<void(const ClientConnection&)>;
+    void setDisconnectHandler(DisconnectHandler handler);
     
     // Send data
     bool sendToClient(const ClientConnection& client, const std::string& data);
+    bool sendToSocket(socket_t socket, const std::string& data);
     void broadcastToAll(const std::string& data);
+
+    // Shut a client connection down (its handler thread then exits)
+    void disconnectClient(const ClientConnection& client);
+
+    // Per-connection traffic, RTT and command-apply latency
+    ConnectionTelemetry& getTelemetry() { return telemetry_; }
+    const ConnectionTelemetry& getTelemetry() const { return telemetry_; }
+
+    // Refresh socket queue depths and close the telemetry rate window
+    void sampleTelemetry();
     
 private:
     std::string host_;
@@ -74,6 +91,8 @@ private:
     mutable std::mutex clients_mutex_;
     
     MessageHandler message_handler_;
+    DisconnectHandler disconnect_handler_;
+    ConnectionTelemetry telemetry_;
     
     std::thread accept_thread_;
     std::vector<std::thread> client_threads_;
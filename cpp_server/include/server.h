@@ -14,7 +14,14 @@
 #include "systems/station_system.h"
 #include "systems/movement_system.h"
 #include "systems/combat_system.h"
+#include "systems/market_system.h"
+#include "systems/research_system.h"
+#include "systems/background_simulation_system.h"
 #include "data/world_persistence.h"
+#include "data/universe_database.h"
+#include "sim/partition_manager.h"
+#include "sim/replay_log.h"
+#include "cluster/cluster_node.h"
 #include "utils/server_metrics.h"
 #include "ui/server_console.h"
 
@@ -37,6 +44,16 @@ public:
     void stop();
     void run();
 
+    /**
+     * @brief Re-simulate a session recording headlessly (--replay)
+     *
+     * Builds the same world as initialize() without opening sockets,
+     * restores the recorded snapshot and seeds, runs every tick back to
+     * back with per-system profiling and prints the profile.
+     * @return process exit code
+     */
+    int replay(const std::string& log_path);
+
     // Status
     bool isRunning() const { return running_; }
     int getPlayerCount() const;
@@ -44,12 +61,31 @@ public:
     // Get game world
     ecs::World* getWorld() { return game_world_.get(); }
 
+    // Per-solar-system partitions (null unless partition_by_system is set)
+    sim::PartitionManager* getPartitions() { return partitions_.get(); }
+
+    // Cluster node (null unless cluster_role is "node")
+    cluster::ClusterNode* getClusterNode() { return cluster_node_.get(); }
+
     // World persistence
     bool saveWorld();
     bool loadWorld();
 
     // Metrics
     const utils::ServerMetrics& getMetrics() const { return metrics_; }
+
+    // Per-connection telemetry (null before initialize())
+    const network::ConnectionTelemetry* getTelemetry() const {
+        return tcp_server_ ? &tcp_server_->getTelemetry() : nullptr;
+    }
+
+    /**
+     * @brief Write server and per-connection metrics as a Prometheus text file
+     *
+     * Written to a temporary file and renamed over @p path, so a scraper
+     * (e.g. node_exporter's textfile collector) never reads a partial file.
+     */
+    bool writeMetricsFile(const std::string& path) const;
     
     // Console
     ServerConsole& getConsole() { return console_; }
@@ -61,13 +97,22 @@ private:
     std::unique_ptr<auth::Whitelist> whitelist_;
     std::unique_ptr<ecs::World> game_world_;
     std::unique_ptr<GameSession> game_session_;
+    std::unique_ptr<sim::PartitionManager> partitions_;
+    std::unique_ptr<cluster::ClusterNode> cluster_node_;
+    std::unique_ptr<sim::ReplayRecorder> recorder_;
     data::WorldPersistence world_persistence_;
+    data::UniverseDatabase universe_;
+    sim::TimeDilation world_dilation_;   // unpartitioned world only
     utils::ServerMetrics metrics_;
     ServerConsole console_;
     systems::TargetingSystem* targeting_system_ = nullptr;
     systems::StationSystem* station_system_ = nullptr;
     systems::MovementSystem* movement_system_ = nullptr;
     systems::CombatSystem* combat_system_ = nullptr;
+    systems::WormholeSystem* wormhole_system_ = nullptr;
+    systems::MarketSystem* market_system_ = nullptr;
+    systems::ResearchSystem* research_system_ = nullptr;
+    systems::BackgroundSimulationSystem* background_system_ = nullptr;
     
     std::atomic<bool> running_;
     
@@ -75,6 +120,12 @@ private:
     void mainLoop();
     void updateSteam();
     void initializeGameWorld();
+    void spawnSolarSystems();
+    void createGameSession();
+    void startRecording();
+    void initializePartitions();
+    sim::TimeDilation::Config timeDilationConfig() const;
+    bool initializeClusterNode();
 };
 
 } // namespace atlas
@@ -0,0 +1,131 @@
+#ifndef EVE_SIM_PARTITION_MANAGER_H
+#define EVE_SIM_PARTITION_MANAGER_H
+
+#include "sim/star_system_partition.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+namespace sim {
+
+/**
+ * @brief Splits the simulation into one World per solar system
+ *
+ * The coordinator World keeps global systems (market, chat, corporations)
+ * and any entity not bound to a solar system.  Each StarSystemPartition
+ * owns the entities of one system and ticks on a pooled worker thread.
+ *
+ * A tick runs in three phases:
+ *   1. the coordinator updates on the calling thread while workers pull
+ *      partitions off a shared job index and update them in parallel;
+ *   2. the caller waits for every partition to finish;
+ *   3. outgoing handoffs are routed: entities are released from their
+ *      source world and posted to the destination partition's inbox,
+ *      which adopts them at the start of its next update.
+ *
+ * Partitions never touch each other's worlds, so no locking is needed
+ * inside systems.  createPartition(), assignEntity() and destroyEntity()
+ * must only be called between ticks.
+ */
+class PartitionManager {
+public:
+    /// Installs systems into a freshly created partition world
+    using SystemInstaller = std::function<void(StarSystemPartition& partition)>;
+
+    /**
+     * @param coordinator  World hosting global systems (not owned)
+     * @param worker_count Worker threads; -1 = hardware_concurrency - 1,
+     *                     0 = tick every partition on the calling thread
+     */
+    explicit PartitionManager(ecs::World* coordinator, int worker_count = -1);
+    ~PartitionManager();
+
+    PartitionManager(const PartitionManager&) = delete;
+    PartitionManager& operator=(const PartitionManager&) = delete;
+
+    /// Create (or return the existing) partition for a solar system
+    StarSystemPartition* createPartition(const std::string& system_id,
+                                         const SystemInstaller& installer = nullptr);
+
+    StarSystemPartition* getPartition(const std::string& system_id);
+    size_t getPartitionCount() const { return partitions_.size(); }
+    std::vector<std::string> getPartitionIds() const;
+
+    ecs::World* getCoordinator() { return coordinator_; }
+
+    /// Move an entity out of the coordinator world into a partition
+    bool assignEntity(const std::string& entity_id, const std::string& system_id);
+
+    /// Solar system currently owning an entity ("" = coordinator or unknown)
+    std::string locateEntity(const std::string& entity_id) const;
+
+    /// Find an entity in whichever world currently holds it
+    ecs::Entity* findEntity(const std::string& entity_id);
+
+    /// Destroy an entity wherever it is, including a partition's inbox
+    bool destroyEntity(const std::string& entity_id);
+
+    /**
+     * @brief Queue an inter-system transfer (any thread)
+     *
+     * Applied at the next tick boundary.  Equivalent to the owning
+     * partition calling StarSystemPartition::requestHandoff().
+     */
+    void requestHandoff(const std::string& entity_id, const std::string& to_system,
+                        HandoffKind kind);
+
+    /// Run one simulation tick across the coordinator and all partitions
+    void tick(float delta_time);
+
+    /// Apply a time dilation config to every current and future partition
+    void setTimeDilationConfig(const TimeDilation::Config& config);
+    const TimeDilation::Config& getTimeDilationConfig() const { return dilation_config_; }
+
+    int getWorkerCount() const { return static_cast<int>(workers_.size()); }
+    uint64_t getHandoffCount() const { return handoff_count_; }
+    uint64_t getRejectedHandoffCount() const { return rejected_handoff_count_; }
+
+private:
+    void workerLoop();
+    void runPartitionJobs();
+    void routeHandoffs();
+    void route(EntityHandoff& handoff);
+
+    ecs::World* coordinator_;
+    std::map<std::string, std::unique_ptr<StarSystemPartition>> partitions_;
+
+    // entity id -> owning system id (absent = coordinator)
+    std::unordered_map<std::string, std::string> entity_locations_;
+
+    std::vector<EntityHandoff> pending_handoffs_;
+    std::mutex pending_mutex_;
+    uint64_t handoff_count_ = 0;
+    uint64_t rejected_handoff_count_ = 0;
+
+    TimeDilation::Config dilation_config_;
+
+    // Worker pool
+    std::vector<std::thread> workers_;
+    std::vector<StarSystemPartition*> jobs_;
+    float job_delta_ = 0.0f;
+    std::atomic<size_t> next_job_{0};
+    size_t finished_workers_ = 0;
+    uint64_t generation_ = 0;
+    bool stopping_ = false;
+    std::mutex pool_mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+};
+
+} // namespace sim
+} // namespace atlas
+
+#endif // EVE_SIM_PARTITION_MANAGER_H
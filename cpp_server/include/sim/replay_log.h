@@ -0,0 +1,118 @@
+#ifndef EVE_SIM_REPLAY_LOG_H
+#define EVE_SIM_REPLAY_LOG_H
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace atlas {
+namespace sim {
+
+/// One inbound client message, exactly as GameSession applied it (a
+/// dropped connection is recorded as a disconnect message)
+struct ReplayCommand {
+    int32_t client = 0;      // socket the message arrived on
+    std::string raw;
+};
+
+/// Commands that arrived before the given tick ran (ticks are 1-based)
+struct ReplayFrame {
+    uint64_t tick = 0;
+    std::vector<ReplayCommand> commands;
+};
+
+/**
+ * @brief Writes a session recording for deterministic replay
+ *
+ * A recording is the world snapshot at the moment recording started
+ * (zlib-compressed JSON), the fixed tick length, a table of named seeds
+ * and counters the simulation needs to reproduce itself, then one frame
+ * per tick that received commands.  Frames are varint-encoded and
+ * appended as ticks end, so quiet ticks cost nothing and a crashed
+ * server still leaves a log that replays up to its last full frame.
+ *
+ * GameSession calls recordCommand() as it applies each command on the
+ * tick thread, so a frame holds exactly the commands applied before that
+ * tick's world update; endTick() is called after each tick.
+ */
+class ReplayRecorder {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    ReplayRecorder() = default;
+    ~ReplayRecorder() { close(); }
+
+    ReplayRecorder(const ReplayRecorder&) = delete;
+    ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+
+    bool open(const std::string& path, const std::string& snapshot_json,
+              float tick_duration, const std::map<std::string, uint64_t>& seeds);
+
+    /// Queue a command for the tick currently being collected
+    void recordCommand(int32_t client, const std::string& raw);
+
+    /// Close the current tick, writing its frame if it had commands
+    void endTick();
+
+    /// Write the end marker and close the file
+    void close();
+
+    bool isOpen() const { return out_.is_open(); }
+    uint64_t getTickCount() const { return tick_; }
+    uint64_t getCommandCount() const { return commands_written_; }
+    uint64_t getBytesWritten() const { return bytes_written_; }
+
+private:
+    void writeBytes(const std::string& bytes);
+
+    std::ofstream out_;
+    uint64_t tick_ = 0;               // ticks completed
+    uint64_t last_frame_tick_ = 0;
+    uint64_t commands_written_ = 0;
+    uint64_t bytes_written_ = 0;
+
+    std::vector<ReplayCommand> pending_;
+    std::vector<ReplayCommand> writing_;   // swapped with pending_ in endTick()
+    std::string buffer_;
+    std::mutex pending_mutex_;
+};
+
+/**
+ * @brief A recording loaded back into memory
+ */
+class ReplayLog {
+public:
+    /// @return false if the file is missing, not a recording or from
+    ///         another version (a truncated tail is not an error)
+    bool load(const std::string& path);
+
+    float getTickDuration() const { return tick_duration_; }
+    const std::map<std::string, uint64_t>& getSeeds() const { return seeds_; }
+    uint64_t getSeed(const std::string& name, uint64_t fallback = 0) const;
+    const std::string& getSnapshot() const { return snapshot_; }
+    const std::vector<ReplayFrame>& getFrames() const { return frames_; }
+
+    /// Ticks the recording covers (the last frame's tick if it was cut short)
+    uint64_t getTickCount() const { return tick_count_; }
+    uint64_t getCommandCount() const { return command_count_; }
+
+    /// True if the file ended without its end marker
+    bool isTruncated() const { return truncated_; }
+
+private:
+    float tick_duration_ = 0.0f;
+    std::map<std::string, uint64_t> seeds_;
+    std::string snapshot_;
+    std::vector<ReplayFrame> frames_;
+    uint64_t tick_count_ = 0;
+    uint64_t command_count_ = 0;
+    bool truncated_ = false;
+};
+
+} // namespace sim
+} // namespace atlas
+
+#endif // EVE_SIM_REPLAY_LOG_H
@@ -0,0 +1,138 @@
+#ifndef EVE_SIM_STAR_SYSTEM_PARTITION_H
+#define EVE_SIM_STAR_SYSTEM_PARTITION_H
+
+#include "ecs/world.h"
+#include "sim/time_dilation.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace atlas {
+namespace sim {
+
+/**
+ * @brief How an entity is leaving its current solar system
+ */
+enum class HandoffKind {
+    Jump,       // jump drive / stargate style transfer
+    Wormhole,   // WormholeSystem jump through a WormholeConnection
+    Gate        // warp-to-gate then jump
+};
+
+/**
+ * @brief Message carrying an entity between partitions
+ *
+ * A partition only ever posts the request (entity_id, to_system); the
+ * PartitionManager releases the entity from the source world at the tick
+ * boundary and fills `entity` before delivering it to the destination.
+ */
+struct EntityHandoff {
+    HandoffKind kind = HandoffKind::Jump;
+    std::string entity_id;
+    std::string from_system;
+    std::string to_system;
+    std::unique_ptr<ecs::Entity> entity;
+};
+
+/**
+ * @brief One solar system's slice of the simulation
+ *
+ * Owns an independent ecs::World with its own system list, so partitions
+ * can be ticked concurrently on different worker threads.  The only
+ * shared state is the pair of handoff queues, both mutex-guarded.
+ *
+ * Each partition carries its own TimeDilation: a dilated partition steps
+ * its world on only a fraction of the ticks, so it both advances less
+ * simulated time and does less work, and the measured cost of every
+ * step feeds the controller for the next one.
+ *
+ * The manager's tick waits for every partition, so a dilated step is not
+ * run in one go: its systems are split into slices, one per wall tick
+ * until the next step is due, and each tick runs one slice.  A partition
+ * at factor 0.25 then adds about a quarter of its step cost to every
+ * tick instead of its whole cost to every fourth, and its neighbours keep
+ * their tick rate.  A single system costlier than the budget still
+ * overruns the tick it runs on.
+ */
+class StarSystemPartition {
+public:
+    explicit StarSystemPartition(const std::string& system_id);
+
+    const std::string& getSystemId() const { return system_id_; }
+    ecs::World& getWorld() { return world_; }
+    const ecs::World& getWorld() const { return world_; }
+
+    /**
+     * @brief Adopt arrived entities, then advance the partition world
+     *
+     * The world steps by the full delta_time when the dilated clock has
+     * accrued a step, and not at all otherwise; a dilated step runs one
+     * slice of its systems per call until it completes.  Arrivals wait in
+     * the inbox while a step is part-way through.
+     * Must be called from a single thread at a time.
+     */
+    void update(float delta_time);
+
+    /// Request that an entity leave this system (any thread)
+    void requestHandoff(const std::string& entity_id, const std::string& to_system,
+                        HandoffKind kind);
+
+    /// Deliver an entity into this partition's inbox (any thread)
+    void postInbound(EntityHandoff handoff);
+
+    /// Drop an entity still waiting in the inbox; false if it is not there
+    bool discardInbound(const std::string& entity_id);
+
+    /// Drain outgoing requests (called by the manager between ticks)
+    std::vector<EntityHandoff> takeOutbound();
+
+    size_t getPendingInbound() const;
+
+    /// Wall-clock cost of the most recent world step in milliseconds,
+    /// summed over its slices
+    double getLastTickMs() const { return last_tick_ms_; }
+    /// World steps completed (fewer than update() calls while dilated)
+    uint64_t getTickCount() const { return tick_count_; }
+    /// True while a sliced step still has systems left to run
+    bool isMidStep() const { return mid_step_; }
+
+    TimeDilation& getTimeDilation() { return dilation_; }
+    const TimeDilation& getTimeDilation() const { return dilation_; }
+    float getDilationFactor() const { return dilation_.getFactor(); }
+
+    /// Total simulated (dilated) seconds since creation
+    double getSimulatedSeconds() const { return simulated_seconds_; }
+
+private:
+    std::string system_id_;
+    ecs::World world_;
+
+    std::vector<EntityHandoff> inbound_;
+    std::vector<EntityHandoff> outbound_;
+    mutable std::mutex inbound_mutex_;
+    std::mutex outbound_mutex_;
+
+    double last_tick_ms_ = 0.0;
+    uint64_t tick_count_ = 0;
+
+    // Step in progress: systems before next_system_ have run
+    bool mid_step_ = false;
+    size_t next_system_ = 0;
+    size_t systems_per_slice_ = 0;
+    float step_delta_ = 0.0f;
+    double step_ms_ = 0.0;
+    bool step_owed_ = false;   // clock granted a step while one was running
+
+    void startStep(float delta_time);
+    void runSlice();
+
+    TimeDilation dilation_;
+    double simulated_seconds_ = 0.0;
+};
+
+} // namespace sim
+} // namespace atlas
+
+#endif // EVE_SIM_STAR_SYSTEM_PARTITION_H
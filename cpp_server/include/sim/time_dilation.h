@@ -0,0 +1,78 @@
+#ifndef EVE_SIM_TIME_DILATION_H
+#define EVE_SIM_TIME_DILATION_H
+
+namespace atlas {
+namespace sim {
+
+/**
+ * @brief Per-partition time dilation controller
+ *
+ * Tracks a smoothed step cost and derives a dilation factor in
+ * [floor, 1] for one solar system (or an unpartitioned world).
+ * When the smoothed cost exceeds the budget the factor drops at once to
+ * budget / cost (never below the floor), so an overloaded system slows
+ * down instead of dragging the whole server; once load falls the factor
+ * climbs back at a limited rate so clients never see time lurch forward.
+ *
+ * The factor throttles work, not just the clock: beginTick() grants a
+ * full-length simulation step on only a fraction `factor` of the wall
+ * ticks, so a system at 0.25 costs a quarter of the CPU per second.
+ */
+class TimeDilation {
+public:
+    struct Config {
+        bool enabled = false;
+        double budget_ms = 25.0;          // tick cost that triggers dilation
+        float floor = 0.1f;               // slowest allowed time rate
+        float recovery_per_second = 0.2f; // max factor increase per wall second
+        float smoothing = 0.2f;           // EMA weight of the newest sample
+    };
+
+    TimeDilation() = default;
+    explicit TimeDilation(const Config& config) : config_(config) {}
+
+    void setConfig(const Config& config);
+    const Config& getConfig() const { return config_; }
+
+    /**
+     * @brief Feed the cost of the tick that just ran
+     * @param tick_ms   Measured wall-clock cost of the tick
+     * @param wall_dt   Undilated tick length in seconds (paces recovery)
+     * @return The factor to apply to the next tick
+     */
+    float update(double tick_ms, float wall_dt);
+
+    float getFactor() const { return factor_; }
+    double getSmoothedTickMs() const { return smoothed_ms_; }
+    bool isDilated() const { return factor_ < 1.0f; }
+
+    /// Scale a nominal delta_time by the current factor
+    float apply(float delta_time) const { return delta_time * factor_; }
+
+    /**
+     * @brief Advance the dilated clock by one wall tick of @p delta_time
+     * @return true if the simulation should step (by the full delta_time)
+     *         this tick; then feed its cost to update() with
+     *         getStepWallSeconds()
+     */
+    bool beginTick(float delta_time);
+
+    /// Wall seconds since the previous step, as of the last granted beginTick()
+    float getStepWallSeconds() const { return step_wall_seconds_; }
+
+    void reset();
+
+private:
+    Config config_;
+    float factor_ = 1.0f;
+    double smoothed_ms_ = 0.0;
+    bool has_sample_ = false;
+    float backlog_ = 0.0f;             // dilated seconds owed to the simulation
+    float wall_since_step_ = 0.0f;
+    float step_wall_seconds_ = 0.0f;
+};
+
+} // namespace sim
+} // namespace atlas
+
+#endif // EVE_SIM_TIME_DILATION_H
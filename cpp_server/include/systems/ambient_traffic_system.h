@@ -10,6 +10,8 @@
 namespace atlas {
 namespace systems {
 
+class BackgroundSimulationSystem;
+
 /**
  * @brief Spawns ambient NPC traffic driven by star-system state
  *
@@ -25,6 +27,12 @@ namespace systems {
  * The system does not directly create entities but records spawn
  * requests in the AmbientTrafficState so that other systems or the
  * game session can act on them.
+ *
+ * Dormant systems (no observers under background fast-forward) are
+ * re-evaluated dormant_spawn_multiplier times less often.  Attached to
+ * the background simulation, spawn clocks advance only when their system
+ * does (every tick while observed, once per catch-up while dormant)
+ * instead of walking every system each tick.
  */
 class AmbientTrafficSystem : public ecs::System {
 public:
@@ -51,8 +59,16 @@ public:
     float trader_economy_threshold = 0.4f;   // min economic_index for traders
     float miner_resource_threshold = 0.3f;   // min resource_availability for miners
     float pirate_activity_threshold = 0.3f;  // min pirate_activity for pirates
+    float dormant_spawn_multiplier = 10.0f;  // spawn clock slowdown for dormant systems
+
+    /** Advance spawn clocks with the background simulation's clock */
+    void attach(BackgroundSimulationSystem* background);
 
 private:
+    bool attached_ = false;
+
+    void advanceSystem(ecs::Entity* entity, float dt);
+
     void evaluateSpawns(ecs::Entity* entity,
                         components::AmbientTrafficState* traffic,
                         const components::SimStarSystemState* state);
@@ -2,11 +2,17 @@
 #define EVE_SYSTEMS_BACKGROUND_SIMULATION_SYSTEM_H
 
 #include "ecs/system.h"
+#include "ecs/entity.h"
 #include "components/game_components.h"
+#include "utils/timer_wheel.h"
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace atlas {
+namespace data { class MarketHistory; }
 namespace systems {
 
 /**
@@ -15,6 +21,18 @@ namespace systems {
  * Updates per-system state vectors each tick: traffic, economy, security,
  * faction influence.  Triggers threshold-based events (pirate surge,
  * resource shortage, lockdown) when conditions are met.
+ *
+ * With fast-forward enabled only observed systems (those with at least
+ * one observer) tick every frame.  Unobserved systems are suspended and
+ * marked dormant; each is caught up in a few coarse steps on a slow
+ * staggered cadence (dormant_sync_interval) and immediately when an
+ * observer arrives, so an empty universe costs almost nothing per tick.
+ * The drift equations are integrated exactly over any step length, so a
+ * coarse catch-up lands close to where per-frame ticking would have.
+ *
+ * Per-system work elsewhere (NPC intents, ambient traffic) follows the
+ * same clock through addAdvanceListener(), so it too only runs for the
+ * systems that are ticking.
  */
 class BackgroundSimulationSystem : public ecs::System {
 public:
@@ -26,7 +44,8 @@ public:
 
     // --- Query API ---
 
-    /** Get the current system state for a star system entity */
+    /** Get the current system state for a star system entity (a dormant
+     *  system's state is as of its last catch-up, see synced_at) */
     const components::SimStarSystemState* getSystemState(const std::string& system_id) const;
 
     /** Check if a specific event is active in a system */
@@ -35,6 +54,56 @@ public:
     /** Get list of systems currently in a specific event state */
     std::vector<std::string> getSystemsWithEvent(const std::string& event_type) const;
 
+    // --- Observation / fast-forward ---
+
+    /**
+     * Suspend unobserved systems and advance them in coarse catch-ups.
+     * Disabling wakes every dormant system, caught up to the current time.
+     */
+    void setFastForward(bool enabled);
+    bool isFastForward() const { return fast_forward_; }
+
+    /** A player entered the system; wakes and catches it up if dormant */
+    void addObserver(const std::string& system_id);
+
+    /** A player left the system; the last one out suspends it */
+    void removeObserver(const std::string& system_id);
+
+    bool isDormant(const std::string& system_id) const;
+
+    /** Simulation time accumulated by update() */
+    double now() const { return now_; }
+
+    /** Systems ticking every frame under fast-forward */
+    size_t getLiveCount() const { return live_.size(); }
+
+    /** Coarse catch-ups run since construction */
+    uint64_t getCatchUpCount() const { return catch_ups_; }
+
+    /**
+     * Called with a system's entity and the time it advanced by: every
+     * tick for each ticking system, and once per catch-up (state still
+     * dormant) for a suspended one.
+     */
+    using AdvanceListener = std::function<void(ecs::Entity* system, float dt)>;
+    void addAdvanceListener(AdvanceListener listener) {
+        listeners_.push_back(std::move(listener));
+    }
+
+    // --- Market feed ---
+
+    /**
+     * Read trade activity from the aggregated market history instead of
+     * order books.  Each tick, trade_volume of a system is set from the
+     * last hour of volume at MarketHubs whose system_id names it, timed
+     * by `trade_clock` (the clock trades are stamped with).
+     */
+    void setMarketHistory(const data::MarketHistory* history,
+                          std::function<double()> trade_clock) {
+        market_history_ = history;
+        trade_clock_ = std::move(trade_clock);
+    }
+
     // --- Configuration ---
 
     /** Thresholds for triggering events */
@@ -49,7 +118,39 @@ public:
     float resource_regen_rate = 0.002f;        // resources slowly regenerate
     float event_duration = 300.0f;             // default event duration in seconds
 
+    /** Hourly traded units at which trade_volume saturates at 1.0 */
+    float market_reference_volume = 10000.0f;
+
+    /** Fast-forward: longest a dormant system goes without a catch-up */
+    float dormant_sync_interval = 600.0f;
+    /** Fast-forward: preferred catch-up step, and the most steps per catch-up */
+    float fast_forward_step = 60.0f;
+    int fast_forward_max_steps = 16;
+
 private:
+    const data::MarketHistory* market_history_ = nullptr;
+    std::function<double()> trade_clock_;
+
+    bool fast_forward_ = false;
+    double now_ = 0.0;
+    double next_discovery_ = 0.0;
+    std::vector<std::string> live_;               // observed, ticked every frame
+    std::unordered_set<std::string> known_;       // live or dormant
+    utils::TimerWheel dormant_wheel_;             // dormant id -> next catch-up
+    std::vector<utils::TimerWheel::Timer> due_;   // reused by update()
+    uint64_t catch_ups_ = 0;
+    std::vector<AdvanceListener> listeners_;
+
+    void updateFastForward(float delta_time);
+    void discoverSystems();
+    void suspend(const std::string& system_id, components::SimStarSystemState* state,
+                 double first_sync);
+    void catchUp(ecs::Entity* entity, components::SimStarSystemState* state);
+    void tickSystem(const std::string& system_id, components::SimStarSystemState* state,
+                    float dt);
+    void notifyAdvance(ecs::Entity* system, float dt);
+
+    void applyMarketTrends();
     void updateSystemState(components::SimStarSystemState* state, float dt);
     void evaluateEvents(const std::string& system_id, components::SimStarSystemState* state);
     void tickEventTimers(components::SimStarSystemState* state, float dt);
@@ -3,6 +3,7 @@
 
 #include "ecs/system.h"
 #include "ecs/entity.h"
+#include "systems/damage_pipeline.h"
 #include <string>
 #include <functional>
 
@@ -35,9 +36,30 @@ public:
      * @param target_id Target entity ID
      * @param damage Amount of damage
      * @param damage_type Damage type (em, thermal, kinetic, explosive)
+     * @param attacker_id Source entity, reported in the emitted events
      * @return true if damage was applied, false otherwise
      */
-    bool applyDamage(const std::string& target_id, float damage, const std::string& damage_type);
+    bool applyDamage(const std::string& target_id, float damage, const std::string& damage_type,
+                     const std::string& attacker_id = "");
+
+    /**
+     * @brief Queue damage for batched resolution at the next update()
+     *
+     * Hits are resolved per target by the DamagePipeline, which records one
+     * aggregated DamageEvent hit and one DamageDealtEvent per target per tick.
+     * @return false if the damage type is unknown or the amount is not positive
+     */
+    bool queueDamage(const std::string& target_id, float damage, DamageType damage_type,
+                     const std::string& attacker_id = "");
+
+    /**
+     * @brief Aggregated damage resolved during the last update()
+     */
+    const std::vector<ResolvedDamage>& getResolvedDamage() const {
+        return pipeline_.getLastResults();
+    }
+
+    DamagePipeline& getDamagePipeline() { return pipeline_; }
     
     /**
      * @brief Fire weapon at target
@@ -49,11 +71,24 @@ public:
 
     /**
      * @brief Register a callback for entity death (hull reaches zero)
+     *
+     * Every death is also emitted as an EntityKilledEvent on the world's
+     * event bus.
      */
     void setDeathCallback(DeathCallback cb) { death_callback_ = std::move(cb); }
     
 private:
     DeathCallback death_callback_;
+    DamagePipeline pipeline_;
+
+    void notifyDeath(ecs::Entity* target, const std::string& killer_id);
+
+    /// Record a hit on the target's DamageEvent and emit a DamageDealtEvent
+    void recordHit(ecs::Entity* target, const components::Health& health,
+                   float hp_before, float damage, const std::string& damage_type,
+                   const std::string& layer_hit, bool shield_depleted,
+                   bool armor_depleted, bool hull_critical,
+                   const std::string& attacker_id);
     /**
      * @brief Calculate effective damage after resistances
      */
@@ -64,7 +99,7 @@ private:
      */
     float getResistance(float em_resist, float thermal_resist, 
                        float kinetic_resist, float explosive_resist,
-                       const std::string& damage_type);
+                       DamageType damage_type);
 };
 
 } // namespace systems
@@ -0,0 +1,149 @@
+#ifndef EVE_SYSTEMS_DAMAGE_PIPELINE_H
+#define EVE_SYSTEMS_DAMAGE_PIPELINE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+namespace ecs {
+class World;
+}
+namespace components {
+class Health;
+}
+
+namespace systems {
+
+/**
+ * @brief Damage types, usable as indices into per-type lane arrays
+ */
+enum class DamageType : uint8_t {
+    EM = 0,
+    Thermal,
+    Kinetic,
+    Explosive,
+    Count
+};
+
+constexpr int DAMAGE_TYPE_COUNT = static_cast<int>(DamageType::Count);
+
+/// Map a data-file damage type string to the enum (Count if unknown)
+DamageType parseDamageType(const std::string& name);
+
+/// Lower-case name as used in data files and network messages
+const char* damageTypeName(DamageType type);
+
+/**
+ * @brief Amounts per damage type, laid out for straight-line lane math
+ */
+struct DamageVector {
+    float amount[DAMAGE_TYPE_COUNT] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+    float total() const {
+        return amount[0] + amount[1] + amount[2] + amount[3];
+    }
+};
+
+/**
+ * @brief Outcome of pushing a damage vector through shield, armor, hull
+ */
+struct LayerResult {
+    float applied = 0.0f;          // HP actually removed across all layers
+    std::string layer_hit;         // deepest layer that took damage
+    bool shield_depleted = false;
+    bool armor_depleted = false;
+    bool hull_critical = false;    // hull below 25% afterwards
+    bool destroyed = false;        // hull reached zero on this application
+};
+
+/**
+ * @brief Apply a damage vector to a Health component
+ *
+ * Each layer's four resistances are applied at once; damage a layer
+ * cannot absorb carries to the next layer as raw (pre-resist) damage,
+ * scaled down by the fraction the layer did absorb.
+ */
+LayerResult applyDamageVector(components::Health& health, DamageVector damage);
+
+/**
+ * @brief Aggregated damage for one target over one flush
+ *
+ * Mirrors the fields of ProtocolHandler::createDamageEvent so the
+ * network layer can send one message per target per tick.
+ */
+struct ResolvedDamage {
+    std::string target_id;
+    std::string attacker_id;       // source that contributed the most damage
+    float damage = 0.0f;           // raw damage received
+    float applied = 0.0f;          // HP removed after resistances
+    std::string damage_type;       // dominant damage type
+    std::string layer_hit;
+    bool shield_depleted = false;
+    bool armor_depleted = false;
+    bool hull_critical = false;
+    bool destroyed = false;
+    int hit_count = 0;
+};
+
+/**
+ * @brief Per-tick damage buffer resolved in one batch
+ *
+ * Weapons queue compact records (target slot, type, amount) during the
+ * tick instead of touching the target immediately.  flush() sorts the
+ * records by target, sums each target's hits into a DamageVector, and
+ * resolves resistances once per target — so the entity lookup, Health
+ * fetch and DamageEvent update happen once per target rather than once
+ * per shot.  Each resolved target is also emitted on the world's event
+ * bus as a DamageDealtEvent.
+ */
+class DamagePipeline {
+public:
+    /**
+     * @brief Queue a hit for the next flush
+     * @param source_id Shooter, used to attribute the target's damage (may be empty)
+     * @return false if the damage type is unknown or the amount is not positive
+     */
+    bool queue(const std::string& target_id, float amount, DamageType type,
+               const std::string& source_id = "");
+
+    /**
+     * @brief Resolve all queued hits against the world
+     * @return Aggregated damage, one entry per target that still exists
+     */
+    const std::vector<ResolvedDamage>& flush(ecs::World& world);
+
+    /// Results of the most recent flush
+    const std::vector<ResolvedDamage>& getLastResults() const { return results_; }
+
+    /// Incremented by every flush(); lets consumers skip stale results
+    uint64_t getFlushCount() const { return flush_count_; }
+
+    size_t getQueuedCount() const { return records_.size(); }
+    size_t getQueuedTargetCount() const { return target_ids_.size(); }
+    void clear();
+
+private:
+    static constexpr uint32_t NO_SOURCE = 0xFFFFFFFFu;
+
+    struct Record {
+        uint32_t target;           // index into target_ids_
+        uint32_t source;           // index into source_ids_, or NO_SOURCE
+        DamageType type;
+        float amount;
+    };
+
+    std::vector<Record> records_;
+    std::vector<std::string> target_ids_;
+    std::unordered_map<std::string, uint32_t> target_slots_;
+    std::vector<std::string> source_ids_;
+    std::unordered_map<std::string, uint32_t> source_slots_;
+    std::vector<ResolvedDamage> results_;
+    uint64_t flush_count_ = 0;
+};
+
+} // namespace systems
+} // namespace atlas
+
+#endif // EVE_SYSTEMS_DAMAGE_PIPELINE_H
@@ -0,0 +1,69 @@
+#ifndef EVE_SYSTEMS_GAME_EVENTS_H
+#define EVE_SYSTEMS_GAME_EVENTS_H
+
+#include <string>
+
+namespace atlas {
+namespace systems {
+
+/**
+ * Event payloads carried on ecs::EventBus.  Each is a plain value type
+ * stored contiguously in its own stream; keep them copy-assignable so the
+ * stream can recycle slots.
+ */
+
+/// One target's resolved damage for a tick (or one immediate hit)
+struct DamageDealtEvent {
+    std::string target_id;
+    std::string attacker_id;       // largest contributor; empty if unknown
+    float damage = 0.0f;           // raw damage received
+    float applied = 0.0f;          // HP removed after resistances
+    std::string damage_type;
+    std::string layer_hit;
+    bool shield_depleted = false;
+    bool armor_depleted = false;
+    bool hull_critical = false;
+    bool destroyed = false;
+};
+
+/// An entity's hull reached zero
+struct EntityKilledEvent {
+    std::string victim_id;
+    std::string killer_id;         // empty if unknown
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+};
+
+/// Dock or undock at a station
+struct DockEvent {
+    std::string entity_id;
+    std::string station_id;
+    bool docked = true;            // false for an undock
+};
+
+/// A warp started or finished
+struct WarpEvent {
+    enum class Phase { Started, Completed };
+
+    std::string entity_id;
+    Phase phase = Phase::Started;
+    float dest_x = 0.0f;
+    float dest_y = 0.0f;
+    float dest_z = 0.0f;
+};
+
+/// An objective of an active mission advanced
+struct MissionProgressEvent {
+    std::string entity_id;
+    std::string mission_id;
+    std::string objective_type;
+    std::string target;
+    int completed = 0;
+    int required = 0;
+};
+
+} // namespace systems
+} // namespace atlas
+
+#endif // EVE_SYSTEMS_GAME_EVENTS_H
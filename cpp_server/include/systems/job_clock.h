@@ -0,0 +1,100 @@
+#ifndef EVE_SYSTEMS_JOB_CLOCK_H
+#define EVE_SYSTEMS_JOB_CLOCK_H
+
+#include "utils/timer_wheel.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+namespace ecs {
+class Entity;
+class World;
+}
+
+namespace systems {
+
+/**
+ * @brief Lazily advanced timers for long-running per-entity jobs
+ *
+ * Skill training, manufacturing, research and PI cycles finish minutes to
+ * days after they start.  Instead of decrementing every timer every tick,
+ * a system hands its per-entity catch-up routine to a JobClock and calls
+ * advance() from update().  The clock remembers when each entity was last
+ * brought up to date and wakes it through a TimerWheel only when its next
+ * job is due; queries call sync() to settle an entity on demand.
+ *
+ * The sync function applies @p elapsed seconds to the entity's jobs
+ * (completing any that finish, carrying the remainder into the next one)
+ * and returns the seconds until its next completion, or a negative value
+ * once nothing is left running.
+ *
+ * Jobs that appear without touch() (an entity adopted from another
+ * partition, a cloned component, a loaded save) are found by the
+ * optional discover function, which lists every entity with running
+ * jobs.  It runs on the first advance() and then once per discovery
+ * interval; an untracked entity it returns is timed from that scan.
+ */
+class JobClock {
+public:
+    using SyncFunction = std::function<double(ecs::Entity& entity, double elapsed)>;
+    using DiscoverFunction = std::function<void(std::vector<ecs::Entity*>& running)>;
+
+    JobClock(ecs::World* world, SyncFunction sync, DiscoverFunction discover = nullptr,
+             double discovery_interval = 60.0, double resolution = 1.0);
+
+    /// Advance the clock and settle every entity whose next job is due
+    void advance(float delta_time);
+
+    /**
+     * @brief Settle @p entity_id before its jobs are changed
+     *
+     * Call before adding, cancelling or editing jobs: elapsed time is
+     * credited to the existing jobs, and the entity is re-examined on the
+     * next advance() so the change takes effect from now.
+     */
+    void touch(const std::string& entity_id);
+
+    /// Bring @p entity_id up to the current time and reschedule it
+    void sync(const std::string& entity_id);
+
+    /// Seconds since the clock was created
+    double now() const { return now_; }
+
+    /// Entities with running jobs
+    size_t trackedCount() const { return tracked_.size(); }
+
+    /// Calls into the sync function since construction
+    uint64_t syncCount() const { return sync_count_; }
+
+    const utils::TimerWheel& timers() const { return timers_; }
+
+private:
+    struct Tracked {
+        double synced_at = 0.0;
+        double next = 0.0;      // seconds after synced_at the next job finishes
+    };
+
+    void settle(const std::string& entity_id, bool deadline_reached);
+    void forget(const std::string& entity_id);
+    void discover();
+
+    ecs::World* world_;
+    SyncFunction sync_;
+    DiscoverFunction discover_;
+    double discovery_interval_;
+    double next_discovery_ = 0.0;
+    std::vector<ecs::Entity*> discovered_;
+    utils::TimerWheel timers_;
+    double now_ = 0.0;
+    std::unordered_map<std::string, Tracked> tracked_;
+    std::vector<utils::TimerWheel::Timer> fired_;
+    uint64_t sync_count_ = 0;
+};
+
+} // namespace systems
+} // namespace atlas
+
+#endif // EVE_SYSTEMS_JOB_CLOCK_H
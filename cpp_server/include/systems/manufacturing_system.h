@@ -2,6 +2,7 @@
 #define EVE_SYSTEMS_MANUFACTURING_SYSTEM_H
 
 #include "ecs/system.h"
+#include "systems/job_clock.h"
 #include <string>
 
 namespace atlas {
@@ -12,6 +13,11 @@ namespace systems {
  *
  * Manages manufacturing jobs: starting jobs, ticking time,
  * completing runs, and delivering output.
+ *
+ * Facilities are settled lazily through a JobClock, only when a run
+ * finishes or a query needs current counts; an idle production line
+ * costs nothing per tick.  ManufacturingJob::time_remaining is as of the
+ * last settle; use getJobTimeRemaining() for the live value.
  */
 class ManufacturingSystem : public ecs::System {
 public:
@@ -56,8 +62,21 @@ public:
      */
     int getTotalRunsCompleted(const std::string& facility_entity_id);
 
+    /**
+     * @brief Seconds until the current run of a job completes
+     * @return remaining time, or 0 if the job is unknown or not active
+     */
+    float getJobTimeRemaining(const std::string& facility_entity_id,
+                              const std::string& job_id);
+
+    const JobClock& getClock() const { return clock_; }
+
 private:
+    /// Apply @p elapsed seconds to every active job; returns seconds to the next run
+    double settleJobs(ecs::Entity& entity, double elapsed);
+
     int job_counter_ = 0;
+    JobClock clock_;
 };
 
 } // namespace systems
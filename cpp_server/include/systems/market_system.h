@@ -2,6 +2,7 @@
 #define EVE_SYSTEMS_MARKET_SYSTEM_H
 
 #include "ecs/system.h"
+#include "data/market_history.h"
 #include <string>
 #include <vector>
 
@@ -70,15 +71,27 @@ public:
      * @brief Seed a station's market with NPC sell orders for common minerals
      *
      * Creates permanent sell orders for Tritanium, Pyerite, Mexallon, and
-     * Nocxidium at baseline prices so players can always buy basic materials.
+     * Nocxidium so players can always buy basic materials.  Prices follow
+     * the hub's recent daily average from the history store when one
+     * exists (clamped to 0.5x-2x baseline), otherwise baseline prices.
      *
      * @param station_id Entity id of the station with a MarketHub component
      * @return number of NPC orders created
      */
     int seedNPCOrders(const std::string& station_id);
 
+    /// Aggregated OHLC trade history for every hub (read-only)
+    const data::MarketHistory& getHistory() const { return history_; }
+    data::MarketHistory& getHistory() { return history_; }
+
+    /// Simulation clock used to timestamp trades (seconds)
+    double getSimTime() const { return sim_time_; }
+    void setSimTime(double seconds) { sim_time_ = seconds; }
+
 private:
     int order_counter_ = 0;
+    double sim_time_ = 0.0;
+    data::MarketHistory history_;
 };
 
 } // namespace systems
@@ -5,12 +5,15 @@
 #include "ecs/entity.h"
 #include "components/game_components.h"
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
 namespace atlas {
 namespace systems {
 
+class BackgroundSimulationSystem;
+
 /**
  * @brief Evaluates and assigns intents to NPC entities
  *
@@ -22,6 +25,16 @@ namespace systems {
  *
  * Once an intent is chosen it persists until completed, interrupted
  * by danger, or the cooldown expires.
+ *
+ * Standalone, NPCs whose target system is dormant (see
+ * BackgroundSimulationSystem fast-forward) bank their elapsed time and
+ * are evaluated only once every dormant_update_interval seconds, with
+ * the banked time applied in one step.
+ *
+ * Attached to the background simulation, NPCs are kept in a per-system
+ * roster and advanced when their target system advances: every tick
+ * while it is observed, once per catch-up while it is dormant.  Only
+ * NPCs without a simulated target system are walked every tick.
  */
 class NPCIntentSystem : public ecs::System {
 public:
@@ -33,6 +46,14 @@ public:
 
     // --- Configuration ---
     float re_eval_interval = 30.0f;  // seconds between intent re-evaluation
+    float dormant_update_interval = 120.0f;  // batch period for NPCs in dormant systems (standalone)
+    float roster_refresh_interval = 30.0f;   // seconds between per-system roster rebuilds (attached)
+
+    /** Advance NPCs with their target system's background clock */
+    void attach(BackgroundSimulationSystem* background);
+
+    /** Rebuild the per-system roster now (after spawning or retargeting NPCs) */
+    void refreshRoster();
 
     // --- Query API ---
 
@@ -59,9 +80,21 @@ public:
                      components::SimNPCIntent::Intent intent);
 
 private:
+    BackgroundSimulationSystem* background_ = nullptr;
+    std::unordered_map<std::string, std::vector<std::string>> roster_;  // system id -> NPC ids
+    std::vector<std::string> unassigned_;  // NPCs without a simulated target system
+    float roster_age_ = 0.0f;
+
+    void advanceSystem(ecs::Entity* system, float dt);
+    void advance(ecs::Entity* entity, components::SimNPCIntent* intent, float dt,
+                 const components::SimStarSystemState* sys_state);
+    const components::SimStarSystemState*
+    targetSystemState(const components::SimNPCIntent* intent) const;
+    bool inDormantSystem(const components::SimNPCIntent* intent) const;
+
     void evaluateIntent(ecs::Entity* entity,
                         components::SimNPCIntent* intent,
-                        float dt);
+                        const components::SimStarSystemState* sys_state);
 
     float scoreForSystem(components::SimNPCIntent::Intent intent,
                          const components::SimNPCIntent* npc,
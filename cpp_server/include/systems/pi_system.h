@@ -2,6 +2,7 @@
 #define EVE_SYSTEMS_PI_SYSTEM_H
 
 #include "ecs/system.h"
+#include "systems/job_clock.h"
 #include <string>
 
 namespace atlas {
@@ -12,6 +13,10 @@ namespace systems {
  *
  * Manages planetary colonies: extraction cycles, processing,
  * storage, and resource transfer to player inventory.
+ *
+ * Colonies are settled lazily through a JobClock: only when one of
+ * their extractor or processor cycles completes, or when storage is
+ * queried.
  */
 class PISystem : public ecs::System {
 public:
@@ -60,9 +65,15 @@ public:
      */
     int getProcessorCount(const std::string& colony_entity_id);
 
+    const JobClock& getClock() const { return clock_; }
+
 private:
+    /// Run @p elapsed seconds of extractor and processor cycles; returns seconds to the next cycle
+    double settleColony(ecs::Entity& entity, double elapsed);
+
     int extractor_counter_ = 0;
     int processor_counter_ = 0;
+    JobClock clock_;
 };
 
 } // namespace systems
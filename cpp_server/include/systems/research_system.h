@@ -2,6 +2,8 @@
 #define EVE_SYSTEMS_RESEARCH_SYSTEM_H
 
 #include "ecs/system.h"
+#include "systems/job_clock.h"
+#include <cstdint>
 #include <string>
 
 namespace atlas {
@@ -71,13 +73,33 @@ public:
      */
     int getFailedJobCount(const std::string& lab_entity_id);
 
+    /**
+     * @brief Seconds until a research job completes
+     * @return remaining time, or 0 if the job is unknown or not active
+     */
+    float getJobTimeRemaining(const std::string& lab_entity_id,
+                              const std::string& job_id);
+
+    const JobClock& getClock() const { return clock_; }
+
+    /// Invention roll state and job id counter; part of a recording's seeds
+    uint32_t getRngState() const { return rng_state_; }
+    void setRngState(uint32_t state) { rng_state_ = state; }
+    int getJobCounter() const { return job_counter_; }
+    void setJobCounter(int counter) { job_counter_ = counter; }
+
 private:
+    /// Apply @p elapsed seconds to every active job; returns seconds to the next completion
+    double settleJobs(ecs::Entity& entity, double elapsed);
+
     int job_counter_ = 0;
 
     // Deterministic "random" for invention success
     // Uses a simple LCG to keep results predictable in tests
-    unsigned int rng_state_ = 42;
+    uint32_t rng_state_ = 42;
     float nextRandom();
+
+    JobClock clock_;
 };
 
 } // namespace systems
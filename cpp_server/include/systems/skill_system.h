@@ -2,6 +2,7 @@
 #define EVE_SYSTEMS_SKILL_SYSTEM_H
 
 #include "ecs/system.h"
+#include "systems/job_clock.h"
 #include <string>
 
 namespace atlas {
@@ -10,10 +11,16 @@ namespace systems {
 /**
  * @brief Processes skill training queues and applies completion
  *
- * Each tick:
+ * Training is settled lazily through a JobClock: a pilot is only touched
+ * when the skill at the front of their queue finishes or when they are
+ * queried.  Settling then:
  *  - Decrements time_remaining on the front of the training queue
- *  - On completion, levels up the skill and pops from queue
+ *  - On completion, levels up the skill, pops it from the queue and
+ *    carries the leftover time into the next entry
  *  - Accumulates total SP
+ *
+ * QueueEntry::time_remaining is therefore as of the last settle; use
+ * getTrainingTimeRemaining() for the live value.
  */
 class SkillSystem : public ecs::System {
 public:
@@ -48,6 +55,20 @@ public:
      */
     int getSkillLevel(const std::string& entity_id,
                       const std::string& skill_id);
+
+    /**
+     * @brief Seconds until the skill at the front of the queue completes
+     * @return remaining time, or 0 if nothing is training
+     */
+    float getTrainingTimeRemaining(const std::string& entity_id);
+
+    const JobClock& getClock() const { return clock_; }
+
+private:
+    /// Apply @p elapsed seconds of training; returns seconds to the next completion
+    double settleTraining(ecs::Entity& entity, double elapsed);
+
+    JobClock clock_;
 };
 
 } // namespace systems
@@ -3,16 +3,23 @@
 
 #include "ecs/system.h"
 #include <string>
+#include <unordered_set>
 
 namespace atlas {
 namespace systems {
 
+class CombatSystem;
+
 /**
  * @brief Handles weapon cooldowns and auto-fire for NPC entities
  * 
  * Manages weapon cycle times and triggers auto-fire for AI-controlled
  * entities that are in the Attacking state. Consumes capacitor when
- * firing weapons. Delegates damage application to CombatSystem.
+ * firing weapons. When linked to a CombatSystem, hits are queued into its
+ * damage pipeline and resolved in one batch per target at the end of the
+ * tick; otherwise they are applied to the target immediately.  A weapon
+ * with an unrecognised damage type hits at once with no resistance, as it
+ * always has, and the type is logged the first time it is seen.
  */
 class WeaponSystem : public ecs::System {
 public:
@@ -29,8 +36,18 @@ public:
      * @return true if weapon fired successfully
      */
     bool fireWeapon(const std::string& shooter_id, const std::string& target_id);
+
+    /**
+     * @brief Route hits through CombatSystem's batched damage pipeline
+     *
+     * The CombatSystem must run after this system in the same world.
+     */
+    void setCombatSystem(CombatSystem* combat) { combat_ = combat; }
     
 private:
+    CombatSystem* combat_ = nullptr;
+    std::unordered_set<std::string> warned_damage_types_;
+
     /**
      * @brief Calculate damage falloff based on distance
      * @return Damage multiplier (0.0 - 1.0)
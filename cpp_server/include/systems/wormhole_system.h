@@ -3,6 +3,7 @@
 
 #include "ecs/system.h"
 #include "data/wormhole_database.h"
+#include <functional>
 #include <string>
 
 namespace atlas {
@@ -30,6 +31,20 @@ public:
      */
     bool jumpThroughWormhole(const std::string& wormhole_entity_id, double ship_mass);
 
+    /// Called after a ship jumps so it can be moved to the destination system
+    using HandoffCallback = std::function<void(const std::string& ship_id,
+                                               const std::string& destination_system)>;
+    void setHandoffCallback(HandoffCallback callback) { handoff_callback_ = std::move(callback); }
+
+    /**
+     * @brief Jump a specific ship and hand it off to the destination system
+     *
+     * Same mass checks as jumpThroughWormhole(); on success the handoff
+     * callback (if set) receives the ship and the connection's destination.
+     */
+    bool jumpShipThroughWormhole(const std::string& wormhole_entity_id,
+                                 const std::string& ship_id, double ship_mass);
+
     /**
      * @brief Check whether a wormhole is still open
      */
@@ -46,6 +61,9 @@ public:
      * @return fraction, or -1.0 if entity not found
      */
     float getRemainingLifetimeFraction(const std::string& wormhole_entity_id) const;
+
+private:
+    HandoffCallback handoff_callback_;
 };
 
 } // namespace systems
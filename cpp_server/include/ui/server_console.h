@@ -6,7 +6,7 @@
  *
  * Provides:
  *   - Non-blocking stdin command reading
- *   - Command dispatching (status, help, kick, stop, players, uptime)
+ *   - Command dispatching (status, help, kick, stop, players, uptime, clients)
  *   - Log message buffering for display
  *
  * See docs/server_gui_design.md for full design specification.
@@ -165,6 +165,7 @@ private:
     std::string handleKickCommand(const std::string& player_name);
     std::string handleStopCommand();
     std::string handleMetricsCommand();
+    std::string handleClientsCommand(const std::vector<std::string>& args);
     std::string handleSaveCommand();
     std::string handleLoadCommand();
 
@@ -2,9 +2,18 @@
 #define EVE_LOGGER_H
 
 #include <string>
+#include <algorithm>
 #include <fstream>
 #include <mutex>
 #include <memory>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
 
 namespace atlas {
 namespace utils {
@@ -33,6 +42,106 @@ enum class LogLevel {
 #undef EVE_LOGGER_RESTORE_ERROR_MACRO
 #endif
 
+/**
+ * @brief What an async producer does when its ring buffer is full
+ */
+enum class LogOverflow {
+    Drop,   // discard the message and count it (never stalls the caller)
+    Block   // wake the writer and wait for space, up to block_timeout_ms
+};
+
+/**
+ * @brief Argument packing for Logger::logFormat()
+ *
+ * Arithmetic values are stored as raw bytes and strings as a 16-bit
+ * length plus their characters, so the caller only pays for a memcpy;
+ * the writer thread decodes them back in argument order.
+ */
+namespace log_format {
+
+template <typename T>
+constexpr bool isString() {
+    using D = std::decay_t<T>;
+    return std::is_same<D, const char*>::value || std::is_same<D, char*>::value ||
+           std::is_same<D, std::string>::value || std::is_same<D, std::string_view>::value;
+}
+
+/// Bytes an argument takes regardless of its contents
+template <typename T>
+constexpr size_t fixedSize() {
+    if constexpr (isString<T>()) {
+        return sizeof(uint16_t);
+    } else {
+        static_assert(std::is_arithmetic<std::decay_t<T>>::value,
+                      "logFormat arguments must be arithmetic or strings");
+        return sizeof(std::decay_t<T>);
+    }
+}
+
+inline std::string_view view(const char* s) { return s ? std::string_view(s) : std::string_view("(null)"); }
+inline std::string_view view(const std::string& s) { return s; }
+inline std::string_view view(std::string_view s) { return s; }
+
+void appendValue(std::string& out, bool value);
+void appendValue(std::string& out, char value);
+void appendValue(std::string& out, long long value);
+void appendValue(std::string& out, unsigned long long value);
+void appendValue(std::string& out, double value);
+
+/// Copy up to the next "{}" of @p format into @p out and step past it
+void nextPlaceholder(std::string& out, const char*& format);
+
+/// Store one argument at @p p; strings are cut to fit @p budget
+template <typename T>
+char* encode(char* p, size_t& budget, const T& value) {
+    if constexpr (isString<T>()) {
+        std::string_view s = view(value);
+        uint16_t n = static_cast<uint16_t>(std::min(s.size(), budget));
+        budget -= n;
+        std::memcpy(p, &n, sizeof(n));
+        std::memcpy(p + sizeof(n), s.data(), n);
+        return p + sizeof(n) + n;
+    } else {
+        std::decay_t<T> v = value;
+        std::memcpy(p, &v, sizeof(v));
+        return p + sizeof(v);
+    }
+}
+
+template <typename T>
+const char* decode(const char* p, std::string& out) {
+    if constexpr (isString<T>()) {
+        uint16_t n;
+        std::memcpy(&n, p, sizeof(n));
+        out.append(p + sizeof(n), n);
+        return p + sizeof(n) + n;
+    } else {
+        T v;
+        std::memcpy(&v, p, sizeof(v));
+        if constexpr (std::is_same<T, bool>::value || std::is_same<T, char>::value) {
+            appendValue(out, v);
+        } else if constexpr (std::is_floating_point<T>::value) {
+            appendValue(out, static_cast<double>(v));
+        } else if constexpr (std::is_signed<T>::value) {
+            appendValue(out, static_cast<long long>(v));
+        } else {
+            appendValue(out, static_cast<unsigned long long>(v));
+        }
+        return p + sizeof(v);
+    }
+}
+
+/// Substitute the packed arguments for the "{}" placeholders in order
+template <typename... Args>
+void render(std::string& out, const char* format, const char* args) {
+    const char* p = args;
+    ((nextPlaceholder(out, format), p = decode<Args>(p, out)), ...);
+    (void)p;
+    out += format;
+}
+
+} // namespace log_format
+
 /**
  * @brief Thread-safe structured logging system
  *
@@ -40,14 +149,31 @@ enum class LogLevel {
  * and an optional log file.  Respects the `log_path` field that
  * already exists in ServerConfig but was previously unused.
  *
+ * By default every call formats and writes synchronously.  After
+ * startAsync() a call only moves the message into the calling thread's
+ * lock-free ring buffer; a background writer drains all rings, orders
+ * the batch by time and writes it with one flush per sink.  An optional
+ * JSON-lines sink and size-based rotation apply in either mode.
+ *
  * Usage:
  *   auto& log = Logger::instance();
  *   log.init("./logs");            // opens ./logs/server.log
  *   log.setLevel(LogLevel::INFO);
+ *   log.startAsync();              // optional: move I/O off the caller
  *   log.info("Server started on port " + std::to_string(8765));
  */
 class Logger {
 public:
+    struct AsyncOptions {
+        size_t ring_capacity = 8192;          // entries per producer thread (rounded up to 2^n)
+        LogOverflow overflow = LogOverflow::Drop;
+        int flush_interval_ms = 20;           // writer wake-up period
+        int block_timeout_ms = 100;           // longest a Block producer waits before dropping
+    };
+
+    /// Argument bytes a logFormat() call can carry inline
+    static constexpr size_t kInlineArgBytes = 96;
+
     /// Singleton accessor
     static Logger& instance();
 
@@ -60,7 +186,14 @@ public:
     bool init(const std::string& log_dir,
               const std::string& filename = "server.log");
 
-    /// Close the log file (called automatically on destruction)
+    /**
+     * @brief Open the structured sink: one JSON object per line
+     * @return true if the file was opened successfully
+     */
+    bool initJson(const std::string& log_dir,
+                  const std::string& filename = "server.jsonl");
+
+    /// Flush pending messages and close the log files (called automatically on destruction)
     void shutdown();
 
     /// Set minimum severity that will be recorded
@@ -70,14 +203,45 @@ public:
     LogLevel getLevel() const;
 
     // Convenience logging methods
-    void debug(const std::string& message);
-    void info(const std::string& message);
-    void warn(const std::string& message);
-    void error(const std::string& message);
-    void fatal(const std::string& message);
+    void debug(std::string message);
+    void info(std::string message);
+    void warn(std::string message);
+    void error(std::string message);
+    void fatal(std::string message);
 
     /// General-purpose log call
-    void log(LogLevel level, const std::string& message);
+    void log(LogLevel level, std::string message);
+
+    /**
+     * @brief Log with formatting deferred to the writer
+     *
+     * Each "{}" in @p format is replaced by the next argument.  The call
+     * itself only reads the clock and copies the raw arguments into the
+     * ring, so it stays in the tens of nanoseconds where building a
+     * std::string would not.  @p format is kept by pointer and must be
+     * a string literal.  Strings are truncated to fit kInlineArgBytes.
+     */
+    template <typename... Args>
+    void logFormat(LogLevel level, const char* format, const Args&... args) {
+        if (level < min_level_.load(std::memory_order_relaxed)) return;
+        constexpr size_t fixed = (size_t(0) + ... + log_format::fixedSize<Args>());
+        static_assert(fixed <= kInlineArgBytes, "too many arguments for one logFormat call");
+        alignas(8) char packed[kInlineArgBytes];
+        size_t budget = kInlineArgBytes - fixed;
+        char* end = packed;
+        ((end = log_format::encode(end, budget, args)), ...);
+        logPacked(level, format, &log_format::render<std::decay_t<Args>...>,
+                  packed, static_cast<size_t>(end - packed));
+    }
+
+    template <typename... Args>
+    void debugf(const char* format, const Args&... args) { logFormat(LogLevel::DEBUG, format, args...); }
+    template <typename... Args>
+    void infof(const char* format, const Args&... args) { logFormat(LogLevel::INFO, format, args...); }
+    template <typename... Args>
+    void warnf(const char* format, const Args&... args) { logFormat(LogLevel::WARN, format, args...); }
+    template <typename... Args>
+    void errorf(const char* format, const Args&... args) { logFormat(LogLevel::ERROR, format, args...); }
 
     /// Enable or disable console output (default: enabled)
     void setConsoleOutput(bool enabled);
@@ -88,20 +252,99 @@ public:
     /// Check whether a log file is currently open
     bool isFileOpen() const;
 
+    /// Check whether the JSON-lines sink is open
+    bool isJsonOpen() const;
+
+    /**
+     * @brief Rotate log files once they would exceed @p max_bytes
+     *
+     * server.log becomes server.log.1, .1 becomes .2 and so on; files
+     * beyond @p max_files are deleted.  A max_bytes of 0 disables rotation.
+     */
+    void setRotation(uint64_t max_bytes, int max_files);
+
+    /// Start the background writer; subsequent calls return immediately
+    bool startAsync(const AsyncOptions& options);
+    bool startAsync();
+
+    /// Stop the writer, drain every ring and return to synchronous logging
+    void stopAsync();
+
+    bool isAsync() const { return async_.load(std::memory_order_acquire); }
+
+    /// Block until every message logged so far has been written
+    void flush();
+
+    /// Messages discarded by a full ring (Drop, or Block past its timeout) since startup
+    uint64_t getDroppedCount() const { return dropped_total_.load(std::memory_order_relaxed); }
+
 private:
     Logger();
     ~Logger();
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
-    static std::string levelToString(LogLevel level);
-    static std::string timestamp();
+    using RenderFn = void (*)(std::string& out, const char* format, const char* args);
+
+    struct Ring;
+    struct Slot;
+    struct Entry {
+        int64_t time_us = 0;
+        LogLevel level = LogLevel::INFO;
+        uint32_t thread = 0;
+        std::string message;
+    };
+
+    static const char* levelToString(LogLevel level);
+
+    void logPacked(LogLevel level, const char* format, RenderFn render,
+                   const char* args, size_t size);
+    template <typename Fill>
+    void submit(LogLevel level, Fill&& fill);
+    Ring* threadRing();
+    void writerLoop();
+    void drain();
+    void writeBatch(std::vector<Entry>& batch);
+    const char* formatTime(int64_t time_us);
+    void writeFile(std::ofstream& file, const std::string& path,
+                   uint64_t& bytes, const std::string& data);
 
     std::ofstream log_file_;
-    LogLevel min_level_ = LogLevel::INFO;
-    bool console_output_ = true;
-    bool file_output_ = true;
-    mutable std::mutex mutex_;
+    std::ofstream json_file_;
+    std::string log_file_path_;
+    std::string json_file_path_;
+    uint64_t log_file_bytes_ = 0;
+    uint64_t json_file_bytes_ = 0;
+    uint64_t rotate_bytes_ = 0;
+    int rotate_files_ = 5;
+
+    std::atomic<LogLevel> min_level_{LogLevel::INFO};
+    std::atomic<bool> console_output_{true};
+    std::atomic<bool> file_output_{true};
+    mutable std::mutex mutex_;           // sinks and formatting state
+
+    // Per-millisecond timestamp cache (guarded by mutex_)
+    int64_t cached_second_ = -1;
+    int64_t cached_ms_ = -1;
+    char cached_time_[32] = {0};
+
+    // Async backend
+    std::atomic<bool> async_{false};
+    AsyncOptions async_options_;
+    std::atomic<uint64_t> ring_generation_{0};
+    std::mutex rings_mutex_;             // registration of producer rings
+    std::vector<std::shared_ptr<Ring>> rings_;
+    uint32_t next_thread_index_ = 0;
+    std::mutex drain_mutex_;             // single consumer at a time
+    std::thread writer_;
+    std::mutex writer_mutex_;
+    std::condition_variable writer_cv_;
+    bool writer_stop_ = false;
+    bool writer_wake_ = false;           // a Block producer is waiting for space
+    std::mutex space_mutex_;             // Block producers waiting for the writer
+    std::condition_variable space_cv_;
+    std::atomic<uint64_t> dropped_total_{0};
+    uint64_t dropped_reported_ = 0;
 };
 
 } // namespace utils
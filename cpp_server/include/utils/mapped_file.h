@@ -0,0 +1,44 @@
+#ifndef EVE_UTILS_MAPPED_FILE_H
+#define EVE_UTILS_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace atlas {
+namespace utils {
+
+/**
+ * @brief Read-only view of a whole file, memory-mapped where the platform allows
+ *
+ * On POSIX the file is mapped privately and pages are faulted in on first
+ * touch; elsewhere it is read into an owned buffer.  Either way data()
+ * stays valid until close() or destruction.  Empty files fail to open.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool isOpen() const { return data_ != nullptr; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    std::vector<char> buffer_;
+#endif
+};
+
+} // namespace utils
+} // namespace atlas
+
+#endif // EVE_UTILS_MAPPED_FILE_H
@@ -5,6 +5,9 @@
 #include <chrono>
 #include <mutex>
 #include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
 
 namespace atlas {
 namespace utils {
@@ -47,15 +50,48 @@ public:
     /// Human-readable uptime string (e.g. "1d 3h 22m 15s")
     std::string getUptimeString() const;
 
+    // --- Time dilation ---
+    struct DilationSample {
+        double uptime_seconds;
+        float factor;
+    };
+    static constexpr size_t MAX_DILATION_SAMPLES = 600;
+
+    /**
+     * @brief Record a solar system's current time dilation factor
+     *
+     * A sample is kept when the factor moves by at least 0.01, or once
+     * per second while the system stays dilated.  Each system keeps the
+     * newest MAX_DILATION_SAMPLES samples.
+     */
+    void recordDilation(const std::string& system_id, float factor);
+
+    std::vector<DilationSample> getDilationHistory(const std::string& system_id) const;
+
+    /// Lowest factor recorded in the current window (1.0 = no dilation)
+    float getMinDilation() const;
+    /// System that reached getMinDilation() ("" if none dilated)
+    std::string getMostDilatedSystem() const;
+
     // --- Reporting ---
     /**
      * @brief Build a one-line status summary
      *
      * Example:
      *   "[Metrics] tick avg=2.13ms min=1.80ms max=4.21ms | entities=42 players=3 | uptime 0d 1h 5m 30s | ticks=113400"
+     *
+     * A " | tidi min=0.35 (system_id)" suffix is added when any system
+     * was dilated during the window.
      */
     std::string summary() const;
 
+    /**
+     * @brief Server-level series in Prometheus text exposition format
+     *
+     * Tick timing covers the current window; ticks_total only grows.
+     */
+    std::string prometheusText() const;
+
     /**
      * @brief Log the summary via the Logger singleton
      *
@@ -82,6 +118,10 @@ private:
     int entity_count_ = 0;
     int player_count_ = 0;
 
+    std::map<std::string, std::deque<DilationSample>> dilation_history_;
+    float dilation_min_ = 1.0f;
+    std::string dilation_min_system_;
+
     mutable std::mutex mutex_;
 };
 
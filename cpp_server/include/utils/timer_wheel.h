@@ -0,0 +1,92 @@
+#ifndef EVE_UTILS_TIMER_WHEEL_H
+#define EVE_UTILS_TIMER_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+namespace utils {
+
+/**
+ * @brief Hierarchical timer wheel of keyed one-shot deadlines
+ *
+ * Deadlines are absolute times in seconds on the owner's clock, bucketed
+ * into ticks of @c resolution seconds across four 256-slot levels
+ * (256^4 ticks; later deadlines wait in an overflow list).  Scheduling
+ * is O(1); advancing visits only the slots that can hold something due,
+ * skipping straight over empty stretches, so thousands of timers that
+ * fire hours from now cost nothing per tick.
+ *
+ * Each key has at most one live deadline: scheduling a key again
+ * replaces its previous deadline, and superseded entries are discarded
+ * lazily when their slot comes round.
+ *
+ * Not thread-safe; owned by one system on the simulation thread.
+ */
+class TimerWheel {
+public:
+    struct Timer {
+        std::string key;
+        double deadline = 0.0;
+    };
+
+    explicit TimerWheel(double resolution = 1.0);
+
+    /// Arm (or re-arm) @p key to fire once @p deadline is reached
+    void schedule(const std::string& key, double deadline);
+
+    /// Disarm @p key; returns false if it was not scheduled
+    bool cancel(const std::string& key);
+
+    bool isScheduled(const std::string& key) const;
+
+    /**
+     * @brief Move the clock to @p now and collect every due timer
+     *
+     * Timers are appended to @p expired in deadline-tick order and are
+     * disarmed before they are returned.  The clock never runs backwards.
+     */
+    void advance(double now, std::vector<Timer>& expired);
+
+    double now() const { return now_; }
+    double resolution() const { return resolution_; }
+
+    /// Live (armed) timers
+    size_t size() const { return armed_.size(); }
+
+    /// Wheel slots examined by advance() since construction
+    uint64_t slotsVisited() const { return slots_visited_; }
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 8;
+    static constexpr uint64_t SLOTS = 1u << SLOT_BITS;
+
+    struct Entry {
+        std::string key;
+        double deadline;
+        uint64_t tick;
+    };
+
+    uint64_t tickOf(double time) const;
+    void insert(Entry entry);
+    void cascade();
+
+    double resolution_;
+    double now_ = 0.0;
+    uint64_t current_ = 0;             // tick the wheel has been advanced to
+    std::vector<Entry> slots_[LEVELS][SLOTS];
+    size_t level_count_[LEVELS] = {};
+    std::vector<Entry> overflow_;      // beyond the top level's horizon
+    std::vector<Entry> due_;           // tick reached, deadline maybe not yet
+    std::unordered_map<std::string, double> armed_;
+    uint64_t slots_visited_ = 0;
+};
+
+} // namespace utils
+} // namespace atlas
+
+#endif // EVE_UTILS_TIMER_WHEEL_H
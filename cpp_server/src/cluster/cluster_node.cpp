@@ -0,0 +1,289 @@
+#include "cluster/cluster_node.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <sstream>
+
+namespace atlas {
+namespace cluster {
+
+namespace {
+
+constexpr const char* ENTITY_KEY = "\"entity\":";
+
+// Read "key":"value" from the message header (the part before the entity body)
+std::string extractField(const std::string& json, const std::string& key) {
+    std::string needle = "\"" + key + "\":\"";
+    size_t pos = json.find(needle);
+    if (pos == std::string::npos) return "";
+    pos += needle.size();
+    size_t end = json.find('"', pos);
+    if (end == std::string::npos) return "";
+    return json.substr(pos, end - pos);
+}
+
+std::string messageHeader(const std::string& line) {
+    size_t body = line.find(ENTITY_KEY);
+    return body == std::string::npos ? line : line.substr(0, body);
+}
+
+} // anonymous namespace
+
+ClusterNode::ClusterNode(const std::string& node_id, const ClusterTopology& topology,
+                         ecs::World* world)
+    : node_id_(node_id)
+    , topology_(topology)
+    , world_(world) {
+}
+
+ClusterNode::~ClusterNode() {
+    stop();
+}
+
+bool ClusterNode::start(const std::string& listen_endpoint) {
+    std::string endpoint = listen_endpoint;
+    if (endpoint.empty()) {
+        const NodeInfo* self = topology_.getNode(node_id_);
+        if (!self) return false;
+        endpoint = self->node_endpoint;
+    }
+
+    bool ok = listener_.listen(endpoint, [this](std::shared_ptr<NodeLink> link) {
+        attach(link);
+    });
+    auto& log = utils::Logger::instance();
+    if (ok) {
+        log.info("[Cluster] Node " + node_id_ + " accepting peers on " + endpoint);
+    } else {
+        log.error("[Cluster] Node " + node_id_ + " failed to listen on " + endpoint);
+    }
+    return ok;
+}
+
+void ClusterNode::stop() {
+    listener_.stop();
+
+    std::vector<std::shared_ptr<NodeLink>> links;
+    {
+        std::lock_guard<std::mutex> lock(links_mutex_);
+        links.swap(links_);
+        outbound_.clear();
+    }
+    for (auto& link : links) link->close();
+
+    // Reader threads call back into this node; wait until they are done
+    for (auto& link : links) link->waitUntilDone();
+
+    std::lock_guard<std::mutex> lock(inbox_mutex_);
+    inbox_.clear();
+}
+
+bool ClusterNode::ownsSystem(const std::string& system_id) const {
+    return topology_.ownerOf(system_id) == node_id_;
+}
+
+void ClusterNode::setPeerEndpoint(const std::string& node_id, const std::string& endpoint) {
+    std::lock_guard<std::mutex> lock(links_mutex_);
+    peer_endpoints_[node_id] = endpoint;
+}
+
+// ---------------------------------------------------------------------------
+// Links
+// ---------------------------------------------------------------------------
+
+void ClusterNode::attach(const std::shared_ptr<NodeLink>& link) {
+    {
+        std::lock_guard<std::mutex> lock(links_mutex_);
+        links_.push_back(link);
+    }
+    link->start(
+        [this](const std::shared_ptr<NodeLink>& from, const std::string& line) {
+            std::lock_guard<std::mutex> lock(inbox_mutex_);
+            inbox_.push_back({from, line});
+        },
+        [this](const std::shared_ptr<NodeLink>& closed) {
+            std::string peer;
+            {
+                std::lock_guard<std::mutex> lock(links_mutex_);
+                links_.erase(std::remove(links_.begin(), links_.end(), closed), links_.end());
+                for (auto it = outbound_.begin(); it != outbound_.end(); ++it) {
+                    if (it->second == closed) {
+                        peer = it->first;
+                        outbound_.erase(it);
+                        break;
+                    }
+                }
+            }
+            if (peer.empty()) return;
+            // Anything still in flight to that peer will never be acked
+            std::lock_guard<std::mutex> lock(inbox_mutex_);
+            inbox_.push_back({nullptr, "{\"type\":\"link_closed\",\"node_id\":\"" + peer + "\"}"});
+        });
+}
+
+std::shared_ptr<NodeLink> ClusterNode::linkTo(const std::string& node_id) {
+    std::string endpoint;
+    {
+        std::lock_guard<std::mutex> lock(links_mutex_);
+        auto it = outbound_.find(node_id);
+        if (it != outbound_.end() && it->second->isOpen()) return it->second;
+
+        auto override_it = peer_endpoints_.find(node_id);
+        if (override_it != peer_endpoints_.end()) {
+            endpoint = override_it->second;
+        } else if (const NodeInfo* info = topology_.getNode(node_id)) {
+            endpoint = info->node_endpoint;
+        }
+    }
+    if (endpoint.empty()) return nullptr;
+
+    auto link = NodeLink::connect(endpoint);
+    if (!link) {
+        utils::Logger::instance().warn("[Cluster] Cannot reach node " + node_id +
+                                       " at " + endpoint);
+        return nullptr;
+    }
+    attach(link);
+
+    std::lock_guard<std::mutex> lock(links_mutex_);
+    outbound_[node_id] = link;
+    return link;
+}
+
+// ---------------------------------------------------------------------------
+// Migration
+// ---------------------------------------------------------------------------
+
+bool ClusterNode::migrateEntity(const std::string& entity_id, const std::string& to_system,
+                                const std::string& resume_token) {
+    std::string to_node = topology_.ownerOf(to_system);
+    if (to_node.empty() || to_node == node_id_) return false;
+    if (in_flight_.count(entity_id)) return false;
+
+    ecs::Entity* entity = world_->getEntity(entity_id);
+    if (!entity) return false;
+
+    auto link = linkTo(to_node);
+    if (!link) {
+        ++failed_migrations_;
+        return false;
+    }
+
+    std::string body = persistence_.serializeEntity(entity);
+    std::replace(body.begin(), body.end(), '\n', ' ');
+
+    std::ostringstream msg;
+    msg << "{\"type\":\"entity_migrate\","
+        << "\"from_node\":\"" << node_id_ << "\","
+        << "\"to_system\":\"" << to_system << "\","
+        << "\"entity_id\":\"" << entity_id << "\",";
+    if (!resume_token.empty()) {
+        msg << "\"resume_token\":\"" << resume_token << "\",";
+    }
+    msg << ENTITY_KEY << body << "}";
+
+    if (!link->sendLine(msg.str())) {
+        ++failed_migrations_;
+        return false;
+    }
+
+    // Stop simulating it here; the ack decides whether it comes back.
+    // Any session resume it was adopted with is void once it leaves.
+    resume_tokens_.erase(entity_id);
+    InFlight flight;
+    flight.entity = world_->releaseEntity(entity_id);
+    flight.to_node = to_node;
+    in_flight_[entity_id] = std::move(flight);
+    return true;
+}
+
+void ClusterNode::update() {
+    std::vector<Incoming> messages;
+    {
+        std::lock_guard<std::mutex> lock(inbox_mutex_);
+        messages.swap(inbox_);
+    }
+
+    for (auto& msg : messages) {
+        std::string type = extractField(messageHeader(msg.line), "type");
+        if (type == "entity_migrate") {
+            handleMigrate(msg.link, msg.line);
+        } else if (type == "migrate_ack") {
+            handleAck(msg.line);
+        } else if (type == "link_closed") {
+            std::string peer = extractField(msg.line, "node_id");
+            std::vector<std::string> stranded;
+            for (const auto& kv : in_flight_) {
+                if (kv.second.to_node == peer) stranded.push_back(kv.first);
+            }
+            for (const auto& id : stranded) finishMigration(id, false);
+        } else {
+            utils::Logger::instance().warn("[Cluster] Unknown node message: " + type);
+        }
+    }
+}
+
+void ClusterNode::handleMigrate(const std::shared_ptr<NodeLink>& link,
+                                const std::string& line) {
+    std::string header = messageHeader(line);
+    std::string entity_id = extractField(header, "entity_id");
+    std::string from_node = extractField(header, "from_node");
+    std::string to_system = extractField(header, "to_system");
+
+    bool ok = false;
+    size_t body = line.find(ENTITY_KEY);
+    if (!entity_id.empty() && ownsSystem(to_system) && body != std::string::npos &&
+        !world_->getEntity(entity_id)) {
+        size_t start = body + std::string(ENTITY_KEY).size();
+        size_t end = line.rfind('}');  // closes the outer message
+        if (end != std::string::npos && end > start) {
+            ok = persistence_.deserializeEntity(world_, line.substr(start, end - start));
+        }
+    }
+
+    link->sendLine("{\"type\":\"migrate_ack\",\"entity_id\":\"" + entity_id +
+                   "\",\"ok\":" + (ok ? "true" : "false") + "}");
+
+    if (!ok) {
+        utils::Logger::instance().warn("[Cluster] Rejected migration of " + entity_id +
+                                       " from " + from_node);
+        return;
+    }
+    ++migrated_in_;
+    std::string token = extractField(header, "resume_token");
+    if (!token.empty()) resume_tokens_[entity_id] = token;
+    utils::Logger::instance().info("[Cluster] Adopted " + entity_id + " from " +
+                                   from_node + " into " + to_system);
+    if (on_arrival_) on_arrival_(entity_id, from_node);
+}
+
+bool ClusterNode::claimResume(const std::string& entity_id, const std::string& token) {
+    auto it = resume_tokens_.find(entity_id);
+    if (it == resume_tokens_.end() || token.empty() || it->second != token) return false;
+    resume_tokens_.erase(it);
+    return world_->getEntity(entity_id) != nullptr;
+}
+
+void ClusterNode::handleAck(const std::string& line) {
+    std::string entity_id = extractField(line, "entity_id");
+    bool ok = line.find("\"ok\":true") != std::string::npos;
+    finishMigration(entity_id, ok);
+}
+
+void ClusterNode::finishMigration(const std::string& entity_id, bool ok) {
+    auto it = in_flight_.find(entity_id);
+    if (it == in_flight_.end()) return;
+
+    std::string to_node = it->second.to_node;
+    if (ok) {
+        ++migrated_out_;
+    } else {
+        ++failed_migrations_;
+        world_->adoptEntity(std::move(it->second.entity));
+    }
+    in_flight_.erase(it);
+
+    if (on_migrated_) on_migrated_(entity_id, to_node, ok);
+}
+
+} // namespace cluster
+} // namespace atlas
@@ -0,0 +1,327 @@
+#include "cluster/cluster_proxy.h"
+#include "utils/logger.h"
+#include <sstream>
+
+namespace atlas {
+namespace cluster {
+
+namespace {
+
+constexpr const char* REDIRECT_MARKER = "\"message_type\":\"session_redirect\"";
+
+// Value of "key":"..." still in its escaped JSON form, so it can be
+// written back into a message verbatim; a \" inside does not end it
+std::string extractString(const std::string& json, const std::string& key) {
+    std::string needle = "\"" + key + "\":\"";
+    size_t pos = json.find(needle);
+    if (pos == std::string::npos) return "";
+    pos += needle.size();
+    for (size_t end = pos; end < json.size(); ++end) {
+        if (json[end] == '\\') ++end;
+        else if (json[end] == '"') return json.substr(pos, end - pos);
+    }
+    return "";
+}
+
+bool isConnectMessage(const std::string& raw) {
+    return raw.find("\"type\":\"connect\"") != std::string::npos ||
+           raw.find("\"message_type\":\"connect\"") != std::string::npos;
+}
+
+} // anonymous namespace
+
+ClusterProxy::ClusterProxy(const ClusterTopology& topology, const std::string& host,
+                           uint16_t port, int max_connections)
+    : topology_(topology)
+    , server_(host, port, max_connections) {
+}
+
+ClusterProxy::~ClusterProxy() {
+    stop();
+}
+
+bool ClusterProxy::start() {
+    if (topology_.empty()) {
+        utils::Logger::instance().error("[Proxy] Cluster topology has no nodes");
+        return false;
+    }
+    if (!server_.initialize()) {
+        utils::Logger::instance().error("[Proxy] Failed to initialize client listener");
+        return false;
+    }
+    server_.setMessageHandler(
+        [this](const network::ClientConnection& client, const std::string& raw) {
+            onClientMessage(client, raw);
+        });
+    server_.setDisconnectHandler(
+        [this](const network::ClientConnection& client) {
+            onClientDisconnect(client);
+        });
+    server_.start();
+
+    utils::Logger::instance().info("[Proxy] Routing clients on port " +
+                                   std::to_string(server_.getPort()) + " to " +
+                                   std::to_string(topology_.getNodes().size()) + " nodes");
+    return true;
+}
+
+void ClusterProxy::stop() {
+    server_.stop();
+
+    std::vector<std::shared_ptr<NodeLink>> upstreams;
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        for (auto& kv : sessions_) {
+            if (kv.second.upstream) upstreams.push_back(kv.second.upstream);
+        }
+        sessions_.clear();
+    }
+    for (auto& link : upstreams) link->close();
+    // Upstream readers call back into the proxy; wait for them to finish
+    for (auto& link : upstreams) link->waitUntilDone();
+}
+
+void ClusterProxy::setNodeAddress(const std::string& node_id, const std::string& endpoint) {
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    node_addresses_[node_id] = endpoint;
+}
+
+size_t ClusterProxy::getSessionCount() const {
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    return sessions_.size();
+}
+
+std::string ClusterProxy::getSessionNode(int client_socket) const {
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    auto it = sessions_.find(client_socket);
+    return it != sessions_.end() ? it->second.node_id : std::string();
+}
+
+std::string ClusterProxy::nodeEndpoint(const std::string& node_id) const {
+    auto it = node_addresses_.find(node_id);
+    if (it != node_addresses_.end()) return it->second;
+    const NodeInfo* info = topology_.getNode(node_id);
+    if (!info) return "";
+    return info->client_host + ":" + std::to_string(info->client_port);
+}
+
+std::shared_ptr<NodeLink> ClusterProxy::connectUpstream(const std::string& node_id,
+                                                        const std::string& endpoint) {
+    auto link = endpoint.empty() ? nullptr : NodeLink::connect(endpoint);
+    if (!link) {
+        utils::Logger::instance().warn("[Proxy] Cannot reach node " + node_id +
+                                       " at " + endpoint);
+    }
+    return link;
+}
+
+void ClusterProxy::startRelay(int client_socket, const std::shared_ptr<NodeLink>& link) {
+    link->start(
+        [this, client_socket](const std::shared_ptr<NodeLink>& from, const std::string& data) {
+            onUpstreamData(client_socket, from, data);
+        },
+        [this, client_socket](const std::shared_ptr<NodeLink>& closed) {
+            onUpstreamClosed(client_socket, closed);
+        },
+        /*raw=*/true);
+}
+
+// ---------------------------------------------------------------------------
+// Client → node
+// ---------------------------------------------------------------------------
+
+void ClusterProxy::onClientMessage(const network::ClientConnection& client,
+                                   const std::string& raw) {
+    const int key = static_cast<int>(client.socket);
+    std::shared_ptr<NodeLink> upstream;
+    std::string node_id;
+    std::string endpoint;
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        auto it = sessions_.find(key);
+        if (it != sessions_.end()) {
+            upstream = it->second.upstream;
+        } else {
+            if (!isConnectMessage(raw)) return;
+
+            std::string entry = extractString(raw, "entry_system");
+            node_id = entry.empty() ? "" : topology_.ownerOf(entry);
+            if (node_id.empty()) node_id = topology_.getNodes().front().node_id;
+            endpoint = nodeEndpoint(node_id);
+        }
+    }
+
+    if (!upstream) {
+        // New session: connect without blocking other sessions' traffic
+        auto link = connectUpstream(node_id, endpoint);
+        if (!link) return;
+
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        if (sessions_.count(key)) {
+            link->close();      // a second connect raced this one
+            return;
+        }
+        Session session;
+        session.client = client;
+        session.node_id = node_id;
+        session.player_id = extractString(raw, "player_id");
+        session.character_name = extractString(raw, "character_name");
+        session.upstream = link;
+        sessions_[key] = std::move(session);
+        startRelay(key, link);
+        upstream = link;
+    }
+    upstream->sendRaw(raw);
+}
+
+void ClusterProxy::onClientDisconnect(const network::ClientConnection& client) {
+    std::shared_ptr<NodeLink> upstream;
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        auto it = sessions_.find(static_cast<int>(client.socket));
+        if (it == sessions_.end()) return;
+        upstream = it->second.upstream;
+        sessions_.erase(it);
+    }
+    if (upstream) upstream->close();
+}
+
+// ---------------------------------------------------------------------------
+// Node → client
+// ---------------------------------------------------------------------------
+
+void ClusterProxy::onUpstreamData(int client_socket, const std::shared_ptr<NodeLink>& from,
+                                  const std::string& data) {
+    network::ClientConnection client;
+    std::string complete;
+    std::string redirect_message;
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        auto it = sessions_.find(client_socket);
+        if (it == sessions_.end() || it->second.upstream != from) return;
+        Session& session = it->second;
+
+        std::vector<std::string> messages;
+        complete = session.framer.feed(data, messages);
+        if (complete.empty()) return;
+        client = session.client;
+        for (const auto& message : messages) {
+            if (message.find(REDIRECT_MARKER) != std::string::npos) {
+                redirect_message = message;
+            }
+        }
+    }
+    // Sent unlocked so a slow client holds up only its own relay; each
+    // upstream has one reader thread, so the session's order is kept
+    server_.sendToClient(client, complete);
+    if (!redirect_message.empty()) redirect(client_socket, from, redirect_message);
+}
+
+void ClusterProxy::redirect(int client_socket, const std::shared_ptr<NodeLink>& from,
+                            const std::string& message) {
+    std::string entity_id = extractString(message, "entity_id");
+    std::string node_id = extractString(message, "node_id");
+    std::string token = extractString(message, "resume_token");
+    std::string endpoint;
+    std::ostringstream resume;
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        auto it = sessions_.find(client_socket);
+        if (it == sessions_.end() || it->second.upstream != from) return;
+        const Session& session = it->second;
+        if (entity_id.empty() || node_id.empty() || node_id == session.node_id) return;
+
+        endpoint = nodeEndpoint(node_id);
+        // Every value is still escaped as it arrived, so it is copied as is
+        resume << "{\"type\":\"connect\",\"data\":{"
+               << "\"player_id\":\"" << session.player_id << "\","
+               << "\"character_name\":\"" << session.character_name << "\","
+               << "\"resume_entity\":\"" << entity_id << "\","
+               << "\"resume_token\":\"" << token << "\"}}";
+    }
+
+    auto next = connectUpstream(node_id, endpoint);
+    if (!next) return;  // stay on the old node; it will report the failure
+
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        auto it = sessions_.find(client_socket);
+        if (it == sessions_.end() || it->second.upstream != from) {
+            next->close();  // the client left while we were connecting
+            return;
+        }
+        Session& session = it->second;
+        session.upstream = next;
+        session.node_id = node_id;
+        session.framer.reset();
+        startRelay(client_socket, next);
+        next->sendRaw(resume.str());
+        ++redirect_count_;
+    }
+
+    from->close();
+    utils::Logger::instance().info("[Proxy] Session " + entity_id + " moved to node " + node_id);
+}
+
+void ClusterProxy::onUpstreamClosed(int client_socket, const std::shared_ptr<NodeLink>& closed) {
+    network::ClientConnection client;
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        auto it = sessions_.find(client_socket);
+        // Upstreams replaced by a redirect close quietly
+        if (it == sessions_.end() || it->second.upstream != closed) return;
+        client = it->second.client;
+        sessions_.erase(it);
+    }
+    utils::Logger::instance().warn("[Proxy] Node closed session for " + client.address);
+    server_.disconnectClient(client);
+}
+
+// ---------------------------------------------------------------------------
+// Message framing
+// ---------------------------------------------------------------------------
+
+std::string ClusterProxy::MessageFramer::feed(const std::string& data,
+                                              std::vector<std::string>& messages) {
+    buffer_ += data;
+
+    size_t start = 0;
+    for (size_t i = scan_; i < buffer_.size(); ++i) {
+        char c = buffer_[i];
+        if (in_string_) {
+            if (escape_) escape_ = false;
+            else if (c == '\\') escape_ = true;
+            else if (c == '"') in_string_ = false;
+            continue;
+        }
+        if (c == '"') {
+            in_string_ = true;
+        } else if (c == '{') {
+            if (depth_ == 0) start = i;
+            ++depth_;
+        } else if (c == '}' && depth_ > 0) {
+            if (--depth_ == 0) {
+                messages.emplace_back(buffer_, start, i + 1 - start);
+                start = i + 1;
+            }
+        } else if (depth_ == 0) {
+            start = i + 1;      // newlines or whitespace between messages
+        }
+    }
+
+    std::string complete = buffer_.substr(0, start);
+    buffer_.erase(0, start);
+    scan_ = buffer_.size();
+    return complete;
+}
+
+void ClusterProxy::MessageFramer::reset() {
+    buffer_.clear();
+    scan_ = 0;
+    depth_ = 0;
+    in_string_ = false;
+    escape_ = false;
+}
+
+} // namespace cluster
+} // namespace atlas
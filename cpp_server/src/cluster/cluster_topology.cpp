@@ -0,0 +1,86 @@
+#include "cluster/cluster_topology.h"
+#include <cstdlib>
+#include <sstream>
+
+namespace atlas {
+namespace cluster {
+
+namespace {
+
+std::vector<std::string> split(const std::string& s, char delim) {
+    std::vector<std::string> parts;
+    std::string part;
+    std::istringstream stream(s);
+    while (std::getline(stream, part, delim)) {
+        size_t first = part.find_first_not_of(" \t");
+        if (first == std::string::npos) continue;
+        size_t last = part.find_last_not_of(" \t");
+        parts.push_back(part.substr(first, last - first + 1));
+    }
+    return parts;
+}
+
+} // anonymous namespace
+
+bool ClusterTopology::parse(const std::string& spec) {
+    std::vector<NodeInfo> nodes;
+    std::map<std::string, std::string> owners;
+
+    for (const auto& entry : split(spec, ';')) {
+        auto fields = split(entry, '|');
+        if (fields.size() != 4) return false;
+
+        NodeInfo node;
+        node.node_id = fields[0];
+
+        size_t colon = fields[1].rfind(':');
+        if (colon == std::string::npos) return false;
+        node.client_host = fields[1].substr(0, colon);
+        int port = std::atoi(fields[1].c_str() + colon + 1);
+        if (port <= 0 || port > 65535) return false;
+        node.client_port = static_cast<uint16_t>(port);
+
+        node.node_endpoint = fields[2];
+        node.systems = split(fields[3], ',');
+
+        for (const auto& sys : node.systems) {
+            // A system may only be owned by one node
+            if (!owners.emplace(sys, node.node_id).second) return false;
+        }
+        nodes.push_back(std::move(node));
+    }
+
+    nodes_ = std::move(nodes);
+    system_owner_ = std::move(owners);
+    return true;
+}
+
+std::string ClusterTopology::ownerOf(const std::string& system_id) const {
+    auto it = system_owner_.find(system_id);
+    return it != system_owner_.end() ? it->second : std::string();
+}
+
+const NodeInfo* ClusterTopology::getNode(const std::string& node_id) const {
+    for (const auto& node : nodes_) {
+        if (node.node_id == node_id) return &node;
+    }
+    return nullptr;
+}
+
+std::string ClusterTopology::toString() const {
+    std::ostringstream out;
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        const auto& n = nodes_[i];
+        if (i > 0) out << ";";
+        out << n.node_id << "|" << n.client_host << ":" << n.client_port
+            << "|" << n.node_endpoint << "|";
+        for (size_t s = 0; s < n.systems.size(); ++s) {
+            if (s > 0) out << ",";
+            out << n.systems[s];
+        }
+    }
+    return out.str();
+}
+
+} // namespace cluster
+} // namespace atlas
@@ -0,0 +1,313 @@
+#include "cluster/node_link.h"
+#include "utils/logger.h"
+#include <cstdlib>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/un.h>
+#endif
+
+namespace atlas {
+namespace cluster {
+
+namespace {
+
+constexpr const char* UNIX_PREFIX = "unix:";
+
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+void closeSocketHandle(socket_t socket) {
+    if (socket == INVALID_SOCKET) return;
+#ifdef _WIN32
+    closesocket(socket);
+#else
+    ::close(socket);
+#endif
+}
+
+void shutdownSocket(socket_t socket) {
+    if (socket == INVALID_SOCKET) return;
+#ifdef _WIN32
+    shutdown(socket, SD_BOTH);
+#else
+    shutdown(socket, SHUT_RDWR);
+#endif
+}
+
+bool isUnixEndpoint(const std::string& endpoint) {
+    return endpoint.compare(0, std::strlen(UNIX_PREFIX), UNIX_PREFIX) == 0;
+}
+
+bool fillInetAddress(const std::string& host, uint16_t port, sockaddr_in& addr) {
+    addr = sockaddr_in{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (host.empty() || host == "0.0.0.0") {
+        addr.sin_addr.s_addr = INADDR_ANY;
+        return true;
+    }
+    std::string numeric = (host == "localhost") ? "127.0.0.1" : host;
+    return inet_pton(AF_INET, numeric.c_str(), &addr.sin_addr) == 1;
+}
+
+} // anonymous namespace
+
+bool parseHostPort(const std::string& endpoint, std::string& host, uint16_t& port) {
+    if (isUnixEndpoint(endpoint)) return false;
+    size_t colon = endpoint.rfind(':');
+    if (colon == std::string::npos) return false;
+    int value = std::atoi(endpoint.c_str() + colon + 1);
+    if (value < 0 || value > 65535) return false;
+    host = endpoint.substr(0, colon);
+    port = static_cast<uint16_t>(value);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// NodeLink
+// ---------------------------------------------------------------------------
+
+NodeLink::NodeLink(socket_t socket)
+    : socket_(socket)
+    , open_(socket != INVALID_SOCKET) {
+}
+
+NodeLink::~NodeLink() {
+    close();
+    if (reader_.joinable()) {
+        // The last reference may be dropped by the reader's own handler
+        if (reader_.get_id() == std::this_thread::get_id()) {
+            reader_.detach();
+        } else {
+            reader_.join();
+        }
+    }
+    closeSocketHandle(socket_);
+}
+
+std::shared_ptr<NodeLink> NodeLink::connect(const std::string& endpoint) {
+    socket_t fd = INVALID_SOCKET;
+
+    if (isUnixEndpoint(endpoint)) {
+#ifdef _WIN32
+        return nullptr;
+#else
+        std::string path = endpoint.substr(std::strlen(UNIX_PREFIX));
+        sockaddr_un addr{};
+        if (path.size() >= sizeof(addr.sun_path)) return nullptr;
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd == INVALID_SOCKET) return nullptr;
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR) {
+            closeSocketHandle(fd);
+            return nullptr;
+        }
+#endif
+    } else {
+        std::string host;
+        uint16_t port = 0;
+        sockaddr_in addr{};
+        if (!parseHostPort(endpoint, host, port) || port == 0 ||
+            !fillInetAddress(host.empty() ? "127.0.0.1" : host, port, addr)) {
+            return nullptr;
+        }
+        fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (fd == INVALID_SOCKET) return nullptr;
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR) {
+            closeSocketHandle(fd);
+            return nullptr;
+        }
+    }
+
+    return std::make_shared<NodeLink>(fd);
+}
+
+void NodeLink::start(LineHandler on_line, CloseHandler on_close, bool raw) {
+    on_line_ = std::move(on_line);
+    on_close_ = std::move(on_close);
+    raw_ = raw;
+    reading_ = true;
+    reader_ = std::thread(&NodeLink::readLoop, this);
+}
+
+void NodeLink::waitUntilDone() {
+    if (reader_.get_id() == std::this_thread::get_id()) return;
+    std::unique_lock<std::mutex> lock(reading_mutex_);
+    reading_done_.wait(lock, [this] { return !reading_; });
+}
+
+bool NodeLink::sendLine(const std::string& line) {
+    return sendRaw(line + "\n");
+}
+
+bool NodeLink::sendRaw(const std::string& data) {
+    if (!open_) return false;
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    size_t sent = 0;
+    while (sent < data.size()) {
+        int n = send(socket_, data.data() + sent,
+                     static_cast<int>(data.size() - sent), SEND_FLAGS);
+        if (n <= 0) {
+            open_ = false;
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+void NodeLink::close() {
+    if (open_.exchange(false)) {
+        shutdownSocket(socket_);
+    }
+}
+
+void NodeLink::readLoop() {
+    // The reader keeps its link alive until the connection closes
+    std::shared_ptr<NodeLink> self = weak_from_this().lock();
+    char buffer[4096];
+    std::string pending;
+
+    while (self) {
+        int n = recv(socket_, buffer, sizeof(buffer), 0);
+        if (n <= 0) break;
+
+        if (raw_) {
+            if (on_line_) on_line_(self, std::string(buffer, static_cast<size_t>(n)));
+            continue;
+        }
+
+        pending.append(buffer, static_cast<size_t>(n));
+        size_t pos;
+        while ((pos = pending.find('\n')) != std::string::npos) {
+            std::string line = pending.substr(0, pos);
+            pending.erase(0, pos + 1);
+            if (!line.empty() && on_line_) on_line_(self, line);
+        }
+    }
+
+    open_ = false;
+    if (self && on_close_) on_close_(self);
+    {
+        std::lock_guard<std::mutex> lock(reading_mutex_);
+        reading_ = false;
+    }
+    reading_done_.notify_all();
+    // May destroy the link on this thread; nothing below touches members
+    self.reset();
+}
+
+// ---------------------------------------------------------------------------
+// NodeListener
+// ---------------------------------------------------------------------------
+
+NodeListener::NodeListener()
+    : socket_(INVALID_SOCKET)
+    , running_(false) {
+}
+
+NodeListener::~NodeListener() {
+    stop();
+}
+
+bool NodeListener::listen(const std::string& endpoint, AcceptHandler on_accept) {
+    if (running_) return false;
+    on_accept_ = std::move(on_accept);
+
+    if (isUnixEndpoint(endpoint)) {
+#ifdef _WIN32
+        return false;
+#else
+        std::string path = endpoint.substr(std::strlen(UNIX_PREFIX));
+        sockaddr_un addr{};
+        if (path.size() >= sizeof(addr.sun_path)) return false;
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+        socket_ = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (socket_ == INVALID_SOCKET) return false;
+        ::unlink(path.c_str());  // stale socket from a previous run
+        if (bind(socket_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR) {
+            closeSocketHandle(socket_);
+            socket_ = INVALID_SOCKET;
+            return false;
+        }
+        unix_path_ = path;
+#endif
+    } else {
+        std::string host;
+        uint16_t port = 0;
+        sockaddr_in addr{};
+        if (!parseHostPort(endpoint, host, port) || !fillInetAddress(host, port, addr)) {
+            return false;
+        }
+        socket_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (socket_ == INVALID_SOCKET) return false;
+
+        int opt = 1;
+        setsockopt(socket_, SOL_SOCKET, SO_REUSEADDR,
+                   reinterpret_cast<const char*>(&opt), sizeof(opt));
+        if (bind(socket_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR) {
+            closeSocketHandle(socket_);
+            socket_ = INVALID_SOCKET;
+            return false;
+        }
+
+        sockaddr_in bound{};
+        socklen_t len = sizeof(bound);
+        getsockname(socket_, reinterpret_cast<sockaddr*>(&bound), &len);
+        port_ = ntohs(bound.sin_port);
+    }
+
+    if (::listen(socket_, 16) == SOCKET_ERROR) {
+        closeSocketHandle(socket_);
+        socket_ = INVALID_SOCKET;
+        return false;
+    }
+
+    running_ = true;
+    accept_thread_ = std::thread(&NodeListener::acceptLoop, this);
+    return true;
+}
+
+void NodeListener::stop() {
+    if (!running_.exchange(false)) return;
+
+    shutdownSocket(socket_);
+    if (accept_thread_.joinable()) accept_thread_.join();
+    closeSocketHandle(socket_);
+    socket_ = INVALID_SOCKET;
+
+#ifndef _WIN32
+    if (!unix_path_.empty()) {
+        ::unlink(unix_path_.c_str());
+        unix_path_.clear();
+    }
+#endif
+}
+
+void NodeListener::acceptLoop() {
+    while (running_) {
+        socket_t fd = accept(socket_, nullptr, nullptr);
+        if (fd == INVALID_SOCKET) {
+            if (running_) {
+                utils::Logger::instance().warn("[Cluster] Node listener accept failed");
+            }
+            break;
+        }
+        if (on_accept_) {
+            on_accept_(std::make_shared<NodeLink>(fd));
+        } else {
+            closeSocketHandle(fd);
+        }
+    }
+}
+
+} // namespace cluster
+} // namespace atlas
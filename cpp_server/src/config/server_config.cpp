@@ -53,9 +53,27 @@ bool ServerConfig::loadFromFile(const std::string& filepath) {
         else if (key == "steam_server_browser") steam_server_browser = (value == "true");
         else if (key == "tick_rate") tick_rate = std::stof(value);
         else if (key == "max_entities") max_entities = std::stoi(value);
+        else if (key == "partition_by_system") partition_by_system = (value == "true");
+        else if (key == "partition_workers") partition_workers = std::stoi(value);
+        else if (key == "time_dilation") time_dilation = (value == "true");
+        else if (key == "time_dilation_budget_ms") time_dilation_budget_ms = std::stof(value);
+        else if (key == "time_dilation_floor") time_dilation_floor = std::stof(value);
+        else if (key == "background_fast_forward") background_fast_forward = (value == "true");
+        else if (key == "cluster_role") cluster_role = value;
+        else if (key == "cluster_node_id") cluster_node_id = value;
+        else if (key == "cluster_topology") cluster_topology = value;
         else if (key == "data_path") data_path = value;
+        else if (key == "data_bake_path") data_bake_path = value;
         else if (key == "save_path") save_path = value;
         else if (key == "log_path") log_path = value;
+        else if (key == "replay_record_path") replay_record_path = value;
+        else if (key == "log_async") log_async = (value == "true");
+        else if (key == "log_json") log_json = (value == "true");
+        else if (key == "log_max_file_mb") log_max_file_mb = std::stoi(value);
+        else if (key == "log_max_files") log_max_files = std::stoi(value);
+        else if (key == "ping_interval_seconds") ping_interval_seconds = std::stof(value);
+        else if (key == "metrics_export_path") metrics_export_path = value;
+        else if (key == "metrics_export_interval_seconds") metrics_export_interval_seconds = std::stoi(value);
     }
     
     file.close();
@@ -86,9 +104,27 @@ bool ServerConfig::saveToFile(const std::string& filepath) const {
     file << "  \"steam_server_browser\": " << (steam_server_browser ? "true" : "false") << "," << std::endl;
     file << "  \"tick_rate\": " << tick_rate << "," << std::endl;
     file << "  \"max_entities\": " << max_entities << "," << std::endl;
+    file << "  \"partition_by_system\": " << (partition_by_system ? "true" : "false") << "," << std::endl;
+    file << "  \"partition_workers\": " << partition_workers << "," << std::endl;
+    file << "  \"time_dilation\": " << (time_dilation ? "true" : "false") << "," << std::endl;
+    file << "  \"time_dilation_budget_ms\": " << time_dilation_budget_ms << "," << std::endl;
+    file << "  \"time_dilation_floor\": " << time_dilation_floor << "," << std::endl;
+    file << "  \"background_fast_forward\": " << (background_fast_forward ? "true" : "false") << "," << std::endl;
+    file << "  \"cluster_role\": \"" << cluster_role << "\"," << std::endl;
+    file << "  \"cluster_node_id\": \"" << cluster_node_id << "\"," << std::endl;
+    file << "  \"cluster_topology\": \"" << cluster_topology << "\"," << std::endl;
     file << "  \"data_path\": \"" << data_path << "\"," << std::endl;
+    file << "  \"data_bake_path\": \"" << data_bake_path << "\"," << std::endl;
     file << "  \"save_path\": \"" << save_path << "\"," << std::endl;
-    file << "  \"log_path\": \"" << log_path << "\"" << std::endl;
+    file << "  \"log_path\": \"" << log_path << "\"," << std::endl;
+    file << "  \"replay_record_path\": \"" << replay_record_path << "\"," << std::endl;
+    file << "  \"log_async\": " << (log_async ? "true" : "false") << "," << std::endl;
+    file << "  \"log_json\": " << (log_json ? "true" : "false") << "," << std::endl;
+    file << "  \"log_max_file_mb\": " << log_max_file_mb << "," << std::endl;
+    file << "  \"log_max_files\": " << log_max_files << "," << std::endl;
+    file << "  \"ping_interval_seconds\": " << ping_interval_seconds << "," << std::endl;
+    file << "  \"metrics_export_path\": \"" << metrics_export_path << "\"," << std::endl;
+    file << "  \"metrics_export_interval_seconds\": " << metrics_export_interval_seconds << std::endl;
     file << "}" << std::endl;
     
     file.close();
@@ -0,0 +1,690 @@
+#include "data/data_bake.h"
+#include "data/ship_database.h"
+#include "data/npc_database.h"
+#include "data/wormhole_database.h"
+#include "utils/mapped_file.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+namespace data {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// On-disk layout
+// ---------------------------------------------------------------------------
+
+constexpr char BAKE_MAGIC[8] = {'A', 'T', 'L', 'S', 'B', 'A', 'K', 'E'};
+
+using StrRef = uint32_t;   // byte offset into the string table; 0 is ""
+
+struct Section {
+    uint32_t offset = 0;   // from the start of the file
+    uint32_t count = 0;
+};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t file_size;
+    uint64_t source_hash;
+    uint64_t json_parse_us;
+    Section strings;       // count = bytes
+    Section ships;
+    Section npcs;
+    Section npc_weapons;
+    Section npc_loot;      // StrRef array
+    Section wh_classes;
+    Section wh_statics;    // StrRef array
+    Section wh_spawns;
+    Section wh_effects;
+    Section wh_modifiers;
+};
+
+struct ResistRecord {
+    float em, thermal, kinetic, explosive;
+};
+
+struct ShipRecord {
+    StrRef id, name, ship_class, race, description;
+    float hull_hp, armor_hp, shield_hp;
+    float capacitor, capacitor_recharge_time;
+    float cpu, powergrid;
+    int32_t high_slots, mid_slots, low_slots, rig_slots;
+    float max_velocity, inertia_modifier, cargo_capacity;
+    float signature_radius, scan_resolution;
+    int32_t max_locked_targets;
+    float max_targeting_range, shield_recharge_time;
+    ResistRecord shield_resists, armor_resists, hull_resists;
+    int32_t turret_hardpoints, launcher_hardpoints, drone_bays, engine_count, generation_seed;
+    uint32_t has_model_data;
+};
+
+struct NpcRecord {
+    double bounty;
+    StrRef id, name, type, faction, behavior;
+    float hull_hp, armor_hp, shield_hp;
+    float max_velocity, orbit_distance, signature_radius, awareness_range;
+    ResistRecord shield_resists, armor_resists, hull_resists;
+    uint32_t weapon_first, weapon_count;
+    uint32_t loot_first, loot_count;
+};
+
+struct NpcWeaponRecord {
+    StrRef type, damage_type;
+    float damage, optimal_range, falloff_range, rate_of_fire;
+};
+
+struct WormholeClassRecord {
+    double max_ship_mass, max_wormhole_stability, blue_loot_isk;
+    StrRef id, name, difficulty, description, max_ship_class;
+    int32_t wormhole_class;
+    float max_wormhole_lifetime_hours, salvage_value_multiplier;
+    uint32_t static_first, static_count;
+    uint32_t spawn_first, spawn_count;
+};
+
+struct DormantSpawnRecord {
+    StrRef id, name, type;
+    int32_t count_min, count_max;
+};
+
+struct WormholeEffectRecord {
+    StrRef id, name, description;
+    uint32_t modifier_first, modifier_count;
+};
+
+struct ModifierRecord {
+    StrRef stat;
+    float value;
+};
+
+static_assert(std::is_trivially_copyable<Header>::value, "bake header must be POD");
+static_assert(std::is_trivially_copyable<ShipRecord>::value, "bake records must be POD");
+static_assert(std::is_trivially_copyable<NpcRecord>::value, "bake records must be POD");
+static_assert(std::is_trivially_copyable<WormholeClassRecord>::value, "bake records must be POD");
+
+// ---------------------------------------------------------------------------
+// Writing helpers
+// ---------------------------------------------------------------------------
+
+/// Deduplicating string table; every distinct string is stored once
+class StringTable {
+public:
+    StringTable() { bytes_.push_back('\0'); }
+
+    StrRef intern(const std::string& s) {
+        if (s.empty()) return 0;
+        auto it = index_.find(s);
+        if (it != index_.end()) return it->second;
+        StrRef ref = static_cast<StrRef>(bytes_.size());
+        bytes_.insert(bytes_.end(), s.begin(), s.end());
+        bytes_.push_back('\0');
+        index_.emplace(s, ref);
+        return ref;
+    }
+
+    const std::vector<char>& bytes() const { return bytes_; }
+
+private:
+    std::vector<char> bytes_;
+    std::unordered_map<std::string, StrRef> index_;
+};
+
+ResistRecord packResists(float em, float thermal, float kinetic, float explosive) {
+    return ResistRecord{em, thermal, kinetic, explosive};
+}
+
+template<typename T>
+void appendSection(std::vector<char>& blob, Section& section, const T* data, size_t count) {
+    while (blob.size() % 8 != 0) blob.push_back('\0');
+    section.offset = static_cast<uint32_t>(blob.size());
+    section.count = static_cast<uint32_t>(count);
+    const char* bytes = reinterpret_cast<const char*>(data);
+    blob.insert(blob.end(), bytes, bytes + count * sizeof(T));
+}
+
+template<typename DB, typename Getter>
+std::vector<std::string> sortedIds(const DB& db, Getter ids) {
+    std::vector<std::string> out = (db.*ids)();
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// Reading helpers
+// ---------------------------------------------------------------------------
+
+/// Bounds-checked typed access to the sections of a mapped bake
+class BakeView {
+public:
+    BakeView(const char* base, size_t size) : base_(base), size_(size) {}
+
+    template<typename T>
+    const T* section(const Section& s) const {
+        if (s.count == 0) return nullptr;
+        if (s.offset % alignof(T) != 0) return nullptr;
+        uint64_t end = static_cast<uint64_t>(s.offset) + static_cast<uint64_t>(s.count) * sizeof(T);
+        if (end > size_) return nullptr;
+        return reinterpret_cast<const T*>(base_ + s.offset);
+    }
+
+    bool setStrings(const Section& s) {
+        if (s.count == 0 || static_cast<uint64_t>(s.offset) + s.count > size_) return false;
+        strings_ = base_ + s.offset;
+        strings_size_ = s.count;
+        return strings_[strings_size_ - 1] == '\0';
+    }
+
+    /// Pointer fixup for a string reference
+    const char* str(StrRef ref) const {
+        return ref < strings_size_ ? strings_ + ref : "";
+    }
+
+    static bool rangeOk(uint32_t first, uint32_t count, uint32_t total) {
+        return static_cast<uint64_t>(first) + count <= total;
+    }
+
+private:
+    const char* base_;
+    size_t size_;
+    const char* strings_ = "";
+    uint32_t strings_size_ = 1;
+};
+
+void ensureParentDirectory(const std::string& path) {
+    std::error_code ec;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) std::filesystem::create_directories(parent, ec);
+}
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// Hashing
+// ---------------------------------------------------------------------------
+
+uint64_t DataBake::hashSources(const std::string& data_dir) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    if (!fs::is_directory(data_dir, ec)) return 0;
+
+    std::vector<std::string> files;
+    for (auto it = fs::recursive_directory_iterator(data_dir, ec);
+         !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (it->is_regular_file(ec) && it->path().extension() == ".json") {
+            files.push_back(fs::relative(it->path(), data_dir, ec).generic_string());
+        }
+    }
+    if (files.empty()) return 0;
+    std::sort(files.begin(), files.end());
+
+    // FNV-1a over each relative path and its contents
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](const char* p, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            hash ^= static_cast<unsigned char>(p[i]);
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    std::vector<char> buffer(1 << 16);
+    for (const auto& rel : files) {
+        mix(rel.c_str(), rel.size() + 1);
+        std::ifstream in(data_dir + "/" + rel, std::ios::binary);
+        while (in) {
+            in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            mix(buffer.data(), static_cast<size_t>(in.gcount()));
+        }
+    }
+    return hash == 0 ? 1 : hash;
+}
+
+// ---------------------------------------------------------------------------
+// Write
+// ---------------------------------------------------------------------------
+
+bool DataBake::write(const std::string& bake_path, uint64_t source_hash,
+                     const ShipDatabase& ships, const NpcDatabase& npcs,
+                     const WormholeDatabase& wormholes, uint64_t json_parse_us) {
+    StringTable strings;
+
+    std::vector<ShipRecord> ship_records;
+    for (const auto& id : sortedIds(ships, &ShipDatabase::getShipIds)) {
+        const ShipTemplate& s = *ships.getShip(id);
+        ShipRecord r{};
+        r.id = strings.intern(s.id);
+        r.name = strings.intern(s.name);
+        r.ship_class = strings.intern(s.ship_class);
+        r.race = strings.intern(s.race);
+        r.description = strings.intern(s.description);
+        r.hull_hp = s.hull_hp;
+        r.armor_hp = s.armor_hp;
+        r.shield_hp = s.shield_hp;
+        r.capacitor = s.capacitor;
+        r.capacitor_recharge_time = s.capacitor_recharge_time;
+        r.cpu = s.cpu;
+        r.powergrid = s.powergrid;
+        r.high_slots = s.high_slots;
+        r.mid_slots = s.mid_slots;
+        r.low_slots = s.low_slots;
+        r.rig_slots = s.rig_slots;
+        r.max_velocity = s.max_velocity;
+        r.inertia_modifier = s.inertia_modifier;
+        r.cargo_capacity = s.cargo_capacity;
+        r.signature_radius = s.signature_radius;
+        r.scan_resolution = s.scan_resolution;
+        r.max_locked_targets = s.max_locked_targets;
+        r.max_targeting_range = s.max_targeting_range;
+        r.shield_recharge_time = s.shield_recharge_time;
+        r.shield_resists = packResists(s.shield_resists.em, s.shield_resists.thermal,
+                                       s.shield_resists.kinetic, s.shield_resists.explosive);
+        r.armor_resists = packResists(s.armor_resists.em, s.armor_resists.thermal,
+                                      s.armor_resists.kinetic, s.armor_resists.explosive);
+        r.hull_resists = packResists(s.hull_resists.em, s.hull_resists.thermal,
+                                     s.hull_resists.kinetic, s.hull_resists.explosive);
+        r.turret_hardpoints = s.model_data.turret_hardpoints;
+        r.launcher_hardpoints = s.model_data.launcher_hardpoints;
+        r.drone_bays = s.model_data.drone_bays;
+        r.engine_count = s.model_data.engine_count;
+        r.generation_seed = s.model_data.generation_seed;
+        r.has_model_data = s.model_data.has_model_data ? 1u : 0u;
+        ship_records.push_back(r);
+    }
+
+    std::vector<NpcRecord> npc_records;
+    std::vector<NpcWeaponRecord> weapon_records;
+    std::vector<StrRef> loot_refs;
+    for (const auto& id : sortedIds(npcs, &NpcDatabase::getNpcIds)) {
+        const NpcTemplate& n = *npcs.getNpc(id);
+        NpcRecord r{};
+        r.bounty = n.bounty;
+        r.id = strings.intern(n.id);
+        r.name = strings.intern(n.name);
+        r.type = strings.intern(n.type);
+        r.faction = strings.intern(n.faction);
+        r.behavior = strings.intern(n.behavior);
+        r.hull_hp = n.hull_hp;
+        r.armor_hp = n.armor_hp;
+        r.shield_hp = n.shield_hp;
+        r.max_velocity = n.max_velocity;
+        r.orbit_distance = n.orbit_distance;
+        r.signature_radius = n.signature_radius;
+        r.awareness_range = n.awareness_range;
+        r.shield_resists = packResists(n.shield_resists.em, n.shield_resists.thermal,
+                                       n.shield_resists.kinetic, n.shield_resists.explosive);
+        r.armor_resists = packResists(n.armor_resists.em, n.armor_resists.thermal,
+                                      n.armor_resists.kinetic, n.armor_resists.explosive);
+        r.hull_resists = packResists(n.hull_resists.em, n.hull_resists.thermal,
+                                     n.hull_resists.kinetic, n.hull_resists.explosive);
+        r.weapon_first = static_cast<uint32_t>(weapon_records.size());
+        r.weapon_count = static_cast<uint32_t>(n.weapons.size());
+        for (const auto& w : n.weapons) {
+            weapon_records.push_back({strings.intern(w.type), strings.intern(w.damage_type),
+                                      w.damage, w.optimal_range, w.falloff_range, w.rate_of_fire});
+        }
+        r.loot_first = static_cast<uint32_t>(loot_refs.size());
+        r.loot_count = static_cast<uint32_t>(n.loot_table.size());
+        for (const auto& item : n.loot_table) loot_refs.push_back(strings.intern(item));
+        npc_records.push_back(r);
+    }
+
+    std::vector<WormholeClassRecord> class_records;
+    std::vector<StrRef> static_refs;
+    std::vector<DormantSpawnRecord> spawn_records;
+    for (const auto& id : sortedIds(wormholes, &WormholeDatabase::getClassIds)) {
+        const WormholeClassTemplate& c = *wormholes.getWormholeClass(id);
+        WormholeClassRecord r{};
+        r.max_ship_mass = c.max_ship_mass;
+        r.max_wormhole_stability = c.max_wormhole_stability;
+        r.blue_loot_isk = c.blue_loot_isk;
+        r.id = strings.intern(c.id);
+        r.name = strings.intern(c.name);
+        r.difficulty = strings.intern(c.difficulty);
+        r.description = strings.intern(c.description);
+        r.max_ship_class = strings.intern(c.max_ship_class);
+        r.wormhole_class = c.wormhole_class;
+        r.max_wormhole_lifetime_hours = c.max_wormhole_lifetime_hours;
+        r.salvage_value_multiplier = c.salvage_value_multiplier;
+        r.static_first = static_cast<uint32_t>(static_refs.size());
+        r.static_count = static_cast<uint32_t>(c.static_connections.size());
+        for (const auto& sc : c.static_connections) static_refs.push_back(strings.intern(sc));
+        r.spawn_first = static_cast<uint32_t>(spawn_records.size());
+        r.spawn_count = static_cast<uint32_t>(c.dormant_spawns.size());
+        for (const auto& sp : c.dormant_spawns) {
+            spawn_records.push_back({strings.intern(sp.id), strings.intern(sp.name),
+                                     strings.intern(sp.type), sp.count_min, sp.count_max});
+        }
+        class_records.push_back(r);
+    }
+
+    std::vector<WormholeEffectRecord> effect_records;
+    std::vector<ModifierRecord> modifier_records;
+    for (const auto& id : sortedIds(wormholes, &WormholeDatabase::getEffectIds)) {
+        const WormholeEffect& e = *wormholes.getEffect(id);
+        WormholeEffectRecord r{};
+        r.id = strings.intern(e.id);
+        r.name = strings.intern(e.name);
+        r.description = strings.intern(e.description);
+        r.modifier_first = static_cast<uint32_t>(modifier_records.size());
+        std::vector<std::pair<std::string, float>> mods(e.modifiers.begin(), e.modifiers.end());
+        std::sort(mods.begin(), mods.end());
+        r.modifier_count = static_cast<uint32_t>(mods.size());
+        for (const auto& m : mods) modifier_records.push_back({strings.intern(m.first), m.second});
+        effect_records.push_back(r);
+    }
+
+    Header header{};
+    std::memcpy(header.magic, BAKE_MAGIC, sizeof(BAKE_MAGIC));
+    header.version = VERSION;
+    header.source_hash = source_hash;
+    header.json_parse_us = json_parse_us;
+
+    std::vector<char> blob(sizeof(Header), '\0');
+    appendSection(blob, header.ships, ship_records.data(), ship_records.size());
+    appendSection(blob, header.npcs, npc_records.data(), npc_records.size());
+    appendSection(blob, header.npc_weapons, weapon_records.data(), weapon_records.size());
+    appendSection(blob, header.npc_loot, loot_refs.data(), loot_refs.size());
+    appendSection(blob, header.wh_classes, class_records.data(), class_records.size());
+    appendSection(blob, header.wh_statics, static_refs.data(), static_refs.size());
+    appendSection(blob, header.wh_spawns, spawn_records.data(), spawn_records.size());
+    appendSection(blob, header.wh_effects, effect_records.data(), effect_records.size());
+    appendSection(blob, header.wh_modifiers, modifier_records.data(), modifier_records.size());
+    appendSection(blob, header.strings, strings.bytes().data(), strings.bytes().size());
+    header.file_size = static_cast<uint32_t>(blob.size());
+    std::memcpy(blob.data(), &header, sizeof(Header));
+
+    // Write to a temporary file and rename so readers never see a partial bake
+    ensureParentDirectory(bake_path);
+    std::string tmp_path = bake_path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+        if (!out) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, bake_path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Read
+// ---------------------------------------------------------------------------
+
+bool DataBake::read(const std::string& bake_path, uint64_t expected_hash,
+                    ShipDatabase* ships, NpcDatabase* npcs,
+                    WormholeDatabase* wormholes, Report* report) {
+    utils::MappedFile file;
+    if (!file.open(bake_path) || file.size() < sizeof(Header)) return false;
+
+    Header header;
+    std::memcpy(&header, file.data(), sizeof(Header));
+    if (std::memcmp(header.magic, BAKE_MAGIC, sizeof(BAKE_MAGIC)) != 0) return false;
+    if (header.version != VERSION || header.file_size != file.size()) return false;
+    if (header.source_hash != expected_hash) return false;
+
+    BakeView view(file.data(), file.size());
+    if (!view.setStrings(header.strings)) return false;
+
+    // Validate every section before touching any database
+    const auto* ship_recs = view.section<ShipRecord>(header.ships);
+    const auto* npc_recs = view.section<NpcRecord>(header.npcs);
+    const auto* weapon_recs = view.section<NpcWeaponRecord>(header.npc_weapons);
+    const auto* loot_refs = view.section<StrRef>(header.npc_loot);
+    const auto* class_recs = view.section<WormholeClassRecord>(header.wh_classes);
+    const auto* static_refs = view.section<StrRef>(header.wh_statics);
+    const auto* spawn_recs = view.section<DormantSpawnRecord>(header.wh_spawns);
+    const auto* effect_recs = view.section<WormholeEffectRecord>(header.wh_effects);
+    const auto* modifier_recs = view.section<ModifierRecord>(header.wh_modifiers);
+    auto present = [](const void* p, const Section& s) { return s.count == 0 || p != nullptr; };
+    if (!present(ship_recs, header.ships) || !present(npc_recs, header.npcs) ||
+        !present(weapon_recs, header.npc_weapons) || !present(loot_refs, header.npc_loot) ||
+        !present(class_recs, header.wh_classes) || !present(static_refs, header.wh_statics) ||
+        !present(spawn_recs, header.wh_spawns) || !present(effect_recs, header.wh_effects) ||
+        !present(modifier_recs, header.wh_modifiers)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < header.npcs.count; ++i) {
+        if (!BakeView::rangeOk(npc_recs[i].weapon_first, npc_recs[i].weapon_count, header.npc_weapons.count) ||
+            !BakeView::rangeOk(npc_recs[i].loot_first, npc_recs[i].loot_count, header.npc_loot.count)) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header.wh_classes.count; ++i) {
+        if (!BakeView::rangeOk(class_recs[i].static_first, class_recs[i].static_count, header.wh_statics.count) ||
+            !BakeView::rangeOk(class_recs[i].spawn_first, class_recs[i].spawn_count, header.wh_spawns.count)) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header.wh_effects.count; ++i) {
+        if (!BakeView::rangeOk(effect_recs[i].modifier_first, effect_recs[i].modifier_count,
+                               header.wh_modifiers.count)) {
+            return false;
+        }
+    }
+
+    if (ships) {
+        for (uint32_t i = 0; i < header.ships.count; ++i) {
+            const ShipRecord& r = ship_recs[i];
+            ShipTemplate s;
+            s.id = view.str(r.id);
+            s.name = view.str(r.name);
+            s.ship_class = view.str(r.ship_class);
+            s.race = view.str(r.race);
+            s.description = view.str(r.description);
+            s.hull_hp = r.hull_hp;
+            s.armor_hp = r.armor_hp;
+            s.shield_hp = r.shield_hp;
+            s.capacitor = r.capacitor;
+            s.capacitor_recharge_time = r.capacitor_recharge_time;
+            s.cpu = r.cpu;
+            s.powergrid = r.powergrid;
+            s.high_slots = r.high_slots;
+            s.mid_slots = r.mid_slots;
+            s.low_slots = r.low_slots;
+            s.rig_slots = r.rig_slots;
+            s.max_velocity = r.max_velocity;
+            s.inertia_modifier = r.inertia_modifier;
+            s.cargo_capacity = r.cargo_capacity;
+            s.signature_radius = r.signature_radius;
+            s.scan_resolution = r.scan_resolution;
+            s.max_locked_targets = r.max_locked_targets;
+            s.max_targeting_range = r.max_targeting_range;
+            s.shield_recharge_time = r.shield_recharge_time;
+            s.shield_resists = {r.shield_resists.em, r.shield_resists.thermal,
+                                r.shield_resists.kinetic, r.shield_resists.explosive};
+            s.armor_resists = {r.armor_resists.em, r.armor_resists.thermal,
+                               r.armor_resists.kinetic, r.armor_resists.explosive};
+            s.hull_resists = {r.hull_resists.em, r.hull_resists.thermal,
+                              r.hull_resists.kinetic, r.hull_resists.explosive};
+            s.model_data.turret_hardpoints = r.turret_hardpoints;
+            s.model_data.launcher_hardpoints = r.launcher_hardpoints;
+            s.model_data.drone_bays = r.drone_bays;
+            s.model_data.engine_count = r.engine_count;
+            s.model_data.generation_seed = r.generation_seed;
+            s.model_data.has_model_data = r.has_model_data != 0;
+            ships->addShip(std::move(s));
+        }
+    }
+
+    if (npcs) {
+        for (uint32_t i = 0; i < header.npcs.count; ++i) {
+            const NpcRecord& r = npc_recs[i];
+            NpcTemplate n;
+            n.id = view.str(r.id);
+            n.name = view.str(r.name);
+            n.type = view.str(r.type);
+            n.faction = view.str(r.faction);
+            n.behavior = view.str(r.behavior);
+            n.hull_hp = r.hull_hp;
+            n.armor_hp = r.armor_hp;
+            n.shield_hp = r.shield_hp;
+            n.max_velocity = r.max_velocity;
+            n.orbit_distance = r.orbit_distance;
+            n.signature_radius = r.signature_radius;
+            n.awareness_range = r.awareness_range;
+            n.bounty = r.bounty;
+            n.shield_resists = {r.shield_resists.em, r.shield_resists.thermal,
+                                r.shield_resists.kinetic, r.shield_resists.explosive};
+            n.armor_resists = {r.armor_resists.em, r.armor_resists.thermal,
+                               r.armor_resists.kinetic, r.armor_resists.explosive};
+            n.hull_resists = {r.hull_resists.em, r.hull_resists.thermal,
+                              r.hull_resists.kinetic, r.hull_resists.explosive};
+            n.weapons.reserve(r.weapon_count);
+            for (uint32_t w = 0; w < r.weapon_count; ++w) {
+                const NpcWeaponRecord& wr = weapon_recs[r.weapon_first + w];
+                NpcTemplate::WeaponData wd;
+                wd.type = view.str(wr.type);
+                wd.damage_type = view.str(wr.damage_type);
+                wd.damage = wr.damage;
+                wd.optimal_range = wr.optimal_range;
+                wd.falloff_range = wr.falloff_range;
+                wd.rate_of_fire = wr.rate_of_fire;
+                n.weapons.push_back(std::move(wd));
+            }
+            n.loot_table.reserve(r.loot_count);
+            for (uint32_t l = 0; l < r.loot_count; ++l) {
+                n.loot_table.emplace_back(view.str(loot_refs[r.loot_first + l]));
+            }
+            npcs->addNpc(std::move(n));
+        }
+    }
+
+    if (wormholes) {
+        for (uint32_t i = 0; i < header.wh_classes.count; ++i) {
+            const WormholeClassRecord& r = class_recs[i];
+            WormholeClassTemplate c;
+            c.id = view.str(r.id);
+            c.name = view.str(r.name);
+            c.difficulty = view.str(r.difficulty);
+            c.description = view.str(r.description);
+            c.max_ship_class = view.str(r.max_ship_class);
+            c.wormhole_class = r.wormhole_class;
+            c.max_ship_mass = r.max_ship_mass;
+            c.max_wormhole_stability = r.max_wormhole_stability;
+            c.max_wormhole_lifetime_hours = r.max_wormhole_lifetime_hours;
+            c.salvage_value_multiplier = r.salvage_value_multiplier;
+            c.blue_loot_isk = r.blue_loot_isk;
+            for (uint32_t s = 0; s < r.static_count; ++s) {
+                c.static_connections.emplace_back(view.str(static_refs[r.static_first + s]));
+            }
+            for (uint32_t s = 0; s < r.spawn_count; ++s) {
+                const DormantSpawnRecord& sr = spawn_recs[r.spawn_first + s];
+                DormantSpawn spawn;
+                spawn.id = view.str(sr.id);
+                spawn.name = view.str(sr.name);
+                spawn.type = view.str(sr.type);
+                spawn.count_min = sr.count_min;
+                spawn.count_max = sr.count_max;
+                c.dormant_spawns.push_back(std::move(spawn));
+            }
+            wormholes->addWormholeClass(std::move(c));
+        }
+        for (uint32_t i = 0; i < header.wh_effects.count; ++i) {
+            const WormholeEffectRecord& r = effect_recs[i];
+            WormholeEffect e;
+            e.id = view.str(r.id);
+            e.name = view.str(r.name);
+            e.description = view.str(r.description);
+            for (uint32_t m = 0; m < r.modifier_count; ++m) {
+                const ModifierRecord& mr = modifier_recs[r.modifier_first + m];
+                e.modifiers[view.str(mr.stat)] = mr.value;
+            }
+            wormholes->addEffect(std::move(e));
+        }
+    }
+
+    if (report) {
+        report->bake_bytes = file.size();
+        report->json_parse_ms = static_cast<double>(header.json_parse_us) / 1000.0;
+        report->ships = header.ships.count;
+        report->npcs = header.npcs.count;
+        report->wormhole_classes = header.wh_classes.count;
+        report->wormhole_effects = header.wh_effects.count;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Load (bake if current, otherwise JSON + rebake)
+// ---------------------------------------------------------------------------
+
+DataBake::Report DataBake::load(const std::string& data_dir, const std::string& bake_path,
+                                ShipDatabase* ships, NpcDatabase* npcs,
+                                WormholeDatabase* wormholes) {
+    Report report;
+
+    auto start = std::chrono::steady_clock::now();
+    report.source_hash = hashSources(data_dir);
+    report.hash_ms = msSince(start);
+
+    if (report.source_hash != 0) {
+        start = std::chrono::steady_clock::now();
+        if (read(bake_path, report.source_hash, ships, npcs, wormholes, &report)) {
+            report.load_ms = msSince(start);
+            report.used_bake = true;
+            std::cout << "[DataBake] Loaded " << report.ships << " ships, "
+                      << report.npcs << " NPCs, " << report.wormhole_classes
+                      << " wormhole classes from " << bake_path << " in "
+                      << report.load_ms << " ms (JSON parse: "
+                      << report.json_parse_ms << " ms)" << std::endl;
+            return report;
+        }
+    }
+
+    // Stale or missing bake: parse the JSON sources
+    start = std::chrono::steady_clock::now();
+    ShipDatabase parsed_ships;
+    NpcDatabase parsed_npcs;
+    WormholeDatabase parsed_wormholes;
+    parsed_ships.loadFromDirectory(data_dir);
+    parsed_npcs.loadFromDirectory(data_dir);
+    parsed_wormholes.loadFromDirectory(data_dir);
+    report.json_parse_ms = msSince(start);
+    report.load_ms = report.json_parse_ms;
+    report.ships = parsed_ships.getShipCount();
+    report.npcs = parsed_npcs.getNpcCount();
+    report.wormhole_classes = parsed_wormholes.getClassCount();
+    report.wormhole_effects = parsed_wormholes.getEffectCount();
+
+    if (report.source_hash != 0 && !bake_path.empty()) {
+        uint64_t parse_us = static_cast<uint64_t>(report.json_parse_ms * 1000.0);
+        report.rebuilt = write(bake_path, report.source_hash, parsed_ships, parsed_npcs,
+                               parsed_wormholes, parse_us);
+        std::error_code ec;
+        if (report.rebuilt) {
+            report.bake_bytes = static_cast<size_t>(std::filesystem::file_size(bake_path, ec));
+            std::cout << "[DataBake] Rebuilt " << bake_path << " (" << report.bake_bytes
+                      << " bytes) after JSON parse of " << report.json_parse_ms
+                      << " ms" << std::endl;
+        } else {
+            std::cerr << "[DataBake] Failed to write " << bake_path << std::endl;
+        }
+    }
+
+    if (ships) *ships = std::move(parsed_ships);
+    if (npcs) *npcs = std::move(parsed_npcs);
+    if (wormholes) *wormholes = std::move(parsed_wormholes);
+    return report;
+}
+
+} // namespace data
+} // namespace atlas
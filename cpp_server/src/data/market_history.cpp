@@ -0,0 +1,400 @@
+#include "data/market_history.h"
+#include "utils/mapped_file.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+
+namespace atlas {
+namespace data {
+
+static_assert(std::is_trivially_copyable<MarketHistory::Ring>::value,
+              "MarketHistory::Ring must stay POD for segment mapping");
+
+namespace {
+
+constexpr char SEGMENT_MAGIC[4] = {'E', 'V', 'M', 'H'};
+constexpr uint32_t SEGMENT_VERSION = 1;
+constexpr char KEY_SEPARATOR = '\x1f';
+const std::string HUB_AGGREGATE_ID = MarketHistory::HUB_AGGREGATE;
+
+struct SegmentHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t series_count;
+    uint32_t key_size;
+    uint32_t ring_capacity;
+    uint32_t resolution_count;
+};
+
+struct SegmentRecord {
+    char hub_id[MarketHistory::SEGMENT_KEY_SIZE];
+    char item_id[MarketHistory::SEGMENT_KEY_SIZE];
+    MarketHistory::Ring rings[MarketHistory::RESOLUTION_COUNT];
+};
+
+// Logical index of the first bucket with start_time >= t
+uint32_t lowerBound(const MarketHistory::Ring& ring, int64_t t) {
+    uint32_t lo = 0, hi = ring.count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (ring.at(mid).start_time < t) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+} // namespace
+
+MarketHistory::MarketHistory() = default;
+
+// ---------------------------------------------------------------------------
+// Resolution helpers
+// ---------------------------------------------------------------------------
+
+int64_t MarketHistory::bucketWidth(Resolution res) {
+    switch (res) {
+        case Resolution::FiveMinutes: return 300;
+        case Resolution::OneHour:     return 3600;
+        case Resolution::OneDay:      return 86400;
+    }
+    return 300;
+}
+
+uint32_t MarketHistory::bucketCapacity(Resolution res) {
+    switch (res) {
+        case Resolution::FiveMinutes: return 288;  // 24 hours
+        case Resolution::OneHour:     return 168;  // 7 days
+        case Resolution::OneDay:      return 90;   // ~3 months
+    }
+    return 288;
+}
+
+bool MarketHistory::parseResolution(const std::string& str, Resolution& out) {
+    if (str == "5m") { out = Resolution::FiveMinutes; return true; }
+    if (str == "1h") { out = Resolution::OneHour; return true; }
+    if (str == "1d") { out = Resolution::OneDay; return true; }
+    return false;
+}
+
+const char* MarketHistory::resolutionToString(Resolution res) {
+    switch (res) {
+        case Resolution::FiveMinutes: return "5m";
+        case Resolution::OneHour:     return "1h";
+        case Resolution::OneDay:      return "1d";
+    }
+    return "5m";
+}
+
+// ---------------------------------------------------------------------------
+// Recording
+// ---------------------------------------------------------------------------
+
+std::string MarketHistory::makeKey(const std::string& hub_id,
+                                   const std::string& item_id) {
+    std::string key;
+    key.reserve(hub_id.size() + item_id.size() + 1);
+    key += hub_id;
+    key += KEY_SEPARATOR;
+    key += item_id;
+    return key;
+}
+
+const MarketHistory::Series* MarketHistory::findSeries(
+        const std::string& hub_id, const std::string& item_id) const {
+    auto it = series_.find(makeKey(hub_id, item_id));
+    return it != series_.end() ? &it->second : nullptr;
+}
+
+bool MarketHistory::hasSeries(const std::string& hub_id,
+                              const std::string& item_id) const {
+    return findSeries(hub_id, item_id) != nullptr;
+}
+
+double MarketHistory::getLatestTime() const {
+    const int fine = static_cast<int>(Resolution::FiveMinutes);
+    int64_t latest = 0;
+    for (const auto& kv : series_) {
+        const Ring& ring = kv.second.rings[fine];
+        if (ring.count == 0) continue;
+        latest = std::max(latest, ring.at(ring.count - 1).start_time +
+                                  bucketWidth(Resolution::FiveMinutes));
+    }
+    return static_cast<double>(latest);
+}
+
+void MarketHistory::rollInto(Ring& ring, int64_t width, double price,
+                             int quantity, int64_t time_seconds) {
+    int64_t start = (time_seconds / width) * width;
+    if (time_seconds < 0 && time_seconds % width != 0) start -= width;
+
+    Bucket* target = nullptr;
+    uint32_t slot = 0;
+    if (ring.count > 0 && ring.at(ring.count - 1).start_time == start) {
+        slot = (ring.head + ring.capacity - 1) % ring.capacity;
+        target = &ring.buckets[slot];
+    } else if (ring.count == 0 || ring.at(ring.count - 1).start_time < start) {
+        // Open a new bucket, overwriting the oldest once the ring is full
+        slot = ring.head;
+        ring.buckets[slot] = Bucket{};
+        ring.buckets[slot].start_time = start;
+        ring.buckets[slot].open = price;
+        ring.buckets[slot].high = price;
+        ring.buckets[slot].low = price;
+        ring.notional[slot] = 0.0;
+        ring.head = (ring.head + 1) % ring.capacity;
+        if (ring.count < ring.capacity) ++ring.count;
+        target = &ring.buckets[slot];
+    } else {
+        // Late trade: fold into its bucket if still retained, else drop it
+        uint32_t idx = lowerBound(ring, start);
+        if (idx >= ring.count || ring.at(idx).start_time != start) return;
+        slot = (ring.head + ring.capacity - ring.count + idx) % ring.capacity;
+        target = &ring.buckets[slot];
+    }
+
+    target->high = std::max(target->high, price);
+    target->low = std::min(target->low, price);
+    target->close = price;
+    target->volume += quantity;
+    target->trade_count += 1;
+    ring.notional[slot] += price * quantity;
+}
+
+void MarketHistory::recordTrade(const std::string& hub_id, const std::string& item_id,
+                                double price, int quantity, double time_seconds) {
+    if (quantity <= 0 || price < 0.0) return;
+
+    int64_t t = static_cast<int64_t>(std::floor(time_seconds));
+    for (const std::string* item : {&item_id, &HUB_AGGREGATE_ID}) {
+        auto key = makeKey(hub_id, *item);
+        auto it = series_.find(key);
+        if (it == series_.end()) {
+            it = series_.emplace(std::move(key), Series{}).first;
+            for (int r = 0; r < RESOLUTION_COUNT; ++r) {
+                it->second.rings[r].capacity =
+                    bucketCapacity(static_cast<Resolution>(r));
+            }
+        }
+        for (int r = 0; r < RESOLUTION_COUNT; ++r) {
+            rollInto(it->second.rings[r], bucketWidth(static_cast<Resolution>(r)),
+                     price, quantity, t);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Queries
+// ---------------------------------------------------------------------------
+
+std::vector<MarketHistory::Bucket> MarketHistory::query(
+        const std::string& hub_id, const std::string& item_id,
+        Resolution res, double from_time, double to_time) const {
+    std::vector<Bucket> result;
+    const Series* s = findSeries(hub_id, item_id);
+    if (!s || to_time < from_time) return result;
+
+    const Ring& ring = s->rings[static_cast<int>(res)];
+    uint32_t first = lowerBound(ring, static_cast<int64_t>(std::ceil(from_time)));
+    for (uint32_t i = first; i < ring.count; ++i) {
+        const Bucket& b = ring.at(i);
+        if (static_cast<double>(b.start_time) > to_time) break;
+        result.push_back(b);
+    }
+    return result;
+}
+
+std::vector<MarketHistory::Bucket> MarketHistory::latest(
+        const std::string& hub_id, const std::string& item_id,
+        Resolution res, int count) const {
+    std::vector<Bucket> result;
+    const Series* s = findSeries(hub_id, item_id);
+    if (!s || count <= 0) return result;
+
+    const Ring& ring = s->rings[static_cast<int>(res)];
+    uint32_t n = std::min(static_cast<uint32_t>(count), ring.count);
+    result.reserve(n);
+    for (uint32_t i = ring.count - n; i < ring.count; ++i) {
+        result.push_back(ring.at(i));
+    }
+    return result;
+}
+
+double MarketHistory::getAveragePrice(const std::string& hub_id,
+                                      const std::string& item_id,
+                                      Resolution res, int buckets) const {
+    const Series* s = findSeries(hub_id, item_id);
+    if (!s || buckets <= 0) return -1.0;
+
+    const Ring& ring = s->rings[static_cast<int>(res)];
+    uint32_t n = std::min(static_cast<uint32_t>(buckets), ring.count);
+    double notional = 0.0;
+    int64_t volume = 0;
+    for (uint32_t i = ring.count - n; i < ring.count; ++i) {
+        notional += ring.notionalAt(i);
+        volume += ring.at(i).volume;
+    }
+    return volume > 0 ? notional / static_cast<double>(volume) : -1.0;
+}
+
+int64_t MarketHistory::getVolume(const std::string& hub_id, const std::string& item_id,
+                                 Resolution res, int buckets) const {
+    const Series* s = findSeries(hub_id, item_id);
+    if (!s || buckets <= 0) return 0;
+
+    const Ring& ring = s->rings[static_cast<int>(res)];
+    uint32_t n = std::min(static_cast<uint32_t>(buckets), ring.count);
+    int64_t volume = 0;
+    for (uint32_t i = ring.count - n; i < ring.count; ++i) {
+        volume += ring.at(i).volume;
+    }
+    return volume;
+}
+
+int64_t MarketHistory::getHubVolume(const std::string& hub_id, Resolution res,
+                                    int buckets) const {
+    return getVolume(hub_id, HUB_AGGREGATE_ID, res, buckets);
+}
+
+int64_t MarketHistory::getVolume(const std::string& hub_id, const std::string& item_id,
+                                 Resolution res, int buckets, double now) const {
+    const Series* s = findSeries(hub_id, item_id);
+    if (!s || buckets <= 0) return 0;
+
+    const Ring& ring = s->rings[static_cast<int>(res)];
+    int64_t to = static_cast<int64_t>(std::floor(now));
+    int64_t from = to - buckets * bucketWidth(res) + 1;
+    int64_t volume = 0;
+    for (uint32_t i = lowerBound(ring, from); i < ring.count; ++i) {
+        const Bucket& b = ring.at(i);
+        if (b.start_time > to) break;
+        volume += b.volume;
+    }
+    return volume;
+}
+
+int64_t MarketHistory::getHubVolume(const std::string& hub_id, Resolution res,
+                                    int buckets, double now) const {
+    return getVolume(hub_id, HUB_AGGREGATE_ID, res, buckets, now);
+}
+
+double MarketHistory::getPriceTrend(const std::string& hub_id,
+                                    const std::string& item_id,
+                                    Resolution res, int buckets) const {
+    const Series* s = findSeries(hub_id, item_id);
+    if (!s || buckets <= 0) return 0.0;
+
+    const Ring& ring = s->rings[static_cast<int>(res)];
+    uint32_t n = std::min(static_cast<uint32_t>(buckets), ring.count);
+    if (n == 0) return 0.0;
+
+    const Bucket& oldest = ring.at(ring.count - n);
+    const Bucket& newest = ring.at(ring.count - 1);
+    if (oldest.open <= 0.0) return 0.0;
+    return (newest.close - oldest.open) / oldest.open;
+}
+
+// ---------------------------------------------------------------------------
+// Segment persistence
+// ---------------------------------------------------------------------------
+
+bool MarketHistory::saveSegment(const std::string& filepath) const {
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "[MarketHistory] Cannot open segment for writing: "
+                  << filepath << std::endl;
+        return false;
+    }
+
+    std::vector<const std::pair<const std::string, Series>*> writable;
+    writable.reserve(series_.size());
+    for (const auto& kv : series_) {
+        size_t sep = kv.first.find(KEY_SEPARATOR);
+        if (sep >= SEGMENT_KEY_SIZE ||
+            kv.first.size() - sep - 1 >= SEGMENT_KEY_SIZE) continue;
+        writable.push_back(&kv);
+    }
+
+    SegmentHeader header{};
+    std::memcpy(header.magic, SEGMENT_MAGIC, sizeof(header.magic));
+    header.version = SEGMENT_VERSION;
+    header.series_count = static_cast<uint32_t>(writable.size());
+    header.key_size = static_cast<uint32_t>(SEGMENT_KEY_SIZE);
+    header.ring_capacity = Ring::MAX_CAPACITY;
+    header.resolution_count = RESOLUTION_COUNT;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    auto record = std::make_unique<SegmentRecord>();
+    for (const auto* kv : writable) {
+        *record = SegmentRecord{};
+        size_t sep = kv->first.find(KEY_SEPARATOR);
+        std::memcpy(record->hub_id, kv->first.data(), sep);
+        std::memcpy(record->item_id, kv->first.data() + sep + 1,
+                    kv->first.size() - sep - 1);
+        for (int r = 0; r < RESOLUTION_COUNT; ++r) {
+            record->rings[r] = kv->second.rings[r];
+        }
+        file.write(reinterpret_cast<const char*>(record.get()), sizeof(SegmentRecord));
+    }
+
+    return file.good();
+}
+
+bool MarketHistory::loadSegment(const std::string& filepath) {
+    utils::MappedFile file;
+    if (!file.open(filepath)) return false;
+
+    SegmentHeader header{};
+    if (file.size() >= sizeof(header)) {
+        std::memcpy(&header, file.data(), sizeof(header));
+    }
+    if (file.size() < sizeof(header) ||
+        std::memcmp(header.magic, SEGMENT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != SEGMENT_VERSION ||
+        header.key_size != SEGMENT_KEY_SIZE ||
+        header.ring_capacity != static_cast<uint32_t>(Ring::MAX_CAPACITY) ||
+        header.resolution_count != static_cast<uint32_t>(RESOLUTION_COUNT)) {
+        std::cerr << "[MarketHistory] Incompatible segment: " << filepath << std::endl;
+        return false;
+    }
+    if ((file.size() - sizeof(header)) / sizeof(SegmentRecord) < header.series_count) {
+        std::cerr << "[MarketHistory] Truncated segment: " << filepath << std::endl;
+        return false;
+    }
+
+    // Records are read in place from the mapping; only the rings are
+    // copied into the live series
+    const char* records = file.data() + sizeof(header);
+    std::unordered_map<std::string, Series> loaded;
+    loaded.reserve(header.series_count);
+    for (uint32_t i = 0; i < header.series_count; ++i) {
+        const char* record = records + static_cast<size_t>(i) * sizeof(SegmentRecord);
+        const char* hub_id = record + offsetof(SegmentRecord, hub_id);
+        const char* item_id = record + offsetof(SegmentRecord, item_id);
+
+        auto inserted = loaded.emplace(
+            makeKey(std::string(hub_id, strnlen(hub_id, SEGMENT_KEY_SIZE - 1)),
+                    std::string(item_id, strnlen(item_id, SEGMENT_KEY_SIZE - 1))),
+            Series());
+        Series& series = inserted.first->second;
+        std::memcpy(series.rings.data(), record + offsetof(SegmentRecord, rings),
+                    sizeof(Ring) * RESOLUTION_COUNT);
+        for (const Ring& ring : series.rings) {
+            if (ring.capacity == 0 || ring.capacity > Ring::MAX_CAPACITY ||
+                ring.count > ring.capacity || ring.head >= ring.capacity) {
+                std::cerr << "[MarketHistory] Corrupt ring in segment: " << filepath << std::endl;
+                return false;
+            }
+        }
+    }
+
+    series_ = std::move(loaded);
+    return true;
+}
+
+} // namespace data
+} // namespace atlas
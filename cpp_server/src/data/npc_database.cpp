@@ -112,6 +112,11 @@ std::vector<std::string> NpcDatabase::getNpcIds() const {
     return ids;
 }
 
+void NpcDatabase::addNpc(NpcTemplate npc) {
+    std::string id = npc.id;
+    npcs_[id] = std::move(npc);
+}
+
 // ---------------------------------------------------------------------------
 // Parsing
 // ---------------------------------------------------------------------------
@@ -126,6 +126,11 @@ std::vector<std::string> ShipDatabase::getShipIds() const {
     return ids;
 }
 
+void ShipDatabase::addShip(ShipTemplate ship) {
+    std::string id = ship.id;
+    ships_[id] = std::move(ship);
+}
+
 // ---------------------------------------------------------------------------
 // Parsing
 // ---------------------------------------------------------------------------
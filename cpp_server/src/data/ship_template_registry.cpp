@@ -0,0 +1,283 @@
+#include "data/ship_template_registry.h"
+#include "data/ship_database.h"
+#include <algorithm>
+
+namespace atlas {
+namespace data {
+
+namespace {
+
+const char* const STAT_NAMES[SHIP_STAT_COUNT] = {
+    "hull_max",
+    "armor_max",
+    "shield_max",
+    "shield_recharge_rate",
+    "capacitor_max",
+    "capacitor_recharge_rate",
+    "cpu_max",
+    "powergrid_max",
+    "max_velocity",
+    "signature_radius",
+    "scan_resolution",
+    "max_locked_targets",
+    "max_targeting_range",
+    "warp_speed_au",
+    "align_time",
+    "warp_strength",
+    "shield_em_resist",
+    "shield_thermal_resist",
+    "shield_kinetic_resist",
+    "shield_explosive_resist",
+    "armor_em_resist",
+    "armor_thermal_resist",
+    "armor_kinetic_resist",
+    "armor_explosive_resist",
+    "hull_em_resist",
+    "hull_thermal_resist",
+    "hull_kinetic_resist",
+    "hull_explosive_resist"
+};
+
+/// Heap bytes owned by a std::string beyond the object itself
+size_t stringHeapBytes(const std::string& s) {
+    // Capacities up to the small-string buffer live inside the object
+    static const size_t sso_capacity = std::string().capacity();
+    return s.capacity() > sso_capacity ? s.capacity() + 1 : 0;
+}
+
+size_t statsBytes(const ShipStats& stats) {
+    return sizeof(ShipStats) + stringHeapBytes(stats.id) + stringHeapBytes(stats.name) +
+           stringHeapBytes(stats.ship_class) + stringHeapBytes(stats.race);
+}
+
+} // anonymous namespace
+
+const char* shipStatName(ShipStat stat) {
+    size_t index = static_cast<size_t>(stat);
+    return index < SHIP_STAT_COUNT ? STAT_NAMES[index] : "unknown";
+}
+
+bool parseShipStat(const std::string& name, ShipStat& out) {
+    for (size_t i = 0; i < SHIP_STAT_COUNT; ++i) {
+        if (name == STAT_NAMES[i]) {
+            out = static_cast<ShipStat>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+ShipStats ShipStats::fromTemplate(const ShipTemplate& tmpl) {
+    ShipStats stats;
+    stats.id = tmpl.id;
+    stats.name = tmpl.name;
+    stats.ship_class = tmpl.ship_class;
+    stats.race = tmpl.race;
+
+    auto set = [&stats](ShipStat stat, float v) { stats.base[static_cast<size_t>(stat)] = v; };
+    set(ShipStat::HullMax, tmpl.hull_hp);
+    set(ShipStat::ArmorMax, tmpl.armor_hp);
+    set(ShipStat::ShieldMax, tmpl.shield_hp);
+    set(ShipStat::ShieldRechargeRate,
+        tmpl.shield_recharge_time > 0.0f ? tmpl.shield_hp / tmpl.shield_recharge_time : 0.0f);
+    set(ShipStat::CapacitorMax, tmpl.capacitor);
+    set(ShipStat::CapacitorRechargeRate,
+        tmpl.capacitor_recharge_time > 0.0f ? tmpl.capacitor / tmpl.capacitor_recharge_time : 0.0f);
+    set(ShipStat::CpuMax, tmpl.cpu);
+    set(ShipStat::PowergridMax, tmpl.powergrid);
+    set(ShipStat::MaxVelocity, tmpl.max_velocity);
+    set(ShipStat::SignatureRadius, tmpl.signature_radius);
+    set(ShipStat::ScanResolution, tmpl.scan_resolution);
+    set(ShipStat::MaxLockedTargets, static_cast<float>(tmpl.max_locked_targets));
+    set(ShipStat::MaxTargetingRange, tmpl.max_targeting_range);
+
+    // Warp parameters are not in the ship JSON yet; use the Ship component defaults
+    components::Ship defaults;
+    set(ShipStat::WarpSpeedAu, defaults.warp_speed_au);
+    set(ShipStat::AlignTime, defaults.align_time);
+    set(ShipStat::WarpStrength, static_cast<float>(defaults.warp_strength));
+
+    set(ShipStat::ShieldEmResist, tmpl.shield_resists.em);
+    set(ShipStat::ShieldThermalResist, tmpl.shield_resists.thermal);
+    set(ShipStat::ShieldKineticResist, tmpl.shield_resists.kinetic);
+    set(ShipStat::ShieldExplosiveResist, tmpl.shield_resists.explosive);
+    set(ShipStat::ArmorEmResist, tmpl.armor_resists.em);
+    set(ShipStat::ArmorThermalResist, tmpl.armor_resists.thermal);
+    set(ShipStat::ArmorKineticResist, tmpl.armor_resists.kinetic);
+    set(ShipStat::ArmorExplosiveResist, tmpl.armor_resists.explosive);
+    set(ShipStat::HullEmResist, tmpl.hull_resists.em);
+    set(ShipStat::HullThermalResist, tmpl.hull_resists.thermal);
+    set(ShipStat::HullKineticResist, tmpl.hull_resists.kinetic);
+    set(ShipStat::HullExplosiveResist, tmpl.hull_resists.explosive);
+    return stats;
+}
+
+// ---------------------------------------------------------------------------
+// Registry
+// ---------------------------------------------------------------------------
+
+ShipTemplateRegistry& ShipTemplateRegistry::shared() {
+    static ShipTemplateRegistry registry;
+    return registry;
+}
+
+const ShipStats* ShipTemplateRegistry::registerTemplate(const ShipTemplate& tmpl) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = by_id_.find(tmpl.id);
+    if (it != by_id_.end()) return it->second;
+
+    records_.push_back(ShipStats::fromTemplate(tmpl));
+    const ShipStats* record = &records_.back();
+    by_id_.emplace(record->id, record);
+    by_name_.emplace(record->name, record);
+    return record;
+}
+
+size_t ShipTemplateRegistry::registerDatabase(const ShipDatabase& db) {
+    size_t before = size();
+    for (const auto& id : db.getShipIds()) {
+        const ShipTemplate* tmpl = db.getShip(id);
+        if (tmpl) registerTemplate(*tmpl);
+    }
+    return size() - before;
+}
+
+const ShipStats* ShipTemplateRegistry::find(const std::string& id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = by_id_.find(id);
+    return it != by_id_.end() ? it->second : nullptr;
+}
+
+const ShipStats* ShipTemplateRegistry::findByName(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = by_name_.find(name);
+    return it != by_name_.end() ? it->second : nullptr;
+}
+
+size_t ShipTemplateRegistry::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return records_.size();
+}
+
+size_t ShipTemplateRegistry::sharedBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t bytes = 0;
+    for (const auto& record : records_) bytes += statsBytes(record);
+    return bytes;
+}
+
+// ---------------------------------------------------------------------------
+// Flyweight accessors
+// ---------------------------------------------------------------------------
+
+float shipStat(const components::ShipTemplateRef& ref, ShipStat stat) {
+    uint8_t key = static_cast<uint8_t>(stat);
+    for (const auto& o : ref.overrides) {
+        if (o.first == key) return o.second;
+    }
+    return ref.stats ? ref.stats->value(stat) : 0.0f;
+}
+
+void setShipStat(components::ShipTemplateRef& ref, ShipStat stat, float value) {
+    if (ref.stats && ref.stats->value(stat) == value) {
+        clearShipStat(ref, stat);
+        return;
+    }
+    uint8_t key = static_cast<uint8_t>(stat);
+    auto it = std::lower_bound(ref.overrides.begin(), ref.overrides.end(), key,
+        [](const std::pair<uint8_t, float>& o, uint8_t k) { return o.first < k; });
+    if (it != ref.overrides.end() && it->first == key) {
+        it->second = value;
+    } else {
+        ref.overrides.insert(it, {key, value});
+    }
+}
+
+void clearShipStat(components::ShipTemplateRef& ref, ShipStat stat) {
+    uint8_t key = static_cast<uint8_t>(stat);
+    ref.overrides.erase(
+        std::remove_if(ref.overrides.begin(), ref.overrides.end(),
+                       [key](const std::pair<uint8_t, float>& o) { return o.first == key; }),
+        ref.overrides.end());
+}
+
+bool entityShipStat(const ecs::Entity& entity, ShipStat stat, float& out) {
+    if (const auto* ship = entity.getComponent<components::Ship>()) {
+        switch (stat) {
+            case ShipStat::CpuMax:            out = ship->cpu_max; return true;
+            case ShipStat::PowergridMax:      out = ship->powergrid_max; return true;
+            case ShipStat::SignatureRadius:   out = ship->signature_radius; return true;
+            case ShipStat::ScanResolution:    out = ship->scan_resolution; return true;
+            case ShipStat::MaxLockedTargets:  out = static_cast<float>(ship->max_locked_targets); return true;
+            case ShipStat::MaxTargetingRange: out = ship->max_targeting_range; return true;
+            case ShipStat::WarpSpeedAu:       out = ship->warp_speed_au; return true;
+            case ShipStat::AlignTime:         out = ship->align_time; return true;
+            case ShipStat::WarpStrength:      out = static_cast<float>(ship->warp_strength); return true;
+            default: break;
+        }
+    }
+    if (const auto* ref = entity.getComponent<components::ShipTemplateRef>()) {
+        if (ref->stats) {
+            out = shipStat(*ref, stat);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string entityShipClass(const ecs::Entity& entity) {
+    if (const auto* ship = entity.getComponent<components::Ship>()) return ship->ship_class;
+    const auto* ref = entity.getComponent<components::ShipTemplateRef>();
+    if (!ref || !ref->stats) return std::string();
+    return ref->ship_class.empty() ? ref->stats->ship_class : ref->ship_class;
+}
+
+void applyTemplateHealth(components::Health& health, const ShipStats& stats) {
+    health.shield_hp = health.shield_max = stats.value(ShipStat::ShieldMax);
+    health.armor_hp  = health.armor_max  = stats.value(ShipStat::ArmorMax);
+    health.hull_hp   = health.hull_max   = stats.value(ShipStat::HullMax);
+    health.shield_recharge_rate    = stats.value(ShipStat::ShieldRechargeRate);
+    health.shield_em_resist        = stats.value(ShipStat::ShieldEmResist);
+    health.shield_thermal_resist   = stats.value(ShipStat::ShieldThermalResist);
+    health.shield_kinetic_resist   = stats.value(ShipStat::ShieldKineticResist);
+    health.shield_explosive_resist = stats.value(ShipStat::ShieldExplosiveResist);
+    health.armor_em_resist         = stats.value(ShipStat::ArmorEmResist);
+    health.armor_thermal_resist    = stats.value(ShipStat::ArmorThermalResist);
+    health.armor_kinetic_resist    = stats.value(ShipStat::ArmorKineticResist);
+    health.armor_explosive_resist  = stats.value(ShipStat::ArmorExplosiveResist);
+    health.hull_em_resist          = stats.value(ShipStat::HullEmResist);
+    health.hull_thermal_resist     = stats.value(ShipStat::HullThermalResist);
+    health.hull_kinetic_resist     = stats.value(ShipStat::HullKineticResist);
+    health.hull_explosive_resist   = stats.value(ShipStat::HullExplosiveResist);
+}
+
+ShipMemoryReport measureShipMemory(const ecs::World& world,
+                                   const ShipTemplateRegistry& registry) {
+    ShipMemoryReport report;
+    // getAllEntities is non-const (existing API limitation)
+    auto entities = const_cast<ecs::World&>(world).getAllEntities();
+    for (const auto* entity : entities) {
+        const auto* ref = entity->getComponent<components::ShipTemplateRef>();
+        if (!ref || !ref->stats) continue;
+        ++report.entities;
+        report.overrides += ref->overrides.size();
+        report.flyweight_bytes += sizeof(components::ShipTemplateRef) +
+            ref->overrides.capacity() * sizeof(std::pair<uint8_t, float>) +
+            stringHeapBytes(ref->ship_class);
+
+        // What a full copy of the same hull costs
+        components::Ship copy;
+        copy.ship_type = ref->stats->name;
+        copy.ship_name = ref->stats->name;
+        copy.ship_class = ref->stats->ship_class;
+        copy.race = ref->stats->race;
+        report.full_copy_bytes += sizeof(components::Ship) +
+            stringHeapBytes(copy.ship_type) + stringHeapBytes(copy.ship_name) +
+            stringHeapBytes(copy.ship_class) + stringHeapBytes(copy.race);
+    }
+    report.shared_bytes = registry.sharedBytes();
+    return report;
+}
+
+} // namespace data
+} // namespace atlas
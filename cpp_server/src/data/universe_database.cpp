@@ -0,0 +1,194 @@
+#include "data/universe_database.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+namespace atlas {
+namespace data {
+
+// ---------------------------------------------------------------------------
+// Public interface
+// ---------------------------------------------------------------------------
+
+int UniverseDatabase::loadFromDirectory(const std::string& data_dir) {
+    int total = loadSystems(data_dir + "/universe/systems.json");
+    std::cout << "[UniverseDatabase] Loaded " << total
+              << " solar systems from " << data_dir << std::endl;
+    return total;
+}
+
+const SolarSystemTemplate* UniverseDatabase::getSystem(const std::string& system_id) const {
+    auto it = systems_.find(system_id);
+    return (it != systems_.end()) ? &it->second : nullptr;
+}
+
+bool UniverseDatabase::hasGate(const std::string& from_system,
+                               const std::string& to_system) const {
+    const SolarSystemTemplate* from = getSystem(from_system);
+    const SolarSystemTemplate* to = getSystem(to_system);
+    if (!from || !to || from == to) return false;
+    return std::find(from->gates.begin(), from->gates.end(), to_system) != from->gates.end() ||
+           std::find(to->gates.begin(), to->gates.end(), from_system) != to->gates.end();
+}
+
+void UniverseDatabase::addSystem(SolarSystemTemplate system) {
+    std::string id = system.id;
+    if (systems_.find(id) == systems_.end()) order_.push_back(id);
+    systems_[id] = std::move(system);
+}
+
+// ---------------------------------------------------------------------------
+// Loader
+// ---------------------------------------------------------------------------
+
+int UniverseDatabase::loadSystems(const std::string& filepath) {
+    std::ifstream ifs(filepath);
+    if (!ifs.is_open()) return 0;
+
+    std::stringstream buf;
+    buf << ifs.rdbuf();
+    std::string content = buf.str();
+
+    int loaded = 0;
+    for (const std::string& block : splitObjects(extractArray(content, "systems"))) {
+        SolarSystemTemplate system;
+        system.id = extractString(block, "id");
+        if (system.id.empty()) continue;
+        system.name     = extractString(block, "name");
+        system.security = extractFloat(block, "security", 1.0f);
+        system.faction  = extractString(block, "faction");
+
+        std::string coords = extractBlock(block, "coordinates");
+        system.x = extractFloat(coords, "x");
+        system.y = extractFloat(coords, "y");
+        system.z = extractFloat(coords, "z");
+
+        system.gates = parseStringArray(extractArray(block, "gates"));
+        for (const std::string& station : splitObjects(extractArray(block, "stations"))) {
+            std::string id = extractString(station, "id");
+            if (!id.empty()) system.station_ids.push_back(id);
+        }
+
+        addSystem(std::move(system));
+        ++loaded;
+    }
+    return loaded;
+}
+
+// ---------------------------------------------------------------------------
+// JSON helpers (same pattern as WormholeDatabase)
+// ---------------------------------------------------------------------------
+
+std::string UniverseDatabase::extractString(const std::string& json, const std::string& key) {
+    std::string search = "\"" + key + "\"";
+    size_t pos = json.find(search);
+    if (pos == std::string::npos) return "";
+    pos = json.find(':', pos + search.size());
+    if (pos == std::string::npos) return "";
+    pos = json.find('\"', pos + 1);
+    if (pos == std::string::npos) return "";
+    size_t end = pos + 1;
+    while (end < json.size()) {
+        if (json[end] == '\\') { end += 2; continue; }
+        if (json[end] == '\"') break;
+        ++end;
+    }
+    if (end >= json.size()) return "";
+    return json.substr(pos + 1, end - pos - 1);
+}
+
+float UniverseDatabase::extractFloat(const std::string& json, const std::string& key, float fallback) {
+    std::string search = "\"" + key + "\"";
+    size_t pos = json.find(search);
+    if (pos == std::string::npos) return fallback;
+    pos = json.find(':', pos + search.size());
+    if (pos == std::string::npos) return fallback;
+    ++pos;
+    while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t' || json[pos] == '\n' || json[pos] == '\r'))
+        ++pos;
+    try {
+        size_t end = pos;
+        while (end < json.size() &&
+               (json[end] == '-' || json[end] == '.' ||
+                (json[end] >= '0' && json[end] <= '9') ||
+                json[end] == 'e' || json[end] == 'E' || json[end] == '+'))
+            ++end;
+        return std::stof(json.substr(pos, end - pos));
+    } catch (...) { return fallback; }
+}
+
+std::string UniverseDatabase::extractBlock(const std::string& json, const std::string& key) {
+    std::string search = "\"" + key + "\"";
+    size_t pos = json.find(search);
+    if (pos == std::string::npos) return "";
+    pos = json.find('{', pos + search.size());
+    if (pos == std::string::npos) return "";
+    int depth = 0; size_t end = pos; bool in_str = false;
+    for (size_t i = pos; i < json.size(); ++i) {
+        char c = json[i];
+        if (c == '\\' && in_str) { ++i; continue; }
+        if (c == '\"') { in_str = !in_str; continue; }
+        if (in_str) continue;
+        if (c == '{') ++depth;
+        if (c == '}') { --depth; if (depth == 0) { end = i; break; } }
+    }
+    return json.substr(pos, end - pos + 1);
+}
+
+std::string UniverseDatabase::extractArray(const std::string& json, const std::string& key) {
+    std::string search = "\"" + key + "\"";
+    size_t pos = json.find(search);
+    if (pos == std::string::npos) return "";
+    pos = json.find('[', pos + search.size());
+    if (pos == std::string::npos) return "";
+    int depth = 0; size_t end = pos;
+    bool in_str = false;
+    for (size_t i = pos; i < json.size(); ++i) {
+        char c = json[i];
+        if (c == '\\' && in_str) { ++i; continue; }
+        if (c == '\"') { in_str = !in_str; continue; }
+        if (in_str) continue;
+        if (c == '[') ++depth;
+        if (c == ']') { --depth; if (depth == 0) { end = i; break; } }
+    }
+    return json.substr(pos, end - pos + 1);
+}
+
+std::vector<std::string> UniverseDatabase::parseStringArray(const std::string& arr) {
+    std::vector<std::string> result;
+    size_t pos = 0;
+    while (pos < arr.size()) {
+        size_t qs = arr.find('\"', pos);
+        if (qs == std::string::npos) break;
+        size_t qe = arr.find('\"', qs + 1);
+        if (qe == std::string::npos) break;
+        result.push_back(arr.substr(qs + 1, qe - qs - 1));
+        pos = qe + 1;
+    }
+    return result;
+}
+
+std::vector<std::string> UniverseDatabase::splitObjects(const std::string& arr) {
+    // Top-level {...} elements of a JSON array
+    std::vector<std::string> objects;
+    int depth = 0;
+    size_t start = 0;
+    bool in_str = false;
+    for (size_t i = 0; i < arr.size(); ++i) {
+        char c = arr[i];
+        if (c == '\\' && in_str) { ++i; continue; }
+        if (c == '\"') { in_str = !in_str; continue; }
+        if (in_str) continue;
+        if (c == '{') {
+            if (depth == 0) start = i;
+            ++depth;
+        } else if (c == '}' && depth > 0) {
+            if (--depth == 0) objects.push_back(arr.substr(start, i - start + 1));
+        }
+    }
+    return objects;
+}
+
+} // namespace data
+} // namespace atlas
@@ -1,5 +1,6 @@
 #include "data/world_persistence.h"
 #include "components/game_components.h"
+#include "data/ship_template_registry.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -39,7 +40,12 @@ static std::string escapeJson(const std::string& input) {
 
 bool WorldPersistence::saveWorld(const ecs::World* world,
                                  const std::string& filepath) {
-    std::string json = serializeWorld(world);
+    return saveWorlds({world}, filepath);
+}
+
+bool WorldPersistence::saveWorlds(const std::vector<const ecs::World*>& worlds,
+                                  const std::string& filepath) {
+    std::string json = serializeWorlds(worlds);
 
     std::ofstream file(filepath);
     if (!file.is_open()) {
@@ -76,18 +82,22 @@ bool WorldPersistence::loadWorld(ecs::World* world,
 // ---------------------------------------------------------------------------
 
 std::string WorldPersistence::serializeWorld(const ecs::World* world) const {
-    // We need a non-const World* to call getAllEntities (existing API limitation)
-    auto* mutable_world = const_cast<ecs::World*>(world);
-    auto entities = mutable_world->getAllEntities();
+    return serializeWorlds({world});
+}
 
+std::string WorldPersistence::serializeWorlds(const std::vector<const ecs::World*>& worlds) const {
     std::ostringstream json;
     json << "{\"entities\":[";
 
     bool first = true;
-    for (const auto* entity : entities) {
-        if (!first) json << ",";
-        first = false;
-        json << serializeEntity(entity);
+    for (const auto* world : worlds) {
+        // We need a non-const World* to call getAllEntities (existing API limitation)
+        auto* mutable_world = const_cast<ecs::World*>(world);
+        for (const auto* entity : mutable_world->getAllEntities()) {
+            if (!first) json << ",";
+            first = false;
+            json << serializeEntity(entity);
+        }
     }
 
     json << "]}";
@@ -218,6 +228,24 @@ std::string WorldPersistence::serializeEntity(
              << "}";
     }
 
+    // Flyweight ship: template id plus only the stats that diverge
+    auto* ship_ref = entity->getComponent<components::ShipTemplateRef>();
+    if (ship_ref && ship_ref->stats) {
+        json << ",\"ship_template\":{"
+             << "\"id\":\"" << escapeJson(ship_ref->stats->id) << "\"";
+        if (!ship_ref->ship_class.empty()) {
+            json << ",\"ship_class\":\"" << escapeJson(ship_ref->ship_class) << "\"";
+        }
+        json << ",\"overrides\":{";
+        bool first = true;
+        for (const auto& o : ship_ref->overrides) {
+            if (!first) json << ",";
+            first = false;
+            json << "\"" << shipStatName(static_cast<ShipStat>(o.first)) << "\":" << o.second;
+        }
+        json << "}}";
+    }
+
     // Faction
     auto* fac = entity->getComponent<components::Faction>();
     if (fac) {
@@ -342,6 +370,14 @@ std::string WorldPersistence::serializeEntity(
              << "}";
     }
 
+    // SystemLocation
+    auto* loc = entity->getComponent<components::SystemLocation>();
+    if (loc) {
+        json << ",\"system_location\":{"
+             << "\"system_id\":\"" << escapeJson(loc->system_id) << "\""
+             << "}";
+    }
+
     // FleetMembership
     auto* fm = entity->getComponent<components::FleetMembership>();
     if (fm) {
@@ -697,6 +733,7 @@ std::string WorldPersistence::serializeEntity(
     if (mh) {
         json << ",\"market_hub\":{"
              << "\"station_id\":\"" << escapeJson(mh->station_id) << "\""
+             << ",\"system_id\":\"" << escapeJson(mh->system_id) << "\""
              << ",\"broker_fee_rate\":" << mh->broker_fee_rate
              << ",\"sales_tax_rate\":" << mh->sales_tax_rate
              << ",\"orders\":[";
@@ -892,6 +929,34 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
         entity->addComponent(std::move(ship));
     }
 
+    // Flyweight ship (resolved against the shared template registry)
+    std::string ship_ref_json = extractObject(json, "ship_template");
+    if (!ship_ref_json.empty()) {
+        const ShipStats* stats = ShipTemplateRegistry::shared().find(
+            extractString(ship_ref_json, "id"));
+        if (stats) {
+            auto ref = std::make_unique<components::ShipTemplateRef>();
+            ref->stats = stats;
+            ref->ship_class = extractString(ship_ref_json, "ship_class");
+            std::string overrides = extractObject(ship_ref_json, "overrides");
+            size_t pos = 0;
+            while ((pos = overrides.find('"', pos)) != std::string::npos) {
+                size_t end = overrides.find('"', pos + 1);
+                if (end == std::string::npos) break;
+                ShipStat stat;
+                std::string name = overrides.substr(pos + 1, end - pos - 1);
+                if (parseShipStat(name, stat)) {
+                    setShipStat(*ref, stat, extractFloat(overrides, "\"" + name + "\":"));
+                }
+                pos = end + 1;
+            }
+            entity->addComponent(std::move(ref));
+        } else {
+            std::cerr << "[WorldPersistence] Unknown ship template for entity "
+                      << entity->getId() << std::endl;
+        }
+    }
+
     // Faction
     std::string fac_json = extractObject(json, "faction");
     if (!fac_json.empty()) {
@@ -1092,6 +1157,14 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
         entity->addComponent(std::move(ss));
     }
 
+    // SystemLocation
+    std::string loc_json = extractObject(json, "system_location");
+    if (!loc_json.empty()) {
+        auto loc = std::make_unique<components::SystemLocation>();
+        loc->system_id = extractString(loc_json, "system_id");
+        entity->addComponent(std::move(loc));
+    }
+
     // FleetMembership
     std::string fm_json = extractObject(json, "fleet_membership");
     if (!fm_json.empty()) {
@@ -1733,6 +1806,7 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
     if (!mh_json.empty()) {
         auto mh = std::make_unique<components::MarketHub>();
         mh->station_id     = extractString(mh_json, "station_id");
+        mh->system_id      = extractString(mh_json, "system_id");
         mh->broker_fee_rate = extractDouble(mh_json, "\"broker_fee_rate\":", 0.02);
         mh->sales_tax_rate  = extractDouble(mh_json, "\"sales_tax_rate\":", 0.04);
 
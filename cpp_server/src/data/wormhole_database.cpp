@@ -45,6 +45,16 @@ std::vector<std::string> WormholeDatabase::getEffectIds() const {
     return ids;
 }
 
+void WormholeDatabase::addWormholeClass(WormholeClassTemplate tmpl) {
+    std::string id = tmpl.id;
+    classes_[id] = std::move(tmpl);
+}
+
+void WormholeDatabase::addEffect(WormholeEffect effect) {
+    std::string id = effect.id;
+    effects_[id] = std::move(effect);
+}
+
 // ---------------------------------------------------------------------------
 // Loaders
 // ---------------------------------------------------------------------------
@@ -0,0 +1,26 @@
+#include "ecs/event_bus.h"
+
+namespace atlas {
+namespace ecs {
+
+void EventBus::publish() {
+    for (auto* stream : order_) {
+        stream->publish();
+    }
+    // Dispatch after every stream has flipped so a handler that reads
+    // another type sees that type's batch for the same tick
+    for (auto* stream : order_) {
+        stream->dispatch();
+    }
+}
+
+size_t EventBus::pendingCount() const {
+    size_t total = 0;
+    for (const auto* stream : order_) {
+        total += stream->pendingCount();
+    }
+    return total;
+}
+
+} // namespace ecs
+} // namespace atlas
@@ -1,4 +1,5 @@
 #include "ecs/world.h"
+#include <chrono>
 #include <iostream>
 
 namespace atlas {
@@ -31,6 +32,26 @@ const Entity* World::getEntity(const std::string& id) const {
     return nullptr;
 }
 
+std::unique_ptr<Entity> World::releaseEntity(const std::string& id) {
+    auto it = entities_.find(id);
+    if (it == entities_.end()) {
+        return nullptr;
+    }
+    std::unique_ptr<Entity> entity = std::move(it->second);
+    entities_.erase(it);
+    return entity;
+}
+
+Entity* World::adoptEntity(std::unique_ptr<Entity> entity) {
+    if (!entity) {
+        return nullptr;
+    }
+    Entity* ptr = entity.get();
+    std::string id = entity->getId();
+    entities_[id] = std::move(entity);
+    return ptr;
+}
+
 std::vector<Entity*> World::getAllEntities() {
     std::vector<Entity*> result;
     result.reserve(entities_.size());
@@ -47,8 +68,37 @@ void World::addSystem(std::unique_ptr<System> system) {
 }
 
 void World::update(float delta_time) {
-    for (auto& system : systems_) {
-        system->update(delta_time);
+    updateSystems(0, systems_.size(), delta_time);
+}
+
+void World::updateSystems(size_t first, size_t last, float delta_time) {
+    last = std::min(last, systems_.size());
+    if (first == 0) events_.publish();
+    if (profiling_) {
+        updateProfiled(first, last, delta_time);
+        return;
+    }
+    for (size_t i = first; i < last; ++i) {
+        systems_[i]->update(delta_time);
+    }
+}
+
+void World::updateProfiled(size_t first, size_t last, float delta_time) {
+    if (profiles_.size() != systems_.size()) {
+        profiles_.resize(systems_.size());
+        for (size_t i = 0; i < systems_.size(); ++i) {
+            profiles_[i].name = systems_[i]->getName();
+        }
+    }
+    for (size_t i = first; i < last; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        systems_[i]->update(delta_time);
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        SystemProfile& profile = profiles_[i];
+        ++profile.calls;
+        profile.total_ms += ms;
+        profile.max_ms = std::max(profile.max_ms, ms);
     }
 }
 
@@ -8,10 +8,23 @@
 #include "systems/anomaly_system.h"
 #include "systems/mission_system.h"
 #include "systems/mission_generator_system.h"
+#include "systems/market_system.h"
+#include "systems/wormhole_system.h"
+#include "systems/background_simulation_system.h"
+#include "cluster/cluster_node.h"
+#include "data/data_bake.h"
+#include "data/ship_template_registry.h"
+#include "data/universe_database.h"
+#include "sim/partition_manager.h"
+#include "sim/replay_log.h"
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <cmath>
 #include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <random>
 
 namespace atlas {
 
@@ -20,7 +33,9 @@ static constexpr float NPC_AWARENESS_RANGE = 50000.0f;
 static constexpr float PLAYER_SPAWN_SPACING_X = 50.0f;
 static constexpr float PLAYER_SPAWN_SPACING_Z = 30.0f;
 static constexpr size_t MAX_CHARACTER_NAME_LEN = 32;
-static constexpr size_t MAX_CHAT_MESSAGE_LEN = 256;
+static constexpr size_t CHAT_JOIN_HISTORY = 20;   // messages replayed on chat_join
+// Ships carry no mass component yet; every jump spends a cruiser-sized budget
+static constexpr double NOMINAL_SHIP_JUMP_MASS = 10000000.0;  // kg
 
 // Escape a string for safe embedding in JSON values
 static std::string escapeJsonString(const std::string& input) {
@@ -45,23 +60,70 @@ static std::string escapeJsonString(const std::string& input) {
     return result;
 }
 
+static std::string destroyEntityMessage(const std::string& entity_id) {
+    return "{\"type\":\"destroy_entity\",\"data\":{\"entity_id\":\"" + entity_id + "\"}}";
+}
+
+// 128 random bits as hex; lets a migrated session resume on the next node once
+static std::string generateResumeToken() {
+    // Straight from the OS entropy source: a seeded generator's output
+    // can be predicted from a few tokens it has already issued
+    std::random_device rd;
+    std::ostringstream token;
+    token << std::hex << std::setfill('0');
+    for (int i = 0; i < 4; ++i) token << std::setw(8) << static_cast<uint32_t>(rd());
+    return token.str();
+}
+
 // ---------------------------------------------------------------------------
 // Construction / Initialization
 // ---------------------------------------------------------------------------
 
 GameSession::GameSession(ecs::World* world, network::TCPServer* tcp_server,
-                         const std::string& data_path)
+                         const std::string& data_path,
+                         const std::string& data_bake_path)
     : world_(world)
     , tcp_server_(tcp_server) {
-    // Load ship data from JSON
-    ship_db_.loadFromDirectory(data_path);
+    // Load ship data from the precompiled bake when one is configured,
+    // falling back to (and rebuilding it from) the JSON sources
+    if (!data_bake_path.empty()) {
+        data::DataBake::load(data_path, data_bake_path, &ship_db_, nullptr, nullptr);
+    } else {
+        ship_db_.loadFromDirectory(data_path);
+    }
+    data::ShipTemplateRegistry::shared().registerDatabase(ship_db_);
+
+    chat_hub_ = std::make_unique<network::ChatHub>(
+        [this](network::ChatMemberId member, const std::string& payload) {
+            tcp_server_->sendToSocket(static_cast<socket_t>(member), payload);
+        },
+        [this](const network::ChatEntry& entry) {
+            return protocol_.createChatMessage(escapeJsonString(entry.sender_name),
+                                               escapeJsonString(entry.text), entry.channel);
+        });
 }
 
 void GameSession::initialize() {
-    // Register the message handler on the TCP server
+    // Client threads only queue what they receive; processIncomingMessages()
+    // applies it on the tick thread
     tcp_server_->setMessageHandler(
         [this](const network::ClientConnection& client, const std::string& raw) {
-            onClientMessage(client, raw);
+            double received_at = std::chrono::duration<double>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            std::lock_guard<std::mutex> lock(incoming_mutex_);
+            incoming_.push_back({client, raw, received_at});
+        }
+    );
+
+    // A dropped connection goes through the same queue as an explicit
+    // disconnect, ahead of anything a new client on the reused fd sends,
+    // and is recorded like one
+    tcp_server_->setDisconnectHandler(
+        [this](const network::ClientConnection& client) {
+            double received_at = std::chrono::duration<double>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            std::lock_guard<std::mutex> lock(incoming_mutex_);
+            incoming_.push_back({client, "{\"type\":\"disconnect\"}", received_at});
         }
     );
 
@@ -79,12 +141,26 @@ void GameSession::initialize() {
 // ---------------------------------------------------------------------------
 
 void GameSession::update(float /*delta_time*/) {
-    // Build a single state-update message and broadcast it to every client
-    std::string state_msg = buildStateUpdate();
+    processPendingMigrations();
+    syncPlayerWorlds();
+    refreshPlayerSystems();
+    sendTimeDilationUpdates();
+    sendDamageEvents();
+    sendPings();
+
+    // Build one state-update message per world and send it to the players
+    // in that world; all worlds share this tick's sequence number
+    uint64_t seq = snapshot_sequence_++;
+    std::unordered_map<ecs::World*, std::string> state_msgs;
 
     std::lock_guard<std::mutex> lock(players_mutex_);
     for (const auto& kv : players_) {
-        tcp_server_->sendToClient(kv.second.connection, state_msg);
+        ecs::World* world = kv.second.world ? kv.second.world : world_;
+        auto it = state_msgs.find(world);
+        if (it == state_msgs.end()) {
+            it = state_msgs.emplace(world, buildStateUpdate(world, seq)).first;
+        }
+        tcp_server_->sendToClient(kv.second.connection, it->second);
     }
 }
 
@@ -97,8 +173,41 @@ int GameSession::getPlayerCount() const {
 // Incoming message dispatch
 // ---------------------------------------------------------------------------
 
+void GameSession::processIncomingMessages() {
+    {
+        std::lock_guard<std::mutex> lock(incoming_mutex_);
+        applying_.swap(incoming_);
+    }
+    if (applying_.empty()) return;
+
+    auto& telemetry = tcp_server_->getTelemetry();
+    for (const auto& message : applying_) {
+        onClientMessage(message.client, message.raw, message.received_at);
+        double now = std::chrono::duration<double>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        telemetry.recordApply(static_cast<int>(message.client.socket), now - message.received_at);
+    }
+    applying_.clear();
+}
+
+void GameSession::replayMessage(int client, const std::string& raw) {
+    network::ClientConnection connection{};
+    connection.socket = static_cast<socket_t>(client);
+    connection.address = "replay";
+    sim::ReplayRecorder* recorder = recorder_;
+    recorder_ = nullptr;
+    double now = std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    onClientMessage(connection, raw, now);
+    recorder_ = recorder;
+}
+
 void GameSession::onClientMessage(const network::ClientConnection& client,
-                                  const std::string& raw) {
+                                  const std::string& raw, double received_at) {
+    if (recorder_) {
+        recorder_->recordCommand(static_cast<int32_t>(client.socket), raw);
+    }
+
     network::MessageType type;
     std::string data;
 
@@ -121,6 +230,12 @@ void GameSession::onClientMessage(const network::ClientConnection& client,
         case network::MessageType::CHAT:
             handleChat(client, data);
             break;
+        case network::MessageType::CHAT_JOIN:
+            handleChatJoin(client, data);
+            break;
+        case network::MessageType::CHAT_LEAVE:
+            handleChatLeave(client, data);
+            break;
         case network::MessageType::TARGET_LOCK:
             handleTargetLock(client, data);
             break;
@@ -175,6 +290,18 @@ void GameSession::onClientMessage(const network::ClientConnection& client,
         case network::MessageType::MISSION_PROGRESS:
             handleMissionProgress(client, data);
             break;
+        case network::MessageType::MARKET_HISTORY:
+            handleMarketHistory(client, data);
+            break;
+        case network::MessageType::WORMHOLE_JUMP:
+            handleWormholeJump(client, data);
+            break;
+        case network::MessageType::GATE_JUMP:
+            handleGateJump(client, data);
+            break;
+        case network::MessageType::PONG:
+            handlePong(client, data, received_at);
+            break;
         default:
             break;
     }
@@ -211,10 +338,37 @@ void GameSession::handleConnect(const network::ClientConnection& client,
         char_name.resize(MAX_CHARACTER_NAME_LEN);
     }
 
-    // Create the player's ship entity in the game world
-    std::string entity_id = createPlayerEntity(player_id, char_name);
+    // A cluster proxy resumes a migrated session by naming the entity that
+    // arrived from another node, with the one-time token the old node sent
+    // in session_redirect, instead of spawning a new ship
+    std::string resume_id = extractJsonString(data, "resume_entity");
+    std::string entity_id;
+    if (!resume_id.empty()) {
+        bool bound = false;
+        {
+            std::lock_guard<std::mutex> lock(players_mutex_);
+            for (const auto& kv : players_) {
+                if (kv.second.entity_id == resume_id) bound = true;
+            }
+        }
+        std::string token = extractJsonString(data, "resume_token");
+        if (bound || !cluster_node_ || !cluster_node_->claimResume(resume_id, token)) {
+            tcp_server_->sendToClient(client,
+                "{\"type\":\"connect_ack\",\"data\":{\"success\":false,"
+                "\"message\":\"Unknown session to resume\"}}");
+            return;
+        }
+        entity_id = resume_id;
+    } else {
+        // Create the player's ship entity in the game world
+        entity_id = createPlayerEntity(player_id, char_name);
+    }
+
+    // The client sees the world holding its ship: with partitioned
+    // simulation, only its own solar system
+    ecs::World* world = systemsFor(entity_id).world;
 
-    // Record the mapping and snapshot other players for notification
+    // Record the mapping and snapshot other players in that world for notification
     std::vector<PlayerInfo> others;
     {
         std::lock_guard<std::mutex> lock(players_mutex_);
@@ -222,10 +376,12 @@ void GameSession::handleConnect(const network::ClientConnection& client,
         info.entity_id      = entity_id;
         info.character_name  = char_name;
         info.connection      = client;
+        info.world           = world;
         players_[static_cast<int>(client.socket)] = info;
+        chat_hub_->setLocalSystem(static_cast<int>(client.socket), systemOf(entity_id));
 
         for (const auto& kv : players_) {
-            if (kv.first != static_cast<int>(client.socket)) {
+            if (kv.first != static_cast<int>(client.socket) && kv.second.world == world) {
                 others.push_back(kv.second);
             }
         }
@@ -234,6 +390,8 @@ void GameSession::handleConnect(const network::ClientConnection& client,
     // Escape char_name for safe JSON embedding
     std::string safe_name = escapeJsonString(char_name);
 
+    tcp_server_->getTelemetry().setPlayer(static_cast<int>(client.socket), char_name, entity_id);
+
     // Send connect_ack with the player's entity id
     std::ostringstream ack;
     ack << "{\"type\":\"connect_ack\","
@@ -245,7 +403,7 @@ void GameSession::handleConnect(const network::ClientConnection& client,
     tcp_server_->sendToClient(client, ack.str());
 
     // Send spawn_entity messages for every existing entity
-    for (auto* entity : world_->getAllEntities()) {
+    for (auto* entity : world->getAllEntities()) {
         std::string spawn_msg = buildSpawnEntity(entity->getId());
         tcp_server_->sendToClient(client, spawn_msg);
     }
@@ -276,15 +434,18 @@ void GameSession::handleDisconnect(const network::ClientConnection& client) {
             players_.erase(it);
         }
     }
+    chat_hub_->removeMember(static_cast<int>(client.socket));
 
     if (!entity_id.empty()) {
-        world_->destroyEntity(entity_id);
+        // The ship may be in a partition, or in flight between two
+        if (partitions_) {
+            partitions_->destroyEntity(entity_id);
+        } else {
+            world_->destroyEntity(entity_id);
+        }
 
         // Tell remaining clients to remove the entity
-        std::ostringstream msg;
-        msg << "{\"type\":\"destroy_entity\","
-            << "\"data\":{\"entity_id\":\"" << entity_id << "\"}}";
-        std::string destroy_msg = msg.str();
+        std::string destroy_msg = destroyEntityMessage(entity_id);
 
         std::lock_guard<std::mutex> lock(players_mutex_);
         for (const auto& kv : players_) {
@@ -307,7 +468,7 @@ void GameSession::handleInputMove(const network::ClientConnection& client,
         entity_id = it->second.entity_id;
     }
 
-    auto* entity = world_->getEntity(entity_id);
+    auto* entity = findEntity(entity_id);
     if (!entity) return;
 
     auto* vel = entity->getComponent<components::Velocity>();
@@ -340,28 +501,191 @@ void GameSession::handleChat(const network::ClientConnection& client,
     }
 
     std::string message = extractJsonString(data, "message");
+    std::string channel = extractJsonString(data, "channel");
+
+    // The hub truncates, rate-limits, serializes once and sends only to
+    // members of the channel ("local" = the sender's solar system)
+    double now = std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    int member = static_cast<int>(client.socket);
+    network::ChatResult result = (channel.empty() || channel == "local")
+        ? chat_hub_->postLocal(member, sender, message, now)
+        : chat_hub_->post(channel, member, sender, message, now);
+
+    switch (result) {
+        case network::ChatResult::RateLimited:
+            tcp_server_->sendToClient(client, protocol_.createError("Chat rate limit exceeded"));
+            break;
+        case network::ChatResult::NotMember:
+            tcp_server_->sendToClient(client, protocol_.createError(
+                "Not a member of chat channel: " + escapeJsonString(channel)));
+            break;
+        case network::ChatResult::UnknownChannel:
+            tcp_server_->sendToClient(client, protocol_.createError(
+                "Unknown chat channel: " + escapeJsonString(channel)));
+            break;
+        default:
+            break;
+    }
+}
+
+void GameSession::handleChatJoin(const network::ClientConnection& client,
+                                 const std::string& data) {
+    {
+        std::lock_guard<std::mutex> lock(players_mutex_);
+        if (players_.find(static_cast<int>(client.socket)) == players_.end()) return;
+    }
+
+    std::string channel = extractJsonString(data, "channel");
+    if (!network::ChatHub::isJoinableChannel(channel)) {
+        tcp_server_->sendToClient(client, protocol_.createChatChannelResult(
+            false, escapeJsonString(channel), "join", 0, "Invalid channel name"));
+        return;
+    }
+
+    bool joined = chat_hub_->join(channel, static_cast<int>(client.socket));
+    int members = static_cast<int>(chat_hub_->memberCount(channel));
+    tcp_server_->sendToClient(client, protocol_.createChatChannelResult(
+        joined, channel, "join", members, joined ? "" : "Already a member"));
+    if (!joined) return;
+
+    for (const auto& entry : chat_hub_->history(channel, CHAT_JOIN_HISTORY)) {
+        tcp_server_->sendToClient(client, *entry->wire);
+    }
+}
+
+void GameSession::handleChatLeave(const network::ClientConnection& client,
+                                  const std::string& data) {
+    std::string channel = extractJsonString(data, "channel");
+    if (!network::ChatHub::isJoinableChannel(channel)) {
+        tcp_server_->sendToClient(client, protocol_.createChatChannelResult(
+            false, escapeJsonString(channel), "leave", 0, "Invalid channel name"));
+        return;
+    }
 
-    // Enforce message length limit
-    if (message.size() > MAX_CHAT_MESSAGE_LEN) {
-        message.resize(MAX_CHAT_MESSAGE_LEN);
+    bool left = chat_hub_->leave(channel, static_cast<int>(client.socket));
+    int members = static_cast<int>(chat_hub_->memberCount(channel));
+    tcp_server_->sendToClient(client, protocol_.createChatChannelResult(
+        left, channel, "leave", members, left ? "" : "Not a member"));
+}
+
+void GameSession::refreshPlayerSystems() {
+    // Keyed on the ship's SystemLocation, so gate and wormhole jumps move
+    // the player's local channel with or without partitions
+    std::lock_guard<std::mutex> lock(players_mutex_);
+    for (const auto& kv : players_) {
+        std::string system_id = systemOf(kv.second.entity_id);
+        chat_hub_->setLocalSystem(kv.first, system_id);
+
+        if (!background_) continue;
+        std::string& observed = observed_systems_[kv.first];
+        if (observed == system_id) continue;
+        if (!observed.empty()) background_->removeObserver(observed);
+        if (!system_id.empty()) background_->addObserver(system_id);
+        observed = system_id;
+    }
+
+    // Disconnected or handed off to another node
+    for (auto it = observed_systems_.begin(); it != observed_systems_.end();) {
+        if (players_.count(it->first)) {
+            ++it;
+            continue;
+        }
+        if (background_ && !it->second.empty()) background_->removeObserver(it->second);
+        it = observed_systems_.erase(it);
     }
+}
+
+// ---------------------------------------------------------------------------
+// World routing
+// ---------------------------------------------------------------------------
+
+void GameSession::setPartitionSystems(const std::string& system_id,
+                                      const SystemSet& systems) {
+    partition_systems_[system_id] = systems;
+}
+
+GameSession::SystemSet GameSession::systemsFor(const std::string& entity_id) const {
+    if (partitions_) {
+        auto it = partition_systems_.find(partitions_->locateEntity(entity_id));
+        if (it != partition_systems_.end()) return it->second;
+    }
+    SystemSet coordinator;
+    coordinator.world     = world_;
+    coordinator.targeting = targeting_system_;
+    coordinator.station   = station_system_;
+    coordinator.movement  = movement_system_;
+    coordinator.combat    = combat_system_;
+    coordinator.wormholes = wormhole_system_;
+    return coordinator;
+}
+
+ecs::Entity* GameSession::findEntity(const std::string& entity_id) {
+    return partitions_ ? partitions_->findEntity(entity_id) : world_->getEntity(entity_id);
+}
 
-    // Escape for safe JSON embedding
-    std::string chat_msg = protocol_.createChatMessage(
-        escapeJsonString(sender), escapeJsonString(message));
+std::string GameSession::systemOf(const std::string& entity_id) {
+    auto* entity = findEntity(entity_id);
+    auto* location = entity ? entity->getComponent<components::SystemLocation>() : nullptr;
+    if (location) return location->system_id;
+    return partitions_ ? partitions_->locateEntity(entity_id) : std::string();
+}
+
+void GameSession::placeInStartingSystem(ecs::Entity* entity) {
+    if (!universe_) return;
+    std::string system_id = universe_->getStartingSystem();
+    if (system_id.empty()) return;
 
-    // Broadcast chat to everyone
-    tcp_server_->broadcastToAll(chat_msg);
+    auto location = std::make_unique<components::SystemLocation>();
+    location->system_id = system_id;
+    entity->addComponent(std::move(location));
+
+    // Ships spawned before partitioning starts are assigned by the server
+    if (partitions_) partitions_->assignEntity(entity->getId(), system_id);
+}
+
+void GameSession::syncPlayerWorlds() {
+    if (!partitions_) return;
+
+    std::lock_guard<std::mutex> lock(players_mutex_);
+    for (auto& kv : players_) {
+        PlayerInfo& info = kv.second;
+        ecs::World* world = systemsFor(info.entity_id).world;
+        // Unchanged, or still waiting in the destination partition's inbox
+        if (world == info.world || !world->getEntity(info.entity_id)) continue;
+        ecs::World* from = info.world;
+        info.world = world;
+
+        // The jumper's client swaps the old system's entities for the new one's
+        if (from) {
+            for (auto* entity : from->getAllEntities()) {
+                tcp_server_->sendToClient(info.connection, destroyEntityMessage(entity->getId()));
+            }
+        }
+        for (auto* entity : world->getAllEntities()) {
+            if (entity->getId() == info.entity_id) continue;
+            tcp_server_->sendToClient(info.connection, buildSpawnEntity(entity->getId()));
+        }
+
+        // Players on either side see the ship leave or arrive
+        std::string destroy_msg = destroyEntityMessage(info.entity_id);
+        std::string spawn_msg = buildSpawnEntity(info.entity_id);
+        for (const auto& other : players_) {
+            if (other.first == kv.first) continue;
+            if (from && other.second.world == from) {
+                tcp_server_->sendToClient(other.second.connection, destroy_msg);
+            } else if (other.second.world == world) {
+                tcp_server_->sendToClient(other.second.connection, spawn_msg);
+            }
+        }
+    }
 }
 
 // ---------------------------------------------------------------------------
 // State broadcast helpers
 // ---------------------------------------------------------------------------
 
-std::string GameSession::buildStateUpdate() const {
-    // Increment snapshot sequence number for packet loss detection
-    uint64_t seq = snapshot_sequence_++;
-    
+std::string GameSession::buildStateUpdate(ecs::World* world, uint64_t seq) const {
     std::ostringstream json;
     json << "{\"type\":\"state_update\",\"data\":{"
          << "\"sequence\":" << seq << ","
@@ -369,7 +693,7 @@ std::string GameSession::buildStateUpdate() const {
                 std::chrono::steady_clock::now().time_since_epoch()).count() << ","
          << "\"entities\":[";
 
-    auto entities = world_->getAllEntities();
+    auto entities = world->getAllEntities();
     bool first = true;
     for (const auto* entity : entities) {
         if (!first) json << ",";
@@ -419,9 +743,13 @@ std::string GameSession::buildStateUpdate() const {
 
         // Ship info (needed for correct model selection on the client)
         auto* ship = entity->getComponent<components::Ship>();
+        auto* ship_ref = entity->getComponent<components::ShipTemplateRef>();
         if (ship) {
             json << ",\"ship_type\":\"" << ship->ship_type << "\"";
             json << ",\"ship_name\":\"" << ship->ship_name << "\"";
+        } else if (ship_ref && ship_ref->stats) {
+            json << ",\"ship_type\":\"" << ship_ref->stats->name << "\"";
+            json << ",\"ship_name\":\"" << ship_ref->stats->name << "\"";
         }
 
         // Faction (needed for correct model coloring on the client)
@@ -437,13 +765,14 @@ std::string GameSession::buildStateUpdate() const {
     return json.str();
 }
 
-std::string GameSession::buildSpawnEntity(const std::string& entity_id) const {
-    auto* entity = world_->getEntity(entity_id);
+std::string GameSession::buildSpawnEntity(const std::string& entity_id) {
+    auto* entity = findEntity(entity_id);
     if (!entity) return "{}";
 
     auto* pos  = entity->getComponent<components::Position>();
     auto* hp   = entity->getComponent<components::Health>();
     auto* ship = entity->getComponent<components::Ship>();
+    auto* ship_ref = entity->getComponent<components::ShipTemplateRef>();
     auto* fac  = entity->getComponent<components::Faction>();
 
     std::ostringstream json;
@@ -477,6 +806,9 @@ std::string GameSession::buildSpawnEntity(const std::string& entity_id) const {
     if (ship) {
         json << ",\"ship_type\":\"" << ship->ship_type << "\"";
         json << ",\"ship_name\":\"" << ship->ship_name << "\"";
+    } else if (ship_ref && ship_ref->stats) {
+        json << ",\"ship_type\":\"" << ship_ref->stats->name << "\"";
+        json << ",\"ship_name\":\"" << ship_ref->stats->name << "\"";
     }
 
     if (fac) {
@@ -587,6 +919,7 @@ std::string GameSession::createPlayerEntity(const std::string& player_id,
     cap->recharge_rate = tmpl ? (tmpl->capacitor / tmpl->capacitor_recharge_time) : 3.0f;
     entity->addComponent(std::move(cap));
 
+    placeInStartingSystem(entity);
     return entity_id;
 }
 
@@ -614,6 +947,11 @@ void GameSession::spawnNPC(const std::string& id, const std::string& name,
     pos->x = x;  pos->y = y;  pos->z = z;
     entity->addComponent(std::move(pos));
 
+    // Hulls known to the template registry are shared rather than copied:
+    // the entity references the immutable record and keeps only its
+    // current HP.  Unknown hulls fall back to a standalone Ship component.
+    const data::ShipStats* stats = data::ShipTemplateRegistry::shared().findByName(ship_name);
+
     auto vel = std::make_unique<components::Velocity>();
     vel->max_speed = 250.0f;
     entity->addComponent(std::move(vel));
@@ -622,13 +960,47 @@ void GameSession::spawnNPC(const std::string& id, const std::string& name,
     hp->shield_hp = hp->shield_max = 300.0f;
     hp->armor_hp  = hp->armor_max  = 250.0f;
     hp->hull_hp   = hp->hull_max   = 200.0f;
-    entity->addComponent(std::move(hp));
 
-    auto ship = std::make_unique<components::Ship>();
-    ship->ship_name  = ship_name;
-    ship->ship_class = "Frigate";
-    ship->ship_type  = ship_name;
-    entity->addComponent(std::move(ship));
+    if (stats) {
+        // NPC balance is fixed rather than per hull: every NPC gets the
+        // pools, speed and handling of a default frigate.  The template
+        // supplies identity only, so pin those values as overrides.
+        auto ref = std::make_unique<components::ShipTemplateRef>();
+        ref->stats = stats;
+        const components::Ship frigate;
+        using data::ShipStat;
+        const std::pair<ShipStat, float> pinned[] = {
+            {ShipStat::ShieldMax, hp->shield_max},
+            {ShipStat::ArmorMax, hp->armor_max},
+            {ShipStat::HullMax, hp->hull_max},
+            {ShipStat::ShieldRechargeRate, hp->shield_recharge_rate},
+            {ShipStat::MaxVelocity, 250.0f},
+            {ShipStat::CpuMax, frigate.cpu_max},
+            {ShipStat::PowergridMax, frigate.powergrid_max},
+            {ShipStat::SignatureRadius, frigate.signature_radius},
+            {ShipStat::ScanResolution, frigate.scan_resolution},
+            {ShipStat::MaxLockedTargets, static_cast<float>(frigate.max_locked_targets)},
+            {ShipStat::MaxTargetingRange, frigate.max_targeting_range},
+            {ShipStat::WarpSpeedAu, frigate.warp_speed_au},
+            {ShipStat::AlignTime, frigate.align_time},
+            {ShipStat::WarpStrength, static_cast<float>(frigate.warp_strength)},
+        };
+        for (const auto& p : pinned) data::setShipStat(*ref, p.first, p.second);
+        // No resists, as the Health component has none
+        for (int r = static_cast<int>(ShipStat::ShieldEmResist);
+             r <= static_cast<int>(ShipStat::HullExplosiveResist); ++r) {
+            data::setShipStat(*ref, static_cast<ShipStat>(r), 0.0f);
+        }
+        if (stats->ship_class != frigate.ship_class) ref->ship_class = frigate.ship_class;
+        entity->addComponent(std::move(ref));
+    } else {
+        auto ship = std::make_unique<components::Ship>();
+        ship->ship_name  = ship_name;
+        ship->ship_class = "Frigate";
+        ship->ship_type  = ship_name;
+        entity->addComponent(std::move(ship));
+    }
+    entity->addComponent(std::move(hp));
 
     auto fac = std::make_unique<components::Faction>();
     fac->faction_name = faction_name;
@@ -665,6 +1037,8 @@ void GameSession::spawnNPC(const std::string& id, const std::string& name,
     weapon->rate_of_fire  = 4.0f;
     entity->addComponent(std::move(weapon));
 
+    placeInStartingSystem(entity);
+
     std::cout << "[GameSession] Spawned NPC: " << name
               << " (" << faction_name << " " << ship_name << ")" << std::endl;
 }
@@ -687,8 +1061,9 @@ void GameSession::handleTargetLock(const network::ClientConnection& client,
     if (target_id.empty()) return;
 
     bool success = false;
-    if (targeting_system_) {
-        success = targeting_system_->startLock(entity_id, target_id);
+    auto* targeting = systemsFor(entity_id).targeting;
+    if (targeting) {
+        success = targeting->startLock(entity_id, target_id);
     }
 
     // Send acknowledgement to the requesting client
@@ -717,8 +1092,9 @@ void GameSession::handleTargetUnlock(const network::ClientConnection& client,
     std::string target_id = extractJsonString(data, "target_id");
     if (target_id.empty()) return;
 
-    if (targeting_system_) {
-        targeting_system_->unlockTarget(entity_id, target_id);
+    auto* targeting = systemsFor(entity_id).targeting;
+    if (targeting) {
+        targeting->unlockTarget(entity_id, target_id);
     }
 
     // Send acknowledgement
@@ -746,7 +1122,8 @@ void GameSession::handleModuleActivate(const network::ClientConnection& client,
     int slot_index = static_cast<int>(extractJsonFloat(data, "\"slot_index\":", -1.0f));
     std::string target_id = extractJsonString(data, "target_id");
 
-    auto* entity = world_->getEntity(entity_id);
+    SystemSet systems = systemsFor(entity_id);
+    auto* entity = systems.world->getEntity(entity_id);
     if (!entity) return;
 
     // For now, module activation triggers the weapon system for high-slot weapons.
@@ -759,8 +1136,8 @@ void GameSession::handleModuleActivate(const network::ClientConnection& client,
         if (weapon->cooldown <= 0.0f && weapon->ammo_count > 0) {
             auto* cap = entity->getComponent<components::Capacitor>();
             if (!cap || cap->capacitor >= weapon->capacitor_cost) {
-                if (combat_system_) {
-                    success = combat_system_->fireWeapon(entity_id, target_id);
+                if (systems.combat) {
+                    success = systems.combat->fireWeapon(entity_id, target_id);
                     if (success && cap) {
                         cap->capacitor -= weapon->capacitor_cost;
                     }
@@ -863,7 +1240,8 @@ void GameSession::handleDockRequest(const network::ClientConnection& client,
         entity_id = it->second.entity_id;
     }
 
-    if (!station_system_) {
+    auto* station_system = systemsFor(entity_id).station;
+    if (!station_system) {
         tcp_server_->sendToClient(client, protocol_.createDockFailed("Station system not available"));
         return;
     }
@@ -874,7 +1252,7 @@ void GameSession::handleDockRequest(const network::ClientConnection& client,
         return;
     }
 
-    bool success = station_system_->dockAtStation(entity_id, station_id);
+    bool success = station_system->dockAtStation(entity_id, station_id);
     if (success) {
         tcp_server_->sendToClient(client, protocol_.createDockSuccess(station_id));
         std::cout << "[GameSession] Player " << entity_id << " docked at " << station_id << std::endl;
@@ -897,12 +1275,13 @@ void GameSession::handleUndockRequest(const network::ClientConnection& client,
         entity_id = it->second.entity_id;
     }
 
-    if (!station_system_) {
+    auto* station_system = systemsFor(entity_id).station;
+    if (!station_system) {
         tcp_server_->sendToClient(client, protocol_.createError("Station system not available"));
         return;
     }
 
-    bool success = station_system_->undockFromStation(entity_id);
+    bool success = station_system->undockFromStation(entity_id);
     if (success) {
         tcp_server_->sendToClient(client, protocol_.createUndockSuccess());
         std::cout << "[GameSession] Player " << entity_id << " undocked" << std::endl;
@@ -925,25 +1304,27 @@ void GameSession::handleRepairRequest(const network::ClientConnection& client,
         entity_id = it->second.entity_id;
     }
 
-    if (!station_system_) {
+    SystemSet systems = systemsFor(entity_id);
+    auto* station_system = systems.station;
+    if (!station_system) {
         tcp_server_->sendToClient(client, protocol_.createError("Station system not available"));
         return;
     }
 
-    auto* entity = world_->getEntity(entity_id);
+    auto* entity = systems.world->getEntity(entity_id);
     if (!entity) {
         tcp_server_->sendToClient(client, protocol_.createError("Entity not found"));
         return;
     }
 
     // Check if player is docked
-    if (!station_system_->isDocked(entity_id)) {
+    if (!station_system->isDocked(entity_id)) {
         tcp_server_->sendToClient(client, protocol_.createError("Must be docked to repair"));
         return;
     }
 
     // Perform repair and get cost
-    double cost = station_system_->repairShip(entity_id);
+    double cost = station_system->repairShip(entity_id);
 
     // Get current HP values after repair
     auto* health = entity->getComponent<components::Health>();
@@ -972,7 +1353,8 @@ void GameSession::handleWarpRequest(const network::ClientConnection& client,
         entity_id = it->second.entity_id;
     }
 
-    if (!movement_system_) {
+    auto* movement = systemsFor(entity_id).movement;
+    if (!movement) {
         tcp_server_->sendToClient(client,
             protocol_.createWarpResult(false, "Movement system not available"));
         return;
@@ -982,13 +1364,13 @@ void GameSession::handleWarpRequest(const network::ClientConnection& client,
     float dest_y = extractJsonFloat(data, "\"dest_y\":");
     float dest_z = extractJsonFloat(data, "\"dest_z\":");
 
-    bool success = movement_system_->commandWarp(entity_id, dest_x, dest_y, dest_z);
+    bool success = movement->commandWarp(entity_id, dest_x, dest_y, dest_z);
     if (success) {
         tcp_server_->sendToClient(client, protocol_.createWarpResult(true));
         std::cout << "[GameSession] Player " << entity_id << " warping to ("
                   << dest_x << ", " << dest_y << ", " << dest_z << ")" << std::endl;
     } else {
-        std::string reason = movement_system_->isWarpDisrupted(entity_id)
+        std::string reason = movement->isWarpDisrupted(entity_id)
                                  ? "Warp drive disrupted"
                                  : "Destination too close (min 150km)";
         tcp_server_->sendToClient(client, protocol_.createWarpResult(false, reason));
@@ -1009,7 +1391,8 @@ void GameSession::handleApproach(const network::ClientConnection& client,
         entity_id = it->second.entity_id;
     }
 
-    if (!movement_system_) {
+    auto* movement = systemsFor(entity_id).movement;
+    if (!movement) {
         tcp_server_->sendToClient(client, protocol_.createMovementAck("approach", false));
         return;
     }
@@ -1020,7 +1403,7 @@ void GameSession::handleApproach(const network::ClientConnection& client,
         return;
     }
 
-    movement_system_->commandApproach(entity_id, target_id);
+    movement->commandApproach(entity_id, target_id);
     tcp_server_->sendToClient(client, protocol_.createMovementAck("approach", true));
 }
 
@@ -1038,7 +1421,8 @@ void GameSession::handleOrbit(const network::ClientConnection& client,
         entity_id = it->second.entity_id;
     }
 
-    if (!movement_system_) {
+    auto* movement = systemsFor(entity_id).movement;
+    if (!movement) {
         tcp_server_->sendToClient(client, protocol_.createMovementAck("orbit", false));
         return;
     }
@@ -1050,7 +1434,7 @@ void GameSession::handleOrbit(const network::ClientConnection& client,
         return;
     }
 
-    movement_system_->commandOrbit(entity_id, target_id, distance);
+    movement->commandOrbit(entity_id, target_id, distance);
     tcp_server_->sendToClient(client, protocol_.createMovementAck("orbit", true));
 }
 
@@ -1068,12 +1452,13 @@ void GameSession::handleStop(const network::ClientConnection& client,
         entity_id = it->second.entity_id;
     }
 
-    if (!movement_system_) {
+    auto* movement = systemsFor(entity_id).movement;
+    if (!movement) {
         tcp_server_->sendToClient(client, protocol_.createMovementAck("stop", false));
         return;
     }
 
-    movement_system_->commandStop(entity_id);
+    movement->commandStop(entity_id);
     tcp_server_->sendToClient(client, protocol_.createMovementAck("stop", true));
 }
 
@@ -1332,4 +1717,347 @@ void GameSession::handleMissionProgress(const network::ClientConnection& client,
         protocol_.createMissionResult(true, mission_id, "progress", "Progress recorded"));
 }
 
+// ---------------------------------------------------------------------------
+// MARKET HISTORY handler
+// ---------------------------------------------------------------------------
+
+void GameSession::handleMarketHistory(const network::ClientConnection& client,
+                                      const std::string& data) {
+    if (!market_system_) {
+        tcp_server_->sendToClient(client, protocol_.createError("Market system not available"));
+        return;
+    }
+
+    std::string station_id = extractJsonString(data, "station_id");
+    std::string item_id = extractJsonString(data, "item_id");
+    if (station_id.empty() || item_id.empty()) {
+        tcp_server_->sendToClient(client, protocol_.createError("Missing station_id or item_id"));
+        return;
+    }
+
+    std::string res_str = extractJsonString(data, "resolution");
+    if (res_str.empty()) res_str = "1h";
+    data::MarketHistory::Resolution res;
+    if (!data::MarketHistory::parseResolution(res_str, res)) {
+        tcp_server_->sendToClient(client, protocol_.createError("Unknown resolution: " +
+                                                                escapeJsonString(res_str)));
+        return;
+    }
+
+    int count = static_cast<int>(extractJsonFloat(data, "count", 24.0f));
+    count = std::max(1, std::min(count, static_cast<int>(data::MarketHistory::bucketCapacity(res))));
+
+    auto buckets = market_system_->getHistory().latest(station_id, item_id, res, count);
+
+    std::ostringstream buckets_json;
+    buckets_json << "[";
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        if (i > 0) buckets_json << ",";
+        const auto& b = buckets[i];
+        buckets_json << "{\"t\":" << b.start_time << ","
+                     << "\"open\":" << b.open << ","
+                     << "\"high\":" << b.high << ","
+                     << "\"low\":" << b.low << ","
+                     << "\"close\":" << b.close << ","
+                     << "\"volume\":" << b.volume << ","
+                     << "\"trades\":" << b.trade_count << "}";
+    }
+    buckets_json << "]";
+
+    tcp_server_->sendToClient(client,
+        protocol_.createMarketHistory(escapeJsonString(station_id), escapeJsonString(item_id),
+                                      res_str, static_cast<int>(buckets.size()),
+                                      buckets_json.str()));
+}
+
+// ---------------------------------------------------------------------------
+// WORMHOLE_JUMP handler / cluster migration
+// ---------------------------------------------------------------------------
+
+void GameSession::handleWormholeJump(const network::ClientConnection& client,
+                                     const std::string& data) {
+    std::string entity_id;
+    {
+        std::lock_guard<std::mutex> lock(players_mutex_);
+        auto it = players_.find(static_cast<int>(client.socket));
+        if (it == players_.end()) return;
+        entity_id = it->second.entity_id;
+    }
+
+    std::string wormhole_id = extractJsonString(data, "wormhole_id");
+    SystemSet systems = systemsFor(entity_id);
+    if (!systems.wormholes) {
+        tcp_server_->sendToClient(client, protocol_.createWormholeJumpResult(
+            false, escapeJsonString(wormhole_id), "", "Wormhole system not available"));
+        return;
+    }
+
+    // Only wormholes in the ship's own system can be entered
+    auto* wh_entity = systems.world->getEntity(wormhole_id);
+    auto* wh = wh_entity ? wh_entity->getComponent<components::WormholeConnection>() : nullptr;
+    if (!wh) {
+        tcp_server_->sendToClient(client, protocol_.createWormholeJumpResult(
+            false, escapeJsonString(wormhole_id), "", "Unknown wormhole"));
+        return;
+    }
+
+    // Triggers the handoff callback, which queues the cross-system move
+    std::string destination = wh->destination_system;
+    if (!systems.wormholes->jumpShipThroughWormhole(wormhole_id, entity_id,
+                                                    NOMINAL_SHIP_JUMP_MASS)) {
+        tcp_server_->sendToClient(client, protocol_.createWormholeJumpResult(
+            false, wormhole_id, destination, "Wormhole collapsed or mass limit exceeded"));
+        return;
+    }
+
+    auto* ship = systems.world->getEntity(entity_id);
+    auto* location = ship ? ship->getComponent<components::SystemLocation>() : nullptr;
+    if (location) location->system_id = destination;
+
+    tcp_server_->sendToClient(client,
+        protocol_.createWormholeJumpResult(true, wormhole_id, destination));
+    std::cout << "[GameSession] " << entity_id << " jumped through " << wormhole_id
+              << " to " << destination << std::endl;
+}
+
+// ---------------------------------------------------------------------------
+// GATE_JUMP handler
+// ---------------------------------------------------------------------------
+
+void GameSession::handleGateJump(const network::ClientConnection& client,
+                                 const std::string& data) {
+    std::string entity_id;
+    {
+        std::lock_guard<std::mutex> lock(players_mutex_);
+        auto it = players_.find(static_cast<int>(client.socket));
+        if (it == players_.end()) return;
+        entity_id = it->second.entity_id;
+    }
+
+    std::string destination = extractJsonString(data, "destination");
+    SystemSet systems = systemsFor(entity_id);
+    auto* ship = systems.world->getEntity(entity_id);
+    if (!ship) {
+        // Routed last tick and not yet adopted by its new partition
+        tcp_server_->sendToClient(client, protocol_.createGateJumpResult(
+            false, escapeJsonString(destination), "Jump already in progress"));
+        return;
+    }
+
+    auto* location = ship->getComponent<components::SystemLocation>();
+    if (!location || !universe_ || !universe_->hasGate(location->system_id, destination)) {
+        tcp_server_->sendToClient(client, protocol_.createGateJumpResult(
+            false, escapeJsonString(destination), "No stargate to that system"));
+        return;
+    }
+    if (partitions_ && !partitions_->getPartition(destination)) {
+        tcp_server_->sendToClient(client, protocol_.createGateJumpResult(
+            false, destination, "Destination system is not simulated"));
+        return;
+    }
+    if (systems.station && systems.station->isDocked(entity_id)) {
+        tcp_server_->sendToClient(client, protocol_.createGateJumpResult(
+            false, destination, "Cannot jump while docked"));
+        return;
+    }
+
+    std::string origin = location->system_id;
+    location->system_id = destination;
+    if (partitions_) {
+        // Moves at the end of the next tick; syncPlayerWorlds() follows it
+        partitions_->requestHandoff(entity_id, destination, sim::HandoffKind::Gate);
+    } else if (cluster_node_) {
+        requestMigration(entity_id, destination);
+    }
+
+    tcp_server_->sendToClient(client, protocol_.createGateJumpResult(true, destination));
+    std::cout << "[GameSession] " << entity_id << " jumped from " << origin
+              << " to " << destination << std::endl;
+}
+
+void GameSession::setClusterNode(cluster::ClusterNode* node) {
+    cluster_node_ = node;
+    if (cluster_node_) {
+        cluster_node_->setMigrationCallback(
+            [this](const std::string& entity_id, const std::string& to_node, bool ok) {
+                onEntityMigrated(entity_id, to_node, ok);
+            });
+    }
+}
+
+void GameSession::requestMigration(const std::string& entity_id,
+                                   const std::string& to_system) {
+    std::lock_guard<std::mutex> lock(migrations_mutex_);
+    pending_migrations_.emplace_back(entity_id, to_system);
+}
+
+void GameSession::processPendingMigrations() {
+    std::vector<std::pair<std::string, std::string>> pending;
+    {
+        std::lock_guard<std::mutex> lock(migrations_mutex_);
+        pending.swap(pending_migrations_);
+    }
+    if (!cluster_node_) return;
+
+    for (const auto& move : pending) {
+        const std::string& entity_id = move.first;
+        const std::string& system_id = move.second;
+        // Systems simulated by this node need no transfer
+        if (cluster_node_->ownsSystem(system_id)) continue;
+
+        std::string token = generateResumeToken();
+        if (cluster_node_->migrateEntity(entity_id, system_id, token)) {
+            migrating_[entity_id] = Migration{system_id, token};
+        } else {
+            onEntityMigrated(entity_id, "", false);
+        }
+    }
+}
+
+void GameSession::onEntityMigrated(const std::string& entity_id,
+                                   const std::string& to_node, bool ok) {
+    Migration migration;
+    auto mit = migrating_.find(entity_id);
+    if (mit != migrating_.end()) {
+        migration = mit->second;
+        migrating_.erase(mit);
+    }
+
+    network::ClientConnection connection;
+    bool found = false;
+    std::vector<network::ClientConnection> others;
+    {
+        std::lock_guard<std::mutex> lock(players_mutex_);
+        for (auto it = players_.begin(); it != players_.end(); ++it) {
+            if (it->second.entity_id != entity_id) continue;
+            connection = it->second.connection;
+            found = true;
+            // The session follows the ship to its new node
+            if (ok) players_.erase(it);
+            break;
+        }
+        if (ok) {
+            for (const auto& kv : players_) others.push_back(kv.second.connection);
+        }
+    }
+
+    if (!ok) {
+        if (found) {
+            tcp_server_->sendToClient(connection,
+                protocol_.createError("Jump failed: destination node unavailable"));
+        }
+        return;
+    }
+
+    if (found) {
+        tcp_server_->sendToClient(connection,
+            protocol_.createSessionRedirect(entity_id, to_node, migration.system_id,
+                                            migration.resume_token));
+    }
+
+    std::string destroy_msg = destroyEntityMessage(entity_id);
+    for (const auto& other : others) {
+        tcp_server_->sendToClient(other, destroy_msg);
+    }
+
+    std::cout << "[GameSession] " << entity_id << " handed over to node " << to_node
+              << std::endl;
+}
+
+// ---------------------------------------------------------------------------
+// Damage events
+// ---------------------------------------------------------------------------
+
+void GameSession::sendDamageEvents() {
+    // Each world resolves its own combat; damage goes to the players in it
+    std::vector<SystemSet> worlds;
+    worlds.push_back(systemsFor(""));
+    for (const auto& kv : partition_systems_) worlds.push_back(kv.second);
+
+    for (const auto& set : worlds) {
+        if (!set.combat) continue;
+        const auto& pipeline = set.combat->getDamagePipeline();
+        uint64_t& flushed = last_damage_flush_[set.combat];
+        if (pipeline.getFlushCount() == flushed) continue;
+        flushed = pipeline.getFlushCount();
+
+        const auto& resolved = pipeline.getLastResults();
+        if (resolved.empty()) continue;
+
+        std::vector<std::string> messages;
+        messages.reserve(resolved.size());
+        for (const auto& dmg : resolved) {
+            messages.push_back(protocol_.createDamageEvent(
+                dmg.target_id, dmg.damage, dmg.damage_type, dmg.layer_hit,
+                dmg.shield_depleted, dmg.armor_depleted, dmg.hull_critical));
+        }
+
+        std::lock_guard<std::mutex> lock(players_mutex_);
+        for (const auto& kv : players_) {
+            if (kv.second.world != set.world) continue;
+            for (const auto& msg : messages) {
+                tcp_server_->sendToClient(kv.second.connection, msg);
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Time dilation
+// ---------------------------------------------------------------------------
+
+void GameSession::sendTimeDilationUpdates() {
+    if (!partitions_ && !world_dilation_) return;
+
+    std::lock_guard<std::mutex> lock(players_mutex_);
+    for (auto& kv : players_) {
+        PlayerInfo& info = kv.second;
+        float factor = 1.0f;
+        if (partitions_) {
+            auto* partition = partitions_->getPartition(partitions_->locateEntity(info.entity_id));
+            if (partition) factor = partition->getDilationFactor();
+        } else {
+            factor = world_dilation_->getFactor();
+        }
+
+        if (std::fabs(factor - info.time_dilation) < 0.01f &&
+            !(factor >= 1.0f && info.time_dilation < 1.0f)) {
+            continue;
+        }
+        info.time_dilation = factor;
+        tcp_server_->sendToClient(info.connection,
+                                  protocol_.createTimeDilation(systemOf(info.entity_id), factor));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Connection telemetry
+// ---------------------------------------------------------------------------
+
+void GameSession::sendPings() {
+    if (ping_interval_ <= 0.0) return;
+    double now = std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (last_ping_ >= 0.0 && now - last_ping_ < ping_interval_) return;
+    last_ping_ = now;
+
+    auto& telemetry = tcp_server_->getTelemetry();
+    std::lock_guard<std::mutex> lock(players_mutex_);
+    for (const auto& kv : players_) {
+        uint64_t nonce = telemetry.recordPingSent(kv.first, now);
+        if (nonce != 0) {
+            tcp_server_->sendToClient(kv.second.connection, protocol_.createPing(nonce));
+        }
+    }
+}
+
+void GameSession::handlePong(const network::ClientConnection& client,
+                             const std::string& data, double received_at) {
+    // Nonces are integers that outgrow a float's precision
+    size_t pos = data.find("\"nonce\":");
+    if (pos == std::string::npos) return;
+    uint64_t nonce = std::strtoull(data.c_str() + pos + 8, nullptr, 10);
+    tcp_server_->getTelemetry().recordPong(static_cast<int>(client.socket), nonce, received_at);
+}
+
 } // namespace atlas
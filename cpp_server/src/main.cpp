@@ -1,11 +1,16 @@
 #include "server.h"
+#include "cluster/cluster_proxy.h"
 #include "utils/logger.h"
 #include <iostream>
 #include <csignal>
 #include <memory>
 #include <exception>
+#include <atomic>
+#include <thread>
+#include <chrono>
 
 static std::unique_ptr<atlas::Server> g_server;
+static std::atomic<bool> g_proxy_running{false};
 
 void signalHandler(int signal) {
     const char* name = (signal == SIGINT)  ? "SIGINT"  :
@@ -15,9 +20,44 @@ void signalHandler(int signal) {
     if (g_server) {
         g_server->stop();
     }
+    g_proxy_running = false;
+}
+
+// Cluster front end: no world of its own, only routes client sessions to nodes
+static int runProxy(const atlas::ServerConfig& config) {
+    auto& log = atlas::utils::Logger::instance();
+    log.init(config.log_path);
+
+    atlas::cluster::ClusterTopology topology;
+    if (!topology.parse(config.cluster_topology) || topology.empty()) {
+        log.fatal("Proxy mode requires a valid cluster_topology");
+        return 1;
+    }
+
+    atlas::cluster::ClusterProxy proxy(topology, config.host, config.port,
+                                       config.max_connections);
+    if (!proxy.start()) {
+        log.fatal("Failed to start cluster proxy");
+        return 1;
+    }
+
+    g_proxy_running = true;
+    while (g_proxy_running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    proxy.stop();
+    log.shutdown();
+    return 0;
 }
 
 int main(int argc, char* argv[]) {
+    // Headless replay of a session recording:
+    //   atlas_dedicated_server --replay <recording> [config]
+    if (argc > 2 && std::string(argv[1]) == "--replay") {
+        atlas::Server server(argc > 3 ? argv[3] : "config/server.json");
+        return server.replay(argv[2]);
+    }
+
     // Parse command line arguments
     std::string config_path = "config/server.json";
     if (argc > 1) {
@@ -29,6 +69,11 @@ int main(int argc, char* argv[]) {
     std::signal(SIGTERM, signalHandler);
     
     try {
+        atlas::ServerConfig config;
+        if (config.loadFromFile(config_path) && config.cluster_role == "proxy") {
+            return runProxy(config);
+        }
+
         // Create and initialize server
         g_server = std::make_unique<atlas::Server>(config_path);
         
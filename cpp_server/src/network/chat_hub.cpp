@@ -0,0 +1,244 @@
+#include "network/chat_hub.h"
+#include <algorithm>
+
+namespace atlas {
+namespace network {
+
+// ---------------------------------------------------------------------------
+// ChatHistory
+// ---------------------------------------------------------------------------
+
+ChatHistory::ChatHistory(size_t capacity)
+    : slots_(std::max<size_t>(capacity, 1)) {
+}
+
+void ChatHistory::push(std::shared_ptr<const ChatEntry> entry) {
+    slots_[head_] = std::move(entry);
+    head_ = (head_ + 1) % slots_.size();
+    if (size_ < slots_.size()) ++size_;
+}
+
+const ChatEntry& ChatHistory::at(size_t index) const {
+    size_t oldest = (head_ + slots_.size() - size_) % slots_.size();
+    return *slots_[(oldest + index) % slots_.size()];
+}
+
+std::vector<std::shared_ptr<const ChatEntry>> ChatHistory::recent(size_t count) const {
+    count = std::min(count, size_);
+    std::vector<std::shared_ptr<const ChatEntry>> out;
+    out.reserve(count);
+    size_t start = (head_ + slots_.size() - count) % slots_.size();
+    for (size_t i = 0; i < count; ++i) {
+        out.push_back(slots_[(start + i) % slots_.size()]);
+    }
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// ChatHub
+// ---------------------------------------------------------------------------
+
+ChatHub::ChatHub(SendFunction send, Serializer serialize, const ChatHubConfig& config)
+    : send_(std::move(send))
+    , serialize_(std::move(serialize))
+    , config_(config) {
+}
+
+ChatHub::ChatHub(SendFunction send, Serializer serialize)
+    : ChatHub(std::move(send), std::move(serialize), ChatHubConfig()) {
+}
+
+std::string ChatHub::localChannel(const std::string& system_id) {
+    return system_id.empty() ? std::string("local") : "local:" + system_id;
+}
+
+bool ChatHub::isJoinableChannel(const std::string& channel) {
+    if (channel.empty() || channel.size() > 32) return false;
+    if (channel == "local" || channel.compare(0, 6, "local:") == 0) return false;
+    return std::all_of(channel.begin(), channel.end(), [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+               (c >= '0' && c <= '9') || c == '_' || c == '-';
+    });
+}
+
+ChatHub::Channel& ChatHub::channelLocked(const std::string& name) {
+    auto it = channels_.find(name);
+    if (it == channels_.end()) {
+        it = channels_.emplace(name, Channel(config_.history_capacity)).first;
+    }
+    return it->second;
+}
+
+bool ChatHub::joinLocked(const std::string& channel, ChatMemberId member) {
+    Channel& ch = channelLocked(channel);
+    if (!ch.members.insert(member).second) return false;
+    ch.snapshot.reset();
+    memberships_[member].push_back(channel);
+    return true;
+}
+
+bool ChatHub::leaveLocked(const std::string& channel, ChatMemberId member) {
+    auto it = channels_.find(channel);
+    if (it == channels_.end() || it->second.members.erase(member) == 0) return false;
+    it->second.snapshot.reset();
+
+    auto mit = memberships_.find(member);
+    if (mit != memberships_.end()) {
+        auto& list = mit->second;
+        list.erase(std::remove(list.begin(), list.end(), channel), list.end());
+        if (list.empty()) memberships_.erase(mit);
+    }
+    return true;
+}
+
+bool ChatHub::join(const std::string& channel, ChatMemberId member) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return joinLocked(channel, member);
+}
+
+bool ChatHub::leave(const std::string& channel, ChatMemberId member) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return leaveLocked(channel, member);
+}
+
+void ChatHub::removeMember(ChatMemberId member) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto mit = memberships_.find(member);
+    if (mit != memberships_.end()) {
+        std::vector<std::string> channels = mit->second;
+        for (const auto& channel : channels) leaveLocked(channel, member);
+    }
+    local_channel_.erase(member);
+    buckets_.erase(member);
+}
+
+void ChatHub::setLocalSystem(ChatMemberId member, const std::string& system_id) {
+    std::string channel = localChannel(system_id);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = local_channel_.find(member);
+    if (it != local_channel_.end()) {
+        if (it->second == channel) return;
+        leaveLocked(it->second, member);
+    }
+    joinLocked(channel, member);
+    local_channel_[member] = channel;
+}
+
+std::string ChatHub::localChannelOf(ChatMemberId member) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = local_channel_.find(member);
+    return it != local_channel_.end() ? it->second : std::string();
+}
+
+bool ChatHub::consumeTokenLocked(ChatMemberId member, double now) {
+    auto it = buckets_.find(member);
+    if (it == buckets_.end()) {
+        it = buckets_.emplace(member, Bucket{config_.rate_limit_burst, now}).first;
+    }
+    Bucket& bucket = it->second;
+    double elapsed = std::max(0.0, now - bucket.last);
+    bucket.tokens = std::min(config_.rate_limit_burst,
+                             bucket.tokens + elapsed * config_.rate_limit_per_second);
+    bucket.last = now;
+    if (bucket.tokens < 1.0) return false;
+    bucket.tokens -= 1.0;
+    return true;
+}
+
+ChatResult ChatHub::post(const std::string& channel, ChatMemberId sender,
+                         const std::string& sender_name, const std::string& text,
+                         double now) {
+    std::shared_ptr<const std::vector<ChatMemberId>> recipients;
+    std::shared_ptr<const std::string> wire;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (text.empty()) {
+            ++stats_.rejected;
+            return ChatResult::Empty;
+        }
+        auto it = channels_.find(channel);
+        if (it == channels_.end()) {
+            ++stats_.rejected;
+            return ChatResult::UnknownChannel;
+        }
+        Channel& ch = it->second;
+        if (ch.members.count(sender) == 0) {
+            ++stats_.rejected;
+            return ChatResult::NotMember;
+        }
+        if (!consumeTokenLocked(sender, now)) {
+            ++stats_.rate_limited;
+            return ChatResult::RateLimited;
+        }
+
+        auto entry = std::make_shared<ChatEntry>();
+        entry->sequence = next_sequence_++;
+        entry->channel = channel;
+        entry->sender = sender;
+        entry->sender_name = sender_name;
+        entry->text = text.size() > config_.max_message_length
+                    ? text.substr(0, config_.max_message_length) : text;
+        entry->wire = std::make_shared<const std::string>(serialize_(*entry));
+        ++stats_.serialized;
+        wire = entry->wire;
+        ch.history.push(std::move(entry));
+
+        if (!ch.snapshot) {
+            ch.snapshot = std::make_shared<const std::vector<ChatMemberId>>(
+                ch.members.begin(), ch.members.end());
+        }
+        recipients = ch.snapshot;
+        ++stats_.posted;
+        stats_.delivered += recipients->size();
+    }
+
+    // Fan out without holding the hub lock; every send shares one buffer
+    for (ChatMemberId member : *recipients) {
+        send_(member, *wire);
+    }
+    return ChatResult::Delivered;
+}
+
+ChatResult ChatHub::postLocal(ChatMemberId sender, const std::string& sender_name,
+                              const std::string& text, double now) {
+    std::string channel = localChannelOf(sender);
+    if (channel.empty()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.rejected;
+        return ChatResult::NotMember;
+    }
+    return post(channel, sender, sender_name, text, now);
+}
+
+size_t ChatHub::memberCount(const std::string& channel) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = channels_.find(channel);
+    return it != channels_.end() ? it->second.members.size() : 0;
+}
+
+bool ChatHub::isMember(const std::string& channel, ChatMemberId member) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = channels_.find(channel);
+    return it != channels_.end() && it->second.members.count(member) > 0;
+}
+
+size_t ChatHub::channelCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return channels_.size();
+}
+
+std::vector<std::shared_ptr<const ChatEntry>> ChatHub::history(const std::string& channel,
+                                                               size_t count) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = channels_.find(channel);
+    if (it == channels_.end()) return {};
+    return it->second.history.recent(count);
+}
+
+ChatHub::Stats ChatHub::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+} // namespace network
+} // namespace atlas
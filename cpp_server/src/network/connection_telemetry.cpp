@@ -0,0 +1,375 @@
+#include "network/connection_telemetry.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace atlas {
+namespace network {
+
+const double LatencyHistogram::UPPER_BOUNDS[LatencyHistogram::BOUNDS] = {
+    0.00005, 0.0001, 0.00025, 0.0005,
+    0.001, 0.0025, 0.005, 0.01,
+    0.025, 0.05, 0.1, 0.25,
+    0.5, 1.0, 2.5, 5.0
+};
+
+void LatencyHistogram::record(double seconds) {
+    if (seconds < 0.0) seconds = 0.0;
+    size_t bucket = static_cast<size_t>(
+        std::lower_bound(UPPER_BOUNDS, UPPER_BOUNDS + BOUNDS, seconds) - UPPER_BOUNDS);
+    ++buckets[bucket];
+    ++count;
+    sum += seconds;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i <= BOUNDS; ++i) buckets[i] += other.buckets[i];
+    count += other.count;
+    sum += other.sum;
+}
+
+double LatencyHistogram::quantile(double q) const {
+    if (count == 0) return 0.0;
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count));
+    if (rank >= count) rank = count - 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BOUNDS; ++i) {
+        seen += buckets[i];
+        if (seen > rank) return UPPER_BOUNDS[i];
+    }
+    return UPPER_BOUNDS[BOUNDS - 1];   // overflow: report the last finite bound
+}
+
+// ---------------------------------------------------------------------------
+// Recording
+// ---------------------------------------------------------------------------
+
+void ConnectionTelemetry::onConnect(int socket, const std::string& address, double now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry entry;
+    entry.stats.socket = socket;
+    entry.stats.address = address;
+    entry.stats.connected_at = now;
+    connections_[socket] = std::move(entry);
+    ++total_connections_;
+}
+
+void ConnectionTelemetry::onDisconnect(int socket) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    connections_.erase(socket);
+}
+
+void ConnectionTelemetry::setPlayer(int socket, const std::string& player_name,
+                                    const std::string& entity_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = connections_.find(socket);
+    if (it == connections_.end()) return;
+    it->second.stats.player_name = player_name;
+    it->second.stats.entity_id = entity_id;
+}
+
+void ConnectionTelemetry::recordMessageIn(int socket, size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    total_bytes_in_ += bytes;
+    ++total_messages_in_;
+    auto it = connections_.find(socket);
+    if (it == connections_.end()) return;
+    it->second.stats.bytes_in += bytes;
+    ++it->second.stats.messages_in;
+}
+
+void ConnectionTelemetry::recordMessageOut(int socket, size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    total_bytes_out_ += bytes;
+    ++total_messages_out_;
+    auto it = connections_.find(socket);
+    if (it == connections_.end()) return;
+    it->second.stats.bytes_out += bytes;
+    ++it->second.stats.messages_out;
+}
+
+void ConnectionTelemetry::recordSendFailure(int socket) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++total_send_failures_;
+    auto it = connections_.find(socket);
+    if (it != connections_.end()) ++it->second.stats.send_failures;
+}
+
+void ConnectionTelemetry::recordApply(int socket, double seconds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    apply_total_.record(seconds);
+    auto it = connections_.find(socket);
+    if (it != connections_.end()) it->second.stats.apply.record(seconds);
+}
+
+uint64_t ConnectionTelemetry::recordPingSent(int socket, double now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = connections_.find(socket);
+    if (it == connections_.end()) return 0;
+    // An unanswered earlier ping is simply superseded
+    it->second.ping_nonce = next_nonce_++;
+    it->second.ping_sent_at = now;
+    return it->second.ping_nonce;
+}
+
+bool ConnectionTelemetry::recordPong(int socket, uint64_t nonce, double now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = connections_.find(socket);
+    if (it == connections_.end()) return false;
+    Entry& entry = it->second;
+    if (nonce == 0 || nonce != entry.ping_nonce) return false;
+    entry.ping_nonce = 0;
+
+    double rtt = std::max(0.0, now - entry.ping_sent_at);
+    double rtt_ms = rtt * 1000.0;
+    ConnectionStats& stats = entry.stats;
+    stats.rtt_ms = rtt_ms;
+    stats.rtt_smoothed_ms = stats.rtt_smoothed_ms < 0.0
+        ? rtt_ms
+        : 0.875 * stats.rtt_smoothed_ms + 0.125 * rtt_ms;
+    stats.rtt.record(rtt);
+    rtt_total_.record(rtt);
+    return true;
+}
+
+void ConnectionTelemetry::setQueueDepth(int socket, size_t send_bytes, size_t recv_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = connections_.find(socket);
+    if (it == connections_.end()) return;
+    ConnectionStats& stats = it->second.stats;
+    stats.send_queue_bytes = send_bytes;
+    stats.recv_queue_bytes = recv_bytes;
+    stats.peak_send_queue_bytes = std::max(stats.peak_send_queue_bytes, send_bytes);
+}
+
+void ConnectionTelemetry::sample(double now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& kv : connections_) {
+        Entry& entry = kv.second;
+        // A connection opened mid-window is measured from when it opened
+        double since = std::max(last_sample_, entry.stats.connected_at);
+        double window = now - since;
+        if (last_sample_ >= 0.0 && window > 0.0) {
+            entry.stats.bytes_in_per_sec =
+                static_cast<double>(entry.stats.bytes_in - entry.sampled_bytes_in) / window;
+            entry.stats.bytes_out_per_sec =
+                static_cast<double>(entry.stats.bytes_out - entry.sampled_bytes_out) / window;
+        }
+        entry.sampled_bytes_in = entry.stats.bytes_in;
+        entry.sampled_bytes_out = entry.stats.bytes_out;
+    }
+    last_sample_ = now;
+}
+
+// ---------------------------------------------------------------------------
+// Queries
+// ---------------------------------------------------------------------------
+
+size_t ConnectionTelemetry::getConnectionCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return connections_.size();
+}
+
+std::vector<ConnectionStats> ConnectionTelemetry::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ConnectionStats> result;
+    result.reserve(connections_.size());
+    for (const auto& kv : connections_) result.push_back(kv.second.stats);
+    std::sort(result.begin(), result.end(),
+              [](const ConnectionStats& a, const ConnectionStats& b) { return a.socket < b.socket; });
+    return result;
+}
+
+std::vector<ConnectionStats> ConnectionTelemetry::top(size_t n, SortKey key) const {
+    std::vector<ConnectionStats> all = snapshot();
+    auto weight = [key](const ConnectionStats& s) -> double {
+        switch (key) {
+            case SortKey::BytesOut:  return s.bytes_out_per_sec;
+            case SortKey::BytesIn:   return s.bytes_in_per_sec;
+            case SortKey::Rtt:       return s.rtt_smoothed_ms;
+            case SortKey::SendQueue: return static_cast<double>(s.send_queue_bytes);
+            case SortKey::Apply:     return s.apply.quantile(0.99);
+        }
+        return 0.0;
+    };
+    n = std::min(n, all.size());
+    std::partial_sort(all.begin(), all.begin() + static_cast<std::ptrdiff_t>(n), all.end(),
+                      [&](const ConnectionStats& a, const ConnectionStats& b) {
+                          double wa = weight(a), wb = weight(b);
+                          return wa != wb ? wa > wb : a.socket < b.socket;
+                      });
+    all.resize(n);
+    return all;
+}
+
+bool ConnectionTelemetry::parseSortKey(const std::string& name, SortKey& key) {
+    if (name == "out")   { key = SortKey::BytesOut;  return true; }
+    if (name == "in")    { key = SortKey::BytesIn;   return true; }
+    if (name == "rtt")   { key = SortKey::Rtt;       return true; }
+    if (name == "queue") { key = SortKey::SendQueue; return true; }
+    if (name == "apply") { key = SortKey::Apply;     return true; }
+    return false;
+}
+
+std::string ConnectionTelemetry::formatTop(size_t n, SortKey key) const {
+    std::vector<ConnectionStats> rows = top(n, key);
+    std::ostringstream out;
+    out << "Connections: " << getConnectionCount() << " (showing " << rows.size() << ")\n";
+    out << std::left << std::setw(20) << "player" << std::setw(22) << "address"
+        << std::right << std::setw(10) << "out KB/s" << std::setw(10) << "in KB/s"
+        << std::setw(9) << "rtt ms" << std::setw(10) << "sndq KB"
+        << std::setw(12) << "apply p99" << std::setw(9) << "msgs in" << "\n";
+    out << std::fixed;
+    for (const auto& s : rows) {
+        std::string name = s.player_name.empty() ? "(connecting)" : s.player_name;
+        if (name.size() > 19) name = name.substr(0, 18) + "~";
+        out << std::left << std::setw(20) << name << std::setw(22) << s.address << std::right
+            << std::setprecision(1)
+            << std::setw(10) << s.bytes_out_per_sec / 1024.0
+            << std::setw(10) << s.bytes_in_per_sec / 1024.0;
+        if (s.rtt_smoothed_ms >= 0.0) out << std::setw(9) << s.rtt_smoothed_ms;
+        else out << std::setw(9) << "-";
+        out << std::setw(10) << static_cast<double>(s.send_queue_bytes) / 1024.0;
+        if (s.apply.count > 0) {
+            out << std::setprecision(2) << std::setw(9) << s.apply.quantile(0.99) * 1000.0 << " ms";
+        } else {
+            out << std::setw(12) << "-";
+        }
+        out << std::setw(9) << s.messages_in << "\n";
+    }
+    return out.str();
+}
+
+// ---------------------------------------------------------------------------
+// Prometheus export
+// ---------------------------------------------------------------------------
+
+namespace {
+
+std::string escapeLabel(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') { escaped += '\\'; escaped += c; }
+        else if (c == '\n') escaped += "\\n";
+        else escaped += c;
+    }
+    return escaped;
+}
+
+void writeHeader(std::ostream& out, const char* name, const char* type, const char* help) {
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " " << type << "\n";
+}
+
+void writeHistogram(std::ostream& out, const char* name, const char* help,
+                    const LatencyHistogram& h) {
+    writeHeader(out, name, "histogram", help);
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < LatencyHistogram::BOUNDS; ++i) {
+        cumulative += h.buckets[i];
+        out << name << "_bucket{le=\"" << LatencyHistogram::UPPER_BOUNDS[i] << "\"} "
+            << cumulative << "\n";
+    }
+    out << name << "_bucket{le=\"+Inf\"} " << h.count << "\n";
+    out << name << "_sum " << h.sum << "\n";
+    out << name << "_count " << h.count << "\n";
+}
+
+} // namespace
+
+void ConnectionTelemetry::writePrometheus(std::ostream& out) const {
+    std::vector<ConnectionStats> rows = snapshot();
+
+    uint64_t bytes_in, bytes_out, messages_in, messages_out, send_failures, opened;
+    LatencyHistogram rtt, apply;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        bytes_in = total_bytes_in_;
+        bytes_out = total_bytes_out_;
+        messages_in = total_messages_in_;
+        messages_out = total_messages_out_;
+        send_failures = total_send_failures_;
+        opened = total_connections_;
+        rtt = rtt_total_;
+        apply = apply_total_;
+    }
+
+    std::ostringstream text;
+    text << std::setprecision(9);
+
+    writeHeader(text, "atlas_connections", "gauge", "Open client connections");
+    text << "atlas_connections " << rows.size() << "\n";
+    writeHeader(text, "atlas_connections_opened_total", "counter", "Client connections accepted");
+    text << "atlas_connections_opened_total " << opened << "\n";
+    writeHeader(text, "atlas_network_received_bytes_total", "counter", "Bytes received from clients");
+    text << "atlas_network_received_bytes_total " << bytes_in << "\n";
+    writeHeader(text, "atlas_network_sent_bytes_total", "counter", "Bytes sent to clients");
+    text << "atlas_network_sent_bytes_total " << bytes_out << "\n";
+    writeHeader(text, "atlas_network_received_messages_total", "counter", "Messages received from clients");
+    text << "atlas_network_received_messages_total " << messages_in << "\n";
+    writeHeader(text, "atlas_network_sent_messages_total", "counter", "Messages sent to clients");
+    text << "atlas_network_sent_messages_total " << messages_out << "\n";
+    writeHeader(text, "atlas_network_send_failures_total", "counter", "Sends that failed");
+    text << "atlas_network_send_failures_total " << send_failures << "\n";
+
+    writeHistogram(text, "atlas_client_rtt_seconds", "Ping round-trip time", rtt);
+    writeHistogram(text, "atlas_command_apply_seconds",
+                   "Time from recv() to the command being applied", apply);
+
+    // Per-client gauges; labelled by player so a laggard is identifiable
+    struct Series {
+        const char* name;
+        const char* help;
+        double (*value)(const ConnectionStats&);
+        bool needs_rtt;              // skip clients that have not answered a ping
+    };
+    static const Series series[] = {
+        {"atlas_client_received_bytes_per_second", "Bytes per second received from the client",
+         [](const ConnectionStats& s) { return s.bytes_in_per_sec; }, false},
+        {"atlas_client_sent_bytes_per_second", "Bytes per second sent to the client",
+         [](const ConnectionStats& s) { return s.bytes_out_per_sec; }, false},
+        {"atlas_client_rtt_smoothed_seconds", "Smoothed ping round-trip time",
+         [](const ConnectionStats& s) { return s.rtt_smoothed_ms / 1000.0; }, true},
+        {"atlas_client_send_queue_bytes", "Unsent bytes in the socket send queue",
+         [](const ConnectionStats& s) { return static_cast<double>(s.send_queue_bytes); }, false},
+        {"atlas_client_recv_queue_bytes", "Unread bytes in the socket receive queue",
+         [](const ConnectionStats& s) { return static_cast<double>(s.recv_queue_bytes); }, false},
+        {"atlas_client_command_apply_p99_seconds", "99th percentile command apply latency",
+         [](const ConnectionStats& s) { return s.apply.quantile(0.99); }, false},
+    };
+    for (const auto& metric : series) {
+        writeHeader(text, metric.name, "gauge", metric.help);
+        for (const auto& s : rows) {
+            if (metric.needs_rtt && s.rtt_smoothed_ms < 0.0) continue;
+            text << metric.name << "{player=\"" << escapeLabel(s.player_name)
+                 << "\",address=\"" << escapeLabel(s.address) << "\"} "
+                 << metric.value(s) << "\n";
+        }
+    }
+
+    out << text.str();
+}
+
+uint64_t ConnectionTelemetry::getTotalBytesIn() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return total_bytes_in_;
+}
+
+uint64_t ConnectionTelemetry::getTotalBytesOut() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return total_bytes_out_;
+}
+
+LatencyHistogram ConnectionTelemetry::getRttHistogram() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rtt_total_;
+}
+
+LatencyHistogram ConnectionTelemetry::getApplyHistogram() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return apply_total_;
+}
+
+} // namespace network
+} // namespace atlas
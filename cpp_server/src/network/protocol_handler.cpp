@@ -53,6 +53,17 @@ void ProtocolHandler::initializeMessageTypes() {
     message_type_map_["abandon_mission"] = MessageType::ABANDON_MISSION;
     message_type_map_["mission_progress"] = MessageType::MISSION_PROGRESS;
     message_type_map_["mission_result"] = MessageType::MISSION_RESULT;
+    message_type_map_["market_history"] = MessageType::MARKET_HISTORY;
+    message_type_map_["wormhole_jump_result"] = MessageType::WORMHOLE_JUMP_RESULT;
+    message_type_map_["gate_jump"] = MessageType::GATE_JUMP;
+    message_type_map_["gate_jump_result"] = MessageType::GATE_JUMP_RESULT;
+    message_type_map_["chat_join"] = MessageType::CHAT_JOIN;
+    message_type_map_["chat_leave"] = MessageType::CHAT_LEAVE;
+    message_type_map_["chat_channel_result"] = MessageType::CHAT_CHANNEL_RESULT;
+    message_type_map_["session_redirect"] = MessageType::SESSION_REDIRECT;
+    message_type_map_["time_dilation"] = MessageType::TIME_DILATION;
+    message_type_map_["ping"] = MessageType::PING;
+    message_type_map_["pong"] = MessageType::PONG;
     message_type_map_["error"] = MessageType::ERROR;
 }
 
@@ -102,6 +113,17 @@ std::string ProtocolHandler::messageTypeToString(MessageType type) {
         case MessageType::ABANDON_MISSION: return "abandon_mission";
         case MessageType::MISSION_PROGRESS: return "mission_progress";
         case MessageType::MISSION_RESULT: return "mission_result";
+        case MessageType::MARKET_HISTORY: return "market_history";
+        case MessageType::WORMHOLE_JUMP_RESULT: return "wormhole_jump_result";
+        case MessageType::GATE_JUMP: return "gate_jump";
+        case MessageType::GATE_JUMP_RESULT: return "gate_jump_result";
+        case MessageType::CHAT_JOIN: return "chat_join";
+        case MessageType::CHAT_LEAVE: return "chat_leave";
+        case MessageType::CHAT_CHANNEL_RESULT: return "chat_channel_result";
+        case MessageType::SESSION_REDIRECT: return "session_redirect";
+        case MessageType::TIME_DILATION: return "time_dilation";
+        case MessageType::PING: return "ping";
+        case MessageType::PONG: return "pong";
         case MessageType::ERROR: return "error";
         default: return "unknown";
     }
@@ -183,6 +205,36 @@ std::string ProtocolHandler::createChatMessage(const std::string& sender, const
     return json.str();
 }
 
+std::string ProtocolHandler::createChatChannelResult(bool success, const std::string& channel,
+                                                     const std::string& action, int members,
+                                                     const std::string& reason) {
+    std::ostringstream json;
+    json << "{\"message_type\":\"chat_channel_result\",\"data\":{";
+    json << "\"success\":" << (success ? "true" : "false") << ",";
+    json << "\"channel\":\"" << channel << "\",";
+    json << "\"action\":\"" << action << "\",";
+    json << "\"members\":" << members;
+    if (!reason.empty()) {
+        json << ",\"reason\":\"" << reason << "\"";
+    }
+    json << "}}";
+    return json.str();
+}
+
+std::string ProtocolHandler::createChatMessage(const std::string& sender, const std::string& message,
+                                               const std::string& channel) {
+    std::ostringstream json;
+    json << "{";
+    json << "\"message_type\":\"" << messageTypeToString(MessageType::CHAT) << "\",";
+    json << "\"data\":{";
+    json << "\"sender\":\"" << sender << "\",";
+    json << "\"message\":\"" << message << "\",";
+    json << "\"channel\":\"" << channel << "\"";
+    json << "}";
+    json << "}";
+    return json.str();
+}
+
 std::string ProtocolHandler::createError(const std::string& error_message) {
     std::ostringstream json;
     json << "{";
@@ -368,5 +420,81 @@ std::string ProtocolHandler::createMissionResult(bool success, const std::string
     return json.str();
 }
 
+std::string ProtocolHandler::createMarketHistory(const std::string& station_id,
+                                                  const std::string& item_id,
+                                                  const std::string& resolution, int count,
+                                                  const std::string& buckets_json) {
+    std::ostringstream json;
+    json << "{\"message_type\":\"market_history\",\"data\":{";
+    json << "\"station_id\":\"" << station_id << "\",";
+    json << "\"item_id\":\"" << item_id << "\",";
+    json << "\"resolution\":\"" << resolution << "\",";
+    json << "\"count\":" << count << ",";
+    json << "\"buckets\":" << buckets_json;
+    json << "}}";
+    return json.str();
+}
+
+std::string ProtocolHandler::createWormholeJumpResult(bool success,
+                                                      const std::string& wormhole_id,
+                                                      const std::string& destination_system,
+                                                      const std::string& reason) {
+    std::ostringstream json;
+    json << "{\"message_type\":\"wormhole_jump_result\",\"data\":{";
+    json << "\"success\":" << (success ? "true" : "false") << ",";
+    json << "\"wormhole_id\":\"" << wormhole_id << "\",";
+    json << "\"destination_system\":\"" << destination_system << "\"";
+    if (!reason.empty()) {
+        json << ",\"reason\":\"" << reason << "\"";
+    }
+    json << "}}";
+    return json.str();
+}
+
+std::string ProtocolHandler::createGateJumpResult(bool success,
+                                                  const std::string& destination_system,
+                                                  const std::string& reason) {
+    std::ostringstream json;
+    json << "{\"message_type\":\"gate_jump_result\",\"data\":{";
+    json << "\"success\":" << (success ? "true" : "false") << ",";
+    json << "\"destination_system\":\"" << destination_system << "\"";
+    if (!reason.empty()) {
+        json << ",\"reason\":\"" << reason << "\"";
+    }
+    json << "}}";
+    return json.str();
+}
+
+std::string ProtocolHandler::createSessionRedirect(const std::string& entity_id,
+                                                   const std::string& node_id,
+                                                   const std::string& system_id,
+                                                   const std::string& resume_token) {
+    std::ostringstream json;
+    json << "{\"message_type\":\"session_redirect\",\"data\":{";
+    json << "\"entity_id\":\"" << entity_id << "\",";
+    json << "\"node_id\":\"" << node_id << "\",";
+    json << "\"system_id\":\"" << system_id << "\"";
+    if (!resume_token.empty()) {
+        json << ",\"resume_token\":\"" << resume_token << "\"";
+    }
+    json << "}}";
+    return json.str();
+}
+
+std::string ProtocolHandler::createTimeDilation(const std::string& system_id, float factor) {
+    std::ostringstream json;
+    json << "{\"message_type\":\"time_dilation\",\"data\":{";
+    json << "\"system_id\":\"" << system_id << "\",";
+    json << "\"factor\":" << factor;
+    json << "}}";
+    return json.str();
+}
+
+std::string ProtocolHandler::createPing(uint64_t nonce) {
+    std::ostringstream json;
+    json << "{\"type\":\"ping\",\"data\":{\"nonce\":" << nonce << "}}";
+    return json.str();
+}
+
 } // namespace network
 } // namespace atlas
@@ -1,4 +1,5 @@
 #include "network/tcp_server.h"
+#include <chrono>
 #include <iostream>
 #include <cstring>
 
@@ -6,9 +7,23 @@
 #pragma comment(lib, "ws2_32.lib")
 #endif
 
+#ifdef __linux__
+#include <linux/sockios.h>
+#include <sys/ioctl.h>
+#endif
+
 namespace atlas {
 namespace network {
 
+namespace {
+
+double steadySeconds() {
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
 TCPServer::TCPServer(const std::string& host, uint16_t port, int max_connections)
     : host_(host)
     , port_(port)
@@ -60,6 +75,15 @@ bool TCPServer::initialize() {
         return false;
     }
     
+    // Resolve the actual port when binding to an ephemeral one (port 0)
+    if (port_ == 0) {
+        sockaddr_in bound{};
+        socklen_t bound_len = sizeof(bound);
+        if (getsockname(server_socket_, (sockaddr*)&bound, &bound_len) == 0) {
+            port_ = ntohs(bound.sin_port);
+        }
+    }
+    
     // Listen
     if (listen(server_socket_, max_connections_) == SOCKET_ERROR) {
         std::cerr << "Failed to listen on socket" << std::endl;
@@ -87,22 +111,32 @@ void TCPServer::stop() {
     
     running_ = false;
     
-    // Close server socket to unblock accept
+    // Shut the server socket down to unblock accept (close() alone does
+    // not wake a blocked accept on Linux)
     if (server_socket_ != INVALID_SOCKET) {
-        closeSocket(server_socket_);
-        server_socket_ = INVALID_SOCKET;
+#ifdef _WIN32
+        shutdown(server_socket_, SD_BOTH);
+#else
+        shutdown(server_socket_, SHUT_RDWR);
+#endif
     }
     
     // Wait for accept thread
     if (accept_thread_.joinable()) {
         accept_thread_.join();
     }
+
+    if (server_socket_ != INVALID_SOCKET) {
+        closeSocket(server_socket_);
+        server_socket_ = INVALID_SOCKET;
+    }
     
     // Close all client connections
     {
         std::lock_guard<std::mutex> lock(clients_mutex_);
         for (auto& client : clients_) {
-            closeSocket(client.socket);
+            // Handler threads close their own sockets once recv() unblocks
+            disconnectClient(client);
         }
         clients_.clear();
     }
@@ -145,6 +179,9 @@ void TCPServer::acceptLoop() {
         client.connect_time = std::time(nullptr);
         
         std::cout << "[TCPServer] New connection from " << client_ip << ":" << client_port << std::endl;
+        telemetry_.onConnect(static_cast<int>(client_socket),
+                             std::string(client_ip) + ":" + std::to_string(client_port),
+                             steadySeconds());
         
         // Add to clients list
         {
@@ -168,6 +205,9 @@ void TCPServer::handleClient(ClientConnection client) {
             break;
         }
         
+        telemetry_.recordMessageIn(static_cast<int>(client.socket),
+                                   static_cast<size_t>(bytes_received));
+
         buffer[bytes_received] = '\0';
         std::string message(buffer, bytes_received);
         
@@ -188,6 +228,10 @@ void TCPServer::handleClient(ClientConnection client) {
     }
     
     std::cout << "[TCPServer] Client disconnected: " << client.address << ":" << client.port << std::endl;
+    telemetry_.onDisconnect(static_cast<int>(client.socket));
+    if (disconnect_handler_) {
+        disconnect_handler_(client);
+    }
     closeSocket(client.socket);
 }
 
@@ -205,18 +249,58 @@ void TCPServer::setMessageHandler(MessageHandler handler) {
     message_handler_ = handler;
 }
 
+void TCPServer::setDisconnectHandler(DisconnectHandler handler) {
+    disconnect_handler_ = handler;
+}
+
 bool TCPServer::sendToClient(const ClientConnection& client, const std::string& data) {
-    int bytes_sent = send(client.socket, data.c_str(), static_cast<int>(data.size()), 0);
-    return bytes_sent > 0;
+    return sendToSocket(client.socket, data);
+}
+
+bool TCPServer::sendToSocket(socket_t socket, const std::string& data) {
+    // Never started (headless replay) or stopped: the fd is not ours
+    if (!running_) return false;
+    int bytes_sent = send(socket, data.c_str(), static_cast<int>(data.size()), 0);
+    if (bytes_sent > 0) {
+        telemetry_.recordMessageOut(static_cast<int>(socket), static_cast<size_t>(bytes_sent));
+        return true;
+    }
+    telemetry_.recordSendFailure(static_cast<int>(socket));
+    return false;
 }
 
 void TCPServer::broadcastToAll(const std::string& data) {
     std::lock_guard<std::mutex> lock(clients_mutex_);
     for (const auto& client : clients_) {
-        send(client.socket, data.c_str(), static_cast<int>(data.size()), 0);
+        sendToSocket(client.socket, data);
     }
 }
 
+void TCPServer::sampleTelemetry() {
+#ifdef __linux__
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        for (const auto& client : clients_) {
+            int unsent = 0;
+            int unread = 0;
+            if (ioctl(client.socket, SIOCOUTQ, &unsent) != 0) unsent = 0;
+            if (ioctl(client.socket, SIOCINQ, &unread) != 0) unread = 0;
+            telemetry_.setQueueDepth(static_cast<int>(client.socket),
+                                     static_cast<size_t>(unsent), static_cast<size_t>(unread));
+        }
+    }
+#endif
+    telemetry_.sample(steadySeconds());
+}
+
+void TCPServer::disconnectClient(const ClientConnection& client) {
+#ifdef _WIN32
+    shutdown(client.socket, SD_BOTH);
+#else
+    shutdown(client.socket, SHUT_RDWR);
+#endif
+}
+
 void TCPServer::closeSocket(socket_t socket) {
     if (socket != INVALID_SOCKET) {
 #ifdef _WIN32
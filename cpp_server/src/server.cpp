@@ -8,9 +8,20 @@
 #include "systems/shield_recharge_system.h"
 #include "systems/weapon_system.h"
 #include "systems/station_system.h"
+#include "systems/wormhole_system.h"
+#include "systems/market_system.h"
+#include "systems/background_simulation_system.h"
+#include "systems/npc_intent_system.h"
+#include "systems/ambient_traffic_system.h"
+#include "components/game_components.h"
 #include "utils/logger.h"
 #include <iostream>
+#include <iomanip>
+#include <cstdio>
 #include <fstream>
+#include <algorithm>
+#include <map>
+#include <sstream>
 #include <thread>
 #include <chrono>
 #include <sys/stat.h>
@@ -54,15 +65,199 @@ void Server::initializeGameWorld() {
     auto movement = std::make_unique<systems::MovementSystem>(game_world_.get());
     movement_system_ = movement.get();
     game_world_->addSystem(std::move(movement));
-    game_world_->addSystem(std::make_unique<systems::WeaponSystem>(game_world_.get()));
+    auto weapons = std::make_unique<systems::WeaponSystem>(game_world_.get());
     auto combat = std::make_unique<systems::CombatSystem>(game_world_.get());
     combat_system_ = combat.get();
+    weapons->setCombatSystem(combat_system_);
+    game_world_->addSystem(std::move(weapons));
     game_world_->addSystem(std::move(combat));
-    
+
+    auto wormholes = std::make_unique<systems::WormholeSystem>(game_world_.get());
+    wormhole_system_ = wormholes.get();
+    game_world_->addSystem(std::move(wormholes));
+
+    // Global economy: trades roll into the market history, which the
+    // background simulation reads for per-system trade volume
+    auto market = std::make_unique<systems::MarketSystem>(game_world_.get());
+    market_system_ = market.get();
+    game_world_->addSystem(std::move(market));
+
+    auto research = std::make_unique<systems::ResearchSystem>(game_world_.get());
+    research_system_ = research.get();
+    game_world_->addSystem(std::move(research));
+
+    universe_.loadFromDirectory(config_->data_path);
+
+    auto background = std::make_unique<systems::BackgroundSimulationSystem>(game_world_.get());
+    systems::MarketSystem* trade_market = market_system_;
+    background->setMarketHistory(&market_system_->getHistory(),
+                                 [trade_market]() { return trade_market->getSimTime(); });
+    background_system_ = background.get();
+    game_world_->addSystem(std::move(background));
+
+    // NPC intents and ambient traffic advance with their system's
+    // background clock, so only systems that are ticking cost anything
+    auto intents = std::make_unique<systems::NPCIntentSystem>(game_world_.get());
+    intents->attach(background_system_);
+    game_world_->addSystem(std::move(intents));
+
+    auto traffic = std::make_unique<systems::AmbientTrafficSystem>(game_world_.get());
+    traffic->attach(background_system_);
+    game_world_->addSystem(std::move(traffic));
+
     auto& log = utils::Logger::instance();
     log.info("Game world initialized with " +
              std::to_string(game_world_->getEntityCount()) + " entities");
-    log.info("Systems: Capacitor, ShieldRecharge, AI, Targeting, Station, Movement, Weapon, Combat");
+    log.info("Systems: Capacitor, ShieldRecharge, AI, Targeting, Station, Movement, Weapon, Combat, "
+             "Wormhole, Market, Research, BackgroundSimulation, NPCIntent, AmbientTraffic");
+}
+
+void Server::spawnSolarSystems() {
+    // Systems missing from the saved world get a fresh entity; they stay
+    // in the coordinator as global state for the background simulation
+    int spawned = 0;
+    for (const auto& system_id : universe_.getSystemIds()) {
+        if (auto* existing = game_world_->getEntity(system_id)) {
+            // Traffic state is not persisted
+            if (!existing->getComponent<components::AmbientTrafficState>()) {
+                existing->addComponent(std::make_unique<components::AmbientTrafficState>());
+            }
+            continue;
+        }
+        const data::SolarSystemTemplate* tmpl = universe_.getSystem(system_id);
+        auto* entity = game_world_->createEntity(system_id);
+        if (!entity) continue;
+
+        auto system = std::make_unique<components::SolarSystem>();
+        system->system_id = system_id;
+        system->system_name = tmpl->name;
+        entity->addComponent(std::move(system));
+
+        auto state = std::make_unique<components::SimStarSystemState>();
+        state->security_level = tmpl->security;
+        entity->addComponent(std::move(state));
+        entity->addComponent(std::make_unique<components::AmbientTrafficState>());
+        ++spawned;
+    }
+    if (spawned > 0) {
+        utils::Logger::instance().info("Spawned " + std::to_string(spawned) + " solar systems");
+    }
+}
+
+sim::TimeDilation::Config Server::timeDilationConfig() const {
+    sim::TimeDilation::Config tidi;
+    tidi.enabled = config_->time_dilation;
+    tidi.budget_ms = config_->time_dilation_budget_ms;
+    tidi.floor = config_->time_dilation_floor;
+    return tidi;
+}
+
+void Server::initializePartitions() {
+    auto& log = utils::Logger::instance();
+    partitions_ = std::make_unique<sim::PartitionManager>(
+        game_world_.get(), config_->partition_workers);
+
+    partitions_->setTimeDilationConfig(timeDilationConfig());
+
+    // Every solar system gets its own partition running the local
+    // simulation systems.  The system entities themselves, and other
+    // global systems, stay in the coordinator.
+    std::vector<std::string> system_ids;
+    for (auto* entity : game_world_->getEntities<components::SolarSystem>()) {
+        system_ids.push_back(entity->getId());
+    }
+
+    GameSession* session = game_session_.get();
+    for (const auto& system_id : system_ids) {
+        partitions_->createPartition(system_id, [session](sim::StarSystemPartition& partition) {
+            GameSession::SystemSet set;
+            ecs::World* world = &partition.getWorld();
+            set.world = world;
+            world->addSystem(std::make_unique<systems::CapacitorSystem>(world));
+            world->addSystem(std::make_unique<systems::ShieldRechargeSystem>(world));
+            world->addSystem(std::make_unique<systems::AISystem>(world));
+
+            auto targeting = std::make_unique<systems::TargetingSystem>(world);
+            set.targeting = targeting.get();
+            world->addSystem(std::move(targeting));
+
+            auto station = std::make_unique<systems::StationSystem>(world);
+            set.station = station.get();
+            world->addSystem(std::move(station));
+
+            auto movement = std::make_unique<systems::MovementSystem>(world);
+            set.movement = movement.get();
+            world->addSystem(std::move(movement));
+            auto weapons = std::make_unique<systems::WeaponSystem>(world);
+            auto combat = std::make_unique<systems::CombatSystem>(world);
+            set.combat = combat.get();
+            weapons->setCombatSystem(combat.get());
+            world->addSystem(std::move(weapons));
+            world->addSystem(std::move(combat));
+
+            auto wormholes = std::make_unique<systems::WormholeSystem>(world);
+            set.wormholes = wormholes.get();
+            sim::StarSystemPartition* self = &partition;
+            wormholes->setHandoffCallback(
+                [self](const std::string& ship_id, const std::string& destination) {
+                    self->requestHandoff(ship_id, destination, sim::HandoffKind::Wormhole);
+                });
+            world->addSystem(std::move(wormholes));
+
+            session->setPartitionSystems(partition.getSystemId(), set);
+        });
+    }
+
+    // Ships (including NPCs spawned and players saved before now) and
+    // wormholes move into the partition of the system they are in
+    std::vector<std::pair<std::string, std::string>> placements;
+    for (auto* entity : game_world_->getAllEntities()) {
+        if (auto* location = entity->getComponent<components::SystemLocation>()) {
+            placements.emplace_back(entity->getId(), location->system_id);
+        } else if (auto* wh = entity->getComponent<components::WormholeConnection>()) {
+            placements.emplace_back(entity->getId(), wh->source_system);
+        }
+    }
+    size_t assigned = 0;
+    for (const auto& placement : placements) {
+        if (partitions_->assignEntity(placement.first, placement.second)) ++assigned;
+    }
+
+    game_session_->setPartitionManager(partitions_.get());
+
+    log.info("Partitioned simulation: " + std::to_string(partitions_->getPartitionCount()) +
+             " solar systems on " + std::to_string(partitions_->getWorkerCount() + 1) +
+             " threads, " + std::to_string(assigned) + " entities placed");
+}
+
+bool Server::initializeClusterNode() {
+    auto& log = utils::Logger::instance();
+    cluster::ClusterTopology topology;
+    if (!topology.parse(config_->cluster_topology) ||
+        !topology.getNode(config_->cluster_node_id)) {
+        log.error("Invalid cluster_topology or unknown cluster_node_id '" +
+                  config_->cluster_node_id + "'");
+        return false;
+    }
+
+    cluster_node_ = std::make_unique<cluster::ClusterNode>(
+        config_->cluster_node_id, topology, game_world_.get());
+    if (!cluster_node_->start()) {
+        return false;
+    }
+
+    // Wormhole jumps into systems owned by other nodes migrate the ship
+    GameSession* session = game_session_.get();
+    wormhole_system_->setHandoffCallback(
+        [session](const std::string& ship_id, const std::string& destination) {
+            session->requestMigration(ship_id, destination);
+        });
+    game_session_->setClusterNode(cluster_node_.get());
+
+    const auto* self = topology.getNode(config_->cluster_node_id);
+    log.info("Cluster node " + config_->cluster_node_id + " owns " +
+             std::to_string(self->systems.size()) + " solar systems");
+    return true;
 }
 
 bool Server::initialize() {
@@ -70,6 +265,15 @@ bool Server::initialize() {
 
     // Initialize file logging using the configured log_path
     log.init(config_->log_path);
+    if (config_->log_json) {
+        log.initJson(config_->log_path);
+    }
+    log.setRotation(static_cast<uint64_t>(std::max(0, config_->log_max_file_mb)) * 1024 * 1024,
+                    config_->log_max_files);
+    if (config_->log_async) {
+        // Keep file and console I/O off the tick thread
+        log.startAsync();
+    }
 
     log.info("==================================");
     log.info("EVE OFFLINE Dedicated Server");
@@ -136,13 +340,13 @@ bool Server::initialize() {
     initializeGameWorld();
     
     // Initialize game session (bridges networking ↔ ECS world)
-    game_session_ = std::make_unique<GameSession>(
-        game_world_.get(), tcp_server_.get(), config_->data_path);
-    game_session_->setTargetingSystem(targeting_system_);
-    game_session_->setStationSystem(station_system_);
-    game_session_->setMovementSystem(movement_system_);
-    game_session_->setCombatSystem(combat_system_);
+    createGameSession();
     game_session_->initialize();
+
+    if (config_->cluster_role == "node" && !initializeClusterNode()) {
+        log.error("Failed to join cluster");
+        return false;
+    }
     
     // Load persisted world state if enabled
     if (config_->persistent_world) {
@@ -162,6 +366,30 @@ bool Server::initialize() {
         }
     }
 
+    spawnSolarSystems();
+
+    // Systems without players are suspended until the session reports an
+    // observer (see GameSession::refreshPlayerSystems)
+    background_system_->setFastForward(config_->background_fast_forward);
+
+    if (config_->partition_by_system) {
+        if (cluster_node_) {
+            // Partition handoffs are in-process only; nodes keep one world
+            log.warn("partition_by_system is ignored in cluster node mode");
+        } else {
+            initializePartitions();
+        }
+    }
+    if (!partitions_) {
+        // One world hosts every player, so it dilates as a whole
+        world_dilation_.setConfig(timeDilationConfig());
+        game_session_->setWorldDilation(&world_dilation_);
+    }
+
+    if (!config_->replay_record_path.empty()) {
+        startRecording();
+    }
+
     // Initialize server console
     console_.setInteractive(true);  // Enable interactive mode by default
     console_.init(*this, *config_);
@@ -169,6 +397,48 @@ bool Server::initialize() {
     return true;
 }
 
+void Server::createGameSession() {
+    game_session_ = std::make_unique<GameSession>(
+        game_world_.get(), tcp_server_.get(), config_->data_path, config_->data_bake_path);
+    game_session_->setTargetingSystem(targeting_system_);
+    game_session_->setStationSystem(station_system_);
+    game_session_->setMovementSystem(movement_system_);
+    game_session_->setCombatSystem(combat_system_);
+    game_session_->setWormholeSystem(wormhole_system_);
+    game_session_->setMarketSystem(market_system_);
+    game_session_->setUniverse(&universe_);
+    game_session_->setBackgroundSimulation(background_system_);
+    game_session_->setPingInterval(config_->ping_interval_seconds);
+}
+
+void Server::startRecording() {
+    auto& log = utils::Logger::instance();
+    if (partitions_ || cluster_node_) {
+        // Replay rebuilds a single world; partition and cluster hand-offs
+        // are not part of the recording
+        log.warn("replay_record_path is ignored with partitioned or clustered simulation");
+        return;
+    }
+
+    std::map<std::string, uint64_t> seeds;
+    seeds["session.next_entity_id"] = game_session_->getNextEntityId();
+    seeds["research.rng_state"] = research_system_->getRngState();
+    seeds["research.job_counter"] = static_cast<uint64_t>(research_system_->getJobCounter());
+
+    recorder_ = std::make_unique<sim::ReplayRecorder>();
+    if (!recorder_->open(config_->replay_record_path,
+                         world_persistence_.serializeWorld(game_world_.get()),
+                         1.0f / config_->tick_rate, seeds)) {
+        log.error("Failed to start session recording at " + config_->replay_record_path);
+        recorder_.reset();
+        return;
+    }
+    game_session_->setRecorder(recorder_.get());
+    // Replay steps the world on every tick, so the recording must as well
+    world_dilation_.setConfig(sim::TimeDilation::Config{});
+    log.info("Recording session to " + config_->replay_record_path);
+}
+
 void Server::start() {
     if (running_) {
         utils::Logger::instance().warn("Server is already running");
@@ -203,16 +473,28 @@ void Server::stop() {
     }
     
     console_.shutdown();
+
+    if (cluster_node_) {
+        cluster_node_->stop();
+    }
     
     if (tcp_server_) {
         tcp_server_->stop();
     }
+
+    if (recorder_) {
+        game_session_->setRecorder(nullptr);
+        recorder_->close();
+        log.info("Session recording closed after " + std::to_string(recorder_->getTickCount()) +
+                 " ticks, " + std::to_string(recorder_->getCommandCount()) + " commands");
+    }
     
     if (steam_auth_) {
         steam_auth_->shutdown();
     }
     
     log.info("Server stopped.");
+    log.stopAsync();
     log.shutdown();
 }
 
@@ -227,18 +509,51 @@ void Server::mainLoop() {
     
     auto last_save_time = std::chrono::steady_clock::now();
     const auto save_interval = std::chrono::seconds(config_->save_interval_seconds);
+    auto last_telemetry_sample = last_save_time;
+    auto last_metrics_export = last_save_time;
+    const auto metrics_export_interval =
+        std::chrono::seconds(std::max(1, config_->metrics_export_interval_seconds));
     
     while (running_) {
         auto frame_start = std::chrono::steady_clock::now();
         metrics_.recordTickStart();
+
+        // Apply client commands on this thread, ahead of the systems they drive
+        if (game_session_) {
+            game_session_->processIncomingMessages();
+        }
         
-        // Update game world (ECS systems)
-        game_world_->update(tick_duration);
+        // Update game world (ECS systems), in parallel per solar system
+        // when partitioning is enabled
+        if (partitions_) {
+            partitions_->tick(tick_duration);
+            for (const auto& system_id : partitions_->getPartitionIds()) {
+                metrics_.recordDilation(system_id,
+                    partitions_->getPartition(system_id)->getDilationFactor());
+            }
+        } else if (world_dilation_.beginTick(tick_duration)) {
+            auto step_start = std::chrono::steady_clock::now();
+            game_world_->update(tick_duration);
+            double step_ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - step_start).count();
+            world_dilation_.update(step_ms, world_dilation_.getStepWallSeconds());
+            metrics_.recordDilation("world", world_dilation_.getFactor());
+        }
+        
+        // Adopt entities from / confirm hand-overs to peer nodes
+        if (cluster_node_) {
+            cluster_node_->update();
+        }
         
         // Broadcast state to all connected clients
         if (game_session_) {
             game_session_->update(tick_duration);
         }
+
+        // Close this tick's frame of recorded commands
+        if (recorder_) {
+            recorder_->endTick();
+        }
         
         // Update Steam callbacks
         if (config_->use_steam && steam_auth_) {
@@ -260,9 +575,27 @@ void Server::mainLoop() {
         metrics_.recordTickEnd();
 
         // Update entity / player counters and emit periodic stats
-        metrics_.setEntityCount(static_cast<int>(game_world_->getEntityCount()));
+        size_t entity_count = game_world_->getEntityCount();
+        if (partitions_) {
+            for (const auto& system_id : partitions_->getPartitionIds()) {
+                entity_count += partitions_->getPartition(system_id)->getWorld().getEntityCount();
+            }
+        }
+        metrics_.setEntityCount(static_cast<int>(entity_count));
         metrics_.setPlayerCount(getPlayerCount());
         metrics_.logSummaryIfDue(60.0);
+
+        // Per-connection rates and queue depths, then the optional
+        // machine-readable dump
+        if (frame_start - last_telemetry_sample >= std::chrono::seconds(1)) {
+            tcp_server_->sampleTelemetry();
+            last_telemetry_sample = frame_start;
+        }
+        if (!config_->metrics_export_path.empty() &&
+            frame_start - last_metrics_export >= metrics_export_interval) {
+            writeMetricsFile(config_->metrics_export_path);
+            last_metrics_export = frame_start;
+        }
         
         // Sleep for remaining tick time
         auto frame_end = std::chrono::steady_clock::now();
@@ -273,6 +606,113 @@ void Server::mainLoop() {
     }
 }
 
+bool Server::writeMetricsFile(const std::string& path) const {
+    std::string temp_path = path + ".tmp";
+    {
+        std::ofstream out(temp_path, std::ios::trunc);
+        if (!out.is_open()) {
+            utils::Logger::instance().warn("Cannot write metrics to " + temp_path);
+            return false;
+        }
+        out << metrics_.prometheusText();
+        if (tcp_server_) tcp_server_->getTelemetry().writePrometheus(out);
+        if (!out.good()) return false;
+    }
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        utils::Logger::instance().warn("Cannot replace metrics file " + path);
+        return false;
+    }
+    return true;
+}
+
+int Server::replay(const std::string& log_path) {
+    sim::ReplayLog recording;
+    if (!recording.load(log_path)) {
+        return 1;
+    }
+    const float dt = recording.getTickDuration();
+    if (!(dt > 0.0f)) {
+        std::cerr << "[Replay] Recording has no valid tick length" << std::endl;
+        return 1;
+    }
+
+    initializeGameWorld();
+    // Never initialized or started: replies and state broadcasts are still
+    // built as they were live, but sendToSocket() drops them instead of
+    // writing to whatever the recorded fd numbers are in this process
+    tcp_server_ = std::make_unique<network::TCPServer>(
+        config_->host, config_->port, config_->max_connections);
+    createGameSession();
+    if (!world_persistence_.deserializeWorld(game_world_.get(), recording.getSnapshot())) {
+        std::cerr << "[Replay] Failed to restore the recorded world snapshot" << std::endl;
+        return 1;
+    }
+    game_session_->setNextEntityId(
+        static_cast<uint32_t>(recording.getSeed("session.next_entity_id", 1)));
+    research_system_->setRngState(
+        static_cast<uint32_t>(recording.getSeed("research.rng_state", research_system_->getRngState())));
+    research_system_->setJobCounter(
+        static_cast<int>(recording.getSeed("research.job_counter", 0)));
+
+    std::cout << "[Replay] " << log_path << ": " << recording.getTickCount() << " ticks, "
+              << recording.getCommandCount() << " commands, "
+              << game_world_->getEntityCount() << " entities"
+              << (recording.isTruncated() ? " (truncated)" : "") << std::endl;
+
+    game_world_->setProfiling(true);
+    const auto& frames = recording.getFrames();
+    size_t next_frame = 0;
+    double worst_ms = 0.0;
+    uint64_t worst_tick = 0;
+    auto replay_start = std::chrono::steady_clock::now();
+
+    for (uint64_t tick = 1; tick <= recording.getTickCount(); ++tick) {
+        auto tick_start = std::chrono::steady_clock::now();
+        if (next_frame < frames.size() && frames[next_frame].tick == tick) {
+            for (const auto& command : frames[next_frame].commands) {
+                game_session_->replayMessage(command.client, command.raw);
+            }
+            ++next_frame;
+        }
+        game_world_->update(dt);
+        game_session_->update(dt);
+
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - tick_start).count();
+        if (ms > worst_ms) {
+            worst_ms = ms;
+            worst_tick = tick;
+        }
+    }
+
+    double wall_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - replay_start).count();
+    double simulated_ms = static_cast<double>(recording.getTickCount()) * dt * 1000.0;
+
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(3);
+    report << "[Replay] " << recording.getTickCount() << " ticks in " << wall_ms << " ms ("
+           << (wall_ms > 0.0 ? simulated_ms / wall_ms : 0.0) << "x real time), worst tick "
+           << worst_tick << " at " << worst_ms << " ms" << std::endl;
+
+    auto profiles = game_world_->getSystemProfiles();
+    std::sort(profiles.begin(), profiles.end(),
+              [](const ecs::World::SystemProfile& a, const ecs::World::SystemProfile& b) {
+                  return a.total_ms > b.total_ms;
+              });
+    report << std::left << std::setw(28) << "system" << std::right
+           << std::setw(12) << "total ms" << std::setw(12) << "avg ms"
+           << std::setw(12) << "max ms" << std::endl;
+    for (const auto& profile : profiles) {
+        double avg = profile.calls ? profile.total_ms / static_cast<double>(profile.calls) : 0.0;
+        report << std::left << std::setw(28) << profile.name << std::right
+               << std::setw(12) << profile.total_ms << std::setw(12) << avg
+               << std::setw(12) << profile.max_ms << std::endl;
+    }
+    std::cout << report.str();
+    return 0;
+}
+
 void Server::updateSteam() {
     if (steam_auth_ && steam_auth_->isInitialized()) {
         steam_auth_->update();
@@ -311,12 +751,41 @@ bool Server::saveWorld() {
 
     std::string filepath = config_->save_path + "/world_state.json";
     utils::Logger::instance().info("[AutoSave] Saving world state...");
-    return world_persistence_.saveWorld(game_world_.get(), filepath);
+    // Ships and wormholes live in their solar system's partition
+    std::vector<const ecs::World*> worlds{game_world_.get()};
+    if (partitions_) {
+        for (const auto& system_id : partitions_->getPartitionIds()) {
+            worlds.push_back(&partitions_->getPartition(system_id)->getWorld());
+        }
+    }
+    bool saved = world_persistence_.saveWorlds(worlds, filepath);
+    if (market_system_ &&
+        !market_system_->getHistory().saveSegment(config_->save_path + "/market_history.seg")) {
+        saved = false;
+    }
+    return saved;
 }
 
 bool Server::loadWorld() {
     std::string filepath = config_->save_path + "/world_state.json";
-    return world_persistence_.loadWorld(game_world_.get(), filepath);
+    if (!world_persistence_.loadWorld(game_world_.get(), filepath)) {
+        return false;
+    }
+
+    // Price history is optional: a world saved before it existed has none
+    std::string history_path = config_->save_path + "/market_history.seg";
+    if (market_system_ && std::ifstream(history_path).good()) {
+        auto& history = market_system_->getHistory();
+        if (history.loadSegment(history_path)) {
+            market_system_->setSimTime(std::max(market_system_->getSimTime(),
+                                                history.getLatestTime()));
+            utils::Logger::instance().info("Market history loaded (" +
+                std::to_string(history.getSeriesCount()) + " series)");
+        } else {
+            utils::Logger::instance().warn("Failed to load market history from " + history_path);
+        }
+    }
+    return true;
 }
 
 } // namespace atlas
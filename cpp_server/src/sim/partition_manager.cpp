@@ -0,0 +1,238 @@
+#include "sim/partition_manager.h"
+#include "utils/logger.h"
+
+namespace atlas {
+namespace sim {
+
+PartitionManager::PartitionManager(ecs::World* coordinator, int worker_count)
+    : coordinator_(coordinator) {
+    if (worker_count < 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        worker_count = hw > 1 ? static_cast<int>(hw) - 1 : 0;
+    }
+    workers_.reserve(static_cast<size_t>(worker_count));
+    for (int i = 0; i < worker_count; ++i) {
+        workers_.emplace_back(&PartitionManager::workerLoop, this);
+    }
+}
+
+PartitionManager::~PartitionManager() {
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto& t : workers_) {
+        if (t.joinable()) t.join();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Partition management
+// ---------------------------------------------------------------------------
+
+StarSystemPartition* PartitionManager::createPartition(const std::string& system_id,
+                                                       const SystemInstaller& installer) {
+    auto it = partitions_.find(system_id);
+    if (it != partitions_.end()) return it->second.get();
+
+    auto partition = std::make_unique<StarSystemPartition>(system_id);
+    partition->getTimeDilation().setConfig(dilation_config_);
+    StarSystemPartition* ptr = partition.get();
+    if (installer) installer(*ptr);
+    partitions_.emplace(system_id, std::move(partition));
+    return ptr;
+}
+
+StarSystemPartition* PartitionManager::getPartition(const std::string& system_id) {
+    auto it = partitions_.find(system_id);
+    return it != partitions_.end() ? it->second.get() : nullptr;
+}
+
+void PartitionManager::setTimeDilationConfig(const TimeDilation::Config& config) {
+    dilation_config_ = config;
+    for (auto& kv : partitions_) {
+        kv.second->getTimeDilation().setConfig(config);
+    }
+}
+
+std::vector<std::string> PartitionManager::getPartitionIds() const {
+    std::vector<std::string> ids;
+    ids.reserve(partitions_.size());
+    for (const auto& kv : partitions_) ids.push_back(kv.first);
+    return ids;
+}
+
+bool PartitionManager::assignEntity(const std::string& entity_id,
+                                    const std::string& system_id) {
+    auto* partition = getPartition(system_id);
+    if (!partition) return false;
+
+    auto entity = coordinator_->releaseEntity(entity_id);
+    if (!entity) return false;
+
+    partition->getWorld().adoptEntity(std::move(entity));
+    entity_locations_[entity_id] = system_id;
+    return true;
+}
+
+std::string PartitionManager::locateEntity(const std::string& entity_id) const {
+    auto it = entity_locations_.find(entity_id);
+    return it != entity_locations_.end() ? it->second : std::string();
+}
+
+ecs::Entity* PartitionManager::findEntity(const std::string& entity_id) {
+    std::string system_id = locateEntity(entity_id);
+    if (system_id.empty()) return coordinator_->getEntity(entity_id);
+    auto* partition = getPartition(system_id);
+    return partition ? partition->getWorld().getEntity(entity_id) : nullptr;
+}
+
+bool PartitionManager::destroyEntity(const std::string& entity_id) {
+    std::string system_id = locateEntity(entity_id);
+    if (system_id.empty()) {
+        if (!coordinator_->getEntity(entity_id)) return false;
+        coordinator_->destroyEntity(entity_id);
+        return true;
+    }
+
+    entity_locations_.erase(entity_id);
+    auto* partition = getPartition(system_id);
+    if (!partition) return false;
+    if (partition->getWorld().getEntity(entity_id)) {
+        partition->getWorld().destroyEntity(entity_id);
+        return true;
+    }
+    // Routed this tick, not yet adopted
+    return partition->discardInbound(entity_id);
+}
+
+// ---------------------------------------------------------------------------
+// Handoff routing
+// ---------------------------------------------------------------------------
+
+void PartitionManager::requestHandoff(const std::string& entity_id,
+                                      const std::string& to_system,
+                                      HandoffKind kind) {
+    EntityHandoff handoff;
+    handoff.kind = kind;
+    handoff.entity_id = entity_id;
+    handoff.to_system = to_system;
+
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    pending_handoffs_.push_back(std::move(handoff));
+}
+
+void PartitionManager::routeHandoffs() {
+    std::vector<EntityHandoff> handoffs;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        handoffs.swap(pending_handoffs_);
+    }
+    for (auto& kv : partitions_) {
+        auto out = kv.second->takeOutbound();
+        for (auto& h : out) handoffs.push_back(std::move(h));
+    }
+    for (auto& h : handoffs) route(h);
+}
+
+void PartitionManager::route(EntityHandoff& handoff) {
+    auto* destination = getPartition(handoff.to_system);
+    if (!destination) {
+        ++rejected_handoff_count_;
+        utils::Logger::instance().warn("[Partition] Handoff of " + handoff.entity_id +
+                                       " to unknown system " + handoff.to_system);
+        return;
+    }
+
+    std::string current = locateEntity(handoff.entity_id);
+    if (current == handoff.to_system) return;
+
+    ecs::World* source = coordinator_;
+    if (!current.empty()) {
+        auto* owner = getPartition(current);
+        if (!owner) {
+            ++rejected_handoff_count_;
+            return;
+        }
+        source = &owner->getWorld();
+    }
+
+    handoff.entity = source->releaseEntity(handoff.entity_id);
+    if (!handoff.entity) {
+        // Not in its recorded world: destroyed this tick or still in flight
+        ++rejected_handoff_count_;
+        return;
+    }
+
+    handoff.from_system = current;
+    entity_locations_[handoff.entity_id] = handoff.to_system;
+    destination->postInbound(std::move(handoff));
+    ++handoff_count_;
+}
+
+// ---------------------------------------------------------------------------
+// Tick / worker pool
+// ---------------------------------------------------------------------------
+
+void PartitionManager::tick(float delta_time) {
+    if (workers_.empty()) {
+        coordinator_->update(delta_time);
+        for (auto& kv : partitions_) kv.second->update(delta_time);
+        routeHandoffs();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        jobs_.clear();
+        for (auto& kv : partitions_) jobs_.push_back(kv.second.get());
+        job_delta_ = delta_time;
+        next_job_ = 0;
+        finished_workers_ = 0;
+        ++generation_;
+    }
+    work_cv_.notify_all();
+
+    // The calling thread runs the coordinator, then helps with partitions
+    coordinator_->update(delta_time);
+    runPartitionJobs();
+
+    {
+        std::unique_lock<std::mutex> lock(pool_mutex_);
+        done_cv_.wait(lock, [this] { return finished_workers_ == workers_.size(); });
+    }
+
+    routeHandoffs();
+}
+
+void PartitionManager::runPartitionJobs() {
+    for (;;) {
+        size_t i = next_job_.fetch_add(1);
+        if (i >= jobs_.size()) break;
+        jobs_[i]->update(job_delta_);
+    }
+}
+
+void PartitionManager::workerLoop() {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(pool_mutex_);
+            work_cv_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) return;
+            seen = generation_;
+        }
+
+        runPartitionJobs();
+
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex_);
+            ++finished_workers_;
+        }
+        done_cv_.notify_one();
+    }
+}
+
+} // namespace sim
+} // namespace atlas
@@ -0,0 +1,273 @@
+#include "sim/replay_log.h"
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <zlib.h>
+
+namespace atlas {
+namespace sim {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// On-disk layout
+//
+//   header   magic[8] u32 version f32 tick_duration
+//            varint seed_count { str name, u64 value }
+//            varint snapshot_bytes varint compressed_bytes bytes[compressed]
+//   frame    varint ticks_since_last_frame (> 0) varint command_count
+//            { varint client, str raw }
+//   end      varint 0 varint total_ticks
+//
+// str = varint length + bytes; integers are little-endian.
+// ---------------------------------------------------------------------------
+
+constexpr char REPLAY_MAGIC[8] = {'A', 'T', 'L', 'S', 'R', 'P', 'L', 'Y'};
+
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void putString(std::string& out, const std::string& s) {
+    putVarint(out, s.size());
+    out.append(s);
+}
+
+template<typename T>
+void putFixed(std::string& out, T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.append(bytes, sizeof(T));
+}
+
+/// Bounds-checked cursor over a loaded file
+class Reader {
+public:
+    Reader(const std::string& data) : data_(data) {}
+
+    bool varint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos_ >= data_.size()) return false;
+            uint8_t byte = static_cast<uint8_t>(data_[pos_++]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool bytes(std::string& out, uint64_t count) {
+        if (count > data_.size() - pos_) return false;
+        out.assign(data_, pos_, count);
+        pos_ += count;
+        return true;
+    }
+
+    bool string(std::string& out) {
+        uint64_t size = 0;
+        return varint(size) && bytes(out, size);
+    }
+
+    template<typename T>
+    bool fixed(T& value) {
+        if (sizeof(T) > data_.size() - pos_) return false;
+        std::memcpy(&value, data_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    bool atEnd() const { return pos_ >= data_.size(); }
+    size_t remaining() const { return data_.size() - pos_; }
+
+private:
+    const std::string& data_;
+    size_t pos_ = 0;
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Recording
+// ---------------------------------------------------------------------------
+
+bool ReplayRecorder::open(const std::string& path, const std::string& snapshot_json,
+                          float tick_duration,
+                          const std::map<std::string, uint64_t>& seeds) {
+    close();
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    if (!out_.is_open()) {
+        std::cerr << "[ReplayRecorder] Cannot open " << path << std::endl;
+        return false;
+    }
+
+    uLongf compressed_size = compressBound(static_cast<uLong>(snapshot_json.size()));
+    std::string compressed(compressed_size, '\0');
+    if (compress2(reinterpret_cast<Bytef*>(&compressed[0]), &compressed_size,
+                  reinterpret_cast<const Bytef*>(snapshot_json.data()),
+                  static_cast<uLong>(snapshot_json.size()), Z_BEST_SPEED) != Z_OK) {
+        std::cerr << "[ReplayRecorder] Failed to compress the world snapshot" << std::endl;
+        out_.close();
+        return false;
+    }
+    compressed.resize(compressed_size);
+
+    tick_ = 0;
+    last_frame_tick_ = 0;
+    commands_written_ = 0;
+    bytes_written_ = 0;
+
+    std::string header(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    putFixed<uint32_t>(header, VERSION);
+    putFixed<float>(header, tick_duration);
+    putVarint(header, seeds.size());
+    for (const auto& kv : seeds) {
+        putString(header, kv.first);
+        putFixed<uint64_t>(header, kv.second);
+    }
+    putVarint(header, snapshot_json.size());
+    putString(header, compressed);
+    writeBytes(header);
+    return out_.good();
+}
+
+void ReplayRecorder::recordCommand(int32_t client, const std::string& raw) {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    pending_.push_back(ReplayCommand{client, raw});
+}
+
+void ReplayRecorder::endTick() {
+    if (!out_.is_open()) return;
+    ++tick_;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        if (pending_.empty()) return;
+        writing_.swap(pending_);
+    }
+
+    buffer_.clear();
+    putVarint(buffer_, tick_ - last_frame_tick_);
+    putVarint(buffer_, writing_.size());
+    for (const auto& command : writing_) {
+        putVarint(buffer_, static_cast<uint32_t>(command.client));
+        putString(buffer_, command.raw);
+    }
+    writeBytes(buffer_);
+    last_frame_tick_ = tick_;
+    commands_written_ += writing_.size();
+    writing_.clear();
+}
+
+void ReplayRecorder::close() {
+    if (!out_.is_open()) return;
+    buffer_.clear();
+    putVarint(buffer_, 0);
+    putVarint(buffer_, tick_);
+    writeBytes(buffer_);
+    out_.close();
+}
+
+void ReplayRecorder::writeBytes(const std::string& bytes) {
+    out_.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    // Flush per frame so a crash leaves everything up to the last tick
+    out_.flush();
+    bytes_written_ += bytes.size();
+}
+
+// ---------------------------------------------------------------------------
+// Loading
+// ---------------------------------------------------------------------------
+
+bool ReplayLog::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "[ReplayLog] Cannot open " << path << std::endl;
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    *this = ReplayLog();
+    Reader reader(data);
+
+    std::string magic;
+    uint32_t version = 0;
+    if (!reader.bytes(magic, sizeof(REPLAY_MAGIC)) ||
+        std::memcmp(magic.data(), REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0 ||
+        !reader.fixed(version) || version != ReplayRecorder::VERSION ||
+        !reader.fixed(tick_duration_)) {
+        std::cerr << "[ReplayLog] " << path << " is not a version "
+                  << ReplayRecorder::VERSION << " recording" << std::endl;
+        return false;
+    }
+
+    uint64_t seed_count = 0;
+    if (!reader.varint(seed_count)) return false;
+    for (uint64_t i = 0; i < seed_count; ++i) {
+        std::string name;
+        uint64_t value = 0;
+        if (!reader.string(name) || !reader.fixed(value)) return false;
+        seeds_[name] = value;
+    }
+
+    uint64_t snapshot_size = 0;
+    std::string compressed;
+    if (!reader.varint(snapshot_size) || !reader.string(compressed)) return false;
+    if (snapshot_size / 1032 > compressed.size()) return false;  // beyond deflate's ratio
+    snapshot_.resize(snapshot_size);
+    uLongf inflated = static_cast<uLongf>(snapshot_size);
+    if (snapshot_size > 0 &&
+        (uncompress(reinterpret_cast<Bytef*>(&snapshot_[0]), &inflated,
+                    reinterpret_cast<const Bytef*>(compressed.data()),
+                    static_cast<uLong>(compressed.size())) != Z_OK ||
+         inflated != snapshot_size)) {
+        std::cerr << "[ReplayLog] Corrupt world snapshot in " << path << std::endl;
+        return false;
+    }
+
+    // Frames until the end marker; a frame cut off mid-write is dropped
+    uint64_t tick = 0;
+    truncated_ = true;
+    while (!reader.atEnd()) {
+        uint64_t delta = 0;
+        uint64_t count = 0;
+        if (!reader.varint(delta) || !reader.varint(count)) break;
+        if (delta == 0) {
+            tick_count_ = count;
+            truncated_ = false;
+            break;
+        }
+
+        if (count > reader.remaining()) break;  // every command takes >= 2 bytes
+
+        ReplayFrame frame;
+        frame.tick = tick + delta;
+        frame.commands.resize(count);
+        bool complete = true;
+        for (auto& command : frame.commands) {
+            uint64_t client = 0;
+            if (!reader.varint(client) || !reader.string(command.raw)) {
+                complete = false;
+                break;
+            }
+            command.client = static_cast<int32_t>(static_cast<uint32_t>(client));
+        }
+        if (!complete) break;
+
+        tick = frame.tick;
+        command_count_ += count;
+        frames_.push_back(std::move(frame));
+    }
+    if (truncated_) tick_count_ = tick;
+    return true;
+}
+
+uint64_t ReplayLog::getSeed(const std::string& name, uint64_t fallback) const {
+    auto it = seeds_.find(name);
+    return it != seeds_.end() ? it->second : fallback;
+}
+
+} // namespace sim
+} // namespace atlas
@@ -0,0 +1,113 @@
+#include "sim/star_system_partition.h"
+#include <algorithm>
+#include <chrono>
+
+namespace atlas {
+namespace sim {
+
+StarSystemPartition::StarSystemPartition(const std::string& system_id)
+    : system_id_(system_id) {
+}
+
+void StarSystemPartition::update(float delta_time) {
+    if (!isMidStep()) {
+        std::vector<EntityHandoff> arrivals;
+        {
+            std::lock_guard<std::mutex> lock(inbound_mutex_);
+            arrivals.swap(inbound_);
+        }
+        for (auto& handoff : arrivals) {
+            world_.adoptEntity(std::move(handoff.entity));
+        }
+    }
+
+    // A dilated system skips whole steps rather than shrinking them, so
+    // its cost per wall second falls with the factor.  The clock runs on
+    // every tick, including those spent on a step's later slices.
+    if (dilation_.beginTick(delta_time)) {
+        if (isMidStep()) step_owed_ = true;
+        else startStep(delta_time);
+    } else if (!isMidStep() && step_owed_) {
+        step_owed_ = false;
+        startStep(delta_time);
+    }
+    if (isMidStep()) runSlice();
+}
+
+void StarSystemPartition::startStep(float delta_time) {
+    // One slice per wall tick until the next step is due
+    size_t slices = 1;
+    float factor = dilation_.getFactor();
+    if (factor < 1.0f) slices = static_cast<size_t>(1.0f / factor + 0.01f);
+    size_t systems = std::max<size_t>(1, world_.getSystemCount());
+    slices = std::max<size_t>(1, std::min(slices, systems));
+
+    systems_per_slice_ = (systems + slices - 1) / slices;
+    step_delta_ = delta_time;
+    step_ms_ = 0.0;
+    next_system_ = 0;
+    mid_step_ = true;
+}
+
+void StarSystemPartition::runSlice() {
+    size_t first = next_system_;
+    size_t last = first + systems_per_slice_;
+
+    auto start = std::chrono::steady_clock::now();
+    world_.updateSystems(first, last, step_delta_);
+    auto end = std::chrono::steady_clock::now();
+    step_ms_ += std::chrono::duration<double, std::milli>(end - start).count();
+
+    if (last < world_.getSystemCount()) {
+        next_system_ = last;
+        return;
+    }
+
+    mid_step_ = false;
+    simulated_seconds_ += step_delta_;
+    last_tick_ms_ = step_ms_;
+    ++tick_count_;
+    dilation_.update(last_tick_ms_, dilation_.getStepWallSeconds());
+}
+
+void StarSystemPartition::requestHandoff(const std::string& entity_id,
+                                         const std::string& to_system,
+                                         HandoffKind kind) {
+    EntityHandoff handoff;
+    handoff.kind = kind;
+    handoff.entity_id = entity_id;
+    handoff.from_system = system_id_;
+    handoff.to_system = to_system;
+
+    std::lock_guard<std::mutex> lock(outbound_mutex_);
+    outbound_.push_back(std::move(handoff));
+}
+
+void StarSystemPartition::postInbound(EntityHandoff handoff) {
+    std::lock_guard<std::mutex> lock(inbound_mutex_);
+    inbound_.push_back(std::move(handoff));
+}
+
+bool StarSystemPartition::discardInbound(const std::string& entity_id) {
+    std::lock_guard<std::mutex> lock(inbound_mutex_);
+    auto it = std::find_if(inbound_.begin(), inbound_.end(),
+                           [&](const EntityHandoff& h) { return h.entity_id == entity_id; });
+    if (it == inbound_.end()) return false;
+    inbound_.erase(it);
+    return true;
+}
+
+std::vector<EntityHandoff> StarSystemPartition::takeOutbound() {
+    std::vector<EntityHandoff> out;
+    std::lock_guard<std::mutex> lock(outbound_mutex_);
+    out.swap(outbound_);
+    return out;
+}
+
+size_t StarSystemPartition::getPendingInbound() const {
+    std::lock_guard<std::mutex> lock(inbound_mutex_);
+    return inbound_.size();
+}
+
+} // namespace sim
+} // namespace atlas
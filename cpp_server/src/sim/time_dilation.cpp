@@ -0,0 +1,61 @@
+#include "sim/time_dilation.h"
+#include <algorithm>
+
+namespace atlas {
+namespace sim {
+
+void TimeDilation::setConfig(const Config& config) {
+    config_ = config;
+    config_.floor = std::min(1.0f, std::max(0.01f, config_.floor));
+    config_.smoothing = std::min(1.0f, std::max(0.01f, config_.smoothing));
+    if (!config_.enabled) reset();
+}
+
+void TimeDilation::reset() {
+    factor_ = 1.0f;
+    smoothed_ms_ = 0.0;
+    has_sample_ = false;
+    backlog_ = 0.0f;
+}
+
+bool TimeDilation::beginTick(float delta_time) {
+    wall_since_step_ += delta_time;
+    backlog_ += apply(delta_time);
+    // Slack for float drift, so an undilated clock steps on every tick
+    if (backlog_ < delta_time * 0.999f) return false;
+
+    backlog_ = std::max(0.0f, backlog_ - delta_time);
+    step_wall_seconds_ = wall_since_step_;
+    wall_since_step_ = 0.0f;
+    return true;
+}
+
+float TimeDilation::update(double tick_ms, float wall_dt) {
+    if (!config_.enabled) return factor_;
+
+    if (!has_sample_) {
+        smoothed_ms_ = tick_ms;
+        has_sample_ = true;
+    } else {
+        smoothed_ms_ += config_.smoothing * (tick_ms - smoothed_ms_);
+    }
+
+    float target = 1.0f;
+    if (config_.budget_ms > 0.0 && smoothed_ms_ > config_.budget_ms) {
+        target = static_cast<float>(config_.budget_ms / smoothed_ms_);
+    }
+    target = std::max(config_.floor, target);
+
+    if (target < factor_) {
+        // Overload: slow down immediately
+        factor_ = target;
+    } else {
+        // Recovery: ease back towards real time
+        float step = config_.recovery_per_second * std::max(0.0f, wall_dt);
+        factor_ = std::min(target, factor_ + step);
+    }
+    return factor_;
+}
+
+} // namespace sim
+} // namespace atlas
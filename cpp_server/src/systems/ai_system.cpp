@@ -2,6 +2,8 @@
 #include "systems/combat_system.h"
 #include "ecs/world.h"
 #include "components/game_components.h"
+#include "data/ship_template_registry.h"
+#include "systems/game_events.h"
 #include <cmath>
 #include <limits>
 #include <algorithm>
@@ -80,9 +82,9 @@ void AISystem::idleBehavior(ecs::Entity* entity) {
     
     // Apply dynamic orbit distance from ship class if enabled
     if (ai->use_dynamic_orbit) {
-        auto* ship = entity->getComponent<components::Ship>();
-        if (ship) {
-            ai->orbit_distance = orbitDistanceForClass(ship->ship_class);
+        std::string ship_class = data::entityShipClass(*entity);
+        if (!ship_class.empty()) {
+            ai->orbit_distance = orbitDistanceForClass(ship_class);
         }
     }
     
@@ -456,48 +458,77 @@ ecs::Entity* AISystem::findNearestDeposit(ecs::Entity* entity) {
     return nearest;
 }
 
+namespace {
+
+/// Is @p other within @p range of @p pos and positively disposed to us?
+bool isFriendlyInRange(const ecs::Entity* self, const components::Faction& our_faction,
+                       ecs::Entity* other, const components::Position& pos, float range) {
+    auto* o_pos = other->getComponent<components::Position>();
+    if (!o_pos) return false;
+
+    float dx = o_pos->x - pos.x;
+    float dy = o_pos->y - pos.y;
+    float dz = o_pos->z - pos.z;
+    float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+    if (dist > range) return false;
+
+    // Check if this entity is friendly to us
+    auto* their_standings = other->getComponent<components::Standings>();
+    auto* their_faction = other->getComponent<components::Faction>();
+    if (their_standings) {
+        float standing = their_standings->getStandingWith(
+            self->getId(), "", our_faction.faction_name);
+        return standing > 0.0f;
+    }
+    if (their_faction) {
+        auto it = our_faction.standings.find(their_faction->faction_name);
+        if (it != our_faction.standings.end()) {
+            return it->second > 0.0f;
+        }
+    }
+    return false;
+}
+
+/// True if we hold positive standing with @p other's faction
+bool isAlliedFaction(const components::Faction& our_faction, ecs::Entity* other) {
+    auto* their_faction = other->getComponent<components::Faction>();
+    if (!their_faction) return false;
+    auto it = our_faction.standings.find(their_faction->faction_name);
+    return it != our_faction.standings.end() && it->second > 0.0f;
+}
+
+} // anonymous namespace
+
 ecs::Entity* AISystem::findAttackerOfFriendly(ecs::Entity* entity) {
     auto* ai = entity->getComponent<components::AI>();
     auto* pos = entity->getComponent<components::Position>();
     auto* our_faction = entity->getComponent<components::Faction>();
     if (!ai || !pos || !our_faction) return nullptr;
 
+    // Fast path: last tick's damage events name both victim and attacker,
+    // so only entities that were actually hit are examined
+    for (const auto& hit : world_->events().read<DamageDealtEvent>()) {
+        if (hit.attacker_id.empty() || hit.target_id == entity->getId()) continue;
+        auto* attacker = world_->getEntity(hit.attacker_id);
+        auto* friendly = world_->getEntity(hit.target_id);
+        if (!attacker || !friendly || attacker == entity) continue;
+        if (!isFriendlyInRange(entity, *our_faction, friendly, *pos, ai->awareness_range)) continue;
+        if (isAlliedFaction(*our_faction, attacker)) continue;
+        return attacker;
+    }
+
+    // Hits recorded outside the bus (or without an attacker) still leave a
+    // DamageEvent component; fall back to matching AI targets
     auto candidates = world_->getEntities<components::Position, components::DamageEvent>();
 
     for (auto* friendly : candidates) {
         if (friendly == entity) continue;
-
-        auto* f_pos = friendly->getComponent<components::Position>();
-        if (!f_pos) continue;
-
-        float dx = f_pos->x - pos->x;
-        float dy = f_pos->y - pos->y;
-        float dz = f_pos->z - pos->z;
-        float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
-        if (dist > ai->awareness_range) continue;
-
-        // Check if this entity is friendly to us
-        auto* their_standings = friendly->getComponent<components::Standings>();
-        auto* their_faction = friendly->getComponent<components::Faction>();
-        bool is_friendly = false;
-        if (their_standings) {
-            float standing = their_standings->getStandingWith(
-                entity->getId(), "", our_faction->faction_name);
-            is_friendly = (standing > 0.0f);
-        } else if (their_faction) {
-            auto it = our_faction->standings.find(their_faction->faction_name);
-            if (it != our_faction->standings.end()) {
-                is_friendly = (it->second > 0.0f);
-            }
-        }
-
-        if (!is_friendly) continue;
+        if (!isFriendlyInRange(entity, *our_faction, friendly, *pos, ai->awareness_range)) continue;
 
         // This entity is friendly and has damage events — find who is attacking them
         auto* dmg = friendly->getComponent<components::DamageEvent>();
         if (!dmg || dmg->recent_hits.empty()) continue;
 
-        // The most recent hit's source is the attacker
         // DamageEvent doesn't store attacker id, so look for nearby hostiles
         // targeting this friendly entity
         auto all_ai = world_->getEntities<components::AI, components::Position>();
@@ -508,11 +539,7 @@ ecs::Entity* AISystem::findAttackerOfFriendly(ecs::Entity* entity) {
             if (atk_ai->target_entity_id != friendly->getId()) continue;
 
             // Confirm the attacker is hostile to us
-            auto* atk_faction = potential_attacker->getComponent<components::Faction>();
-            if (atk_faction) {
-                auto it = our_faction->standings.find(atk_faction->faction_name);
-                if (it != our_faction->standings.end() && it->second > 0.0f) continue;
-            }
+            if (isAlliedFaction(*our_faction, potential_attacker)) continue;
 
             return potential_attacker;
         }
@@ -1,4 +1,5 @@
 #include "systems/ambient_traffic_system.h"
+#include "systems/background_simulation_system.h"
 #include "ecs/world.h"
 #include <algorithm>
 
@@ -10,17 +11,34 @@ AmbientTrafficSystem::AmbientTrafficSystem(ecs::World* world)
 }
 
 void AmbientTrafficSystem::update(float delta_time) {
+    // Attached: advanceSystem() runs as each system advances
+    if (attached_) return;
+
     auto entities = world_->getEntities<components::AmbientTrafficState>();
     for (auto* entity : entities) {
-        auto* traffic = entity->getComponent<components::AmbientTrafficState>();
-        auto* state   = entity->getComponent<components::SimStarSystemState>();
-        if (!traffic || !state) continue;
-
-        traffic->spawn_timer -= delta_time;
-        if (traffic->spawn_timer <= 0.0f) {
-            traffic->spawn_timer = spawn_interval;
-            evaluateSpawns(entity, traffic, state);
-        }
+        advanceSystem(entity, delta_time);
+    }
+}
+
+void AmbientTrafficSystem::attach(BackgroundSimulationSystem* background) {
+    attached_ = true;
+    background->addAdvanceListener([this](ecs::Entity* system, float dt) {
+        advanceSystem(system, dt);
+    });
+}
+
+void AmbientTrafficSystem::advanceSystem(ecs::Entity* entity, float dt) {
+    auto* traffic = entity->getComponent<components::AmbientTrafficState>();
+    auto* state   = entity->getComponent<components::SimStarSystemState>();
+    if (!traffic || !state) return;
+
+    // Dormant systems (nobody watching) run their spawn clock slower
+    traffic->spawn_timer -= state->dormant
+        ? dt / std::max(dormant_spawn_multiplier, 1.0f)
+        : dt;
+    if (traffic->spawn_timer <= 0.0f) {
+        traffic->spawn_timer = spawn_interval;
+        evaluateSpawns(entity, traffic, state);
     }
 }
 
@@ -1,7 +1,10 @@
 #include "systems/background_simulation_system.h"
 #include "ecs/world.h"
+#include "data/market_history.h"
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <unordered_map>
 
 namespace atlas {
 namespace systems {
@@ -11,17 +14,185 @@ BackgroundSimulationSystem::BackgroundSimulationSystem(ecs::World* world)
 }
 
 void BackgroundSimulationSystem::update(float delta_time) {
+    now_ += delta_time;
+    if (market_history_ && trade_clock_) applyMarketTrends();
+
+    if (fast_forward_) {
+        updateFastForward(delta_time);
+        return;
+    }
+
     auto entities = world_->getEntities<components::SimStarSystemState>();
     for (auto* entity : entities) {
         auto* state = entity->getComponent<components::SimStarSystemState>();
         if (!state) continue;
 
-        updateSystemState(state, delta_time);
-        evaluateEvents(entity->getId(), state);
-        tickEventTimers(state, delta_time);
+        tickSystem(entity->getId(), state, delta_time);
+        state->synced_at = now_;
+        notifyAdvance(entity, delta_time);
     }
 }
 
+void BackgroundSimulationSystem::notifyAdvance(ecs::Entity* system, float dt) {
+    for (const auto& listener : listeners_) listener(system, dt);
+}
+
+void BackgroundSimulationSystem::tickSystem(const std::string& system_id,
+                                            components::SimStarSystemState* state,
+                                            float dt) {
+    updateSystemState(state, dt);
+    evaluateEvents(system_id, state);
+    tickEventTimers(state, dt);
+}
+
+// -----------------------------------------------------------------------
+// Fast-forward: observed systems tick, dormant ones catch up on a cadence
+// -----------------------------------------------------------------------
+
+void BackgroundSimulationSystem::setFastForward(bool enabled) {
+    if (enabled == fast_forward_) return;
+    fast_forward_ = enabled;
+
+    if (enabled) {
+        discoverSystems();
+        next_discovery_ = now_ + dormant_sync_interval;
+        return;
+    }
+
+    // Back to per-frame ticking: bring every dormant system up to date
+    for (auto* entity : world_->getEntities<components::SimStarSystemState>()) {
+        auto* state = entity->getComponent<components::SimStarSystemState>();
+        if (!state || !state->dormant) continue;
+        catchUp(entity, state);
+        state->dormant = false;
+    }
+    for (const auto& id : known_) dormant_wheel_.cancel(id);
+    known_.clear();
+    live_.clear();
+}
+
+void BackgroundSimulationSystem::updateFastForward(float delta_time) {
+    // Systems created since the last scan are picked up on the slow cadence
+    if (now_ >= next_discovery_) {
+        discoverSystems();
+        next_discovery_ = now_ + dormant_sync_interval;
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < live_.size(); ++i) {
+        auto* entity = world_->getEntity(live_[i]);
+        auto* state = entity ? entity->getComponent<components::SimStarSystemState>() : nullptr;
+        if (!state) {
+            known_.erase(live_[i]);
+            continue;
+        }
+        tickSystem(live_[i], state, delta_time);
+        state->synced_at = now_;
+        notifyAdvance(entity, delta_time);
+        if (kept != i) live_[kept] = std::move(live_[i]);
+        ++kept;
+    }
+    live_.resize(kept);
+
+    due_.clear();
+    dormant_wheel_.advance(now_, due_);
+    for (const auto& timer : due_) {
+        auto* entity = world_->getEntity(timer.key);
+        auto* state = entity ? entity->getComponent<components::SimStarSystemState>() : nullptr;
+        if (!state || !state->dormant) {
+            known_.erase(timer.key);
+            continue;
+        }
+        catchUp(entity, state);
+        dormant_wheel_.schedule(timer.key, now_ + dormant_sync_interval);
+    }
+}
+
+void BackgroundSimulationSystem::discoverSystems() {
+    for (auto* entity : world_->getEntities<components::SimStarSystemState>()) {
+        const std::string& id = entity->getId();
+        if (known_.count(id)) continue;
+        auto* state = entity->getComponent<components::SimStarSystemState>();
+        if (!state) continue;
+
+        known_.insert(id);
+        state->synced_at = now_;
+        if (state->observers > 0) {
+            state->dormant = false;
+            live_.push_back(id);
+            continue;
+        }
+        // Stagger first catch-ups across the interval so a whole universe
+        // suspended at once does not come due on the same tick
+        double offset = static_cast<double>(std::hash<std::string>{}(id) % 1024)
+                      / 1024.0 * dormant_sync_interval;
+        suspend(id, state, now_ + offset);
+    }
+}
+
+void BackgroundSimulationSystem::suspend(const std::string& system_id,
+                                         components::SimStarSystemState* state,
+                                         double first_sync) {
+    state->dormant = true;
+    dormant_wheel_.schedule(system_id, first_sync);
+}
+
+void BackgroundSimulationSystem::catchUp(ecs::Entity* entity,
+                                         components::SimStarSystemState* state) {
+    double elapsed = now_ - state->synced_at;
+    state->synced_at = now_;
+    if (elapsed <= 0.0) return;
+
+    // A handful of coarse steps: the drift is exact per step, the steps
+    // only bound how late a threshold event can be noticed
+    double step_hint = std::max(static_cast<double>(fast_forward_step), 1e-3);
+    int steps = static_cast<int>(std::ceil(elapsed / step_hint));
+    steps = std::clamp(steps, 1, std::max(fast_forward_max_steps, 1));
+    float step = static_cast<float>(elapsed / steps);
+    for (int i = 0; i < steps; ++i) {
+        tickSystem(entity->getId(), state, step);
+    }
+    ++catch_ups_;
+    notifyAdvance(entity, static_cast<float>(elapsed));
+}
+
+void BackgroundSimulationSystem::addObserver(const std::string& system_id) {
+    auto* entity = world_->getEntity(system_id);
+    auto* state = entity ? entity->getComponent<components::SimStarSystemState>() : nullptr;
+    if (!state) return;
+
+    ++state->observers;
+    if (!fast_forward_) return;
+
+    if (state->dormant) {
+        catchUp(entity, state);
+        state->dormant = false;
+        dormant_wheel_.cancel(system_id);
+        live_.push_back(system_id);
+    } else if (known_.insert(system_id).second) {
+        state->synced_at = now_;
+        live_.push_back(system_id);
+    }
+}
+
+void BackgroundSimulationSystem::removeObserver(const std::string& system_id) {
+    auto* entity = world_->getEntity(system_id);
+    auto* state = entity ? entity->getComponent<components::SimStarSystemState>() : nullptr;
+    if (!state || state->observers <= 0) return;
+
+    --state->observers;
+    if (!fast_forward_ || state->observers > 0 || state->dormant) return;
+    if (!known_.count(system_id)) return;  // the next discovery suspends it
+
+    live_.erase(std::remove(live_.begin(), live_.end(), system_id), live_.end());
+    suspend(system_id, state, now_ + dormant_sync_interval);
+}
+
+bool BackgroundSimulationSystem::isDormant(const std::string& system_id) const {
+    auto* state = getSystemState(system_id);
+    return state && state->dormant;
+}
+
 // -----------------------------------------------------------------------
 // State drift: values move toward equilibrium over time
 // -----------------------------------------------------------------------
@@ -46,9 +217,10 @@ void BackgroundSimulationSystem::updateSystemState(
             state->resource_availability + resource_regen_rate * dt);
     }
 
-    // Traffic drifts toward baseline (0.5)
+    // Traffic relaxes exponentially toward baseline (0.5); exact for any
+    // dt, so fast-forward catch-ups can take long steps
     float traffic_diff = 0.5f - state->traffic_level;
-    state->traffic_level += traffic_diff * traffic_fluctuation_rate * dt;
+    state->traffic_level += traffic_diff * (1.0f - std::exp(-traffic_fluctuation_rate * dt));
 
     // Pirate activity increases when security is low
     if (state->security_level < 0.3f) {
@@ -66,6 +238,31 @@ void BackgroundSimulationSystem::updateSystemState(
     state->price_modifier = std::clamp(state->price_modifier, 0.5f, 2.0f);
 }
 
+// -----------------------------------------------------------------------
+// Market feed: trade volume from aggregated history, not order books
+// -----------------------------------------------------------------------
+
+void BackgroundSimulationSystem::applyMarketTrends() {
+    double now = trade_clock_();
+    std::unordered_map<std::string, int64_t> volume_by_system;
+    for (auto* entity : world_->getEntities<components::MarketHub>()) {
+        auto* hub = entity->getComponent<components::MarketHub>();
+        if (!hub || hub->system_id.empty()) continue;
+        volume_by_system[hub->system_id] += market_history_->getHubVolume(
+            entity->getId(), data::MarketHistory::Resolution::OneHour, 1, now);
+    }
+    if (market_reference_volume <= 0.0f) return;
+
+    for (const auto& kv : volume_by_system) {
+        auto* entity = world_->getEntity(kv.first);
+        if (!entity) continue;
+        auto* state = entity->getComponent<components::SimStarSystemState>();
+        if (!state) continue;
+        state->trade_volume = std::clamp(
+            static_cast<float>(kv.second) / market_reference_volume, 0.0f, 1.0f);
+    }
+}
+
 // -----------------------------------------------------------------------
 // Threshold-based event evaluation
 // -----------------------------------------------------------------------
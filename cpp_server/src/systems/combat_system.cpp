@@ -1,6 +1,7 @@
 #include "systems/combat_system.h"
 #include "ecs/world.h"
 #include "components/game_components.h"
+#include "systems/game_events.h"
 #include <cmath>
 #include <algorithm>
 #include <memory>
@@ -17,15 +18,80 @@ void CombatSystem::update(float delta_time) {
     // Shield recharge is handled by ShieldRechargeSystem.
     // Capacitor recharge is handled by CapacitorSystem.
     // Weapon cooldowns and auto-fire are handled by WeaponSystem.
+
+    // Resolve the hits weapons queued this tick, one batch per target
+    for (const auto& resolved : pipeline_.flush(*world_)) {
+        if (resolved.destroyed) {
+            notifyDeath(world_->getEntity(resolved.target_id), resolved.attacker_id);
+        }
+    }
+}
+
+bool CombatSystem::queueDamage(const std::string& target_id, float damage, DamageType damage_type,
+                               const std::string& attacker_id) {
+    return pipeline_.queue(target_id, damage, damage_type, attacker_id);
+}
+
+void CombatSystem::notifyDeath(ecs::Entity* target, const std::string& killer_id) {
+    if (!target) return;
+    auto* pos = target->getComponent<components::Position>();
+    float px = pos ? pos->x : 0.0f;
+    float py = pos ? pos->y : 0.0f;
+    float pz = pos ? pos->z : 0.0f;
+
+    EntityKilledEvent killed;
+    killed.victim_id = target->getId();
+    killed.killer_id = killer_id;
+    killed.x = px;
+    killed.y = py;
+    killed.z = pz;
+    world_->events().emit(killed);
+
+    if (death_callback_) death_callback_(target->getId(), px, py, pz);
 }
 
-bool CombatSystem::applyDamage(const std::string& target_id, float damage, const std::string& damage_type) {
+void CombatSystem::recordHit(ecs::Entity* target, const components::Health& health,
+                             float hp_before, float damage, const std::string& damage_type,
+                             const std::string& layer_hit, bool shield_depleted,
+                             bool armor_depleted, bool hull_critical,
+                             const std::string& attacker_id) {
+    auto* dmgEvent = target->getComponent<components::DamageEvent>();
+    if (!dmgEvent) {
+        target->addComponent(std::make_unique<components::DamageEvent>());
+        dmgEvent = target->getComponent<components::DamageEvent>();
+    }
+    if (dmgEvent) {
+        dmgEvent->addHit(damage, damage_type, layer_hit,
+                         dmgEvent->last_hit_time + 1.0f,
+                         shield_depleted, armor_depleted, hull_critical);
+    }
+
+    DamageDealtEvent dealt;
+    dealt.target_id = target->getId();
+    dealt.attacker_id = attacker_id;
+    dealt.damage = damage;
+    dealt.applied = hp_before - (health.shield_hp + health.armor_hp + health.hull_hp);
+    dealt.damage_type = damage_type;
+    dealt.layer_hit = layer_hit;
+    dealt.shield_depleted = shield_depleted;
+    dealt.armor_depleted = armor_depleted;
+    dealt.hull_critical = hull_critical;
+    dealt.destroyed = health.hull_hp <= 0.0f;
+    world_->events().emit(dealt);
+}
+
+bool CombatSystem::applyDamage(const std::string& target_id, float damage, const std::string& damage_type,
+                               const std::string& attacker_id) {
     auto* target = world_->getEntity(target_id);
     if (!target) return false;
     
     auto* health = target->getComponent<components::Health>();
     if (!health) return false;
     
+    float hp_before = health->shield_hp + health->armor_hp + health->hull_hp;
+
+    DamageType type = parseDamageType(damage_type);
+    
     // Track which layer absorbs the initial hit for damage events
     std::string layer_hit = "shield";
     bool shield_depleted = false;
@@ -40,7 +106,7 @@ bool CombatSystem::applyDamage(const std::string& target_id, float damage, const
             health->shield_thermal_resist,
             health->shield_kinetic_resist,
             health->shield_explosive_resist,
-            damage_type
+            type
         );
         float effective_damage = calculateDamage(damage, resist);
         health->shield_hp -= effective_damage;
@@ -53,15 +119,8 @@ bool CombatSystem::applyDamage(const std::string& target_id, float damage, const
             damage = overflow_damage;
         } else {
             // Record damage event - shield absorbed all damage
-            auto* dmgEvent = target->getComponent<components::DamageEvent>();
-            if (!dmgEvent) {
-                target->addComponent(std::make_unique<components::DamageEvent>());
-                dmgEvent = target->getComponent<components::DamageEvent>();
-            }
-            if (dmgEvent) {
-                dmgEvent->addHit(original_damage, damage_type, "shield",
-                                 dmgEvent->last_hit_time + 1.0f);
-            }
+            recordHit(target, *health, hp_before, original_damage, damage_type, "shield",
+                      false, false, false, attacker_id);
             return true;  // All damage absorbed by shields
         }
     } else {
@@ -76,7 +135,7 @@ bool CombatSystem::applyDamage(const std::string& target_id, float damage, const
             health->armor_thermal_resist,
             health->armor_kinetic_resist,
             health->armor_explosive_resist,
-            damage_type
+            type
         );
         float effective_damage = calculateDamage(damage, resist);
         health->armor_hp -= effective_damage;
@@ -89,16 +148,8 @@ bool CombatSystem::applyDamage(const std::string& target_id, float damage, const
             damage = overflow_damage;
         } else {
             // Record damage event - armor absorbed remaining damage
-            auto* dmgEvent = target->getComponent<components::DamageEvent>();
-            if (!dmgEvent) {
-                target->addComponent(std::make_unique<components::DamageEvent>());
-                dmgEvent = target->getComponent<components::DamageEvent>();
-            }
-            if (dmgEvent) {
-                dmgEvent->addHit(original_damage, damage_type, layer_hit,
-                                 dmgEvent->last_hit_time + 1.0f,
-                                 shield_depleted, false, false);
-            }
+            recordHit(target, *health, hp_before, original_damage, damage_type, layer_hit,
+                      shield_depleted, false, false, attacker_id);
             return true;  // All damage absorbed by armor
         }
     } else {
@@ -113,7 +164,7 @@ bool CombatSystem::applyDamage(const std::string& target_id, float damage, const
             health->hull_thermal_resist,
             health->hull_kinetic_resist,
             health->hull_explosive_resist,
-            damage_type
+            type
         );
         float effective_damage = calculateDamage(damage, resist);
         health->hull_hp -= effective_damage;
@@ -126,24 +177,12 @@ bool CombatSystem::applyDamage(const std::string& target_id, float damage, const
     }
     
     // Record damage event
-    auto* dmgEvent = target->getComponent<components::DamageEvent>();
-    if (!dmgEvent) {
-        target->addComponent(std::make_unique<components::DamageEvent>());
-        dmgEvent = target->getComponent<components::DamageEvent>();
-    }
-    if (dmgEvent) {
-        dmgEvent->addHit(original_damage, damage_type, layer_hit,
-                         dmgEvent->last_hit_time + 1.0f,
-                         shield_depleted, armor_depleted, hull_critical);
-    }
+    recordHit(target, *health, hp_before, original_damage, damage_type, layer_hit,
+              shield_depleted, armor_depleted, hull_critical, attacker_id);
     
     // Fire death callback when hull reaches zero
-    if (health->hull_hp <= 0.0f && death_callback_) {
-        auto* pos = target->getComponent<components::Position>();
-        float px = pos ? pos->x : 0.0f;
-        float py = pos ? pos->y : 0.0f;
-        float pz = pos ? pos->z : 0.0f;
-        death_callback_(target_id, px, py, pz);
+    if (health->hull_hp <= 0.0f) {
+        notifyDeath(target, attacker_id);
     }
     
     return true;
@@ -184,7 +223,7 @@ bool CombatSystem::fireWeapon(const std::string& shooter_id, const std::string&
     
     // Apply damage
     float effective_damage = weapon->damage * damage_multiplier;
-    applyDamage(target_id, effective_damage, weapon->damage_type);
+    applyDamage(target_id, effective_damage, weapon->damage_type, shooter_id);
     
     // Set weapon cooldown and consume ammo
     weapon->cooldown = weapon->rate_of_fire;
@@ -200,12 +239,14 @@ float CombatSystem::calculateDamage(float base_damage, float resistance) {
 
 float CombatSystem::getResistance(float em_resist, float thermal_resist,
                                   float kinetic_resist, float explosive_resist,
-                                  const std::string& damage_type) {
-    if (damage_type == "em") return em_resist;
-    if (damage_type == "thermal") return thermal_resist;
-    if (damage_type == "kinetic") return kinetic_resist;
-    if (damage_type == "explosive") return explosive_resist;
-    return 0.0f;  // Unknown damage type, no resistance
+                                  DamageType damage_type) {
+    switch (damage_type) {
+        case DamageType::EM:        return em_resist;
+        case DamageType::Thermal:   return thermal_resist;
+        case DamageType::Kinetic:   return kinetic_resist;
+        case DamageType::Explosive: return explosive_resist;
+        default:                    return 0.0f;  // Unknown damage type, no resistance
+    }
 }
 
 } // namespace systems
@@ -0,0 +1,241 @@
+#include "systems/damage_pipeline.h"
+#include "ecs/world.h"
+#include "components/game_components.h"
+#include "systems/game_events.h"
+#include <algorithm>
+#include <memory>
+
+namespace atlas {
+namespace systems {
+
+DamageType parseDamageType(const std::string& name) {
+    if (name == "em") return DamageType::EM;
+    if (name == "thermal") return DamageType::Thermal;
+    if (name == "kinetic") return DamageType::Kinetic;
+    if (name == "explosive") return DamageType::Explosive;
+    return DamageType::Count;
+}
+
+const char* damageTypeName(DamageType type) {
+    switch (type) {
+        case DamageType::EM:        return "em";
+        case DamageType::Thermal:   return "thermal";
+        case DamageType::Kinetic:   return "kinetic";
+        case DamageType::Explosive: return "explosive";
+        default:                    return "unknown";
+    }
+}
+
+namespace {
+
+/**
+ * Absorb as much of @p damage as one layer allows.  Returns true if the
+ * layer soaked everything (or resisted it fully), false if damage carries
+ * on to the next layer.
+ */
+bool absorbLayer(float& hp, const float (&resist)[DAMAGE_TYPE_COUNT],
+                 DamageVector& damage, float& applied, bool& depleted) {
+    float effective = 0.0f;
+    for (int t = 0; t < DAMAGE_TYPE_COUNT; ++t) {
+        effective += damage.amount[t] * (1.0f - resist[t]);
+    }
+    if (effective <= 0.0f) return true;
+
+    if (effective <= hp) {
+        hp -= effective;
+        applied += effective;
+        return true;
+    }
+
+    // Layer breaks: the unabsorbed fraction carries on as raw damage
+    float carry = 1.0f - hp / effective;
+    applied += hp;
+    hp = 0.0f;
+    depleted = true;
+    for (int t = 0; t < DAMAGE_TYPE_COUNT; ++t) {
+        damage.amount[t] *= carry;
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+LayerResult applyDamageVector(components::Health& health, DamageVector damage) {
+    LayerResult result;
+    result.layer_hit = "shield";
+    if (damage.total() <= 0.0f) return result;
+
+    bool was_alive = health.hull_hp > 0.0f;
+
+    if (health.shield_hp > 0.0f) {
+        const float resist[DAMAGE_TYPE_COUNT] = {
+            health.shield_em_resist, health.shield_thermal_resist,
+            health.shield_kinetic_resist, health.shield_explosive_resist};
+        if (absorbLayer(health.shield_hp, resist, damage,
+                        result.applied, result.shield_depleted)) {
+            return result;
+        }
+    }
+
+    if (health.armor_hp > 0.0f) {
+        result.layer_hit = "armor";
+        const float resist[DAMAGE_TYPE_COUNT] = {
+            health.armor_em_resist, health.armor_thermal_resist,
+            health.armor_kinetic_resist, health.armor_explosive_resist};
+        if (absorbLayer(health.armor_hp, resist, damage,
+                        result.applied, result.armor_depleted)) {
+            return result;
+        }
+    }
+
+    if (health.hull_hp > 0.0f) {
+        result.layer_hit = "hull";
+        const float resist[DAMAGE_TYPE_COUNT] = {
+            health.hull_em_resist, health.hull_thermal_resist,
+            health.hull_kinetic_resist, health.hull_explosive_resist};
+        bool hull_gone = false;
+        absorbLayer(health.hull_hp, resist, damage, result.applied, hull_gone);
+        result.hull_critical = health.hull_hp < health.hull_max * 0.25f;
+        result.destroyed = was_alive && health.hull_hp <= 0.0f;
+    }
+    return result;
+}
+
+bool DamagePipeline::queue(const std::string& target_id, float amount, DamageType type,
+                           const std::string& source_id) {
+    if (type == DamageType::Count || !(amount > 0.0f)) return false;
+
+    auto it = target_slots_.find(target_id);
+    uint32_t slot;
+    if (it == target_slots_.end()) {
+        slot = static_cast<uint32_t>(target_ids_.size());
+        target_ids_.push_back(target_id);
+        target_slots_.emplace(target_id, slot);
+    } else {
+        slot = it->second;
+    }
+
+    uint32_t source = NO_SOURCE;
+    if (!source_id.empty()) {
+        auto sit = source_slots_.find(source_id);
+        if (sit == source_slots_.end()) {
+            source = static_cast<uint32_t>(source_ids_.size());
+            source_ids_.push_back(source_id);
+            source_slots_.emplace(source_id, source);
+        } else {
+            source = sit->second;
+        }
+    }
+    records_.push_back({slot, source, type, amount});
+    return true;
+}
+
+const std::vector<ResolvedDamage>& DamagePipeline::flush(ecs::World& world) {
+    results_.clear();
+    ++flush_count_;
+    if (records_.empty()) return results_;
+
+    std::sort(records_.begin(), records_.end(),
+              [](const Record& a, const Record& b) {
+                  return a.target != b.target ? a.target < b.target : a.source < b.source;
+              });
+
+    size_t i = 0;
+    while (i < records_.size()) {
+        uint32_t slot = records_[i].target;
+        DamageVector sum;
+        int hits = 0;
+        // Records are grouped by source within a target, so each source's
+        // share is one contiguous run
+        uint32_t top_source = NO_SOURCE;
+        float top_damage = 0.0f;
+        uint32_t run_source = NO_SOURCE;
+        float run_damage = 0.0f;
+        for (; i < records_.size() && records_[i].target == slot; ++i) {
+            const Record& rec = records_[i];
+            sum.amount[static_cast<int>(rec.type)] += rec.amount;
+            ++hits;
+            if (rec.source != run_source) {
+                run_source = rec.source;
+                run_damage = 0.0f;
+            }
+            run_damage += rec.amount;
+            if (run_source != NO_SOURCE && run_damage > top_damage) {
+                top_source = run_source;
+                top_damage = run_damage;
+            }
+        }
+
+        const std::string& target_id = target_ids_[slot];
+        auto* target = world.getEntity(target_id);
+        if (!target) continue;
+        auto* health = target->getComponent<components::Health>();
+        if (!health) continue;
+
+        LayerResult layers = applyDamageVector(*health, sum);
+
+        int dominant = 0;
+        for (int t = 1; t < DAMAGE_TYPE_COUNT; ++t) {
+            if (sum.amount[t] > sum.amount[dominant]) dominant = t;
+        }
+
+        ResolvedDamage resolved;
+        resolved.target_id = target_id;
+        if (top_source != NO_SOURCE) resolved.attacker_id = source_ids_[top_source];
+        resolved.damage = sum.total();
+        resolved.applied = layers.applied;
+        resolved.damage_type = damageTypeName(static_cast<DamageType>(dominant));
+        resolved.layer_hit = layers.layer_hit;
+        resolved.shield_depleted = layers.shield_depleted;
+        resolved.armor_depleted = layers.armor_depleted;
+        resolved.hull_critical = layers.hull_critical;
+        resolved.destroyed = layers.destroyed;
+        resolved.hit_count = hits;
+
+        auto* dmgEvent = target->getComponent<components::DamageEvent>();
+        if (!dmgEvent) {
+            target->addComponent(std::make_unique<components::DamageEvent>());
+            dmgEvent = target->getComponent<components::DamageEvent>();
+        }
+        if (dmgEvent) {
+            dmgEvent->addHit(resolved.damage, resolved.damage_type, resolved.layer_hit,
+                             dmgEvent->last_hit_time + 1.0f,
+                             resolved.shield_depleted, resolved.armor_depleted,
+                             resolved.hull_critical);
+        }
+
+        DamageDealtEvent dealt;
+        dealt.target_id = resolved.target_id;
+        dealt.attacker_id = resolved.attacker_id;
+        dealt.damage = resolved.damage;
+        dealt.applied = resolved.applied;
+        dealt.damage_type = resolved.damage_type;
+        dealt.layer_hit = resolved.layer_hit;
+        dealt.shield_depleted = resolved.shield_depleted;
+        dealt.armor_depleted = resolved.armor_depleted;
+        dealt.hull_critical = resolved.hull_critical;
+        dealt.destroyed = resolved.destroyed;
+        world.events().emit(dealt);
+
+        results_.push_back(std::move(resolved));
+    }
+
+    records_.clear();
+    target_ids_.clear();
+    target_slots_.clear();
+    source_ids_.clear();
+    source_slots_.clear();
+    return results_;
+}
+
+void DamagePipeline::clear() {
+    records_.clear();
+    target_ids_.clear();
+    target_slots_.clear();
+    source_ids_.clear();
+    source_slots_.clear();
+    results_.clear();
+}
+
+} // namespace systems
+} // namespace atlas
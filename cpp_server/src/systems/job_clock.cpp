@@ -0,0 +1,91 @@
+#include "systems/job_clock.h"
+#include "ecs/world.h"
+#include <algorithm>
+
+namespace atlas {
+namespace systems {
+
+JobClock::JobClock(ecs::World* world, SyncFunction sync, DiscoverFunction discover,
+                   double discovery_interval, double resolution)
+    : world_(world)
+    , sync_(std::move(sync))
+    , discover_(std::move(discover))
+    , discovery_interval_(discovery_interval)
+    , timers_(resolution) {
+}
+
+void JobClock::advance(float delta_time) {
+    if (delta_time > 0.0f) now_ += delta_time;
+
+    // Jobs set up without touch() are picked up on the slow cadence
+    if (discover_ && now_ >= next_discovery_) {
+        discover();
+        next_discovery_ = now_ + discovery_interval_;
+    }
+
+    fired_.clear();
+    timers_.advance(now_, fired_);
+    for (const auto& timer : fired_) {
+        settle(timer.key, true);
+    }
+}
+
+void JobClock::touch(const std::string& entity_id) {
+    if (tracked_.count(entity_id)) settle(entity_id, false);
+
+    // Re-examine on the next advance so edits made after this call are
+    // picked up before any further time is credited
+    Tracked& track = tracked_[entity_id];
+    track.synced_at = now_;
+    track.next = 0.0;
+    timers_.schedule(entity_id, now_);
+}
+
+void JobClock::sync(const std::string& entity_id) {
+    settle(entity_id, false);
+}
+
+void JobClock::settle(const std::string& entity_id, bool deadline_reached) {
+    auto* entity = world_->getEntity(entity_id);
+    if (!entity) {
+        forget(entity_id);
+        return;
+    }
+
+    auto it = tracked_.find(entity_id);
+    double elapsed = 0.0;
+    if (it != tracked_.end()) {
+        elapsed = now_ - it->second.synced_at;
+        // The wheel fired, so the job is due; don't let rounding in the
+        // subtraction leave it a hair short of completion
+        if (deadline_reached) elapsed = std::max(elapsed, it->second.next);
+    }
+
+    ++sync_count_;
+    double next = sync_(*entity, elapsed);
+    if (next < 0.0) {
+        forget(entity_id);
+        return;
+    }
+
+    Tracked& track = tracked_[entity_id];
+    track.synced_at = now_;
+    track.next = next;
+    timers_.schedule(entity_id, now_ + next);
+}
+
+void JobClock::discover() {
+    discovered_.clear();
+    discover_(discovered_);
+    for (auto* entity : discovered_) {
+        if (!tracked_.count(entity->getId())) settle(entity->getId(), false);
+    }
+}
+
+void JobClock::forget(const std::string& entity_id) {
+    tracked_.erase(entity_id);
+    timers_.cancel(entity_id);
+}
+
+} // namespace systems
+} // namespace atlas
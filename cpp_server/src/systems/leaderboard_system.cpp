@@ -1,6 +1,7 @@
 #include "systems/leaderboard_system.h"
 #include "ecs/world.h"
 #include "components/game_components.h"
+#include "systems/game_events.h"
 #include <algorithm>
 #include <memory>
 
@@ -12,7 +13,34 @@ LeaderboardSystem::LeaderboardSystem(ecs::World* world)
 }
 
 void LeaderboardSystem::update(float /*delta_time*/) {
-    // Leaderboard updates are event-driven via record* methods
+    // Kills and damage arrive as batches on the event bus; other stats
+    // are still pushed through the record* methods
+    auto kills = world_->events().read<EntityKilledEvent>();
+    auto hits = world_->events().read<DamageDealtEvent>();
+    if (kills.empty() && hits.empty()) return;
+
+    auto boards = world_->getEntities<components::Leaderboard>();
+    if (boards.empty()) return;
+
+    for (const auto& kill : kills) {
+        auto* killer = world_->getEntity(kill.killer_id);
+        auto* player = killer ? killer->getComponent<components::Player>() : nullptr;
+        if (!player) continue;
+        for (auto* board : boards) {
+            recordKill(board->getId(), player->player_id, player->character_name);
+        }
+    }
+
+    for (const auto& hit : hits) {
+        if (hit.attacker_id.empty() || hit.applied <= 0.0f) continue;
+        auto* attacker = world_->getEntity(hit.attacker_id);
+        auto* player = attacker ? attacker->getComponent<components::Player>() : nullptr;
+        if (!player) continue;
+        for (auto* board : boards) {
+            recordDamageDealt(board->getId(), player->player_id, player->character_name,
+                              hit.applied);
+        }
+    }
 }
 
 int LeaderboardSystem::findOrCreateEntry(const std::string& entity_id,
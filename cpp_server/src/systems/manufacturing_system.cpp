@@ -1,35 +1,56 @@
 #include "systems/manufacturing_system.h"
 #include "ecs/world.h"
 #include "components/game_components.h"
+#include <algorithm>
 
 namespace atlas {
 namespace systems {
 
 ManufacturingSystem::ManufacturingSystem(ecs::World* world)
-    : System(world) {
+    : System(world)
+    , clock_(world, [this](ecs::Entity& entity, double elapsed) {
+          return settleJobs(entity, elapsed);
+      }, [world](std::vector<ecs::Entity*>& running) {
+          for (auto* entity : world->getEntities<components::ManufacturingFacility>()) {
+              const auto& jobs = entity->getComponent<components::ManufacturingFacility>()->jobs;
+              if (std::any_of(jobs.begin(), jobs.end(),
+                              [](const auto& job) { return job.status == "active"; })) {
+                  running.push_back(entity);
+              }
+          }
+      }) {
 }
 
 void ManufacturingSystem::update(float delta_time) {
-    for (auto* entity : world_->getAllEntities()) {
-        auto* facility = entity->getComponent<components::ManufacturingFacility>();
-        if (!facility) continue;
-
-        for (auto& job : facility->jobs) {
-            if (job.status != "active") continue;
-
-            job.time_remaining -= delta_time;
-            if (job.time_remaining <= 0.0f) {
-                job.runs_completed++;
-                if (job.runs_completed >= job.runs) {
-                    job.time_remaining = 0.0f;
-                    job.status = "completed";
-                } else {
-                    // Start next run
-                    job.time_remaining = job.time_per_run;
-                }
+    clock_.advance(delta_time);
+}
+
+double ManufacturingSystem::settleJobs(ecs::Entity& entity, double elapsed) {
+    auto* facility = entity.getComponent<components::ManufacturingFacility>();
+    if (!facility) return -1.0;
+
+    double next = -1.0;
+    for (auto& job : facility->jobs) {
+        if (job.status != "active") continue;
+
+        double left = elapsed;
+        while (job.time_remaining <= left) {
+            left -= std::max(0.0f, job.time_remaining);
+            job.runs_completed++;
+            if (job.runs_completed >= job.runs) {
+                job.time_remaining = 0.0f;
+                job.status = "completed";
+                break;
             }
+            // Start next run
+            job.time_remaining = job.time_per_run;
         }
+        if (job.status != "active") continue;
+
+        job.time_remaining = static_cast<float>(job.time_remaining - left);
+        if (next < 0.0 || job.time_remaining < next) next = job.time_remaining;
     }
+    return next;
 }
 
 std::string ManufacturingSystem::startJob(const std::string& facility_entity_id,
@@ -46,7 +67,8 @@ std::string ManufacturingSystem::startJob(const std::string& facility_entity_id,
     auto* facility = entity->getComponent<components::ManufacturingFacility>();
     if (!facility) return "";
 
-    // Check job slot availability
+    // Check job slot availability (settling first frees finished slots)
+    clock_.sync(facility_entity_id);
     if (facility->activeJobCount() >= facility->max_jobs) return "";
 
     // Deduct install cost from owner
@@ -72,6 +94,7 @@ std::string ManufacturingSystem::startJob(const std::string& facility_entity_id,
     job.install_cost = install_cost;
     job.status = "active";
 
+    clock_.touch(facility_entity_id);
     facility->jobs.push_back(job);
     return job.job_id;
 }
@@ -84,6 +107,7 @@ bool ManufacturingSystem::cancelJob(const std::string& facility_entity_id,
     auto* facility = entity->getComponent<components::ManufacturingFacility>();
     if (!facility) return false;
 
+    clock_.sync(facility_entity_id);
     for (auto& job : facility->jobs) {
         if (job.job_id == job_id && job.status == "active") {
             job.status = "cancelled";
@@ -100,6 +124,7 @@ int ManufacturingSystem::getActiveJobCount(const std::string& facility_entity_id
     auto* facility = entity->getComponent<components::ManufacturingFacility>();
     if (!facility) return 0;
 
+    clock_.sync(facility_entity_id);
     return facility->activeJobCount();
 }
 
@@ -110,6 +135,7 @@ int ManufacturingSystem::getCompletedJobCount(const std::string& facility_entity
     auto* facility = entity->getComponent<components::ManufacturingFacility>();
     if (!facility) return 0;
 
+    clock_.sync(facility_entity_id);
     int count = 0;
     for (const auto& job : facility->jobs)
         if (job.status == "completed") ++count;
@@ -123,11 +149,29 @@ int ManufacturingSystem::getTotalRunsCompleted(const std::string& facility_entit
     auto* facility = entity->getComponent<components::ManufacturingFacility>();
     if (!facility) return 0;
 
+    clock_.sync(facility_entity_id);
     int total = 0;
     for (const auto& job : facility->jobs)
         total += job.runs_completed;
     return total;
 }
 
+float ManufacturingSystem::getJobTimeRemaining(const std::string& facility_entity_id,
+                                               const std::string& job_id) {
+    auto* entity = world_->getEntity(facility_entity_id);
+    if (!entity) return 0.0f;
+
+    auto* facility = entity->getComponent<components::ManufacturingFacility>();
+    if (!facility) return 0.0f;
+
+    clock_.sync(facility_entity_id);
+    for (const auto& job : facility->jobs) {
+        if (job.job_id == job_id) {
+            return job.status == "active" ? job.time_remaining : 0.0f;
+        }
+    }
+    return 0.0f;
+}
+
 } // namespace systems
 } // namespace atlas
@@ -12,6 +12,8 @@ MarketSystem::MarketSystem(ecs::World* world)
 }
 
 void MarketSystem::update(float delta_time) {
+    sim_time_ += delta_time;
+
     // Tick order durations and expire/clean up
     auto entities = world_->getEntities<components::MarketHub>();
     for (auto* entity : entities) {
@@ -168,6 +170,9 @@ int MarketSystem::buyFromMarket(const std::string& station_id,
             best->fulfilled = true;
         }
 
+        history_.recordTrade(station_id, item_id, best->price_per_unit,
+                             can_buy, sim_time_);
+
         total_bought += can_buy;
         remaining -= can_buy;
     }
@@ -247,13 +252,22 @@ int MarketSystem::seedNPCOrders(const std::string& station_id) {
 
     int created = 0;
     for (const auto& s : seeds) {
+        // Last known daily average, however old: a hub that went quiet
+        // reopens at the price it left off at, not at baseline
+        double price = s.price;
+        double recent = history_.getAveragePrice(
+            station_id, s.id, data::MarketHistory::Resolution::OneDay, 1);
+        if (recent > 0.0) {
+            price = std::clamp(recent, s.price * 0.5, s.price * 2.0);
+        }
+
         components::MarketHub::Order order;
         order.order_id = "npc_seed_" + std::to_string(++order_counter_);
         order.item_id = s.id;
         order.item_name = s.name;
         order.owner_id = "npc_market";
         order.is_buy_order = false;
-        order.price_per_unit = s.price;
+        order.price_per_unit = price;
         order.quantity = s.qty;
         order.quantity_remaining = s.qty;
         order.duration_remaining = -1.0f;  // permanent
@@ -1,6 +1,7 @@
 #include "systems/mission_system.h"
 #include "ecs/world.h"
 #include "components/game_components.h"
+#include "systems/game_events.h"
 #include <algorithm>
 
 namespace atlas {
@@ -119,6 +120,15 @@ void MissionSystem::recordProgress(const std::string& entity_id,
         for (auto& obj : mission.objectives) {
             if (obj.type == objective_type && obj.target == target && !obj.done()) {
                 obj.completed = std::min(obj.completed + count, obj.required);
+
+                MissionProgressEvent progress;
+                progress.entity_id = entity_id;
+                progress.mission_id = mission_id;
+                progress.objective_type = objective_type;
+                progress.target = target;
+                progress.completed = obj.completed;
+                progress.required = obj.required;
+                world_->events().emit(progress);
             }
         }
     }
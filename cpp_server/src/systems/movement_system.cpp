@@ -1,6 +1,8 @@
 #include "systems/movement_system.h"
 #include "ecs/world.h"
 #include "components/game_components.h"
+#include "data/ship_template_registry.h"
+#include "systems/game_events.h"
 #include <cmath>
 
 namespace atlas {
@@ -149,6 +151,13 @@ void MovementSystem::update(float delta_time) {
                     warpState->distance_remaining = 0.0f;
                     warpState->intensity = 0.0f;
                 }
+                WarpEvent arrived;
+                arrived.entity_id = it->first;
+                arrived.phase = WarpEvent::Phase::Completed;
+                arrived.dest_x = cmd.warp_dest_x;
+                arrived.dest_y = cmd.warp_dest_y;
+                arrived.dest_z = cmd.warp_dest_z;
+                world_->events().emit(arrived);
                 it = movement_commands_.erase(it);
                 continue;
             }
@@ -223,10 +232,7 @@ void MovementSystem::commandOrbit(const std::string& entity_id,
     // Read align time from Ship component for inertia-based turning
     auto* entity = world_->getEntity(entity_id);
     if (entity) {
-        auto* ship = entity->getComponent<components::Ship>();
-        if (ship) {
-            cmd.align_time = ship->align_time;
-        }
+        data::entityShipStat(*entity, data::ShipStat::AlignTime, cmd.align_time);
     }
     movement_commands_[entity_id] = cmd;
 }
@@ -239,10 +245,7 @@ void MovementSystem::commandApproach(const std::string& entity_id,
     // Read align time from Ship component for inertia-based turning
     auto* entity = world_->getEntity(entity_id);
     if (entity) {
-        auto* ship = entity->getComponent<components::Ship>();
-        if (ship) {
-            cmd.align_time = ship->align_time;
-        }
+        data::entityShipStat(*entity, data::ShipStat::AlignTime, cmd.align_time);
     }
     movement_commands_[entity_id] = cmd;
 }
@@ -280,11 +283,8 @@ bool MovementSystem::commandWarp(const std::string& entity_id,
     // Read ship-class warp parameters if Ship component present
     float warp_speed_au = 3.0f;
     float align_time = DEFAULT_ALIGN_TIME;
-    auto* ship = entity->getComponent<components::Ship>();
-    if (ship) {
-        warp_speed_au = ship->warp_speed_au;
-        align_time = ship->align_time;
-    }
+    data::entityShipStat(*entity, data::ShipStat::WarpSpeedAu, warp_speed_au);
+    data::entityShipStat(*entity, data::ShipStat::AlignTime, align_time);
 
     // Compute warp duration: align_time + (distance_AU / warp_speed_AU)
     float distance_au = dist / AU_IN_METERS;
@@ -312,6 +312,14 @@ bool MovementSystem::commandWarp(const std::string& entity_id,
     cmd.align_time = align_time;
     cmd.warping = true;
     movement_commands_[entity_id] = cmd;
+
+    WarpEvent started;
+    started.entity_id = entity_id;
+    started.phase = WarpEvent::Phase::Started;
+    started.dest_x = dest_x;
+    started.dest_y = dest_y;
+    started.dest_z = dest_z;
+    world_->events().emit(started);
     return true;
 }
 
@@ -322,11 +330,8 @@ bool MovementSystem::isWarpDisrupted(const std::string& entity_id) const {
     auto* warpState = entity->getComponent<components::WarpState>();
     if (!warpState) return false;
 
-    int warp_strength = 1;  // default warp core strength
-    auto* ship = entity->getComponent<components::Ship>();
-    if (ship) {
-        warp_strength = ship->warp_strength;
-    }
+    float warp_strength = 1.0f;  // default warp core strength
+    data::entityShipStat(*entity, data::ShipStat::WarpStrength, warp_strength);
 
     return warpState->warp_disrupt_strength >= warp_strength;
 }
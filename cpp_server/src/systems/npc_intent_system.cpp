@@ -1,4 +1,5 @@
 #include "systems/npc_intent_system.h"
+#include "systems/background_simulation_system.h"
 #include "ecs/world.h"
 #include <algorithm>
 #include <cmath>
@@ -11,31 +12,102 @@ NPCIntentSystem::NPCIntentSystem(ecs::World* world)
 }
 
 void NPCIntentSystem::update(float delta_time) {
+    if (background_) {
+        // NPCs in simulated systems are advanced by advanceSystem()
+        roster_age_ += delta_time;
+        if (roster_age_ >= roster_refresh_interval) refreshRoster();
+        for (const auto& id : unassigned_) {
+            auto* entity = world_->getEntity(id);
+            auto* intent = entity ? entity->getComponent<components::SimNPCIntent>() : nullptr;
+            if (intent) advance(entity, intent, delta_time, nullptr);
+        }
+        return;
+    }
+
     auto entities = world_->getEntities<components::SimNPCIntent>();
     for (auto* entity : entities) {
         auto* intent = entity->getComponent<components::SimNPCIntent>();
         if (!intent) continue;
 
-        intent->intent_duration += delta_time;
+        // Nobody is watching: bank the time and catch up in one step
+        float dt = delta_time + intent->deferred_time;
+        if (inDormantSystem(intent) && dt < dormant_update_interval) {
+            intent->deferred_time = dt;
+            continue;
+        }
+        intent->deferred_time = 0.0f;
+        advance(entity, intent, dt, targetSystemState(intent));
+    }
+}
+
+void NPCIntentSystem::attach(BackgroundSimulationSystem* background) {
+    background_ = background;
+    background_->addAdvanceListener([this](ecs::Entity* system, float dt) {
+        advanceSystem(system, dt);
+    });
+    refreshRoster();
+}
 
-        // Tick cooldown
-        if (intent->intent_cooldown > 0.0f) {
-            intent->intent_cooldown -= delta_time;
-            if (intent->intent_cooldown < 0.0f)
-                intent->intent_cooldown = 0.0f;
+void NPCIntentSystem::refreshRoster() {
+    roster_age_ = 0.0f;
+    roster_.clear();
+    unassigned_.clear();
+    for (auto* entity : world_->getEntities<components::SimNPCIntent>()) {
+        auto* intent = entity->getComponent<components::SimNPCIntent>();
+        if (background_ && background_->getSystemState(intent->target_system_id)) {
+            roster_[intent->target_system_id].push_back(entity->getId());
+        } else {
+            unassigned_.push_back(entity->getId());
         }
+    }
+}
 
-        evaluateIntent(entity, intent, delta_time);
+void NPCIntentSystem::advanceSystem(ecs::Entity* system, float dt) {
+    auto it = roster_.find(system->getId());
+    if (it == roster_.end()) return;
+    auto* sys_state = system->getComponent<components::SimStarSystemState>();
+    for (const auto& id : it->second) {
+        auto* entity = world_->getEntity(id);
+        auto* intent = entity ? entity->getComponent<components::SimNPCIntent>() : nullptr;
+        // Retargeted NPCs move rosters at the next refresh
+        if (!intent || intent->target_system_id != it->first) continue;
+        advance(entity, intent, dt, sys_state);
     }
 }
 
+void NPCIntentSystem::advance(ecs::Entity* entity, components::SimNPCIntent* intent, float dt,
+                              const components::SimStarSystemState* sys_state) {
+    intent->intent_duration += dt;
+
+    // Tick cooldown
+    if (intent->intent_cooldown > 0.0f) {
+        intent->intent_cooldown -= dt;
+        if (intent->intent_cooldown < 0.0f)
+            intent->intent_cooldown = 0.0f;
+    }
+
+    evaluateIntent(entity, intent, sys_state);
+}
+
+const components::SimStarSystemState*
+NPCIntentSystem::targetSystemState(const components::SimNPCIntent* intent) const {
+    if (intent->target_system_id.empty()) return nullptr;
+    auto* sys_entity = world_->getEntity(intent->target_system_id);
+    return sys_entity ? sys_entity->getComponent<components::SimStarSystemState>() : nullptr;
+}
+
+bool NPCIntentSystem::inDormantSystem(const components::SimNPCIntent* intent) const {
+    auto* sys_state = targetSystemState(intent);
+    return sys_state && sys_state->dormant;
+}
+
 // -----------------------------------------------------------------------
 // Per-entity intent evaluation
 // -----------------------------------------------------------------------
 
 void NPCIntentSystem::evaluateIntent(ecs::Entity* entity,
                                       components::SimNPCIntent* intent,
-                                      float /*dt*/) {
+                                      const components::SimStarSystemState* sys_state) {
     // Don't re-evaluate while on cooldown (unless intent is complete)
     if (intent->intent_cooldown > 0.0f && !intent->intent_complete)
         return;
@@ -54,16 +126,6 @@ void NPCIntentSystem::evaluateIntent(ecs::Entity* entity,
         }
     }
 
-    // Look up star system state (if entity has a SolarSystem component or
-    // we find one by target_system_id)
-    const components::SimStarSystemState* sys_state = nullptr;
-    if (!intent->target_system_id.empty()) {
-        auto* sys_entity = world_->getEntity(intent->target_system_id);
-        if (sys_entity) {
-            sys_state = sys_entity->getComponent<components::SimStarSystemState>();
-        }
-    }
-
     // Score every intent
     using Intent = components::SimNPCIntent::Intent;
     Intent best = Intent::Idle;
@@ -1,96 +1,120 @@
 #include "systems/pi_system.h"
 #include "ecs/world.h"
 #include "components/game_components.h"
+#include <algorithm>
 
 namespace atlas {
 namespace systems {
 
 PISystem::PISystem(ecs::World* world)
-    : System(world) {
+    : System(world)
+    , clock_(world, [this](ecs::Entity& entity, double elapsed) {
+          return settleColony(entity, elapsed);
+      }, [world](std::vector<ecs::Entity*>& running) {
+          auto cycling = [](const auto& unit) { return unit.active && unit.cycle_time > 0.0f; };
+          for (auto* entity : world->getEntities<components::PlanetaryColony>()) {
+              auto* colony = entity->getComponent<components::PlanetaryColony>();
+              if (std::any_of(colony->extractors.begin(), colony->extractors.end(), cycling) ||
+                  std::any_of(colony->processors.begin(), colony->processors.end(), cycling)) {
+                  running.push_back(entity);
+              }
+          }
+      }) {
 }
 
 void PISystem::update(float delta_time) {
-    for (auto* entity : world_->getAllEntities()) {
-        auto* colony = entity->getComponent<components::PlanetaryColony>();
-        if (!colony) continue;
-
-        // Tick extractors
-        for (auto& ext : colony->extractors) {
-            if (!ext.active) continue;
-            ext.cycle_progress += delta_time;
-            while (ext.cycle_progress >= ext.cycle_time) {
-                ext.cycle_progress -= ext.cycle_time;
-
-                // Check storage capacity
-                if (colony->totalStored() + ext.quantity_per_cycle > static_cast<int>(colony->storage_capacity))
-                    continue;
-
-                // Add extracted resource to storage
-                bool found = false;
-                for (auto& s : colony->storage) {
-                    if (s.resource_type == ext.resource_type) {
-                        s.quantity += ext.quantity_per_cycle;
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    components::PlanetaryColony::StoredResource sr;
-                    sr.resource_type = ext.resource_type;
-                    sr.quantity = ext.quantity_per_cycle;
-                    colony->storage.push_back(sr);
+    clock_.advance(delta_time);
+}
+
+double PISystem::settleColony(ecs::Entity& entity, double elapsed) {
+    auto* colony = entity.getComponent<components::PlanetaryColony>();
+    if (!colony) return -1.0;
+
+    double next = -1.0;
+
+    // Tick extractors
+    for (auto& ext : colony->extractors) {
+        if (!ext.active || ext.cycle_time <= 0.0f) continue;
+        double progress = ext.cycle_progress + elapsed;
+        while (progress >= ext.cycle_time) {
+            progress -= ext.cycle_time;
+
+            // Check storage capacity
+            if (colony->totalStored() + ext.quantity_per_cycle > static_cast<int>(colony->storage_capacity))
+                continue;
+
+            // Add extracted resource to storage
+            bool found = false;
+            for (auto& s : colony->storage) {
+                if (s.resource_type == ext.resource_type) {
+                    s.quantity += ext.quantity_per_cycle;
+                    found = true;
+                    break;
                 }
             }
+            if (!found) {
+                components::PlanetaryColony::StoredResource sr;
+                sr.resource_type = ext.resource_type;
+                sr.quantity = ext.quantity_per_cycle;
+                colony->storage.push_back(sr);
+            }
         }
+        ext.cycle_progress = static_cast<float>(progress);
+        double until = static_cast<double>(ext.cycle_time) - ext.cycle_progress;
+        if (next < 0.0 || until < next) next = until;
+    }
 
-        // Tick processors
-        for (auto& proc : colony->processors) {
-            if (!proc.active) continue;
-            proc.cycle_progress += delta_time;
-            while (proc.cycle_progress >= proc.cycle_time) {
-                proc.cycle_progress -= proc.cycle_time;
-
-                // Check input availability
-                int available_input = 0;
-                for (const auto& s : colony->storage) {
-                    if (s.resource_type == proc.input_type) {
-                        available_input = s.quantity;
-                        break;
-                    }
+    // Tick processors
+    for (auto& proc : colony->processors) {
+        if (!proc.active || proc.cycle_time <= 0.0f) continue;
+        double progress = proc.cycle_progress + elapsed;
+        while (progress >= proc.cycle_time) {
+            progress -= proc.cycle_time;
+
+            // Check input availability
+            int available_input = 0;
+            for (const auto& s : colony->storage) {
+                if (s.resource_type == proc.input_type) {
+                    available_input = s.quantity;
+                    break;
                 }
-                if (available_input < proc.input_quantity) continue;
-
-                // Check output storage capacity
-                if (colony->totalStored() - proc.input_quantity + proc.output_quantity
-                    > static_cast<int>(colony->storage_capacity))
-                    continue;
-
-                // Consume input
-                for (auto& s : colony->storage) {
-                    if (s.resource_type == proc.input_type) {
-                        s.quantity -= proc.input_quantity;
-                        break;
-                    }
+            }
+            if (available_input < proc.input_quantity) continue;
+
+            // Check output storage capacity
+            if (colony->totalStored() - proc.input_quantity + proc.output_quantity
+                > static_cast<int>(colony->storage_capacity))
+                continue;
+
+            // Consume input
+            for (auto& s : colony->storage) {
+                if (s.resource_type == proc.input_type) {
+                    s.quantity -= proc.input_quantity;
+                    break;
                 }
+            }
 
-                // Produce output
-                bool found = false;
-                for (auto& s : colony->storage) {
-                    if (s.resource_type == proc.output_type) {
-                        s.quantity += proc.output_quantity;
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    components::PlanetaryColony::StoredResource sr;
-                    sr.resource_type = proc.output_type;
-                    sr.quantity = proc.output_quantity;
-                    colony->storage.push_back(sr);
+            // Produce output
+            bool found = false;
+            for (auto& s : colony->storage) {
+                if (s.resource_type == proc.output_type) {
+                    s.quantity += proc.output_quantity;
+                    found = true;
+                    break;
                 }
             }
+            if (!found) {
+                components::PlanetaryColony::StoredResource sr;
+                sr.resource_type = proc.output_type;
+                sr.quantity = proc.output_quantity;
+                colony->storage.push_back(sr);
+            }
         }
+        proc.cycle_progress = static_cast<float>(progress);
+        double until = static_cast<double>(proc.cycle_time) - proc.cycle_progress;
+        if (next < 0.0 || until < next) next = until;
     }
+    return next;
 }
 
 bool PISystem::installExtractor(const std::string& colony_entity_id,
@@ -111,6 +135,7 @@ bool PISystem::installExtractor(const std::string& colony_entity_id,
     if (colony->usedCpu() + ext.cpu_usage > colony->cpu_max) return false;
     if (colony->usedPowergrid() + ext.powergrid_usage > colony->powergrid_max) return false;
 
+    clock_.touch(colony_entity_id);
     colony->extractors.push_back(ext);
     return true;
 }
@@ -137,6 +162,7 @@ bool PISystem::installProcessor(const std::string& colony_entity_id,
     if (colony->usedCpu() + proc.cpu_usage > colony->cpu_max) return false;
     if (colony->usedPowergrid() + proc.powergrid_usage > colony->powergrid_max) return false;
 
+    clock_.touch(colony_entity_id);
     colony->processors.push_back(proc);
     return true;
 }
@@ -149,6 +175,7 @@ int PISystem::getStoredResource(const std::string& colony_entity_id,
     auto* colony = entity->getComponent<components::PlanetaryColony>();
     if (!colony) return 0;
 
+    clock_.sync(colony_entity_id);
     for (const auto& s : colony->storage) {
         if (s.resource_type == resource_type)
             return s.quantity;
@@ -163,6 +190,7 @@ int PISystem::getTotalStored(const std::string& colony_entity_id) {
     auto* colony = entity->getComponent<components::PlanetaryColony>();
     if (!colony) return 0;
 
+    clock_.sync(colony_entity_id);
     return colony->totalStored();
 }
 
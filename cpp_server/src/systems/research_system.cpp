@@ -1,12 +1,24 @@
 #include "systems/research_system.h"
 #include "ecs/world.h"
 #include "components/game_components.h"
+#include <algorithm>
 
 namespace atlas {
 namespace systems {
 
 ResearchSystem::ResearchSystem(ecs::World* world)
-    : System(world) {
+    : System(world)
+    , clock_(world, [this](ecs::Entity& entity, double elapsed) {
+          return settleJobs(entity, elapsed);
+      }, [world](std::vector<ecs::Entity*>& running) {
+          for (auto* entity : world->getEntities<components::ResearchLab>()) {
+              const auto& jobs = entity->getComponent<components::ResearchLab>()->jobs;
+              if (std::any_of(jobs.begin(), jobs.end(),
+                              [](const auto& job) { return job.status == "active"; })) {
+                  running.push_back(entity);
+              }
+          }
+      }) {
 }
 
 float ResearchSystem::nextRandom() {
@@ -16,32 +28,38 @@ float ResearchSystem::nextRandom() {
 }
 
 void ResearchSystem::update(float delta_time) {
-    for (auto* entity : world_->getAllEntities()) {
-        auto* lab = entity->getComponent<components::ResearchLab>();
-        if (!lab) continue;
-
-        for (auto& job : lab->jobs) {
-            if (job.status != "active") continue;
-
-            job.time_remaining -= delta_time;
-            if (job.time_remaining <= 0.0f) {
-                job.time_remaining = 0.0f;
-
-                if (job.research_type == "invention") {
-                    // Roll for success
-                    float roll = nextRandom();
-                    if (roll <= job.success_chance) {
-                        job.status = "completed";
-                    } else {
-                        job.status = "failed";
-                    }
-                } else {
-                    // ME/TE research always succeeds
-                    job.status = "completed";
-                }
+    clock_.advance(delta_time);
+}
+
+double ResearchSystem::settleJobs(ecs::Entity& entity, double elapsed) {
+    auto* lab = entity.getComponent<components::ResearchLab>();
+    if (!lab) return -1.0;
+
+    double next = -1.0;
+    for (auto& job : lab->jobs) {
+        if (job.status != "active") continue;
+
+        if (job.time_remaining > elapsed) {
+            job.time_remaining = static_cast<float>(job.time_remaining - elapsed);
+            if (next < 0.0 || job.time_remaining < next) next = job.time_remaining;
+            continue;
+        }
+
+        job.time_remaining = 0.0f;
+        if (job.research_type == "invention") {
+            // Roll for success
+            float roll = nextRandom();
+            if (roll <= job.success_chance) {
+                job.status = "completed";
+            } else {
+                job.status = "failed";
             }
+        } else {
+            // ME/TE research always succeeds
+            job.status = "completed";
         }
     }
+    return next;
 }
 
 std::string ResearchSystem::startMEResearch(const std::string& lab_entity_id,
@@ -56,6 +74,7 @@ std::string ResearchSystem::startMEResearch(const std::string& lab_entity_id,
     auto* lab = entity->getComponent<components::ResearchLab>();
     if (!lab) return "";
 
+    clock_.sync(lab_entity_id);
     if (lab->activeJobCount() >= lab->max_jobs) return "";
 
     // Deduct install cost
@@ -79,6 +98,7 @@ std::string ResearchSystem::startMEResearch(const std::string& lab_entity_id,
     job.install_cost = install_cost;
     job.status = "active";
 
+    clock_.touch(lab_entity_id);
     lab->jobs.push_back(job);
     return job.job_id;
 }
@@ -95,6 +115,7 @@ std::string ResearchSystem::startTEResearch(const std::string& lab_entity_id,
     auto* lab = entity->getComponent<components::ResearchLab>();
     if (!lab) return "";
 
+    clock_.sync(lab_entity_id);
     if (lab->activeJobCount() >= lab->max_jobs) return "";
 
     auto* owner = world_->getEntity(owner_id);
@@ -117,6 +138,7 @@ std::string ResearchSystem::startTEResearch(const std::string& lab_entity_id,
     job.install_cost = install_cost;
     job.status = "active";
 
+    clock_.touch(lab_entity_id);
     lab->jobs.push_back(job);
     return job.job_id;
 }
@@ -136,6 +158,7 @@ std::string ResearchSystem::startInvention(const std::string& lab_entity_id,
     auto* lab = entity->getComponent<components::ResearchLab>();
     if (!lab) return "";
 
+    clock_.sync(lab_entity_id);
     if (lab->activeJobCount() >= lab->max_jobs) return "";
 
     auto* owner = world_->getEntity(owner_id);
@@ -161,6 +184,7 @@ std::string ResearchSystem::startInvention(const std::string& lab_entity_id,
     job.install_cost = install_cost;
     job.status = "active";
 
+    clock_.touch(lab_entity_id);
     lab->jobs.push_back(job);
     return job.job_id;
 }
@@ -172,6 +196,7 @@ int ResearchSystem::getActiveJobCount(const std::string& lab_entity_id) {
     auto* lab = entity->getComponent<components::ResearchLab>();
     if (!lab) return 0;
 
+    clock_.sync(lab_entity_id);
     return lab->activeJobCount();
 }
 
@@ -182,6 +207,7 @@ int ResearchSystem::getCompletedJobCount(const std::string& lab_entity_id) {
     auto* lab = entity->getComponent<components::ResearchLab>();
     if (!lab) return 0;
 
+    clock_.sync(lab_entity_id);
     int count = 0;
     for (const auto& job : lab->jobs)
         if (job.status == "completed") ++count;
@@ -195,11 +221,29 @@ int ResearchSystem::getFailedJobCount(const std::string& lab_entity_id) {
     auto* lab = entity->getComponent<components::ResearchLab>();
     if (!lab) return 0;
 
+    clock_.sync(lab_entity_id);
     int count = 0;
     for (const auto& job : lab->jobs)
         if (job.status == "failed") ++count;
     return count;
 }
 
+float ResearchSystem::getJobTimeRemaining(const std::string& lab_entity_id,
+                                          const std::string& job_id) {
+    auto* entity = world_->getEntity(lab_entity_id);
+    if (!entity) return 0.0f;
+
+    auto* lab = entity->getComponent<components::ResearchLab>();
+    if (!lab) return 0.0f;
+
+    clock_.sync(lab_entity_id);
+    for (const auto& job : lab->jobs) {
+        if (job.job_id == job_id) {
+            return job.status == "active" ? job.time_remaining : 0.0f;
+        }
+    }
+    return 0.0f;
+}
+
 } // namespace systems
 } // namespace atlas
@@ -10,45 +10,60 @@ namespace systems {
 static constexpr double BASE_SP_PER_LEVEL = 1000.0;
 
 SkillSystem::SkillSystem(ecs::World* world)
-    : System(world) {
+    : System(world)
+    , clock_(world, [this](ecs::Entity& entity, double elapsed) {
+          return settleTraining(entity, elapsed);
+      }, [world](std::vector<ecs::Entity*>& running) {
+          for (auto* entity : world->getEntities<components::SkillSet>()) {
+              if (!entity->getComponent<components::SkillSet>()->training_queue.empty()) {
+                  running.push_back(entity);
+              }
+          }
+      }) {
 }
 
 void SkillSystem::update(float delta_time) {
-    auto entities = world_->getEntities<components::SkillSet>();
+    clock_.advance(delta_time);
+}
 
-    for (auto* entity : entities) {
-        auto* skillset = entity->getComponent<components::SkillSet>();
-        if (!skillset || skillset->training_queue.empty()) continue;
+double SkillSystem::settleTraining(ecs::Entity& entity, double elapsed) {
+    auto* skillset = entity.getComponent<components::SkillSet>();
+    if (!skillset) return -1.0;
 
+    double left = elapsed;
+    while (!skillset->training_queue.empty()) {
         auto& front = skillset->training_queue.front();
-        front.time_remaining -= delta_time;
-
-        if (front.time_remaining <= 0.0f) {
-            // Skill training complete
-            auto it = skillset->skills.find(front.skill_id);
-            if (it != skillset->skills.end()) {
-                if (front.target_level <= it->second.max_level) {
-                    it->second.level = front.target_level;
-                }
-            } else {
-                // New skill
-                components::SkillSet::TrainedSkill skill;
-                skill.skill_id = front.skill_id;
-                skill.level = front.target_level;
-                skillset->skills[front.skill_id] = skill;
-            }
+        if (front.time_remaining > left) {
+            front.time_remaining = static_cast<float>(front.time_remaining - left);
+            return front.time_remaining;
+        }
+        left -= std::max(0.0f, front.time_remaining);
 
-            // Award SP (base: 1000 SP per level, scaled by multiplier)
-            double sp_gain = BASE_SP_PER_LEVEL * front.target_level;
-            auto skill_it = skillset->skills.find(front.skill_id);
-            if (skill_it != skillset->skills.end()) {
-                sp_gain *= skill_it->second.training_multiplier;
+        // Skill training complete; leftover time flows into the next entry
+        auto it = skillset->skills.find(front.skill_id);
+        if (it != skillset->skills.end()) {
+            if (front.target_level <= it->second.max_level) {
+                it->second.level = front.target_level;
             }
-            skillset->total_sp += sp_gain;
+        } else {
+            // New skill
+            components::SkillSet::TrainedSkill skill;
+            skill.skill_id = front.skill_id;
+            skill.level = front.target_level;
+            skillset->skills[front.skill_id] = skill;
+        }
 
-            skillset->training_queue.erase(skillset->training_queue.begin());
+        // Award SP (base: 1000 SP per level, scaled by multiplier)
+        double sp_gain = BASE_SP_PER_LEVEL * front.target_level;
+        auto skill_it = skillset->skills.find(front.skill_id);
+        if (skill_it != skillset->skills.end()) {
+            sp_gain *= skill_it->second.training_multiplier;
         }
+        skillset->total_sp += sp_gain;
+
+        skillset->training_queue.erase(skillset->training_queue.begin());
     }
+    return -1.0;
 }
 
 bool SkillSystem::queueSkillTraining(const std::string& entity_id,
@@ -79,6 +94,8 @@ bool SkillSystem::queueSkillTraining(const std::string& entity_id,
     int current = skillset->getSkillLevel(skill_id);
     if (target_level <= current) return false;
 
+    clock_.touch(entity_id);
+
     // Add to queue
     components::SkillSet::QueueEntry entry;
     entry.skill_id = skill_id;
@@ -119,8 +136,21 @@ int SkillSystem::getSkillLevel(const std::string& entity_id,
     auto* skillset = entity->getComponent<components::SkillSet>();
     if (!skillset) return 0;
 
+    if (!skillset->training_queue.empty()) clock_.sync(entity_id);
     return skillset->getSkillLevel(skill_id);
 }
 
+float SkillSystem::getTrainingTimeRemaining(const std::string& entity_id) {
+    auto* entity = world_->getEntity(entity_id);
+    if (!entity) return 0.0f;
+
+    auto* skillset = entity->getComponent<components::SkillSet>();
+    if (!skillset || skillset->training_queue.empty()) return 0.0f;
+
+    clock_.sync(entity_id);
+    if (skillset->training_queue.empty()) return 0.0f;
+    return skillset->training_queue.front().time_remaining;
+}
+
 } // namespace systems
 } // namespace atlas
@@ -1,6 +1,7 @@
 #include "systems/station_system.h"
 #include "ecs/world.h"
 #include "components/game_components.h"
+#include "systems/game_events.h"
 #include <cmath>
 
 namespace atlas {
@@ -97,6 +98,7 @@ bool StationSystem::dockAtStation(const std::string& entity_id,
     entity->addComponent(std::move(docked));
 
     station->docked_count++;
+    world_->events().emit(DockEvent{entity_id, station_id, true});
     return true;
 }
 
@@ -111,6 +113,8 @@ bool StationSystem::undockFromStation(const std::string& entity_id) {
     auto* docked = entity->getComponent<components::Docked>();
     if (!docked) return false;
 
+    DockEvent undocked{entity_id, docked->station_id, false};
+
     // Decrement station count
     auto* station_entity = world_->getEntity(docked->station_id);
     if (station_entity) {
@@ -121,6 +125,7 @@ bool StationSystem::undockFromStation(const std::string& entity_id) {
     }
 
     entity->removeComponent<components::Docked>();
+    world_->events().emit(undocked);
     return true;
 }
 
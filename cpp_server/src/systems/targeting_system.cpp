@@ -1,6 +1,7 @@
 #include "systems/targeting_system.h"
 #include "ecs/world.h"
 #include "components/game_components.h"
+#include "data/ship_template_registry.h"
 #include <algorithm>
 
 namespace atlas {
@@ -11,14 +12,19 @@ TargetingSystem::TargetingSystem(ecs::World* world)
 }
 
 void TargetingSystem::update(float delta_time) {
-    // Get all entities with targeting capability
-    auto entities = world_->getEntities<components::Target, components::Ship>();
+    // Get all entities with targeting capability (full Ship or flyweight template)
+    auto entities = world_->getEntities<components::Target>();
     
     for (auto* entity : entities) {
         auto* target_comp = entity->getComponent<components::Target>();
-        auto* ship = entity->getComponent<components::Ship>();
+        float scan_resolution = 0.0f;
+        float max_locked_targets = 0.0f;
         
-        if (!target_comp || !ship) continue;
+        if (!target_comp ||
+            !data::entityShipStat(*entity, data::ShipStat::ScanResolution, scan_resolution) ||
+            !data::entityShipStat(*entity, data::ShipStat::MaxLockedTargets, max_locked_targets)) {
+            continue;
+        }
         
         // Process locking targets
         std::vector<std::string> completed_locks;
@@ -26,7 +32,7 @@ void TargetingSystem::update(float delta_time) {
         for (auto& [target_id, progress] : target_comp->locking_targets) {
             // Lock time based on scan resolution (simplified)
             // Higher scan resolution = faster locking
-            float lock_time = 1000.0f / ship->scan_resolution;  // seconds
+            float lock_time = 1000.0f / scan_resolution;  // seconds
             progress += delta_time / lock_time;
             
             // Check if lock is complete
@@ -38,7 +44,7 @@ void TargetingSystem::update(float delta_time) {
         // Complete locks
         for (const auto& target_id : completed_locks) {
             // Check if we have room for more locked targets
-            if (target_comp->locked_targets.size() < static_cast<size_t>(ship->max_locked_targets)) {
+            if (target_comp->locked_targets.size() < static_cast<size_t>(max_locked_targets)) {
                 target_comp->locked_targets.push_back(target_id);
             }
             // Remove from locking map
@@ -52,9 +58,12 @@ bool TargetingSystem::startLock(const std::string& entity_id, const std::string&
     if (!entity) return false;
     
     auto* target_comp = entity->getComponent<components::Target>();
-    auto* ship = entity->getComponent<components::Ship>();
+    float max_locked_targets = 0.0f;
     
-    if (!target_comp || !ship) return false;
+    if (!target_comp ||
+        !data::entityShipStat(*entity, data::ShipStat::MaxLockedTargets, max_locked_targets)) {
+        return false;
+    }
     
     // Check if already locked
     auto it = std::find(target_comp->locked_targets.begin(), 
@@ -71,7 +80,7 @@ bool TargetingSystem::startLock(const std::string& entity_id, const std::string&
     
     // Check max targets
     size_t total_targets = target_comp->locked_targets.size() + target_comp->locking_targets.size();
-    if (total_targets >= static_cast<size_t>(ship->max_locked_targets)) {
+    if (total_targets >= static_cast<size_t>(max_locked_targets)) {
         return false;  // Too many targets
     }
     
@@ -4,6 +4,7 @@
 #include "components/game_components.h"
 #include <cmath>
 #include <algorithm>
+#include <iostream>
 
 namespace atlas {
 namespace systems {
@@ -74,62 +75,34 @@ bool WeaponSystem::fireWeapon(const std::string& shooter_id, const std::string&
     float damage_multiplier = calculateFalloff(distance, weapon->optimal_range, weapon->falloff_range);
     float effective_damage = weapon->damage * damage_multiplier;
     
-    // Apply damage through CombatSystem
     auto* target_health = target->getComponent<components::Health>();
     if (!target_health) return false;
     
-    // Apply damage to shields first, then armor, then hull (EVE damage cascade)
-    float remaining = effective_damage;
-    
-    // Shield layer
-    if (target_health->shield_hp > 0.0f && remaining > 0.0f) {
-        float resist = 0.0f;
-        if (weapon->damage_type == "em") resist = target_health->shield_em_resist;
-        else if (weapon->damage_type == "thermal") resist = target_health->shield_thermal_resist;
-        else if (weapon->damage_type == "kinetic") resist = target_health->shield_kinetic_resist;
-        else if (weapon->damage_type == "explosive") resist = target_health->shield_explosive_resist;
-        
-        float applied = remaining * (1.0f - resist);
-        target_health->shield_hp -= applied;
-        if (target_health->shield_hp < 0.0f) {
-            remaining = -target_health->shield_hp / (1.0f - resist);
-            target_health->shield_hp = 0.0f;
-        } else {
-            remaining = 0.0f;
+    DamageType type = parseDamageType(weapon->damage_type);
+    if (type == DamageType::Count) {
+        // Bad data: the pipeline has no lane for it, so hit with no resistance
+        if (warned_damage_types_.insert(weapon->damage_type).second) {
+            std::cerr << "[WeaponSystem] Unknown damage type '" << weapon->damage_type
+                      << "' on " << shooter_id << "; applied without resistances" << std::endl;
         }
-    }
-    
-    // Armor layer
-    if (target_health->armor_hp > 0.0f && remaining > 0.0f) {
-        float resist = 0.0f;
-        if (weapon->damage_type == "em") resist = target_health->armor_em_resist;
-        else if (weapon->damage_type == "thermal") resist = target_health->armor_thermal_resist;
-        else if (weapon->damage_type == "kinetic") resist = target_health->armor_kinetic_resist;
-        else if (weapon->damage_type == "explosive") resist = target_health->armor_explosive_resist;
-        
-        float applied = remaining * (1.0f - resist);
-        target_health->armor_hp -= applied;
-        if (target_health->armor_hp < 0.0f) {
-            remaining = -target_health->armor_hp / (1.0f - resist);
-            target_health->armor_hp = 0.0f;
+        if (combat_) {
+            combat_->applyDamage(target_id, effective_damage, weapon->damage_type, shooter_id);
         } else {
-            remaining = 0.0f;
-        }
-    }
-    
-    // Hull layer
-    if (target_health->hull_hp > 0.0f && remaining > 0.0f) {
-        float resist = 0.0f;
-        if (weapon->damage_type == "em") resist = target_health->hull_em_resist;
-        else if (weapon->damage_type == "thermal") resist = target_health->hull_thermal_resist;
-        else if (weapon->damage_type == "kinetic") resist = target_health->hull_kinetic_resist;
-        else if (weapon->damage_type == "explosive") resist = target_health->hull_explosive_resist;
-        
-        float applied = remaining * (1.0f - resist);
-        target_health->hull_hp -= applied;
-        if (target_health->hull_hp < 0.0f) {
-            target_health->hull_hp = 0.0f;
+            float remaining = effective_damage;
+            for (float* hp : {&target_health->shield_hp, &target_health->armor_hp, &target_health->hull_hp}) {
+                float taken = std::min(std::max(*hp, 0.0f), remaining);
+                *hp -= taken;
+                remaining -= taken;
+            }
         }
+    } else if (combat_) {
+        // Batched: resolved per target when CombatSystem updates
+        combat_->queueDamage(target_id, effective_damage, type, shooter_id);
+    } else {
+        // Immediate: shields first, then armor, then hull (EVE damage cascade)
+        DamageVector hit;
+        hit.amount[static_cast<int>(type)] = effective_damage;
+        applyDamageVector(*target_health, hit);
     }
     
     // Set weapon cooldown and consume ammo
@@ -50,6 +50,18 @@ bool WormholeSystem::jumpThroughWormhole(const std::string& wormhole_entity_id,
     return true;
 }
 
+bool WormholeSystem::jumpShipThroughWormhole(const std::string& wormhole_entity_id,
+                                             const std::string& ship_id, double ship_mass) {
+    if (!jumpThroughWormhole(wormhole_entity_id, ship_mass)) return false;
+
+    if (handoff_callback_) {
+        auto* wh = world_->getEntity(wormhole_entity_id)
+                       ->getComponent<components::WormholeConnection>();
+        handoff_callback_(ship_id, wh->destination_system);
+    }
+    return true;
+}
+
 bool WormholeSystem::isWormholeStable(const std::string& wormhole_entity_id) const {
     auto* entity = world_->getEntity(wormhole_entity_id);
     if (!entity) return false;
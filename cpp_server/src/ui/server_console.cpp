@@ -95,6 +95,7 @@ namespace {
 bool ServerConsole::init(Server& server, const ServerConfig& config) {
     server_ = &server;
     config_ = &config;
+    m_initialized = true;
     
     if (m_interactive) {
         setNonBlockingStdin(true);
@@ -199,7 +200,11 @@ std::string ServerConsole::executeCommand(const std::string& command) {
     }
     
     // Dispatch to server-aware command handlers
-    if (base_cmd == "players") {
+    if (base_cmd == "help") {
+        return handleHelpCommand();
+    } else if (base_cmd == "status") {
+        return handleStatusCommand();
+    } else if (base_cmd == "players") {
         return handlePlayersCommand();
     } else if (base_cmd == "kick") {
         std::string player_name;
@@ -210,6 +215,11 @@ std::string ServerConsole::executeCommand(const std::string& command) {
         return handleStopCommand();
     } else if (base_cmd == "metrics") {
         return handleMetricsCommand();
+    } else if (base_cmd == "clients") {
+        std::vector<std::string> args;
+        std::string arg;
+        while (iss >> arg) args.push_back(arg);
+        return handleClientsCommand(args);
     } else if (base_cmd == "save") {
         return handleSaveCommand();
     } else if (base_cmd == "load") {
@@ -227,6 +237,7 @@ std::string ServerConsole::handleHelpCommand() {
     oss << "  players         - List connected players\n";
     oss << "  kick <player>   - Kick a player (not yet implemented)\n";
     oss << "  metrics         - Show detailed performance metrics\n";
+    oss << "  clients [n] [k] - Top n connections by k (out, in, rtt, queue, apply)\n";
     oss << "  save            - Save world state\n";
     oss << "  load            - Load world state (not yet implemented)\n";
     oss << "  stop            - Gracefully stop the server";
@@ -279,6 +290,25 @@ std::string ServerConsole::handleMetricsCommand() {
     return metrics.summary();
 }
 
+std::string ServerConsole::handleClientsCommand(const std::vector<std::string>& args) {
+    const auto* telemetry = server_->getTelemetry();
+    if (!telemetry) {
+        return "Connection telemetry not available";
+    }
+
+    size_t count = 10;
+    auto key = network::ConnectionTelemetry::SortKey::BytesOut;
+    for (const auto& arg : args) {
+        if (!arg.empty() && std::all_of(arg.begin(), arg.end(),
+                                        [](unsigned char c) { return std::isdigit(c) != 0; })) {
+            count = static_cast<size_t>(std::stoul(arg));
+        } else if (!network::ConnectionTelemetry::parseSortKey(arg, key)) {
+            return "Usage: clients [count] [out|in|rtt|queue|apply]";
+        }
+    }
+    return telemetry->formatTop(count, key);
+}
+
 std::string ServerConsole::handleSaveCommand() {
     if (server_->saveWorld()) {
         return "World saved successfully";
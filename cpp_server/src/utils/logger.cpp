@@ -1,8 +1,10 @@
 #include "utils/logger.h"
 #include <iostream>
-#include <iomanip>
-#include <sstream>
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 #include <sys/stat.h>
 #ifdef _WIN32
 #include <direct.h>
@@ -11,6 +13,148 @@
 namespace atlas {
 namespace utils {
 
+namespace {
+
+bool ensureDirectory(const std::string& dir) {
+    struct stat st;
+    if (stat(dir.c_str(), &st) == 0) return true;
+#ifdef _WIN32
+    return _mkdir(dir.c_str()) == 0;
+#else
+    return mkdir(dir.c_str(), 0755) == 0;
+#endif
+}
+
+uint64_t fileSize(const std::string& path) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return 0;
+    return static_cast<uint64_t>(st.st_size);
+}
+
+void appendJsonEscaped(std::string& out, const std::string& text) {
+    for (char c : text) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n";  break;
+            case '\r': out += "\\r";  break;
+            case '\t': out += "\\t";  break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out += buf;
+                } else {
+                    out += c;
+                }
+        }
+    }
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// Deferred formatting
+// ---------------------------------------------------------------------------
+
+namespace log_format {
+
+void appendValue(std::string& out, bool value) { out += value ? "true" : "false"; }
+void appendValue(std::string& out, char value) { out += value; }
+void appendValue(std::string& out, long long value) { out += std::to_string(value); }
+void appendValue(std::string& out, unsigned long long value) { out += std::to_string(value); }
+
+void appendValue(std::string& out, double value) {
+    char buf[32];
+    int n = std::snprintf(buf, sizeof(buf), "%g", value);
+    if (n > 0) out.append(buf, std::min(static_cast<size_t>(n), sizeof(buf) - 1));
+}
+
+void nextPlaceholder(std::string& out, const char*& format) {
+    const char* hole = std::strstr(format, "{}");
+    if (!hole) {
+        // More arguments than placeholders: append the extras
+        out += format;
+        out += ' ';
+        format += std::strlen(format);
+        return;
+    }
+    out.append(format, static_cast<size_t>(hole - format));
+    format = hole + 2;
+}
+
+} // namespace log_format
+
+/**
+ * A ring slot: the entry plus, for logFormat() calls, the packed
+ * arguments the consumer renders into entry.message.
+ */
+struct Logger::Slot {
+    Entry entry;
+    const char* format = nullptr;
+    RenderFn render = nullptr;
+    alignas(8) char args[kInlineArgBytes];
+
+    Entry take() {
+        if (render) {
+            entry.message.clear();
+            render(entry.message, format, args);
+        }
+        return std::move(entry);
+    }
+};
+
+/**
+ * Single-producer / single-consumer ring owned by one logging thread.
+ * The producer only advances head, the consumer (whoever holds
+ * drain_mutex_) only advances tail, so neither side takes a lock.  The
+ * producer re-reads tail only when its cached copy says the ring is full,
+ * which keeps the consumer's cache line out of the common path.
+ */
+struct Logger::Ring {
+    Ring(size_t capacity, uint32_t index)
+        : slots(capacity), mask(capacity - 1), thread(index) {}
+
+    template <typename Fill>
+    bool tryPush(LogLevel level, int64_t time_us, Fill& fill) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h - cached_tail > mask) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (h - cached_tail > mask) return false;
+        }
+        Slot& s = slots[h & mask];
+        s.entry.time_us = time_us;
+        s.entry.level = level;
+        s.entry.thread = thread;
+        fill(s);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t popAll(std::vector<Entry>& out) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t h = head.load(std::memory_order_acquire);
+        size_t count = h - t;
+        for (; t != h; ++t) {
+            out.push_back(slots[t & mask].take());
+        }
+        tail.store(t, std::memory_order_release);
+        return count;
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    std::vector<Slot> slots;
+    size_t mask;
+    uint32_t thread;
+    alignas(64) std::atomic<size_t> head{0};
+    size_t cached_tail = 0;              // producer's last view of tail
+    alignas(64) std::atomic<size_t> tail{0};
+    std::atomic<bool> orphaned{false};   // owning thread has exited
+};
+
 Logger& Logger::instance() {
     static Logger inst;
     return inst;
@@ -19,6 +163,7 @@ Logger& Logger::instance() {
 Logger::Logger() = default;
 
 Logger::~Logger() {
+    stopAsync();
     shutdown();
 }
 
@@ -26,14 +171,7 @@ bool Logger::init(const std::string& log_dir, const std::string& filename) {
     std::lock_guard<std::mutex> lock(mutex_);
 
     // Create directory if it doesn't exist
-    struct stat st;
-    if (stat(log_dir.c_str(), &st) != 0) {
-#ifdef _WIN32
-        _mkdir(log_dir.c_str());
-#else
-        mkdir(log_dir.c_str(), 0755);
-#endif
-    }
+    ensureDirectory(log_dir);
 
     std::string path = log_dir + "/" + filename;
     log_file_.open(path, std::ios::out | std::ios::app);
@@ -41,34 +179,52 @@ bool Logger::init(const std::string& log_dir, const std::string& filename) {
         std::cerr << "[Logger] Failed to open log file: " << path << std::endl;
         return false;
     }
+    log_file_path_ = path;
+    log_file_bytes_ = fileSize(path);
+    return true;
+}
+
+bool Logger::initJson(const std::string& log_dir, const std::string& filename) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ensureDirectory(log_dir);
+
+    std::string path = log_dir + "/" + filename;
+    json_file_.open(path, std::ios::out | std::ios::app);
+    if (!json_file_.is_open()) {
+        std::cerr << "[Logger] Failed to open JSON log file: " << path << std::endl;
+        return false;
+    }
+    json_file_path_ = path;
+    json_file_bytes_ = fileSize(path);
     return true;
 }
 
 void Logger::shutdown() {
+    drain();
+
     std::lock_guard<std::mutex> lock(mutex_);
     if (log_file_.is_open()) {
         log_file_.close();
     }
+    if (json_file_.is_open()) {
+        json_file_.close();
+    }
 }
 
 void Logger::setLevel(LogLevel level) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    min_level_ = level;
+    min_level_.store(level, std::memory_order_relaxed);
 }
 
 LogLevel Logger::getLevel() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return min_level_;
+    return min_level_.load(std::memory_order_relaxed);
 }
 
 void Logger::setConsoleOutput(bool enabled) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    console_output_ = enabled;
+    console_output_.store(enabled, std::memory_order_relaxed);
 }
 
 void Logger::setFileOutput(bool enabled) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    file_output_ = enabled;
+    file_output_.store(enabled, std::memory_order_relaxed);
 }
 
 bool Logger::isFileOpen() const {
@@ -76,36 +232,310 @@ bool Logger::isFileOpen() const {
     return log_file_.is_open();
 }
 
-// Convenience methods
-void Logger::debug(const std::string& message) { log(LogLevel::DEBUG, message); }
-void Logger::info(const std::string& message)  { log(LogLevel::INFO, message);  }
-void Logger::warn(const std::string& message)  { log(LogLevel::WARN, message);  }
-void Logger::error(const std::string& message) { log(LogLevel::ERROR, message); }
-void Logger::fatal(const std::string& message) { log(LogLevel::FATAL, message); }
+bool Logger::isJsonOpen() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return json_file_.is_open();
+}
 
-void Logger::log(LogLevel level, const std::string& message) {
+void Logger::setRotation(uint64_t max_bytes, int max_files) {
     std::lock_guard<std::mutex> lock(mutex_);
+    rotate_bytes_ = max_bytes;
+    rotate_files_ = std::max(0, max_files);
+}
 
-    if (level < min_level_) {
+// Convenience methods
+void Logger::debug(std::string message) { log(LogLevel::DEBUG, std::move(message)); }
+void Logger::info(std::string message)  { log(LogLevel::INFO, std::move(message));  }
+void Logger::warn(std::string message)  { log(LogLevel::WARN, std::move(message));  }
+void Logger::error(std::string message) { log(LogLevel::ERROR, std::move(message)); }
+void Logger::fatal(std::string message) { log(LogLevel::FATAL, std::move(message)); }
+
+void Logger::log(LogLevel level, std::string message) {
+    if (level < min_level_.load(std::memory_order_relaxed)) {
         return;
     }
+    submit(level, [&](Slot& s) {
+        s.entry.message = std::move(message);
+        s.render = nullptr;
+    });
+}
+
+void Logger::logPacked(LogLevel level, const char* format, RenderFn render,
+                       const char* args, size_t size) {
+    submit(level, [&](Slot& s) {
+        s.format = format;
+        s.render = render;
+        std::memcpy(s.args, args, size);
+    });
+}
 
-    std::string ts = timestamp();
-    std::string lvl = levelToString(level);
-    std::string line = ts + " [" + lvl + "] " + message;
+template <typename Fill>
+void Logger::submit(LogLevel level, Fill&& fill) {
+    int64_t now_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
 
-    if (console_output_) {
-        auto& out = (level >= LogLevel::ERROR) ? std::cerr : std::cout;
-        out << line << std::endl;
+    if (async_.load(std::memory_order_acquire)) {
+        Ring* ring = threadRing();
+        bool pushed = ring->tryPush(level, now_us, fill);
+        if (!pushed && async_options_.overflow == LogOverflow::Block) {
+            // Nudge the writer and wait for room, but never past the timeout
+            auto deadline = std::chrono::steady_clock::now() +
+                            std::chrono::milliseconds(async_options_.block_timeout_ms);
+            std::unique_lock<std::mutex> lock(space_mutex_);
+            while (!(pushed = ring->tryPush(level, now_us, fill)) &&
+                   async_.load(std::memory_order_acquire)) {
+                {
+                    std::lock_guard<std::mutex> writer_lock(writer_mutex_);
+                    writer_wake_ = true;
+                }
+                writer_cv_.notify_one();
+                if (space_cv_.wait_until(lock, deadline) == std::cv_status::timeout) {
+                    pushed = ring->tryPush(level, now_us, fill);
+                    break;
+                }
+            }
+        }
+        if (pushed) {
+            // Raced stopAsync(): write our entry out rather than leave it
+            // for the next flush()
+            if (level == LogLevel::FATAL || !async_.load(std::memory_order_acquire)) {
+                drain();
+            }
+            return;
+        }
+        if (async_.load(std::memory_order_acquire)) {
+            dropped_total_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        // Writer stopped while we waited: fall through to a direct write
     }
 
-    if (file_output_ && log_file_.is_open()) {
-        log_file_ << line << std::endl;
-        log_file_.flush();
+    Slot direct;
+    direct.entry.time_us = now_us;
+    direct.entry.level = level;
+    fill(direct);
+    std::vector<Entry> batch;
+    batch.push_back(direct.take());
+    writeBatch(batch);
+}
+
+bool Logger::startAsync() {
+    return startAsync(AsyncOptions());
+}
+
+bool Logger::startAsync(const AsyncOptions& options) {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    if (async_.load(std::memory_order_acquire)) return true;
+
+    async_options_ = options;
+    size_t capacity = 2;
+    while (capacity < options.ring_capacity) capacity <<= 1;
+    async_options_.ring_capacity = capacity;
+    async_options_.flush_interval_ms = std::max(1, options.flush_interval_ms);
+    async_options_.block_timeout_ms = std::max(0, options.block_timeout_ms);
+
+    // Rings from an earlier session are replaced on each thread's next
+    // call; they stay registered until drained so no late entry is lost
+    drain();
+    {
+        std::lock_guard<std::mutex> rings_lock(rings_mutex_);
+        for (auto& ring : rings_) ring->orphaned.store(true, std::memory_order_release);
+        next_thread_index_ = 0;
     }
+    ring_generation_.fetch_add(1, std::memory_order_acq_rel);
+
+    writer_stop_ = false;
+    writer_wake_ = false;
+    writer_ = std::thread(&Logger::writerLoop, this);
+    async_.store(true, std::memory_order_release);
+    return true;
 }
 
-std::string Logger::levelToString(LogLevel level) {
+void Logger::stopAsync() {
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        if (!async_.exchange(false, std::memory_order_acq_rel)) return;
+        writer_stop_ = true;
+    }
+    writer_cv_.notify_all();
+    {
+        // Release Block producers so they fall back to direct writes
+        std::lock_guard<std::mutex> lock(space_mutex_);
+    }
+    space_cv_.notify_all();
+    if (writer_.joinable()) writer_.join();
+
+    // Final pass now that the writer is gone.  Rings stay registered, so
+    // a producer that pushes after this pass drains its own entry, and
+    // anything still racing is picked up by flush() or shutdown().
+    drain();
+}
+
+void Logger::flush() {
+    drain();
+}
+
+Logger::Ring* Logger::threadRing() {
+    struct Slot {
+        std::shared_ptr<Ring> ring;
+        uint64_t generation = 0;
+        ~Slot() {
+            if (ring) ring->orphaned.store(true, std::memory_order_release);
+        }
+    };
+    thread_local Slot slot;
+
+    uint64_t generation = ring_generation_.load(std::memory_order_acquire);
+    if (!slot.ring || slot.generation != generation) {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        if (slot.ring) slot.ring->orphaned.store(true, std::memory_order_release);
+        slot.ring = std::make_shared<Ring>(async_options_.ring_capacity, next_thread_index_++);
+        slot.generation = generation;
+        rings_.push_back(slot.ring);
+    }
+    return slot.ring.get();
+}
+
+void Logger::writerLoop() {
+    std::unique_lock<std::mutex> lock(writer_mutex_);
+    while (!writer_stop_) {
+        writer_cv_.wait_for(lock, std::chrono::milliseconds(async_options_.flush_interval_ms),
+                            [this]() { return writer_stop_ || writer_wake_; });
+        if (writer_stop_) break;
+        writer_wake_ = false;
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+}
+
+void Logger::drain() {
+    std::lock_guard<std::mutex> drain_lock(drain_mutex_);
+
+    std::vector<std::shared_ptr<Ring>> rings;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings = rings_;
+    }
+
+    std::vector<Entry> batch;
+    size_t popped = 0;
+    for (auto& ring : rings) {
+        popped += ring->popAll(batch);
+    }
+    if (popped > 0) {
+        {
+            std::lock_guard<std::mutex> lock(space_mutex_);
+        }
+        space_cv_.notify_all();
+    }
+
+    // Retire rings whose threads have exited and whose entries are written
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+            [](const std::shared_ptr<Ring>& r) {
+                return r->orphaned.load(std::memory_order_acquire) && r->empty();
+            }), rings_.end());
+    }
+
+    uint64_t dropped = dropped_total_.load(std::memory_order_relaxed);
+    if (dropped != dropped_reported_) {
+        Entry note;
+        note.time_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        note.level = LogLevel::WARN;
+        note.message = "[Logger] " + std::to_string(dropped - dropped_reported_) +
+                       " messages dropped (ring buffer full)";
+        batch.push_back(std::move(note));
+        dropped_reported_ = dropped;
+    }
+
+    if (batch.empty()) return;
+
+    // Interleave threads in the order the messages were logged
+    std::stable_sort(batch.begin(), batch.end(),
+                     [](const Entry& a, const Entry& b) { return a.time_us < b.time_us; });
+    writeBatch(batch);
+}
+
+void Logger::writeBatch(std::vector<Entry>& batch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    bool console = console_output_.load(std::memory_order_relaxed);
+    bool files = file_output_.load(std::memory_order_relaxed);
+    bool to_text = files && log_file_.is_open();
+    bool to_json = files && json_file_.is_open();
+
+    std::string out, err, text, json;
+    for (const auto& e : batch) {
+        const char* ts = formatTime(e.time_us);
+        const char* lvl = levelToString(e.level);
+
+        if (console || to_text) {
+            std::string line;
+            line.reserve(e.message.size() + 40);
+            line += ts;
+            line += " [";
+            line += lvl;
+            line += "] ";
+            line += e.message;
+            line += '\n';
+            if (console) ((e.level >= LogLevel::ERROR) ? err : out) += line;
+            if (to_text) text += line;
+        }
+
+        if (to_json) {
+            json += "{\"ts\":\"";
+            json += ts;
+            json += "\",\"level\":\"";
+            json += lvl;
+            json += "\",\"thread\":";
+            json += std::to_string(e.thread);
+            json += ",\"msg\":\"";
+            appendJsonEscaped(json, e.message);
+            json += "\"}\n";
+        }
+    }
+
+    if (!out.empty()) {
+        std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+        std::cout.flush();
+    }
+    if (!err.empty()) {
+        std::cerr.write(err.data(), static_cast<std::streamsize>(err.size()));
+        std::cerr.flush();
+    }
+    if (to_text) writeFile(log_file_, log_file_path_, log_file_bytes_, text);
+    if (to_json) writeFile(json_file_, json_file_path_, json_file_bytes_, json);
+}
+
+void Logger::writeFile(std::ofstream& file, const std::string& path,
+                       uint64_t& bytes, const std::string& data) {
+    if (rotate_bytes_ > 0 && bytes > 0 && bytes + data.size() > rotate_bytes_) {
+        file.close();
+        // server.log.N-1 -> server.log.N ... server.log -> server.log.1
+        std::remove((path + "." + std::to_string(rotate_files_)).c_str());
+        for (int i = rotate_files_ - 1; i >= 1; --i) {
+            std::rename((path + "." + std::to_string(i)).c_str(),
+                        (path + "." + std::to_string(i + 1)).c_str());
+        }
+        if (rotate_files_ > 0) {
+            std::rename(path.c_str(), (path + ".1").c_str());
+        } else {
+            std::remove(path.c_str());
+        }
+        file.open(path, std::ios::out | std::ios::trunc);
+        bytes = 0;
+        if (!file.is_open()) return;
+    }
+
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    file.flush();
+    bytes += data.size();
+}
+
+const char* Logger::levelToString(LogLevel level) {
     switch (level) {
         case LogLevel::DEBUG: return "DEBUG";
         case LogLevel::INFO:  return "INFO";
@@ -116,23 +546,26 @@ std::string Logger::levelToString(LogLevel level) {
     return "UNKNOWN";
 }
 
-std::string Logger::timestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t_now = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
+const char* Logger::formatTime(int64_t time_us) {
+    int64_t ms = time_us / 1000;
+    if (ms == cached_ms_) return cached_time_;
 
-    std::tm tm_buf;
+    int64_t second = ms / 1000;
+    if (second != cached_second_) {
+        std::time_t t = static_cast<std::time_t>(second);
+        std::tm tm_buf;
 #ifdef _WIN32
-    localtime_s(&tm_buf, &time_t_now);
+        localtime_s(&tm_buf, &t);
 #else
-    localtime_r(&time_t_now, &tm_buf);
+        localtime_r(&t, &tm_buf);
 #endif
-
-    std::ostringstream oss;
-    oss << std::put_time(&tm_buf, "%Y-%m-%d %H:%M:%S");
-    oss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-    return oss.str();
+        std::strftime(cached_time_, sizeof(cached_time_), "%Y-%m-%d %H:%M:%S", &tm_buf);
+        cached_second_ = second;
+    }
+    std::snprintf(cached_time_ + 19, sizeof(cached_time_) - 19, ".%03d",
+                  static_cast<int>(ms % 1000));
+    cached_ms_ = ms;
+    return cached_time_;
 }
 
 } // namespace utils
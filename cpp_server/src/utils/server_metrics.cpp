@@ -3,6 +3,7 @@
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <cmath>
 
 namespace atlas {
 namespace utils {
@@ -89,6 +90,47 @@ std::string ServerMetrics::getUptimeString() const {
     return oss.str();
 }
 
+void ServerMetrics::recordDilation(const std::string& system_id, float factor) {
+    double now = getUptimeSeconds();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (factor < dilation_min_) {
+        dilation_min_ = factor;
+        dilation_min_system_ = system_id;
+    }
+
+    auto& history = dilation_history_[system_id];
+    if (!history.empty()) {
+        const auto& last = history.back();
+        bool moved = std::abs(last.factor - factor) >= 0.01f;
+        bool heartbeat = factor < 1.0f && now - last.uptime_seconds >= 1.0;
+        if (!moved && !heartbeat) return;
+    } else if (factor >= 1.0f) {
+        return;  // nothing worth recording until the system first dilates
+    }
+
+    history.push_back({now, factor});
+    if (history.size() > MAX_DILATION_SAMPLES) history.pop_front();
+}
+
+std::vector<ServerMetrics::DilationSample>
+ServerMetrics::getDilationHistory(const std::string& system_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = dilation_history_.find(system_id);
+    if (it == dilation_history_.end()) return {};
+    return std::vector<DilationSample>(it->second.begin(), it->second.end());
+}
+
+float ServerMetrics::getMinDilation() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dilation_min_;
+}
+
+std::string ServerMetrics::getMostDilatedSystem() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dilation_min_system_;
+}
+
 std::string ServerMetrics::summary() const {
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -120,6 +162,38 @@ std::string ServerMetrics::summary() const {
     }
 
     oss << " | ticks=" << tick_count_total_;
+
+    if (dilation_min_ < 1.0f) {
+        oss << " | tidi min=" << dilation_min_ << " (" << dilation_min_system_ << ")";
+    }
+    return oss.str();
+}
+
+std::string ServerMetrics::prometheusText() const {
+    double uptime = getUptimeSeconds();
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::ostringstream oss;
+    oss << std::setprecision(9);
+    auto gauge = [&oss](const char* name, const char* help, double value) {
+        oss << "# HELP " << name << " " << help << "\n"
+            << "# TYPE " << name << " gauge\n"
+            << name << " " << value << "\n";
+    };
+
+    gauge("atlas_uptime_seconds", "Seconds since the server started", uptime);
+    oss << "# HELP atlas_ticks_total Simulation ticks run\n"
+        << "# TYPE atlas_ticks_total counter\n"
+        << "atlas_ticks_total " << tick_count_total_ << "\n";
+    if (tick_count_window_ > 0) {
+        gauge("atlas_tick_duration_avg_ms", "Mean tick duration over the reporting window",
+              tick_sum_ms_ / tick_count_window_);
+        gauge("atlas_tick_duration_max_ms", "Worst tick duration over the reporting window",
+              tick_max_ms_);
+    }
+    gauge("atlas_entities", "Entities in the world", entity_count_);
+    gauge("atlas_players", "Connected players", player_count_);
+    gauge("atlas_time_dilation_min", "Lowest time dilation factor this window", dilation_min_);
     return oss.str();
 }
 
@@ -140,6 +214,8 @@ void ServerMetrics::resetWindow() {
     tick_max_ms_ = 0.0;
     tick_min_ms_ = 0.0;
     tick_count_window_ = 0;
+    dilation_min_ = 1.0f;
+    dilation_min_system_.clear();
 }
 
 } // namespace utils
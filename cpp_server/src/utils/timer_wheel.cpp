@@ -0,0 +1,122 @@
+#include "utils/timer_wheel.h"
+#include <cmath>
+
+namespace atlas {
+namespace utils {
+
+TimerWheel::TimerWheel(double resolution)
+    : resolution_(resolution > 0.0 ? resolution : 1.0) {
+}
+
+uint64_t TimerWheel::tickOf(double time) const {
+    if (!(time > 0.0)) return 0;
+    return static_cast<uint64_t>(std::floor(time / resolution_));
+}
+
+void TimerWheel::schedule(const std::string& key, double deadline) {
+    armed_[key] = deadline;
+    insert(Entry{key, deadline, tickOf(deadline)});
+}
+
+bool TimerWheel::cancel(const std::string& key) {
+    return armed_.erase(key) > 0;
+}
+
+bool TimerWheel::isScheduled(const std::string& key) const {
+    return armed_.count(key) > 0;
+}
+
+void TimerWheel::insert(Entry entry) {
+    if (entry.tick <= current_) {
+        due_.push_back(std::move(entry));
+        return;
+    }
+    uint64_t delta = entry.tick - current_;
+    for (int level = 0; level < LEVELS; ++level) {
+        if (delta < (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+            size_t slot = (entry.tick >> (SLOT_BITS * level)) & (SLOTS - 1);
+            slots_[level][slot].push_back(std::move(entry));
+            ++level_count_[level];
+            return;
+        }
+    }
+    overflow_.push_back(std::move(entry));
+}
+
+void TimerWheel::cascade() {
+    // Entries above level 0 are re-filed when the wheel reaches the start
+    // of their block; higher levels first so they can fall through to the
+    // lower slot that is emptied on this same tick
+    if ((current_ & ((uint64_t(1) << (SLOT_BITS * LEVELS)) - 1)) == 0 && !overflow_.empty()) {
+        std::vector<Entry> pending;
+        pending.swap(overflow_);
+        for (auto& entry : pending) insert(std::move(entry));
+    }
+    for (int level = LEVELS - 1; level >= 1; --level) {
+        uint64_t span_mask = (uint64_t(1) << (SLOT_BITS * level)) - 1;
+        if ((current_ & span_mask) != 0) continue;
+        size_t slot = (current_ >> (SLOT_BITS * level)) & (SLOTS - 1);
+        auto& bucket = slots_[level][slot];
+        if (bucket.empty()) continue;
+        ++slots_visited_;
+        std::vector<Entry> pending;
+        pending.swap(bucket);
+        level_count_[level] -= pending.size();
+        for (auto& entry : pending) insert(std::move(entry));
+    }
+}
+
+void TimerWheel::advance(double now, std::vector<Timer>& expired) {
+    if (now > now_) now_ = now;
+    uint64_t target = tickOf(now_);
+
+    while (current_ < target) {
+        int lowest = LEVELS;
+        for (int level = 0; level < LEVELS; ++level) {
+            if (level_count_[level] > 0) { lowest = level; break; }
+        }
+        if (lowest == LEVELS && overflow_.empty()) {
+            current_ = target;
+            break;
+        }
+
+        // Nothing below the lowest occupied level, so skip to its next
+        // block boundary — the first tick at which it can release entries
+        uint64_t span = uint64_t(1) << (SLOT_BITS * lowest);
+        uint64_t next = (current_ | (span - 1)) + 1;
+        if (next > target) {
+            current_ = target;
+            break;
+        }
+        current_ = next;
+        cascade();
+
+        auto& bucket = slots_[0][current_ & (SLOTS - 1)];
+        if (!bucket.empty()) {
+            ++slots_visited_;
+            level_count_[0] -= bucket.size();
+            for (auto& entry : bucket) due_.push_back(std::move(entry));
+            bucket.clear();
+        }
+    }
+
+    // Fire what is due; entries whose tick arrived but whose deadline lies
+    // later in the same tick wait for the next advance
+    size_t kept = 0;
+    for (size_t i = 0; i < due_.size(); ++i) {
+        Entry& entry = due_[i];
+        auto it = armed_.find(entry.key);
+        if (it == armed_.end() || it->second != entry.deadline) continue;  // superseded
+        if (entry.deadline <= now_) {
+            armed_.erase(it);
+            expired.push_back(Timer{std::move(entry.key), entry.deadline});
+        } else {
+            if (kept != i) due_[kept] = std::move(entry);
+            ++kept;
+        }
+    }
+    due_.resize(kept);
+}
+
+} // namespace utils
+} // namespace atlas
@@ -15,6 +15,7 @@
 #include "systems/targeting_system.h"
 #include "data/ship_database.h"
 #include "data/wormhole_database.h"
+#include "data/universe_database.h"
 #include "systems/wormhole_system.h"
 #include "systems/fleet_system.h"
 #include "systems/mission_system.h"
@@ -27,6 +28,7 @@
 #include "systems/corporation_system.h"
 #include "systems/bounty_system.h"
 #include "systems/market_system.h"
+#include "data/market_history.h"
 #include "systems/contract_system.h"
 #include "systems/pi_system.h"
 #include "systems/manufacturing_system.h"
@@ -37,6 +39,8 @@
 #include "systems/leaderboard_system.h"
 #include "data/world_persistence.h"
 #include "data/npc_database.h"
+#include "data/data_bake.h"
+#include "data/ship_template_registry.h"
 #include "systems/movement_system.h"
 #include "systems/station_system.h"
 #include "systems/wreck_salvage_system.h"
@@ -70,10 +74,20 @@
 #include "systems/combat_threat_system.h"
 #include "systems/security_response_system.h"
 #include "systems/ambient_traffic_system.h"
+#include "systems/game_events.h"
 #include "network/protocol_handler.h"
+#include "network/chat_hub.h"
+#include "network/connection_telemetry.h"
+#include "network/tcp_server.h"
+#include "game_session.h"
+#include "sim/partition_manager.h"
+#include "sim/replay_log.h"
+#include "cluster/cluster_node.h"
+#include "cluster/cluster_proxy.h"
 #include "ui/server_console.h"
 #include "utils/logger.h"
 #include "utils/server_metrics.h"
+#include "utils/timer_wheel.h"
 #include <iostream>
 #include <cassert>
 #include <string>
@@ -81,6 +95,8 @@
 #include <memory>
 #include <fstream>
 #include <thread>
+#include <chrono>
+#include <mutex>
 #include <sys/stat.h>
 
 using namespace atlas;
@@ -489,6 +505,191 @@ void testWeaponNoAutoFireIdleAI() {
     assertTrue(approxEqual(playerHealth->shield_hp, 100.0f), "Idle AI does not auto-fire");
 }
 
+// ==================== Damage Pipeline Tests ====================
+
+static ecs::Entity* makeDamageTarget(ecs::World& world, const std::string& id,
+                                     float shield, float armor, float hull) {
+    auto* target = world.createEntity(id);
+    addComp<components::Position>(target);
+    auto* health = addComp<components::Health>(target);
+    health->shield_hp = shield;
+    health->shield_max = shield;
+    health->armor_hp = armor;
+    health->armor_max = armor;
+    health->hull_hp = hull;
+    health->hull_max = hull;
+    return target;
+}
+
+void testDamagePipelineBatchesPerTarget() {
+    std::cout << "\n=== Damage Pipeline Batches Per Target ===" << std::endl;
+
+    ecs::World world;
+    systems::WeaponSystem weaponSys(&world);
+    systems::CombatSystem combatSys(&world);
+    weaponSys.setCombatSystem(&combatSys);
+
+    auto* target = makeDamageTarget(world, "target", 500.0f, 100.0f, 100.0f);
+    auto* health = target->getComponent<components::Health>();
+    for (int i = 0; i < 3; ++i) {
+        auto* shooter = world.createEntity("shooter_" + std::to_string(i));
+        auto* weapon = addComp<components::Weapon>(shooter);
+        weapon->damage = 40.0f;
+        weapon->damage_type = "kinetic";
+        weapon->capacitor_cost = 0.0f;
+        weapon->optimal_range = 10000.0f;
+        addComp<components::Position>(shooter);
+        weaponSys.fireWeapon(shooter->getId(), "target");
+    }
+
+    assertTrue(approxEqual(health->shield_hp, 500.0f), "Queued hits not applied before flush");
+    assertTrue(combatSys.getDamagePipeline().getQueuedCount() == 3, "Three hits queued");
+    assertTrue(combatSys.getDamagePipeline().getQueuedTargetCount() == 1, "One target slot");
+
+    combatSys.update(0.1f);
+    assertTrue(approxEqual(health->shield_hp, 380.0f), "All hits applied on flush");
+
+    const auto& resolved = combatSys.getResolvedDamage();
+    assertTrue(resolved.size() == 1, "One aggregated result per target");
+    assertTrue(resolved.size() == 1 && resolved[0].hit_count == 3 &&
+               approxEqual(resolved[0].damage, 120.0f) &&
+               resolved[0].damage_type == "kinetic", "Aggregated result sums hits");
+
+    auto* dmgEvent = target->getComponent<components::DamageEvent>();
+    assertTrue(dmgEvent && dmgEvent->recent_hits.size() == 1,
+               "One DamageEvent hit per target per tick");
+
+    combatSys.update(0.1f);
+    assertTrue(combatSys.getResolvedDamage().empty(), "Empty flush yields no results");
+}
+
+void testDamagePipelineMixedResists() {
+    std::cout << "\n=== Damage Pipeline Mixed Resists ===" << std::endl;
+
+    ecs::World world;
+    systems::CombatSystem combatSys(&world);
+    auto* target = makeDamageTarget(world, "target", 500.0f, 100.0f, 100.0f);
+    auto* health = target->getComponent<components::Health>();
+    health->shield_em_resist = 0.5f;
+    health->shield_thermal_resist = 0.2f;
+
+    combatSys.queueDamage("target", 100.0f, systems::DamageType::EM);
+    combatSys.queueDamage("target", 100.0f, systems::DamageType::Thermal);
+    combatSys.queueDamage("target", 50.0f, systems::DamageType::EM);
+    combatSys.update(0.1f);
+
+    // 150 EM at 50% + 100 thermal at 20% = 75 + 80
+    assertTrue(approxEqual(health->shield_hp, 345.0f), "Per-type resists applied in one pass");
+    assertTrue(combatSys.getResolvedDamage().size() == 1 &&
+               combatSys.getResolvedDamage()[0].damage_type == "em",
+               "Dominant damage type reported");
+    assertTrue(!combatSys.queueDamage("target", 10.0f, systems::DamageType::Count),
+               "Unknown damage type rejected");
+    assertTrue(systems::parseDamageType("explosive") == systems::DamageType::Explosive,
+               "Damage type parsed to enum");
+}
+
+void testWeaponUnknownDamageTypeHitsUnresisted() {
+    std::cout << "\n=== Weapon Unknown Damage Type Hits Unresisted ===" << std::endl;
+
+    ecs::World world;
+    systems::WeaponSystem weaponSys(&world);
+    systems::CombatSystem combatSys(&world);
+
+    auto* target = makeDamageTarget(world, "target", 50.0f, 100.0f, 100.0f);
+    auto* health = target->getComponent<components::Health>();
+    health->shield_em_resist = health->shield_thermal_resist = 0.5f;
+    health->shield_kinetic_resist = health->shield_explosive_resist = 0.5f;
+
+    auto* shooter = world.createEntity("shooter");
+    auto* weapon = addComp<components::Weapon>(shooter);
+    weapon->damage = 80.0f;
+    weapon->damage_type = "plasma";
+    weapon->capacitor_cost = 0.0f;
+    weapon->optimal_range = 10000.0f;
+    weapon->ammo_count = 10;
+    addComp<components::Position>(shooter);
+
+    assertTrue(weaponSys.fireWeapon("shooter", "target"), "Shot with an unknown type fires");
+    assertTrue(approxEqual(health->shield_hp, 0.0f) && approxEqual(health->armor_hp, 70.0f),
+               "Immediate hit ignores resists and carries into armor");
+    assertTrue(weapon->ammo_count == 9, "Ammo spent on a shot that landed");
+
+    weaponSys.setCombatSystem(&combatSys);
+    weapon->cooldown = 0.0f;
+    assertTrue(weaponSys.fireWeapon("shooter", "target"), "Fires with the pipeline linked");
+    assertTrue(approxEqual(health->armor_hp, 0.0f) && approxEqual(health->hull_hp, 90.0f),
+               "Pipeline path still lands the unresisted hit");
+}
+
+void testDamagePipelineOverflowAndDeath() {
+    std::cout << "\n=== Damage Pipeline Overflow And Death ===" << std::endl;
+
+    ecs::World world;
+    systems::CombatSystem combatSys(&world);
+    int deaths = 0;
+    combatSys.setDeathCallback([&](const std::string&, float, float, float) { ++deaths; });
+
+    auto* target = makeDamageTarget(world, "target", 100.0f, 100.0f, 100.0f);
+    auto* health = target->getComponent<components::Health>();
+    health->armor_kinetic_resist = 0.5f;
+
+    // 100 raw breaks shields, 100 raw * 50% = 50 armor, rest carries on
+    combatSys.queueDamage("target", 150.0f, systems::DamageType::Kinetic);
+    combatSys.update(0.1f);
+    assertTrue(approxEqual(health->shield_hp, 0.0f), "Shield depleted");
+    assertTrue(approxEqual(health->armor_hp, 75.0f), "Overflow resisted by armor");
+    const auto& first = combatSys.getResolvedDamage();
+    assertTrue(first.size() == 1 && first[0].shield_depleted && first[0].layer_hit == "armor",
+               "Shield depletion reported");
+
+    combatSys.queueDamage("target", 1000.0f, systems::DamageType::Kinetic);
+    combatSys.update(0.1f);
+    assertTrue(approxEqual(health->hull_hp, 0.0f), "Hull destroyed");
+    assertTrue(combatSys.getResolvedDamage()[0].destroyed, "Destruction reported");
+    assertTrue(deaths == 1, "Death callback fired once");
+
+    combatSys.queueDamage("target", 10.0f, systems::DamageType::Kinetic);
+    combatSys.queueDamage("ghost", 10.0f, systems::DamageType::Kinetic);
+    combatSys.update(0.1f);
+    assertTrue(deaths == 1, "Dead target does not die again");
+    assertTrue(combatSys.getResolvedDamage().size() == 1, "Missing target skipped");
+}
+
+void testDamagePipelineFleetFight() {
+    std::cout << "\n=== Damage Pipeline Fleet Fight ===" << std::endl;
+
+    ecs::World world;
+    systems::CombatSystem combatSys(&world);
+    const int targets = 100;
+    for (int t = 0; t < targets; ++t) {
+        makeDamageTarget(world, "ship_" + std::to_string(t), 1e6f, 1e6f, 1e6f);
+    }
+
+    const int shots = 20000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < shots; ++i) {
+        combatSys.queueDamage("ship_" + std::to_string((i * 7) % targets), 10.0f,
+                              static_cast<systems::DamageType>(i % 4));
+    }
+    combatSys.update(0.1f);
+    double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    std::cout << "  " << shots << " hits on " << targets << " targets resolved in "
+              << ms << " ms" << std::endl;
+
+    const auto& resolved = combatSys.getResolvedDamage();
+    int total_hits = 0;
+    float total_damage = 0.0f;
+    for (const auto& r : resolved) {
+        total_hits += r.hit_count;
+        total_damage += r.damage;
+    }
+    assertTrue(resolved.size() == static_cast<size_t>(targets), "One result per target");
+    assertTrue(total_hits == shots, "Every hit accounted for");
+    assertTrue(approxEqual(total_damage, shots * 10.0f, 1.0f), "Damage conserved");
+}
+
 // ==================== TargetingSystem Tests ====================
 
 void testTargetLockUnlock() {
@@ -917,6 +1118,28 @@ void testWormholeDatabaseLoad() {
     assertTrue(db.getEffectCount() > 0, "Loaded at least 1 wormhole effect");
 }
 
+// ==================== UniverseDatabase Tests ====================
+
+void testUniverseDatabaseLoad() {
+    std::cout << "\n=== UniverseDatabase Load ===" << std::endl;
+
+    data::UniverseDatabase db;
+    int count = db.loadFromDirectory("../data");
+    if (count == 0) count = db.loadFromDirectory("data");
+    if (count == 0) count = db.loadFromDirectory("../../data");
+
+    assertTrue(db.getSystemCount() == 6, "Loaded all 6 solar systems");
+    assertTrue(db.getStartingSystem() == "thyrkstad", "First system in the file is the start");
+    const auto* sys = db.getSystem("thyrkstad");
+    assertTrue(sys != nullptr && sys->name == "Thyrkstad", "System name parsed");
+    assertTrue(sys != nullptr && !sys->station_ids.empty(), "Station ids parsed");
+    assertTrue(db.hasGate("thyrkstad", "rimward"), "Gate thyrkstad -> rimward");
+    assertTrue(db.hasGate("rimward", "duskfall"), "Gate listed only by duskfall works both ways");
+    assertTrue(!db.hasGate("thyrkstad", "maurasi"), "Gate to a system missing from the file ignored");
+    assertTrue(!db.hasGate("thyrkstad", "solari"), "Unlinked systems have no gate");
+    assertTrue(!db.hasGate("thyrkstad", "thyrkstad"), "No gate to the same system");
+}
+
 void testWormholeDatabaseGetClass() {
     std::cout << "\n=== WormholeDatabase Get Class ===" << std::endl;
     
@@ -2228,6 +2451,283 @@ void testLoggerLevelFiltering() {
     log.setLevel(utils::LogLevel::INFO);
 }
 
+static std::string readLogFile(const std::string& path) {
+    std::ifstream f(path);
+    return std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+}
+
+static int countOccurrences(const std::string& text, const std::string& needle) {
+    int n = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos;
+         pos = text.find(needle, pos + needle.size())) {
+        ++n;
+    }
+    return n;
+}
+
+void testLoggerAsyncMultiThread() {
+    std::cout << "\n=== Logger Async Multi-Thread ===" << std::endl;
+
+    auto& log = utils::Logger::instance();
+    log.setConsoleOutput(false);
+    log.shutdown();
+    std::remove("/tmp/eve_test_logs/async_test.log");
+    log.init("/tmp/eve_test_logs", "async_test.log");
+
+    assertTrue(log.startAsync(), "Async writer starts");
+    assertTrue(log.isAsync(), "Logger reports async mode");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&log, t]() {
+            for (int i = 0; i < 500; ++i) {
+                log.info("worker" + std::to_string(t) + " seq=" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    log.stopAsync();
+    assertTrue(!log.isAsync(), "Logger back to synchronous mode");
+    log.shutdown();
+
+    std::string content = readLogFile("/tmp/eve_test_logs/async_test.log");
+    assertTrue(countOccurrences(content, "[INFO] worker") == 2000,
+               "Every message from every thread written");
+    bool ordered = true;
+    for (int t = 0; t < 4; ++t) {
+        std::string prefix = "worker" + std::to_string(t) + " seq=";
+        size_t last = 0;
+        for (int i = 0; i < 500; i += 50) {
+            size_t pos = content.find(prefix + std::to_string(i) + "\n");
+            if (pos == std::string::npos || pos < last) ordered = false;
+            last = pos;
+        }
+    }
+    assertTrue(ordered, "Per-thread message order preserved");
+
+    std::remove("/tmp/eve_test_logs/async_test.log");
+    log.setConsoleOutput(true);
+}
+
+void testLoggerAsyncOverflowPolicies() {
+    std::cout << "\n=== Logger Async Overflow Policies ===" << std::endl;
+
+    auto& log = utils::Logger::instance();
+    log.setConsoleOutput(false);
+    log.shutdown();
+    std::remove("/tmp/eve_test_logs/overflow_test.log");
+    log.init("/tmp/eve_test_logs", "overflow_test.log");
+
+    utils::Logger::AsyncOptions opts;
+    opts.ring_capacity = 8;
+    opts.flush_interval_ms = 10000;   // writer only runs on flush()
+    opts.overflow = utils::LogOverflow::Drop;
+    log.startAsync(opts);
+
+    uint64_t dropped_before = log.getDroppedCount();
+    for (int i = 0; i < 100; ++i) log.info("drop_policy " + std::to_string(i));
+    assertTrue(log.getDroppedCount() - dropped_before == 92, "Drop policy discards overflow");
+    log.flush();
+    std::string content = readLogFile("/tmp/eve_test_logs/overflow_test.log");
+    assertTrue(countOccurrences(content, "drop_policy") == 8, "Ring contents written on flush");
+    assertTrue(content.find("92 messages dropped") != std::string::npos,
+               "Drop count reported in log");
+    log.stopAsync();
+
+    opts.overflow = utils::LogOverflow::Block;
+    log.startAsync(opts);
+    for (int i = 0; i < 100; ++i) log.info("block_policy " + std::to_string(i));
+    log.stopAsync();
+    log.shutdown();
+    content = readLogFile("/tmp/eve_test_logs/overflow_test.log");
+    assertTrue(countOccurrences(content, "block_policy") == 100, "Block policy loses nothing");
+
+    std::remove("/tmp/eve_test_logs/overflow_test.log");
+    log.setConsoleOutput(true);
+}
+
+void testLoggerJsonSink() {
+    std::cout << "\n=== Logger JSON Sink ===" << std::endl;
+
+    auto& log = utils::Logger::instance();
+    log.setConsoleOutput(false);
+    log.shutdown();
+    std::remove("/tmp/eve_test_logs/json_test.jsonl");
+    assertTrue(log.initJson("/tmp/eve_test_logs", "json_test.jsonl"), "JSON sink opens");
+    assertTrue(log.isJsonOpen(), "JSON sink reports open");
+
+    log.warn("ship \"Rifter\" lost\tshields");
+    log.shutdown();
+    assertTrue(!log.isJsonOpen(), "JSON sink closed on shutdown");
+
+    std::string content = readLogFile("/tmp/eve_test_logs/json_test.jsonl");
+    assertTrue(content.find("\"level\":\"WARN\"") != std::string::npos, "JSON line has level");
+    assertTrue(content.find("\"msg\":\"ship \\\"Rifter\\\" lost\\tshields\"") != std::string::npos,
+               "JSON message escaped");
+    assertTrue(content.find("\"ts\":\"") != std::string::npos, "JSON line has timestamp");
+    assertTrue(countOccurrences(content, "\n") == 1, "One object per line");
+
+    std::remove("/tmp/eve_test_logs/json_test.jsonl");
+    log.setConsoleOutput(true);
+}
+
+void testLoggerRotation() {
+    std::cout << "\n=== Logger Rotation ===" << std::endl;
+
+    auto& log = utils::Logger::instance();
+    log.setConsoleOutput(false);
+    log.shutdown();
+    const std::string base = "/tmp/eve_test_logs/rotate_test.log";
+    for (const char* suffix : {"", ".1", ".2", ".3"}) std::remove((base + suffix).c_str());
+
+    log.init("/tmp/eve_test_logs", "rotate_test.log");
+    log.setRotation(400, 2);
+    for (int i = 0; i < 60; ++i) log.info("rotation line " + std::to_string(i));
+    log.shutdown();
+    log.setRotation(0, 5);
+
+    assertTrue(std::ifstream(base + ".1").good(), "First rotated file exists");
+    assertTrue(std::ifstream(base + ".2").good(), "Second rotated file exists");
+    assertTrue(!std::ifstream(base + ".3").good(), "Files beyond the limit deleted");
+    std::string current = readLogFile(base);
+    assertTrue(current.size() <= 400, "Active file respects size limit");
+    assertTrue(current.find("rotation line 59") != std::string::npos, "Newest line in active file");
+
+    for (const char* suffix : {"", ".1", ".2", ".3"}) std::remove((base + suffix).c_str());
+    log.setConsoleOutput(true);
+}
+
+void testLoggerAsyncHotPathCost() {
+    std::cout << "\n=== Logger Async Hot Path Cost ===" << std::endl;
+
+    auto& log = utils::Logger::instance();
+    log.setConsoleOutput(false);
+    log.shutdown();
+
+    // Keep the writer asleep so the loops time only the caller; on a
+    // one-core runner its drains would otherwise be billed to them
+    utils::Logger::AsyncOptions opts;
+    opts.ring_capacity = 1 << 16;
+    opts.flush_interval_ms = 60000;
+    log.startAsync(opts);
+    log.info("warm");   // registers this thread's ring
+
+    const int count = 50000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) log.info("tick");
+    double ns = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count() / count;
+    log.stopAsync();
+
+    // The same message formatted by the caller, then by the writer
+    log.startAsync(opts);
+    log.info("warm");
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        log.info("tick " + std::to_string(i) + " at " + std::to_string(0.5));
+    }
+    double formatted_ns = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count() / count;
+    log.stopAsync();
+
+    log.startAsync(opts);
+    log.infof("warm {}", 0);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) log.infof("tick {} at {}", i, 0.5);
+    double deferred_ns = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count() / count;
+    log.stopAsync();
+
+    std::cout << "  async log call: " << ns << " ns, caller-formatted: " << formatted_ns
+              << " ns, deferred format: " << deferred_ns << " ns" << std::endl;
+    assertTrue(ns < 2000.0, "Async log call stays well under synchronous cost");
+    assertTrue(deferred_ns * 2.0 < formatted_ns, "Deferred formatting keeps the work off the caller");
+    log.setConsoleOutput(true);
+}
+
+void testLoggerDeferredFormat() {
+    std::cout << "\n=== Logger Deferred Format ===" << std::endl;
+
+    std::string dir = "/tmp/eve_test_logs_deferred";
+    std::remove((dir + "/deferred.log").c_str());
+
+    auto& log = utils::Logger::instance();
+    log.setConsoleOutput(false);
+    log.shutdown();
+    log.init(dir, "deferred.log");
+    log.setLevel(utils::LogLevel::DEBUG);
+
+    std::string pilot = "Aria";
+    log.infof("sync {} docked at {} with {} ISK", pilot, "Jita", 1500u);
+
+    log.startAsync();
+    log.infof("int {} neg {} float {} bool {} char {}", 42, -7LL, 2.5f, true, 'x');
+    log.warnf("missing {} {}", 1);
+    log.infof("extra", 9);
+    log.infof("long {}", std::string(500, 'z'));
+    log.stopAsync();
+    log.shutdown();
+
+    std::ifstream in(dir + "/deferred.log");
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    assertTrue(content.find("sync Aria docked at Jita with 1500 ISK") != std::string::npos,
+               "Synchronous logFormat renders immediately");
+    assertTrue(content.find("int 42 neg -7 float 2.5 bool true char x") != std::string::npos,
+               "Async logFormat renders every argument type");
+    assertTrue(content.find("[WARN] missing 1 {}") != std::string::npos,
+               "Unfilled placeholders are left as written");
+    assertTrue(content.find("extra 9") != std::string::npos,
+               "Surplus arguments are appended");
+    size_t pos = content.find("long z");
+    size_t end = content.find('\n', pos);
+    assertTrue(pos != std::string::npos &&
+               end - pos == 5 + utils::Logger::kInlineArgBytes - sizeof(uint16_t),
+               "Oversized strings are truncated to the inline budget");
+
+    log.setLevel(utils::LogLevel::INFO);
+    log.setConsoleOutput(true);
+}
+
+void testLoggerStopAsyncDrainsLatePushes() {
+    std::cout << "\n=== Logger stopAsync Drains Late Pushes ===" << std::endl;
+
+    std::string dir = "/tmp/eve_test_logs_stop";
+    std::remove((dir + "/stop.log").c_str());
+
+    auto& log = utils::Logger::instance();
+    log.setConsoleOutput(false);
+    log.shutdown();
+    log.init(dir, "stop.log");
+
+    // Producers keep logging straight through stopAsync(); none of their
+    // messages may be stranded in a ring
+    const int threads = 4, per_thread = 2000;
+    uint64_t dropped_before = log.getDroppedCount();
+    log.startAsync();
+    std::atomic<int> started{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            started.fetch_add(1);
+            for (int i = 0; i < per_thread; ++i) log.infof("late {} {}", t, i);
+        });
+    }
+    while (started.load() < threads) std::this_thread::yield();
+    log.stopAsync();
+    for (auto& w : workers) w.join();
+    log.shutdown();
+
+    std::ifstream in(dir + "/stop.log");
+    int lines = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.find("late ") != std::string::npos) ++lines;
+    }
+    assertTrue(lines == threads * per_thread, "Every message logged across stopAsync is written");
+    assertTrue(log.getDroppedCount() == dropped_before, "Default ring absorbs the burst without drops");
+    log.setConsoleOutput(true);
+}
+
 // ==================== ServerMetrics Tests ====================
 
 void testMetricsTickTiming() {
@@ -3605,6 +4105,220 @@ void testMarketOrderExpiry() {
     assertTrue(marketSys.getOrderCount("station_1") == 0, "Order expired and removed");
 }
 
+// ==================== MarketHistory Tests ====================
+
+void testMarketHistoryOHLCRollup() {
+    std::cout << "\n=== Market History OHLC Rollup ===" << std::endl;
+    data::MarketHistory history;
+    using Res = data::MarketHistory::Resolution;
+
+    history.recordTrade("station_1", "tritanium", 5.0, 100, 10.0);
+    history.recordTrade("station_1", "tritanium", 7.0, 50, 60.0);
+    history.recordTrade("station_1", "tritanium", 4.0, 10, 120.0);
+    history.recordTrade("station_1", "tritanium", 6.0, 40, 299.0);
+
+    auto buckets = history.latest("station_1", "tritanium", Res::FiveMinutes, 10);
+    assertTrue(buckets.size() == 1, "Trades within 5 minutes share one bucket");
+    assertTrue(approxEqual(static_cast<float>(buckets[0].open), 5.0f), "Open is first trade price");
+    assertTrue(approxEqual(static_cast<float>(buckets[0].high), 7.0f), "High is max trade price");
+    assertTrue(approxEqual(static_cast<float>(buckets[0].low), 4.0f), "Low is min trade price");
+    assertTrue(approxEqual(static_cast<float>(buckets[0].close), 6.0f), "Close is last trade price");
+    assertTrue(buckets[0].volume == 200, "Volume sums quantities");
+    assertTrue(buckets[0].trade_count == 4, "Trade count tracked");
+
+    history.recordTrade("station_1", "tritanium", 8.0, 10, 301.0);
+    assertTrue(history.latest("station_1", "tritanium", Res::FiveMinutes, 10).size() == 2,
+               "Trade after 5 minutes opens new bucket");
+    assertTrue(history.latest("station_1", "tritanium", Res::OneHour, 10).size() == 1,
+               "Hourly resolution still has one bucket");
+
+    double vwap = history.getAveragePrice("station_1", "tritanium", Res::OneHour, 1);
+    double expected = (5.0 * 100 + 7.0 * 50 + 4.0 * 10 + 6.0 * 40 + 8.0 * 10) / 210.0;
+    assertTrue(approxEqual(static_cast<float>(vwap), static_cast<float>(expected)),
+               "VWAP over hourly bucket");
+    assertTrue(history.getHubVolume("station_1", Res::OneDay, 1) == 210,
+               "Hub aggregate tracks total volume");
+    assertTrue(history.getAveragePrice("station_1", "unknown", Res::OneDay, 1) < 0.0,
+               "Unknown item has no average price");
+}
+
+void testMarketHistoryRangeQuery() {
+    std::cout << "\n=== Market History Range Query ===" << std::endl;
+    data::MarketHistory history;
+    using Res = data::MarketHistory::Resolution;
+
+    for (int i = 0; i < 10; ++i) {
+        history.recordTrade("station_1", "pyerite", 10.0 + i, 5, i * 3600.0 + 30.0);
+    }
+
+    auto range = history.query("station_1", "pyerite", Res::OneHour, 3600.0 * 3, 3600.0 * 6);
+    assertTrue(range.size() == 4, "Range query returns buckets 3..6 inclusive");
+    assertTrue(range.front().start_time == 3600 * 3, "Range starts at requested bucket");
+    assertTrue(range.back().start_time == 3600 * 6, "Range ends at requested bucket");
+
+    auto empty = history.query("station_1", "pyerite", Res::OneHour, 3600.0 * 20, 3600.0 * 30);
+    assertTrue(empty.empty(), "Range past newest bucket is empty");
+
+    double trend = history.getPriceTrend("station_1", "pyerite", Res::OneHour, 10);
+    assertTrue(approxEqual(static_cast<float>(trend), 0.9f), "Price trend is (19 - 10) / 10");
+}
+
+void testMarketHistoryFixedCapacity() {
+    std::cout << "\n=== Market History Fixed Capacity ===" << std::endl;
+    data::MarketHistory history;
+    using Res = data::MarketHistory::Resolution;
+
+    uint32_t cap = data::MarketHistory::bucketCapacity(Res::FiveMinutes);
+    for (uint32_t i = 0; i < cap + 50; ++i) {
+        history.recordTrade("station_1", "mexallon", 40.0, 1, i * 300.0);
+    }
+
+    auto all = history.latest("station_1", "mexallon", Res::FiveMinutes, 10000);
+    assertTrue(all.size() == cap, "Ring never exceeds its capacity");
+    assertTrue(all.front().start_time == 50 * 300, "Oldest buckets are overwritten first");
+    assertTrue(all.back().start_time == static_cast<int64_t>(cap + 49) * 300,
+               "Newest bucket retained");
+    assertTrue(history.getSeriesCount() == 2, "Item series plus hub aggregate");
+
+    // Late trade into a retained bucket is folded in; into an evicted one is dropped
+    history.recordTrade("station_1", "mexallon", 40.0, 5, 100.0 * 300.0);
+    history.recordTrade("station_1", "mexallon", 40.0, 5, 10.0 * 300.0);
+    auto late = history.query("station_1", "mexallon", Res::FiveMinutes, 100.0 * 300.0, 100.0 * 300.0);
+    assertTrue(late.size() == 1 && late[0].volume == 6, "Late trade folded into retained bucket");
+    assertTrue(history.latest("station_1", "mexallon", Res::FiveMinutes, 10000).size() == cap,
+               "Evicted late trade does not grow the ring");
+}
+
+void testMarketHistorySegmentRoundTrip() {
+    std::cout << "\n=== Market History Segment Round Trip ===" << std::endl;
+    data::MarketHistory history;
+    using Res = data::MarketHistory::Resolution;
+
+    history.recordTrade("station_1", "tritanium", 5.0, 100, 10.0);
+    history.recordTrade("station_1", "tritanium", 6.0, 100, 4000.0);
+    history.recordTrade("station_2", "nocxidium", 800.0, 3, 50.0);
+
+    std::string filepath = "/tmp/eve_test_market_history.seg";
+    assertTrue(history.saveSegment(filepath), "Segment saved");
+
+    data::MarketHistory loaded;
+    assertTrue(loaded.loadSegment(filepath), "Segment loaded");
+    assertTrue(loaded.getSeriesCount() == history.getSeriesCount(), "Series count preserved");
+    assertTrue(loaded.latest("station_1", "tritanium", Res::OneHour, 10).size() == 2,
+               "Hourly buckets preserved");
+    assertTrue(approxEqual(static_cast<float>(loaded.getAveragePrice("station_2", "nocxidium", Res::OneDay, 1)),
+                           800.0f), "VWAP preserved");
+    assertTrue(!loaded.loadSegment("/tmp/eve_test_market_history_missing.seg"),
+               "Missing segment fails to load");
+    assertTrue(approxEqual(static_cast<float>(loaded.getLatestTime()), 4200.0f),
+               "Latest time is the end of the newest bucket");
+
+    // A segment cut short must not replace what is loaded
+    std::string truncated = "/tmp/eve_test_market_history_truncated.seg";
+    {
+        std::ifstream in(filepath, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out(truncated, std::ios::binary);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 100));
+    }
+    assertTrue(!loaded.loadSegment(truncated), "Truncated segment rejected");
+    assertTrue(loaded.getSeriesCount() == history.getSeriesCount(), "Rejected load keeps contents");
+
+    std::remove(filepath.c_str());
+    std::remove(truncated.c_str());
+}
+
+void testMarketTradesRecordHistory() {
+    std::cout << "\n=== Market Trades Record History ===" << std::endl;
+    ecs::World world;
+    systems::MarketSystem marketSys(&world);
+
+    auto* station = world.createEntity("station_1");
+    auto* hub = addComp<components::MarketHub>(station);
+    hub->station_id = "station_1";
+
+    auto* buyer = world.createEntity("buyer_1");
+    auto* buyer_pc = addComp<components::Player>(buyer);
+    buyer_pc->isk = 10000000.0;
+
+    marketSys.seedNPCOrders("station_1");
+    assertTrue(approxEqual(static_cast<float>(marketSys.getLowestSellPrice("station_1", "mineral_tritanium")), 6.0f),
+               "Seed uses baseline price without history");
+
+    marketSys.update(100.0f);
+    int bought = marketSys.buyFromMarket("station_1", "buyer_1", "mineral_tritanium", 500);
+    assertTrue(bought == 500, "Bought from seeded order");
+
+    const auto& history = marketSys.getHistory();
+    using Res = data::MarketHistory::Resolution;
+    assertTrue(history.getVolume("station_1", "mineral_tritanium", Res::FiveMinutes, 1) == 500,
+               "Trade volume recorded in history");
+    assertTrue(history.latest("station_1", "mineral_tritanium", Res::FiveMinutes, 1)[0].start_time == 0,
+               "Trade timestamped with market sim clock");
+
+    // Seed a second hub that has trended well above baseline
+    auto* station2 = world.createEntity("station_2");
+    addComp<components::MarketHub>(station2)->station_id = "station_2";
+    marketSys.getHistory().recordTrade("station_2", "mineral_pyerite", 14.0, 1000, 200.0);
+    marketSys.getHistory().recordTrade("station_2", "mineral_mexallon", 500.0, 1000, 200.0);
+    marketSys.seedNPCOrders("station_2");
+    assertTrue(approxEqual(static_cast<float>(marketSys.getLowestSellPrice("station_2", "mineral_pyerite")), 14.0f),
+               "Seed follows recent daily average");
+    assertTrue(approxEqual(static_cast<float>(marketSys.getLowestSellPrice("station_2", "mineral_mexallon")), 80.0f),
+               "Seed price clamped to 2x baseline");
+}
+
+void testBackgroundSimMarketFeed() {
+    std::cout << "\n=== Background Sim Market Feed ===" << std::endl;
+    ecs::World world;
+    systems::BackgroundSimulationSystem bgSim(&world);
+    data::MarketHistory history;
+    double trade_clock = 40.0;
+    bgSim.setMarketHistory(&history, [&trade_clock]() { return trade_clock; });
+    bgSim.market_reference_volume = 1000.0f;
+
+    auto* sys = world.createEntity("system_a");
+    auto* state = addComp<components::SimStarSystemState>(sys);
+    state->trade_volume = 0.0f;
+
+    auto* station = world.createEntity("station_a");
+    auto* hub = addComp<components::MarketHub>(station);
+    hub->station_id = "station_a";
+    hub->system_id = "system_a";
+
+    history.recordTrade("station_a", "tritanium", 5.0, 300, 10.0);
+    history.recordTrade("station_a", "pyerite", 10.0, 200, 20.0);
+    bgSim.update(1.0f);
+    assertTrue(approxEqual(state->trade_volume, 0.5f), "Trade volume derived from hourly hub volume");
+
+    history.recordTrade("station_a", "tritanium", 5.0, 5000, 30.0);
+    bgSim.update(1.0f);
+    assertTrue(approxEqual(state->trade_volume, 1.0f), "Trade volume saturates at 1.0");
+
+    // Two quiet hours later the last bucket is stale
+    trade_clock = 40.0 + 7200.0;
+    bgSim.update(1.0f);
+    assertTrue(approxEqual(state->trade_volume, 0.0f), "Trades older than the hour no longer count");
+    assertTrue(history.getHubVolume("station_a", data::MarketHistory::Resolution::OneHour, 1) == 5500,
+               "Bucket-count query still returns the newest bucket");
+}
+
+void testProtocolMarketHistoryMessages() {
+    std::cout << "\n=== Protocol Market History Messages ===" << std::endl;
+    atlas::network::ProtocolHandler proto;
+
+    std::string msg = "{\"type\":\"market_history\",\"station_id\":\"s1\",\"item_id\":\"tritanium\",\"resolution\":\"1h\"}";
+    atlas::network::MessageType type;
+    std::string data;
+    assertTrue(proto.parseMessage(msg, type, data), "Market history request parses");
+    assertTrue(type == atlas::network::MessageType::MARKET_HISTORY, "Parsed type is MARKET_HISTORY");
+
+    std::string reply = proto.createMarketHistory("s1", "tritanium", "1h", 0, "[]");
+    assertTrue(reply.find("\"market_history\"") != std::string::npos, "Reply has message type");
+    assertTrue(reply.find("\"resolution\":\"1h\"") != std::string::npos, "Reply has resolution");
+    assertTrue(reply.find("\"buckets\":[]") != std::string::npos, "Reply has buckets array");
+}
+
 // ==================== Corporation System Tests ====================
 
 void testCorpCreate() {
@@ -10897,6 +11611,26 @@ void testPersistencePlayerPresence() {
     assertTrue(approxEqual(pp2->time_since_last_speech, 120.0f), "time_since_last_speech preserved");
 }
 
+void testPersistenceSystemLocation() {
+    std::cout << "\n=== Persistence: SystemLocation Round-Trip ===" << std::endl;
+    ecs::World coordinator;
+    ecs::World partition;
+    coordinator.createEntity("thyrkstad");
+    auto* ship = partition.createEntity("player_loc1");
+    addComp<components::SystemLocation>(ship)->system_id = "thyrkstad";
+
+    data::WorldPersistence persistence;
+    std::string json = persistence.serializeWorlds({&coordinator, &partition});
+
+    ecs::World world2;
+    assertTrue(persistence.deserializeWorld(&world2, json), "Deserialized merged worlds");
+    assertTrue(world2.getEntity("thyrkstad") != nullptr, "Coordinator entity saved");
+    auto* ship2 = world2.getEntity("player_loc1");
+    assertTrue(ship2 != nullptr, "Partition entity saved");
+    auto* loc = ship2 ? ship2->getComponent<components::SystemLocation>() : nullptr;
+    assertTrue(loc != nullptr && loc->system_id == "thyrkstad", "system_id preserved");
+}
+
 void testPersistenceFactionCulture() {
     std::cout << "\n=== Persistence: FactionCulture Round-Trip ===" << std::endl;
     ecs::World world;
@@ -13453,13 +14187,2216 @@ void testOverlayFleetExtensionsMissing() {
     assertTrue(toSys.getWingBandOffsets("nobody").empty(), "Missing entity no offsets");
 }
 
+// ==================== Solar System Partition Tests ====================
+
+// Counts updates and the thread each update ran on
+class TickCounterSystem : public ecs::System {
+public:
+    explicit TickCounterSystem(ecs::World* world) : System(world) {}
+    void update(float delta_time) override {
+        ++ticks;
+        total_time += delta_time;
+        last_thread = std::this_thread::get_id();
+    }
+    std::string getName() const override { return "TickCounterSystem"; }
+    int ticks = 0;
+    float total_time = 0.0f;
+    std::thread::id last_thread;
+};
+
+void testWorldReleaseAdoptEntity() {
+    std::cout << "\n=== World Release/Adopt Entity ===" << std::endl;
+    ecs::World a;
+    ecs::World b;
+    auto* e = a.createEntity("ship_1");
+    addComp<components::Position>(e)->x = 12.0f;
+
+    auto owned = a.releaseEntity("ship_1");
+    assertTrue(owned != nullptr, "Entity released from source world");
+    assertTrue(a.getEntity("ship_1") == nullptr, "Source world no longer has entity");
+    assertTrue(a.releaseEntity("ship_1") == nullptr, "Second release returns null");
+
+    b.adoptEntity(std::move(owned));
+    auto* moved = b.getEntity("ship_1");
+    assertTrue(moved != nullptr, "Destination world adopted entity");
+    assertTrue(approxEqual(moved->getComponent<components::Position>()->x, 12.0f),
+               "Components travel with entity");
+}
+
+void testPartitionParallelTick() {
+    std::cout << "\n=== Partition Parallel Tick ===" << std::endl;
+    ecs::World coordinator;
+    auto coord_counter = std::make_unique<TickCounterSystem>(&coordinator);
+    auto* coord_ptr = coord_counter.get();
+    coordinator.addSystem(std::move(coord_counter));
+
+    sim::PartitionManager manager(&coordinator, 3);
+    assertTrue(manager.getWorkerCount() == 3, "Three worker threads started");
+
+    std::vector<TickCounterSystem*> counters;
+    for (int i = 0; i < 8; ++i) {
+        manager.createPartition("system_" + std::to_string(i),
+            [&counters](sim::StarSystemPartition& p) {
+                auto sys = std::make_unique<TickCounterSystem>(&p.getWorld());
+                counters.push_back(sys.get());
+                p.getWorld().addSystem(std::move(sys));
+            });
+    }
+    assertTrue(manager.getPartitionCount() == 8, "Eight partitions created");
+    assertTrue(manager.createPartition("system_0") == manager.getPartition("system_0"),
+               "Creating an existing partition returns it");
+
+    for (int t = 0; t < 10; ++t) manager.tick(0.1f);
+
+    bool all_ten = true;
+    for (auto* c : counters) all_ten = all_ten && c->ticks == 10;
+    assertTrue(all_ten, "Every partition ticked once per tick");
+    assertTrue(coord_ptr->ticks == 10, "Coordinator ticked once per tick");
+    assertTrue(approxEqual(counters[0]->total_time, 1.0f), "Partitions receive tick delta");
+    assertTrue(manager.getPartition("system_3")->getTickCount() == 10,
+               "Partition tracks its tick count");
+}
+
+void testPartitionInlineMode() {
+    std::cout << "\n=== Partition Inline Mode ===" << std::endl;
+    ecs::World coordinator;
+    sim::PartitionManager manager(&coordinator, 0);
+    TickCounterSystem* counter = nullptr;
+    manager.createPartition("system_a", [&counter](sim::StarSystemPartition& p) {
+        auto sys = std::make_unique<TickCounterSystem>(&p.getWorld());
+        counter = sys.get();
+        p.getWorld().addSystem(std::move(sys));
+    });
+    manager.tick(0.5f);
+    assertTrue(manager.getWorkerCount() == 0, "No workers in inline mode");
+    assertTrue(counter->ticks == 1, "Partition ticked inline");
+    assertTrue(counter->last_thread == std::this_thread::get_id(), "Inline tick runs on caller");
+}
+
+void testPartitionHandoff() {
+    std::cout << "\n=== Partition Handoff ===" << std::endl;
+    ecs::World coordinator;
+    sim::PartitionManager manager(&coordinator, 2);
+    manager.createPartition("system_a");
+    manager.createPartition("system_b");
+
+    auto* ship = coordinator.createEntity("ship_1");
+    addComp<components::Position>(ship);
+    assertTrue(manager.assignEntity("ship_1", "system_a"), "Ship assigned to system_a");
+    assertTrue(coordinator.getEntity("ship_1") == nullptr, "Ship left coordinator");
+    assertTrue(manager.locateEntity("ship_1") == "system_a", "Ship located in system_a");
+    assertTrue(manager.findEntity("ship_1") != nullptr, "Ship found through manager");
+    assertTrue(!manager.assignEntity("ghost", "system_a"), "Unknown entity cannot be assigned");
+
+    manager.getPartition("system_a")->requestHandoff("ship_1", "system_b", sim::HandoffKind::Jump);
+    manager.tick(0.1f);
+    assertTrue(manager.locateEntity("ship_1") == "system_b", "Ship owned by system_b after routing");
+    assertTrue(manager.getPartition("system_b")->getPendingInbound() == 1, "Ship waits in inbox");
+    assertTrue(manager.getPartition("system_a")->getWorld().getEntity("ship_1") == nullptr,
+               "Ship released from system_a");
+
+    manager.tick(0.1f);
+    assertTrue(manager.getPartition("system_b")->getWorld().getEntity("ship_1") != nullptr,
+               "Ship adopted by system_b on its next tick");
+    assertTrue(manager.getHandoffCount() == 1, "One handoff routed");
+
+    manager.requestHandoff("ship_1", "system_missing", sim::HandoffKind::Gate);
+    manager.tick(0.1f);
+    assertTrue(manager.getRejectedHandoffCount() == 1, "Handoff to unknown system rejected");
+    assertTrue(manager.findEntity("ship_1") != nullptr, "Rejected handoff leaves ship in place");
+}
+
+void testPartitionWormholeHandoff() {
+    std::cout << "\n=== Partition Wormhole Handoff ===" << std::endl;
+    ecs::World coordinator;
+    sim::PartitionManager manager(&coordinator, 1);
+
+    systems::WormholeSystem* whSys = nullptr;
+    auto* part_a = manager.createPartition("system_a", [&whSys](sim::StarSystemPartition& p) {
+        auto sys = std::make_unique<systems::WormholeSystem>(&p.getWorld());
+        whSys = sys.get();
+        sim::StarSystemPartition* self = &p;
+        sys->setHandoffCallback([self](const std::string& ship, const std::string& dest) {
+            self->requestHandoff(ship, dest, sim::HandoffKind::Wormhole);
+        });
+        p.getWorld().addSystem(std::move(sys));
+    });
+    manager.createPartition("system_b");
+
+    auto* wh_entity = part_a->getWorld().createEntity("wh_ab");
+    auto* wh = addComp<components::WormholeConnection>(wh_entity);
+    wh->source_system = "system_a";
+    wh->destination_system = "system_b";
+    wh->max_mass = 500000000.0;
+    wh->remaining_mass = 500000000.0;
+    wh->max_jump_mass = 20000000.0;
+    wh->max_lifetime_hours = 24.0f;
+
+    coordinator.createEntity("ship_1");
+    manager.assignEntity("ship_1", "system_a");
+
+    assertTrue(!whSys->jumpShipThroughWormhole("wh_ab", "ship_1", 50000000.0),
+               "Too-heavy ship cannot jump");
+    assertTrue(whSys->jumpShipThroughWormhole("wh_ab", "ship_1", 1000000.0), "Ship jumps");
+    manager.tick(0.1f);
+    manager.tick(0.1f);
+    assertTrue(manager.locateEntity("ship_1") == "system_b", "Wormhole jump hands ship to destination");
+    assertTrue(manager.getPartition("system_b")->getWorld().getEntity("ship_1") != nullptr,
+               "Ship simulated in destination partition");
+}
+
+void testPartitionDestroyEntity() {
+    std::cout << "\n=== Partition Destroy Entity ===" << std::endl;
+    ecs::World coordinator;
+    sim::PartitionManager manager(&coordinator, 0);
+    manager.createPartition("system_a");
+    manager.createPartition("system_b");
+
+    coordinator.createEntity("loose");
+    coordinator.createEntity("ship_1");
+    coordinator.createEntity("ship_2");
+    manager.assignEntity("ship_1", "system_a");
+    manager.assignEntity("ship_2", "system_a");
+
+    assertTrue(manager.destroyEntity("loose"), "Coordinator entity destroyed");
+    assertTrue(coordinator.getEntity("loose") == nullptr, "Gone from coordinator");
+    assertTrue(manager.destroyEntity("ship_1"), "Partition entity destroyed");
+    assertTrue(manager.getPartition("system_a")->getWorld().getEntity("ship_1") == nullptr,
+               "Gone from its partition");
+    assertTrue(manager.locateEntity("ship_1").empty(), "Location forgotten");
+
+    manager.requestHandoff("ship_2", "system_b", sim::HandoffKind::Gate);
+    manager.tick(0.1f);
+    assertTrue(manager.getPartition("system_b")->getPendingInbound() == 1, "Ship in flight");
+    assertTrue(manager.destroyEntity("ship_2"), "In-flight entity destroyed");
+    assertTrue(manager.getPartition("system_b")->getPendingInbound() == 0, "Removed from inbox");
+    manager.tick(0.1f);
+    assertTrue(manager.findEntity("ship_2") == nullptr, "Never adopted");
+    assertTrue(!manager.destroyEntity("ship_2"), "Second destroy reports nothing to do");
+}
+
+// ==================== Time Dilation Tests ====================
+
+void testTimeDilationDisabledByDefault() {
+    std::cout << "\n=== Time Dilation Disabled By Default ===" << std::endl;
+    sim::TimeDilation tidi;
+    tidi.update(500.0, 0.033f);
+    assertTrue(approxEqual(tidi.getFactor(), 1.0f), "Disabled controller stays at 1.0");
+    assertTrue(approxEqual(tidi.apply(0.5f), 0.5f), "Disabled controller passes delta through");
+}
+
+void testTimeDilationOverload() {
+    std::cout << "\n=== Time Dilation Overload ===" << std::endl;
+    sim::TimeDilation::Config cfg;
+    cfg.enabled = true;
+    cfg.budget_ms = 10.0;
+    cfg.floor = 0.1f;
+    sim::TimeDilation tidi(cfg);
+
+    tidi.update(5.0, 0.033f);
+    assertTrue(approxEqual(tidi.getFactor(), 1.0f), "Under budget keeps real time");
+    tidi.update(5.0 + 5.0 / 0.2, 0.033f);   // EMA -> 10ms exactly
+    assertTrue(approxEqual(tidi.getFactor(), 1.0f), "At budget keeps real time");
+
+    sim::TimeDilation hit(cfg);
+    hit.update(20.0, 0.033f);
+    assertTrue(approxEqual(hit.getFactor(), 0.5f), "Double cost halves time rate");
+    assertTrue(approxEqual(hit.apply(0.1f), 0.05f), "Delta scaled by factor");
+
+    for (int i = 0; i < 50; ++i) hit.update(1000.0, 0.033f);
+    assertTrue(approxEqual(hit.getFactor(), 0.1f), "Factor clamped at floor");
+    assertTrue(hit.isDilated(), "Controller reports dilation");
+}
+
+void testTimeDilationRecovery() {
+    std::cout << "\n=== Time Dilation Recovery ===" << std::endl;
+    sim::TimeDilation::Config cfg;
+    cfg.enabled = true;
+    cfg.budget_ms = 10.0;
+    cfg.recovery_per_second = 0.5f;
+    sim::TimeDilation tidi(cfg);
+    tidi.update(100.0, 0.1f);
+    assertTrue(approxEqual(tidi.getFactor(), 0.1f), "Heavy load reaches floor");
+
+    bool bounded = true;
+    float prev = tidi.getFactor();
+    for (int i = 0; i < 100; ++i) {
+        float f = tidi.update(1.0, 0.1f);
+        if (f < prev - 0.0001f || f - prev > 0.05f + 0.0001f) bounded = false;
+        prev = f;
+    }
+    assertTrue(bounded, "Recovery is monotonic and rate-limited");
+    assertTrue(approxEqual(tidi.getFactor(), 1.0f), "Factor returns to real time");
+    assertTrue(!tidi.isDilated(), "No longer dilated after recovery");
+}
+
+void testTimeDilationThrottlesSteps() {
+    std::cout << "\n=== Time Dilation Throttles Steps ===" << std::endl;
+    sim::TimeDilation idle;
+    int idle_steps = 0;
+    for (int i = 0; i < 10; ++i) idle_steps += idle.beginTick(0.1f) ? 1 : 0;
+    assertTrue(idle_steps == 10, "Undilated clock steps every tick");
+
+    sim::TimeDilation::Config cfg;
+    cfg.enabled = true;
+    cfg.budget_ms = 10.0;
+    cfg.recovery_per_second = 0.0f;
+    sim::TimeDilation tidi(cfg);
+    tidi.update(40.0, 0.1f);
+    assertTrue(approxEqual(tidi.getFactor(), 0.25f), "Quadruple cost dilates to 0.25");
+
+    int steps = 0;
+    for (int i = 0; i < 40; ++i) {
+        if (tidi.beginTick(0.1f)) {
+            ++steps;
+            assertTrue(approxEqual(tidi.getStepWallSeconds(), 0.4f), "Step covers four wall ticks");
+        }
+    }
+    assertTrue(steps == 10, "Only a quarter of the ticks step the simulation");
+}
+
+class LoadSystem : public ecs::System {
+public:
+    explicit LoadSystem(ecs::World* world) : System(world) {}
+    void update(float /*delta_time*/) override {
+        if (sleep_ms > 0) std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+    }
+    std::string getName() const override { return "LoadSystem"; }
+    int sleep_ms = 0;
+};
+
+void testPartitionTimeDilation() {
+    std::cout << "\n=== Partition Time Dilation ===" << std::endl;
+    ecs::World coordinator;
+    sim::PartitionManager manager(&coordinator, 0);
+
+    sim::TimeDilation::Config cfg;
+    cfg.enabled = true;
+    cfg.budget_ms = 1.0;
+    cfg.recovery_per_second = 0.5f;
+    manager.setTimeDilationConfig(cfg);
+
+    LoadSystem* load = nullptr;
+    TickCounterSystem* busy = nullptr;
+    TickCounterSystem* quiet = nullptr;
+    auto* hot = manager.createPartition("system_hot", [&](sim::StarSystemPartition& p) {
+        auto l = std::make_unique<LoadSystem>(&p.getWorld());
+        load = l.get();
+        p.getWorld().addSystem(std::move(l));
+        auto c = std::make_unique<TickCounterSystem>(&p.getWorld());
+        busy = c.get();
+        p.getWorld().addSystem(std::move(c));
+    });
+    auto* calm = manager.createPartition("system_calm", [&](sim::StarSystemPartition& p) {
+        auto c = std::make_unique<TickCounterSystem>(&p.getWorld());
+        quiet = c.get();
+        p.getWorld().addSystem(std::move(c));
+    });
+
+    load->sleep_ms = 3;
+    manager.tick(0.1f);
+    assertTrue(approxEqual(busy->total_time, 0.1f), "First tick runs at real time");
+    assertTrue(hot->getDilationFactor() < 0.5f, "Overloaded partition dilates");
+    assertTrue(approxEqual(calm->getDilationFactor(), 1.0f), "Idle partition unaffected");
+
+    manager.tick(0.1f);
+    assertTrue(busy->total_time < 0.15f, "Dilated partition advances less simulated time");
+    assertTrue(approxEqual(quiet->total_time, 0.2f), "Idle partition keeps full delta");
+    assertTrue(hot->getSimulatedSeconds() < calm->getSimulatedSeconds(),
+               "Simulated clock lags in dilated system");
+    assertTrue(busy->ticks < quiet->ticks, "Dilated partition skips world steps");
+
+    // A 1 ms budget can be blown by preemption alone on a busy runner;
+    // recovery only needs every idle tick to come in under budget
+    load->sleep_ms = 0;
+    cfg.budget_ms = 50.0;
+    manager.setTimeDilationConfig(cfg);
+    for (int i = 0; i < 40; ++i) manager.tick(0.1f);
+    assertTrue(approxEqual(hot->getDilationFactor(), 1.0f), "Partition recovers when load drops");
+}
+
+void testPartitionDilationSpreadsStep() {
+    std::cout << "\n=== Partition Dilation Spreads Step ===" << std::endl;
+    ecs::World coordinator;
+    sim::PartitionManager manager(&coordinator, 1);
+
+    sim::TimeDilation::Config cfg;
+    cfg.enabled = true;
+    cfg.budget_ms = 10.0;
+    cfg.recovery_per_second = 0.0f;
+    manager.setTimeDilationConfig(cfg);
+
+    // Eight 5 ms systems: a 40 ms step dilates to 0.25
+    auto* hot = manager.createPartition("system_hot", [](sim::StarSystemPartition& p) {
+        for (int i = 0; i < 8; ++i) {
+            auto l = std::make_unique<LoadSystem>(&p.getWorld());
+            l->sleep_ms = 5;
+            p.getWorld().addSystem(std::move(l));
+        }
+    });
+    TickCounterSystem* light = nullptr;
+    manager.createPartition("system_light", [&](sim::StarSystemPartition& p) {
+        auto c = std::make_unique<TickCounterSystem>(&p.getWorld());
+        light = c.get();
+        p.getWorld().addSystem(std::move(c));
+    });
+
+    for (int i = 0; i < 4; ++i) manager.tick(0.1f);
+    assertTrue(hot->getDilationFactor() < 0.3f, "Heavy partition dilates");
+
+    uint64_t hot_steps = hot->getTickCount();
+    int light_ticks = light->ticks;
+    int slow_ticks = 0;
+    for (int i = 0; i < 24; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        manager.tick(0.1f);
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        if (ms > 25.0) ++slow_ticks;
+    }
+    // Stepping whole would make every fourth tick (six here) take the full
+    // 40 ms; allow a stray preempted tick or two
+    assertTrue(slow_ticks <= 2, "No tick waits for the heavy partition's whole step");
+    assertTrue(light->ticks - light_ticks == 24, "Light partition steps on every tick");
+    assertTrue(hot->getTickCount() - hot_steps >= 4, "Heavy partition still completes its steps");
+}
+
+void testMetricsDilationHistory() {
+    std::cout << "\n=== Metrics Dilation History ===" << std::endl;
+    utils::ServerMetrics metrics;
+    metrics.recordDilation("sys_a", 1.0f);
+    assertTrue(metrics.getDilationHistory("sys_a").empty(), "Undilated system has no history");
+
+    metrics.recordDilation("sys_a", 0.4f);
+    metrics.recordDilation("sys_a", 0.405f);   // below change threshold
+    metrics.recordDilation("sys_a", 0.2f);
+    metrics.recordDilation("sys_b", 0.9f);
+    metrics.recordDilation("sys_a", 1.0f);
+
+    auto history = metrics.getDilationHistory("sys_a");
+    assertTrue(history.size() == 3, "Only significant changes recorded");
+    assertTrue(history.size() == 3 && approxEqual(history[1].factor, 0.2f) &&
+               approxEqual(history[2].factor, 1.0f), "History keeps dilation and recovery");
+    assertTrue(approxEqual(metrics.getMinDilation(), 0.2f), "Window minimum tracked");
+    assertTrue(metrics.getMostDilatedSystem() == "sys_a", "Most dilated system tracked");
+    assertTrue(metrics.summary().find("tidi min=0.20 (sys_a)") != std::string::npos,
+               "Summary reports dilation");
+
+    metrics.resetWindow();
+    assertTrue(approxEqual(metrics.getMinDilation(), 1.0f), "Window reset clears minimum");
+    assertTrue(metrics.getDilationHistory("sys_a").size() == 3, "History survives window reset");
+
+    network::ProtocolHandler proto;
+    std::string msg = proto.createTimeDilation("sys_a", 0.5f);
+    network::MessageType type;
+    std::string data;
+    assertTrue(proto.parseMessage(msg, type, data) && type == network::MessageType::TIME_DILATION,
+               "time_dilation message round-trips");
+    assertTrue(data.find("\"factor\":0.5") != std::string::npos, "Factor carried in message");
+}
+
+// ==================== Cluster Tests ====================
+
+// Poll until pred() holds or the timeout expires (cluster I/O is threaded)
+template <typename Pred>
+static bool waitFor(Pred pred, int timeout_ms = 2000) {
+    for (int waited = 0; waited < timeout_ms; waited += 5) {
+        if (pred()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return pred();
+}
+
+void testClusterTopologyParse() {
+    std::cout << "\n=== Cluster Topology Parse ===" << std::endl;
+    cluster::ClusterTopology topo;
+    bool ok = topo.parse("alpha|127.0.0.1:8801|127.0.0.1:9801|sys_a, sys_b;"
+                         "beta|127.0.0.1:8802|unix:/tmp/beta.sock|sys_c");
+    assertTrue(ok, "Valid topology parses");
+    assertTrue(topo.getNodes().size() == 2, "Two nodes parsed");
+    assertTrue(topo.ownerOf("sys_b") == "alpha", "sys_b owned by alpha");
+    assertTrue(topo.ownerOf("sys_c") == "beta", "sys_c owned by beta");
+    assertTrue(topo.ownerOf("sys_x").empty(), "Unknown system has no owner");
+    const auto* beta = topo.getNode("beta");
+    assertTrue(beta && beta->client_port == 8802, "Client port parsed");
+    assertTrue(beta && beta->node_endpoint == "unix:/tmp/beta.sock", "Unix node endpoint kept");
+
+    cluster::ClusterTopology copy;
+    assertTrue(copy.parse(topo.toString()) && copy.ownerOf("sys_a") == "alpha",
+               "Topology round-trips through toString");
+
+    cluster::ClusterTopology bad;
+    assertTrue(!bad.parse("a|127.0.0.1:1|127.0.0.1:2|sys;b|127.0.0.1:3|127.0.0.1:4|sys"),
+               "System owned by two nodes is rejected");
+    assertTrue(!bad.parse("a|no_port|127.0.0.1:2|sys"), "Missing client port is rejected");
+    assertTrue(bad.empty(), "Failed parse leaves topology empty");
+}
+
+void testNodeLinkUnixSocket() {
+    std::cout << "\n=== Node Link Unix Socket ===" << std::endl;
+    const std::string endpoint = "unix:/tmp/eve_test_node_link.sock";
+    std::mutex mtx;
+    std::vector<std::string> received;
+    std::shared_ptr<cluster::NodeLink> server_side;
+
+    cluster::NodeListener listener;
+    bool listening = listener.listen(endpoint, [&](std::shared_ptr<cluster::NodeLink> link) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            server_side = link;
+        }
+        link->start([&](const std::shared_ptr<cluster::NodeLink>&, const std::string& line) {
+            std::lock_guard<std::mutex> lock(mtx);
+            received.push_back(line);
+        });
+    });
+    assertTrue(listening, "Listener binds unix socket");
+
+    auto client = cluster::NodeLink::connect(endpoint);
+    assertTrue(client != nullptr, "Client connects over unix socket");
+    if (!client) return;
+    client->start(nullptr);
+    client->sendRaw("{\"n\":1}\n{\"n\":");   // second line split across writes
+    client->sendLine("2}");
+
+    bool got = waitFor([&] {
+        std::lock_guard<std::mutex> lock(mtx);
+        return received.size() == 2;
+    });
+    assertTrue(got, "Both framed lines delivered");
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        assertTrue(got && received[1] == "{\"n\":2}", "Split line reassembled");
+    }
+
+    client->close();
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (server_side) server_side->close();
+    }
+    waitFor([&] { return !client->isReading(); });
+    listener.stop();
+    std::ifstream gone("/tmp/eve_test_node_link.sock");
+    assertTrue(!gone.good(), "Socket file removed on stop");
+}
+
+void testClusterNodeMigration() {
+    std::cout << "\n=== Cluster Node Migration ===" << std::endl;
+    cluster::ClusterTopology topo;
+    topo.parse("alpha|127.0.0.1:1|127.0.0.1:0|sys_a;beta|127.0.0.1:2|127.0.0.1:0|sys_b");
+
+    ecs::World world_a;
+    ecs::World world_b;
+    cluster::ClusterNode node_a("alpha", topo, &world_a);
+    cluster::ClusterNode node_b("beta", topo, &world_b);
+    assertTrue(node_a.start("127.0.0.1:0") && node_b.start("127.0.0.1:0"),
+               "Both nodes listen on localhost");
+    node_a.setPeerEndpoint("beta", "127.0.0.1:" + std::to_string(node_b.getListenPort()));
+
+    std::string migrated_id;
+    bool migrated_ok = false;
+    node_a.setMigrationCallback([&](const std::string& id, const std::string&, bool ok) {
+        migrated_id = id;
+        migrated_ok = ok;
+    });
+    std::string arrived_from;
+    node_b.setArrivalCallback([&](const std::string&, const std::string& from) {
+        arrived_from = from;
+    });
+
+    auto* ship = world_a.createEntity("player_1");
+    auto* pos = addComp<components::Position>(ship);
+    pos->x = 1250.0f;
+    pos->z = -40.0f;
+    auto* hp = addComp<components::Health>(ship);
+    hp->shield_hp = 321.0f;
+
+    assertTrue(!node_a.migrateEntity("player_1", "sys_a"), "Local system needs no migration");
+    assertTrue(!node_a.migrateEntity("player_1", "sys_unknown"), "Unowned system is rejected");
+    assertTrue(node_a.migrateEntity("player_1", "sys_b", "resume-42"), "Migration to beta starts");
+    assertTrue(world_a.getEntity("player_1") == nullptr, "Entity leaves source world at once");
+    assertTrue(node_a.getInFlightCount() == 1, "Entity held in flight");
+
+    bool done = waitFor([&] {
+        node_b.update();
+        node_a.update();
+        return node_a.getInFlightCount() == 0;
+    });
+    assertTrue(done, "Migration acknowledged");
+    auto* arrived = world_b.getEntity("player_1");
+    assertTrue(arrived != nullptr, "Entity adopted by destination node");
+    if (arrived) {
+        auto* apos = arrived->getComponent<components::Position>();
+        auto* ahp = arrived->getComponent<components::Health>();
+        assertTrue(apos && approxEqual(apos->x, 1250.0f) && approxEqual(apos->z, -40.0f),
+                   "Position survives migration");
+        assertTrue(ahp && approxEqual(ahp->shield_hp, 321.0f), "Health survives migration");
+    }
+    assertTrue(migrated_ok && migrated_id == "player_1", "Source notified of success");
+    assertTrue(arrived_from == "alpha", "Destination notified of arrival");
+    assertTrue(node_a.getMigratedOutCount() == 1 && node_b.getMigratedInCount() == 1,
+               "Migration counters updated");
+
+    world_b.createEntity("native_ship");
+    assertTrue(!node_b.claimResume("native_ship", ""), "Entity not adopted by handoff cannot be resumed");
+    assertTrue(!node_b.claimResume("player_1", "guess"), "Wrong resume token rejected");
+    assertTrue(node_b.claimResume("player_1", "resume-42"), "Handoff token resumes the session");
+    assertTrue(!node_b.claimResume("player_1", "resume-42"), "Resume token is single use");
+
+    node_a.stop();
+    node_b.stop();
+}
+
+void testClusterNodeMigrationRejected() {
+    std::cout << "\n=== Cluster Node Migration Rejected ===" << std::endl;
+    cluster::ClusterTopology topo;
+    topo.parse("alpha|127.0.0.1:1|127.0.0.1:0|sys_a;beta|127.0.0.1:2|127.0.0.1:0|sys_b");
+
+    ecs::World world_a;
+    ecs::World world_b;
+    cluster::ClusterNode node_a("alpha", topo, &world_a);
+    cluster::ClusterNode node_b("beta", topo, &world_b);
+    node_a.start("127.0.0.1:0");
+    node_b.start("127.0.0.1:0");
+    node_a.setPeerEndpoint("beta", "127.0.0.1:" + std::to_string(node_b.getListenPort()));
+
+    bool callback_ok = true;
+    node_a.setMigrationCallback([&](const std::string&, const std::string&, bool ok) {
+        callback_ok = ok;
+    });
+
+    addComp<components::Position>(world_a.createEntity("dup_ship"))->x = 5.0f;
+    addComp<components::Position>(world_b.createEntity("dup_ship"))->x = 99.0f;
+
+    assertTrue(node_a.migrateEntity("dup_ship", "sys_b"), "Migration sent");
+    bool done = waitFor([&] {
+        node_b.update();
+        node_a.update();
+        return node_a.getInFlightCount() == 0;
+    });
+    assertTrue(done, "Rejection acknowledged");
+    auto* restored = world_a.getEntity("dup_ship");
+    assertTrue(restored != nullptr, "Entity restored to source world");
+    assertTrue(restored && approxEqual(restored->getComponent<components::Position>()->x, 5.0f),
+               "Restored entity unchanged");
+    assertTrue(approxEqual(world_b.getEntity("dup_ship")->getComponent<components::Position>()->x, 99.0f),
+               "Destination entity not overwritten");
+    assertTrue(!callback_ok && node_a.getFailedMigrationCount() == 1, "Failure reported");
+
+    // Unreachable peer: entity never leaves
+    node_a.setPeerEndpoint("beta", "unix:/tmp/eve_test_no_such_node.sock");
+    node_b.stop();
+    waitFor([&] { node_a.update(); return false; }, 50);
+    assertTrue(!node_a.migrateEntity("dup_ship", "sys_b"), "Unreachable node refuses migration");
+    assertTrue(world_a.getEntity("dup_ship") != nullptr, "Entity stays when peer unreachable");
+    node_a.stop();
+}
+
+void testClusterProxyRedirect() {
+    std::cout << "\n=== Cluster Proxy Redirect ===" << std::endl;
+
+    // Two stand-in game nodes that record what the proxy sends them
+    struct FakeNode {
+        cluster::NodeListener listener;
+        std::mutex mtx;
+        std::string received;
+        std::shared_ptr<cluster::NodeLink> conn;
+    };
+    FakeNode alpha, beta;
+    for (FakeNode* node : {&alpha, &beta}) {
+        node->listener.listen("127.0.0.1:0", [node](std::shared_ptr<cluster::NodeLink> link) {
+            {
+                std::lock_guard<std::mutex> lock(node->mtx);
+                node->conn = link;
+            }
+            link->start([node](const std::shared_ptr<cluster::NodeLink>&, const std::string& data) {
+                std::lock_guard<std::mutex> lock(node->mtx);
+                node->received += data;
+            }, nullptr, true);
+        });
+    }
+
+    cluster::ClusterTopology topo;
+    topo.parse("alpha|127.0.0.1:" + std::to_string(alpha.listener.getPort()) + "|127.0.0.1:0|sys_a;"
+               "beta|127.0.0.1:" + std::to_string(beta.listener.getPort()) + "|127.0.0.1:0|sys_b");
+    cluster::ClusterProxy proxy(topo, "127.0.0.1", 0);
+    assertTrue(proxy.start(), "Proxy starts on ephemeral port");
+
+    std::mutex client_mtx;
+    std::string client_received;
+    auto client = cluster::NodeLink::connect("127.0.0.1:" + std::to_string(proxy.getPort()));
+    assertTrue(client != nullptr, "Client connects to proxy");
+    if (!client) return;
+    client->start([&](const std::shared_ptr<cluster::NodeLink>&, const std::string& data) {
+        std::lock_guard<std::mutex> lock(client_mtx);
+        client_received += data;
+    }, nullptr, true);
+
+    // A name with an escaped quote and a trailing backslash
+    client->sendRaw("{\"type\":\"connect\",\"data\":{\"player_id\":\"p1\","
+                    "\"character_name\":\"Kira \\\"K\\\" \\\\\"}}");
+    bool routed = waitFor([&] {
+        std::lock_guard<std::mutex> lock(alpha.mtx);
+        return alpha.received.find("Kira") != std::string::npos;
+    });
+    assertTrue(routed, "Connect routed to entry node");
+    assertTrue(proxy.getSessionCount() == 1, "Proxy tracks one session");
+
+    {
+        std::lock_guard<std::mutex> lock(alpha.mtx);
+        network::ProtocolHandler proto;
+        // Split mid-message: the proxy must wait for the whole redirect
+        std::string redirect = proto.createSessionRedirect("player_p1", "beta", "sys_b", "tok123");
+        size_t half = redirect.find("\"node_id\"") + 4;
+        alpha.conn->sendRaw("{\"type\":\"pong\"}\n" + redirect.substr(0, half));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        assertTrue(proxy.getRedirectCount() == 0, "Partial redirect not acted on");
+        alpha.conn->sendRaw(redirect.substr(half));
+    }
+    bool resumed = waitFor([&] {
+        std::lock_guard<std::mutex> lock(beta.mtx);
+        return beta.received.find("\"resume_entity\":\"player_p1\"") != std::string::npos;
+    });
+    assertTrue(resumed, "Proxy resumes session on new node");
+    {
+        std::lock_guard<std::mutex> lock(beta.mtx);
+        assertTrue(beta.received.find("\"character_name\":\"Kira \\\"K\\\" \\\\\",") != std::string::npos,
+                   "Resume carries the character name with its escapes intact");
+        assertTrue(beta.received.find("\"resume_token\":\"tok123\"") != std::string::npos,
+                   "Resume carries the one-time token");
+    }
+    assertTrue(proxy.getRedirectCount() == 1, "Redirect counted");
+    {
+        std::lock_guard<std::mutex> lock(client_mtx);
+        assertTrue(client_received.find("session_redirect") != std::string::npos,
+                   "Client sees redirect notice");
+    }
+
+    client->sendRaw("{\"type\":\"stop\"}");
+    bool relayed = waitFor([&] {
+        std::lock_guard<std::mutex> lock(beta.mtx);
+        return beta.received.find("\"stop\"") != std::string::npos;
+    });
+    assertTrue(relayed, "Later input relayed to new node");
+
+    client->close();
+    waitFor([&] { return proxy.getSessionCount() == 0; });
+    assertTrue(proxy.getSessionCount() == 0, "Session dropped when client leaves");
+    proxy.stop();
+    for (FakeNode* node : {&alpha, &beta}) {
+        node->listener.stop();
+        std::lock_guard<std::mutex> lock(node->mtx);
+        if (node->conn) node->conn->close();
+    }
+    waitFor([&] {
+        return !alpha.conn->isReading() && !beta.conn->isReading() && !client->isReading();
+    });
+}
+
+// ==================== Data Bake Tests ====================
+
+static std::string findDataDir() {
+    for (const char* dir : {"../data", "data", "../../data"}) {
+        std::ifstream probe(std::string(dir) + "/ships/frigates.json");
+        if (probe.is_open()) return dir;
+    }
+    return "";
+}
+
+static bool sameResists(const data::ShipTemplate::Resistances& a,
+                        const data::ShipTemplate::Resistances& b) {
+    return a.em == b.em && a.thermal == b.thermal &&
+           a.kinetic == b.kinetic && a.explosive == b.explosive;
+}
+
+void testDataBakeRoundTrip() {
+    std::cout << "\n=== Data Bake Round Trip ===" << std::endl;
+    std::string data_dir = findDataDir();
+    if (data_dir.empty()) {
+        std::cout << "  (data directory not found, skipping)" << std::endl;
+        return;
+    }
+    const std::string bake_path = "/tmp/eve_test_bake/round_trip.bake";
+    std::remove(bake_path.c_str());
+
+    data::ShipDatabase json_ships;
+    data::NpcDatabase json_npcs;
+    data::WormholeDatabase json_wh;
+    json_ships.loadFromDirectory(data_dir);
+    json_npcs.loadFromDirectory(data_dir);
+    json_wh.loadFromDirectory(data_dir);
+
+    data::ShipDatabase ships;
+    data::NpcDatabase npcs;
+    data::WormholeDatabase wh;
+    auto report = data::DataBake::load(data_dir, bake_path, &ships, &npcs, &wh);
+    assertTrue(!report.used_bake && report.rebuilt, "First load parses JSON and writes the bake");
+    assertTrue(report.source_hash != 0, "Source hash computed");
+
+    data::ShipDatabase baked_ships;
+    data::NpcDatabase baked_npcs;
+    data::WormholeDatabase baked_wh;
+    data::DataBake::Report read_report;
+    bool ok = data::DataBake::read(bake_path, report.source_hash,
+                                   &baked_ships, &baked_npcs, &baked_wh, &read_report);
+    assertTrue(ok, "Bake reads back with matching hash");
+    assertTrue(baked_ships.getShipCount() == json_ships.getShipCount() &&
+               baked_ships.getShipCount() > 0, "Ship count matches JSON");
+    assertTrue(baked_npcs.getNpcCount() == json_npcs.getNpcCount(), "NPC count matches JSON");
+    assertTrue(baked_wh.getClassCount() == json_wh.getClassCount() &&
+               baked_wh.getEffectCount() == json_wh.getEffectCount(), "Wormhole counts match JSON");
+    assertTrue(read_report.json_parse_ms > 0.0, "Bake remembers the JSON parse time");
+
+    int mismatched = 0;
+    for (const auto& id : json_ships.getShipIds()) {
+        const auto* a = json_ships.getShip(id);
+        const auto* b = baked_ships.getShip(id);
+        if (!b || a->name != b->name || a->ship_class != b->ship_class || a->race != b->race ||
+            a->description != b->description || a->hull_hp != b->hull_hp ||
+            a->armor_hp != b->armor_hp || a->shield_hp != b->shield_hp ||
+            a->cpu != b->cpu || a->powergrid != b->powergrid ||
+            a->high_slots != b->high_slots || a->rig_slots != b->rig_slots ||
+            a->max_velocity != b->max_velocity || a->max_targeting_range != b->max_targeting_range ||
+            !sameResists(a->shield_resists, b->shield_resists) ||
+            !sameResists(a->armor_resists, b->armor_resists) ||
+            !sameResists(a->hull_resists, b->hull_resists) ||
+            a->model_data.turret_hardpoints != b->model_data.turret_hardpoints ||
+            a->model_data.generation_seed != b->model_data.generation_seed ||
+            a->model_data.has_model_data != b->model_data.has_model_data) {
+            ++mismatched;
+        }
+    }
+    assertTrue(mismatched == 0, "Every baked ship matches its JSON template");
+
+    const auto* scout_json = json_npcs.getNpc("venom_syndicate_scout");
+    const auto* scout = baked_npcs.getNpc("venom_syndicate_scout");
+    assertTrue(scout != nullptr && scout_json != nullptr, "Baked NPC present");
+    if (scout && scout_json) {
+        assertTrue(scout->weapons.size() == scout_json->weapons.size(), "NPC weapon count preserved");
+        assertTrue(!scout->weapons.empty() &&
+                   scout->weapons[0].damage_type == scout_json->weapons[0].damage_type &&
+                   scout->weapons[0].damage == scout_json->weapons[0].damage, "NPC weapon fields preserved");
+        assertTrue(scout->loot_table == scout_json->loot_table, "NPC loot table preserved");
+        assertTrue(scout->bounty == scout_json->bounty, "NPC bounty preserved");
+    }
+
+    const auto* c1 = baked_wh.getWormholeClass("c1");
+    const auto* c1_json = json_wh.getWormholeClass("c1");
+    assertTrue(c1 != nullptr && c1_json != nullptr, "Baked wormhole class present");
+    if (c1 && c1_json) {
+        assertTrue(c1->static_connections == c1_json->static_connections, "Static connections preserved");
+        assertTrue(c1->dormant_spawns.size() == c1_json->dormant_spawns.size() &&
+                   !c1->dormant_spawns.empty() &&
+                   c1->dormant_spawns[0].name == c1_json->dormant_spawns[0].name &&
+                   c1->dormant_spawns[0].count_max == c1_json->dormant_spawns[0].count_max,
+                   "Dormant spawns preserved");
+        assertTrue(c1->max_ship_mass == c1_json->max_ship_mass, "Wormhole doubles preserved");
+    }
+    const auto* magnetar = baked_wh.getEffect("magnetar");
+    const auto* magnetar_json = json_wh.getEffect("magnetar");
+    assertTrue(magnetar != nullptr && magnetar_json != nullptr &&
+               magnetar->modifiers == magnetar_json->modifiers, "Effect modifiers preserved");
+}
+
+void testDataBakeReusesCurrentBake() {
+    std::cout << "\n=== Data Bake Reuses Current Bake ===" << std::endl;
+    std::string data_dir = findDataDir();
+    if (data_dir.empty()) {
+        std::cout << "  (data directory not found, skipping)" << std::endl;
+        return;
+    }
+    const std::string bake_path = "/tmp/eve_test_bake/reuse.bake";
+    std::remove(bake_path.c_str());
+
+    data::ShipDatabase first;
+    auto r1 = data::DataBake::load(data_dir, bake_path, &first, nullptr, nullptr);
+    data::ShipDatabase second;
+    auto r2 = data::DataBake::load(data_dir, bake_path, &second, nullptr, nullptr);
+    assertTrue(r1.rebuilt && !r1.used_bake, "Missing bake is built");
+    assertTrue(r2.used_bake && !r2.rebuilt, "Current bake is loaded without parsing JSON");
+    assertTrue(second.getShipCount() == first.getShipCount(), "Bake load fills the same ships");
+    assertTrue(r2.bake_bytes > 0, "Bake size reported");
+    std::cout << "  JSON parse " << r1.json_parse_ms << " ms, bake load "
+              << r2.load_ms << " ms (" << r2.bake_bytes << " bytes)" << std::endl;
+}
+
+void testDataBakeRejectsStaleOrCorrupt() {
+    std::cout << "\n=== Data Bake Rejects Stale Or Corrupt ===" << std::endl;
+    std::string data_dir = findDataDir();
+    if (data_dir.empty()) {
+        std::cout << "  (data directory not found, skipping)" << std::endl;
+        return;
+    }
+    const std::string bake_path = "/tmp/eve_test_bake/corrupt.bake";
+    data::ShipDatabase ships;
+    data::NpcDatabase npcs;
+    data::WormholeDatabase wh;
+    uint64_t hash = data::DataBake::hashSources(data_dir);
+    data::ShipDatabase src;
+    data::NpcDatabase src_npcs;
+    data::WormholeDatabase src_wh;
+    src.loadFromDirectory(data_dir);
+    assertTrue(data::DataBake::write(bake_path, hash, src, src_npcs, src_wh), "Bake written");
+
+    assertTrue(!data::DataBake::read(bake_path, hash + 1, &ships, nullptr, nullptr),
+               "Hash mismatch rejected");
+    assertTrue(ships.getShipCount() == 0, "Rejected bake leaves database untouched");
+
+    std::ifstream in(bake_path, std::ios::binary);
+    std::string blob((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    {
+        std::ofstream out(bake_path, std::ios::binary | std::ios::trunc);
+        out.write(blob.data(), static_cast<std::streamsize>(blob.size() / 2));
+    }
+    assertTrue(!data::DataBake::read(bake_path, hash, &ships, &npcs, &wh), "Truncated bake rejected");
+    {
+        std::string bad = blob;
+        bad[0] = 'X';
+        std::ofstream out(bake_path, std::ios::binary | std::ios::trunc);
+        out.write(bad.data(), static_cast<std::streamsize>(bad.size()));
+    }
+    assertTrue(!data::DataBake::read(bake_path, hash, &ships, &npcs, &wh), "Bad magic rejected");
+    assertTrue(!data::DataBake::read("/tmp/eve_test_bake/missing.bake", hash, &ships, nullptr, nullptr),
+               "Missing bake rejected");
+}
+
+static void writeBakeTestShips(const std::string& dir, float hull_hp) {
+    mkdir(dir.c_str(), 0755);
+    mkdir((dir + "/ships").c_str(), 0755);
+    std::ofstream out(dir + "/ships/frigates.json", std::ios::trunc);
+    out << "{\n  \"test_frigate\": {\n    \"name\": \"Test Frigate\",\n"
+        << "    \"class\": \"Frigate\",\n    \"hull_hp\": " << hull_hp << "\n  }\n}\n";
+}
+
+void testDataBakeRebuildsOnSourceChange() {
+    std::cout << "\n=== Data Bake Rebuilds On Source Change ===" << std::endl;
+    const std::string data_dir = "/tmp/eve_test_bake_src";
+    const std::string bake_path = "/tmp/eve_test_bake/source_change.bake";
+    std::remove(bake_path.c_str());
+    writeBakeTestShips(data_dir, 350.0f);
+
+    data::ShipDatabase a;
+    auto r1 = data::DataBake::load(data_dir, bake_path, &a, nullptr, nullptr);
+    assertTrue(r1.rebuilt && a.getShipCount() == 1, "Bake built from small data dir");
+
+    data::ShipDatabase b;
+    auto r2 = data::DataBake::load(data_dir, bake_path, &b, nullptr, nullptr);
+    assertTrue(r2.used_bake, "Unchanged sources load from bake");
+
+    writeBakeTestShips(data_dir, 420.0f);
+    data::ShipDatabase c;
+    auto r3 = data::DataBake::load(data_dir, bake_path, &c, nullptr, nullptr);
+    assertTrue(r3.rebuilt && !r3.used_bake, "Edited JSON triggers a rebuild");
+    assertTrue(r3.source_hash != r1.source_hash, "Source hash changes with content");
+    const auto* ship = c.getShip("test_frigate");
+    assertTrue(ship != nullptr && approxEqual(ship->hull_hp, 420.0f), "Rebuilt bake carries new value");
+
+    data::ShipDatabase d;
+    auto r4 = data::DataBake::load(data_dir, bake_path, &d, nullptr, nullptr);
+    const auto* baked = d.getShip("test_frigate");
+    assertTrue(r4.used_bake && baked != nullptr && approxEqual(baked->hull_hp, 420.0f),
+               "Rebuilt bake is reused on the next load");
+}
+
+// ==================== Ship Template Registry Tests ====================
+
+static const data::ShipStats* registerFlyweightTestHull() {
+    data::ShipTemplate tmpl;
+    tmpl.id = "flyweight_test_hull";
+    tmpl.name = "Flyweight Test Hull";
+    tmpl.ship_class = "Cruiser";
+    tmpl.race = "Solari";
+    tmpl.hull_hp = 1200.0f;
+    tmpl.armor_hp = 1500.0f;
+    tmpl.shield_hp = 900.0f;
+    tmpl.scan_resolution = 250.0f;
+    tmpl.max_locked_targets = 2;
+    tmpl.armor_resists.thermal = 0.35f;
+    return data::ShipTemplateRegistry::shared().registerTemplate(tmpl);
+}
+
+void testShipTemplateRegistrySharesRecords() {
+    std::cout << "\n=== Ship Template Registry Shares Records ===" << std::endl;
+    const data::ShipStats* a = registerFlyweightTestHull();
+    const data::ShipStats* b = registerFlyweightTestHull();
+    auto& registry = data::ShipTemplateRegistry::shared();
+    assertTrue(a != nullptr && a == b, "Re-registering an id returns the same record");
+    assertTrue(registry.find("flyweight_test_hull") == a, "Lookup by id");
+    assertTrue(registry.findByName("Flyweight Test Hull") == a, "Lookup by display name");
+    assertTrue(approxEqual(a->value(data::ShipStat::HullMax), 1200.0f), "Hull max from template");
+    assertTrue(approxEqual(a->value(data::ShipStat::ArmorThermalResist), 0.35f), "Resist from template");
+    assertTrue(a->value(data::ShipStat::MaxLockedTargets) == 2.0f, "Integer stat stored as float");
+
+    components::Health hp;
+    data::applyTemplateHealth(hp, *a);
+    assertTrue(approxEqual(hp.armor_hp, 1500.0f) && approxEqual(hp.armor_max, 1500.0f),
+               "Health starts at template max");
+    assertTrue(approxEqual(hp.armor_thermal_resist, 0.35f), "Health resists from template");
+
+    data::ShipStat stat;
+    assertTrue(data::parseShipStat("scan_resolution", stat) && stat == data::ShipStat::ScanResolution,
+               "Stat names round-trip");
+    assertTrue(!data::parseShipStat("bogus", stat), "Unknown stat name rejected");
+}
+
+void testShipTemplateSparseOverrides() {
+    std::cout << "\n=== Ship Template Sparse Overrides ===" << std::endl;
+    components::ShipTemplateRef ref;
+    ref.stats = registerFlyweightTestHull();
+
+    assertTrue(ref.overrides.empty(), "Fresh reference holds no overrides");
+    data::setShipStat(ref, data::ShipStat::ScanResolution, 300.0f);
+    data::setShipStat(ref, data::ShipStat::ArmorMax, 1800.0f);
+    assertTrue(ref.overrides.size() == 2, "Only diverging stats are stored");
+    assertTrue(approxEqual(data::shipStat(ref, data::ShipStat::ScanResolution), 300.0f),
+               "Override wins over template");
+    assertTrue(approxEqual(data::shipStat(ref, data::ShipStat::HullMax), 1200.0f),
+               "Untouched stat reads through to template");
+    assertTrue(ref.overrides[0].first < ref.overrides[1].first, "Overrides kept sorted by stat");
+
+    data::setShipStat(ref, data::ShipStat::ScanResolution, 250.0f);
+    assertTrue(ref.overrides.size() == 1, "Setting a stat back to base drops the override");
+    data::clearShipStat(ref, data::ShipStat::ArmorMax);
+    assertTrue(ref.overrides.empty(), "Cleared override removed");
+
+    data::setShipStat(ref, data::ShipStat::MaxVelocity, 90.0f);
+    auto copy = ref.clone();
+    auto* cloned = static_cast<components::ShipTemplateRef*>(copy.get());
+    assertTrue(cloned->stats == ref.stats, "Clone shares the template record");
+    assertTrue(approxEqual(data::shipStat(*cloned, data::ShipStat::MaxVelocity), 90.0f),
+               "Clone carries the overrides");
+}
+
+void testShipTemplateDrivesTargeting() {
+    std::cout << "\n=== Ship Template Drives Targeting ===" << std::endl;
+    ecs::World world;
+    systems::TargetingSystem targetSys(&world);
+
+    auto* npc = world.createEntity("flyweight_npc");
+    addComp<components::Target>(npc);
+    auto* ref = addComp<components::ShipTemplateRef>(npc);
+    ref->stats = registerFlyweightTestHull();
+    for (const char* id : {"t1", "t2", "t3"}) world.createEntity(id);
+
+    assertTrue(data::entityShipClass(*npc) == "Cruiser", "Ship class resolved from template");
+    assertTrue(targetSys.startLock("flyweight_npc", "t1"), "Flyweight entity can lock");
+    assertTrue(targetSys.startLock("flyweight_npc", "t2"), "Second lock within template limit");
+    assertTrue(!targetSys.startLock("flyweight_npc", "t3"), "Template max_locked_targets enforced");
+
+    // lock_time = 1000 / 250 = 4 s from the template
+    targetSys.update(3.0f);
+    assertTrue(!targetSys.isTargetLocked("flyweight_npc", "t1"), "Template scan resolution sets lock time");
+    data::setShipStat(*ref, data::ShipStat::ScanResolution, 1000.0f);
+    targetSys.update(1.0f);
+    assertTrue(targetSys.isTargetLocked("flyweight_npc", "t1"), "Per-entity override takes effect");
+}
+
+void testShipTemplatePersistenceRoundTrip() {
+    std::cout << "\n=== Ship Template Persistence Round Trip ===" << std::endl;
+    const data::ShipStats* stats = registerFlyweightTestHull();
+    ecs::World world;
+    auto* npc = world.createEntity("flyweight_saved");
+    auto* ref = addComp<components::ShipTemplateRef>(npc);
+    ref->stats = stats;
+    data::setShipStat(*ref, data::ShipStat::MaxLockedTargets, 5.0f);
+    ref->ship_class = "Frigate";
+
+    data::WorldPersistence persistence;
+    std::string json = persistence.serializeEntity(npc);
+    assertTrue(json.find("\"ship_template\"") != std::string::npos &&
+               json.find("\"max_locked_targets\":5") != std::string::npos,
+               "Saved as template id plus overrides");
+    assertTrue(json.find("\"ship\":") == std::string::npos, "No full ship copy saved");
+
+    ecs::World restored;
+    assertTrue(persistence.deserializeEntity(&restored, json), "Entity deserialized");
+    auto* loaded = restored.getEntity("flyweight_saved");
+    auto* loaded_ref = loaded ? loaded->getComponent<components::ShipTemplateRef>() : nullptr;
+    assertTrue(loaded_ref && loaded_ref->stats == stats, "Reference resolved to the shared record");
+    assertTrue(loaded_ref && loaded_ref->overrides.size() == 1 &&
+               data::shipStat(*loaded_ref, data::ShipStat::MaxLockedTargets) == 5.0f,
+               "Override restored");
+    assertTrue(loaded && data::entityShipClass(*loaded) == "Frigate", "Class override restored");
+}
+
+void testShipTemplateMemoryReport() {
+    std::cout << "\n=== Ship Template Memory Report ===" << std::endl;
+    const data::ShipStats* stats = registerFlyweightTestHull();
+    ecs::World world;
+    const int count = 5000;
+    for (int i = 0; i < count; ++i) {
+        auto* e = world.createEntity("fw_" + std::to_string(i));
+        auto* ref = addComp<components::ShipTemplateRef>(e);
+        ref->stats = stats;
+        if (i % 10 == 0) data::setShipStat(*ref, data::ShipStat::ShieldMax, 1000.0f);
+    }
+    auto report = data::measureShipMemory(world, data::ShipTemplateRegistry::shared());
+    assertTrue(report.entities == static_cast<size_t>(count), "Every flyweight entity counted");
+    assertTrue(report.overrides == static_cast<size_t>(count / 10), "Sparse overrides counted");
+    assertTrue(report.flyweight_bytes < report.full_copy_bytes, "Flyweight smaller than full copies");
+    assertTrue(report.bytesSavedPerEntity() > 100.0, "Saves over 100 bytes per entity");
+    std::cout << "  " << count << " entities: full copies " << report.full_copy_bytes
+              << " B, flyweight " << report.flyweight_bytes << " B + shared "
+              << report.shared_bytes << " B (" << report.bytesSavedPerEntity()
+              << " B saved per entity)" << std::endl;
+}
+
+void testSpawnedNpcKeepsFixedBalance() {
+    std::cout << "\n=== Spawned NPC Keeps Fixed Balance ===" << std::endl;
+    ecs::World world;
+    network::TCPServer server("127.0.0.1", 0, 4);
+    GameSession session(&world, &server);
+    session.initialize();
+
+    // Falk is a known hull, so the NPC is a flyweight
+    auto* npc = world.getEntity("npc_corsairs_1");
+    auto* ref = npc ? npc->getComponent<components::ShipTemplateRef>() : nullptr;
+    assertTrue(ref != nullptr && ref->stats != nullptr, "Known hull spawns as a template reference");
+    if (!ref) return;
+
+    auto* hp = npc->getComponent<components::Health>();
+    assertTrue(approxEqual(hp->shield_max, 300.0f) && approxEqual(hp->armor_max, 250.0f) &&
+               approxEqual(hp->hull_max, 200.0f), "NPC pools stay 300/250/200");
+    assertTrue(approxEqual(hp->armor_thermal_resist, 0.0f), "NPC has no resists");
+    assertTrue(approxEqual(npc->getComponent<components::Velocity>()->max_speed, 250.0f),
+               "NPC speed stays 250 m/s");
+    assertTrue(data::entityShipClass(*npc) == "Frigate", "NPC flies as a frigate for AI orbit range");
+    float value = 0.0f;
+    assertTrue(data::entityShipStat(*npc, data::ShipStat::ShieldMax, value) && approxEqual(value, 300.0f),
+               "Template stats read back the pinned pool");
+    assertTrue(data::entityShipStat(*npc, data::ShipStat::ScanResolution, value) &&
+               approxEqual(value, components::Ship().scan_resolution),
+               "Targeting uses the old default frigate stats");
+    assertTrue(ref->stats->name == "Falk", "Template still names the hull");
+}
+
+// ==================== Chat Hub Tests ====================
+
+void testChatHistoryRing() {
+    std::cout << "\n=== Chat History Ring ===" << std::endl;
+    network::ChatHistory history(3);
+    for (uint64_t i = 1; i <= 5; ++i) {
+        auto entry = std::make_shared<network::ChatEntry>();
+        entry->sequence = i;
+        history.push(entry);
+    }
+    assertTrue(history.size() == 3 && history.capacity() == 3, "History capped at capacity");
+    assertTrue(history.at(0).sequence == 3 && history.at(2).sequence == 5,
+               "Oldest entries overwritten in order");
+    auto recent = history.recent(2);
+    assertTrue(recent.size() == 2 && recent[0]->sequence == 4 && recent[1]->sequence == 5,
+               "recent() returns newest entries oldest-first");
+    assertTrue(history.recent(10).size() == 3, "recent() clamps to size");
+}
+
+void testChatHubMembershipFanout() {
+    std::cout << "\n=== Chat Hub Membership Fan-out ===" << std::endl;
+    std::map<int, std::vector<std::string>> inbox;
+    int serializations = 0;
+    network::ChatHub hub(
+        [&](network::ChatMemberId m, const std::string& payload) { inbox[m].push_back(payload); },
+        [&](const network::ChatEntry& e) { ++serializations; return e.channel + "|" + e.sender_name + "|" + e.text; });
+
+    hub.join("corp", 1);
+    hub.join("corp", 2);
+    hub.join("fleet", 3);
+    assertTrue(!hub.join("corp", 1), "Duplicate join rejected");
+    assertTrue(hub.memberCount("corp") == 2, "Corp has two members");
+
+    assertTrue(hub.post("corp", 1, "Alice", "o7", 0.0) == network::ChatResult::Delivered,
+               "Member can post");
+    assertTrue(inbox[1].size() == 1 && inbox[2].size() == 1 && inbox[3].empty(),
+               "Only channel members receive the message");
+    assertTrue(inbox[2][0] == "corp|Alice|o7", "Payload built by serializer");
+    assertTrue(serializations == 1, "Message serialized once for all recipients");
+
+    assertTrue(hub.post("corp", 3, "Mallory", "hi", 0.0) == network::ChatResult::NotMember,
+               "Non-member cannot post");
+    assertTrue(hub.post("nowhere", 1, "Alice", "hi", 0.0) == network::ChatResult::UnknownChannel,
+               "Unknown channel rejected");
+    assertTrue(hub.post("corp", 1, "Alice", "", 0.0) == network::ChatResult::Empty,
+               "Empty message rejected");
+
+    auto history = hub.history("corp", 10);
+    assertTrue(history.size() == 1 && history[0]->text == "o7", "Post recorded in channel history");
+
+    hub.removeMember(2);
+    hub.post("corp", 1, "Alice", "still here?", 0.0);
+    assertTrue(inbox[2].size() == 1, "Removed member no longer receives");
+    auto stats = hub.getStats();
+    assertTrue(stats.posted == 2 && stats.delivered == 3 && stats.rejected == 3,
+               "Stats count posts, deliveries and rejections");
+}
+
+void testChatHubRateLimit() {
+    std::cout << "\n=== Chat Hub Rate Limit ===" << std::endl;
+    network::ChatHubConfig config;
+    config.rate_limit_burst = 3.0;
+    config.rate_limit_per_second = 1.0;
+    config.max_message_length = 4;
+    int sends = 0;
+    network::ChatHub hub([&](network::ChatMemberId, const std::string&) { ++sends; },
+                         [](const network::ChatEntry& e) { return e.text; }, config);
+    hub.join("local", 7);
+    hub.join("local", 8);
+
+    int delivered = 0;
+    for (int i = 0; i < 5; ++i) {
+        if (hub.post("local", 7, "Spammer", "spam", 10.0) == network::ChatResult::Delivered) ++delivered;
+    }
+    assertTrue(delivered == 3, "Burst allowance enforced");
+    assertTrue(hub.getStats().rate_limited == 2, "Excess posts counted as rate limited");
+    assertTrue(hub.post("local", 8, "Other", "hi", 10.0) == network::ChatResult::Delivered,
+               "Limit is per sender");
+    assertTrue(hub.post("local", 7, "Spammer", "spam", 10.5) == network::ChatResult::RateLimited,
+               "Half a second refills less than one message");
+    assertTrue(hub.post("local", 7, "Spammer", "spam", 11.2) == network::ChatResult::Delivered,
+               "Tokens refill over time");
+    assertTrue(hub.history("local", 1)[0]->text == "spam", "Latest message kept");
+    hub.post("local", 8, "Other", "truncate me", 20.0);
+    assertTrue(hub.history("local", 1)[0]->text == "trun", "Long messages truncated");
+}
+
+void testChatHubLocalChannels() {
+    std::cout << "\n=== Chat Hub Local Channels ===" << std::endl;
+    std::map<int, int> received;
+    network::ChatHub hub([&](network::ChatMemberId m, const std::string&) { ++received[m]; },
+                         [](const network::ChatEntry& e) { return e.text; });
+
+    hub.setLocalSystem(1, "jita");
+    hub.setLocalSystem(2, "jita");
+    hub.setLocalSystem(3, "amarr");
+    assertTrue(hub.localChannelOf(1) == network::ChatHub::localChannel("jita"),
+               "Member placed in system's local channel");
+    assertTrue(hub.postLocal(1, "A", "hello jita", 0.0) == network::ChatResult::Delivered,
+               "Local post delivered");
+    assertTrue(received[1] == 1 && received[2] == 1 && received[3] == 0,
+               "Local chat stays within the solar system");
+
+    hub.setLocalSystem(2, "amarr");
+    assertTrue(!hub.isMember(network::ChatHub::localChannel("jita"), 2) &&
+               hub.isMember(network::ChatHub::localChannel("amarr"), 2),
+               "Moving systems switches local channel");
+    hub.postLocal(3, "C", "hello amarr", 0.0);
+    assertTrue(received[2] == 2 && received[1] == 1, "Moved member hears new system");
+    assertTrue(hub.postLocal(99, "X", "who?", 0.0) == network::ChatResult::NotMember,
+               "Member without a local channel cannot post locally");
+}
+
+void testChatHubJoinableChannels() {
+    std::cout << "\n=== Chat Hub Joinable Channels ===" << std::endl;
+    using network::ChatHub;
+    assertTrue(ChatHub::isJoinableChannel("corp") && ChatHub::isJoinableChannel("Fleet_2-b"),
+               "Plain channel names are joinable");
+    assertTrue(!ChatHub::isJoinableChannel("") &&
+               !ChatHub::isJoinableChannel(std::string(33, 'a')),
+               "Empty and over-long names rejected");
+    assertTrue(!ChatHub::isJoinableChannel("local") &&
+               !ChatHub::isJoinableChannel(ChatHub::localChannel("jita")),
+               "Local channels cannot be joined by name");
+    assertTrue(!ChatHub::isJoinableChannel("a\"b") && !ChatHub::isJoinableChannel("two words"),
+               "Quotes and spaces rejected");
+}
+
+void testChatHubFanoutBenchmark() {
+    std::cout << "\n=== Chat Hub Fan-out Benchmark (5k members) ===" << std::endl;
+    const int members = 5000;
+    const int posts = 200;
+    uint64_t sends = 0;
+    const std::string* last_payload = nullptr;
+    bool shared_buffer = true;
+    int sends_this_post = 0;
+    network::ChatHubConfig config;
+    config.rate_limit_burst = posts;
+    network::ChatHub hub(
+        [&](network::ChatMemberId, const std::string& payload) {
+            if (sends_this_post++ > 0 && &payload != last_payload) shared_buffer = false;
+            last_payload = &payload;
+            ++sends;
+        },
+        [](const network::ChatEntry& e) {
+            return "{\"type\":\"chat\",\"data\":{\"sender\":\"" + e.sender_name +
+                   "\",\"message\":\"" + e.text + "\"}}";
+        },
+        config);
+    for (int m = 0; m < members; ++m) hub.join("local:jita", m);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < posts; ++i) {
+        sends_this_post = 0;
+        hub.post("local:jita", i % members, "Trader", "WTS Rifter " + std::to_string(i), 0.0);
+    }
+    double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    auto stats = hub.getStats();
+    assertTrue(sends == static_cast<uint64_t>(members) * posts, "Every member received every post");
+    assertTrue(stats.serialized == static_cast<uint64_t>(posts), "One serialization per post");
+    assertTrue(shared_buffer, "All recipients of a post share one payload buffer");
+    assertTrue(hub.history("local:jita", 1000).size() == 200, "History holds the default capacity");
+    std::cout << "  " << posts << " posts x " << members << " members: " << ms << " ms ("
+              << (ms * 1000.0 / posts) << " us per post, "
+              << (static_cast<double>(sends) / (ms / 1000.0)) << " deliveries/s)" << std::endl;
+}
+
+// ==================== Event Bus Tests ====================
+
+void testEventBusDoubleBuffer() {
+    std::cout << "\n=== Event Bus Double Buffer ===" << std::endl;
+
+    ecs::EventBus bus;
+    bus.emit(systems::DockEvent{"ship_1", "station_1", true});
+    bus.emit(systems::DockEvent{"ship_2", "station_1", true});
+    assertTrue(bus.read<systems::DockEvent>().empty(), "Pending events not readable before publish");
+    assertTrue(bus.pendingCount() == 2, "Two events pending");
+
+    bus.publish();
+    auto batch = bus.read<systems::DockEvent>();
+    assertTrue(batch.size() == 2, "Published batch holds both events");
+    assertTrue(batch.size() == 2 && batch[0].entity_id == "ship_1" && batch[1].entity_id == "ship_2",
+               "Batch preserves emit order");
+    assertTrue(&batch[1] == &batch[0] + 1, "Events stored contiguously");
+
+    bus.emit(systems::DockEvent{"ship_3", "station_1", false});
+    assertTrue(bus.read<systems::DockEvent>().size() == 2, "Emitting does not disturb the readable batch");
+
+    bus.publish();
+    batch = bus.read<systems::DockEvent>();
+    assertTrue(batch.size() == 1 && batch[0].entity_id == "ship_3" && !batch[0].docked,
+               "Next publish exposes only the next tick's events");
+
+    bus.publish();
+    assertTrue(bus.read<systems::DockEvent>().empty(), "Batch empties after a quiet tick");
+    assertTrue(bus.read<systems::WarpEvent>().empty(), "Unknown type reads as empty");
+    assertTrue(bus.streamCount() == 1, "Reading an unknown type does not create a stream");
+}
+
+void testEventBusRecyclesSlots() {
+    std::cout << "\n=== Event Bus Recycles Slots ===" << std::endl;
+
+    ecs::EventBus bus;
+    auto& stream = bus.stream<systems::DamageDealtEvent>();
+    systems::DamageDealtEvent hit;
+    hit.target_id = "target_with_a_long_identifier_000000";
+    hit.attacker_id = "attacker_with_a_long_identifier_000";
+    hit.damage_type = "kinetic";
+
+    // Warm both buffers to the peak per-tick volume
+    for (int tick = 0; tick < 2; ++tick) {
+        for (int i = 0; i < 64; ++i) bus.emit(hit);
+        bus.publish();
+    }
+    size_t capacity = stream.slotCapacity();
+    const systems::DamageDealtEvent* first = bus.read<systems::DamageDealtEvent>().begin();
+    const char* name_storage = first->target_id.data();
+
+    bool stable = true;
+    for (int tick = 0; tick < 100; ++tick) {
+        for (int i = 0; i < 64; ++i) bus.emit(hit);
+        bus.publish();
+        stable = stable && stream.slotCapacity() == capacity;
+    }
+    assertTrue(capacity == 128, "Each buffer retains its peak slot count");
+    assertTrue(stable, "Steady-state ticks add no slots");
+    auto batch = bus.read<systems::DamageDealtEvent>();
+    assertTrue(batch.size() == 64, "Full batch readable after recycling");
+    assertTrue(batch.begin() == first && first->target_id.data() == name_storage,
+               "Recycled slots reuse element and string storage");
+}
+
+void testEventBusSubscribersGetBatches() {
+    std::cout << "\n=== Event Bus Subscribers Get Batches ===" << std::endl;
+
+    ecs::World world;
+    int calls = 0;
+    size_t delivered = 0;
+    world.events().subscribe<systems::WarpEvent>(
+        [&](const ecs::EventBatch<systems::WarpEvent>& batch) {
+            ++calls;
+            delivered += batch.size();
+        });
+
+    for (int i = 0; i < 5; ++i) {
+        systems::WarpEvent warp;
+        warp.entity_id = "ship_" + std::to_string(i);
+        world.events().emit(warp);
+    }
+    assertTrue(calls == 0, "Subscribers not called on emit");
+
+    world.update(0.1f);
+    assertTrue(calls == 1 && delivered == 5, "One call per tick with the whole batch");
+
+    world.update(0.1f);
+    assertTrue(calls == 1, "No call for an empty batch");
+}
+
+void testEventBusCombatEvents() {
+    std::cout << "\n=== Event Bus Combat Events ===" << std::endl;
+
+    ecs::World world;
+    systems::WeaponSystem weaponSys(&world);
+    systems::CombatSystem combatSys(&world);
+    systems::LeaderboardSystem lbSys(&world);
+    weaponSys.setCombatSystem(&combatSys);
+
+    addComp<components::Leaderboard>(world.createEntity("board_1"));
+    makeDamageTarget(world, "target", 0.0f, 0.0f, 100.0f);
+
+    const char* shooters[] = {"pilot", "npc"};
+    float damages[] = {80.0f, 30.0f};
+    for (int i = 0; i < 2; ++i) {
+        auto* shooter = world.createEntity(shooters[i]);
+        auto* weapon = addComp<components::Weapon>(shooter);
+        weapon->damage = damages[i];
+        weapon->damage_type = "thermal";
+        weapon->capacitor_cost = 0.0f;
+        weapon->optimal_range = 10000.0f;
+        addComp<components::Position>(shooter);
+    }
+    auto* player = addComp<components::Player>(world.getEntity("pilot"));
+    player->player_id = "p1";
+    player->character_name = "Alice";
+
+    weaponSys.fireWeapon("pilot", "target");
+    weaponSys.fireWeapon("npc", "target");
+    combatSys.update(0.1f);
+
+    const auto& resolved = combatSys.getResolvedDamage();
+    assertTrue(resolved.size() == 1 && resolved[0].attacker_id == "pilot",
+               "Resolved damage attributed to the largest contributor");
+
+    world.events().publish();
+    auto hits = world.events().read<systems::DamageDealtEvent>();
+    assertTrue(hits.size() == 1, "One damage event per target per tick");
+    assertTrue(hits.size() == 1 && hits[0].attacker_id == "pilot" && hits[0].destroyed &&
+               approxEqual(hits[0].applied, 100.0f), "Damage event carries attacker and outcome");
+
+    auto kills = world.events().read<systems::EntityKilledEvent>();
+    assertTrue(kills.size() == 1 && kills[0].victim_id == "target" && kills[0].killer_id == "pilot",
+               "Kill event emitted with killer");
+
+    lbSys.update(0.1f);
+    assertTrue(lbSys.getPlayerKills("board_1", "p1") == 1, "Leaderboard consumes kill events");
+
+    // Immediate damage path emits the same event type
+    makeDamageTarget(world, "target_2", 100.0f, 0.0f, 100.0f);
+    combatSys.applyDamage("target_2", 10.0f, "em", "npc");
+    world.events().publish();
+    hits = world.events().read<systems::DamageDealtEvent>();
+    assertTrue(hits.size() == 1 && hits[0].target_id == "target_2" &&
+               hits[0].attacker_id == "npc" && hits[0].layer_hit == "shield" &&
+               approxEqual(hits[0].applied, 10.0f), "applyDamage emits a damage event");
+}
+
+void testEventBusDefensiveAIUsesEvents() {
+    std::cout << "\n=== Event Bus Defensive AI Uses Events ===" << std::endl;
+
+    ecs::World world;
+    systems::AISystem aiSys(&world);
+
+    auto* patrol = world.createEntity("patrol_01");
+    auto* ai = addComp<components::AI>(patrol);
+    ai->behavior = components::AI::Behavior::Defensive;
+    ai->awareness_range = 100000.0f;
+    addComp<components::Position>(patrol);
+    auto* patrolFaction = addComp<components::Faction>(patrol);
+    patrolFaction->faction_name = "Solari";
+    patrolFaction->standings["Veyren"] = -5.0f;
+
+    auto* player = world.createEntity("player_01");
+    addComp<components::Player>(player);
+    addComp<components::Position>(player)->x = 200.0f;
+    addComp<components::Standings>(player)->faction_standings["Solari"] = 3.0f;
+
+    // The attacker is not an AI targeting the player, so only the event
+    // names it; no DamageEvent component exists either
+    auto* pirate = world.createEntity("pirate_01");
+    addComp<components::Position>(pirate)->x = 300.0f;
+    addComp<components::Faction>(pirate)->faction_name = "Veyren";
+
+    assertTrue(aiSys.findAttackerOfFriendly(patrol) == nullptr, "No attacker before any damage");
+
+    systems::DamageDealtEvent hit;
+    hit.target_id = "player_01";
+    hit.attacker_id = "pirate_01";
+    hit.damage = 50.0f;
+    world.events().emit(hit);
+    world.events().publish();
+    assertTrue(aiSys.findAttackerOfFriendly(patrol) == pirate,
+               "Defensive NPC finds attacker from damage events");
+
+    // An allied attacker is ignored
+    patrolFaction->standings["Veyren"] = 2.0f;
+    assertTrue(aiSys.findAttackerOfFriendly(patrol) == nullptr, "Allied attacker ignored");
+}
+
+void testEventBusDockWarpMissionEvents() {
+    std::cout << "\n=== Event Bus Dock Warp Mission Events ===" << std::endl;
+
+    ecs::World world;
+    systems::StationSystem stationSys(&world);
+    systems::MovementSystem moveSys(&world);
+    systems::MissionSystem missionSys(&world);
+
+    stationSys.createStation("station_1", "Hub", 0, 0, 0, 5000.0f);
+    auto* ship = world.createEntity("player_1");
+    addComp<components::Position>(ship)->x = 100.0f;
+    addComp<components::Velocity>(ship);
+    addComp<components::MissionTracker>(ship);
+
+    stationSys.dockAtStation("player_1", "station_1");
+    stationSys.undockFromStation("player_1");
+
+    missionSys.acceptMission("player_1", "m1", "Destroy Pirates", 1, "combat", "Veyren", 1000.0, 0.1f);
+    components::MissionTracker::Objective obj;
+    obj.type = "destroy";
+    obj.target = "pirate";
+    obj.required = 3;
+    ship->getComponent<components::MissionTracker>()->active_missions[0].objectives.push_back(obj);
+    missionSys.recordProgress("player_1", "m1", "destroy", "pirate", 2);
+
+    assertTrue(moveSys.commandWarp("player_1", 1.0e7f, 0.0f, 0.0f), "Warp command accepted");
+
+    world.events().publish();
+    auto docks = world.events().read<systems::DockEvent>();
+    assertTrue(docks.size() == 2 && docks[0].docked && !docks[1].docked &&
+               docks[1].station_id == "station_1", "Dock and undock events emitted");
+    auto progress = world.events().read<systems::MissionProgressEvent>();
+    assertTrue(progress.size() == 1 && progress[0].completed == 2 && progress[0].required == 3,
+               "Mission progress event emitted");
+    auto warps = world.events().read<systems::WarpEvent>();
+    assertTrue(warps.size() == 1 && warps[0].phase == systems::WarpEvent::Phase::Started,
+               "Warp start event emitted");
+
+    for (int i = 0; i < 200; ++i) moveSys.update(0.5f);
+    world.events().publish();
+    warps = world.events().read<systems::WarpEvent>();
+    assertTrue(warps.size() == 1 && warps[0].phase == systems::WarpEvent::Phase::Completed &&
+               approxEqual(warps[0].dest_x, 1.0e7f), "Warp completion event emitted");
+}
+
+// ==================== Timer Wheel Tests ====================
+
+void testTimerWheelFiresAtDeadlines() {
+    std::cout << "\n=== Timer Wheel Fires At Deadlines ===" << std::endl;
+
+    utils::TimerWheel wheel(1.0);
+    wheel.schedule("soon", 1.5);
+    wheel.schedule("minutes", 300.0);
+    wheel.schedule("day", 86400.0);
+    wheel.schedule("year", 3.2e7);
+    wheel.schedule("moved", 10.0);
+    wheel.schedule("moved", 20.0);
+    wheel.schedule("dropped", 5.0);
+    assertTrue(wheel.cancel("dropped"), "Cancel reports an armed timer");
+    assertTrue(wheel.size() == 5, "Rescheduling replaces, cancel removes");
+
+    std::vector<utils::TimerWheel::Timer> fired;
+    wheel.advance(1.2, fired);
+    assertTrue(fired.empty(), "Nothing fires before its deadline within the same tick");
+    wheel.advance(1.5, fired);
+    assertTrue(fired.size() == 1 && fired[0].key == "soon", "Fires once the deadline is reached");
+
+    fired.clear();
+    wheel.advance(15.0, fired);
+    assertTrue(fired.empty(), "Superseded deadline does not fire");
+    wheel.advance(20.0, fired);
+    assertTrue(fired.size() == 1 && fired[0].key == "moved", "Rescheduled deadline fires");
+
+    fired.clear();
+    wheel.advance(86399.0, fired);
+    assertTrue(fired.size() == 1 && fired[0].key == "minutes", "Level-one timer cascades down and fires");
+    fired.clear();
+    wheel.advance(86400.0, fired);
+    assertTrue(fired.size() == 1 && fired[0].key == "day", "Level-two timer fires on time");
+    fired.clear();
+    wheel.advance(3.2e7 - 1.0, fired);
+    assertTrue(fired.empty(), "Level-three timer not early");
+    wheel.advance(3.2e7, fired);
+    assertTrue(fired.size() == 1 && fired[0].key == "year", "Level-three timer fires on time");
+    assertTrue(wheel.size() == 0, "Fired timers are disarmed");
+
+    wheel.schedule("late", 10.0);
+    fired.clear();
+    wheel.advance(3.2e7 + 1.0, fired);
+    assertTrue(fired.size() == 1 && fired[0].key == "late", "Past deadline fires on the next advance");
+}
+
+void testTimerWheelSkipsIdleSpans() {
+    std::cout << "\n=== Timer Wheel Skips Idle Spans ===" << std::endl;
+
+    utils::TimerWheel wheel(1.0);
+    for (int i = 0; i < 10000; ++i) {
+        wheel.schedule("job_" + std::to_string(i), 3600.0 + i);
+    }
+
+    std::vector<utils::TimerWheel::Timer> fired;
+    double now = 0.0;
+    for (int tick = 0; tick < 600; ++tick) {
+        now += 0.1;
+        wheel.advance(now, fired);
+    }
+    assertTrue(fired.empty(), "No timers fire during the idle minute");
+    assertTrue(wheel.slotsVisited() == 0, "Idle ticks visit no wheel slots");
+
+    wheel.advance(3600.0 + 9999.0, fired);
+    assertTrue(fired.size() == 10000, "All timers fire after one large advance");
+    bool ordered = true;
+    for (size_t i = 1; i < fired.size(); ++i) {
+        ordered = ordered && fired[i - 1].deadline <= fired[i].deadline;
+    }
+    assertTrue(ordered, "Timers fire in deadline order");
+    assertTrue(wheel.slotsVisited() < 20000, "Large advance visits only occupied slots");
+}
+
+void testJobClockIdleFactoriesCostNothing() {
+    std::cout << "\n=== Job Clock Idle Factories Cost Nothing ===" << std::endl;
+
+    ecs::World world;
+    systems::ManufacturingSystem mfgSys(&world);
+    const int facilities = 10000;
+    for (int i = 0; i < facilities; ++i) {
+        auto* station = world.createEntity("fac_" + std::to_string(i));
+        addComp<components::ManufacturingFacility>(station)->max_jobs = 1;
+        mfgSys.startJob(station->getId(), "nobody", "bp", "item", "Item", 1,
+                        3600.0f + static_cast<float>(i % 600), 0.0);
+    }
+
+    mfgSys.update(0.1f);   // first settle of the newly started jobs
+    uint64_t after_start = mfgSys.getClock().syncCount();
+    assertTrue(mfgSys.getClock().trackedCount() == static_cast<size_t>(facilities),
+               "Every facility with a running job is tracked");
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < 10000; ++tick) {
+        mfgSys.update(0.1f);
+    }
+    double idle_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t0).count();
+    std::cout << "  10000 idle ticks over " << facilities << " jobs: " << idle_ms << " ms" << std::endl;
+    assertTrue(mfgSys.getClock().syncCount() == after_start, "Idle ticks settle no facilities");
+
+    for (int tick = 0; tick < 400; ++tick) {
+        mfgSys.update(10.0f);
+    }
+    assertTrue(mfgSys.getClock().syncCount() - after_start == static_cast<uint64_t>(facilities),
+               "Each facility settled exactly once, when its job finished");
+    assertTrue(mfgSys.getClock().trackedCount() == 0, "Finished facilities are no longer tracked");
+    assertTrue(mfgSys.getCompletedJobCount("fac_0") == 1 &&
+               mfgSys.getCompletedJobCount("fac_" + std::to_string(facilities - 1)) == 1,
+               "Jobs completed");
+}
+
+void testJobClockDiscoversUntrackedJobs() {
+    std::cout << "\n=== Job Clock Discovers Untracked Jobs ===" << std::endl;
+
+    ecs::World world;
+    systems::SkillSystem skillSys(&world);
+    systems::ManufacturingSystem mfgSys(&world);
+
+    // Set up before the first update, as a loaded save would be
+    auto* station = world.createEntity("station");
+    auto* facility = addComp<components::ManufacturingFacility>(station);
+    components::ManufacturingFacility::ManufacturingJob job;
+    job.job_id = "job_direct";
+    job.runs = 2;
+    job.time_per_run = 50.0f;
+    job.time_remaining = 50.0f;
+    job.status = "active";
+    facility->jobs.push_back(job);
+
+    mfgSys.update(1.0f);
+    assertTrue(mfgSys.getClock().trackedCount() == 1, "Job present at start is found on first update");
+    for (int i = 0; i < 10; ++i) mfgSys.update(10.0f);
+    assertTrue(facility->jobs[0].status == "completed" && facility->jobs[0].runs_completed == 2,
+               "Discovered manufacturing job completes");
+
+    // Added mid-run without queueSkillTraining(), e.g. by adoption
+    auto* pilot = world.createEntity("pilot");
+    auto* skills = addComp<components::SkillSet>(pilot);
+    skillSys.update(1.0f);
+    components::SkillSet::QueueEntry entry;
+    entry.skill_id = "gunnery";
+    entry.target_level = 1;
+    entry.time_remaining = 5.0f;
+    skills->training_queue.push_back(entry);
+
+    skillSys.update(30.0f);
+    assertTrue(skillSys.getClock().trackedCount() == 0, "Not found before the next scan");
+    skillSys.update(30.0f);
+    assertTrue(skillSys.getClock().trackedCount() == 1, "Found on the slow discovery cadence");
+    skillSys.update(10.0f);
+    assertTrue(skills->training_queue.empty() && skills->getSkillLevel("gunnery") == 1,
+               "Discovered training completes");
+    assertTrue(skillSys.getClock().trackedCount() == 0, "Finished pilot no longer tracked");
+}
+
+void testJobClockOnDemandRemaining() {
+    std::cout << "\n=== Job Clock On-Demand Remaining ===" << std::endl;
+
+    ecs::World world;
+    systems::SkillSystem skillSys(&world);
+    systems::ManufacturingSystem mfgSys(&world);
+    systems::ResearchSystem resSys(&world);
+
+    auto* pilot = world.createEntity("pilot");
+    addComp<components::SkillSet>(pilot);
+    skillSys.queueSkillTraining("pilot", "a", "Skill A", 1, 10.0f);
+    skillSys.queueSkillTraining("pilot", "b", "Skill B", 1, 20.0f);
+
+    skillSys.update(15.0f);
+    assertTrue(skillSys.getSkillLevel("pilot", "a") == 1, "First skill complete");
+    assertTrue(approxEqual(skillSys.getTrainingTimeRemaining("pilot"), 15.0f),
+               "Leftover time carries into the next skill");
+    skillSys.update(0.5f);
+    skillSys.update(0.5f);
+    assertTrue(approxEqual(skillSys.getTrainingTimeRemaining("pilot"), 14.0f),
+               "Remaining time computed on query between completions");
+
+    auto* station = world.createEntity("station");
+    addComp<components::ManufacturingFacility>(station)->max_jobs = 1;
+    std::string job = mfgSys.startJob("station", "nobody", "bp", "item", "Item", 3, 100.0f, 0.0);
+    mfgSys.update(1000.0f);
+    assertTrue(mfgSys.getTotalRunsCompleted("station") == 3,
+               "One long step completes every run");
+    assertTrue(mfgSys.getCompletedJobCount("station") == 1 &&
+               approxEqual(mfgSys.getJobTimeRemaining("station", job), 0.0f), "Job finished");
+
+    auto* lab = world.createEntity("lab");
+    addComp<components::ResearchLab>(lab)->max_jobs = 1;
+    std::string res = resSys.startMEResearch("lab", "nobody", "bp", 2, 50.0f, 0.0);
+    resSys.update(20.0f);
+    assertTrue(approxEqual(resSys.getJobTimeRemaining("lab", res), 30.0f), "Research remaining on query");
+    assertTrue(resSys.startTEResearch("lab", "nobody", "bp", 2, 50.0f, 0.0).empty(),
+               "Slot still busy");
+    resSys.update(30.0f);
+    assertTrue(!resSys.startTEResearch("lab", "nobody", "bp", 2, 50.0f, 0.0).empty(),
+               "Finished research frees its slot");
+    assertTrue(resSys.getCompletedJobCount("lab") == 1, "Research completed");
+}
+
+// ==================== Background Fast-Forward Tests ====================
+
+void testBackgroundSimFastForwardCatchUp() {
+    std::cout << "\n=== Background Sim: Fast-Forward Catch-Up ===" << std::endl;
+    auto seed = [](components::SimStarSystemState* s) {
+        s->threat_level = 0.6f;
+        s->economic_index = 0.2f;
+        s->resource_availability = 0.3f;
+        s->traffic_level = 0.9f;
+        s->security_level = 0.2f;
+        s->pirate_activity = 0.5f;
+    };
+
+    // Reference: ticked every frame
+    ecs::World ref_world;
+    systems::BackgroundSimulationSystem ref_sim(&ref_world);
+    auto* ref = addComp<components::SimStarSystemState>(ref_world.createEntity("sys_ref"));
+    seed(ref);
+
+    ecs::World world;
+    systems::BackgroundSimulationSystem bgSim(&world);
+    bgSim.dormant_sync_interval = 1.0e6f;  // no cadence catch-up during the test
+    auto* state = addComp<components::SimStarSystemState>(world.createEntity("sys_ff"));
+    seed(state);
+    bgSim.setFastForward(true);
+    assertTrue(bgSim.isDormant("sys_ff"), "Unobserved system is suspended");
+    assertTrue(bgSim.getLiveCount() == 0, "No live systems");
+
+    for (int i = 0; i < 45; ++i) {
+        ref_sim.update(1.0f);
+        bgSim.update(1.0f);
+    }
+    assertTrue(approxEqual(state->threat_level, 0.6f) && state->synced_at == 0.0,
+               "Dormant state untouched between catch-ups");
+
+    bgSim.addObserver("sys_ff");
+    assertTrue(!bgSim.isDormant("sys_ff"), "Observer wakes the system");
+    assertTrue(bgSim.getCatchUpCount() == 1, "Woken with one catch-up");
+    assertTrue(approxEqual(state->synced_at, 45.0), "Caught up to now");
+    assertTrue(std::fabs(state->threat_level - ref->threat_level) < 0.01f, "Threat matches per-frame sim");
+    assertTrue(std::fabs(state->economic_index - ref->economic_index) < 0.01f, "Economy matches per-frame sim");
+    assertTrue(std::fabs(state->resource_availability - ref->resource_availability) < 0.01f,
+               "Resources match per-frame sim");
+    assertTrue(std::fabs(state->traffic_level - ref->traffic_level) < 0.01f, "Traffic matches per-frame sim");
+    assertTrue(std::fabs(state->pirate_activity - ref->pirate_activity) < 0.01f, "Pirates match per-frame sim");
+    assertTrue(state->pirate_surge && ref->pirate_surge, "Surge crossed during the gap is raised");
+
+    // Observed systems tick every frame
+    bgSim.update(1.0f);
+    assertTrue(bgSim.getLiveCount() == 1, "Observed system is live");
+    assertTrue(approxEqual(state->synced_at, 46.0), "Live system synced each tick");
+
+    bgSim.removeObserver("sys_ff");
+    assertTrue(bgSim.isDormant("sys_ff"), "Last observer out suspends it");
+    bgSim.update(1.0f);
+    assertTrue(approxEqual(state->synced_at, 46.0), "Suspended system not ticked");
+
+    bgSim.setFastForward(false);
+    assertTrue(!bgSim.isDormant("sys_ff") && approxEqual(state->synced_at, 47.0),
+               "Disabling fast-forward wakes and catches up");
+}
+
+void testBackgroundSimFastForwardEmptyUniverse() {
+    std::cout << "\n=== Background Sim: Fast-Forward Empty Universe ===" << std::endl;
+    ecs::World world;
+    systems::BackgroundSimulationSystem bgSim(&world);
+    bgSim.dormant_sync_interval = 600.0f;
+    const int systems_count = 5000;
+    for (int i = 0; i < systems_count; ++i) {
+        auto* s = addComp<components::SimStarSystemState>(
+            world.createEntity("ffsys_" + std::to_string(i)));
+        s->threat_level = 0.5f;
+    }
+    bgSim.setFastForward(true);
+    bgSim.addObserver("ffsys_7");
+
+    // One simulated hour at 1 Hz
+    for (int i = 0; i < 3600; ++i) bgSim.update(1.0f);
+
+    uint64_t catch_ups = bgSim.getCatchUpCount();
+    assertTrue(catch_ups >= static_cast<uint64_t>(systems_count) * 5, "Every dormant system synced on the cadence");
+    assertTrue(catch_ups <= static_cast<uint64_t>(systems_count) * 7, "Dormant systems synced only on the cadence");
+
+    auto* observed = bgSim.getSystemState("ffsys_7");
+    auto* dormant = bgSim.getSystemState("ffsys_8");
+    assertTrue(approxEqual(observed->synced_at, 3600.0), "Observed system is current");
+    assertTrue(dormant->synced_at > 3600.0 - 600.0 - 1.0, "Dormant system at most one interval stale");
+    assertTrue(approxEqual(dormant->threat_level, 0.0f), "Dormant threat still decayed");
+}
+
+void testDormantSystemReducedRates() {
+    std::cout << "\n=== Dormant Systems: Reduced Intent/Traffic Rates ===" << std::endl;
+    ecs::World world;
+    systems::BackgroundSimulationSystem bgSim(&world);
+    systems::NPCIntentSystem intentSys(&world);
+    systems::AmbientTrafficSystem atSys(&world);
+    intentSys.dormant_update_interval = 10.0f;
+    atSys.spawn_interval = 5.0f;
+    atSys.dormant_spawn_multiplier = 4.0f;
+
+    auto* sys = world.createEntity("sys_quiet");
+    addComp<components::SimStarSystemState>(sys);
+    auto* traffic = addComp<components::AmbientTrafficState>(sys);
+    traffic->spawn_timer = 5.0f;
+
+    auto* npc = world.createEntity("npc_quiet");
+    auto* intent = addComp<components::SimNPCIntent>(npc);
+    intent->target_system_id = "sys_quiet";
+
+    bgSim.setFastForward(true);
+    for (int i = 0; i < 9; ++i) {
+        intentSys.update(1.0f);
+        atSys.update(1.0f);
+    }
+    assertTrue(approxEqual(intent->intent_duration, 0.0f), "Dormant NPC not evaluated yet");
+    assertTrue(approxEqual(intent->deferred_time, 9.0f), "Dormant NPC banks its time");
+    assertTrue(traffic->pending_spawns.empty(), "Dormant spawn clock runs slower");
+
+    intentSys.update(1.0f);
+    assertTrue(intent->intent_duration > 0.0f || intent->current_intent != components::SimNPCIntent::Intent::Idle,
+               "Dormant NPC evaluated after the batch period");
+    assertTrue(approxEqual(intent->deferred_time, 0.0f), "Banked time consumed");
+
+    bgSim.addObserver("sys_quiet");
+    intentSys.update(1.0f);
+    assertTrue(approxEqual(intent->deferred_time, 0.0f), "Observed NPC evaluated every tick");
+    for (int i = 0; i < 5; ++i) atSys.update(1.0f);
+    assertTrue(!traffic->pending_spawns.empty(), "Observed system spawns at the normal rate");
+}
+
+void testBackgroundSimDrivesAttachedSystems() {
+    std::cout << "\n=== Background Sim: Attached Intent/Traffic Follow Live Systems ===" << std::endl;
+    ecs::World world;
+    systems::BackgroundSimulationSystem bgSim(&world);
+    systems::NPCIntentSystem intentSys(&world);
+    systems::AmbientTrafficSystem atSys(&world);
+    bgSim.dormant_sync_interval = 100.0f;
+    atSys.spawn_interval = 5.0f;
+    intentSys.attach(&bgSim);
+    atSys.attach(&bgSim);
+
+    std::vector<components::SimNPCIntent*> intents;
+    std::vector<components::AmbientTrafficState*> traffic;
+    for (int i = 0; i < 4; ++i) {
+        std::string sys_id = "att_sys_" + std::to_string(i);
+        auto* sys = world.createEntity(sys_id);
+        addComp<components::SimStarSystemState>(sys);
+        traffic.push_back(addComp<components::AmbientTrafficState>(sys));
+        traffic.back()->spawn_timer = 5.0f;
+        auto* intent = addComp<components::SimNPCIntent>(world.createEntity("att_npc_" + std::to_string(i)));
+        intent->target_system_id = sys_id;
+        intents.push_back(intent);
+    }
+    auto* drifter = addComp<components::SimNPCIntent>(world.createEntity("att_drifter"));
+    intentSys.refreshRoster();
+
+    bgSim.setFastForward(true);
+    bgSim.addObserver("att_sys_0");
+    for (int i = 0; i < 6; ++i) {
+        bgSim.update(1.0f);
+        intentSys.update(1.0f);
+        atSys.update(1.0f);
+    }
+    assertTrue(approxEqual(intents[0]->intent_duration, 6.0f) ||
+               intents[0]->current_intent != components::SimNPCIntent::Intent::Idle,
+               "NPC in the observed system advances every tick");
+    assertTrue(approxEqual(intents[1]->intent_duration, 0.0f) &&
+               approxEqual(intents[1]->deferred_time, 0.0f),
+               "NPC in a dormant system is not visited between catch-ups");
+    assertTrue(approxEqual(drifter->intent_duration, 6.0f) ||
+               drifter->current_intent != components::SimNPCIntent::Intent::Idle,
+               "NPC without a simulated system advances every tick");
+    assertTrue(!traffic[0]->pending_spawns.empty(), "Observed system spawns traffic");
+    assertTrue(approxEqual(traffic[1]->spawn_timer, 5.0f), "Dormant spawn clock untouched between catch-ups");
+
+    // Waking a system hands the gap to its NPCs and traffic in one step
+    bgSim.addObserver("att_sys_1");
+    assertTrue(approxEqual(intents[1]->intent_duration, 6.0f) ||
+               intents[1]->current_intent != components::SimNPCIntent::Intent::Idle,
+               "Woken system's NPCs catch up");
+    assertTrue(traffic[1]->spawn_timer < 5.0f, "Woken system's spawn clock catches up at the dormant rate");
+
+    // The cadence catch-up reaches every dormant system
+    for (int i = 0; i < 100; ++i) bgSim.update(1.0f);
+    assertTrue(intents[3]->intent_duration > 0.0f ||
+               intents[3]->current_intent != components::SimNPCIntent::Intent::Idle,
+               "Dormant NPCs advance on the background cadence");
+}
+
+// ==================== Session Replay Tests ====================
+
+void testReplayLogRoundTrip() {
+    std::cout << "\n=== Replay Log Round Trip ===" << std::endl;
+    const std::string path = "/tmp/eve_test_replay.atrp";
+    sim::ReplayRecorder recorder;
+    std::map<std::string, uint64_t> seeds{{"session.next_entity_id", 42}, {"loot", 7}};
+    assertTrue(recorder.open(path, "{\"entities\":[]}", 1.0f / 30.0f, seeds), "Recorder opens");
+
+    recorder.endTick();                                        // tick 1: quiet
+    recorder.recordCommand(5, "{\"type\":\"connect\"}");
+    recorder.recordCommand(6, "{\"type\":\"chat\",\"message\":\"o7\"}");
+    recorder.endTick();                                        // tick 2
+    for (int i = 0; i < 200; ++i) recorder.endTick();          // ticks 3..202: quiet
+    recorder.recordCommand(5, "{\"type\":\"stop\"}");
+    recorder.endTick();                                        // tick 203
+    recorder.endTick();                                        // tick 204
+    recorder.close();
+    assertTrue(recorder.getCommandCount() == 3, "Three commands written");
+
+    sim::ReplayLog log;
+    assertTrue(log.load(path), "Recording loads");
+    assertTrue(!log.isTruncated(), "Closed recording is complete");
+    assertTrue(approxEqual(log.getTickDuration(), 1.0f / 30.0f), "Tick length kept");
+    assertTrue(log.getSeed("session.next_entity_id") == 42 && log.getSeed("loot") == 7,
+               "Seeds kept");
+    assertTrue(log.getSeed("missing", 9) == 9, "Unknown seed falls back");
+    assertTrue(log.getSnapshot() == "{\"entities\":[]}", "Snapshot round-trips");
+    assertTrue(log.getTickCount() == 204, "Tick count includes quiet tail");
+    assertTrue(log.getFrames().size() == 2, "Only ticks with commands stored");
+    assertTrue(log.getFrames()[0].tick == 2 && log.getFrames()[1].tick == 203,
+               "Frames keep their ticks");
+    assertTrue(log.getFrames()[0].commands[1].client == 6 &&
+               log.getFrames()[0].commands[1].raw == "{\"type\":\"chat\",\"message\":\"o7\"}",
+               "Commands keep client and bytes in order");
+    std::remove(path.c_str());
+}
+
+void testReplayLogTruncatedTail() {
+    std::cout << "\n=== Replay Log Truncated Tail ===" << std::endl;
+    const std::string path = "/tmp/eve_test_replay_cut.atrp";
+    {
+        sim::ReplayRecorder recorder;
+        recorder.open(path, "{}", 0.1f, {});
+        recorder.recordCommand(1, "first");
+        recorder.endTick();
+        recorder.endTick();
+        recorder.recordCommand(1, "second-command-payload");
+        recorder.endTick();
+        // Closed cleanly on destruction; below, the end marker and half of
+        // the last frame are chopped off as a crash mid-write would leave it
+    }
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 2 - 12));
+    }
+
+    sim::ReplayLog log;
+    assertTrue(log.load(path), "Truncated recording still loads");
+    assertTrue(log.isTruncated(), "Missing end marker reported");
+    assertTrue(log.getFrames().size() == 1 && log.getFrames()[0].commands[0].raw == "first",
+               "Partial frame dropped, complete ones kept");
+    assertTrue(log.getTickCount() == 1, "Replays up to the last full frame");
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "not a recording";
+    assertTrue(!log.load(path), "Foreign file rejected");
+    std::remove(path.c_str());
+}
+
+void testReplayResimulationIsDeterministic() {
+    std::cout << "\n=== Replay Re-simulation Is Deterministic ===" << std::endl;
+    data::WorldPersistence persistence;
+    const std::string path = "/tmp/eve_test_replay_sim.atrp";
+
+    // A live world: ships drifting, commands changing their velocity
+    ecs::World live;
+    for (int i = 0; i < 20; ++i) {
+        auto* e = live.createEntity("ship_" + std::to_string(i));
+        auto* pos = addComp<components::Position>(e);
+        pos->x = static_cast<float>(i) * 100.0f;
+        auto* vel = addComp<components::Velocity>(e);
+        vel->vx = static_cast<float>(i % 5);
+        vel->max_speed = 1000.0f;
+    }
+    sim::ReplayRecorder recorder;
+    assertTrue(recorder.open(path, persistence.serializeWorld(&live), 0.05f, {}),
+               "Recording started from live world");
+
+    auto apply = [](ecs::World& world, const std::string& raw) {
+        // "<entity> <vz>"
+        auto space = raw.find(' ');
+        auto* e = world.getEntity(raw.substr(0, space));
+        if (e) e->getComponent<components::Velocity>()->vz = std::stof(raw.substr(space + 1));
+    };
+    for (int tick = 1; tick <= 300; ++tick) {
+        if (tick % 37 == 0) {
+            recorder.recordCommand(3, "ship_" + std::to_string(tick % 20) + " " +
+                                      std::to_string(tick * 0.5f));
+        }
+        recorder.endTick();
+    }
+    recorder.close();
+
+    sim::ReplayLog log;
+    assertTrue(log.load(path), "Recording loads");
+
+    auto replay = [&](std::vector<ecs::World::SystemProfile>* profiles) {
+        ecs::World world;
+        world.addSystem(std::make_unique<systems::MovementSystem>(&world));
+        persistence.deserializeWorld(&world, log.getSnapshot());
+        world.setProfiling(true);
+        size_t next = 0;
+        for (uint64_t tick = 1; tick <= log.getTickCount(); ++tick) {
+            if (next < log.getFrames().size() && log.getFrames()[next].tick == tick) {
+                for (const auto& command : log.getFrames()[next].commands) apply(world, command.raw);
+                ++next;
+            }
+            world.update(log.getTickDuration());
+        }
+        if (profiles) *profiles = world.getSystemProfiles();
+        return persistence.serializeWorld(&world);
+    };
+
+    std::vector<ecs::World::SystemProfile> profiles;
+    std::string first = replay(&profiles);
+    std::string second = replay(nullptr);
+    assertTrue(!first.empty() && first == second, "Two replays end in identical worlds");
+    assertTrue(first != log.getSnapshot(), "Replay actually simulated");
+    assertTrue(profiles.size() == 1 && profiles[0].name == "MovementSystem",
+               "Per-system profile recorded");
+    assertTrue(profiles[0].calls == 300, "Profile counts every tick");
+    assertTrue(profiles[0].max_ms >= 0.0 && profiles[0].total_ms >= profiles[0].max_ms,
+               "Profile totals consistent");
+    std::remove(path.c_str());
+}
+
+void testReplaySeedsRestoreResearchRolls() {
+    std::cout << "\n=== Replay Seeds Restore Research Rolls ===" << std::endl;
+
+    // Outcomes of a run of coin-flip inventions, starting from the given seeds
+    auto run = [](systems::ResearchSystem& research, ecs::World& world) {
+        std::string outcome;
+        for (int i = 0; i < 8; ++i) {
+            std::string job = research.startInvention("lab", "researcher", "fang_blueprint",
+                                                      "fang_ii_blueprint", "datacore_a", "datacore_b",
+                                                      0.5f, 10.0f, 10.0);
+            research.update(10.0f);
+            outcome += job + (research.getCompletedJobCount("lab") > 0 ? "+" : "-");
+            world.getEntity("lab")->getComponent<components::ResearchLab>()->jobs.clear();
+        }
+        return outcome;
+    };
+    auto makeWorld = [](ecs::World& world) {
+        auto* lab = addComp<components::ResearchLab>(world.createEntity("lab"));
+        lab->max_jobs = 1;
+        addComp<components::Player>(world.createEntity("researcher"))->isk = 1000000.0;
+    };
+
+    ecs::World live;
+    makeWorld(live);
+    systems::ResearchSystem live_research(&live);
+    run(live_research, live);   // advance past the initial state
+    uint32_t rng = live_research.getRngState();
+    int counter = live_research.getJobCounter();
+    std::string expected = run(live_research, live);
+
+    ecs::World replayed;
+    makeWorld(replayed);
+    systems::ResearchSystem replay_research(&replayed);
+    replay_research.setRngState(rng);
+    replay_research.setJobCounter(counter);
+    assertTrue(run(replay_research, replayed) == expected,
+               "Restored seeds reproduce invention rolls and job ids");
+}
+
+void testUnstartedServerDropsSends() {
+    std::cout << "\n=== Unstarted Server Drops Sends ===" << std::endl;
+
+    // Replay feeds recorded fd numbers through a server that never started;
+    // fd 1 here is stdout, which must not receive game messages
+    network::TCPServer server("127.0.0.1", 0, 1);
+    assertTrue(!server.sendToSocket(1, "{\"type\":\"state_update\"}\n"),
+               "Send through an unstarted server is dropped");
+}
+
+// ==================== Connection Telemetry Tests ====================
+
+void testLatencyHistogramQuantiles() {
+    std::cout << "\n=== Latency Histogram Quantiles ===" << std::endl;
+
+    atlas::network::LatencyHistogram h;
+    assertTrue(h.quantile(0.5) == 0.0, "Empty histogram reports zero");
+
+    for (int i = 0; i < 90; ++i) h.record(0.0008);   // 1 ms bucket
+    for (int i = 0; i < 10; ++i) h.record(0.2);      // 250 ms bucket
+    assertTrue(h.count == 100, "All samples counted");
+    assertTrue(approxEqual(h.quantile(0.5), 0.001), "p50 falls in the 1 ms bucket");
+    assertTrue(approxEqual(h.quantile(0.99), 0.25), "p99 falls in the 250 ms bucket");
+    assertTrue(approxEqual(h.mean(), (90 * 0.0008 + 10 * 0.2) / 100.0), "Mean uses the exact sum");
+
+    atlas::network::LatencyHistogram other;
+    other.record(30.0);
+    h.merge(other);
+    assertTrue(h.count == 101 && h.buckets[atlas::network::LatencyHistogram::BOUNDS] == 1,
+               "Overflow sample lands in the +Inf bucket after merge");
+}
+
+void testConnectionTelemetryRatesAndRtt() {
+    std::cout << "\n=== Connection Telemetry Rates And RTT ===" << std::endl;
+
+    atlas::network::ConnectionTelemetry telemetry;
+    telemetry.onConnect(5, "10.0.0.1:4000", 0.0);
+    telemetry.onConnect(6, "10.0.0.2:4001", 0.0);
+    telemetry.setPlayer(5, "Heavy", "player_5");
+    telemetry.sample(0.0);
+
+    telemetry.recordMessageOut(5, 4000);
+    telemetry.recordMessageOut(6, 1000);
+    telemetry.recordMessageIn(6, 300);
+    telemetry.recordApply(6, 0.002);
+    telemetry.sample(2.0);
+
+    auto top = telemetry.top(1, atlas::network::ConnectionTelemetry::SortKey::BytesOut);
+    assertTrue(top.size() == 1 && top[0].player_name == "Heavy", "Heaviest sender listed first");
+    assertTrue(approxEqual(static_cast<float>(top[0].bytes_out_per_sec), 2000.0f),
+               "Send rate is bytes over the sample window");
+
+    uint64_t nonce = telemetry.recordPingSent(5, 10.0);
+    assertTrue(nonce != 0, "Ping returns a nonce");
+    assertTrue(!telemetry.recordPong(5, nonce + 1, 10.05), "Wrong nonce is rejected");
+    assertTrue(telemetry.recordPong(5, nonce, 10.04), "Matching pong accepted");
+    assertTrue(!telemetry.recordPong(5, nonce, 10.06), "Pong counts once");
+
+    auto stats = telemetry.snapshot();
+    assertTrue(stats.size() == 2 && approxEqual(static_cast<float>(stats[0].rtt_ms), 40.0f),
+               "RTT measured from ping to pong");
+    assertTrue(telemetry.getRttHistogram().count == 1, "RTT recorded in the aggregate histogram");
+
+    telemetry.onDisconnect(6);
+    assertTrue(telemetry.getConnectionCount() == 1, "Closed connection leaves the table");
+    assertTrue(telemetry.getTotalBytesOut() == 5000 && telemetry.getApplyHistogram().count == 1,
+               "Totals keep closed connections");
+}
+
+void testConnectionTelemetryExport() {
+    std::cout << "\n=== Connection Telemetry Export ===" << std::endl;
+
+    atlas::network::ConnectionTelemetry telemetry;
+    telemetry.onConnect(7, "127.0.0.1:5000", 0.0);
+    telemetry.setPlayer(7, "Pilot \"Q\"", "player_7");
+    telemetry.recordMessageIn(7, 120);
+    telemetry.setQueueDepth(7, 65536, 0);
+
+    std::ostringstream text;
+    telemetry.writePrometheus(text);
+    std::string out = text.str();
+    assertTrue(out.find("atlas_network_received_bytes_total 120") != std::string::npos,
+               "Aggregate byte counter exported");
+    assertTrue(out.find("# TYPE atlas_client_rtt_seconds histogram") != std::string::npos,
+               "RTT histogram exported");
+    assertTrue(out.find("atlas_client_send_queue_bytes{player=\"Pilot \\\"Q\\\"\"") != std::string::npos,
+               "Per-client gauge labels are escaped");
+    assertTrue(out.find("atlas_client_rtt_smoothed_seconds{") == std::string::npos,
+               "Clients without a pong have no RTT gauge");
+
+    atlas::network::ConnectionTelemetry::SortKey key;
+    assertTrue(atlas::network::ConnectionTelemetry::parseSortKey("queue", key) &&
+               key == atlas::network::ConnectionTelemetry::SortKey::SendQueue,
+               "Sort key parsed");
+    assertTrue(!atlas::network::ConnectionTelemetry::parseSortKey("bogus", key), "Unknown sort key rejected");
+    std::string table = telemetry.formatTop(5, key);
+    assertTrue(table.find("Connections: 1") != std::string::npos &&
+               table.find("127.0.0.1:5000") != std::string::npos,
+               "Console table lists the connection");
+}
+
+void testPongRttExcludesQueueWait() {
+    std::cout << "\n=== Pong RTT Excludes Queue Wait ===" << std::endl;
+
+    ecs::World world;
+    network::TCPServer server("127.0.0.1", 0, 4);
+    if (!server.initialize()) {
+        assertTrue(false, "Server binds an ephemeral port");
+        return;
+    }
+    server.start();
+    GameSession session(&world, &server);
+    session.initialize();
+
+    auto client = cluster::NodeLink::connect("127.0.0.1:" + std::to_string(server.getPort()));
+    assertTrue(client != nullptr, "Client connects");
+    if (!client) {
+        server.stop();
+        return;
+    }
+    client->start(nullptr);
+    assertTrue(waitFor([&] { return server.getClientCount() == 1; }), "Server accepts the client");
+    int socket = static_cast<int>(server.getClients().front().socket);
+
+    auto& telemetry = server.getTelemetry();
+    double sent = std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    uint64_t nonce = telemetry.recordPingSent(socket, sent);
+    client->sendRaw("{\"type\":\"pong\",\"data\":{\"nonce\":" + std::to_string(nonce) + "}}\n");
+
+    // A slow tick gets to the queued pong 300 ms after it arrived
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    session.processIncomingMessages();
+
+    double rtt_ms = -1.0;
+    for (const auto& stats : telemetry.snapshot()) {
+        if (stats.socket == socket) rtt_ms = stats.rtt_ms;
+    }
+    assertTrue(rtt_ms >= 0.0, "Pong recorded");
+    assertTrue(rtt_ms < 150.0, "RTT ends when the pong arrived, not when the tick applied it");
+
+    client->close();
+    server.stop();
+}
+
 int main() {
     std::cout << "========================================" << std::endl;
     std::cout << "EVE OFFLINE C++ Server System Tests" << std::endl;
     std::cout << "Capacitor, Shield, Weapon, Targeting," << std::endl;
     std::cout << "ShipDB, WormholeDB, Wormhole, Fleet," << std::endl;
     std::cout << "Mission, Skill, Module, Inventory," << std::endl;
-    std::cout << "Loot, NpcDB, Drone, Insurance, Bounty, Market," << std::endl;
+    std::cout << "Loot, NpcDB, Drone, Insurance, Bounty, Market, MarketHistory," << std::endl;
     std::cout << "WorldPersistence, Interdictors, StealthBombers," << std::endl;
     std::cout << "PI, Manufacturing, Research," << std::endl;
     std::cout << "Chat, CharacterCreation, Tournament, Leaderboard," << std::endl;
@@ -13482,7 +16419,7 @@ int main() {
     std::cout << "LODSystem, SpatialHash, CompressedPersistence, 200ShipStress," << std::endl;
     std::cout << "BackgroundSimulation, NPCIntent," << std::endl;
     std::cout << "NPCBehaviorTree, CombatThreat, SecurityResponse," << std::endl;
-    std::cout << "AmbientTraffic, TacticalOverlayFleetExt" << std::endl;
+    std::cout << "AmbientTraffic, TacticalOverlayFleetExt, Partitions" << std::endl;
     std::cout << "========================================" << std::endl;
     
     // Capacitor tests
@@ -13503,6 +16440,13 @@ int main() {
     testWeaponDamageResistances();
     testWeaponAutoFireAI();
     testWeaponNoAutoFireIdleAI();
+
+    // Damage pipeline tests
+    testDamagePipelineBatchesPerTarget();
+    testWeaponUnknownDamageTypeHitsUnresisted();
+    testDamagePipelineMixedResists();
+    testDamagePipelineOverflowAndDeath();
+    testDamagePipelineFleetFight();
     
     // Targeting system tests
     testTargetLockUnlock();
@@ -13525,6 +16469,7 @@ int main() {
     testWormholeDatabaseGetClass();
     testWormholeDatabaseEffects();
     testWormholeDatabaseClassIds();
+    testUniverseDatabaseLoad();
     
     // WormholeSystem tests
     testWormholeLifetimeDecay();
@@ -13573,6 +16518,13 @@ int main() {
     testLoggerLevels();
     testLoggerFileOutput();
     testLoggerLevelFiltering();
+    testLoggerAsyncMultiThread();
+    testLoggerAsyncOverflowPolicies();
+    testLoggerJsonSink();
+    testLoggerRotation();
+    testLoggerAsyncHotPathCost();
+    testLoggerDeferredFormat();
+    testLoggerStopAsyncDrainsLatePushes();
     
     // ServerMetrics tests
     testMetricsTickTiming();
@@ -13655,6 +16607,15 @@ int main() {
     testMarketPriceQueries();
     testMarketOrderExpiry();
 
+    // Market history tests
+    testMarketHistoryOHLCRollup();
+    testMarketHistoryRangeQuery();
+    testMarketHistoryFixedCapacity();
+    testMarketHistorySegmentRoundTrip();
+    testMarketTradesRecordHistory();
+    testBackgroundSimMarketFeed();
+    testProtocolMarketHistoryMessages();
+
     // Corporation system tests
     testCorpCreate();
     testCorpJoin();
@@ -14130,6 +17091,7 @@ int main() {
     testPersistenceWarpEvent();
     testPersistenceTacticalProjection();
     testPersistencePlayerPresence();
+    testPersistenceSystemLocation();
     testPersistenceFactionCulture();
 
     // Mineral economy integration test
@@ -14279,6 +17241,86 @@ int main() {
     testOverlayWingBandsDisabledByDefault();
     testOverlayFleetExtensionsMissing();
 
+    // Solar system partition tests
+    testWorldReleaseAdoptEntity();
+    testPartitionParallelTick();
+    testPartitionInlineMode();
+    testPartitionHandoff();
+    testPartitionWormholeHandoff();
+    testPartitionDestroyEntity();
+
+    // Cluster mode tests
+    testClusterTopologyParse();
+    testNodeLinkUnixSocket();
+    testClusterNodeMigration();
+    testClusterNodeMigrationRejected();
+    testClusterProxyRedirect();
+
+    // Data bake tests
+    testDataBakeRoundTrip();
+    testDataBakeReusesCurrentBake();
+    testDataBakeRejectsStaleOrCorrupt();
+    testDataBakeRebuildsOnSourceChange();
+
+    // Ship template registry tests
+    testShipTemplateRegistrySharesRecords();
+    testShipTemplateSparseOverrides();
+    testShipTemplateDrivesTargeting();
+    testShipTemplatePersistenceRoundTrip();
+    testShipTemplateMemoryReport();
+    testSpawnedNpcKeepsFixedBalance();
+
+    // Chat hub tests
+    testChatHistoryRing();
+    testChatHubMembershipFanout();
+    testChatHubRateLimit();
+    testChatHubLocalChannels();
+    testChatHubJoinableChannels();
+    testChatHubFanoutBenchmark();
+
+    // Event bus tests
+    testEventBusDoubleBuffer();
+    testEventBusRecyclesSlots();
+    testEventBusSubscribersGetBatches();
+    testEventBusCombatEvents();
+    testEventBusDefensiveAIUsesEvents();
+    testEventBusDockWarpMissionEvents();
+
+    // Timer wheel tests
+    testTimerWheelFiresAtDeadlines();
+    testTimerWheelSkipsIdleSpans();
+    testJobClockIdleFactoriesCostNothing();
+    testJobClockOnDemandRemaining();
+    testJobClockDiscoversUntrackedJobs();
+
+    // Background fast-forward tests
+    testBackgroundSimFastForwardCatchUp();
+    testBackgroundSimFastForwardEmptyUniverse();
+    testDormantSystemReducedRates();
+    testBackgroundSimDrivesAttachedSystems();
+
+    // Session replay tests
+    testReplayLogRoundTrip();
+    testReplayLogTruncatedTail();
+    testReplayResimulationIsDeterministic();
+    testReplaySeedsRestoreResearchRolls();
+    testUnstartedServerDropsSends();
+
+    // Connection telemetry tests
+    testLatencyHistogramQuantiles();
+    testConnectionTelemetryRatesAndRtt();
+    testConnectionTelemetryExport();
+    testPongRttExcludesQueueWait();
+
+    // Time dilation tests
+    testTimeDilationDisabledByDefault();
+    testTimeDilationOverload();
+    testTimeDilationRecovery();
+    testTimeDilationThrottlesSteps();
+    testPartitionTimeDilation();
+    testPartitionDilationSpreadsStep();
+    testMetricsDilationHistory();
+
     std::cout << "\n========================================" << std::endl;
     std::cout << "Results: " << testsPassed << "/" << testsRun << " tests passed" << std::endl;
     std::cout << "========================================" << std::endl;